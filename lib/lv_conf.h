@@ -68,7 +68,12 @@
 #define LV_STDARG_INCLUDE       <stdarg.h>
 
 #if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
-    /** Size of memory available for `lv_malloc()` in bytes (>= 2kB) */
+    /** Size of memory available for `lv_malloc()` in bytes (>= 2kB)
+     *  The caches share it with the UI, so their sizes below are chosen together.
+     *  testing/host/heap_budget_bench walks through the app's UI: without its caches it takes up to
+     *  38 KB (loading screen with the GIF) and a refresh peaks up to 6 KB above that, which leaves about 20 KB.
+     *  Resolved styles take up to 8.5 KB, text layouts 4 KB, masks 2 KB, gradients 1 KB and glyph IDs 0.2 KB per font.
+     *  The layer buffer pool is off and the image cache only gets what main.c finds free above a reserve. */
     #define LV_MEM_SIZE (64 * 1024U)          /**< [bytes] */
 
     /** Size of the memory expand for `lv_malloc()` in bytes */
@@ -136,6 +141,12 @@
 /** The target buffer size for simple layer chunks. */
 #define LV_DRAW_LAYER_SIMPLE_BUF_SIZE    (24 * 1024)    /**< [bytes]*/
 
+/** Keep up to this many bytes of released layer buffers to reuse them for the next layers
+ * instead of allocating and freeing them in every refresh (e.g. while fading a screen).
+ * Buffers not used during a refresh are freed at its end.
+ * Set it to 0 to disable the pool. */
+#define LV_DRAW_LAYER_BUF_POOL_SIZE    0    /**< [bytes]*/
+
 /** Stack size of drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -186,6 +197,12 @@
          *  `radius * 4` bytes are used per circle (the most often used radiuses are saved).
          *  - 0: disables caching */
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
+
+        /** Size of the cache of rounded corner masks and blurred shadow corners [bytes].
+         *  Corners are kept per radius, border width and shadow size, so rounded rectangles,
+         *  borders and shadows which are redrawn often don't compute their masks again.
+         *  - 0: disables caching */
+        #define LV_DRAW_SW_MASK_CACHE_SIZE (2 * 1024)
     #endif
 
     #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
@@ -196,6 +213,12 @@
 
     /** Enable drawing complex gradients in software: linear at an angle, radial or conical */
     #define LV_USE_DRAW_SW_COMPLEX_GRADIENTS    0
+
+    /** Size of the cache of gradient color and opacity maps [bytes].
+     *  Maps are kept per gradient stops and size, so gradients redrawn in many stripes
+     *  or frames don't calculate every color again.
+     *  - 0: disables caching */
+    #define LV_DRAW_SW_GRADIENT_CACHE_SIZE  (1 * 1024)
 #endif
 
 /** Use NXP's VG-Lite GPU on iMX RTxxx platforms. */
@@ -359,12 +382,13 @@
  *  Used by image decoders such as `lv_lodepng` to keep the decoded image in memory.
  *  If size is not set to 0, the decoder will fail to decode when the cache is full.
  *  If size is 0, the cache function is not enabled and the decoded memory will be
- *  released immediately after use. */
+ *  released immediately after use.
+ *  The app starts without it and main.c resizes it to the heap left free by the UI. */
 #define LV_CACHE_DEF_SIZE       0
 
 /** Default number of image header cache entries. The cache is used to store the headers of images
  *  The main logic is like `LV_CACHE_DEF_SIZE` but for image headers. */
-#define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
+#define LV_IMAGE_HEADER_CACHE_DEF_CNT 8
 
 /** Number of stops allowed per gradient. Increase this to allow more stops.
  *  This adds (sizeof(lv_color_t) + 1) bytes per additional stop. */
@@ -381,6 +405,10 @@
 /** Add 2 x 32-bit variables to each `lv_obj_t` to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      0
 
+/** Keep the values resolved by `lv_obj_get_style_prop` per object, part and state.
+ *  Costs a pointer in each `lv_obj_t` and about 4 bytes per resolved property. */
+#define LV_OBJ_STYLE_RESOLVED_CACHE 1
+
 /** Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -532,6 +560,10 @@
  *  A compiler error will be triggered if a font needs it. */
 #define LV_FONT_FMT_TXT_LARGE 0
 
+/** 1: Keep a direct-mapped table of the glyph IDs of the printable ASCII letters for each used built-in font
+ *  (about 200 bytes each), so they are not searched in the font's character maps for every letter. */
+#define LV_USE_FONT_FMT_TXT_GID_TABLE 1
+
 /** Enables/disables support for compressed fonts. */
 #define LV_USE_FONT_COMPRESSED 0
 
@@ -565,6 +597,10 @@
  *  Depends on LV_TXT_LINE_BREAK_LONG_LEN. */
 #define LV_TXT_LINE_BREAK_LONG_POST_MIN_LEN 3
 
+/** Size of the text layout cache in bytes. The measured size and line breaks of texts are kept
+ *  so labels and tables don't break the same text into lines again. 0 to disable. */
+#define LV_TEXT_LAYOUT_CACHE_SIZE (4 * 1024)
+
 /** Support bidirectional text. Allows mixing Left-to-Right and Right-to-Left text.
  *  The direction will be processed according to the Unicode Bidirectional Algorithm:
  *  https://www.w3.org/International/articles/inline-bidi-markup/uba-basics */
@@ -653,6 +689,8 @@
 
 #define LV_USE_MSGBOX     1
 
+#define LV_USE_NUMLABEL   1   /**< Fixed point numbers drawn from pre-rendered digits*/
+
 #define LV_USE_ROLLER     1   /**< Requires: lv_label */
 
 #define LV_USE_SCALE      1
@@ -808,12 +846,16 @@
     #define LV_GIF_CACHE_DECODE_DATA 0
 #endif
 
+/** Player for pre-decoded RGB565 animations made with `scripts/LVGLImage.py --ofmt ANIM`.
+ *  Frames are streamed via lv_fs; enable LV_USE_RLE or LV_USE_LZ4_* for compressed files. */
+#define LV_USE_SPRITE_ANIM 1
+
 
 /** Decode bin images to RAM */
 #define LV_BIN_DECODER_RAM_LOAD 0
 
 /** RLE decompress library */
-#define LV_USE_RLE 0
+#define LV_USE_RLE 1
 
 /** QR code library */
 #define LV_USE_QRCODE 0
@@ -854,7 +896,7 @@
 #define LV_USE_THORVG_EXTERNAL 0
 
 /** Use lvgl built-in LZ4 lib */
-#define LV_USE_LZ4_INTERNAL  0
+#define LV_USE_LZ4_INTERNAL  1
 
 /** Use external LZ4 library */
 #define LV_USE_LZ4_EXTERNAL  0
@@ -873,7 +915,11 @@
 /* Documentation for several of the below items can be found here: https://docs.lvgl.io/master/others/index.html . */
 
 /** 1: Enable API to take snapshot for object */
-#define LV_USE_SNAPSHOT 0
+#define LV_USE_SNAPSHOT 1
+
+/** 1: Keep the rendered image of screens so an unchanged screen is copied instead of rendered when
+ *  it's loaded again. Needs `LV_USE_SNAPSHOT`, see `lv_page_cache_create()` */
+#define LV_USE_PAGE_CACHE 1
 
 /** 1: Enable system monitor component */
 #define LV_USE_SYSMON   0
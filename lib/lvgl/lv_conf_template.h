@@ -151,6 +151,12 @@
  * Set it to 0 to have no limit. */
 #define LV_DRAW_LAYER_MAX_MEMORY 0  /**< No limit by default [bytes]*/
 
+/** Keep up to this many bytes of released layer buffers to reuse them for the next layers
+ * instead of allocating and freeing them in every refresh (e.g. while fading a screen).
+ * Buffers not used during a refresh are freed at its end.
+ * Set it to 0 to disable the pool. */
+#define LV_DRAW_LAYER_BUF_POOL_SIZE 0  /**< [bytes]*/
+
 /** Stack size of drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -201,6 +207,12 @@
          *  `radius * 4` bytes are used per circle (the most often used radiuses are saved).
          *  - 0: disables caching */
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
+
+        /** Size of the cache of rounded corner masks and blurred shadow corners [bytes].
+         *  Corners are kept per radius, border width and shadow size, so rounded rectangles,
+         *  borders and shadows which are redrawn often don't compute their masks again.
+         *  - 0: disables caching */
+        #define LV_DRAW_SW_MASK_CACHE_SIZE 0
     #endif
 
     #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
@@ -211,6 +223,12 @@
 
     /** Enable drawing complex gradients in software: linear at an angle, radial or conical */
     #define LV_USE_DRAW_SW_COMPLEX_GRADIENTS    0
+
+    /** Size of the cache of gradient color and opacity maps [bytes].
+     *  Maps are kept per gradient stops and size, so gradients redrawn in many stripes
+     *  or frames don't calculate every color again.
+     *  - 0: disables caching */
+    #define LV_DRAW_SW_GRADIENT_CACHE_SIZE  0
 #endif
 
 /*Use TSi's aka (Think Silicon) NemaGFX */
@@ -438,6 +456,10 @@
 /** Add 2 x 32-bit variables to each `lv_obj_t` to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      0
 
+/** Keep the values resolved by `lv_obj_get_style_prop` per object, part and state.
+ *  Costs a pointer in each `lv_obj_t` and about 4 bytes per resolved property. */
+#define LV_OBJ_STYLE_RESOLVED_CACHE 0
+
 /** Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -593,6 +615,10 @@
  *  A compiler error will be triggered if a font needs it. */
 #define LV_FONT_FMT_TXT_LARGE 0
 
+/** 1: Keep a direct-mapped table of the glyph IDs of the printable ASCII letters for each used built-in font
+ *  (about 200 bytes each), so they are not searched in the font's character maps for every letter. */
+#define LV_USE_FONT_FMT_TXT_GID_TABLE 0
+
 /** Enables/disables support for compressed fonts. */
 #define LV_USE_FONT_COMPRESSED 0
 
@@ -626,6 +652,10 @@
  *  Depends on LV_TXT_LINE_BREAK_LONG_LEN. */
 #define LV_TXT_LINE_BREAK_LONG_POST_MIN_LEN 3
 
+/** Size of the text layout cache in bytes. The measured size and line breaks of texts are kept
+ *  so labels and tables don't break the same text into lines again. 0 to disable. */
+#define LV_TEXT_LAYOUT_CACHE_SIZE 0
+
 /** Support bidirectional text. Allows mixing Left-to-Right and Right-to-Left text.
  *  The direction will be processed according to the Unicode Bidirectional Algorithm:
  *  https://www.w3.org/International/articles/inline-bidi-markup/uba-basics */
@@ -717,6 +747,8 @@
 
 #define LV_USE_MSGBOX     1
 
+#define LV_USE_NUMLABEL   1   /**< Fixed point numbers drawn from pre-rendered digits*/
+
 #define LV_USE_ROLLER     1   /**< Requires: lv_label */
 
 #define LV_USE_SCALE      1
@@ -876,6 +908,10 @@
     #define LV_GIF_CACHE_DECODE_DATA 0
 #endif
 
+/** Player for pre-decoded RGB565 animations made with `scripts/LVGLImage.py --ofmt ANIM`.
+ *  Frames are streamed via lv_fs; enable LV_USE_RLE or LV_USE_LZ4_* for compressed files. */
+#define LV_USE_SPRITE_ANIM 0
+
 
 /** Decode bin images to RAM */
 #define LV_BIN_DECODER_RAM_LOAD 0
@@ -953,6 +989,10 @@
 /** 1: Enable API to take snapshot for object */
 #define LV_USE_SNAPSHOT 0
 
+/** 1: Keep the rendered image of screens so an unchanged screen is copied instead of rendered when
+ *  it's loaded again. Needs `LV_USE_SNAPSHOT`, see `lv_page_cache_create()` */
+#define LV_USE_PAGE_CACHE 0
+
 /** 1: Enable system monitor component */
 #define LV_USE_SYSMON   0
 #if LV_USE_SYSMON
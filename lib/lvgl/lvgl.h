@@ -35,7 +35,7 @@ extern "C" {
 #include "src/misc/lv_utils.h"
 #include "src/misc/lv_iter.h"
 #include "src/misc/lv_circle_buf.h"
-#include "src/misc/lv_tree.h"
+#include "src/misc/cache/lv_cache.h"
 #include "src/misc/cache/lv_image_cache.h"
 
 #include "src/tick/lv_tick.h"
@@ -43,7 +43,6 @@ extern "C" {
 #include "src/core/lv_obj.h"
 #include "src/core/lv_group.h"
 #include "src/indev/lv_indev.h"
-#include "src/indev/lv_indev_gesture.h"
 #include "src/core/lv_refr.h"
 #include "src/display/lv_display.h"
 
@@ -71,6 +70,7 @@ extern "C" {
 #include "src/widgets/lottie/lv_lottie.h"
 #include "src/widgets/menu/lv_menu.h"
 #include "src/widgets/msgbox/lv_msgbox.h"
+#include "src/widgets/numlabel/lv_numlabel.h"
 #include "src/widgets/roller/lv_roller.h"
 #include "src/widgets/scale/lv_scale.h"
 #include "src/widgets/slider/lv_slider.h"
@@ -85,6 +85,7 @@ extern "C" {
 #include "src/widgets/win/lv_win.h"
 
 #include "src/others/snapshot/lv_snapshot.h"
+#include "src/others/page_cache/lv_page_cache.h"
 #include "src/others/sysmon/lv_sysmon.h"
 #include "src/others/monkey/lv_monkey.h"
 #include "src/others/gridnav/lv_gridnav.h"
@@ -94,8 +95,6 @@ extern "C" {
 #include "src/others/ime/lv_ime_pinyin.h"
 #include "src/others/file_explorer/lv_file_explorer.h"
 #include "src/others/font_manager/lv_font_manager.h"
-#include "src/others/xml/lv_xml.h"
-#include "src/others/xml/lv_xml_component.h"
 
 #include "src/libs/barcode/lv_barcode.h"
 #include "src/libs/bin_decoder/lv_bin_decoder.h"
@@ -105,6 +104,7 @@ extern "C" {
 #include "src/libs/lodepng/lv_lodepng.h"
 #include "src/libs/libpng/lv_libpng.h"
 #include "src/libs/gif/lv_gif.h"
+#include "src/libs/sprite_anim/lv_sprite_anim.h"
 #include "src/libs/qrcode/lv_qrcode.h"
 #include "src/libs/tjpgd/lv_tjpgd.h"
 #include "src/libs/libjpeg_turbo/lv_libjpeg_turbo.h"
@@ -112,8 +112,6 @@ extern "C" {
 #include "src/libs/rlottie/lv_rlottie.h"
 #include "src/libs/ffmpeg/lv_ffmpeg.h"
 #include "src/libs/tiny_ttf/lv_tiny_ttf.h"
-#include "src/libs/svg/lv_svg.h"
-#include "src/libs/svg/lv_svg_render.h"
 
 #include "src/layouts/lv_layout.h"
 
@@ -1152,7 +1152,7 @@ class RLEImage(LVGLImage):
 
             index += blksize  # move to next position
             if index >= len(data):  # data end
-                nonrepeat_count += repeat_cnt
+                nonrepeat_count = min(nonrepeat_count + repeat_cnt, 127)
                 break
 
         return nonrepeat_count
@@ -1195,10 +1195,153 @@ class RAWImage():
         return self
 
 
+class LVGLAnimation:
+    '''
+    Pre-decoded animation for lv_sprite_anim. Every frame is stored as the
+    RGB565 rectangle that changed since the previous frame, split into chunks
+    of whole rows so the player only needs one chunk buffer besides the canvas.
+    See lv_sprite_anim.h for the file layout.
+    '''
+    MAGIC = 0x4E41564C  # "LVAN"
+    VERSION = 1
+
+    def __init__(self) -> None:
+        self.w = 0
+        self.h = 0
+        self.loop_count = 0
+        self.frames = []  # (rgb565 bytes of the whole canvas, delay in ms)
+
+    def from_gif(self, filename: str, background: int = 0x00):
+        """
+        Decode every frame of a GIF (or any animation Pillow can read) and
+        blend it on the background color
+        """
+        try:
+            from PIL import Image, ImageSequence
+        except ImportError:
+            raise ImportError("Need Pillow package, do `pip3 install Pillow`")
+
+        with Image.open(filename) as im:
+            self.w, self.h = im.size
+            self.loop_count = im.info.get("loop", 1)
+            bg = ((background >> 16) & 0xff, (background >> 8) & 0xff,
+                  background & 0xff, 0xff)
+            self.frames = []
+            for frame in ImageSequence.Iterator(im):
+                canvas = Image.new("RGBA", im.size, bg)
+                canvas.alpha_composite(frame.convert("RGBA"))
+                delay = frame.info.get("duration", im.info.get("duration", 100))
+                self.frames.append((self._to_rgb565(canvas), int(delay)))
+
+        if not self.frames:
+            raise FormatError(f"no frames in {filename}")
+        return self
+
+    @staticmethod
+    def _to_rgb565(img) -> bytes:
+        rgba = img.tobytes()
+        out = bytearray()
+        for i in range(0, len(rgba), 4):
+            r, g, b = rgba[i], rgba[i + 1], rgba[i + 2]
+            out += uint16_t(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3))
+        return bytes(out)
+
+    def _changed_rect(self, prev: bytes, cur: bytes):
+        stride = self.w * 2
+        rows = [y for y in range(self.h)
+                if prev[y * stride:(y + 1) * stride] != cur[y * stride:(y + 1) * stride]]
+        if not rows:
+            return 0, 0, 0, 0
+        y1, y2 = rows[0], rows[-1]
+        x1, x2 = self.w, -1
+        for y in range(y1, y2 + 1):
+            a = prev[y * stride:(y + 1) * stride]
+            b = cur[y * stride:(y + 1) * stride]
+            for x in range(self.w):
+                if a[x * 2:x * 2 + 2] != b[x * 2:x * 2 + 2]:
+                    x1 = min(x1, x)
+                    break
+            for x in range(self.w - 1, -1, -1):
+                if a[x * 2:x * 2 + 2] != b[x * 2:x * 2 + 2]:
+                    x2 = max(x2, x)
+                    break
+        return x1, y1, x2 - x1 + 1, y2 - y1 + 1
+
+    def to_bin(self,
+               filename: str,
+               compress: CompressMethod = CompressMethod.NONE,
+               chunk_size: int = 4096):
+        """
+        Write the animation to file, filename should be ended with '.anim'
+        chunk_size is the decoded size of a chunk in bytes, at least one row
+        """
+        if not filename.lower().endswith(".anim"):
+            raise ParameterError(f"filename not ended with '.anim': {filename}")
+        os.makedirs(path.dirname(filename) or ".", exist_ok=True)
+
+        body = bytearray()
+        max_stored = 0
+        max_raw = 0
+        raw_total = 0
+        prev = None
+        stride = self.w * 2
+        for data, delay in self.frames:
+            if prev is None:
+                x, y, w, h = 0, 0, self.w, self.h
+            else:
+                x, y, w, h = self._changed_rect(prev, data)
+            prev = data
+
+            rows_per_chunk = max(1, chunk_size // (w * 2)) if w else 0
+            chunks = []
+            for r in range(0, h, rows_per_chunk or 1):
+                raw = b"".join(
+                    data[(y + i) * stride + x * 2:(y + i) * stride + (x + w) * 2]
+                    for i in range(r, min(r + rows_per_chunk, h)))
+                if compress == CompressMethod.RLE:
+                    stored = RLEImage().rle_compress(raw, 2)
+                elif compress == CompressMethod.LZ4:
+                    stored = lz4.block.compress(raw, store_size=False)
+                else:
+                    stored = raw
+                max_stored = max(max_stored, len(stored))
+                max_raw = max(max_raw, len(raw))
+                raw_total += len(raw)
+                chunks.append(stored)
+
+            body += uint16_t(x) + uint16_t(y) + uint16_t(w) + uint16_t(h)
+            body += uint16_t(min(delay, 0xffff)) + uint16_t(rows_per_chunk)
+            body += uint16_t(len(chunks)) + uint16_t(0)
+            for c in chunks:
+                body += uint32_t(len(c)) + c
+
+        header = bytearray()
+        header += uint32_t(self.MAGIC)
+        header += uint8_t(self.VERSION)
+        header += uint8_t(ColorFormat.RGB565.value)
+        header += uint8_t(compress.value)
+        header += uint8_t(0)
+        header += uint16_t(self.w) + uint16_t(self.h)
+        header += uint16_t(len(self.frames)) + uint16_t(min(self.loop_count, 0xffff))
+        header += uint32_t(max_stored) + uint32_t(max_raw if compress != CompressMethod.NONE else 0)
+        header += b"\x00" * 8
+
+        with open(filename, "wb") as f:
+            f.write(header)
+            f.write(body)
+
+        full = len(self.frames) * self.w * self.h * 2
+        ram = self.w * self.h * 2 + max_stored + (max_raw if compress != CompressMethod.NONE else 0)
+        logging.info(f"{path.basename(filename)}: {len(self.frames)} frames, "
+                     f"{len(header) + len(body)} bytes on disk ({raw_total} changed of {full} pixel bytes), "
+                     f"{ram} bytes RAM to play")
+
+
 class OutputFormat(Enum):
     C_ARRAY = "C"
     BIN_FILE = "BIN"
     PNG_FILE = "PNG"  # convert to lvgl image and then to png
+    ANIM_FILE = "ANIM"  # pre-decoded animation for lv_sprite_anim
 
 
 class PNGConverter:
@@ -1236,7 +1379,11 @@ class PNGConverter:
     def convert(self):
         output = []
         for f in self.files:
-            if self.cf in (ColorFormat.RAW, ColorFormat.RAW_ALPHA):
+            if self.ofmt == OutputFormat.ANIM_FILE:
+                anim = LVGLAnimation().from_gif(str(f), background=self.background)
+                anim.to_bin(self._replace_ext(str(f), ".anim"),
+                            compress=self.compress)
+            elif self.cf in (ColorFormat.RAW, ColorFormat.RAW_ALPHA):
                 # Process RAW image explicitly
                 img = RAWImage().from_file(f, self.cf)
                 img.to_c_array(self._replace_ext(f, ".c"))
@@ -1261,9 +1408,10 @@ class PNGConverter:
 def main():
     parser = argparse.ArgumentParser(description='LVGL PNG to bin image tool.')
     parser.add_argument('--ofmt',
-                        help="output filename format, C or BIN",
+                        help=("output filename format, C, BIN, PNG or ANIM "
+                              "(pre-decoded RGB565 animation from a GIF)"),
                         default="BIN",
-                        choices=["C", "BIN", "PNG"])
+                        choices=["C", "BIN", "PNG", "ANIM"])
     parser.add_argument(
         '--cf',
         help=("bin image color format, use AUTO for automatically "
@@ -1307,6 +1455,8 @@ def main():
 
     if path.isfile(args.input):
         files = [args.input]
+    elif path.isdir(args.input) and args.ofmt == "ANIM":
+        files = list(Path(args.input).rglob("*.[gG][iI][fF]"))
     elif path.isdir(args.input):
         files = list(Path(args.input).rglob("*.[pP][nN][gG]"))
     else:
@@ -626,11 +626,14 @@ def guard_close():
     print(f"#endif /*{guard}*/\n")
   guard = ""
 
-base_dir = os.path.abspath(os.path.dirname(__file__))
-sys.stdout = open(base_dir + '/../src/core/lv_obj_style_gen.h', 'w')
+def main():
+  global guard
+
+  base_dir = os.path.abspath(os.path.dirname(__file__))
+  sys.stdout = open(base_dir + '/../src/core/lv_obj_style_gen.h', 'w')
 
 
-HEADING = f'''
+  HEADING = f'''
 /*
  **********************************************************************
  *                            DO NOT EDIT
@@ -640,100 +643,104 @@ HEADING = f'''
 
 '''
 
-print(HEADING)
-print('#ifndef LV_OBJ_STYLE_GEN_H')
-print('#define LV_OBJ_STYLE_GEN_H')
-print()
-print('''\
+  print(HEADING)
+  print('#ifndef LV_OBJ_STYLE_GEN_H')
+  print('#define LV_OBJ_STYLE_GEN_H')
+  print()
+  print('''\
 #ifdef __cplusplus
 extern "C" {
 #endif
 ''')
-print("#include \"../misc/lv_area.h\"")
-print("#include \"../misc/lv_style.h\"")
-print("#include \"../core/lv_obj_style.h\"")
-print("#include \"../misc/lv_types.h\"")
-print()
-
-guard = ""
-for p in props:
-  guard_proc(p)
-  obj_style_get(p)
-guard_close()
-
-for p in props:
-  guard_proc(p)
-  local_style_set_h(p)
-guard_close()
-
-print()
-print('''\
+  print("#include \"../misc/lv_area.h\"")
+  print("#include \"../misc/lv_style.h\"")
+  print("#include \"../core/lv_obj_style.h\"")
+  print("#include \"../misc/lv_types.h\"")
+  print()
+
+  guard = ""
+  for p in props:
+    guard_proc(p)
+    obj_style_get(p)
+  guard_close()
+
+  for p in props:
+    guard_proc(p)
+    local_style_set_h(p)
+  guard_close()
+
+  print()
+  print('''\
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
 ''')
 
-print('#endif /* LV_OBJ_STYLE_GEN_H */')
+  print('#endif /* LV_OBJ_STYLE_GEN_H */')
 
-sys.stdout = open(base_dir + '/../src/core/lv_obj_style_gen.c', 'w')
+  sys.stdout = open(base_dir + '/../src/core/lv_obj_style_gen.c', 'w')
 
-print(HEADING)
-print("#include \"lv_obj.h\"")
-print()
+  print(HEADING)
+  print("#include \"lv_obj.h\"")
+  print()
 
-for p in props:
-  guard_proc(p)
-  local_style_set_c(p)
-guard_close()
+  for p in props:
+    guard_proc(p)
+    local_style_set_c(p)
+  guard_close()
 
-sys.stdout = open(base_dir + '/../src/misc/lv_style_gen.c', 'w')
+  sys.stdout = open(base_dir + '/../src/misc/lv_style_gen.c', 'w')
 
-print(HEADING)
-print("#include \"lv_style.h\"")
-print()
+  print(HEADING)
+  print("#include \"lv_style.h\"")
+  print()
 
-for p in props:
-  guard_proc(p)
-  style_set_c(p)
-guard_close()
+  for p in props:
+    guard_proc(p)
+    style_set_c(p)
+  guard_close()
 
-sys.stdout = open(base_dir + '/../src/misc/lv_style_gen.h', 'w')
+  sys.stdout = open(base_dir + '/../src/misc/lv_style_gen.h', 'w')
 
-print(HEADING)
-print('#ifndef LV_STYLE_GEN_H')
-print('#define LV_STYLE_GEN_H')
-print()
-print('''\
+  print(HEADING)
+  print('#ifndef LV_STYLE_GEN_H')
+  print('#define LV_STYLE_GEN_H')
+  print()
+  print('''\
 #ifdef __cplusplus
 extern "C" {
 #endif
 ''')
 
-for p in props:
-  guard_proc(p)
-  style_set_h(p)
-guard_close()
+  for p in props:
+    guard_proc(p)
+    style_set_h(p)
+  guard_close()
 
-for p in props:
-  guard_proc(p)
-  style_const_set(p)
-guard_close()
+  for p in props:
+    guard_proc(p)
+    style_const_set(p)
+  guard_close()
 
-print()
-print('''\
+  print()
+  print('''\
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
 ''')
-print('#endif /* LV_STYLE_GEN_H */')
+  print('#endif /* LV_STYLE_GEN_H */')
+
+  sys.stdout = open(base_dir + '/../docs/details/base-widget/styles/style-properties.rst', 'w')
+
+  print('.. _style_properties:')
+  print()
+  print('================')
+  print('Style Properties')
+  print('================')
 
-sys.stdout = open(base_dir + '/../docs/details/base-widget/styles/style-properties.rst', 'w')
+  for p in props:
+    docs(p)
 
-print('.. _style_properties:')
-print()
-print('================')
-print('Style Properties')
-print('================')
 
-for p in props:
-  docs(p)
+if __name__ == '__main__':
+  main()
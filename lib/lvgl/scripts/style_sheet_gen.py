@@ -0,0 +1,319 @@
+#!/usr/bin/env python3
+
+"""
+Compile a style sheet into constant LVGL styles.
+
+Every style of the sheet becomes a `const lv_style_t` created with `LV_STYLE_CONST_INIT_SORTED`.
+The properties are sorted by their ID, so they are found with binary search, and the style
+tells which property groups it uses. As everything is `const` the styles stay in flash and
+need no heap and no `lv_style_set_...()` calls at startup.
+
+Usage:
+  style_sheet_gen.py styles.lvss -o styles_gen
+
+It writes `styles_gen.c` and `styles_gen.h`.
+
+A style sheet looks like this:
+
+  /* The bar at the top of the screen */
+  nav_style {
+      pad_hor: 0;
+      pad_ver: 8;
+      size: 320 40;               /* Shorthands of lv_style.h: size, pad_all/hor/ver/gap, margin_all, transform_scale */
+      bg_color: #1c0126;          /* Colors: #rrggbb, rgb(r, g, b) or a constant expression */
+      bg_opa: COVER;              /* Numbers: integers, 50%, enum values without their LV_..._ prefix or a constant expression */
+      text_font: &lv_font_montserrat_14;
+  }
+
+The property names are the ones of `lv_style_set_<name>()`. A property set twice takes the last value.
+The comment right before a style is copied to the header.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+from style_api_gen import props
+
+# Shorthands setting every property to the same value
+SHORTHANDS = {
+  'pad_all': ['PAD_TOP', 'PAD_BOTTOM', 'PAD_LEFT', 'PAD_RIGHT'],
+  'pad_hor': ['PAD_LEFT', 'PAD_RIGHT'],
+  'pad_ver': ['PAD_TOP', 'PAD_BOTTOM'],
+  'pad_gap': ['PAD_ROW', 'PAD_COLUMN'],
+  'margin_all': ['MARGIN_TOP', 'MARGIN_BOTTOM', 'MARGIN_LEFT', 'MARGIN_RIGHT'],
+  'transform_scale': ['TRANSFORM_SCALE_X', 'TRANSFORM_SCALE_Y'],
+}
+
+# Shorthands taking one value per property
+SPLIT_SHORTHANDS = {
+  'size': ['WIDTH', 'HEIGHT'],
+}
+
+
+class SheetError(Exception):
+  pass
+
+
+def read_prop_ids(style_h):
+  """Read the IDs of the built-in properties from the enum in lv_style.h"""
+  ids = {}
+  with open(style_h) as f:
+    for m in re.finditer(r'^\s*LV_STYLE_(\w+)\s*=\s*(\d+)\s*,', f.read(), re.MULTILINE):
+      ids[m.group(1)] = int(m.group(2))
+  return ids
+
+
+def prop_group(prop_id):
+  """The same as lv_style_get_prop_group()"""
+  return min(prop_id >> 2, 31)
+
+
+def prop_table():
+  """Map the property names to their descriptor in style_api_gen.py and the guard they are in"""
+  table = {}
+  guard = None
+  for p in props:
+    if 'section' in p:
+      guard = p.get('guard')
+      continue
+    table[p['name']] = (p, guard)
+  return table
+
+
+def strip_comments(text):
+  """Remove the comments but keep the line count, and remember the comment ending on each line"""
+  out = []
+  comments = {}
+  pos = 0
+  for m in re.finditer(r'/\*.*?\*/', text, re.DOTALL):
+    out.append(text[pos:m.start()])
+    out.append('\n' * m.group(0).count('\n'))
+    line = text.count('\n', 0, m.end()) + 1
+    comments[line] = m.group(0)[2:-2].strip()
+    pos = m.end()
+  out.append(text[pos:])
+  return ''.join(out), comments
+
+
+def parse_sheet(path):
+  """Return a list of (name, comment, [(prop_name, value, line)]) in the order of the sheet"""
+  with open(path) as f:
+    text, comments = strip_comments(f.read())
+
+  styles = []
+  for m in re.finditer(r'([A-Za-z_]\w*)\s*\{([^}]*)\}', text):
+    line = text.count('\n', 0, m.start()) + 1
+    decls = []
+    body_line = text.count('\n', 0, m.start(2)) + 1
+    for decl in m.group(2).split(';'):
+      decl_line = body_line + decl[:len(decl) - len(decl.lstrip())].count('\n')
+      body_line += decl.count('\n')
+      if not decl.strip():
+        continue
+      if ':' not in decl:
+        raise SheetError(f"{path}:{decl_line}: expected 'property: value'")
+      name, value = decl.split(':', 1)
+      decls.append((name.strip(), value.strip(), decl_line))
+
+    comment = comments.get(line) or comments.get(line - 1)
+    styles.append((m.group(1), comment, decls))
+
+  rest = re.sub(r'([A-Za-z_]\w*)\s*\{([^}]*)\}', '', text)
+  if rest.strip():
+    raise SheetError(f"{path}: unexpected text outside of the styles: '{rest.strip()[:40]}'")
+
+  return styles
+
+
+def enum_prefix(c_type):
+  """The prefix of the enum values of a type, e.g. `LV_TEXT_ALIGN_` of `lv_text_align_t`"""
+  m = re.fullmatch(r'(?:const\s+)?lv_(\w+)_t', c_type.strip())
+  return f"LV_{m.group(1).upper()}_" if m else None
+
+
+def convert_enum(c_type, value):
+  """Add the prefix to an enum value given without it, e.g. CENTER -> LV_TEXT_ALIGN_CENTER"""
+  prefix = enum_prefix(c_type)
+  if prefix and re.fullmatch(r'[A-Z][A-Z0-9_]*', value) and not value.startswith('LV_'):
+    return prefix + value
+  return value
+
+
+def convert_value(p, value, where):
+  """Turn a value of the sheet into a C constant expression"""
+  style_type = p['style_type']
+  m = re.fullmatch(r'#([0-9a-fA-F]{6})', value)
+  if m:
+    if style_type != 'color':
+      raise SheetError(f"{where}: a color is given to a non-color property")
+    h = m.group(1)
+    return f"LV_COLOR_MAKE(0x{h[0:2]}, 0x{h[2:4]}, 0x{h[4:6]})"
+
+  m = re.fullmatch(r'rgb\(\s*(\d+)\s*,\s*(\d+)\s*,\s*(\d+)\s*\)', value)
+  if m:
+    if style_type != 'color':
+      raise SheetError(f"{where}: a color is given to a non-color property")
+    return f"LV_COLOR_MAKE({m.group(1)}, {m.group(2)}, {m.group(3)})"
+
+  m = re.fullmatch(r'(-?\d+)%', value)
+  if m:
+    if style_type != 'num':
+      raise SheetError(f"{where}: a percentage is given to a non-numeric property")
+    return f"LV_PCT({m.group(1)})"
+
+  if not value:
+    raise SheetError(f"{where}: missing value")
+
+  if style_type == 'num':
+    return convert_enum(p['var_type'], value)
+
+  return value
+
+
+def split_values(value):
+  """Split a value at the spaces which are not in parentheses or quotes"""
+  values = []
+  depth = 0
+  quote = None
+  cur = ''
+  for c in value:
+    if quote:
+      if c == quote and not cur.endswith('\\'):
+        quote = None
+    elif c in '"\'':
+      quote = c
+    elif c == '(':
+      depth += 1
+    elif c == ')':
+      depth -= 1
+    elif c.isspace() and depth == 0:
+      if cur:
+        values.append(cur)
+      cur = ''
+      continue
+    cur += c
+  if cur:
+    values.append(cur)
+  return values
+
+
+def compile_style(name, decls, table, ids, path, split_shorthands=SPLIT_SHORTHANDS):
+  """Return the sorted list of (prop_id, prop_name, c_value, guard) of a style"""
+  resolved = {}
+  for prop_name, value, line in decls:
+    where = f"{path}:{line}"
+    key = prop_name.lower()
+    if key in split_shorthands:
+      targets = split_shorthands[key]
+      values = split_values(value)
+      if len(values) != len(targets):
+        raise SheetError(f"{where}: '{prop_name}' needs {len(targets)} values")
+    elif key in SHORTHANDS:
+      targets = SHORTHANDS[key]
+      values = [value] * len(targets)
+    else:
+      targets = [key.upper()]
+      values = [value]
+
+    for target, v in zip(targets, values):
+      if target not in table or target not in ids:
+        raise SheetError(f"{where}: unknown property '{prop_name}'")
+      p, guard = table[target]
+      resolved[target] = (ids[target], target, convert_value(p, v, where), guard)
+
+  if not resolved:
+    raise SheetError(f"{path}: style '{name}' has no properties")
+
+  return sorted(resolved.values())
+
+
+HEADING = '''\
+/*
+ **********************************************************************
+ *                            DO NOT EDIT
+ * This file is automatically generated by "{script}"
+ * from "{sheet}"
+ **********************************************************************
+ */
+'''
+
+
+def write_header(f, guard_name, styles, heading):
+  f.write(heading)
+  f.write(f"\n#ifndef {guard_name}\n#define {guard_name}\n\n")
+  f.write('#ifdef __cplusplus\nextern "C" {\n#endif\n\n')
+  f.write('#include "lvgl.h"\n\n')
+  for name, comment, _ in styles:
+    if comment:
+      f.write("/** " + comment.replace('\n', '\n * ') + " */\n")
+    f.write(f"extern const lv_style_t {name};\n\n")
+  f.write('#ifdef __cplusplus\n} /*extern "C"*/\n#endif\n\n')
+  f.write(f"#endif /*{guard_name}*/\n")
+
+
+def write_source(f, header_name, compiled, heading):
+  f.write(heading)
+  f.write(f'\n#include "{header_name}"\n')
+  for name, entries in compiled:
+    # The lookup probes the indices 0, 1, 3, 7... until the end marker, so pad to a power of 2.
+    # The missing entries are zero, i.e. LV_STYLE_PROP_INV
+    size = 1
+    while size < len(entries) + 1:
+      size <<= 1
+
+    groups = 0
+    for prop_id, _, _, _ in entries:
+      groups |= 1 << prop_group(prop_id)
+
+    f.write(f"\nstatic const lv_style_const_prop_t {name}_props[{size}] = {{\n")
+    for _, prop, value, guard in entries:
+      if guard:
+        f.write(f"#if {guard}\n")
+      f.write(f"    LV_STYLE_CONST_{prop}({value}),\n")
+      if guard:
+        f.write("#endif\n")
+    f.write("    LV_STYLE_CONST_PROPS_END\n};\n\n")
+    f.write(f"LV_STYLE_CONST_INIT_SORTED({name}, {name}_props, 0x{groups:08X});\n")
+
+
+def main():
+  base_dir = os.path.abspath(os.path.dirname(__file__))
+
+  parser = argparse.ArgumentParser(description='Compile a style sheet into constant LVGL styles')
+  parser.add_argument('sheet', help='the style sheet')
+  parser.add_argument('-o', '--output', required=True,
+                      help='path of the output files without extension, .c and .h are appended')
+  parser.add_argument('--style-h', default=os.path.join(base_dir, '../src/misc/lv_style.h'),
+                      help='lv_style.h to read the property IDs from')
+  args = parser.parse_args()
+
+  try:
+    ids = read_prop_ids(args.style_h)
+    table = prop_table()
+    styles = parse_sheet(args.sheet)
+
+    seen = set()
+    compiled = []
+    for name, _, decls in styles:
+      if name in seen:
+        raise SheetError(f"{args.sheet}: style '{name}' is defined twice")
+      seen.add(name)
+      compiled.append((name, compile_style(name, decls, table, ids, args.sheet)))
+  except SheetError as e:
+    print(f"error: {e}", file=sys.stderr)
+    sys.exit(1)
+
+  heading = HEADING.format(script=os.path.basename(__file__), sheet=os.path.basename(args.sheet))
+  header_name = os.path.basename(args.output) + '.h'
+  guard_name = re.sub(r'\W', '_', header_name).upper()
+
+  with open(args.output + '.h', 'w') as f:
+    write_header(f, guard_name, styles, heading)
+  with open(args.output + '.c', 'w') as f:
+    write_source(f, header_name, compiled, heading)
+
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,460 @@
+#!/usr/bin/env python3
+
+"""
+Compile a UI description into the C code building its screens.
+
+For every screen a `lv_obj_t * <screen>_create(void)` function is generated. It creates the objects
+in a style batch (see `lv_obj_begin_style_batch`), so styles, sizes and invalidations are refreshed
+only once per object when the screen is complete instead of after every setting. The style properties
+of an object are collected into sorted constant styles (see `style_sheet_gen.py`), so they need no heap
+and are added with a single `lv_obj_add_style()` call per part. Only the other settings become calls.
+
+Usage:
+  ui_tree_gen.py screens.lvui -o screens_gen
+
+It writes `screens_gen.c` and `screens_gen.h`.
+
+A UI description looks like this:
+
+  include "styles_gen.h";           /* Included by the generated .c file */
+
+  /* The first screen */
+  screen home_page {
+      bg_color: #000000;            /* Style properties and shorthands as in style sheets, plus `align: <align> <x> <y>` and `pos: <x> <y>` */
+
+      obj nav_bar {                 /* <widget type> [name]. Named objects are exported as `lv_obj_t * <name>` */
+          style: nav_style;         /* Add a style */
+          scrollbar_mode: OFF;      /* Others call `lv_<type>_set_<key>(obj, ...)` or `lv_<type>_<key>(obj, ...)` */
+          remove_style_all;         /* of the widget or one of its base classes, chosen by the number of arguments */
+
+          label {
+              text: LV_SYMBOL_HOME " Home";
+              align: LEFT_MID 0 0;
+          }
+      }
+
+      table {
+          column_width: 0 180;      /* Arguments are separated by spaces */
+          items pressed {           /* Part and state of the settings inside */
+              bg_color: #00ff32;
+          }
+      }
+  }
+
+Objects shared by all screens, e.g. a header, can be built on the top, sys or bottom layer of the
+default display with `layer <top|sys|bottom> <name> { ... }`. Its `<name>_create()` returns the layer.
+They stay in place on screen changes, and where they are opaque the screens are not redrawn.
+
+Enum arguments can be given without their prefix (e.g. `OFF` for `LV_SCROLLBAR_MODE_OFF`).
+The comment right before a screen or a named object is copied to the header.
+"""
+
+import argparse
+import glob
+import os
+import re
+import sys
+
+from style_sheet_gen import (SheetError, SHORTHANDS, SPLIT_SHORTHANDS, strip_comments, read_prop_ids, prop_table,
+                             compile_style, split_values, enum_prefix, prop_group)
+
+# Shorthands of the UI description for the settings of `lv_obj_align()` and `lv_obj_set_pos()`
+UI_SPLIT_SHORTHANDS = dict(SPLIT_SHORTHANDS, align=['ALIGN', 'X', 'Y'], pos=['X', 'Y'])
+
+PARTS = ['main', 'scrollbar', 'indicator', 'knob', 'selected', 'items', 'cursor']
+STATES = ['checked', 'focused', 'focus_key', 'edited', 'hovered', 'pressed', 'scrolled', 'disabled',
+          'user_1', 'user_2', 'user_3', 'user_4']
+
+
+class Obj:
+  def __init__(self, type, name, line, comment):
+    self.type = type
+    self.name = name
+    self.line = line
+    self.comment = comment
+    self.stmts = []       # (selector, key, value or None, line)
+    self.children = []
+    self.var = None
+    self.layer = None     # 'top', 'sys' or 'bottom' if the object is a display layer
+
+
+class Parser:
+  """Parse the nested blocks of a UI description"""
+
+  def __init__(self, path):
+    self.path = path
+    with open(path) as f:
+      self.text, self.comments = strip_comments(f.read())
+    self.pos = 0
+
+  def line(self, pos=None):
+    return self.text.count('\n', 0, self.pos if pos is None else pos) + 1
+
+  def error(self, msg, line=None):
+    return SheetError(f"{self.path}:{line or self.line()}: {msg}")
+
+  def skip_space(self):
+    while self.pos < len(self.text) and self.text[self.pos].isspace():
+      self.pos += 1
+
+  def read_until(self, stops):
+    """Read until one of the `stops` characters outside of quotes and parentheses"""
+    start = self.pos
+    depth = 0
+    quote = None
+    while self.pos < len(self.text):
+      c = self.text[self.pos]
+      if quote:
+        if c == '\\':
+          self.pos += 1
+        elif c == quote:
+          quote = None
+      elif c in '"\'':
+        quote = c
+      elif c == '(':
+        depth += 1
+      elif c == ')':
+        depth -= 1
+      elif depth == 0 and c in stops:
+        return self.text[start:self.pos].strip(), c
+      self.pos += 1
+    raise self.error("unexpected end of file")
+
+  def parse(self):
+    """Return the includes and the screens"""
+    includes = []
+    screens = []
+    while True:
+      self.skip_space()
+      if self.pos >= len(self.text):
+        break
+      start = self.pos
+      head, stop = self.read_until('{;')
+      self.pos += 1
+      words = head.split(None, 1)
+      line = self.line(start)
+      if stop == ';' and words and words[0] == 'include' and len(words) == 2:
+        includes.append(words[1])
+      elif stop == '{' and len(words) == 2 and words[0] == 'screen' and re.fullmatch(r'[A-Za-z_]\w*', words[1]):
+        screen = Obj('obj', words[1], line, self.comment(line))
+        self.parse_block(screen, '0')
+        screens.append(screen)
+      elif (stop == '{' and len(words) == 2 and words[0] == 'layer' and
+            re.fullmatch(r'(top|sys|bottom)\s+[A-Za-z_]\w*', words[1])):
+        which, name = words[1].split()
+        screen = Obj('obj', name, line, self.comment(line))
+        screen.layer = which
+        self.parse_block(screen, '0')
+        screens.append(screen)
+      else:
+        raise self.error(f"expected 'screen <name> {{', 'layer <top|sys|bottom> <name> {{' or "
+                         f"'include \"<file>\";', found '{head}'", line)
+    return includes, screens
+
+  def comment(self, line):
+    return self.comments.get(line) or self.comments.get(line - 1)
+
+  def parse_block(self, obj, selector):
+    while True:
+      self.skip_space()
+      if self.pos >= len(self.text):
+        raise self.error("missing '}'")
+      if self.text[self.pos] == '}':
+        self.pos += 1
+        return
+
+      start = self.pos
+      head, stop = self.read_until('{;:')
+      self.pos += 1
+      line = self.line(start)
+      words = head.split()
+
+      if stop == '{':
+        if words and all(w in PARTS or w in STATES for w in words):
+          if selector != '0':
+            raise self.error("parts and states can't be nested", line)
+          flags = [f"LV_PART_{w.upper()}" if w in PARTS else f"LV_STATE_{w.upper()}" for w in words]
+          self.parse_block(obj, ' | '.join(flags))
+        elif len(words) in (1, 2) and all(re.fullmatch(r'[A-Za-z_]\w*', w) for w in words):
+          if selector != '0':
+            raise self.error("objects can't be created in a part or state block", line)
+          child = Obj(words[0], words[1] if len(words) == 2 else None, line, self.comment(line))
+          self.parse_block(child, '0')
+          obj.children.append(child)
+        else:
+          raise self.error(f"expected '<type> [name] {{' or '<part/state> {{', found '{head}'", line)
+      elif stop == ':':
+        value, _ = self.read_until(';')
+        self.pos += 1
+        if len(words) != 1:
+          raise self.error(f"expected a single name before ':', found '{head}'", line)
+        if not value:
+          raise self.error(f"missing value of '{head}'", line)
+        obj.stmts.append((selector, words[0], value, line))
+      else:
+        if len(words) != 1:
+          raise self.error(f"expected '<name>;', found '{head}'", line)
+        obj.stmts.append((selector, words[0], None, line))
+
+
+class Api:
+  """The functions, widget classes and constants found in the LVGL headers and sources"""
+
+  def __init__(self, src_dir):
+    self.funcs = {}
+    self.consts = set()
+    self.base = {}
+
+    proto = re.compile(r'^[ \t]*(?:[A-Za-z_][\w \t]*?[\s\*]+)(lv_\w+)\s*\(([^;{}()]*)\)\s*;', re.MULTILINE)
+    for path in glob.glob(os.path.join(src_dir, '**', '*.h'), recursive=True):
+      with open(path, errors='replace') as f:
+        text = f.read()
+      for m in proto.finditer(text):
+        params = [p.strip() for p in m.group(2).split(',')]
+        if params == ['void']:
+          params = []
+        self.funcs.setdefault(m.group(1), [re.sub(r'\b\w+$', '', p).strip() if p != '...' else p for p in params])
+      self.consts.update(re.findall(r'\b(LV_[A-Z0-9_]+)\b', text))
+
+    cls = re.compile(r'lv_obj_class_t\s+lv_(\w+)_class\s*=\s*\{[^}]*?\.base_class\s*=\s*&lv_(\w+)_class', re.DOTALL)
+    for path in glob.glob(os.path.join(src_dir, '**', '*.c'), recursive=True):
+      with open(path, errors='replace') as f:
+        for m in cls.finditer(f.read()):
+          self.base[m.group(1)] = m.group(2)
+
+  def class_chain(self, type):
+    chain = [type]
+    while chain[-1] in self.base and self.base[chain[-1]] not in chain:
+      chain.append(self.base[chain[-1]])
+    if 'obj' not in chain:
+      chain.append('obj')
+    return chain
+
+  def find(self, type, key, arg_cnt):
+    """Find the function for a setting of an object with `arg_cnt` arguments"""
+    for cls in self.class_chain(type):
+      for name in (f"lv_{cls}_set_{key}", f"lv_{cls}_{key}"):
+        params = self.funcs.get(name)
+        if params is None or not params or not params[0].startswith('lv_obj_t'):
+          continue
+        if len(params) == arg_cnt + 1 or ('...' in params and arg_cnt + 1 >= len(params) - 1):
+          return name, params[1:]
+    return None, None
+
+  def enum(self, c_type, value):
+    """Add the prefix to an enum value given without it, e.g. OFF -> LV_SCROLLBAR_MODE_OFF.
+    Try shorter prefixes if needed, e.g. ON -> LV_ANIM_ON for lv_anim_enable_t"""
+    prefix = enum_prefix(c_type)
+    if not prefix or not re.fullmatch(r'[A-Z][A-Z0-9_]*', value) or value.startswith('LV_'):
+      return value
+    words = prefix.rstrip('_').split('_')
+    while len(words) > 1:
+      name = '_'.join(words) + '_' + value
+      if name in self.consts:
+        return name
+      words.pop()
+    return prefix + value
+
+
+def convert_arg(api, c_type, value):
+  """Turn an argument of a call into a C expression"""
+  m = re.fullmatch(r'#([0-9a-fA-F]{6})', value)
+  if m:
+    return f"lv_color_hex(0x{m.group(1)})"
+  m = re.fullmatch(r'rgb\(\s*(\d+)\s*,\s*(\d+)\s*,\s*(\d+)\s*\)', value)
+  if m:
+    return f"lv_color_make({m.group(1)}, {m.group(2)}, {m.group(3)})"
+  m = re.fullmatch(r'(-?\d+)%', value)
+  if m:
+    return f"LV_PCT({m.group(1)})"
+  return api.enum(c_type, value)
+
+
+def join_strings(args):
+  """Join the arguments which are concatenated strings in C, e.g. LV_SYMBOL_WIFI " Loading..." """
+  out = []
+  for a in args:
+    if out and (a.startswith('"') or out[-1].endswith('"')) and \
+       (re.fullmatch(r'[A-Za-z_]\w*', a) or re.fullmatch(r'[A-Za-z_]\w*', out[-1]) or
+        (a.startswith('"') and out[-1].endswith('"'))):
+      out[-1] += ' ' + a
+    else:
+      out.append(a)
+  return out
+
+
+class Generator:
+  def __init__(self, path, api, table, ids):
+    self.path = path
+    self.api = api
+    self.table = table
+    self.ids = ids
+    self.exported = []
+    self.styles = []      # The C code of the constant styles
+    self.code = []        # The C code of the current create function
+    self.counter = 0
+
+  def is_style_setting(self, key, value):
+    key = key.lower()
+    cnt = len(split_values(value))
+    if key in UI_SPLIT_SHORTHANDS and cnt == len(UI_SPLIT_SHORTHANDS[key]):
+      return True
+    return cnt == 1 and (key in SHORTHANDS or key.upper() in self.table)
+
+  def add_const_style(self, var, selector, decls):
+    entries = compile_style(var, decls, self.table, self.ids, self.path, UI_SPLIT_SHORTHANDS)
+    size = 1
+    while size < len(entries) + 1:
+      size <<= 1
+    groups = 0
+    for prop_id, _, _, _ in entries:
+      groups |= 1 << prop_group(prop_id)
+
+    sel_name = '_'.join(w[len('LV_PART_'):].lower() if w.startswith('LV_PART_') else w[len('LV_STATE_'):].lower()
+                        for w in selector.split(' | ')) if selector != '0' else 'main'
+    name = f"{var}_{sel_name}"
+    lines = [f"static const lv_style_const_prop_t {name}_props[{size}] = {{"]
+    for _, prop, value, guard in entries:
+      if guard:
+        lines.append(f"#if {guard}")
+      lines.append(f"    LV_STYLE_CONST_{prop}({value}),")
+      if guard:
+        lines.append("#endif")
+    lines.append("    LV_STYLE_CONST_PROPS_END")
+    lines.append("};")
+    lines.append("")
+    lines.append(f"static LV_STYLE_CONST_INIT_SORTED({name}_style, {name}_props, 0x{groups:08X});")
+    self.styles.append('\n'.join(lines))
+    return f"{name}_style"
+
+  def emit_obj(self, obj, parent_var, screen):
+    if obj.name:
+      obj.var = obj.name
+      if obj.name in (o.name for o in self.exported):
+        raise SheetError(f"{self.path}:{obj.line}: '{obj.name}' is defined twice")
+      self.exported.append(obj)
+    else:
+      self.counter += 1
+      obj.var = f"{obj.type}_{self.counter}"
+
+    create = f"lv_{obj.type}_create"
+    if create not in self.api.funcs:
+      raise SheetError(f"{self.path}:{obj.line}: unknown widget type '{obj.type}', `{create}()` doesn't exist")
+
+    decl = '' if obj.name else 'lv_obj_t * '
+    if obj.layer:
+      self.code.append(f"    {decl}{obj.var} = lv_layer_{obj.layer}();")
+    else:
+      self.code.append(f"    {decl}{obj.var} = {create}({parent_var});")
+
+    # The style properties of each part and state are collected, the rest is called in order
+    props = {}
+    for selector, key, value, line in obj.stmts:
+      where = f"{self.path}:{line}"
+      if key == 'style':
+        if value is None:
+          raise SheetError(f"{where}: 'style' needs the name of a style")
+        for style in split_values(value):
+          self.code.append(f"    lv_obj_add_style({obj.var}, &{style}, {selector});")
+      elif value is not None and self.is_style_setting(key, value):
+        props.setdefault(selector, []).append((key, value, line))
+      else:
+        if selector != '0':
+          raise SheetError(f"{where}: only style properties and styles can be set in a part or state block")
+        args = join_strings(split_values(value)) if value is not None else []
+        func, params = self.api.find(obj.type, key, len(args))
+        if func is None:
+          raise SheetError(f"{where}: '{key}' with {len(args)} argument(s) is neither a style property "
+                           f"nor a function of '{obj.type}'")
+        args = [convert_arg(self.api, params[i] if i < len(params) else '', a) for i, a in enumerate(args)]
+        self.code.append(f"    {func}({', '.join([obj.var] + args)});")
+
+    for selector, decls in props.items():
+      style = self.add_const_style(obj.name or f"{screen.name}_{obj.var}", selector, decls)
+      self.code.append(f"    lv_obj_add_style({obj.var}, &{style}, {selector});")
+
+    for child in obj.children:
+      self.code.append("")
+      self.emit_obj(child, obj.var, screen)
+
+  def emit_screen(self, screen):
+    self.code = []
+    self.counter = 0
+    self.emit_obj(screen, 'NULL', screen)
+    body = '\n'.join(self.code)
+    return (f"lv_obj_t * {screen.name}_create(void)\n{{\n"
+            f"    lv_obj_begin_style_batch();\n\n{body}\n\n"
+            f"    lv_obj_commit_style_batch({screen.name});\n"
+            f"    return {screen.name};\n}}\n")
+
+
+HEADING = '''\
+/*
+ **********************************************************************
+ *                            DO NOT EDIT
+ * This file is automatically generated by "{script}"
+ * from "{ui}"
+ **********************************************************************
+ */
+'''
+
+
+def doc(comment):
+  return "/** " + comment.replace('\n', '\n * ') + " */\n" if comment else ''
+
+
+def main():
+  base_dir = os.path.abspath(os.path.dirname(__file__))
+
+  parser = argparse.ArgumentParser(description='Compile a UI description into the C code building its screens')
+  parser.add_argument('ui', help='the UI description')
+  parser.add_argument('-o', '--output', required=True,
+                      help='path of the output files without extension, .c and .h are appended')
+  parser.add_argument('--src', default=os.path.join(base_dir, '../src'),
+                      help="LVGL's src directory to find the widgets and their functions in")
+  args = parser.parse_args()
+
+  try:
+    includes, screens = Parser(args.ui).parse()
+    api = Api(args.src)
+    gen = Generator(args.ui, api, prop_table(), read_prop_ids(os.path.join(args.src, 'misc/lv_style.h')))
+    functions = [gen.emit_screen(s) for s in screens]
+  except SheetError as e:
+    print(f"error: {e}", file=sys.stderr)
+    sys.exit(1)
+
+  heading = HEADING.format(script=os.path.basename(__file__), ui=os.path.basename(args.ui))
+  header_name = os.path.basename(args.output) + '.h'
+  guard_name = re.sub(r'\W', '_', header_name).upper()
+
+  with open(args.output + '.h', 'w') as f:
+    f.write(heading)
+    f.write(f"\n#ifndef {guard_name}\n#define {guard_name}\n\n")
+    f.write('#ifdef __cplusplus\nextern "C" {\n#endif\n\n')
+    f.write('#include "lvgl.h"\n\n')
+    for screen in screens:
+      f.write(doc(screen.comment))
+      f.write(f"lv_obj_t * {screen.name}_create(void);\n\n")
+    f.write("/* The named objects. Set by the `..._create()` function of their screen */\n\n")
+    for obj in gen.exported:
+      f.write(doc(obj.comment))
+      f.write(f"extern lv_obj_t * {obj.name};\n")
+    f.write('\n#ifdef __cplusplus\n} /*extern "C"*/\n#endif\n\n')
+    f.write(f"#endif /*{guard_name}*/\n")
+
+  with open(args.output + '.c', 'w') as f:
+    f.write(heading)
+    f.write(f'\n#include "{header_name}"\n')
+    for inc in includes:
+      f.write(f"#include {inc}\n")
+    f.write('\n')
+    for obj in gen.exported:
+      f.write(f"lv_obj_t * {obj.name};\n")
+    for style in gen.styles:
+      f.write('\n' + style + '\n')
+    for func in functions:
+      f.write('\n' + func)
+
+
+if __name__ == '__main__':
+  main()
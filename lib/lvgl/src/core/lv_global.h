@@ -31,7 +31,7 @@ extern "C" {
 #include "../others/sysmon/lv_sysmon.h"
 #include "../stdlib/builtin/lv_tlsf.h"
 
-#if LV_USE_FONT_COMPRESSED
+#if LV_USE_FONT_COMPRESSED || LV_USE_FONT_FMT_TXT_GID_TABLE
 #include "../font/lv_font_fmt_txt_private.h"
 #endif
 
@@ -86,6 +86,7 @@ typedef struct _lv_global_t {
 
     lv_ll_t style_trans_ll;
     bool style_refresh;
+    bool style_batch;
     uint32_t style_custom_table_size;
     uint32_t style_last_custom_prop_id;
     uint8_t * style_custom_prop_flag_lookup_table;
@@ -115,11 +116,15 @@ typedef struct _lv_global_t {
     lv_draw_buf_handlers_t font_draw_buf_handlers;
     lv_draw_buf_handlers_t image_cache_draw_buf_handlers;  /**< Ensure that all assigned draw buffers
                                                             * can be managed by image cache. */
+#if LV_DRAW_LAYER_BUF_POOL_SIZE
+    lv_draw_buf_pool_t draw_buf_pool;
+#endif
 
     lv_ll_t img_decoder_ll;
 
     lv_cache_t * img_cache;
     lv_cache_t * img_header_cache;
+    uint32_t (*img_cache_clock_cb)(void);   /**< Microsecond clock used to weigh cached images by decode time */
 
     lv_draw_global_info_t draw_info;
 #if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
@@ -127,6 +132,12 @@ typedef struct _lv_global_t {
 #endif
 #if LV_DRAW_SW_COMPLEX
     lv_draw_sw_mask_radius_circle_dsc_arr_t sw_circle_cache;
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+    lv_cache_t * sw_mask_cache;
+#endif
+#endif
+#if LV_USE_DRAW_SW && LV_DRAW_SW_GRADIENT_CACHE_SIZE
+    lv_cache_t * sw_grad_cache;
 #endif
 
 #if LV_USE_LOG
@@ -189,10 +200,32 @@ typedef struct _lv_global_t {
     lv_font_fmt_rle_t font_fmt_rle;
 #endif
 
+#if LV_USE_FONT_FMT_TXT_GID_TABLE
+    lv_ll_t font_fmt_txt_gid_ll;                            /**< lv_font_fmt_txt_gid_table_t per used font*/
+    lv_font_fmt_txt_gid_table_t * font_fmt_txt_gid_last;    /**< The table used last, checked first*/
+    lv_mutex_t font_fmt_txt_gid_lock;
+#endif
+
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    uint32_t style_res_hits;
+    uint32_t style_res_misses;
+    uint32_t style_res_evictions;
+#endif
+
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    lv_cache_t * text_layout_cache;
+    uint32_t (*text_layout_clock_cb)(void);         /**< Measures the layout time of the texts*/
+    uint64_t text_layout_saved;                     /**< Layout time saved by the hits*/
+#endif
+
 #if LV_USE_SPAN != 0
     struct _snippet_stack * span_snippet_stack;
 #endif
 
+#if LV_USE_NUMLABEL
+    lv_ll_t numlabel_strip_ll;      /**< lv_numlabel_strip_t per font used by numeric labels*/
+#endif
+
 #if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
     struct _lv_profiler_builtin_ctx_t * profiler_context;
 #endif
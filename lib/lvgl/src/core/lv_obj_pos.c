@@ -16,6 +16,9 @@
 #include "../display/lv_display_private.h"
 #include "lv_refr_private.h"
 #include "../core/lv_global.h"
+#if LV_USE_PAGE_CACHE
+#include "../others/page_cache/lv_page_cache_private.h"
+#endif
 
 /*********************
  *      DEFINES
@@ -824,6 +827,12 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
     lv_display_t * disp   = lv_obj_get_display(obj);
+
+#if LV_USE_PAGE_CACHE
+    /*Cached images get outdated even if the screen is not shown or invalidation is disabled*/
+    lv_page_cache_report_change(disp, obj, area);
+#endif
+
     if(!lv_display_is_invalidation_enabled(disp)) return;
 
     lv_area_t area_tmp;
@@ -887,10 +896,7 @@ bool lv_obj_area_is_visible(const lv_obj_t * obj, lv_area_t * area)
     /*The area is not on the object*/
     if(!lv_area_intersect(area, area, &obj_coords)) return false;
 
-    if(!is_transformed(obj)) {
-        *area = obj_coords;
-    }
-    else {
+    if(is_transformed(obj)) {
         lv_obj_get_transformed_area(obj, area, LV_OBJ_POINT_TRANSFORM_FLAG_RECURSIVE);
     }
 
@@ -57,6 +57,9 @@ struct _lv_obj_t {
 #if LV_OBJ_STYLE_CACHE
     uint32_t style_main_prop_is_set;
     uint32_t style_other_prop_is_set;
+#endif
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    lv_obj_style_resolved_t * style_res;     /**< Resolved style values, one block per part and state*/
 #endif
     void * user_data;
 #if LV_USE_OBJ_ID
@@ -15,14 +15,18 @@
 #include "../misc/lv_color.h"
 #include "../stdlib/lv_string.h"
 #include "../core/lv_global.h"
+#include "../misc/cache/lv_cache.h"
 /*********************
  *      DEFINES
  *********************/
 #define MY_CLASS (&lv_obj_class)
 #define style_refr LV_GLOBAL_DEFAULT()->style_refresh
+#define style_batch LV_GLOBAL_DEFAULT()->style_batch
 #define style_trans_ll_p &(LV_GLOBAL_DEFAULT()->style_trans_ll)
 #define _style_custom_prop_flag_lookup_table LV_GLOBAL_DEFAULT()->style_custom_prop_flag_lookup_table
 #define STYLE_PROP_SHIFTED(prop) ((uint32_t)1 << ((prop) >> 3))
+#define STYLE_RES_BLOCK_MAX 4         /*Parts and states kept per object*/
+#define STYLE_RES_GROW      8         /*Grow the value arrays by this many values*/
 
 /**********************
  *      TYPEDEFS
@@ -57,6 +61,7 @@ static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_style_selector_t se
                                     lv_style_value_t * v);
 static void report_style_change_core(void * style, lv_obj_t * obj);
 static void refresh_children_style(lv_obj_t * obj);
+static void refresh_batch_style(lv_obj_t * obj);
 static bool trans_delete(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, trans_t * tr_limit);
 static void trans_anim_cb(void * _tr, int32_t v);
 static void trans_anim_start_cb(lv_anim_t * a);
@@ -68,6 +73,12 @@ static void fade_in_anim_completed(lv_anim_t * a);
 static bool style_has_flag(const lv_style_t * style, uint32_t flag);
 static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                               lv_style_value_t * value_act);
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    static lv_obj_style_resolved_t * style_res_get_block(lv_obj_t * obj, lv_style_selector_t selector);
+    static uint32_t style_res_get_index(const lv_obj_style_resolved_t * res, lv_style_prop_t prop);
+    static void style_res_add(lv_obj_style_resolved_t * res, lv_style_prop_t prop, lv_style_value_t value);
+    static void style_res_invalidate(lv_obj_t * obj, bool recursive);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -260,7 +271,20 @@ void lv_obj_remove_style_all(lv_obj_t * obj)
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
-    if(!style_refr) return;
+    if(!style_refr || style_batch) {
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+        /*The affected objects are not visited now, so forget the resolved values of every object*/
+        lv_display_t * d;
+        for(d = lv_display_get_next(NULL); d; d = lv_display_get_next(d)) {
+            uint32_t i;
+            for(i = 0; i < d->screen_cnt; i++) style_res_invalidate(d->screens[i], true);
+            style_res_invalidate(d->top_layer, true);
+            style_res_invalidate(d->sys_layer, true);
+            style_res_invalidate(d->bottom_layer, true);
+        }
+#endif
+        return;
+    }
     lv_display_t * d = lv_display_get_next(NULL);
 
     while(d) {
@@ -276,7 +300,13 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
-    if(!style_refr) return;
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    /*The children inherit the inheritable properties, so forget their values too*/
+    style_res_invalidate(obj, prop == LV_STYLE_PROP_ANY ||
+                         lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE));
+#endif
+
+    if(!style_refr || style_batch) return;
 
     LV_PROFILER_STYLE_BEGIN;
 
@@ -327,6 +357,27 @@ void lv_obj_enable_style_refresh(bool en)
     style_refr = en;
 }
 
+void lv_obj_begin_style_batch(void)
+{
+    LV_ASSERT_MSG(!style_batch, "Style batches can't be nested");
+    style_batch = true;
+}
+
+void lv_obj_commit_style_batch(lv_obj_t * obj)
+{
+    style_batch = false;
+    if(obj == NULL) return;
+
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    LV_PROFILER_STYLE_BEGIN;
+
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    if(parent) lv_obj_mark_layout_as_dirty(parent);
+    refresh_batch_style(obj);
+
+    LV_PROFILER_STYLE_END;
+}
+
 lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
 {
     LV_ASSERT_NULL(obj)
@@ -335,10 +386,51 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
     lv_style_value_t value_act = { .ptr = NULL };
     lv_style_res_t found;
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    /*While a transition is being created the transition styles are skipped. Don't mix these values with the others.
+     *The custom properties have no bit in the bitmap*/
+    lv_obj_style_resolved_t * res = NULL;
+    if(!obj->skip_trans && prop < LV_STYLE_NUM_BUILT_IN_PROPS) {
+        res = obj->style_res;
+        if(res == NULL || res->selector != selector) res = style_res_get_block((lv_obj_t *)obj, selector);
+        if(res && (res->resolved[prop >> 5] & ((uint32_t)1 << (prop & 0x1F)))) {
+            LV_GLOBAL_DEFAULT()->style_res_hits++;
+            return res->values[style_res_get_index(res, prop)];
+        }
+    }
+#endif
+
     found = get_selector_style_prop(obj, selector, prop, &value_act);
-    if(found == LV_STYLE_RES_FOUND) return value_act;
+    if(found != LV_STYLE_RES_FOUND) value_act = lv_style_prop_get_default(prop);
 
-    return lv_style_prop_get_default(prop);
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    if(res) {
+        LV_GLOBAL_DEFAULT()->style_res_misses++;
+        style_res_add(res, prop, value_act);
+    }
+#endif
+
+    return value_act;
+}
+
+void lv_obj_style_resolved_cache_get_stats(lv_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+    lv_memzero(stats, sizeof(lv_cache_stats_t));
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    stats->hits = LV_GLOBAL_DEFAULT()->style_res_hits;
+    stats->misses = LV_GLOBAL_DEFAULT()->style_res_misses;
+    stats->evictions = LV_GLOBAL_DEFAULT()->style_res_evictions;
+#endif
+}
+
+void lv_obj_style_resolved_cache_invalidate(lv_obj_t * obj)
+{
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    style_res_invalidate(obj, true);
+#else
+    LV_UNUSED(obj);
+#endif
 }
 
 bool lv_obj_has_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop)
@@ -811,6 +903,26 @@ static void refresh_children_style(lv_obj_t * obj)
     }
 }
 
+/**
+ * Do what `lv_obj_refresh_style(obj, LV_PART_ANY, LV_STYLE_PROP_ANY)` and the creation of the object would do,
+ * but visit every child only once
+ */
+static void refresh_batch_style(lv_obj_t * obj)
+{
+    lv_obj_send_event(obj, LV_EVENT_STYLE_CHANGED, NULL);
+    lv_obj_mark_layout_as_dirty(obj);
+    lv_obj_update_layer_type(obj);
+    lv_obj_refresh_ext_draw_size(obj);
+    lv_obj_refresh_self_size(obj);
+    lv_obj_invalidate(obj);
+
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    for(i = 0; i < child_cnt; i++) {
+        refresh_batch_style(obj->spec_attr->children[i]);
+    }
+}
+
 /**
  * Remove the transition from object's part's property.
  * - Remove the transition from `lv_obj_style_trans_ll` and free it
@@ -851,6 +963,11 @@ static bool trans_delete(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, t
         }
         tr = tr_prev;
     }
+
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    if(removed) style_res_invalidate(obj, true);
+#endif
+
     return removed;
 }
 
@@ -968,6 +1085,9 @@ static void trans_anim_completed_cb(lv_anim_t * a)
 
                 lv_obj_style_t * obj_style = &obj->styles[i];
                 lv_style_remove_prop((lv_style_t *)obj_style->style, prop);
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+                style_res_invalidate(obj, true);
+#endif
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, (lv_style_t *)obj_style->style, obj_style->selector);
@@ -1149,3 +1269,122 @@ static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_sel
 
     return LV_STYLE_RES_NOT_FOUND;
 }
+
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+
+/**
+ * Get the resolved values of an object for a part and state.
+ * The block is moved to the front to be found quickly next time.
+ * If there is no such block a new one is created, dropping the least recently used one if needed.
+ * @param obj       pointer to an object
+ * @param selector  part and state
+ * @return          the block or `NULL` if out of memory
+ */
+static lv_obj_style_resolved_t * style_res_get_block(lv_obj_t * obj, lv_style_selector_t selector)
+{
+    lv_obj_style_resolved_t ** next_p = &obj->style_res;
+    lv_obj_style_resolved_t * res;
+    uint32_t cnt = 0;
+    while((res = *next_p) != NULL) {
+        if(res->selector == selector) {
+            *next_p = res->next;
+            res->next = obj->style_res;
+            obj->style_res = res;
+            return res;
+        }
+        next_p = &res->next;
+        cnt++;
+    }
+
+    /*Drop the least recently used block if there are too many*/
+    if(cnt >= STYLE_RES_BLOCK_MAX) {
+        next_p = &obj->style_res;
+        while((*next_p)->next) next_p = &(*next_p)->next;
+        lv_free((*next_p)->values);
+        lv_free(*next_p);
+        *next_p = NULL;
+        LV_GLOBAL_DEFAULT()->style_res_evictions++;
+    }
+
+    res = lv_malloc_zeroed(sizeof(lv_obj_style_resolved_t));
+    if(res == NULL) return NULL;
+    res->selector = selector;
+    res->next = obj->style_res;
+    obj->style_res = res;
+    return res;
+}
+
+/**
+ * Get the index of a resolved property in `res->values`, i.e. the number of resolved properties before it.
+ * @param res       the block of resolved values
+ * @param prop      a built-in property
+ * @return          index in `res->values`
+ */
+static uint32_t style_res_get_index(const lv_obj_style_resolved_t * res, lv_style_prop_t prop)
+{
+    uint32_t word = prop >> 5;
+    uint32_t idx = 0;
+    uint32_t i;
+    for(i = 0; i <= word; i++) {
+        uint32_t v = res->resolved[i];
+        if(i == word) v &= ((uint32_t)1 << (prop & 0x1F)) - 1;
+
+        /*Count the bits*/
+        v = v - ((v >> 1) & 0x55555555);
+        v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+        idx += (((v + (v >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+    }
+
+    return idx;
+}
+
+/**
+ * Store a resolved value
+ * @param res       the block of resolved values
+ * @param prop      a built-in property which is not resolved yet
+ * @param value     its value
+ */
+static void style_res_add(lv_obj_style_resolved_t * res, lv_style_prop_t prop, lv_style_value_t value)
+{
+    if(res->cnt == res->cap) {
+        lv_style_value_t * values = lv_realloc(res->values, (res->cap + STYLE_RES_GROW) * sizeof(lv_style_value_t));
+        if(values == NULL) return;
+        res->values = values;
+        res->cap += STYLE_RES_GROW;
+    }
+
+    uint32_t idx = style_res_get_index(res, prop);
+    lv_memmove(&res->values[idx + 1], &res->values[idx], (res->cnt - idx) * sizeof(lv_style_value_t));
+    res->values[idx] = value;
+    res->resolved[prop >> 5] |= (uint32_t)1 << (prop & 0x1F);
+    res->cnt++;
+}
+
+/**
+ * Free the resolved values of an object
+ * @param obj       pointer to an object
+ * @param recursive true: free the values of the children too
+ */
+static void style_res_invalidate(lv_obj_t * obj, bool recursive)
+{
+    if(obj == NULL) return;
+
+    lv_obj_style_resolved_t * res = obj->style_res;
+    while(res) {
+        lv_obj_style_resolved_t * next = res->next;
+        lv_free(res->values);
+        lv_free(res);
+        res = next;
+    }
+    obj->style_res = NULL;
+
+    if(!recursive) return;
+
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    for(i = 0; i < child_cnt; i++) {
+        style_res_invalidate(obj->spec_attr->children[i], true);
+    }
+}
+
+#endif /*LV_OBJ_STYLE_RESOLVED_CACHE*/
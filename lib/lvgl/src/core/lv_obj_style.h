@@ -117,6 +117,21 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
  */
 void lv_obj_enable_style_refresh(bool en);
 
+/**
+ * Start building or changing a tree of objects without refreshing their styles.
+ * Adding styles, setting local style properties and creating objects only store the change;
+ * the styles, sizes, layouts and invalidations are refreshed once by `lv_obj_commit_style_batch`.
+ * Batches can't be nested.
+ */
+void lv_obj_begin_style_batch(void);
+
+/**
+ * Finish a batch started with `lv_obj_begin_style_batch` and refresh the styles of an object
+ * and all of its children, visiting each object only once.
+ * @param obj       the root of the objects created or changed in the batch, or `NULL` to only end the batch
+ */
+void lv_obj_commit_style_batch(lv_obj_t * obj);
+
 /**
  * Get the value of a style property. The current state of the object will be considered.
  * Inherited properties will be inherited.
@@ -129,6 +144,13 @@ void lv_obj_enable_style_refresh(bool en);
  */
 lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
 
+/**
+ * Get the hit, miss and eviction counters of the resolved style value cache
+ * (see `LV_OBJ_STYLE_RESOLVED_CACHE`). A miss means the styles of the object were searched.
+ * @param stats     store the counters here. Zeroed if the cache is disabled.
+ */
+void lv_obj_style_resolved_cache_get_stats(lv_cache_stats_t * stats);
+
 /**
  * Check if an object has a specified style property for a given style selector.
  * @param obj       pointer to an object
@@ -20,6 +20,8 @@ extern "C" {
  *      DEFINES
  *********************/
 
+#define LV_OBJ_STYLE_RES_BITMAP_SIZE ((LV_STYLE_NUM_BUILT_IN_PROPS + 31) / 32)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -31,6 +33,16 @@ struct _lv_obj_style_t {
     uint32_t is_trans : 1;
 };
 
+/** The values resolved by `lv_obj_get_style_prop` for a part in a state*/
+struct _lv_obj_style_resolved_t {
+    lv_obj_style_resolved_t * next;
+    lv_style_selector_t selector;                           /**< Part and state*/
+    uint32_t resolved[LV_OBJ_STYLE_RES_BITMAP_SIZE];        /**< A bit for each built-in property*/
+    uint16_t cnt;
+    uint16_t cap;
+    lv_style_value_t * values;                              /**< The resolved values in property order*/
+};
+
 struct _lv_obj_style_transition_dsc_t {
     uint16_t time;
     uint16_t delay;
@@ -77,6 +89,14 @@ void lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t p
  */
 lv_style_state_cmp_t lv_obj_style_state_compare(lv_obj_t * obj, lv_state_t state1, lv_state_t state2);
 
+/**
+ * Forget the resolved style values of an object and its children.
+ * Needs to be called when the style values might change without `lv_obj_refresh_style`,
+ * e.g. when the state or the parent of the object changes.
+ * @param obj       pointer to an object
+ */
+void lv_obj_style_resolved_cache_invalidate(lv_obj_t * obj);
+
 /**
  * Update the layer type of a widget bayed on its current styles.
  * The result will be stored in `obj->spec_attr->layer_type`
@@ -24,6 +24,9 @@
 #include "../font/lv_font_fmt_txt.h"
 #include "../stdlib/lv_string.h"
 #include "lv_global.h"
+#if LV_USE_PAGE_CACHE
+#include "../others/page_cache/lv_page_cache_private.h"
+#endif
 
 /*********************
  *      DEFINES
@@ -44,9 +47,11 @@ static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
 static void refr_area(const lv_area_t * area_p);
 static void refr_configured_layer(lv_layer_t * layer);
+static void refr_screens(lv_layer_t * layer);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj);
 static void refr_obj(lv_layer_t * layer, lv_obj_t * obj);
+static void layer_alloc_chunk(lv_layer_t * layer, lv_area_t * area);
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h);
 static void draw_buf_flush(lv_display_t * disp);
 static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
@@ -350,6 +355,35 @@ void lv_refr_set_disp_refreshing(lv_display_t * disp)
     disp_refr = disp;
 }
 
+bool lv_refr_trim_covered_area(lv_display_t * disp, lv_area_t * area)
+{
+    lv_obj_t * layers[2] = {disp->top_layer, disp->sys_layer};
+    uint32_t l;
+    for(l = 0; l < 2; l++) {
+        if(layers[l] == NULL) continue;
+        if(lv_obj_has_flag(layers[l], LV_OBJ_FLAG_HIDDEN)) continue;
+        if(lv_obj_get_layer_type(layers[l]) != LV_LAYER_TYPE_NONE) continue;
+        if(lv_obj_get_style_opa(layers[l], LV_PART_MAIN) < LV_OPA_MAX) continue;
+
+        uint32_t i;
+        uint32_t child_cnt = lv_obj_get_child_count(layers[l]);
+        for(i = 0; i < child_cnt; i++) {
+            lv_obj_t * child = layers[l]->spec_attr->children[i];
+            lv_area_t strip;
+            if(!lv_area_intersect(&strip, area, &child->coords)) continue;
+            if(strip.x1 != area->x1 || strip.x2 != area->x2) continue;
+            if(strip.y1 != area->y1 && strip.y2 != area->y2) continue;
+            if(lv_refr_get_top_obj(&strip, child) == NULL) continue;
+
+            if(strip.y1 == area->y1 && strip.y2 == area->y2) return false;
+            if(strip.y1 == area->y1) area->y1 = strip.y2 + 1;
+            else area->y2 = strip.y1 - 1;
+        }
+    }
+
+    return true;
+}
+
 void lv_display_refr_timer(lv_timer_t * tmr)
 {
     LV_PROFILER_REFR_BEGIN;
@@ -428,6 +462,11 @@ refr_finish:
     lv_draw_sw_mask_cleanup();
 #endif
 
+#if LV_DRAW_LAYER_BUF_POOL_SIZE
+    /*Free the pooled layer buffers which were not needed in this refresh*/
+    lv_draw_buf_pool_trim();
+#endif
+
     lv_display_send_event(disp_refr, LV_EVENT_REFR_READY, NULL);
 
     LV_TRACE_REFR("finished");
@@ -650,6 +689,19 @@ static void layer_reshape_draw_buf(lv_layer_t * layer, uint32_t stride)
     LV_ASSERT_NULL(ret);
 }
 
+/**
+ * Get the stride of a screen sized buffer. It's kept until the width changes, e.g. the display is
+ * rotated by 90 degrees, then the buffer is used with the stride of the new width.
+ * @param layer     the display's layer with its buffer area set
+ * @return          the stride to use
+ */
+static uint32_t get_screen_buf_stride(lv_layer_t * layer)
+{
+    int32_t w = lv_area_get_width(&layer->buf_area);
+    if((int32_t)layer->draw_buf->header.w == w) return layer->draw_buf->header.stride;
+    return lv_draw_buf_width_to_stride(w, layer->color_format);
+}
+
 /**
  * Refresh an area if there is Virtual Display Buffer
  * @param area_p  pointer to an area to refresh
@@ -665,7 +717,7 @@ static void refr_area(const lv_area_t * area_p)
     if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_FULL) {
         /*In full mode the area is always the full screen, so the buffer area to it too*/
         layer->buf_area = *area_p;
-        layer_reshape_draw_buf(layer, layer->draw_buf->header.stride);
+        layer_reshape_draw_buf(layer, get_screen_buf_stride(layer));
 
     }
     else if(disp_refr->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
@@ -679,7 +731,7 @@ static void refr_area(const lv_area_t * area_p)
         layer->buf_area.y1 = 0;
         layer->buf_area.x2 = lv_display_get_horizontal_resolution(disp_refr) - 1;
         layer->buf_area.y2 = lv_display_get_vertical_resolution(disp_refr) - 1;
-        layer_reshape_draw_buf(layer, layer->draw_buf->header.stride);
+        layer_reshape_draw_buf(layer, get_screen_buf_stride(layer));
     }
 
     /*Try to divide the area to smaller tiles*/
@@ -777,6 +829,38 @@ static void refr_configured_layer(lv_layer_t * layer)
         lv_draw_buf_clear(layer->draw_buf, &clear_area);
     }
 
+    /*The screens are drawn only where they are not covered by the top and sys layers*/
+    lv_area_t clip_area = layer->_clip_area;
+    if(lv_refr_trim_covered_area(disp_refr, &layer->_clip_area)) {
+#if LV_USE_PAGE_CACHE
+        /*Copy what is cached of the screen and render only the rest of it*/
+        lv_area_t render_area;
+        if(lv_page_cache_draw(disp_refr, layer, &render_area) == false) {
+            refr_screens(layer);
+        }
+        else if(lv_area_get_height(&render_area) > 0) {
+            layer->_clip_area = render_area;
+            refr_screens(layer);
+        }
+#else
+        refr_screens(layer);
+#endif
+    }
+    layer->_clip_area = clip_area;
+
+    /*Also refresh top and sys layer unconditionally*/
+    refr_obj_and_children(layer, lv_display_get_layer_top(disp_refr));
+    refr_obj_and_children(layer, lv_display_get_layer_sys(disp_refr));
+
+    LV_PROFILER_REFR_END;
+}
+
+/**
+ * Draw the bottom layer if needed and the active and previous screens on the clip area of a layer
+ * @param layer     pointer to a layer
+ */
+static void refr_screens(lv_layer_t * layer)
+{
     lv_obj_t * top_act_scr = NULL;
     lv_obj_t * top_prev_scr = NULL;
 
@@ -811,12 +895,6 @@ static void refr_configured_layer(lv_layer_t * layer)
         if(top_act_scr == NULL) top_act_scr = disp_refr->act_scr;
         refr_obj_and_children(layer, top_act_scr);
     }
-
-    /*Also refresh top and sys layer unconditionally*/
-    refr_obj_and_children(layer, lv_display_get_layer_top(disp_refr));
-    refr_obj_and_children(layer, lv_display_get_layer_sys(disp_refr));
-
-    LV_PROFILER_REFR_END;
 }
 
 /**
@@ -1153,6 +1231,16 @@ static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
 
             lv_layer_t * new_layer = lv_draw_layer_create(layer,
                                                           area_need_alpha ? LV_COLOR_FORMAT_ARGB8888 : LV_COLOR_FORMAT_NATIVE, &layer_area_act);
+            if(layer_type == LV_LAYER_TYPE_SIMPLE) {
+                int32_t chunk_h = lv_area_get_height(&layer_area_act);
+                layer_alloc_chunk(new_layer, &layer_area_act);
+
+                /*If the chunk had to be made shorter, don't try the larger size again for the next ones*/
+                if(lv_area_get_height(&layer_area_act) < chunk_h) {
+                    max_rgb_row_height = lv_area_get_height(&layer_area_act);
+                    max_argb_row_height = LV_MIN(max_argb_row_height, max_rgb_row_height);
+                }
+            }
             lv_obj_redraw(new_layer, obj);
 
             lv_point_t pivot = {
@@ -1193,6 +1281,36 @@ static void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
     }
 }
 
+/**
+ * Allocate the buffer of a simple layer's chunk before drawing on it. If there is not enough memory
+ * halve the height of the chunk until the buffer fits. The remaining rows go to the next chunks.
+ * @param layer     the chunk's new layer, nothing is drawn on it yet
+ * @param area      the area of the chunk, made shorter if needed
+ */
+static void layer_alloc_chunk(lv_layer_t * layer, lv_area_t * area)
+{
+    while(lv_draw_layer_alloc_buf(layer) == NULL) {
+        /*The previous chunks free their buffers when they are blended, wait for them first*/
+        if(layer->parent->draw_task_head) {
+            while(layer->parent->draw_task_head) {
+                lv_draw_dispatch_wait_for_request();
+                lv_draw_dispatch();
+            }
+            continue;
+        }
+
+        int32_t h = lv_area_get_height(area);
+        /*The draw unit will try to allocate it again later*/
+        if(h <= 1) return;
+
+        area->y2 = area->y1 + h / 2 - 1;
+        layer->buf_area = *area;
+        layer->_clip_area = *area;
+        layer->phy_clip_area = *area;
+        LV_LOG_INFO("Layer chunk reduced to %" LV_PRId32 " rows", lv_area_get_height(area));
+    }
+}
+
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h)
 {
     lv_color_format_t cf = disp->color_format;
@@ -58,6 +58,17 @@ lv_display_t * lv_refr_get_disp_refreshing(void);
  */
 void lv_refr_set_disp_refreshing(lv_display_t * disp);
 
+/**
+ * Remove the rows of an area which are covered by opaque objects of the top or system layer,
+ * e.g. a header bar shared by all screens. The screens are not visible there.
+ * Only strips spanning the whole width at the top or bottom of the area are removed, so the
+ * rest remains a rectangle.
+ * @param disp  pointer to a display
+ * @param area  the area to trim, changed in place
+ * @return      false if the whole area is covered
+ */
+bool lv_refr_trim_covered_area(lv_display_t * disp, lv_area_t * area);
+
 /**
  * Called periodically to handle the refreshing
  * @param timer pointer to the timer itself
@@ -11,6 +11,7 @@
 #include "../misc/lv_anim_private.h"
 #include "../draw/lv_draw_private.h"
 #include "../core/lv_obj_private.h"
+#include "../core/lv_obj_draw_private.h"
 #include "lv_display.h"
 #include "../misc/lv_math.h"
 #include "../core/lv_refr_private.h"
@@ -45,6 +46,7 @@ static void set_x_anim(void * obj, int32_t v);
 static void set_y_anim(void * obj, int32_t v);
 static void scr_anim_completed(lv_anim_t * a);
 static bool is_out_anim(lv_screen_load_anim_t a);
+static void redraw_screen(lv_display_t * d, lv_obj_t * scr);
 static void disp_event_cb(lv_event_t * e);
 
 /**********************
@@ -1159,7 +1161,7 @@ static void scr_load_internal(lv_obj_t * scr)
     lv_obj_send_event(scr, LV_EVENT_SCREEN_LOADED, NULL);
     if(old_scr) lv_obj_send_event(old_scr, LV_EVENT_SCREEN_UNLOADED, NULL);
 
-    lv_obj_invalidate(scr);
+    redraw_screen(d, scr);
 }
 
 static void scr_load_anim_start(lv_anim_t * a)
@@ -1199,7 +1201,7 @@ static void scr_anim_completed(lv_anim_t * a)
     d->draw_prev_over_act = false;
     d->scr_to_load = NULL;
     lv_obj_remove_local_style_prop(a->var, LV_STYLE_OPA, 0);
-    lv_obj_invalidate(d->act_scr);
+    redraw_screen(d, d->act_scr);
 }
 
 static bool is_out_anim(lv_screen_load_anim_t anim_type)
@@ -1211,6 +1213,21 @@ static bool is_out_anim(lv_screen_load_anim_t anim_type)
            anim_type == LV_SCR_LOAD_ANIM_OUT_BOTTOM;
 }
 
+/**
+ * Invalidate the area of a loaded screen on the display. Unlike `lv_obj_invalidate` it doesn't
+ * tell that the screen has changed, so the page cache can keep its image. The rows covered by the
+ * top and sys layers, e.g. a header shared by the screens, are not redrawn.
+ */
+static void redraw_screen(lv_display_t * d, lv_obj_t * scr)
+{
+    if(lv_obj_has_flag(scr, LV_OBJ_FLAG_HIDDEN)) return;
+
+    lv_area_t area = scr->coords;
+    int32_t ext_size = lv_obj_get_ext_draw_size(scr);
+    lv_area_increase(&area, ext_size, ext_size);
+    if(lv_refr_trim_covered_area(d, &area)) lv_inv_area(d, &area);
+}
+
 static void disp_event_cb(lv_event_t * e)
 {
     lv_event_code_t code = lv_event_get_code(e);
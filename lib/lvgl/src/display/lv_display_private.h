@@ -166,6 +166,10 @@ struct _lv_display_t {
     lv_obj_t * mem_label;
 #endif
 
+#if LV_USE_PAGE_CACHE
+    lv_page_cache_t * page_cache;       /**< Keeps the rendered image of screens, see `lv_page_cache_create`*/
+#endif
+
 };
 
 /**********************
@@ -31,7 +31,18 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_DRAW_TASK_INDEX
+static void index_task(lv_layer_t * layer, lv_draw_task_t * t);
+static void unindex_task(lv_layer_t * layer, lv_draw_task_t * t);
+static void get_task_bands(lv_layer_t * layer, const lv_draw_task_t * t, uint32_t * first, uint32_t * last);
+static void avail_append(lv_layer_t * layer, lv_draw_task_t * t);
+static void avail_remove(lv_layer_t * layer, lv_draw_task_t * t);
+static void remove_finished_taken_tasks(lv_display_t * disp, lv_layer_t * layer);
+#else
 static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check);
+#endif
+static void remove_finished_tasks(lv_display_t * disp, lv_layer_t * layer);
+static void remove_task(lv_layer_t * layer, lv_draw_task_t * t);
 static void lv_cleanup_task(lv_draw_task_t * t, lv_display_t * disp);
 
 static inline uint32_t get_layer_size_kb(uint32_t size_byte)
@@ -73,6 +84,10 @@ void lv_draw_deinit(void)
         lv_free(cur_unit);
     }
     _draw_info.unit_head = NULL;
+
+#if LV_DRAW_LAYER_BUF_POOL_SIZE
+    lv_draw_buf_pool_flush();
+#endif
 }
 
 void * lv_draw_create_unit(size_t size)
@@ -99,16 +114,18 @@ lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords)
 #endif
     new_task->state = LV_DRAW_TASK_STATE_QUEUED;
 
-    /*Find the tail*/
     if(layer->draw_task_head == NULL) {
         layer->draw_task_head = new_task;
     }
     else {
-        lv_draw_task_t * tail = layer->draw_task_head;
-        while(tail->next) tail = tail->next;
-
-        tail->next = new_task;
+        layer->draw_task_tail->next = new_task;
     }
+    new_task->prev = layer->draw_task_tail;
+    layer->draw_task_tail = new_task;
+#if LV_DRAW_TASK_INDEX
+    if(new_task->prev == NULL) layer->draw_task_seq = 0;
+    new_task->seq = layer->draw_task_seq++;
+#endif
 
     LV_PROFILER_DRAW_END;
     return new_task;
@@ -134,6 +151,11 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
             info->task_running = false;
         }
 
+#if LV_DRAW_TASK_INDEX
+        /*The area of the task is final now*/
+        if(info->unit_cnt > 1) index_task(layer, t);
+#endif
+
         /*Let the draw units set their preference score*/
         t->preference_score = 100;
         t->preferred_draw_unit_id = 0;
@@ -157,6 +179,10 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
         }
     }
     else {
+#if LV_DRAW_TASK_INDEX
+        if(info->unit_cnt > 1) index_task(layer, t);
+#endif
+
         /*Let the draw units set their preference score*/
         t->preference_score = 100;
         t->preferred_draw_unit_id = 0;
@@ -219,23 +245,12 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
 {
     LV_PROFILER_DRAW_BEGIN;
     /*Remove the finished tasks first*/
-    lv_draw_task_t * t_prev = NULL;
-    lv_draw_task_t * t = layer->draw_task_head;
-    lv_draw_task_t * t_next;
-    while(t) {
-        t_next = t->next;
-        if(t->state == LV_DRAW_TASK_STATE_READY) {
-            lv_cleanup_task(t, disp);
-            if(t_prev != NULL)
-                t_prev->next = t_next;
-            else
-                layer->draw_task_head = t_next;
-        }
-        else {
-            t_prev = t;
-        }
-        t = t_next;
-    }
+#if LV_DRAW_TASK_INDEX
+    if(_draw_info.unit_cnt > 1) remove_finished_taken_tasks(disp, layer);
+    else remove_finished_tasks(disp, layer);
+#else
+    remove_finished_tasks(disp, layer);
+#endif
 
     bool task_dispatched = false;
 
@@ -348,6 +363,27 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
         }
     }
 
+#if LV_DRAW_TASK_INDEX
+    /*Find a queued task among the independent ones, i.e. which have no older unfinished tasks overlapping them.
+     *The returned task is moved to the taken ones, like the ones finished without a draw unit*/
+    LV_UNUSED(t_prev);
+    lv_draw_task_t * t = layer->draw_task_avail_head;
+    while(t) {
+        lv_draw_task_t * t_next = t->avail_next;
+        bool take = t->state == LV_DRAW_TASK_STATE_QUEUED &&
+                    (t->preferred_draw_unit_id == LV_DRAW_UNIT_NONE || t->preferred_draw_unit_id == draw_unit_id);
+        if(take || (t->state != LV_DRAW_TASK_STATE_QUEUED && t->state != LV_DRAW_TASK_STATE_WAITING)) {
+            avail_remove(layer, t);
+            t->avail_next = layer->draw_task_taken;
+            layer->draw_task_taken = t;
+            if(take) {
+                LV_PROFILER_DRAW_END;
+                return t;
+            }
+        }
+        t = t_next;
+    }
+#else
     lv_draw_task_t * t = t_prev ? t_prev->next : layer->draw_task_head;
     while(t) {
         /*Find a queued and independent task*/
@@ -359,6 +395,7 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
         }
         t = t->next;
     }
+#endif
 
     LV_PROFILER_DRAW_END;
     return NULL;
@@ -457,7 +494,7 @@ void * lv_draw_layer_alloc_buf(lv_layer_t * layer)
     }
 #endif
 
-    layer->draw_buf = lv_draw_buf_create(w, h, layer->color_format, 0);
+    layer->draw_buf = lv_draw_buf_pool_acquire(w, h, layer->color_format);
 
     if(layer->draw_buf == NULL) {
         LV_LOG_WARN("Allocating layer buffer failed. Try later");
@@ -500,6 +537,168 @@ void lv_draw_task_get_area(const lv_draw_task_t * t, lv_area_t * area)
  *   STATIC FUNCTIONS
  **********************/
 
+#if LV_DRAW_TASK_INDEX
+
+/**
+ * Add a draw task to the band index of its layer and count the older unfinished tasks overlapping it.
+ * Tasks added in its `LV_EVENT_DRAW_TASK_ADDED` event are indexed earlier but they are newer,
+ * so they get the overlap counted instead.
+ * @param layer     the layer of the task
+ * @param t         the task whose area is final
+ */
+static void index_task(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    if(layer->draw_task_indexed_cnt == 0) {
+        int32_t h = lv_area_get_height(&layer->phy_clip_area);
+        layer->draw_task_band_y = layer->phy_clip_area.y1;
+        layer->draw_task_band_h = LV_MAX(1, (h + LV_DRAW_TASK_BAND_CNT - 1) / LV_DRAW_TASK_BAND_CNT);
+        lv_memzero(layer->draw_task_band_reach, sizeof(layer->draw_task_band_reach));
+    }
+
+    uint32_t first;
+    uint32_t last;
+    get_task_bands(layer, t, &first, &last);
+
+    /*Only the bands up to the last one of `t` can have tasks starting above or in it,
+     *and only those reaching the first band of `t` can overlap it*/
+    t->dep_cnt = 0;
+    uint32_t b;
+    for(b = 0; b <= last; b++) {
+        if(layer->draw_task_band_reach[b] < first) continue;
+        lv_draw_task_t * t2;
+        for(t2 = layer->draw_task_bands[b]; t2; t2 = t2->band_next) {
+            if(!lv_area_is_on(&t2->_real_area, &t->_real_area)) continue;
+            if(t2->seq < t->seq) {
+                t->dep_cnt++;
+            }
+            else {
+                if(t2->dep_cnt == 0) avail_remove(layer, t2);
+                t2->dep_cnt++;
+            }
+        }
+    }
+    if(t->dep_cnt == 0) avail_append(layer, t);
+
+    t->band_next = layer->draw_task_bands[first];
+    layer->draw_task_bands[first] = t;
+    if(layer->draw_task_band_reach[first] < last) layer->draw_task_band_reach[first] = (uint8_t)last;
+    layer->draw_task_indexed_cnt++;
+}
+
+/**
+ * Remove a finished draw task from the band index and release the newer tasks overlapping it
+ * @param layer     the layer of the task
+ * @param t         the finished task
+ */
+static void unindex_task(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    uint32_t first;
+    uint32_t last;
+    get_task_bands(layer, t, &first, &last);
+
+    uint32_t b;
+    for(b = 0; b <= last; b++) {
+        if(layer->draw_task_band_reach[b] < first) continue;
+        lv_draw_task_t * t_prev = NULL;
+        lv_draw_task_t * t2 = layer->draw_task_bands[b];
+        while(t2) {
+            lv_draw_task_t * t_next = t2->band_next;
+            if(t2 == t) {
+                if(t_prev) t_prev->band_next = t_next;
+                else layer->draw_task_bands[b] = t_next;
+            }
+            else {
+                if(t2->seq > t->seq && lv_area_is_on(&t2->_real_area, &t->_real_area)) {
+                    t2->dep_cnt--;
+                    if(t2->dep_cnt == 0) avail_append(layer, t2);
+                }
+                t_prev = t2;
+            }
+            t2 = t_next;
+        }
+    }
+
+    layer->draw_task_indexed_cnt--;
+}
+
+/**
+ * Get the first and last band of the layer covered by a draw task. The rows out of the bands
+ * belong to the first or last band.
+ * @param layer     the layer of the task
+ * @param t         the task
+ * @param first     store the index of the first band here
+ * @param last      store the index of the last band here
+ */
+static void get_task_bands(lv_layer_t * layer, const lv_draw_task_t * t, uint32_t * first, uint32_t * last)
+{
+    int32_t b1 = (t->_real_area.y1 - layer->draw_task_band_y) / layer->draw_task_band_h;
+    int32_t b2 = (t->_real_area.y2 - layer->draw_task_band_y) / layer->draw_task_band_h;
+    *first = LV_CLAMP(0, b1, LV_DRAW_TASK_BAND_CNT - 1);
+    *last = LV_CLAMP(0, b2, LV_DRAW_TASK_BAND_CNT - 1);
+}
+
+/**
+ * Append a draw task to the list of available tasks of its layer
+ * @param layer     the layer of the task
+ * @param t         a task which has no older unfinished tasks overlapping it
+ */
+static void avail_append(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    t->avail_next = NULL;
+    t->avail_prev = layer->draw_task_avail_tail;
+    if(layer->draw_task_avail_tail) layer->draw_task_avail_tail->avail_next = t;
+    else layer->draw_task_avail_head = t;
+    layer->draw_task_avail_tail = t;
+}
+
+/**
+ * Remove a draw task from the list of available tasks of its layer
+ * @param layer     the layer of the task
+ * @param t         a task in the list
+ */
+static void avail_remove(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    if(t->avail_prev) t->avail_prev->avail_next = t->avail_next;
+    else layer->draw_task_avail_head = t->avail_next;
+    if(t->avail_next) t->avail_next->avail_prev = t->avail_prev;
+    else layer->draw_task_avail_tail = t->avail_prev;
+}
+
+/**
+ * Remove the finished tasks of a layer, with more draw units. Only the taken tasks can be finished,
+ * the ones which were not started are made available again.
+ * @param disp      the display on which the tasks were drawn
+ * @param layer     the layer of the tasks
+ */
+static void remove_finished_taken_tasks(lv_display_t * disp, lv_layer_t * layer)
+{
+    lv_draw_task_t * t_prev = NULL;
+    lv_draw_task_t * t = layer->draw_task_taken;
+    while(t) {
+        lv_draw_task_t * t_next = t->avail_next;
+        if(t->state == LV_DRAW_TASK_STATE_READY || t->state == LV_DRAW_TASK_STATE_QUEUED) {
+            if(t_prev) t_prev->avail_next = t_next;
+            else layer->draw_task_taken = t_next;
+
+            if(t->state == LV_DRAW_TASK_STATE_READY) {
+                unindex_task(layer, t);
+                remove_task(layer, t);
+                lv_cleanup_task(t, disp);
+            }
+            /*The draw unit couldn't start it after all*/
+            else {
+                avail_append(layer, t);
+            }
+        }
+        else {
+            t_prev = t;
+        }
+        t = t_next;
+    }
+}
+
+#else
+
 /**
  * Check if there are older draw task overlapping the area of `t_check`
  * @param layer      the draw ctx to search in
@@ -527,6 +726,39 @@ static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check)
     return true;
 }
 
+#endif /*LV_DRAW_TASK_INDEX*/
+
+/**
+ * Remove the finished tasks of a layer by checking all of them
+ * @param disp      the display on which the tasks were drawn
+ * @param layer     the layer of the tasks
+ */
+static void remove_finished_tasks(lv_display_t * disp, lv_layer_t * layer)
+{
+    lv_draw_task_t * t = layer->draw_task_head;
+    while(t) {
+        lv_draw_task_t * t_next = t->next;
+        if(t->state == LV_DRAW_TASK_STATE_READY) {
+            remove_task(layer, t);
+            lv_cleanup_task(t, disp);
+        }
+        t = t_next;
+    }
+}
+
+/**
+ * Unlink a draw task from the task list of its layer
+ * @param layer     the layer of the task
+ * @param t         the task to unlink
+ */
+static void remove_task(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    if(t->prev) t->prev->next = t->next;
+    else layer->draw_task_head = t->next;
+    if(t->next) t->next->prev = t->prev;
+    else layer->draw_task_tail = t->prev;
+}
+
 /**
  * Clean-up resources allocated by a finished task
  * @param t         pointer to a draw task
@@ -552,7 +784,7 @@ static void lv_cleanup_task(lv_draw_task_t * t, lv_display_t * disp)
                 LV_LOG_WARN("More layers were freed than allocated");
             }
             LV_LOG_INFO("Layer memory used: %" LV_PRIu32 " kB", get_layer_size_kb(_draw_info.used_memory_for_layers));
-            lv_draw_buf_destroy(layer_drawn->draw_buf);
+            lv_draw_buf_pool_release(layer_drawn->draw_buf);
             layer_drawn->draw_buf = NULL;
         }
 
@@ -33,6 +33,20 @@ extern "C" {
 #define LV_DRAW_UNIT_NONE  0
 #define LV_DRAW_UNIT_IDLE  -1   /**< The draw unit is idle, new dispatching might be requested to try again */
 
+/** 1: the enabled draw units can be more than one, so the unfinished draw tasks of the layers
+ *  are indexed in row bands to find the independent ones quickly. Without it, draw units created
+ *  by the application find them by comparing each task with the older ones.*/
+#ifndef LV_DRAW_TASK_INDEX
+#define LV_DRAW_TASK_INDEX  (((LV_USE_DRAW_SW ? LV_DRAW_SW_DRAW_UNIT_CNT : 0) + LV_USE_DRAW_VGLITE + \
+                              LV_USE_DRAW_PXP + LV_USE_DRAW_DAVE2D + LV_USE_DRAW_SDL + LV_USE_DRAW_VG_LITE) > 1)
+#endif
+
+#if LV_DRAW_TASK_INDEX
+/** Number of row bands in which the unfinished draw tasks of a layer are indexed
+ *  to find the overlapping ones quickly. Only used with more than one draw unit.*/
+#define LV_DRAW_TASK_BAND_CNT  16
+#endif
+
 #if LV_DRAW_TRANSFORM_USE_MATRIX
 #if !LV_USE_MATRIX
 #error "LV_DRAW_TRANSFORM_USE_MATRIX requires LV_USE_MATRIX = 1"
@@ -100,6 +114,34 @@ struct _lv_layer_t  {
     /** Linked list of draw tasks */
     lv_draw_task_t * draw_task_head;
 
+    /** The last draw task, new tasks are appended here */
+    lv_draw_task_t * draw_task_tail;
+
+#if LV_DRAW_TASK_INDEX
+    /** The tasks without older unfinished tasks overlapping them, in the order they got free */
+    lv_draw_task_t * draw_task_avail_head;
+    lv_draw_task_t * draw_task_avail_tail;
+
+    /** The tasks given to the draw units, only these can be finished */
+    lv_draw_task_t * draw_task_taken;
+
+    /** The unfinished draw tasks listed in the band of their first row */
+    lv_draw_task_t * draw_task_bands[LV_DRAW_TASK_BAND_CNT];
+
+    /** The last band covered by the tasks starting in each band */
+    uint8_t draw_task_band_reach[LV_DRAW_TASK_BAND_CNT];
+
+    /** First row and height of the bands, set when the first task is indexed */
+    int32_t draw_task_band_y;
+    int32_t draw_task_band_h;
+
+    /** Number of indexed tasks */
+    uint32_t draw_task_indexed_cnt;
+
+    /** Order of the next draw task */
+    uint32_t draw_task_seq;
+#endif
+
     lv_layer_t * parent;
     lv_layer_t * next;
     bool all_tasks_added;
@@ -194,7 +236,8 @@ uint32_t lv_draw_get_unit_count(void);
 /**
  * Find and available draw task
  * @param layer             the draw ctx to search in
- * @param t_prev            continue searching from this task
+ * @param t_prev            continue searching from this task. With `LV_DRAW_TASK_INDEX` and more draw units
+ *                          the tasks returned once are skipped anyway.
  * @param draw_unit_id      check the task where `preferred_draw_unit_id` equals this value or `LV_DRAW_UNIT_NONE`
  * @return                  tan available draw task or NULL if there is no any
  */
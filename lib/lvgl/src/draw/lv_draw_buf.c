@@ -12,6 +12,7 @@
 #include "../core/lv_global.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_area_private.h"
+#include "../misc/cache/lv_cache.h"
 
 /*********************
  *      DEFINES
@@ -19,6 +20,9 @@
 #define default_handlers LV_GLOBAL_DEFAULT()->draw_buf_handlers
 #define font_draw_buf_handlers LV_GLOBAL_DEFAULT()->font_draw_buf_handlers
 #define image_cache_draw_buf_handlers LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers
+#if LV_DRAW_LAYER_BUF_POOL_SIZE
+    #define draw_buf_pool LV_GLOBAL_DEFAULT()->draw_buf_pool
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -33,6 +37,11 @@ static void * buf_align(void * buf, lv_color_format_t color_format);
 static void * draw_buf_malloc(const lv_draw_buf_handlers_t * handler, size_t size_bytes,
                               lv_color_format_t color_format);
 static void draw_buf_free(const lv_draw_buf_handlers_t * handler, void * buf);
+static lv_draw_buf_t * draw_buf_create(const lv_draw_buf_handlers_t * handlers, uint32_t w, uint32_t h,
+                                       lv_color_format_t cf, uint32_t stride, uint32_t size);
+#if LV_DRAW_LAYER_BUF_POOL_SIZE
+    static uint32_t pool_size_class(uint32_t size);
+#endif
 static uint32_t width_to_stride(uint32_t w, lv_color_format_t color_format);
 static uint32_t _calculate_draw_buf_size(uint32_t w, uint32_t h, lv_color_format_t cf, uint32_t stride);
 static void draw_buf_get_full_area(const lv_draw_buf_t * draw_buf, lv_area_t * full_area);
@@ -306,39 +315,10 @@ lv_draw_buf_t * lv_draw_buf_create(uint32_t w, uint32_t h, lv_color_format_t cf,
 lv_draw_buf_t * lv_draw_buf_create_ex(const lv_draw_buf_handlers_t * handlers, uint32_t w, uint32_t h,
                                       lv_color_format_t cf, uint32_t stride)
 {
-    LV_PROFILER_DRAW_BEGIN;
-    lv_draw_buf_t * draw_buf = lv_malloc_zeroed(sizeof(lv_draw_buf_t));
-    LV_ASSERT_MALLOC(draw_buf);
-    if(draw_buf == NULL) {
-        LV_PROFILER_DRAW_END;
-        return NULL;
-    }
     if(stride == 0) stride = lv_draw_buf_width_to_stride(w, cf);
 
     uint32_t size = _calculate_draw_buf_size(w, h, cf, stride);
-
-    void * buf = draw_buf_malloc(handlers, size, cf);
-    /*Do not assert here as LVGL or the app might just want to try creating a draw_buf*/
-    if(buf == NULL) {
-        LV_LOG_WARN("No memory: %"LV_PRIu32"x%"LV_PRIu32", cf: %d, stride: %"LV_PRIu32", %"LV_PRIu32"Byte, ",
-                    w, h, cf, stride, size);
-        lv_free(draw_buf);
-        LV_PROFILER_DRAW_END;
-        return NULL;
-    }
-
-    draw_buf->header.w = w;
-    draw_buf->header.h = h;
-    draw_buf->header.cf = cf;
-    draw_buf->header.flags = LV_IMAGE_FLAGS_MODIFIABLE | LV_IMAGE_FLAGS_ALLOCATED;
-    draw_buf->header.stride = stride;
-    draw_buf->header.magic = LV_IMAGE_HEADER_MAGIC;
-    draw_buf->data = lv_draw_buf_align(buf, cf);
-    draw_buf->unaligned_data = buf;
-    draw_buf->data_size = size;
-    draw_buf->handlers = handlers;
-    LV_PROFILER_DRAW_END;
-    return draw_buf;
+    return draw_buf_create(handlers, w, h, cf, stride, size);
 }
 
 lv_draw_buf_t * lv_draw_buf_dup(const lv_draw_buf_t * draw_buf)
@@ -414,6 +394,122 @@ void lv_draw_buf_destroy(lv_draw_buf_t * draw_buf)
     LV_PROFILER_DRAW_END;
 }
 
+lv_draw_buf_t * lv_draw_buf_pool_acquire(uint32_t w, uint32_t h, lv_color_format_t cf)
+{
+#if LV_DRAW_LAYER_BUF_POOL_SIZE
+    LV_PROFILER_DRAW_BEGIN;
+    lv_draw_buf_pool_t * pool = &draw_buf_pool;
+    uint32_t stride = lv_draw_buf_width_to_stride(w, cf);
+    uint32_t size = _calculate_draw_buf_size(w, h, cf, stride);
+
+    /*Take the smallest idle buffer which is large enough*/
+    int32_t best = -1;
+    int32_t i;
+    for(i = 0; i < LV_DRAW_BUF_POOL_SLOTS; i++) {
+        lv_draw_buf_t * draw_buf = pool->bufs[i];
+        if(draw_buf == NULL || draw_buf->data_size < size) continue;
+        if(best < 0 || draw_buf->data_size < pool->bufs[best]->data_size) best = i;
+    }
+
+    if(best >= 0) {
+        lv_draw_buf_t * draw_buf = pool->bufs[best];
+        pool->bufs[best] = NULL;
+        pool->size -= draw_buf->data_size;
+        pool->hits++;
+        lv_draw_buf_reshape(draw_buf, cf, w, h, stride);
+        LV_PROFILER_DRAW_END;
+        return draw_buf;
+    }
+
+    /*Round up the size, so that the buffer can be reused by layers of similar size too*/
+    lv_draw_buf_t * draw_buf = draw_buf_create(&default_handlers, w, h, cf, stride, pool_size_class(size));
+    if(draw_buf == NULL) {
+        /*Give the idle buffers back to the heap and try again without rounding*/
+        lv_draw_buf_pool_flush();
+        draw_buf = draw_buf_create(&default_handlers, w, h, cf, stride, size);
+    }
+    if(draw_buf) pool->misses++;
+
+    LV_PROFILER_DRAW_END;
+    return draw_buf;
+#else
+    return lv_draw_buf_create(w, h, cf, 0);
+#endif
+}
+
+void lv_draw_buf_pool_release(lv_draw_buf_t * draw_buf)
+{
+    LV_ASSERT_NULL(draw_buf);
+    if(draw_buf == NULL) return;
+
+#if LV_DRAW_LAYER_BUF_POOL_SIZE
+    lv_draw_buf_pool_t * pool = &draw_buf_pool;
+    if(draw_buf->handlers == &default_handlers && lv_draw_buf_has_flag(draw_buf, LV_IMAGE_FLAGS_ALLOCATED) &&
+       pool->size + draw_buf->data_size <= LV_DRAW_LAYER_BUF_POOL_SIZE) {
+        uint32_t i;
+        for(i = 0; i < LV_DRAW_BUF_POOL_SLOTS; i++) {
+            if(pool->bufs[i] == NULL) {
+                pool->bufs[i] = draw_buf;
+                pool->used[i] = true;
+                pool->size += draw_buf->data_size;
+                return;
+            }
+        }
+    }
+
+    pool->evictions++;
+#endif
+
+    lv_draw_buf_destroy(draw_buf);
+}
+
+void lv_draw_buf_pool_trim(void)
+{
+#if LV_DRAW_LAYER_BUF_POOL_SIZE
+    lv_draw_buf_pool_t * pool = &draw_buf_pool;
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_BUF_POOL_SLOTS; i++) {
+        if(pool->bufs[i] && !pool->used[i]) {
+            pool->size -= pool->bufs[i]->data_size;
+            pool->evictions++;
+            lv_draw_buf_destroy(pool->bufs[i]);
+            pool->bufs[i] = NULL;
+        }
+        pool->used[i] = false;
+    }
+#endif
+}
+
+void lv_draw_buf_pool_flush(void)
+{
+#if LV_DRAW_LAYER_BUF_POOL_SIZE
+    lv_draw_buf_pool_t * pool = &draw_buf_pool;
+    uint32_t i;
+    for(i = 0; i < LV_DRAW_BUF_POOL_SLOTS; i++) {
+        if(pool->bufs[i]) {
+            pool->evictions++;
+            lv_draw_buf_destroy(pool->bufs[i]);
+            pool->bufs[i] = NULL;
+        }
+        pool->used[i] = false;
+    }
+    pool->size = 0;
+#endif
+}
+
+void lv_draw_buf_pool_get_stats(lv_cache_stats_t * stats)
+{
+    lv_memzero(stats, sizeof(lv_cache_stats_t));
+#if LV_DRAW_LAYER_BUF_POOL_SIZE
+    lv_draw_buf_pool_t * pool = &draw_buf_pool;
+    stats->hits = pool->hits;
+    stats->misses = pool->misses;
+    stats->evictions = pool->evictions;
+    stats->size = pool->size;
+    stats->max_size = LV_DRAW_LAYER_BUF_POOL_SIZE;
+#endif
+}
+
 void * lv_draw_buf_goto_xy(const lv_draw_buf_t * buf, uint32_t x, uint32_t y)
 {
     LV_ASSERT_NULL(buf);
@@ -668,6 +764,57 @@ static void * buf_align(void * buf, lv_color_format_t color_format)
     return buf_u8;
 }
 
+/**
+ * Allocate a draw buffer with `size` bytes of pixel data
+ */
+static lv_draw_buf_t * draw_buf_create(const lv_draw_buf_handlers_t * handlers, uint32_t w, uint32_t h,
+                                       lv_color_format_t cf, uint32_t stride, uint32_t size)
+{
+    LV_PROFILER_DRAW_BEGIN;
+    lv_draw_buf_t * draw_buf = lv_malloc_zeroed(sizeof(lv_draw_buf_t));
+    LV_ASSERT_MALLOC(draw_buf);
+    if(draw_buf == NULL) {
+        LV_PROFILER_DRAW_END;
+        return NULL;
+    }
+
+    void * buf = draw_buf_malloc(handlers, size, cf);
+    /*Do not assert here as LVGL or the app might just want to try creating a draw_buf*/
+    if(buf == NULL) {
+        LV_LOG_WARN("No memory: %"LV_PRIu32"x%"LV_PRIu32", cf: %d, stride: %"LV_PRIu32", %"LV_PRIu32"Byte, ",
+                    w, h, cf, stride, size);
+        lv_free(draw_buf);
+        LV_PROFILER_DRAW_END;
+        return NULL;
+    }
+
+    draw_buf->header.w = w;
+    draw_buf->header.h = h;
+    draw_buf->header.cf = cf;
+    draw_buf->header.flags = LV_IMAGE_FLAGS_MODIFIABLE | LV_IMAGE_FLAGS_ALLOCATED;
+    draw_buf->header.stride = stride;
+    draw_buf->header.magic = LV_IMAGE_HEADER_MAGIC;
+    draw_buf->data = lv_draw_buf_align(buf, cf);
+    draw_buf->unaligned_data = buf;
+    draw_buf->data_size = size;
+    draw_buf->handlers = handlers;
+    LV_PROFILER_DRAW_END;
+    return draw_buf;
+}
+
+#if LV_DRAW_LAYER_BUF_POOL_SIZE
+/**
+ * Round up the size of a new pooled buffer. The steps are 1/16 of the next power of two,
+ * so at most 1/8 of the buffer is wasted.
+ */
+static uint32_t pool_size_class(uint32_t size)
+{
+    uint32_t step = 64;
+    while(step * 16 < size) step <<= 1;
+    return LV_ROUND_UP(size, step);
+}
+#endif
+
 static uint32_t width_to_stride(uint32_t w, lv_color_format_t color_format)
 {
     uint32_t width_byte;
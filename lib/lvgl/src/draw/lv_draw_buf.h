@@ -285,6 +285,19 @@ lv_draw_buf_t * lv_draw_buf_reshape(lv_draw_buf_t * draw_buf, lv_color_format_t
  */
 void lv_draw_buf_destroy(lv_draw_buf_t * draw_buf);
 
+/**
+ * Free the idle buffers kept in the pool of layer buffers (see `LV_DRAW_LAYER_BUF_POOL_SIZE`).
+ */
+void lv_draw_buf_pool_flush(void);
+
+/**
+ * Get the statistics of the pool of layer buffers. `hits` and `misses` count the layer buffers
+ * taken from the pool and allocated, `evictions` the pooled buffers freed, `size` the memory
+ * held by idle buffers. All zero if the pool is disabled.
+ * @param stats     store the statistics here
+ */
+void lv_draw_buf_pool_get_stats(lv_cache_stats_t * stats);
+
 /**
  * Return pointer to the buffer at the given coordinates
  */
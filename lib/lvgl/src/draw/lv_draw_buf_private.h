@@ -20,6 +20,11 @@ extern "C" {
  *      DEFINES
  *********************/
 
+#if LV_DRAW_LAYER_BUF_POOL_SIZE
+/** Number of idle buffers the pool of layer buffers can keep */
+#define LV_DRAW_BUF_POOL_SLOTS 4
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -33,6 +38,17 @@ struct _lv_draw_buf_handlers_t {
     lv_draw_buf_width_to_stride_cb width_to_stride_cb;
 };
 
+#if LV_DRAW_LAYER_BUF_POOL_SIZE
+typedef struct {
+    lv_draw_buf_t * bufs[LV_DRAW_BUF_POOL_SLOTS];   /**< Idle buffers, NULL in the free slots */
+    bool used[LV_DRAW_BUF_POOL_SLOTS];              /**< The buffer was released since the last trim */
+    uint32_t size;                                  /**< Sum of the `data_size` of the idle buffers */
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+} lv_draw_buf_pool_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -42,6 +58,29 @@ struct _lv_draw_buf_handlers_t {
  */
 void lv_draw_buf_init_handlers(void);
 
+/**
+ * Get a buffer for a layer. Reuse an idle buffer of the pool if one is large enough,
+ * else allocate a new one. The content of the buffer is undefined.
+ * @param w         width in pixels
+ * @param h         height in pixels
+ * @param cf        color format
+ * @return          the draw buffer or NULL if there is not enough memory
+ */
+lv_draw_buf_t * lv_draw_buf_pool_acquire(uint32_t w, uint32_t h, lv_color_format_t cf);
+
+/**
+ * Give back a buffer of `lv_draw_buf_pool_acquire`. It's kept for the next layers if it fits
+ * into `LV_DRAW_LAYER_BUF_POOL_SIZE`, else destroyed.
+ * @param draw_buf  the draw buffer to release
+ */
+void lv_draw_buf_pool_release(lv_draw_buf_t * draw_buf);
+
+/**
+ * Free the idle buffers which were not used since the last trim. Called at the end of every refresh,
+ * so the pool holds memory only while layers are drawn (e.g. during a fade).
+ */
+void lv_draw_buf_pool_trim(void);
+
 /**********************
  *      MACROS
  **********************/
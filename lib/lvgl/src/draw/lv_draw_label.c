@@ -199,9 +199,19 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
 
     uint32_t line_start     = 0;
     int32_t last_line_start = -1;
+    uint32_t remaining_len = dsc->text_length;
+
+    /*Take the line breaks from the text layout cache if the whole text is drawn*/
+    const lv_text_layout_t * layout = lv_text_layout_acquire(dsc->text, font, dsc->letter_space, dsc->line_space, w,
+                                                             dsc->flag);
+    if(layout && (layout->line_starts == NULL || remaining_len < layout->line_starts[layout->line_cnt])) {
+        lv_text_layout_release(layout);
+        layout = NULL;
+    }
+    uint32_t line_id = 0;
 
     /*Check the hint to use the cached info*/
-    if(dsc->hint && y_ofs == 0 && coords->y1 < 0) {
+    if(layout == NULL && dsc->hint && y_ofs == 0 && coords->y1 < 0) {
         /*If the label changed too much recalculate the hint.*/
         if(LV_ABS(dsc->hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
             dsc->hint->line_start = -1;
@@ -215,13 +225,27 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
         pos.y += dsc->hint->y;
     }
 
-    uint32_t remaining_len = dsc->text_length;
-
-    uint32_t line_end = line_start + lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, dsc->letter_space,
-                                                           w, NULL, dsc->flag);
+    uint32_t line_end;
+    if(layout) {
+        /*Skip the lines above the clip area without processing their text*/
+        while(line_id < layout->line_cnt && pos.y + line_height_font < draw_unit->clip_area->y1) {
+            line_id++;
+            pos.y += line_height;
+        }
+        if(line_id == layout->line_cnt) {
+            lv_text_layout_release(layout);
+            return;
+        }
+        line_start = layout->line_starts[line_id];
+        line_end = layout->line_starts[line_id + 1];
+    }
+    else {
+        line_end = line_start + lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, dsc->letter_space,
+                                                      w, NULL, dsc->flag);
+    }
 
     /*Go the first visible line*/
-    while(pos.y + line_height_font < draw_unit->clip_area->y1) {
+    while(layout == NULL && pos.y + line_height_font < draw_unit->clip_area->y1) {
         /*Go to next line*/
         line_start = line_end;
         line_end += lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, dsc->letter_space, w, NULL, dsc->flag);
@@ -446,7 +470,11 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
         /*Go to next line*/
         remaining_len -= line_end - line_start;
         line_start = line_end;
-        if(remaining_len) {
+        if(layout) {
+            line_id++;
+            if(line_id < layout->line_cnt) line_end = layout->line_starts[line_id + 1];
+        }
+        else if(remaining_len) {
             line_end += lv_text_get_next_line(&dsc->text[line_start], remaining_len, font, dsc->letter_space, w, NULL, dsc->flag);
         }
 
@@ -472,6 +500,7 @@ void lv_draw_label_iterate_characters(lv_draw_unit_t * draw_unit, const lv_draw_
     }
 
     if(draw_letter_dsc._draw_buf) lv_draw_buf_destroy(draw_letter_dsc._draw_buf);
+    if(layout) lv_text_layout_release(layout);
 
     LV_ASSERT_MEM_INTEGRITY();
 }
@@ -32,6 +32,7 @@ extern "C" {
 
 struct _lv_draw_task_t {
     lv_draw_task_t * next;
+    lv_draw_task_t * prev;
 
     lv_draw_task_type_t type;
 
@@ -77,6 +78,23 @@ struct _lv_draw_task_t {
      */
     uint8_t preference_score;
 
+#if LV_DRAW_TASK_INDEX
+    /** Order in the layer, older tasks have smaller numbers */
+    uint32_t seq;
+
+    /** Number of older unfinished tasks overlapping this one. It can be drawn only if it's 0.*/
+    uint32_t dep_cnt;
+
+    /** The next unfinished task starting in the same band of the layer */
+    lv_draw_task_t * band_next;
+
+    /** The next task in the layer's list of available or taken tasks */
+    lv_draw_task_t * avail_next;
+
+    /** The previous task in the layer's list of available tasks */
+    lv_draw_task_t * avail_prev;
+#endif
+
 };
 
 struct _lv_draw_mask_t {
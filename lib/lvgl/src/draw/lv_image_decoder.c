@@ -126,8 +126,15 @@ lv_result_t lv_image_decoder_open(lv_image_decoder_dsc_t * dsc, const void * src
      * If decoder open failed, free the source and return error.
      * If decoder open succeed, add the image to cache if enabled.
      * */
+    uint32_t t_start = lv_image_cache_clock();
     lv_result_t res = dsc->decoder->open_cb(dsc->decoder, dsc);
 
+    /*Let the cache know what it would cost to decode this image again*/
+    if(res == LV_RESULT_OK && dsc->cache_entry) {
+        lv_image_cache_data_t * cached_data = lv_cache_entry_get_data(dsc->cache_entry);
+        cached_data->slot.cost = lv_image_cache_clock() - t_start;
+    }
+
     /* Flush the D-Cache if enabled and the image was successfully opened */
     if(dsc->args.flush_cache && res == LV_RESULT_OK && dsc->decoded != NULL) {
         lv_draw_buf_flush_cache(dsc->decoded, NULL);
@@ -233,6 +240,7 @@ lv_cache_entry_t * lv_image_decoder_add_to_cache(lv_image_decoder_t * decoder,
     }
     cached_data->user_data = user_data; /*Need to free data on cache invalidate instead of decoder_close*/
     cached_data->decoder = decoder;
+    cached_data->slot.cost = 0;     /*Measured by lv_image_decoder_open once the decoder returns*/
 
     return cache_entry;
 }
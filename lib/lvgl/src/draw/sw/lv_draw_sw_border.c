@@ -39,6 +39,11 @@ static void draw_border_complex(lv_draw_unit_t * draw_unit, const lv_area_t * ou
 static void draw_border_simple(lv_draw_unit_t * draw_unit, const lv_area_t * outer_area, const lv_area_t * inner_area,
                                lv_color_t color, lv_opa_t opa);
 
+#if LV_DRAW_SW_COMPLEX && LV_DRAW_SW_MASK_CACHE_SIZE
+static void blend_corners(lv_draw_unit_t * draw_unit, lv_draw_sw_blend_dsc_t * blend_dsc, const lv_area_t * coords,
+                          int32_t radius, const lv_opa_t * corners);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -102,20 +107,6 @@ void draw_border_complex(lv_draw_unit_t * draw_unit, const lv_area_t * outer_are
     lv_opa_t * mask_buf = lv_malloc(draw_area_w);
     blend_dsc.mask_buf = mask_buf;
 
-    void * mask_list[3] = {0};
-
-    /*Create mask for the inner mask*/
-    lv_draw_sw_mask_radius_param_t mask_rin_param;
-    lv_draw_sw_mask_radius_init(&mask_rin_param, inner_area, rin, true);
-    mask_list[0] = &mask_rin_param;
-
-    /*Create mask for the outer area*/
-    lv_draw_sw_mask_radius_param_t mask_rout_param;
-    if(rout > 0) {
-        lv_draw_sw_mask_radius_init(&mask_rout_param, outer_area, rout, false);
-        mask_list[1] = &mask_rout_param;
-    }
-
     int32_t h;
     lv_area_t blend_area;
     blend_dsc.blend_area = &blend_area;
@@ -191,6 +182,34 @@ void draw_border_complex(lv_draw_unit_t * draw_unit, const lv_area_t * outer_are
     /*Draw the corners*/
     int32_t blend_w;
 
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+    /*Blend the corners of a border on every side with their cached coverage*/
+    if(split_hor && left_side && right_side && top_side && bottom_side && rin > 0) {
+        lv_cache_entry_t * entry;
+        const lv_opa_t * corners = lv_draw_sw_mask_get_corners(rout, rout - rin, &entry);
+        if(corners) {
+            blend_corners(draw_unit, &blend_dsc, outer_area, rout, corners);
+            lv_draw_sw_mask_cache_release(entry);
+            lv_free(mask_buf);
+            return;
+        }
+    }
+#endif
+
+    void * mask_list[3] = {0};
+
+    /*Create mask for the inner mask*/
+    lv_draw_sw_mask_radius_param_t mask_rin_param;
+    lv_draw_sw_mask_radius_init(&mask_rin_param, inner_area, rin, true);
+    mask_list[0] = &mask_rin_param;
+
+    /*Create mask for the outer area*/
+    lv_draw_sw_mask_radius_param_t mask_rout_param;
+    if(rout > 0) {
+        lv_draw_sw_mask_radius_init(&mask_rout_param, outer_area, rout, false);
+        mask_list[1] = &mask_rout_param;
+    }
+
     /*Left and right corner together if they are close to each other*/
     if(!split_hor) {
         /*Calculate the top corner and mirror it to the bottom*/
@@ -285,6 +304,51 @@ void draw_border_complex(lv_draw_unit_t * draw_unit, const lv_area_t * outer_are
 
 #endif /*LV_DRAW_SW_COMPLEX*/
 }
+
+#if LV_DRAW_SW_COMPLEX && LV_DRAW_SW_MASK_CACHE_SIZE
+/**
+ * Blend the corners of a border
+ * @param draw_unit     pointer to a draw unit
+ * @param blend_dsc     color and opacity to blend, the area and mask fields are overwritten
+ * @param coords        the outer area of the border
+ * @param radius        outer radius of the corners
+ * @param corners       coverage of the corners from `lv_draw_sw_mask_get_corners`
+ */
+static void blend_corners(lv_draw_unit_t * draw_unit, lv_draw_sw_blend_dsc_t * blend_dsc, const lv_area_t * coords,
+                          int32_t radius, const lv_opa_t * corners)
+{
+    int32_t size = radius * 2;
+    lv_area_t mask_area;
+    lv_area_t blend_area;
+    blend_dsc->mask_buf = corners;
+    blend_dsc->mask_stride = size;
+    blend_dsc->mask_area = &mask_area;
+    blend_dsc->mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
+    blend_dsc->blend_area = &blend_area;
+
+    /*Each corner is blended with the matching quarter of the cached border*/
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        bool right = i & 1;
+        bool bottom = i & 2;
+        mask_area.x1 = right ? coords->x2 - size + 1 : coords->x1;
+        mask_area.y1 = bottom ? coords->y2 - size + 1 : coords->y1;
+        mask_area.x2 = mask_area.x1 + size - 1;
+        mask_area.y2 = mask_area.y1 + size - 1;
+
+        blend_area.x1 = right ? coords->x2 - radius + 1 : coords->x1;
+        blend_area.y1 = bottom ? coords->y2 - radius + 1 : coords->y1;
+        blend_area.x2 = blend_area.x1 + radius - 1;
+        blend_area.y2 = blend_area.y1 + radius - 1;
+        lv_draw_sw_blend(draw_unit, blend_dsc);
+    }
+
+    blend_dsc->blend_area = NULL;
+    blend_dsc->mask_area = NULL;
+    blend_dsc->mask_stride = 0;
+}
+#endif
+
 static void draw_border_simple(lv_draw_unit_t * draw_unit, const lv_area_t * outer_area, const lv_area_t * inner_area,
                                lv_color_t color, lv_opa_t opa)
 {
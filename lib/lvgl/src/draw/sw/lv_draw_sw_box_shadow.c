@@ -42,6 +42,10 @@
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf, int32_t s,
                                                                int32_t r);
 static void /* LV_ATTRIBUTE_FAST_MEM */ shadow_blur_corner(int32_t size, int32_t sw, uint16_t * sh_ups_buf);
+static void shadow_mirror_corner_buf(lv_opa_t * sh_buf, int32_t size);
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+    static void render_shadow_corners(lv_draw_sw_mask_cache_data_t * data);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -99,7 +103,29 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
 
     lv_opa_t * sh_buf;
 
-#if LV_DRAW_SW_SHADOW_CACHE_SIZE
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+    /*The corner depends on the size of the core area only if it is smaller than the corner*/
+    lv_draw_sw_mask_cache_data_t key;
+    lv_memzero(&key, sizeof(key));
+    key.render_cb = render_shadow_corners;
+    key.key[0] = dsc->width;
+    key.key[1] = r_sh;
+    key.key[2] = LV_MIN(lv_area_get_width(&core_area), 2 * corner_size);
+    key.key[3] = LV_MIN(lv_area_get_height(&core_area), 2 * corner_size);
+    /*The right corners are followed by their horizontal mirror for the left ones*/
+    key.slot.size = 2 * corner_size * corner_size;
+
+    lv_cache_entry_t * entry = lv_draw_sw_mask_cache_acquire(&key);
+    if(entry) {
+        lv_draw_sw_mask_cache_data_t * data = lv_cache_entry_get_data(entry);
+        sh_buf = data->buf;
+    }
+    else {
+        sh_buf = lv_malloc(corner_size * corner_size * sizeof(uint16_t));
+        LV_ASSERT_MALLOC(sh_buf);
+        shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->width, r_sh);
+    }
+#elif LV_DRAW_SW_SHADOW_CACHE_SIZE
     lv_draw_sw_shadow_cache_t * cache = &shadow_cache;
     if(cache->cache_size == corner_size && cache->cache_r == r_sh) {
         /*Use the cache if available*/
@@ -187,7 +213,7 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
                 blend_area.y2 = y;
 
                 if(!simple_sub) {
-                    lv_memcpy(mask_buf, sh_buf_tmp, corner_size);
+                    lv_memcpy(mask_buf, sh_buf_tmp, w);
                     blend_dsc.mask_res = lv_draw_sw_mask_apply(masks, mask_buf, clip_area_sub.x1, y, w);
                     if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
                 }
@@ -230,7 +256,7 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
                 blend_area.y2 = y;
 
                 if(!simple_sub) {
-                    lv_memcpy(mask_buf, sh_buf_tmp, corner_size);
+                    lv_memcpy(mask_buf, sh_buf_tmp, w);
                     blend_dsc.mask_res = lv_draw_sw_mask_apply(masks, mask_buf, clip_area_sub.x1, y, w);
                     if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
                 }
@@ -383,21 +409,11 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
     }
 
     /*Mirror the shadow corner buffer horizontally*/
-    sh_buf_tmp = sh_buf ;
-    for(y = 0; y < corner_size; y++) {
-        int32_t x;
-        lv_opa_t * start = sh_buf_tmp;
-        lv_opa_t * end = sh_buf_tmp + corner_size - 1;
-        for(x = 0; x < corner_size / 2; x++) {
-            lv_opa_t tmp = *start;
-            *start = *end;
-            *end = tmp;
-
-            start++;
-            end--;
-        }
-        sh_buf_tmp += corner_size;
-    }
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+    if(entry) sh_buf += corner_size * corner_size;
+    else
+#endif
+        shadow_mirror_corner_buf(sh_buf, corner_size);
 
     /*Left side*/
     blend_area.x1 = shadow_area.x1;
@@ -469,7 +485,7 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
                 blend_area.y2 = y;
 
                 if(!simple_sub) {
-                    lv_memcpy(mask_buf, sh_buf_tmp, corner_size);
+                    lv_memcpy(mask_buf, sh_buf_tmp, w);
                     blend_dsc.mask_res = lv_draw_sw_mask_apply(masks, mask_buf, clip_area_sub.x1, y, w);
                     if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
                 }
@@ -513,7 +529,7 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
                 blend_area.y2 = y;
 
                 if(!simple_sub) {
-                    lv_memcpy(mask_buf, sh_buf_tmp, corner_size);
+                    lv_memcpy(mask_buf, sh_buf_tmp, w);
                     blend_dsc.mask_res = lv_draw_sw_mask_apply(masks, mask_buf, clip_area_sub.x1, y, w);
                     if(blend_dsc.mask_res == LV_DRAW_SW_MASK_RES_FULL_COVER) blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
                 }
@@ -555,7 +571,11 @@ void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_
     if(!simple) {
         lv_draw_sw_mask_free_param(&mask_rout_param);
     }
-    lv_free(sh_buf);
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+    if(entry) lv_draw_sw_mask_cache_release(entry);
+    else
+#endif
+        lv_free(sh_buf);
     lv_free(mask_buf);
 }
 
@@ -730,6 +750,51 @@ static void LV_ATTRIBUTE_FAST_MEM shadow_blur_corner(int32_t size, int32_t sw, u
     lv_free(sh_ups_blur_buf);
 }
 
+/**
+ * Mirror a shadow corner buffer horizontally
+ * @param sh_buf    the corner buffer
+ * @param size      width and height of the corner
+ */
+static void shadow_mirror_corner_buf(lv_opa_t * sh_buf, int32_t size)
+{
+    int32_t y;
+    for(y = 0; y < size; y++) {
+        int32_t x;
+        lv_opa_t * start = sh_buf;
+        lv_opa_t * end = sh_buf + size - 1;
+        for(x = 0; x < size / 2; x++) {
+            lv_opa_t tmp = *start;
+            *start = *end;
+            *end = tmp;
+
+            start++;
+            end--;
+        }
+        sh_buf += size;
+    }
+}
+
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+/**
+ * Render the right shadow corner of a cache entry and its mirrored copy after it
+ * @param data      the cache entry with the shadow width, radius and core area size in its key
+ */
+static void render_shadow_corners(lv_draw_sw_mask_cache_data_t * data)
+{
+    int32_t sw = data->key[0];
+    int32_t r = data->key[1];
+    int32_t size = sw + r;
+    lv_area_t core_area = {0, 0, data->key[2] - 1, data->key[3] - 1};
+
+    /*The entry has `2 * size * size` bytes which is just enough for the 16 bit buffer of the calculation*/
+    shadow_draw_corner_buf(&core_area, (uint16_t *)data->buf, sw, r);
+
+    lv_opa_t * mirrored = data->buf + size * size;
+    lv_memcpy(mirrored, data->buf, size * size);
+    shadow_mirror_corner_buf(mirrored, size);
+}
+#endif
+
 #else /*LV_DRAW_SW_COMPLEX*/
 
 void lv_draw_sw_box_shadow(lv_draw_unit_t * draw_unit, const lv_draw_box_shadow_dsc_t * dsc, const lv_area_t * coords)
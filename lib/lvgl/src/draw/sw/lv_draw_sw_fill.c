@@ -32,6 +32,10 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_DRAW_SW_COMPLEX && LV_DRAW_SW_MASK_CACHE_SIZE
+static void blend_corners(lv_draw_unit_t * draw_unit, lv_draw_sw_blend_dsc_t * blend_dsc, const lv_area_t * coords,
+                          int32_t radius, const lv_opa_t * corners);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -81,6 +85,42 @@ void lv_draw_sw_fill(lv_draw_unit_t * draw_unit, lv_draw_fill_dsc_t * dsc, const
     int32_t short_side = LV_MIN(coords_bg_w, coords_bg_h);
     int32_t rout = LV_MIN(dsc->radius, short_side >> 1);
 
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+    /*Blend the corners of an opaque rectangle with their cached coverage and the rest without masks*/
+    if(rout > 0 && grad_dir == LV_GRAD_DIR_NONE && opa == LV_OPA_COVER) {
+        lv_cache_entry_t * entry;
+        const lv_opa_t * corners = lv_draw_sw_mask_get_corners(rout, 0, &entry);
+        if(corners) {
+            blend_dsc.opa = LV_OPA_COVER;
+            blend_corners(draw_unit, &blend_dsc, &bg_coords, rout, corners);
+            lv_draw_sw_mask_cache_release(entry);
+
+            lv_area_t blend_area;
+            blend_dsc.mask_buf = NULL;
+            blend_dsc.blend_area = &blend_area;
+
+            /*Between the top and bottom corners*/
+            blend_area.x1 = bg_coords.x1 + rout;
+            blend_area.x2 = bg_coords.x2 - rout;
+            blend_area.y1 = bg_coords.y1;
+            blend_area.y2 = bg_coords.y1 + rout - 1;
+            lv_draw_sw_blend(draw_unit, &blend_dsc);
+
+            blend_area.y1 = bg_coords.y2 - rout + 1;
+            blend_area.y2 = bg_coords.y2;
+            lv_draw_sw_blend(draw_unit, &blend_dsc);
+
+            /*The center*/
+            blend_area.x1 = bg_coords.x1;
+            blend_area.x2 = bg_coords.x2;
+            blend_area.y1 = bg_coords.y1 + rout;
+            blend_area.y2 = bg_coords.y2 - rout;
+            lv_draw_sw_blend(draw_unit, &blend_dsc);
+            return;
+        }
+    }
+#endif
+
     /*Add a radius mask if there is a radius*/
     int32_t clipped_w = lv_area_get_width(&clipped_coords);
     lv_opa_t * mask_buf = NULL;
@@ -344,4 +384,52 @@ void lv_draw_sw_fill(lv_draw_unit_t * draw_unit, lv_draw_fill_dsc_t * dsc, const
 #endif
 }
 
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_DRAW_SW_COMPLEX && LV_DRAW_SW_MASK_CACHE_SIZE
+/**
+ * Blend the corners of a rounded rectangle
+ * @param draw_unit     pointer to a draw unit
+ * @param blend_dsc     color and opacity to blend, the area and mask fields are overwritten
+ * @param coords        the rectangle
+ * @param radius        radius of its corners
+ * @param corners       coverage of the corners from `lv_draw_sw_mask_get_corners`
+ */
+static void blend_corners(lv_draw_unit_t * draw_unit, lv_draw_sw_blend_dsc_t * blend_dsc, const lv_area_t * coords,
+                          int32_t radius, const lv_opa_t * corners)
+{
+    int32_t size = radius * 2;
+    lv_area_t mask_area;
+    lv_area_t blend_area;
+    blend_dsc->mask_buf = corners;
+    blend_dsc->mask_stride = size;
+    blend_dsc->mask_area = &mask_area;
+    blend_dsc->mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
+    blend_dsc->blend_area = &blend_area;
+
+    /*Each corner is blended with the matching quarter of the cached rectangle*/
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        bool right = i & 1;
+        bool bottom = i & 2;
+        mask_area.x1 = right ? coords->x2 - size + 1 : coords->x1;
+        mask_area.y1 = bottom ? coords->y2 - size + 1 : coords->y1;
+        mask_area.x2 = mask_area.x1 + size - 1;
+        mask_area.y2 = mask_area.y1 + size - 1;
+
+        blend_area.x1 = right ? coords->x2 - radius + 1 : coords->x1;
+        blend_area.y1 = bottom ? coords->y2 - radius + 1 : coords->y1;
+        blend_area.x2 = blend_area.x1 + radius - 1;
+        blend_area.y2 = blend_area.y1 + radius - 1;
+        lv_draw_sw_blend(draw_unit, blend_dsc);
+    }
+
+    blend_dsc->blend_area = NULL;
+    blend_dsc->mask_area = NULL;
+    blend_dsc->mask_stride = 0;
+}
+#endif
+
 #endif /*LV_USE_DRAW_SW*/
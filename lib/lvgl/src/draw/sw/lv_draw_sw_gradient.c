@@ -12,6 +12,7 @@
 #include "../../misc/lv_types.h"
 #include "../../osal/lv_os.h"
 #include "../../misc/lv_math.h"
+#include "../../core/lv_global.h"
 
 /*********************
  *      DEFINES
@@ -19,6 +20,11 @@
 #define GRAD_CM(r,g,b) lv_color_make(r,g,b)
 #define GRAD_CONV(t, x) t = x
 
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+    #define grad_cache_p LV_GLOBAL_DEFAULT()->sw_grad_cache
+    #define GRAD_CACHE_NAME "DRAW_SW_GRAD"
+#endif
+
 #undef ALIGN
 #if defined(LV_ARCH_64)
     #define ALIGN(X)    (((X) + 7) & ~7)
@@ -30,6 +36,16 @@
  *      TYPEDEFS
  **********************/
 
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+typedef struct {
+    lv_cache_slot_size_t slot;
+    lv_gradient_stop_t stops[LV_GRADIENT_MAX_STOPS];
+    uint8_t stops_count;
+    int32_t size;
+    lv_grad_t * grad;
+} grad_cache_data_t;
+#endif
+
 #if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
 
 typedef struct {
@@ -73,7 +89,15 @@ typedef struct {
  *  STATIC PROTOTYPES
  **********************/
 typedef lv_result_t (*op_cache_t)(lv_grad_t * c, void * ctx);
-static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h);
+static lv_grad_t * allocate_item(int32_t size);
+static lv_grad_t * get_color_map(const lv_grad_dsc_t * g, int32_t size);
+static void fill_color_map(const lv_grad_dsc_t * g, lv_grad_t * item);
+
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+    static bool grad_cache_create_cb(grad_cache_data_t * node, void * user_data);
+    static void grad_cache_free_cb(grad_cache_data_t * node, void * user_data);
+    static lv_cache_compare_res_t grad_cache_compare_cb(const grad_cache_data_t * lhs, const grad_cache_data_t * rhs);
+#endif
 
 #if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
 
@@ -89,23 +113,8 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h);
  *   STATIC FUNCTIONS
  **********************/
 
-static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h)
+static lv_grad_t * allocate_item(int32_t size)
 {
-    int32_t size;
-    switch(g->dir) {
-        case LV_GRAD_DIR_HOR:
-        case LV_GRAD_DIR_LINEAR:
-        case LV_GRAD_DIR_RADIAL:
-        case LV_GRAD_DIR_CONICAL:
-            size = w;
-            break;
-        case LV_GRAD_DIR_VER:
-            size = h;
-            break;
-        default:
-            size = 64;
-    }
-
     size_t req_size = ALIGN(sizeof(lv_grad_t)) + ALIGN(size * sizeof(lv_color_t)) + ALIGN(size * sizeof(lv_opa_t));
     lv_grad_t * item  = lv_malloc(req_size);
     LV_ASSERT_MALLOC(item);
@@ -115,9 +124,107 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, int32_t w, int32_t h)
     item->color_map = (lv_color_t *)(p + ALIGN(sizeof(*item)));
     item->opa_map = (lv_opa_t *)(p + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_color_t)));
     item->size = size;
+    item->cache_entry = NULL;
     return item;
 }
 
+static void fill_color_map(const lv_grad_dsc_t * g, lv_grad_t * item)
+{
+    uint32_t i;
+    for(i = 0; i < item->size; i++) {
+        lv_gradient_color_calculate(g, item->size, i, &item->color_map[i], &item->opa_map[i]);
+    }
+}
+
+/**
+ * Get the color and opacity map of a gradient from the cache, or calculate a new one if it's not cached
+ * @param g         the gradient, only its stops are used
+ * @param size      number of colors in the map
+ * @return          the map, release it with `lv_gradient_cleanup`
+ */
+static lv_grad_t * get_color_map(const lv_grad_dsc_t * g, int32_t size)
+{
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+    size_t req_size = ALIGN(sizeof(lv_grad_t)) + ALIGN(size * sizeof(lv_color_t)) + ALIGN(size * sizeof(lv_opa_t));
+    /*A map taking a large part of the cache would only push out many small ones*/
+    if(grad_cache_p && req_size <= LV_DRAW_SW_GRADIENT_CACHE_SIZE / 4) {
+        grad_cache_data_t search_key;
+        lv_memzero(&search_key, sizeof(search_key));
+        lv_memcpy(search_key.stops, g->stops, g->stops_count * sizeof(lv_gradient_stop_t));
+        search_key.stops_count = g->stops_count;
+        search_key.size = size;
+        search_key.slot.size = req_size;
+
+        lv_cache_entry_t * entry = lv_cache_acquire_or_create(grad_cache_p, &search_key, NULL);
+        if(entry) {
+            grad_cache_data_t * data = lv_cache_entry_get_data(entry);
+            return data->grad;
+        }
+    }
+#endif
+
+    lv_grad_t * item = allocate_item(size);
+    if(item == NULL) return NULL;
+    fill_color_map(g, item);
+    return item;
+}
+
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+
+static bool grad_cache_create_cb(grad_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_grad_t * item = allocate_item(node->size);
+    if(item == NULL) return false;
+
+    /*Only the stops are used for the map*/
+    lv_grad_dsc_t g;
+    lv_memzero(&g, sizeof(g));
+    lv_memcpy(g.stops, node->stops, sizeof(node->stops));
+    g.stops_count = node->stops_count;
+    fill_color_map(&g, item);
+
+    item->cache_entry = lv_cache_entry_get_entry(node, sizeof(grad_cache_data_t));
+    node->grad = item;
+    return true;
+}
+
+static void grad_cache_free_cb(grad_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+    lv_free(node->grad);
+}
+
+static lv_cache_compare_res_t grad_cache_compare_cb(const grad_cache_data_t * lhs, const grad_cache_data_t * rhs)
+{
+    if(lhs->size != rhs->size) {
+        return lhs->size > rhs->size ? 1 : -1;
+    }
+    if(lhs->stops_count != rhs->stops_count) {
+        return lhs->stops_count > rhs->stops_count ? 1 : -1;
+    }
+
+    uint32_t i;
+    for(i = 0; i < lhs->stops_count; i++) {
+        const lv_gradient_stop_t * l = &lhs->stops[i];
+        const lv_gradient_stop_t * r = &rhs->stops[i];
+        uint32_t l_color = lv_color_to_int(l->color);
+        uint32_t r_color = lv_color_to_int(r->color);
+        if(l_color != r_color) {
+            return l_color > r_color ? 1 : -1;
+        }
+        uint32_t l_opa_frac = (l->opa << 8) | l->frac;
+        uint32_t r_opa_frac = (r->opa << 8) | r->frac;
+        if(l_opa_frac != r_opa_frac) {
+            return l_opa_frac > r_opa_frac ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+#endif /*LV_DRAW_SW_GRADIENT_CACHE_SIZE*/
+
 #if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
 
 static inline int32_t extend_w(int32_t w, lv_grad_extend_t extend)
@@ -141,23 +248,64 @@ static inline int32_t extend_w(int32_t w, lv_grad_extend_t extend)
  *     FUNCTIONS
  **********************/
 
+void lv_gradient_cache_init(void)
+{
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+    if(grad_cache_p != NULL) return;
+
+    grad_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(grad_cache_data_t),
+    LV_DRAW_SW_GRADIENT_CACHE_SIZE, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t)grad_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t)grad_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t)grad_cache_free_cb,
+    });
+    if(grad_cache_p) lv_cache_set_name(grad_cache_p, GRAD_CACHE_NAME);
+#endif
+}
+
+void lv_gradient_cache_deinit(void)
+{
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+    if(grad_cache_p) {
+        lv_cache_destroy(grad_cache_p, NULL);
+        grad_cache_p = NULL;
+    }
+#endif
+}
+
+void lv_gradient_cache_get_stats(lv_cache_stats_t * stats)
+{
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+    if(grad_cache_p) {
+        lv_cache_get_stats(grad_cache_p, stats);
+        return;
+    }
+#endif
+    lv_memzero(stats, sizeof(lv_cache_stats_t));
+}
+
 lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, int32_t w, int32_t h)
 {
     /* No gradient, no cache */
     if(g->dir == LV_GRAD_DIR_NONE) return NULL;
 
-    /* Step 1: Search cache for the given key */
-    lv_grad_t * item = allocate_item(g, w, h);
-    if(item == NULL) {
-        LV_LOG_WARN("Failed to allocate item for the gradient");
-        return item;
+    lv_grad_t * item;
+    switch(g->dir) {
+        /* The maps of horizontal and vertical gradients are only read, so they can be shared */
+        case LV_GRAD_DIR_HOR:
+            item = get_color_map(g, w);
+            break;
+        case LV_GRAD_DIR_VER:
+            item = get_color_map(g, h);
+            break;
+        /* The other gradients render their lines into the maps */
+        default:
+            item = allocate_item(w);
+            if(item) fill_color_map(g, item);
+            break;
     }
 
-    /* Step 3: Fill it with the gradient, as expected */
-    uint32_t i;
-    for(i = 0; i < item->size; i++) {
-        lv_gradient_color_calculate(g, item->size, i, &item->color_map[i], &item->opa_map[i]);
-    }
+    if(item == NULL) LV_LOG_WARN("Failed to allocate item for the gradient");
     return item;
 }
 
@@ -216,6 +364,12 @@ void LV_ATTRIBUTE_FAST_MEM lv_gradient_color_calculate(const lv_grad_dsc_t * dsc
 
 void lv_gradient_cleanup(lv_grad_t * grad)
 {
+#if LV_DRAW_SW_GRADIENT_CACHE_SIZE
+    if(grad->cache_entry) {
+        lv_cache_release(grad_cache_p, grad->cache_entry, NULL);
+        return;
+    }
+#endif
     lv_free(grad);
 }
 
@@ -305,7 +459,7 @@ void lv_gradient_radial_setup(lv_grad_dsc_t * dsc, const lv_area_t * coords)
     LV_ASSERT(r_end != 0);
 
     /* Create gradient color map */
-    state->cgrad = lv_gradient_get(dsc, 256, 0);
+    state->cgrad = get_color_map(dsc, 256);
 
     state->x0 = start.x;
     state->y0 = start.y;
@@ -474,7 +628,7 @@ void lv_gradient_linear_setup(lv_grad_dsc_t * dsc, const lv_area_t * coords)
     dsc->state = state;
 
     /* Create gradient color map */
-    state->cgrad = lv_gradient_get(dsc, 256, 0);
+    state->cgrad = get_color_map(dsc, 256);
 
     /* Convert from percentage coordinates */
     int32_t wdt = lv_area_get_width(coords);
@@ -548,7 +702,7 @@ void lv_gradient_conical_setup(lv_grad_dsc_t * dsc, const lv_area_t * coords)
     dsc->state = state;
 
     /* Create gradient color map */
-    state->cgrad = lv_gradient_get(dsc, 256, 0);
+    state->cgrad = get_color_map(dsc, 256);
 
     /* Convert from percentage coordinates */
     int32_t wdt = lv_area_get_width(coords);
@@ -60,6 +60,13 @@ lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * gradient, int32_t w, int32_t h
  */
 void lv_gradient_cleanup(lv_grad_t * grad);
 
+/**
+ * Get the hit, miss and eviction counters of the gradient cache.
+ * All are zero if `LV_DRAW_SW_GRADIENT_CACHE_SIZE` is 0.
+ * @param stats     store the statistics here
+ */
+void lv_gradient_cache_get_stats(lv_cache_stats_t * stats);
+
 /**
  * Initialize gradient color map from a table
  * @param grad      pointer to a gradient descriptor
@@ -18,6 +18,8 @@ extern "C" {
 
 #if LV_USE_DRAW_SW
 
+#include "../../misc/cache/lv_cache.h"
+
 /*********************
  *      DEFINES
  *********************/
@@ -30,6 +32,7 @@ struct _lv_grad_t {
     lv_color_t   *  color_map;
     lv_opa_t   *  opa_map;
     uint32_t size;
+    lv_cache_entry_t * cache_entry;     /**< The entry of the gradient cache holding the maps, NULL if not cached*/
 };
 
 
@@ -37,6 +40,16 @@ struct _lv_grad_t {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Create the cache of gradient color maps (see `LV_DRAW_SW_GRADIENT_CACHE_SIZE`). Called by `lv_draw_sw_init`
+ */
+void lv_gradient_cache_init(void);
+
+/**
+ * Free the cached gradient color maps. Called by `lv_draw_sw_deinit`
+ */
+void lv_gradient_cache_deinit(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -6,8 +6,10 @@
 /*********************
  *      INCLUDES
  *********************/
+#include "../../misc/lv_area_private.h"
 #include "blend/lv_draw_sw_blend_private.h"
 #include "../lv_draw_label_private.h"
+#include "../lv_draw_private.h"
 #include "lv_draw_sw.h"
 #if LV_USE_DRAW_SW
 
@@ -17,6 +19,7 @@
 #include "../../misc/lv_area.h"
 #include "../../misc/lv_style.h"
 #include "../../font/lv_font.h"
+#include "../../font/lv_font_fmt_txt.h"
 #include "../../core/lv_refr_private.h"
 #include "../../stdlib/lv_string.h"
 
@@ -34,11 +37,26 @@
 
 static void /* LV_ATTRIBUTE_FAST_MEM */ draw_letter_cb(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * glyph_draw_dsc,
                                                        lv_draw_fill_dsc_t * fill_draw_dsc, const lv_area_t * fill_area);
+static void draw_letter_a8(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * glyph_draw_dsc);
+#if LV_DRAW_SW_SUPPORT_RGB565
+static bool draw_letter_packed_to_rgb565(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * glyph_draw_dsc);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 
+#if LV_DRAW_SW_SUPPORT_RGB565
+/*The same opacity values as the A8 bitmaps of the fonts have*/
+static const uint8_t opa1_table[2] = {0, 255};
+static const uint8_t opa2_table[4] = {0, 85, 170, 255};
+static const uint8_t opa4_table[16] = {0,  17, 34,  51,
+                                       68, 85, 102, 119,
+                                       136, 153, 170, 187,
+                                       204, 221, 238, 255
+                                      };
+#endif
+
 /**********************
  *  GLOBAL VARIABLES
  **********************/
@@ -83,29 +101,23 @@ static void LV_ATTRIBUTE_FAST_MEM draw_letter_cb(lv_draw_unit_t * draw_unit, lv_
                 break;
             case LV_FONT_GLYPH_FORMAT_A1:
             case LV_FONT_GLYPH_FORMAT_A2:
-            case LV_FONT_GLYPH_FORMAT_A3:
             case LV_FONT_GLYPH_FORMAT_A4:
-            case LV_FONT_GLYPH_FORMAT_A8:
             case LV_FONT_GLYPH_FORMAT_A1_ALIGNED:
             case LV_FONT_GLYPH_FORMAT_A2_ALIGNED:
             case LV_FONT_GLYPH_FORMAT_A4_ALIGNED:
-            case LV_FONT_GLYPH_FORMAT_A8_ALIGNED: {
-                    glyph_draw_dsc->glyph_data = lv_font_get_glyph_bitmap(glyph_draw_dsc->g, glyph_draw_dsc->_draw_buf);
-                    lv_area_t mask_area = *glyph_draw_dsc->letter_coords;
-                    mask_area.x2 = mask_area.x1 + lv_draw_buf_width_to_stride(lv_area_get_width(&mask_area), LV_COLOR_FORMAT_A8) - 1;
-                    lv_draw_sw_blend_dsc_t blend_dsc;
-                    lv_memzero(&blend_dsc, sizeof(blend_dsc));
-                    blend_dsc.color = glyph_draw_dsc->color;
-                    blend_dsc.opa = glyph_draw_dsc->opa;
-                    const lv_draw_buf_t * draw_buf = glyph_draw_dsc->glyph_data;
-                    blend_dsc.mask_buf = draw_buf->data;
-                    blend_dsc.mask_area = &mask_area;
-                    blend_dsc.mask_stride = draw_buf->header.stride;
-                    blend_dsc.blend_area = glyph_draw_dsc->letter_coords;
-                    blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
-
-                    lv_draw_sw_blend(draw_unit, &blend_dsc);
+#if LV_DRAW_SW_SUPPORT_RGB565
+                /*Blend the packed bitmap directly if possible instead of expanding it to A8*/
+                if(draw_unit->target_layer->color_format == LV_COLOR_FORMAT_RGB565 &&
+                   draw_letter_packed_to_rgb565(draw_unit, glyph_draw_dsc)) {
+                    break;
                 }
+#endif
+                draw_letter_a8(draw_unit, glyph_draw_dsc);
+                break;
+            case LV_FONT_GLYPH_FORMAT_A3:
+            case LV_FONT_GLYPH_FORMAT_A8:
+            case LV_FONT_GLYPH_FORMAT_A8_ALIGNED:
+                draw_letter_a8(draw_unit, glyph_draw_dsc);
                 break;
             case LV_FONT_GLYPH_FORMAT_IMAGE: {
                     glyph_draw_dsc->glyph_data = lv_font_get_glyph_bitmap(glyph_draw_dsc->g, glyph_draw_dsc->_draw_buf);
@@ -130,4 +142,91 @@ static void LV_ATTRIBUTE_FAST_MEM draw_letter_cb(lv_draw_unit_t * draw_unit, lv_
     }
 }
 
+/**
+ * Draw a letter by blending the A8 bitmap of the glyph
+ * @param draw_unit         pointer to a draw unit
+ * @param glyph_draw_dsc    the glyph to draw
+ */
+static void draw_letter_a8(lv_draw_unit_t * draw_unit, lv_draw_glyph_dsc_t * glyph_draw_dsc)
+{
+    glyph_draw_dsc->glyph_data = lv_font_get_glyph_bitmap(glyph_draw_dsc->g, glyph_draw_dsc->_draw_buf);
+    lv_area_t mask_area = *glyph_draw_dsc->letter_coords;
+    mask_area.x2 = mask_area.x1 + lv_draw_buf_width_to_stride(lv_area_get_width(&mask_area), LV_COLOR_FORMAT_A8) - 1;
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memzero(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.color = glyph_draw_dsc->color;
+    blend_dsc.opa = glyph_draw_dsc->opa;
+    const lv_draw_buf_t * draw_buf = glyph_draw_dsc->glyph_data;
+    blend_dsc.mask_buf = draw_buf->data;
+    blend_dsc.mask_area = &mask_area;
+    blend_dsc.mask_stride = draw_buf->header.stride;
+    blend_dsc.blend_area = glyph_draw_dsc->letter_coords;
+    blend_dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
+
+    lv_draw_sw_blend(draw_unit, &blend_dsc);
+}
+
+#if LV_DRAW_SW_SUPPORT_RGB565
+/**
+ * Draw a letter from the packed 1, 2 or 4 bpp bitmap of the font into an RGB565 layer.
+ * The result is the same as blending the A8 bitmap with `lv_draw_sw_blend`.
+ * @param draw_unit         pointer to a draw unit
+ * @param glyph_draw_dsc    the glyph to draw
+ * @return                  false if the font has no packed bitmap, the A8 bitmap should be used then
+ */
+static bool LV_ATTRIBUTE_FAST_MEM draw_letter_packed_to_rgb565(lv_draw_unit_t * draw_unit,
+                                                               lv_draw_glyph_dsc_t * glyph_draw_dsc)
+{
+    const uint8_t * bitmap = lv_font_fmt_txt_get_packed_bitmap(glyph_draw_dsc->g);
+    if(bitmap == NULL) return false;
+
+    lv_opa_t opa = glyph_draw_dsc->opa;
+    if(opa <= LV_OPA_MIN) return true;
+
+    const lv_area_t * letter_coords = glyph_draw_dsc->letter_coords;
+    lv_area_t blend_area;
+    if(!lv_area_intersect(&blend_area, letter_coords, draw_unit->clip_area)) return true;
+
+    LV_PROFILER_DRAW_BEGIN;
+    lv_font_glyph_format_t format = glyph_draw_dsc->format;
+    bool aligned = format >= LV_FONT_GLYPH_FORMAT_A1_ALIGNED;
+    uint32_t bpp = aligned ? format - (LV_FONT_GLYPH_FORMAT_A1_ALIGNED - LV_FONT_GLYPH_FORMAT_A1) : format;
+    const uint8_t * opa_table = bpp == 1 ? opa1_table : bpp == 2 ? opa2_table : opa4_table;
+    uint32_t px_mask = (1 << bpp) - 1;
+
+    /*Number of bits from the start of a row to the next one*/
+    uint32_t row_bits = lv_area_get_width(letter_coords) * bpp;
+    if(aligned) row_bits = (row_bits + 7) & ~0x7;
+
+    lv_layer_t * layer = draw_unit->target_layer;
+    int32_t dest_stride = layer->draw_buf->header.stride;
+    uint16_t * dest_buf = lv_draw_layer_go_to_xy(layer, blend_area.x1 - layer->buf_area.x1,
+                                                 blend_area.y1 - layer->buf_area.y1);
+    uint16_t color16 = lv_color_to_u16(glyph_draw_dsc->color);
+    int32_t w = lv_area_get_width(&blend_area);
+    int32_t h = lv_area_get_height(&blend_area);
+    uint32_t row_start = (blend_area.y1 - letter_coords->y1) * row_bits + (blend_area.x1 - letter_coords->x1) * bpp;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        uint32_t bit = row_start;
+        for(x = 0; x < w; x++, bit += bpp) {
+            uint32_t v = (bitmap[bit >> 3] >> (8 - bpp - (bit & 0x7))) & px_mask;
+            if(v == 0) continue;
+
+            lv_opa_t mix = opa_table[v];
+            if(opa < LV_OPA_MAX) mix = LV_OPA_MIX2(mix, opa);
+            if(mix == LV_OPA_COVER) dest_buf[x] = color16;
+            else dest_buf[x] = lv_color_16_16_mix(color16, dest_buf[x], mix);
+        }
+        row_start += row_bits;
+        dest_buf = (uint16_t *)((uint8_t *)dest_buf + dest_stride);
+    }
+
+    LV_PROFILER_DRAW_END;
+    return true;
+}
+#endif /*LV_DRAW_SW_SUPPORT_RGB565*/
+
 #endif /*LV_USE_DRAW_SW*/
@@ -25,6 +25,10 @@
 #define CIRCLE_CACHE_AGING(life, r)     life = LV_MIN(life + (r < 16 ? 1 : (r >> 4)), 1000)
 #define circle_cache_mutex              LV_GLOBAL_DEFAULT()->draw_info.circle_cache_mutex
 #define _circle_cache                   LV_GLOBAL_DEFAULT()->sw_circle_cache
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+    #define mask_cache_p                LV_GLOBAL_DEFAULT()->sw_mask_cache
+    #define MASK_CACHE_NAME             "DRAW_SW_MASK"
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -66,6 +70,14 @@ static lv_opa_t * get_next_line(lv_draw_sw_mask_radius_circle_dsc_t * c, int32_t
                                 int32_t * x_start);
 static inline lv_opa_t /* LV_ATTRIBUTE_FAST_MEM */ mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
 
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+    static void render_corners(lv_draw_sw_mask_cache_data_t * data);
+    static bool mask_cache_create_cb(lv_draw_sw_mask_cache_data_t * node, void * user_data);
+    static void mask_cache_free_cb(lv_draw_sw_mask_cache_data_t * node, void * user_data);
+    static lv_cache_compare_res_t mask_cache_compare_cb(const lv_draw_sw_mask_cache_data_t * lhs,
+                                                        const lv_draw_sw_mask_cache_data_t * rhs);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -81,13 +93,84 @@ static inline lv_opa_t /* LV_ATTRIBUTE_FAST_MEM */ mask_mix(lv_opa_t mask_act, l
 void lv_draw_sw_mask_init(void)
 {
     lv_mutex_init(&circle_cache_mutex);
+
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+    mask_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(lv_draw_sw_mask_cache_data_t),
+    LV_DRAW_SW_MASK_CACHE_SIZE, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t)mask_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t)mask_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t)mask_cache_free_cb,
+    });
+    if(mask_cache_p) lv_cache_set_name(mask_cache_p, MASK_CACHE_NAME);
+#endif
 }
 
 void lv_draw_sw_mask_deinit(void)
 {
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+    if(mask_cache_p) {
+        lv_cache_destroy(mask_cache_p, NULL);
+        mask_cache_p = NULL;
+    }
+#endif
+
     lv_mutex_delete(&circle_cache_mutex);
 }
 
+void lv_draw_sw_mask_cache_get_stats(lv_cache_stats_t * stats)
+{
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+    if(mask_cache_p) {
+        lv_cache_get_stats(mask_cache_p, stats);
+        return;
+    }
+#endif
+    lv_memzero(stats, sizeof(lv_cache_stats_t));
+}
+
+lv_cache_entry_t * lv_draw_sw_mask_cache_acquire(const lv_draw_sw_mask_cache_data_t * key)
+{
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+    /*A mask taking a large part of the cache would only push out many small ones*/
+    if(mask_cache_p == NULL || key->slot.size == 0 || key->slot.size > LV_DRAW_SW_MASK_CACHE_SIZE / 4) return NULL;
+    return lv_cache_acquire_or_create(mask_cache_p, key, NULL);
+#else
+    LV_UNUSED(key);
+    return NULL;
+#endif
+}
+
+void lv_draw_sw_mask_cache_release(lv_cache_entry_t * entry)
+{
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+    lv_cache_release(mask_cache_p, entry, NULL);
+#else
+    LV_UNUSED(entry);
+#endif
+}
+
+const lv_opa_t * lv_draw_sw_mask_get_corners(int32_t radius, int32_t width, lv_cache_entry_t ** entry)
+{
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+    lv_draw_sw_mask_cache_data_t key;
+    lv_memzero(&key, sizeof(key));
+    key.render_cb = render_corners;
+    key.key[0] = radius;
+    key.key[1] = width;
+    key.slot.size = 4 * radius * radius;
+
+    *entry = lv_draw_sw_mask_cache_acquire(&key);
+    if(*entry == NULL) return NULL;
+    lv_draw_sw_mask_cache_data_t * data = lv_cache_entry_get_data(*entry);
+    return data->buf;
+#else
+    LV_UNUSED(radius);
+    LV_UNUSED(width);
+    *entry = NULL;
+    return NULL;
+#endif
+}
+
 lv_draw_sw_mask_res_t LV_ATTRIBUTE_FAST_MEM lv_draw_sw_mask_apply(void * masks[], lv_opa_t * mask_buf, int32_t abs_x,
                                                                   int32_t abs_y,
                                                                   int32_t len)
@@ -1233,4 +1316,80 @@ static inline lv_opa_t LV_ATTRIBUTE_FAST_MEM mask_mix(lv_opa_t mask_act, lv_opa_
     return LV_UDIV255(mask_act * mask_new);
 }
 
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+
+/**
+ * Render a rounded rectangle or border with the same masks as `lv_draw_sw_fill` and `lv_draw_sw_border` use
+ * @param data      `key[0]` is the radius and the half size of the rectangle, `key[1]` the border width or 0
+ */
+static void render_corners(lv_draw_sw_mask_cache_data_t * data)
+{
+    int32_t radius = data->key[0];
+    int32_t width = data->key[1];
+    int32_t size = radius * 2;
+    lv_area_t rect = {0, 0, size - 1, size - 1};
+
+    /*The border masks are applied in the same order as in lv_draw_sw_border*/
+    void * mask_list[3] = {0};
+    lv_draw_sw_mask_radius_param_t mask_rin_param;
+    lv_draw_sw_mask_radius_param_t mask_rout_param;
+    if(width > 0) {
+        lv_area_t inner = {width, width, size - 1 - width, size - 1 - width};
+        lv_draw_sw_mask_radius_init(&mask_rin_param, &inner, radius - width, true);
+        mask_list[0] = &mask_rin_param;
+        lv_draw_sw_mask_radius_init(&mask_rout_param, &rect, radius, false);
+        mask_list[1] = &mask_rout_param;
+    }
+    else {
+        lv_draw_sw_mask_radius_init(&mask_rout_param, &rect, radius, false);
+        mask_list[0] = &mask_rout_param;
+    }
+
+    int32_t y;
+    lv_opa_t * buf = data->buf;
+    for(y = 0; y < size; y++) {
+        lv_memset(buf, 0xff, size);
+        if(lv_draw_sw_mask_apply(mask_list, buf, 0, y, size) == LV_DRAW_SW_MASK_RES_TRANSP) lv_memzero(buf, size);
+        buf += size;
+    }
+
+    if(width > 0) lv_draw_sw_mask_free_param(&mask_rin_param);
+    lv_draw_sw_mask_free_param(&mask_rout_param);
+}
+
+static bool mask_cache_create_cb(lv_draw_sw_mask_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    node->buf = lv_malloc(node->slot.size);
+    if(node->buf == NULL) return false;
+
+    node->render_cb(node);
+    return true;
+}
+
+static void mask_cache_free_cb(lv_draw_sw_mask_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+    lv_free(node->buf);
+}
+
+static lv_cache_compare_res_t mask_cache_compare_cb(const lv_draw_sw_mask_cache_data_t * lhs,
+                                                    const lv_draw_sw_mask_cache_data_t * rhs)
+{
+    if(lhs->render_cb != rhs->render_cb) {
+        return (uintptr_t)lhs->render_cb > (uintptr_t)rhs->render_cb ? 1 : -1;
+    }
+
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        if(lhs->key[i] != rhs->key[i]) {
+            return lhs->key[i] > rhs->key[i] ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+#endif /*LV_DRAW_SW_MASK_CACHE_SIZE*/
+
 #endif /*LV_DRAW_SW_COMPLEX*/
@@ -72,6 +72,13 @@ void lv_draw_sw_mask_init(void);
 
 void lv_draw_sw_mask_deinit(void);
 
+/**
+ * Get the hit, miss and eviction counters and the size of the cache of corner masks
+ * (see `LV_DRAW_SW_MASK_CACHE_SIZE`)
+ * @param stats     store the statistics here, all zero if caching is disabled
+ */
+void lv_draw_sw_mask_cache_get_stats(lv_cache_stats_t * stats);
+
 //! @cond Doxygen_Suppress
 
 /**
@@ -18,6 +18,8 @@ extern "C" {
 
 #if LV_DRAW_SW_COMPLEX
 
+#include "../../misc/cache/lv_cache.h"
+
 /*********************
  *      DEFINES
  *********************/
@@ -134,6 +136,21 @@ struct _lv_draw_sw_mask_map_param_t {
 
 typedef lv_draw_sw_mask_radius_circle_dsc_t lv_draw_sw_mask_radius_circle_dsc_arr_t[LV_DRAW_SW_CIRCLE_CACHE_SIZE];
 
+typedef struct _lv_draw_sw_mask_cache_data_t lv_draw_sw_mask_cache_data_t;
+
+/**
+ * Render a mask of the mask cache
+ * @param data      render `data->slot.size` bytes into `data->buf` from `data->key`
+ */
+typedef void (*lv_draw_sw_mask_cache_render_cb_t)(lv_draw_sw_mask_cache_data_t * data);
+
+struct _lv_draw_sw_mask_cache_data_t {
+    lv_cache_slot_size_t slot;                      /**< `slot.size` is the size of `buf` in bytes */
+    lv_draw_sw_mask_cache_render_cb_t render_cb;    /**< Renders the mask, also tells the kind of the mask */
+    int32_t key[4];                                 /**< Parameters of the mask, the unused ones are 0 */
+    lv_opa_t * buf;
+};
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -144,6 +161,31 @@ typedef lv_draw_sw_mask_radius_circle_dsc_t lv_draw_sw_mask_radius_circle_dsc_ar
  */
 void lv_draw_sw_mask_cleanup(void);
 
+/**
+ * Get a mask from the mask cache (see `LV_DRAW_SW_MASK_CACHE_SIZE`), rendering it if it's not there yet
+ * @param key       `render_cb`, `key` and `slot.size` of the mask
+ * @return          the cache entry whose data is an `lv_draw_sw_mask_cache_data_t`,
+ *                  or NULL if caching is disabled, the mask is too large or out of memory
+ */
+lv_cache_entry_t * lv_draw_sw_mask_cache_acquire(const lv_draw_sw_mask_cache_data_t * key);
+
+/**
+ * Release a mask acquired with `lv_draw_sw_mask_cache_acquire`
+ * @param entry     the cache entry of the mask
+ */
+void lv_draw_sw_mask_cache_release(lv_cache_entry_t * entry);
+
+/**
+ * Get the coverage of a `2 * radius` wide and tall rounded rectangle from the mask cache.
+ * Its quarters are the corners of every rounded rectangle with this radius, and with `width`
+ * the corners of every border with this radius and width on all four sides.
+ * @param radius    radius of the corners, already clamped to the size of the rectangle
+ * @param width     width of the border, or 0 for a filled rectangle. Must be less than `radius`
+ * @param entry     store the cache entry here, release it with `lv_draw_sw_mask_cache_release`
+ * @return          `(2 * radius)^2` opacity values row by row, or NULL if the corners aren't cached
+ */
+const lv_opa_t * lv_draw_sw_mask_get_corners(int32_t radius, int32_t width, lv_cache_entry_t ** entry);
+
 /**********************
  *      MACROS
  **********************/
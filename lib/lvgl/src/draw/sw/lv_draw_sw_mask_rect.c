@@ -30,6 +30,10 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+static void apply_corners(lv_draw_unit_t * draw_unit, const lv_area_t * coords, const lv_area_t * draw_area,
+                          int32_t radius, const lv_opa_t * corners);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -80,6 +84,20 @@ void lv_draw_sw_mask_rect(lv_draw_unit_t * draw_unit, const lv_draw_mask_rect_ds
     lv_area_move(&clear_area, -buf_area->x1, -buf_area->y1);
     lv_draw_buf_clear(draw_buf, &clear_area);
 
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+    /*Only the corners are masked inside the area, apply their cached coverage*/
+    int32_t radius = LV_MIN(dsc->radius, LV_MIN(lv_area_get_width(&dsc->area), lv_area_get_height(&dsc->area)) >> 1);
+    if(radius <= 0) return;
+
+    lv_cache_entry_t * entry;
+    const lv_opa_t * corners = lv_draw_sw_mask_get_corners(radius, 0, &entry);
+    if(corners) {
+        apply_corners(draw_unit, &dsc->area, &draw_area, radius, corners);
+        lv_draw_sw_mask_cache_release(entry);
+        return;
+    }
+#endif
+
     lv_draw_sw_mask_radius_param_t param;
     lv_draw_sw_mask_radius_init(&param, &dsc->area, dsc->radius, false);
 
@@ -119,6 +137,55 @@ void lv_draw_sw_mask_rect(lv_draw_unit_t * draw_unit, const lv_draw_mask_rect_ds
  *   STATIC FUNCTIONS
  **********************/
 
+#if LV_DRAW_SW_MASK_CACHE_SIZE
+/**
+ * Multiply the alpha of the corners of an area with the coverage of rounded corners
+ * @param draw_unit     pointer to a draw unit
+ * @param coords        the rounded area
+ * @param draw_area     the part of `coords` to change
+ * @param radius        radius of the corners
+ * @param corners       coverage of the corners from `lv_draw_sw_mask_get_corners`
+ */
+static void apply_corners(lv_draw_unit_t * draw_unit, const lv_area_t * coords, const lv_area_t * draw_area,
+                          int32_t radius, const lv_opa_t * corners)
+{
+    lv_layer_t * target_layer = draw_unit->target_layer;
+    lv_area_t * buf_area = &target_layer->buf_area;
+    int32_t size = radius * 2;
+
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        bool right = i & 1;
+        bool bottom = i & 2;
+        lv_area_t corner_area;
+        corner_area.x1 = right ? coords->x2 - radius + 1 : coords->x1;
+        corner_area.y1 = bottom ? coords->y2 - radius + 1 : coords->y1;
+        corner_area.x2 = corner_area.x1 + radius - 1;
+        corner_area.y2 = corner_area.y1 + radius - 1;
+        if(!lv_area_intersect(&corner_area, &corner_area, draw_area)) continue;
+
+        /*Top left pixel of the corner in the cached rectangle*/
+        int32_t mask_x = corner_area.x1 - (right ? coords->x2 - size + 1 : coords->x1);
+        int32_t mask_y = corner_area.y1 - (bottom ? coords->y2 - size + 1 : coords->y1);
+        const lv_opa_t * mask = corners + mask_y * size + mask_x;
+        int32_t w = lv_area_get_width(&corner_area);
+
+        int32_t y;
+        for(y = corner_area.y1; y <= corner_area.y2; y++) {
+            lv_color32_t * c32_buf = lv_draw_layer_go_to_xy(target_layer, corner_area.x1 - buf_area->x1,
+                                                            y - buf_area->y1);
+            int32_t x;
+            for(x = 0; x < w; x++) {
+                if(mask[x] != LV_OPA_COVER) {
+                    c32_buf[x].alpha = LV_OPA_MIX2(c32_buf[x].alpha, mask[x]);
+                }
+            }
+            mask += size;
+        }
+    }
+}
+#endif
+
 #else /*LV_DRAW_SW_COMPLEX*/
 
 void lv_draw_sw_mask_rect(lv_draw_unit_t * draw_unit, const lv_draw_mask_rect_dsc_t * dsc, const lv_area_t * coords)
@@ -0,0 +1,271 @@
+/**
+ * @file lv_draw_sw_utils.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_utils.h"
+#if LV_USE_DRAW_SW
+
+#include "../../misc/lv_assert.h"
+#include "../../misc/lv_log.h"
+#include "../../stdlib/lv_string.h"
+
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_HELIUM
+    #include "arm2d/lv_draw_sw_helium.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
+    #include LV_DRAW_SW_ASM_CUSTOM_INCLUDE
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void rotate90(const uint8_t * src, uint8_t * dst, int32_t src_width, int32_t src_height,
+                     int32_t src_stride, int32_t dst_stride, uint32_t px_size);
+static void rotate180(const uint8_t * src, uint8_t * dst, int32_t src_width, int32_t src_height,
+                      int32_t src_stride, int32_t dst_stride, uint32_t px_size);
+static void rotate270(const uint8_t * src, uint8_t * dst, int32_t src_width, int32_t src_height,
+                      int32_t src_stride, int32_t dst_stride, uint32_t px_size);
+static inline void copy_px(uint8_t * dst, const uint8_t * src, uint32_t px_size);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_sw_rgb565_swap(void * buf, uint32_t buf_size_px)
+{
+#ifdef LV_DRAW_SW_RGB565_SWAP
+    if(LV_RESULT_OK == LV_DRAW_SW_RGB565_SWAP(buf, buf_size_px)) return;
+#endif
+
+    uint32_t u32_cnt = buf_size_px / 2;
+    uint16_t * buf16 = buf;
+    uint32_t * buf32 = buf;
+
+    while(u32_cnt >= 8) {
+        buf32[0] = ((buf32[0] & 0xff00ff00) >> 8) | ((buf32[0] & 0x00ff00ff) << 8);
+        buf32[1] = ((buf32[1] & 0xff00ff00) >> 8) | ((buf32[1] & 0x00ff00ff) << 8);
+        buf32[2] = ((buf32[2] & 0xff00ff00) >> 8) | ((buf32[2] & 0x00ff00ff) << 8);
+        buf32[3] = ((buf32[3] & 0xff00ff00) >> 8) | ((buf32[3] & 0x00ff00ff) << 8);
+        buf32[4] = ((buf32[4] & 0xff00ff00) >> 8) | ((buf32[4] & 0x00ff00ff) << 8);
+        buf32[5] = ((buf32[5] & 0xff00ff00) >> 8) | ((buf32[5] & 0x00ff00ff) << 8);
+        buf32[6] = ((buf32[6] & 0xff00ff00) >> 8) | ((buf32[6] & 0x00ff00ff) << 8);
+        buf32[7] = ((buf32[7] & 0xff00ff00) >> 8) | ((buf32[7] & 0x00ff00ff) << 8);
+        buf32 += 8;
+        u32_cnt -= 8;
+    }
+
+    while(u32_cnt) {
+        *buf32 = ((*buf32 & 0xff00ff00) >> 8) | ((*buf32 & 0x00ff00ff) << 8);
+        buf32++;
+        u32_cnt--;
+    }
+
+    if(buf_size_px & 0x1) {
+        uint32_t e = buf_size_px - 1;
+        buf16[e] = ((buf16[e] & 0xff00) >> 8) | ((buf16[e] & 0x00ff) << 8);
+    }
+}
+
+void lv_draw_sw_i1_invert(void * buf, uint32_t buf_size)
+{
+    if(buf == NULL) return;
+
+    uint8_t * byte_buf = (uint8_t *)buf;
+    uint32_t i;
+
+    /*Make the buffer aligned*/
+    while(((lv_uintptr_t)(byte_buf) & (sizeof(int) - 1)) && buf_size > 0) {
+        *byte_buf = ~(*byte_buf);
+        byte_buf++;
+        buf_size--;
+    }
+
+    if(buf_size >= sizeof(uint32_t)) {
+        uint32_t * aligned_addr = (uint32_t *)byte_buf;
+        uint32_t word_count = buf_size / 4;
+
+        for(i = 0; i < word_count; i++) {
+            aligned_addr[i] = ~aligned_addr[i];
+        }
+
+        byte_buf = (uint8_t *)(aligned_addr + word_count);
+        buf_size = buf_size % sizeof(uint32_t);
+    }
+
+    for(i = 0; i < buf_size; i++) {
+        byte_buf[i] = ~byte_buf[i];
+    }
+}
+
+void lv_draw_sw_i1_convert_to_vtiled(const void * buf, uint32_t buf_size, uint32_t width, uint32_t height,
+                                     void * out_buf, uint32_t out_buf_size, bool bit_order_lsb)
+{
+    LV_ASSERT(buf && out_buf);
+    LV_ASSERT(width % 8 == 0 && height % 8 == 0);
+    LV_ASSERT(buf_size >= (width / 8) * height);
+    LV_ASSERT(out_buf_size >= buf_size);
+    LV_UNUSED(buf_size);
+
+    lv_memset(out_buf, 0, out_buf_size);
+
+    const uint8_t * src_buf = (const uint8_t *)buf;
+    uint8_t * dst_buf = (uint8_t *)out_buf;
+
+    for(uint32_t y = 0; y < height; y++) {
+        for(uint32_t x = 0; x < width; x++) {
+            uint32_t src_index = y * width + x;
+            uint32_t dst_index = x * height + y;
+            uint8_t bit = (src_buf[src_index / 8] >> (7 - (src_index % 8))) & 0x01;
+            if(bit_order_lsb) dst_buf[dst_index / 8] |= (uint8_t)(bit << (dst_index % 8));
+            else dst_buf[dst_index / 8] |= (uint8_t)(bit << (7 - (dst_index % 8)));
+        }
+    }
+}
+
+void lv_draw_sw_i1_to_argb8888(const void * buf_i1, void * buf_argb8888, uint32_t width, uint32_t height,
+                               uint32_t buf_i1_stride, uint32_t buf_argb8888_stride, uint32_t index0_color,
+                               uint32_t index1_color)
+{
+    LV_ASSERT(buf_i1 && buf_argb8888);
+
+    const uint8_t * src_row = (const uint8_t *)buf_i1;
+    uint8_t * dst_row = (uint8_t *)buf_argb8888;
+
+    for(uint32_t y = 0; y < height; y++) {
+        uint32_t * dst = (uint32_t *)dst_row;
+        for(uint32_t x = 0; x < width; x++) {
+            uint8_t bit = (src_row[x / 8] >> (7 - (x % 8))) & 0x01;
+            dst[x] = bit ? index1_color : index0_color;
+        }
+        src_row += buf_i1_stride;
+        dst_row += buf_argb8888_stride;
+    }
+}
+
+void lv_draw_sw_rotate(const void * src, void * dest, int32_t src_width, int32_t src_height, int32_t src_stride,
+                       int32_t dest_stride, lv_display_rotation_t rotation, lv_color_format_t color_format)
+{
+    uint32_t px_size = lv_color_format_get_size(color_format);
+    if(px_size == 0 || px_size > 4) {
+        LV_LOG_WARN("unsupported color format: %d", color_format);
+        return;
+    }
+
+    const uint8_t * src8 = src;
+    uint8_t * dst8 = dest;
+
+    switch(rotation) {
+        case LV_DISPLAY_ROTATION_0: {
+                int32_t row_size = src_width * (int32_t)px_size;
+                for(int32_t y = 0; y < src_height; y++) {
+                    lv_memcpy(dst8 + y * dest_stride, src8 + y * src_stride, row_size);
+                }
+            }
+            break;
+        case LV_DISPLAY_ROTATION_90:
+            rotate90(src8, dst8, src_width, src_height, src_stride, dest_stride, px_size);
+            break;
+        case LV_DISPLAY_ROTATION_180:
+            rotate180(src8, dst8, src_width, src_height, src_stride, dest_stride, px_size);
+            break;
+        case LV_DISPLAY_ROTATION_270:
+            rotate270(src8, dst8, src_width, src_height, src_stride, dest_stride, px_size);
+            break;
+        default:
+            break;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static inline void copy_px(uint8_t * dst, const uint8_t * src, uint32_t px_size)
+{
+    switch(px_size) {
+        case 1:
+            dst[0] = src[0];
+            break;
+        case 2:
+            *(uint16_t *)dst = *(const uint16_t *)src;
+            break;
+        case 3:
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+            break;
+        default:
+            *(uint32_t *)dst = *(const uint32_t *)src;
+            break;
+    }
+}
+
+/**
+ * The source column `x` becomes the destination row `x`, read bottom to top
+ */
+static void rotate90(const uint8_t * src, uint8_t * dst, int32_t src_width, int32_t src_height,
+                     int32_t src_stride, int32_t dst_stride, uint32_t px_size)
+{
+    for(int32_t x = 0; x < src_width; x++) {
+        const uint8_t * s = src + x * px_size;
+        uint8_t * d = dst + x * dst_stride + (src_height - 1) * px_size;
+        for(int32_t y = 0; y < src_height; y++) {
+            copy_px(d, s, px_size);
+            s += src_stride;
+            d -= px_size;
+        }
+    }
+}
+
+static void rotate180(const uint8_t * src, uint8_t * dst, int32_t src_width, int32_t src_height,
+                      int32_t src_stride, int32_t dst_stride, uint32_t px_size)
+{
+    for(int32_t y = 0; y < src_height; y++) {
+        const uint8_t * s = src + y * src_stride;
+        uint8_t * d = dst + (src_height - y - 1) * dst_stride + (src_width - 1) * px_size;
+        for(int32_t x = 0; x < src_width; x++) {
+            copy_px(d, s, px_size);
+            s += px_size;
+            d -= px_size;
+        }
+    }
+}
+
+/**
+ * The source column `x` becomes the destination row `src_width - 1 - x`, read top to bottom
+ */
+static void rotate270(const uint8_t * src, uint8_t * dst, int32_t src_width, int32_t src_height,
+                      int32_t src_stride, int32_t dst_stride, uint32_t px_size)
+{
+    for(int32_t x = 0; x < src_width; x++) {
+        const uint8_t * s = src + x * px_size;
+        uint8_t * d = dst + (src_width - x - 1) * dst_stride;
+        for(int32_t y = 0; y < src_height; y++) {
+            copy_px(d, s, px_size);
+            s += src_stride;
+            d += px_size;
+        }
+    }
+}
+
+#endif /*LV_USE_DRAW_SW*/
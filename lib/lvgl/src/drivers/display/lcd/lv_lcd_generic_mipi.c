@@ -293,9 +293,11 @@ static void set_rotation(lv_lcd_generic_mipi_driver_t * drv, lv_display_rotation
             set_swap_xy(drv, drv->swap_xy);
             set_mirror(drv, drv->mirror_x, drv->mirror_y);
             break;
+        /* When the native orientation has swapped axes already, the other address order
+         * has to be reversed to turn the image by 90 degrees in the same direction */
         case LV_DISPLAY_ROTATION_90:
             set_swap_xy(drv, !drv->swap_xy);
-            set_mirror(drv, drv->mirror_x, !drv->mirror_y);
+            set_mirror(drv, drv->mirror_x != drv->swap_xy, drv->mirror_y == drv->swap_xy);
             break;
         case LV_DISPLAY_ROTATION_180:
             set_swap_xy(drv, drv->swap_xy);
@@ -303,7 +305,7 @@ static void set_rotation(lv_lcd_generic_mipi_driver_t * drv, lv_display_rotation
             break;
         case LV_DISPLAY_ROTATION_270:
             set_swap_xy(drv, !drv->swap_xy);
-            set_mirror(drv, !drv->mirror_x, drv->mirror_y);
+            set_mirror(drv, drv->mirror_x == drv->swap_xy, drv->mirror_y != drv->swap_xy);
             break;
     }
     send_cmd(drv, LV_LCD_CMD_SET_ADDRESS_MODE, (uint8_t[]) {
@@ -14,6 +14,7 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
 #include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
 
 /*********************
  *      DEFINES
@@ -22,6 +23,13 @@
     #define font_rle LV_GLOBAL_DEFAULT()->font_fmt_rle
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_USE_FONT_FMT_TXT_GID_TABLE
+    #define gid_ll_p &(LV_GLOBAL_DEFAULT()->font_fmt_txt_gid_ll)
+    #define gid_last LV_GLOBAL_DEFAULT()->font_fmt_txt_gid_last
+    #define gid_lock_p &(LV_GLOBAL_DEFAULT()->font_fmt_txt_gid_lock)
+    #define GID_UNKNOWN 0xFFFF
+#endif /*LV_USE_FONT_FMT_TXT_GID_TABLE*/
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -33,7 +41,10 @@ typedef struct {
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static const void * render_bitmap(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_glyph_dsc_t * gdsc,
+                                  lv_draw_buf_t * draw_buf);
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static uint32_t lookup_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
 static int unicode_list_compare(const void * ref, const void * element);
 static int kern_pair_8_compare(const void * ref, const void * element);
@@ -47,6 +58,10 @@ static int kern_pair_16_compare(const void * ref, const void * element);
     static inline uint8_t rle_next(void);
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_USE_FONT_FMT_TXT_GID_TABLE
+    static lv_font_fmt_txt_gid_table_t * get_gid_table(const lv_font_fmt_txt_dsc_t * fdsc);
+#endif /*LV_USE_FONT_FMT_TXT_GID_TABLE*/
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -75,10 +90,50 @@ static const uint8_t opa2_table[4] = {0, 85, 170, 255};
  *   GLOBAL FUNCTIONS
  **********************/
 
+void lv_font_fmt_txt_cache_init(void)
+{
+#if LV_USE_FONT_FMT_TXT_GID_TABLE
+    if((gid_ll_p)->n_size == 0) {
+        lv_ll_init(gid_ll_p, sizeof(lv_font_fmt_txt_gid_table_t));
+        lv_mutex_init(gid_lock_p);
+        gid_last = NULL;
+    }
+#endif
+}
+
+void lv_font_fmt_txt_cache_deinit(void)
+{
+#if LV_USE_FONT_FMT_TXT_GID_TABLE
+    lv_ll_clear(gid_ll_p);
+    lv_mutex_delete(gid_lock_p);
+    gid_last = NULL;
+#endif
+}
+
+void lv_font_fmt_txt_cache_drop(const lv_font_t * font)
+{
+#if LV_USE_FONT_FMT_TXT_GID_TABLE
+    if((gid_ll_p)->n_size == 0) return;    /*lv_font_fmt_txt_cache_init wasn't called*/
+    lv_mutex_lock(gid_lock_p);
+    gid_last = NULL;
+    lv_font_fmt_txt_gid_table_t * table = lv_ll_get_head(gid_ll_p);
+    while(table) {
+        lv_font_fmt_txt_gid_table_t * next = lv_ll_get_next(gid_ll_p, table);
+        if(font == NULL || table->fdsc == font->dsc) {
+            lv_ll_remove(gid_ll_p, table);
+            lv_free(table);
+        }
+        table = next;
+    }
+    lv_mutex_unlock(gid_lock_p);
+#else
+    LV_UNUSED(font);
+#endif
+}
+
 const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf)
 {
     const lv_font_t * font = g_dsc->resolved_font;
-    uint8_t * bitmap_out = draw_buf->data;
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
     uint32_t gid = g_dsc->gid.index;
@@ -91,6 +146,93 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
     int32_t gsize = (int32_t) gdsc->box_w * gdsc->box_h;
     if(gsize == 0) return NULL;
 
+    return render_bitmap(fdsc, gdsc, draw_buf);
+}
+
+const uint8_t * lv_font_fmt_txt_get_packed_bitmap(const lv_font_glyph_dsc_t * g_dsc)
+{
+    const lv_font_t * font = g_dsc->resolved_font;
+    if(font == NULL || font->get_glyph_bitmap != lv_font_get_bitmap_fmt_txt) return NULL;
+
+    const lv_font_fmt_txt_dsc_t * fdsc = (const lv_font_fmt_txt_dsc_t *)font->dsc;
+    if(fdsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN && fdsc->bitmap_format != LV_FONT_FMT_PLAIN_ALIGNED) return NULL;
+
+    uint32_t gid = g_dsc->gid.index;
+    if(!gid) return NULL;
+
+    /*The box of tabs is wider than their bitmap*/
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+    if(gdsc->box_w != g_dsc->box_w || gdsc->box_h != g_dsc->box_h) return NULL;
+
+    return &fdsc->glyph_bitmap[gdsc->bitmap_index];
+}
+
+bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
+                                   uint32_t unicode_letter_next)
+{
+    /*It fixes a strange compiler optimization issue: https://github.com/lvgl/lvgl/issues/4370*/
+    bool is_tab = unicode_letter == '\t';
+    if(is_tab) {
+        unicode_letter = ' ';
+    }
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
+    if(!gid) return false;
+
+    int8_t kvalue = 0;
+    if(fdsc->kern_dsc) {
+        uint32_t gid_next = get_glyph_dsc_id(font, unicode_letter_next);
+        if(gid_next) {
+            kvalue = get_kern_value(font, gid, gid_next);
+        }
+    }
+
+    /*Put together a glyph dsc*/
+    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
+
+    int32_t kv = ((int32_t)((int32_t)kvalue * fdsc->kern_scale) >> 4);
+
+    uint32_t adv_w = gdsc->adv_w;
+    if(is_tab) adv_w *= 2;
+
+    adv_w += kv;
+    adv_w  = (adv_w + (1 << 3)) >> 4;
+
+    dsc_out->adv_w = adv_w;
+    dsc_out->box_h = gdsc->box_h;
+    dsc_out->box_w = gdsc->box_w;
+    dsc_out->ofs_x = gdsc->ofs_x;
+    dsc_out->ofs_y = gdsc->ofs_y;
+    dsc_out->format = (uint8_t)fdsc->bpp;
+    if(fdsc->bitmap_format == LV_FONT_FMT_PLAIN_ALIGNED) {
+        /*Offset in the enum to the ALIGNED values */
+        dsc_out->format += LV_FONT_GLYPH_FORMAT_A1_ALIGNED - LV_FONT_GLYPH_FORMAT_A1;
+    }
+    dsc_out->is_placeholder = false;
+    dsc_out->gid.index = gid;
+    dsc_out->entry = NULL;
+
+    if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
+
+    return true;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Render the bitmap of a glyph as A8
+ * @param fdsc      the font's descriptor
+ * @param gdsc      the glyph to render
+ * @param draw_buf  render here, its stride must be `lv_draw_buf_width_to_stride(box_w, LV_COLOR_FORMAT_A8)`
+ * @return          `draw_buf`, or NULL if the glyph can't be rendered
+ */
+static const void * render_bitmap(const lv_font_fmt_txt_dsc_t * fdsc, const lv_font_fmt_txt_glyph_dsc_t * gdsc,
+                                  lv_draw_buf_t * draw_buf)
+{
+    uint8_t * bitmap_out = draw_buf->data;
+
     bool byte_aligned = fdsc->bitmap_format == LV_FONT_FMT_PLAIN_ALIGNED;
 
     if(fdsc->bitmap_format == LV_FONT_FMT_TXT_PLAIN || fdsc->bitmap_format == LV_FONT_FMT_PLAIN_ALIGNED) {
@@ -117,7 +259,7 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
                 }
                 /*Go to the next byte if stopped in the middle of a byte and
                  *the next line is byte aligned*/
-                if(byte_aligned && i != 0) {
+                if(byte_aligned && (i & 0x7) != 0) {
                     i = 0;
                     bitmap_in++;
                 }
@@ -139,7 +281,7 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
 
                 /*Go to the next byte if stopped in the middle of a byte and
                  *the next line is byte aligned*/
-                if(byte_aligned && i != 0) {
+                if(byte_aligned && (i & 0x3) != 0) {
                     i = 0;
                     bitmap_in++;
                 }
@@ -163,7 +305,7 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
 
                 /*Go to the next byte if stopped in the middle of a byte and
                  *the next line is byte aligned*/
-                if(byte_aligned && i != 0) {
+                if(byte_aligned && (i & 0x1) != 0) {
                     i = 0;
                     bitmap_in++;
                 }
@@ -199,65 +341,32 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
     return NULL;
 }
 
-bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
-                                   uint32_t unicode_letter_next)
+static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 {
-    /*It fixes a strange compiler optimization issue: https://github.com/lvgl/lvgl/issues/4370*/
-    bool is_tab = unicode_letter == '\t';
-    if(is_tab) {
-        unicode_letter = ' ';
-    }
+    if(letter == '\0') return 0;
+
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
-    uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
-    if(!gid) return false;
 
-    int8_t kvalue = 0;
-    if(fdsc->kern_dsc) {
-        uint32_t gid_next = get_glyph_dsc_id(font, unicode_letter_next);
-        if(gid_next) {
-            kvalue = get_kern_value(font, gid, gid_next);
+#if LV_USE_FONT_FMT_TXT_GID_TABLE
+    if(letter >= LV_FONT_FMT_TXT_GID_TABLE_FIRST && letter <= LV_FONT_FMT_TXT_GID_TABLE_LAST) {
+        lv_font_fmt_txt_gid_table_t * table = get_gid_table(fdsc);
+        if(table) {
+            uint16_t * gid_p = &table->gid[letter - LV_FONT_FMT_TXT_GID_TABLE_FIRST];
+            if(*gid_p == GID_UNKNOWN) {
+                uint32_t glyph_id = lookup_glyph_dsc_id(fdsc, letter);
+                if(glyph_id >= GID_UNKNOWN) return glyph_id;
+                *gid_p = (uint16_t)glyph_id;
+            }
+            return *gid_p;
         }
     }
+#endif /*LV_USE_FONT_FMT_TXT_GID_TABLE*/
 
-    /*Put together a glyph dsc*/
-    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
-
-    int32_t kv = ((int32_t)((int32_t)kvalue * fdsc->kern_scale) >> 4);
-
-    uint32_t adv_w = gdsc->adv_w;
-    if(is_tab) adv_w *= 2;
-
-    adv_w += kv;
-    adv_w  = (adv_w + (1 << 3)) >> 4;
-
-    dsc_out->adv_w = adv_w;
-    dsc_out->box_h = gdsc->box_h;
-    dsc_out->box_w = gdsc->box_w;
-    dsc_out->ofs_x = gdsc->ofs_x;
-    dsc_out->ofs_y = gdsc->ofs_y;
-    dsc_out->format = (uint8_t)fdsc->bpp;
-    if(fdsc->bitmap_format == LV_FONT_FMT_PLAIN_ALIGNED) {
-        /*Offset in the enum to the ALIGNED values */
-        dsc_out->format += LV_FONT_GLYPH_FORMAT_A1_ALIGNED - LV_FONT_GLYPH_FORMAT_A1;
-    }
-    dsc_out->is_placeholder = false;
-    dsc_out->gid.index = gid;
-
-    if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
-
-    return true;
+    return lookup_glyph_dsc_id(fdsc, letter);
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
-
-static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
+static uint32_t lookup_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
 {
-    if(letter == '\0') return 0;
-
-    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
-
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
@@ -595,3 +704,40 @@ static int unicode_list_compare(const void * ref, const void * element)
 {
     return (*(uint16_t *)ref) - (*(uint16_t *)element);
 }
+
+#if LV_USE_FONT_FMT_TXT_GID_TABLE
+
+/**
+ * Get the glyph ID table of a font, creating it on first use
+ * @param fdsc      the font's descriptor
+ * @return          the table or NULL if the cache isn't initialized or out of memory
+ */
+static lv_font_fmt_txt_gid_table_t * get_gid_table(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    /*A text is measured and drawn with one font for many glyphs in a row*/
+    lv_font_fmt_txt_gid_table_t * table = gid_last;
+    if(table && table->fdsc == fdsc) return table;
+
+    lv_ll_t * ll = gid_ll_p;
+    if(ll->n_size == 0) return NULL;    /*lv_font_fmt_txt_cache_init wasn't called*/
+
+    /*Draw units may look up glyphs in parallel with the main thread*/
+    lv_mutex_lock(gid_lock_p);
+    LV_LL_READ(ll, table) {
+        if(table->fdsc == fdsc) break;
+    }
+
+    if(table == NULL) {
+        table = lv_ll_ins_head(ll);
+        if(table) {
+            table->fdsc = fdsc;
+            lv_memset(table->gid, 0xFF, sizeof(table->gid));
+        }
+    }
+
+    if(table) gid_last = table;
+    lv_mutex_unlock(gid_lock_p);
+    return table;
+}
+
+#endif /*LV_USE_FONT_FMT_TXT_GID_TABLE*/
@@ -198,6 +198,15 @@ typedef struct {
  */
 const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf);
 
+/**
+ * Get the bitmap of a glyph as it's stored in an uncompressed font of lvgl's native format.
+ * The pixels follow each other MSB first on `bpp` bits, a row starts on a new byte only if the
+ * font is `LV_FONT_FMT_PLAIN_ALIGNED`. Renderers can blend it directly instead of an A8 bitmap.
+ * @param g_dsc         a glyph descriptor from `lv_font_get_glyph_dsc`
+ * @return              pointer to the packed bitmap, or NULL if the glyph is not from such a font
+ */
+const uint8_t * lv_font_fmt_txt_get_packed_bitmap(const lv_font_glyph_dsc_t * g_dsc);
+
 /**
  * Used as `get_glyph_dsc` callback in lvgl's native font format if the font is uncompressed.
  * @param font pointer to font
@@ -210,6 +219,13 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+/**
+ * Forget the cached glyph IDs of a font (see `LV_USE_FONT_FMT_TXT_GID_TABLE`).
+ * Must be called before a font of this format is freed.
+ * @param font      pointer to a font, or NULL to drop the glyphs of every font
+ */
+void lv_font_fmt_txt_cache_drop(const lv_font_t * font);
+
 /**********************
  *      MACROS
  **********************/
@@ -20,6 +20,10 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/** First and last code point served by the direct-mapped glyph ID table*/
+#define LV_FONT_FMT_TXT_GID_TABLE_FIRST 0x20
+#define LV_FONT_FMT_TXT_GID_TABLE_LAST  0x7E
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -41,10 +45,28 @@ typedef struct {
 } lv_font_fmt_rle_t;
 #endif
 
+#if LV_USE_FONT_FMT_TXT_GID_TABLE
+/** Glyph IDs of the printable ASCII letters of one font, so they are not searched in the cmaps again*/
+typedef struct {
+    const lv_font_fmt_txt_dsc_t * fdsc;
+    uint16_t gid[LV_FONT_FMT_TXT_GID_TABLE_LAST - LV_FONT_FMT_TXT_GID_TABLE_FIRST + 1];   /**< 0xFFFF: not looked up yet*/
+} lv_font_fmt_txt_gid_table_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Prepare the glyph ID tables of the built-in font format. Called by `lv_init`
+ */
+void lv_font_fmt_txt_cache_init(void);
+
+/**
+ * Free the glyph ID tables. Called by `lv_deinit`
+ */
+void lv_font_fmt_txt_cache_deinit(void);
+
 /**********************
  *      MACROS
  **********************/
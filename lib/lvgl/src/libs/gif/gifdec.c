@@ -29,7 +29,7 @@ typedef struct Table {
 #define LZW_CACHE_SIZE              (LZW_TABLE_SIZE * 4)
 #endif
 
-static gd_GIF  * gif_open(gd_GIF * gif);
+static gd_GIF  * gif_open(gd_GIF * gif, lv_color_format_t cf);
 static bool f_gif_open(gd_GIF * gif, const void * path, bool is_file);
 static void f_gif_read(gd_GIF * gif, void * buf, size_t len);
 static int f_gif_seek(gd_GIF * gif, size_t pos, int k);
@@ -39,6 +39,9 @@ static void f_gif_close(gd_GIF * gif);
     #include "gifdec_mve.h"
 #endif
 
+static void fill_canvas_rect(gd_GIF * gif, int i, int w, int h, const uint8_t * color, uint8_t opa);
+static void update_palette565(gd_GIF * gif);
+
 static uint16_t
 read_num(gd_GIF * gif)
 {
@@ -49,7 +52,7 @@ read_num(gd_GIF * gif)
 }
 
 gd_GIF *
-gd_open_gif_file(const char * fname)
+gd_open_gif_file(const char * fname, lv_color_format_t cf)
 {
     gd_GIF gif_base;
     memset(&gif_base, 0, sizeof(gif_base));
@@ -57,11 +60,11 @@ gd_open_gif_file(const char * fname)
     bool res = f_gif_open(&gif_base, fname, true);
     if(!res) return NULL;
 
-    return gif_open(&gif_base);
+    return gif_open(&gif_base, cf);
 }
 
 gd_GIF *
-gd_open_gif_data(const void * data)
+gd_open_gif_data(const void * data, lv_color_format_t cf)
 {
     gd_GIF gif_base;
     memset(&gif_base, 0, sizeof(gif_base));
@@ -69,18 +72,35 @@ gd_open_gif_data(const void * data)
     bool res = f_gif_open(&gif_base, data, false);
     if(!res) return NULL;
 
-    return gif_open(&gif_base);
+    return gif_open(&gif_base, cf);
 }
 
-static gd_GIF * gif_open(gd_GIF * gif_base)
+static gd_GIF * gif_open(gd_GIF * gif_base, lv_color_format_t cf)
 {
     uint8_t sigver[3];
     uint16_t width, height, depth;
     uint8_t fdsz, bgidx, aspect;
     uint8_t * bgcolor;
     int gct_sz;
+    int canvas_px;
     gd_GIF * gif = NULL;
 
+    /* Bytes per canvas pixel */
+    switch(cf) {
+        case LV_COLOR_FORMAT_ARGB8888:
+            canvas_px = 4;
+            break;
+        case LV_COLOR_FORMAT_RGB565:
+            canvas_px = 2;
+            break;
+        case LV_COLOR_FORMAT_RGB565A8:
+            canvas_px = 3;
+            break;
+        default:
+            LV_LOG_WARN("unsupported canvas color format %d", cf);
+            goto fail;
+    }
+
     /* Header */
     f_gif_read(gif_base, sigver, 3);
     if(memcmp(sigver, "GIF", 3) != 0) {
@@ -117,18 +137,19 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
         LV_LOG_WARN("Zero size image");
         goto fail;
     }
+    /* Canvas plus one index byte per pixel for the frame */
 #if LV_GIF_CACHE_DECODE_DATA
-    if(0 == (INT_MAX - sizeof(gd_GIF) - LZW_CACHE_SIZE) / width / height / 5){
+    if(0 == (INT_MAX - sizeof(gd_GIF) - LZW_CACHE_SIZE) / width / height / (canvas_px + 1)){
         LV_LOG_WARN("Image dimensions are too large");
         goto fail;
     } 
-    gif = lv_malloc(sizeof(gd_GIF) + 5 * width * height + LZW_CACHE_SIZE);
+    gif = lv_malloc(sizeof(gd_GIF) + (canvas_px + 1) * width * height + LZW_CACHE_SIZE);
     #else
-    if(0 == (INT_MAX - sizeof(gd_GIF)) / width / height / 5){
+    if(0 == (INT_MAX - sizeof(gd_GIF)) / width / height / (canvas_px + 1)){
         LV_LOG_WARN("Image dimensions are too large");
         goto fail;
     } 
-    gif = lv_malloc(sizeof(gd_GIF) + 5 * width * height);
+    gif = lv_malloc(sizeof(gd_GIF) + (canvas_px + 1) * width * height);
     #endif
     if(!gif) goto fail;
     memcpy(gif, gif_base, sizeof(gd_GIF));
@@ -141,7 +162,9 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     gif->palette = &gif->gct;
     gif->bgindex = bgidx;
     gif->canvas = (uint8_t *) &gif[1];
-    gif->frame = &gif->canvas[4 * width * height];
+    gif->canvas_cf = cf;
+    gif->palette565_src = NULL;
+    gif->frame = &gif->canvas[canvas_px * width * height];
     if(gif->bgindex) {
         memset(gif->frame, gif->bgindex, gif->width * gif->height);
     }
@@ -150,16 +173,8 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     gif->lzw_cache = gif->frame + width * height;
     #endif
 
-#ifdef GIFDEC_FILL_BG
-    GIFDEC_FILL_BG(gif->canvas, gif->width * gif->height, 1, gif->width * gif->height, bgcolor, 0xff);
-#else
-    for(int i = 0; i < gif->width * gif->height; i++) {
-        gif->canvas[i * 4 + 0] = *(bgcolor + 2);
-        gif->canvas[i * 4 + 1] = *(bgcolor + 1);
-        gif->canvas[i * 4 + 2] = *(bgcolor + 0);
-        gif->canvas[i * 4 + 3] = 0xff;
-    }
-#endif
+    update_palette565(gif);
+    fill_canvas_rect(gif, 0, gif->width * gif->height, 1, bgcolor, 0xff);
     gif->anim_start = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
     gif->loop_count = -1;
     goto ok;
@@ -596,7 +611,7 @@ read_image_data(gd_GIF * gif, int interlace)
         if(ret == 1) key_size++;
         entry = table->entries[key];
         str_len = entry.length;
-	if(frm_off + str_len >= frm_size){
+	if(frm_off + str_len > frm_size){
 		LV_LOG_WARN("LZW table token overflows the frame buffer");
 		return -1;
 	}
@@ -653,27 +668,101 @@ read_image(gd_GIF * gif)
     }
     else
         gif->palette = &gif->gct;
+    update_palette565(gif);
     /* Image Data. */
     return read_image_data(gif, interlace);
 }
 
+/* Convert the current palette once so RGB565 canvases are filled with a table lookup per pixel. */
+static void
+update_palette565(gd_GIF * gif)
+{
+    int i;
+    const uint8_t * color;
+
+    if(gif->canvas_cf == LV_COLOR_FORMAT_ARGB8888) return;
+    /* The LCT is re-read for every frame that has one, so only the GCT can be reused as is */
+    if(gif->palette565_src == gif->palette && gif->palette == &gif->gct) return;
+
+    for(i = 0; i < gif->palette->size; i++) {
+        color = &gif->palette->colors[i * 3];
+        gif->palette565[i] = lv_color_to_u16(lv_color_make(color[0], color[1], color[2]));
+    }
+    gif->palette565_src = gif->palette;
+}
+
+/* Fill `w` x `h` canvas pixels starting at pixel index `i` with one color. */
+static void
+fill_canvas_rect(gd_GIF * gif, int i, int w, int h, const uint8_t * color, uint8_t opa)
+{
+    int j, k;
+
+    if(gif->canvas_cf == LV_COLOR_FORMAT_ARGB8888) {
+#ifdef GIFDEC_FILL_BG
+        GIFDEC_FILL_BG(&(gif->canvas[i * 4]), w, h, gif->width, color, opa);
+#else
+        for(j = 0; j < h; j++) {
+            for(k = 0; k < w; k++) {
+                gif->canvas[(i + k) * 4 + 0] = *(color + 2);
+                gif->canvas[(i + k) * 4 + 1] = *(color + 1);
+                gif->canvas[(i + k) * 4 + 2] = *(color + 0);
+                gif->canvas[(i + k) * 4 + 3] = opa;
+            }
+            i += gif->width;
+        }
+#endif
+        return;
+    }
+
+    uint16_t c16 = lv_color_to_u16(lv_color_make(color[0], color[1], color[2]));
+    uint16_t * dst = (uint16_t *)gif->canvas;
+    uint8_t * alpha = gif->canvas_cf == LV_COLOR_FORMAT_RGB565A8 ?
+                      &gif->canvas[gif->width * gif->height * 2] : NULL;
+    for(j = 0; j < h; j++) {
+        for(k = 0; k < w; k++) dst[i + k] = c16;
+        if(alpha) memset(&alpha[i], opa, w);
+        i += gif->width;
+    }
+}
+
 static void
 render_frame_rect(gd_GIF * gif, uint8_t * buffer)
 {
     int i = gif->fy * gif->width + gif->fx;
+    int j, k;
+    uint8_t index;
+    int tindex = gif->gce.transparency ? gif->gce.tindex : 0x100;
+
+    if(gif->canvas_cf != LV_COLOR_FORMAT_ARGB8888) {
+        const uint16_t * palette = gif->palette565;
+        uint16_t * dst = (uint16_t *)buffer;
+        uint8_t * alpha = gif->canvas_cf == LV_COLOR_FORMAT_RGB565A8 ?
+                          &buffer[gif->width * gif->height * 2] : NULL;
+        for(j = 0; j < gif->fh; j++) {
+            const uint8_t * src = &gif->frame[i];
+            for(k = 0; k < gif->fw; k++) {
+                index = src[k];
+                if(index != tindex) {
+                    dst[i + k] = palette[index];
+                    if(alpha) alpha[i + k] = 0xFF;
+                }
+            }
+            i += gif->width;
+        }
+        return;
+    }
+
 #ifdef GIFDEC_RENDER_FRAME
     GIFDEC_RENDER_FRAME(&buffer[i * 4], gif->fw, gif->fh, gif->width,
-                        &gif->frame[i], gif->palette->colors,
-                        gif->gce.transparency ? gif->gce.tindex : 0x100);
+                        &gif->frame[i], gif->palette->colors, tindex);
 #else
-    int j, k;
-    uint8_t index, * color;
+    uint8_t * color;
 
     for(j = 0; j < gif->fh; j++) {
         for(k = 0; k < gif->fw; k++) {
             index = gif->frame[(gif->fy + j) * gif->width + gif->fx + k];
             color = &gif->palette->colors[index * 3];
-            if(!gif->gce.transparency || index != gif->gce.tindex) {
+            if(index != tindex) {
                 buffer[(i + k) * 4 + 0] = *(color + 2);
                 buffer[(i + k) * 4 + 1] = *(color + 1);
                 buffer[(i + k) * 4 + 2] = *(color + 0);
@@ -698,20 +787,7 @@ dispose(gd_GIF * gif)
             if(gif->gce.transparency) opa = 0x00;
 
             i = gif->fy * gif->width + gif->fx;
-#ifdef GIFDEC_FILL_BG
-            GIFDEC_FILL_BG(&(gif->canvas[i * 4]), gif->fw, gif->fh, gif->width, bgcolor, opa);
-#else
-            int j, k;
-            for(j = 0; j < gif->fh; j++) {
-                for(k = 0; k < gif->fw; k++) {
-                    gif->canvas[(i + k) * 4 + 0] = *(bgcolor + 2);
-                    gif->canvas[(i + k) * 4 + 1] = *(bgcolor + 1);
-                    gif->canvas[(i + k) * 4 + 2] = *(bgcolor + 0);
-                    gif->canvas[(i + k) * 4 + 3] = opa;
-                }
-                i += gif->width;
-            }
-#endif
+            fill_canvas_rect(gif, i, gif->fw, gif->fh, bgcolor, opa);
             break;
         case 3: /* Restore to previous, i.e., don't update canvas.*/
             break;
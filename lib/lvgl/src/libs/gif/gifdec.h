@@ -6,6 +6,7 @@ extern "C" {
 #endif
 
 #include "../../misc/lv_fs.h"
+#include "../../misc/lv_color.h"
 
 #if LV_USE_GIF
 #include <stdint.h>
@@ -47,14 +48,17 @@ typedef struct _gd_GIF {
     uint16_t fx, fy, fw, fh;
     uint8_t bgindex;
     uint8_t * canvas, * frame;
+    lv_color_format_t canvas_cf;            /*ARGB8888, RGB565 or RGB565A8 (alpha plane after the colors)*/
+    uint16_t palette565[0x100];             /*`palette` pre-converted for RGB565 canvases*/
+    const gd_Palette * palette565_src;      /*Palette `palette565` was converted from*/
     #if LV_GIF_CACHE_DECODE_DATA
     uint8_t *lzw_cache;
     #endif
 } gd_GIF;
 
-gd_GIF * gd_open_gif_file(const char * fname);
+gd_GIF * gd_open_gif_file(const char * fname, lv_color_format_t cf);
 
-gd_GIF * gd_open_gif_data(const void * data);
+gd_GIF * gd_open_gif_data(const void * data, lv_color_format_t cf);
 
 void gd_render_frame(gd_GIF * gif, uint8_t * buffer);
 
@@ -10,6 +10,7 @@
 #if LV_USE_GIF
 #include "../../misc/lv_timer_private.h"
 #include "../../misc/cache/lv_image_cache.h"
+#include "../../misc/lv_area_private.h"
 #include "../../core/lv_obj_class_private.h"
 
 #include "gifdec.h"
@@ -75,10 +76,10 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
 
     if(lv_image_src_get_type(src) == LV_IMAGE_SRC_VARIABLE) {
         const lv_image_dsc_t * img_dsc = src;
-        gif = gd_open_gif_data(img_dsc->data);
+        gif = gd_open_gif_data(img_dsc->data, gifobj->color_format);
     }
     else if(lv_image_src_get_type(src) == LV_IMAGE_SRC_FILE) {
-        gif = gd_open_gif_file(src);
+        gif = gd_open_gif_file(src, gifobj->color_format);
     }
     if(gif == NULL) {
         LV_LOG_WARN("Couldn't load the source");
@@ -89,11 +90,12 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
     gifobj->imgdsc.data = gif->canvas;
     gifobj->imgdsc.header.magic = LV_IMAGE_HEADER_MAGIC;
     gifobj->imgdsc.header.flags = LV_IMAGE_FLAGS_MODIFIABLE;
-    gifobj->imgdsc.header.cf = LV_COLOR_FORMAT_ARGB8888;
+    gifobj->imgdsc.header.cf = gif->canvas_cf;
     gifobj->imgdsc.header.h = gif->height;
     gifobj->imgdsc.header.w = gif->width;
-    gifobj->imgdsc.header.stride = gif->width * 4;
-    gifobj->imgdsc.data_size = gif->width * gif->height * 4;
+    gifobj->imgdsc.header.stride = gif->width * lv_color_format_get_size(gif->canvas_cf);
+    gifobj->imgdsc.data_size = gifobj->imgdsc.header.stride * gif->height;
+    if(gif->canvas_cf == LV_COLOR_FORMAT_RGB565A8) gifobj->imgdsc.data_size += gif->width * gif->height;
 
     gifobj->last_call = lv_tick_get();
 
@@ -106,6 +108,18 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
 
 }
 
+void lv_gif_set_color_format(lv_obj_t * obj, lv_color_format_t cf)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+
+    if(cf != LV_COLOR_FORMAT_ARGB8888 && cf != LV_COLOR_FORMAT_RGB565 && cf != LV_COLOR_FORMAT_RGB565A8) {
+        LV_LOG_WARN("Unsupported color format %d", cf);
+        return;
+    }
+
+    gifobj->color_format = cf;
+}
+
 void lv_gif_restart(lv_obj_t * obj)
 {
     lv_gif_t * gifobj = (lv_gif_t *) obj;
@@ -179,6 +193,7 @@ static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_gif_t * gifobj = (lv_gif_t *) obj;
 
     gifobj->gif = NULL;
+    gifobj->color_format = LV_COLOR_FORMAT_ARGB8888;
     gifobj->timer = lv_timer_create(next_frame_task_cb, 10, obj);
     lv_timer_pause(gifobj->timer);
 }
@@ -204,6 +219,11 @@ static void next_frame_task_cb(lv_timer_t * t)
 
     gifobj->last_call = lv_tick_get();
 
+    /*The previous frame's rectangle may be disposed, the new one is drawn*/
+    gd_GIF * gif = gifobj->gif;
+    lv_area_t changed;
+    lv_area_set(&changed, gif->fx, gif->fy, gif->fx + gif->fw - 1, gif->fy + gif->fh - 1);
+
     int has_next = gd_get_frame(gifobj->gif);
     if(has_next == 0) {
         /*It was the last repeat*/
@@ -214,8 +234,13 @@ static void next_frame_task_cb(lv_timer_t * t)
 
     gd_render_frame(gifobj->gif, (uint8_t *)gifobj->imgdsc.data);
 
+    lv_area_t frame_area;
+    lv_area_set(&frame_area, gif->fx, gif->fy, gif->fx + gif->fw - 1, gif->fy + gif->fh - 1);
+    if(lv_area_get_size(&changed) > 0) lv_area_join(&changed, &changed, &frame_area);
+    else changed = frame_area;
+
     lv_image_cache_drop(lv_image_get_src(obj));
-    lv_obj_invalidate(obj);
+    lv_image_invalidate_src_area(obj, &changed);
 }
 
 #endif /*LV_USE_GIF*/
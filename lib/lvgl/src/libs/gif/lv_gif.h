@@ -54,6 +54,16 @@ lv_obj_t * lv_gif_create(lv_obj_t * parent);
  */
 void lv_gif_set_src(lv_obj_t * obj, const void * src);
 
+/**
+ * Set the color format of the canvas the frames are decoded into.
+ * `LV_COLOR_FORMAT_RGB565` needs 3 bytes per pixel instead of 5 and matches RGB565 displays directly,
+ * `LV_COLOR_FORMAT_RGB565A8` keeps transparency at 4 bytes per pixel.
+ * Takes effect on the next `lv_gif_set_src()`.
+ * @param obj       pointer to a gif object
+ * @param cf        `LV_COLOR_FORMAT_ARGB8888` (default), `LV_COLOR_FORMAT_RGB565` or `LV_COLOR_FORMAT_RGB565A8`
+ */
+void lv_gif_set_color_format(lv_obj_t * obj, lv_color_format_t cf);
+
 /**
  * Restart a gif animation.
  * @param obj pointer to a gif obj
@@ -0,0 +1,409 @@
+/**
+ * @file lv_sprite_anim.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_sprite_anim_private.h"
+#if LV_USE_SPRITE_ANIM
+#include "../../misc/lv_timer_private.h"
+#include "../../misc/cache/lv_image_cache.h"
+#include "../../misc/lv_area_private.h"
+#include "../../core/lv_obj_class_private.h"
+#include "../../stdlib/lv_mem.h"
+#include "../../stdlib/lv_string.h"
+#include "../../libs/rle/lv_rle.h"
+
+#if LV_USE_LZ4_EXTERNAL
+    #include <lz4.h>
+#endif
+
+#if LV_USE_LZ4_INTERNAL
+    #include "../../libs/lz4/lz4.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MY_CLASS (&lv_sprite_anim_class)
+
+#define FILE_HEADER_SIZE    32
+#define FRAME_HEADER_SIZE   16
+#define PX_SIZE             2   /*Only RGB565 is written by the converter*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    uint16_t w;
+    uint16_t h;
+    uint16_t delay;
+    uint16_t rows_per_chunk;
+    uint16_t chunk_count;
+} frame_header_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void lv_sprite_anim_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_sprite_anim_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void close_src(lv_sprite_anim_t * anim);
+static bool read_exact(lv_sprite_anim_t * anim, void * buf, uint32_t len);
+static bool decode_frame(lv_sprite_anim_t * anim, lv_area_t * changed);
+static void next_frame_task_cb(lv_timer_t * t);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+const lv_obj_class_t lv_sprite_anim_class = {
+    .constructor_cb = lv_sprite_anim_constructor,
+    .destructor_cb = lv_sprite_anim_destructor,
+    .instance_size = sizeof(lv_sprite_anim_t),
+    .base_class = &lv_image_class,
+    .name = "sprite_anim",
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+#define GET_U16(p) ((uint16_t)((p)[0] | ((p)[1] << 8)))
+#define GET_U32(p) ((uint32_t)((p)[0] | ((p)[1] << 8) | ((p)[2] << 16) | ((uint32_t)(p)[3] << 24)))
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_obj_t * lv_sprite_anim_create(lv_obj_t * parent)
+{
+    LV_LOG_INFO("begin");
+    lv_obj_t * obj = lv_obj_class_create_obj(MY_CLASS, parent);
+    lv_obj_class_init_obj(obj);
+    return obj;
+}
+
+void lv_sprite_anim_set_buffer(lv_obj_t * obj, void * buf, uint32_t buf_size)
+{
+    lv_sprite_anim_t * anim = (lv_sprite_anim_t *) obj;
+
+    anim->user_buf = buf;
+    anim->user_buf_size = buf ? buf_size : 0;
+}
+
+void lv_sprite_anim_set_src(lv_obj_t * obj, const char * path)
+{
+    lv_sprite_anim_t * anim = (lv_sprite_anim_t *) obj;
+
+    close_src(anim);
+
+    if(lv_fs_open(&anim->file, path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        LV_LOG_WARN("Couldn't open %s", path);
+        return;
+    }
+    anim->file_open = true;
+
+    uint8_t h[FILE_HEADER_SIZE];
+    if(!read_exact(anim, h, sizeof(h)) || GET_U32(h) != LV_SPRITE_ANIM_MAGIC || h[4] != LV_SPRITE_ANIM_VERSION ||
+       h[5] != LV_COLOR_FORMAT_RGB565) {
+        LV_LOG_WARN("%s is not a sprite animation", path);
+        close_src(anim);
+        return;
+    }
+
+    uint16_t w = GET_U16(h + 8);
+    uint16_t hgt = GET_U16(h + 10);
+    anim->compress = h[6];
+    anim->frame_count = GET_U16(h + 12);
+    anim->file_loop_count = GET_U16(h + 14);
+    anim->loop_count = anim->file_loop_count;
+    anim->chunk_buf_size = GET_U32(h + 16);
+    anim->raw_buf_size = GET_U32(h + 20);
+    anim->first_frame_pos = FILE_HEADER_SIZE;
+    anim->frame_index = 0;
+
+    if(w == 0 || hgt == 0 || anim->frame_count == 0 || anim->compress > 2) {
+        LV_LOG_WARN("Invalid sprite animation header");
+        close_src(anim);
+        return;
+    }
+
+    if((anim->compress == 1 && !LV_USE_RLE) || (anim->compress == 2 && !LV_USE_LZ4)) {
+        LV_LOG_WARN("%s is %s compressed, enable %s", path, anim->compress == 1 ? "RLE" : "LZ4",
+                    anim->compress == 1 ? "LV_USE_RLE" : "LV_USE_LZ4_INTERNAL or LV_USE_LZ4_EXTERNAL");
+        close_src(anim);
+        return;
+    }
+
+    /*The canvas is the only full-size buffer, chunks are streamed through small ones*/
+    uint32_t canvas_size = (uint32_t)w * hgt * PX_SIZE;
+    if(anim->user_buf) {
+        if(anim->user_buf_size < canvas_size) {
+            LV_LOG_WARN("The buffer is too small for a %dx%d animation", w, hgt);
+            close_src(anim);
+            return;
+        }
+        anim->canvas = anim->user_buf;
+        anim->canvas_is_user_buf = true;
+    }
+    else {
+        anim->canvas = lv_malloc(canvas_size);
+    }
+    anim->chunk_buf = lv_malloc(anim->chunk_buf_size);
+    if(anim->compress != 0) anim->raw_buf = lv_malloc(anim->raw_buf_size);
+    if(anim->canvas == NULL || anim->chunk_buf == NULL || (anim->compress != 0 && anim->raw_buf == NULL)) {
+        LV_LOG_WARN("Out of memory");
+        close_src(anim);
+        return;
+    }
+    lv_memzero(anim->canvas, canvas_size);
+
+    anim->imgdsc.data = anim->canvas;
+    anim->imgdsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+    anim->imgdsc.header.flags = LV_IMAGE_FLAGS_MODIFIABLE;
+    anim->imgdsc.header.cf = LV_COLOR_FORMAT_RGB565;
+    anim->imgdsc.header.w = w;
+    anim->imgdsc.header.h = hgt;
+    anim->imgdsc.header.stride = w * PX_SIZE;
+    anim->imgdsc.data_size = canvas_size;
+
+    anim->delay = 0;
+    anim->last_call = lv_tick_get();
+
+    lv_image_set_src(obj, &anim->imgdsc);
+
+    lv_timer_resume(anim->timer);
+    lv_timer_reset(anim->timer);
+
+    next_frame_task_cb(anim->timer);
+}
+
+void lv_sprite_anim_restart(lv_obj_t * obj)
+{
+    lv_sprite_anim_t * anim = (lv_sprite_anim_t *) obj;
+
+    if(anim->canvas == NULL) {
+        LV_LOG_WARN("Sprite animation not loaded correctly");
+        return;
+    }
+
+    anim->frame_index = 0;
+    anim->loop_count = anim->file_loop_count;
+    anim->delay = 0;
+    lv_timer_resume(anim->timer);
+    lv_timer_reset(anim->timer);
+}
+
+void lv_sprite_anim_pause(lv_obj_t * obj)
+{
+    lv_sprite_anim_t * anim = (lv_sprite_anim_t *) obj;
+    lv_timer_pause(anim->timer);
+}
+
+void lv_sprite_anim_resume(lv_obj_t * obj)
+{
+    lv_sprite_anim_t * anim = (lv_sprite_anim_t *) obj;
+
+    if(anim->canvas == NULL) {
+        LV_LOG_WARN("Sprite animation not loaded correctly");
+        return;
+    }
+
+    lv_timer_resume(anim->timer);
+}
+
+bool lv_sprite_anim_is_loaded(lv_obj_t * obj)
+{
+    lv_sprite_anim_t * anim = (lv_sprite_anim_t *) obj;
+
+    return (anim->canvas != NULL);
+}
+
+uint32_t lv_sprite_anim_get_ram_usage(lv_obj_t * obj)
+{
+    lv_sprite_anim_t * anim = (lv_sprite_anim_t *) obj;
+
+    if(anim->canvas == NULL) return 0;
+
+    uint32_t size = anim->chunk_buf_size;
+    if(!anim->canvas_is_user_buf) size += anim->imgdsc.data_size;
+    if(anim->raw_buf) size += anim->raw_buf_size;
+    return size;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void lv_sprite_anim_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+
+    lv_sprite_anim_t * anim = (lv_sprite_anim_t *) obj;
+
+    anim->file_open = false;
+    anim->canvas = NULL;
+    anim->canvas_is_user_buf = false;
+    anim->user_buf = NULL;
+    anim->user_buf_size = 0;
+    anim->chunk_buf = NULL;
+    anim->raw_buf = NULL;
+    anim->timer = lv_timer_create(next_frame_task_cb, 10, obj);
+    lv_timer_pause(anim->timer);
+}
+
+static void lv_sprite_anim_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    lv_sprite_anim_t * anim = (lv_sprite_anim_t *) obj;
+
+    lv_image_cache_drop(lv_image_get_src(obj));
+
+    close_src(anim);
+    lv_timer_delete(anim->timer);
+}
+
+static void close_src(lv_sprite_anim_t * anim)
+{
+    if(anim->canvas) lv_image_cache_drop(&anim->imgdsc);
+    if(anim->file_open) lv_fs_close(&anim->file);
+    anim->file_open = false;
+
+    if(!anim->canvas_is_user_buf) lv_free(anim->canvas);
+    lv_free(anim->chunk_buf);
+    lv_free(anim->raw_buf);
+    anim->canvas = NULL;
+    anim->canvas_is_user_buf = false;
+    anim->chunk_buf = NULL;
+    anim->raw_buf = NULL;
+    anim->imgdsc.data = NULL;
+    lv_timer_pause(anim->timer);
+}
+
+static bool read_exact(lv_sprite_anim_t * anim, void * buf, uint32_t len)
+{
+    uint32_t rn = 0;
+    return lv_fs_read(&anim->file, buf, len, &rn) == LV_FS_RES_OK && rn == len;
+}
+
+/**
+ * Read the next frame from the file and copy it into the canvas chunk by chunk.
+ * @param anim      the animation
+ * @param changed   the canvas rectangle that was updated
+ * @return          false if the file is broken
+ */
+static bool decode_frame(lv_sprite_anim_t * anim, lv_area_t * changed)
+{
+    if(anim->frame_index == 0 && lv_fs_seek(&anim->file, anim->first_frame_pos, LV_FS_SEEK_SET) != LV_FS_RES_OK) {
+        return false;
+    }
+
+    uint8_t h[FRAME_HEADER_SIZE];
+    if(!read_exact(anim, h, sizeof(h))) return false;
+
+    frame_header_t fh;
+    fh.x = GET_U16(h);
+    fh.y = GET_U16(h + 2);
+    fh.w = GET_U16(h + 4);
+    fh.h = GET_U16(h + 6);
+    fh.delay = GET_U16(h + 8);
+    fh.rows_per_chunk = GET_U16(h + 10);
+    fh.chunk_count = GET_U16(h + 12);
+
+    anim->delay = fh.delay;
+    lv_area_set(changed, fh.x, fh.y, fh.x + fh.w - 1, fh.y + fh.h - 1);
+
+    if(fh.x + fh.w > anim->imgdsc.header.w || fh.y + fh.h > anim->imgdsc.header.h) return false;
+
+    uint32_t stride = anim->imgdsc.header.stride;
+    uint32_t row_size = (uint32_t)fh.w * PX_SIZE;
+    uint16_t row = 0;
+    for(uint16_t c = 0; c < fh.chunk_count; c++) {
+        uint8_t sz[4];
+        if(!read_exact(anim, sz, sizeof(sz))) return false;
+        uint32_t stored = GET_U32(sz);
+        if(stored > anim->chunk_buf_size || !read_exact(anim, anim->chunk_buf, stored)) return false;
+
+        uint16_t rows = LV_MIN(fh.rows_per_chunk, fh.h - row);
+        uint32_t raw_len = rows * row_size;
+        if(raw_len > (anim->compress ? anim->raw_buf_size : anim->chunk_buf_size)) return false;
+
+        const uint8_t * src = anim->chunk_buf;
+        if(anim->compress == 1) {
+#if LV_USE_RLE
+            if(lv_rle_decompress(anim->chunk_buf, stored, anim->raw_buf, raw_len, PX_SIZE) != raw_len) return false;
+            src = anim->raw_buf;
+#else
+            LV_LOG_WARN("RLE decompress is not enabled");
+            return false;
+#endif
+        }
+        else if(anim->compress == 2) {
+#if LV_USE_LZ4
+            if(LZ4_decompress_safe((const char *)anim->chunk_buf, (char *)anim->raw_buf, stored, raw_len) != (int)raw_len) {
+                return false;
+            }
+            src = anim->raw_buf;
+#else
+            LV_LOG_WARN("LZ4 decompress is not enabled");
+            return false;
+#endif
+        }
+        else if(stored != raw_len) {
+            return false;
+        }
+
+        uint8_t * dst = anim->canvas + (uint32_t)(fh.y + row) * stride + fh.x * PX_SIZE;
+        for(uint16_t r = 0; r < rows; r++) {
+            lv_memcpy(dst, src, row_size);
+            dst += stride;
+            src += row_size;
+        }
+        row += rows;
+    }
+
+    return row == fh.h;
+}
+
+static void next_frame_task_cb(lv_timer_t * t)
+{
+    lv_obj_t * obj = t->user_data;
+    lv_sprite_anim_t * anim = (lv_sprite_anim_t *) obj;
+    uint32_t elaps = lv_tick_elaps(anim->last_call);
+    if(elaps < anim->delay) return;
+
+    anim->last_call = lv_tick_get();
+
+    lv_area_t changed;
+    if(!decode_frame(anim, &changed)) {
+        LV_LOG_WARN("Broken sprite animation frame %d", anim->frame_index);
+        lv_timer_pause(t);
+        return;
+    }
+
+    anim->frame_index++;
+    if(anim->frame_index >= anim->frame_count) {
+        anim->frame_index = 0;
+        if(anim->loop_count == 1) {
+            /*It was the last repeat*/
+            lv_result_t res = lv_obj_send_event(obj, LV_EVENT_READY, NULL);
+            lv_timer_pause(t);
+            if(res != LV_RESULT_OK) return;
+        }
+        else if(anim->loop_count > 1) {
+            anim->loop_count--;
+        }
+    }
+
+    if(lv_area_get_size(&changed) == 0) return;     /*Same picture as the previous frame*/
+
+    lv_image_cache_drop(lv_image_get_src(obj));
+    lv_image_invalidate_src_area(obj, &changed);
+}
+
+#endif /*LV_USE_SPRITE_ANIM*/
@@ -0,0 +1,120 @@
+/**
+ * @file lv_sprite_anim.h
+ *
+ */
+
+#ifndef LV_SPRITE_ANIM_H
+#define LV_SPRITE_ANIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../lv_conf_internal.h"
+#include "../../misc/lv_types.h"
+#include "../../widgets/image/lv_image.h"
+#include "../../core/lv_obj_class.h"
+#include LV_STDBOOL_INCLUDE
+#include LV_STDINT_INCLUDE
+#if LV_USE_SPRITE_ANIM
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**
+ * Pre-decoded animation file, little endian, written by `scripts/LVGLImage.py --ofmt ANIM`.
+ *
+ * File header (32 bytes):
+ *   u32 magic (LV_SPRITE_ANIM_MAGIC), u8 version, u8 color format, u8 compress (0: none, 1: RLE, 2: LZ4), u8 reserved,
+ *   u16 width, u16 height, u16 frame count, u16 loop count (0: forever),
+ *   u32 largest stored chunk, u32 largest decoded chunk, 8 reserved bytes
+ * Every frame (16 byte header):
+ *   u16 x, u16 y, u16 w, u16 h, u16 delay [ms], u16 rows per chunk, u16 chunk count, u16 reserved
+ *   followed by `chunk count` chunks of u32 size + data, each holding `rows per chunk` rows of the rectangle
+ *
+ * The first frame covers the whole canvas, later frames only the rectangle that changed.
+ */
+#define LV_SPRITE_ANIM_MAGIC    0x4E41564C  /*"LVAN"*/
+#define LV_SPRITE_ANIM_VERSION  1
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+LV_ATTRIBUTE_EXTERN_DATA extern const lv_obj_class_t lv_sprite_anim_class;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a sprite animation object
+ * @param parent    pointer to an object, it will be the parent of the new sprite animation.
+ * @return          pointer to the sprite animation obj
+ */
+lv_obj_t * lv_sprite_anim_create(lv_obj_t * parent);
+
+/**
+ * Decode the frames into a buffer of the application instead of one allocated with `lv_malloc()`.
+ * A full-screen canvas rarely fits in LVGL's heap, e.g. 320x240 RGB565 takes 150 KB.
+ * Takes effect on the next `lv_sprite_anim_set_src()`. The buffer must stay valid while the object uses it.
+ * @param obj       pointer to a sprite animation object
+ * @param buf       buffer of at least width * height * 2 bytes of the animation, or NULL to allocate it again
+ * @param buf_size  size of `buf` in bytes
+ */
+void lv_sprite_anim_set_buffer(lv_obj_t * obj, void * buf, uint32_t buf_size);
+
+/**
+ * Set the animation file to play. Frames are streamed from the file, only one chunk is buffered at a time.
+ * @param obj       pointer to a sprite animation object
+ * @param path      path to the file (e.g. "S:/anim/loading.anim")
+ */
+void lv_sprite_anim_set_src(lv_obj_t * obj, const char * path);
+
+/**
+ * Restart the animation from the first frame, with the loop count of the file.
+ * @param obj pointer to a sprite animation obj
+ */
+void lv_sprite_anim_restart(lv_obj_t * obj);
+
+/**
+ * Pause the animation.
+ * @param obj pointer to a sprite animation obj
+ */
+void lv_sprite_anim_pause(lv_obj_t * obj);
+
+/**
+ * Resume the animation.
+ * @param obj pointer to a sprite animation obj
+ */
+void lv_sprite_anim_resume(lv_obj_t * obj);
+
+/**
+ * Checks if the animation was loaded correctly.
+ * @param obj pointer to a sprite animation obj
+ */
+bool lv_sprite_anim_is_loaded(lv_obj_t * obj);
+
+/**
+ * Get the memory used by the animation: canvas plus streaming buffers.
+ * @param obj pointer to a sprite animation obj
+ * @return    bytes allocated for the loaded animation, a buffer set by `lv_sprite_anim_set_buffer()` not included
+ */
+uint32_t lv_sprite_anim_get_ram_usage(lv_obj_t * obj);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_SPRITE_ANIM*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_SPRITE_ANIM_H*/
@@ -0,0 +1,69 @@
+/**
+ * @file lv_sprite_anim_private.h
+ *
+ */
+
+#ifndef LV_SPRITE_ANIM_PRIVATE_H
+#define LV_SPRITE_ANIM_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../widgets/image/lv_image_private.h"
+#include "../../misc/lv_fs.h"
+#include "lv_sprite_anim.h"
+
+#if LV_USE_SPRITE_ANIM
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_sprite_anim_t {
+    lv_image_t img;
+    lv_timer_t * timer;
+    lv_image_dsc_t imgdsc;
+    lv_fs_file_t file;
+    bool file_open;
+    bool canvas_is_user_buf;    /*The canvas is `user_buf`, so it is not freed*/
+    uint8_t compress;           /*0: none, 1: RLE, 2: LZ4*/
+    uint16_t frame_count;
+    uint16_t frame_index;       /*Next frame to decode*/
+    int32_t loop_count;         /*Loops left, 0: forever*/
+    uint16_t file_loop_count;   /*Loop count of the file, restored by a restart*/
+    uint32_t first_frame_pos;   /*File offset of the first frame*/
+    uint8_t * canvas;
+    uint8_t * user_buf;         /*Canvas buffer set by `lv_sprite_anim_set_buffer()`, not freed by the widget*/
+    uint32_t user_buf_size;
+    uint8_t * chunk_buf;        /*Stored chunk as read from the file*/
+    uint8_t * raw_buf;          /*Decompressed chunk (NULL when not compressed)*/
+    uint32_t chunk_buf_size;
+    uint32_t raw_buf_size;
+    uint32_t delay;             /*Delay of the current frame [ms]*/
+    uint32_t last_call;
+};
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* LV_USE_SPRITE_ANIM */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_SPRITE_ANIM_PRIVATE_H*/
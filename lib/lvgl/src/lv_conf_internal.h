@@ -57,7 +57,7 @@
     #elif defined(LV_CONF_INCLUDE_SIMPLE)         /* Or simply include lv_conf.h is enabled. */
         #include "lv_conf.h"
     #else
-        #include "../../../include/lv_conf.h"                /* Else assume lv_conf.h is next to the lvgl folder. */
+        #include "../../lv_conf.h"                /* Else assume lv_conf.h is next to the lvgl folder. */
     #endif
     #if !defined(LV_CONF_H) && !defined(LV_CONF_SUPPRESS_DEFINE_CHECK)
         /* #include will sometimes silently fail when __has_include is used */
@@ -366,6 +366,18 @@
     #endif
 #endif
 
+/** Keep up to this many bytes of released layer buffers to reuse them for the next layers
+ * instead of allocating and freeing them in every refresh (e.g. while fading a screen).
+ * Buffers not used during a refresh are freed at its end.
+ * Set it to 0 to disable the pool. */
+#ifndef LV_DRAW_LAYER_BUF_POOL_SIZE
+    #ifdef CONFIG_LV_DRAW_LAYER_BUF_POOL_SIZE
+        #define LV_DRAW_LAYER_BUF_POOL_SIZE CONFIG_LV_DRAW_LAYER_BUF_POOL_SIZE
+    #else
+        #define LV_DRAW_LAYER_BUF_POOL_SIZE 0  /**< [bytes]*/
+    #endif
+#endif
+
 /** Stack size of drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -566,6 +578,18 @@
                 #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
             #endif
         #endif
+
+        /** Size of the cache of rounded corner masks and blurred shadow corners [bytes].
+         *  Corners are kept per radius, border width and shadow size, so rounded rectangles,
+         *  borders and shadows which are redrawn often don't compute their masks again.
+         *  - 0: disables caching */
+        #ifndef LV_DRAW_SW_MASK_CACHE_SIZE
+            #ifdef CONFIG_LV_DRAW_SW_MASK_CACHE_SIZE
+                #define LV_DRAW_SW_MASK_CACHE_SIZE CONFIG_LV_DRAW_SW_MASK_CACHE_SIZE
+            #else
+                #define LV_DRAW_SW_MASK_CACHE_SIZE 0
+            #endif
+        #endif
     #endif
 
     #ifndef LV_USE_DRAW_SW_ASM
@@ -594,6 +618,18 @@
             #define LV_USE_DRAW_SW_COMPLEX_GRADIENTS    0
         #endif
     #endif
+
+    /** Size of the cache of gradient color and opacity maps [bytes].
+     *  Maps are kept per gradient stops and size, so gradients redrawn in many stripes
+     *  or frames don't calculate every color again.
+     *  - 0: disables caching */
+    #ifndef LV_DRAW_SW_GRADIENT_CACHE_SIZE
+        #ifdef CONFIG_LV_DRAW_SW_GRADIENT_CACHE_SIZE
+            #define LV_DRAW_SW_GRADIENT_CACHE_SIZE CONFIG_LV_DRAW_SW_GRADIENT_CACHE_SIZE
+        #else
+            #define LV_DRAW_SW_GRADIENT_CACHE_SIZE  0
+        #endif
+    #endif
 #endif
 
 /*Use TSi's aka (Think Silicon) NemaGFX */
@@ -1249,6 +1285,16 @@
     #endif
 #endif
 
+/** Keep the values resolved by `lv_obj_get_style_prop` per object, part and state.
+ *  Costs a pointer in each `lv_obj_t` and about 4 bytes per resolved property. */
+#ifndef LV_OBJ_STYLE_RESOLVED_CACHE
+    #ifdef CONFIG_LV_OBJ_STYLE_RESOLVED_CACHE
+        #define LV_OBJ_STYLE_RESOLVED_CACHE CONFIG_LV_OBJ_STYLE_RESOLVED_CACHE
+    #else
+        #define LV_OBJ_STYLE_RESOLVED_CACHE 0
+    #endif
+#endif
+
 /** Add `id` field to `lv_obj_t` */
 #ifndef LV_USE_OBJ_ID
     #ifdef CONFIG_LV_USE_OBJ_ID
@@ -1766,6 +1812,16 @@
     #endif
 #endif
 
+/** 1: Keep a direct-mapped table of the glyph IDs of the printable ASCII letters for each used built-in font
+ *  (about 200 bytes each), so they are not searched in the font's character maps for every letter. */
+#ifndef LV_USE_FONT_FMT_TXT_GID_TABLE
+    #ifdef CONFIG_LV_USE_FONT_FMT_TXT_GID_TABLE
+        #define LV_USE_FONT_FMT_TXT_GID_TABLE CONFIG_LV_USE_FONT_FMT_TXT_GID_TABLE
+    #else
+        #define LV_USE_FONT_FMT_TXT_GID_TABLE 0
+    #endif
+#endif
+
 /** Enables/disables support for compressed fonts. */
 #ifndef LV_USE_FONT_COMPRESSED
     #ifdef CONFIG_LV_USE_FONT_COMPRESSED
@@ -1845,6 +1901,16 @@
     #endif
 #endif
 
+/** Size of the text layout cache in bytes. The measured size and line breaks of texts are kept
+ *  so labels and tables don't break the same text into lines again. 0 to disable. */
+#ifndef LV_TEXT_LAYOUT_CACHE_SIZE
+    #ifdef CONFIG_LV_TEXT_LAYOUT_CACHE_SIZE
+        #define LV_TEXT_LAYOUT_CACHE_SIZE CONFIG_LV_TEXT_LAYOUT_CACHE_SIZE
+    #else
+        #define LV_TEXT_LAYOUT_CACHE_SIZE 0
+    #endif
+#endif
+
 /** Support bidirectional text. Allows mixing Left-to-Right and Right-to-Left text.
  *  The direction will be processed according to the Unicode Bidirectional Algorithm:
  *  https://www.w3.org/International/articles/inline-bidi-markup/uba-basics */
@@ -2242,6 +2308,18 @@
     #endif
 #endif
 
+#ifndef LV_USE_NUMLABEL
+    #ifdef LV_KCONFIG_PRESENT
+        #ifdef CONFIG_LV_USE_NUMLABEL
+            #define LV_USE_NUMLABEL CONFIG_LV_USE_NUMLABEL
+        #else
+            #define LV_USE_NUMLABEL 0
+        #endif
+    #else
+        #define LV_USE_NUMLABEL   1   /**< Fixed point numbers drawn from pre-rendered digits*/
+    #endif
+#endif
+
 #ifndef LV_USE_ROLLER
     #ifdef LV_KCONFIG_PRESENT
         #ifdef CONFIG_LV_USE_ROLLER
@@ -2815,6 +2893,16 @@
     #endif
 #endif
 
+/** Player for pre-decoded RGB565 animations made with `scripts/LVGLImage.py --ofmt ANIM`.
+ *  Frames are streamed via lv_fs; enable LV_USE_RLE or LV_USE_LZ4_* for compressed files. */
+#ifndef LV_USE_SPRITE_ANIM
+    #ifdef CONFIG_LV_USE_SPRITE_ANIM
+        #define LV_USE_SPRITE_ANIM CONFIG_LV_USE_SPRITE_ANIM
+    #else
+        #define LV_USE_SPRITE_ANIM 0
+    #endif
+#endif
+
 
 /** Decode bin images to RAM */
 #ifndef LV_BIN_DECODER_RAM_LOAD
@@ -3030,6 +3118,16 @@
     #endif
 #endif
 
+/** 1: Keep the rendered image of screens so an unchanged screen is copied instead of rendered when
+ *  it's loaded again. Needs `LV_USE_SNAPSHOT`, see `lv_page_cache_create()` */
+#ifndef LV_USE_PAGE_CACHE
+    #ifdef CONFIG_LV_USE_PAGE_CACHE
+        #define LV_USE_PAGE_CACHE CONFIG_LV_USE_PAGE_CACHE
+    #else
+        #define LV_USE_PAGE_CACHE 0
+    #endif
+#endif
+
 /** 1: Enable system monitor component */
 #ifndef LV_USE_SYSMON
     #ifdef CONFIG_LV_USE_SYSMON
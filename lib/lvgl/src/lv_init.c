@@ -11,6 +11,8 @@
 #include "misc/lv_anim_private.h"
 #include "draw/lv_image_decoder_private.h"
 #include "draw/lv_draw_buf_private.h"
+#include "font/lv_font_fmt_txt_private.h"
+#include "misc/lv_text_private.h"
 #include "core/lv_refr_private.h"
 #include "core/lv_obj_style_private.h"
 #include "core/lv_group_private.h"
@@ -35,11 +37,11 @@
 #include "misc/lv_async.h"
 #include "misc/lv_fs_private.h"
 #include "widgets/span/lv_span.h"
+#include "widgets/numlabel/lv_numlabel_private.h"
 #include "themes/simple/lv_theme_simple.h"
 #include "misc/lv_fs.h"
 #include "osal/lv_os_private.h"
 #include "others/sysmon/lv_sysmon_private.h"
-#include "others/xml/lv_xml.h"
 
 #if LV_USE_NEMA_GFX
     #include "draw/nema_gfx/lv_draw_nema_gfx.h"
@@ -116,6 +118,9 @@ static inline void lv_global_init(lv_global_t * global)
 
     lv_ll_init(&(global->disp_ll), sizeof(lv_display_t));
     lv_ll_init(&(global->indev_ll), sizeof(lv_indev_t));
+#if LV_USE_NUMLABEL
+    lv_ll_init(&(global->numlabel_strip_ll), sizeof(lv_numlabel_strip_t));
+#endif
 
     global->memory_zero = ZERO_MEM_SENTINEL;
     global->style_refresh = true;
@@ -257,6 +262,9 @@ void lv_init(void)
 #endif
 
     lv_image_decoder_init(LV_CACHE_DEF_SIZE, LV_IMAGE_HEADER_CACHE_DEF_CNT);
+
+    lv_font_fmt_txt_cache_init();
+    lv_text_layout_cache_init(LV_TEXT_LAYOUT_CACHE_SIZE);
     lv_bin_decoder_init();  /*LVGL built-in binary image decoder*/
 
 #if LV_USE_DRAW_VG_LITE
@@ -358,10 +366,6 @@ void lv_init(void)
     lv_ffmpeg_init();
 #endif
 
-#if LV_USE_XML
-    lv_xml_init();
-#endif
-
     lv_initialized = true;
 
     LV_LOG_TRACE("finished");
@@ -409,6 +413,9 @@ void lv_deinit(void)
 
     lv_image_decoder_deinit();
 
+    lv_font_fmt_txt_cache_deinit();
+    lv_text_layout_cache_deinit();
+
     lv_refr_deinit();
 
     lv_obj_style_deinit();
@@ -55,6 +55,9 @@ lv_cache_t * lv_cache_create(const lv_cache_class_t * cache_class,
     cache->max_size = max_size;
     cache->size = 0;
     cache->ops = ops;
+    cache->hit_cnt = 0;
+    cache->miss_cnt = 0;
+    cache->evict_cnt = 0;
 
     if(cache->clz->init_cb(cache) == false) {
         LV_LOG_ERROR("Cache init failed");
@@ -88,6 +91,7 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
     lv_mutex_lock(&cache->lock);
 
     if(cache->size == 0) {
+        cache->miss_cnt++;
         lv_mutex_unlock(&cache->lock);
 
         LV_PROFILER_CACHE_END;
@@ -97,6 +101,10 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
     lv_cache_entry_t * entry = cache->clz->get_cb(cache, key, user_data);
     if(entry != NULL) {
         lv_cache_entry_acquire_data(entry);
+        cache->hit_cnt++;
+    }
+    else {
+        cache->miss_cnt++;
     }
     lv_mutex_unlock(&cache->lock);
 
@@ -158,6 +166,7 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
         entry = cache->clz->get_cb(cache, key, user_data);
         if(entry != NULL) {
             lv_cache_entry_acquire_data(entry);
+            cache->hit_cnt++;
             lv_mutex_unlock(&cache->lock);
 
             LV_PROFILER_CACHE_END;
@@ -165,6 +174,8 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
         }
     }
 
+    cache->miss_cnt++;
+
     if(cache->max_size == 0) {
         lv_mutex_unlock(&cache->lock);
 
@@ -301,6 +312,30 @@ lv_iter_t * lv_cache_iter_create(lv_cache_t * cache)
     return cache->clz->iter_create_cb(cache);
 }
 
+void lv_cache_get_stats(lv_cache_t * cache, lv_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(cache);
+
+    lv_mutex_lock(&cache->lock);
+    stats->hits = cache->hit_cnt;
+    stats->misses = cache->miss_cnt;
+    stats->evictions = cache->evict_cnt;
+    stats->size = cache->size;
+    stats->max_size = cache->max_size;
+    lv_mutex_unlock(&cache->lock);
+}
+
+void lv_cache_reset_stats(lv_cache_t * cache)
+{
+    LV_ASSERT_NULL(cache);
+
+    lv_mutex_lock(&cache->lock);
+    cache->hit_cnt = 0;
+    cache->miss_cnt = 0;
+    cache->evict_cnt = 0;
+    lv_mutex_unlock(&cache->lock);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -335,6 +370,7 @@ static bool cache_evict_one_internal_no_lock(lv_cache_t * cache, void * user_dat
     cache->clz->remove_cb(cache, victim, user_data);
     cache->ops.free_cb(lv_cache_entry_get_data(victim), user_data);
     lv_cache_entry_delete(victim);
+    cache->evict_cnt++;
     return true;
 }
 
@@ -29,6 +29,17 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/**
+ * Counters of a cache, see `lv_cache_get_stats`
+ */
+struct _lv_cache_stats_t {
+    uint32_t hits;          /**< Lookups that found their entry */
+    uint32_t misses;        /**< Lookups that did not */
+    uint32_t evictions;     /**< Entries dropped to make room for new ones */
+    size_t size;            /**< Current size (count or bytes, depending on the class) */
+    size_t max_size;        /**< Current limit */
+};
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -38,10 +49,12 @@ extern "C" {
  * @param cache_class   The class of the cache. Currently only support one two builtin classes:
  *                        - lv_cache_class_lru_rb_count for LRU-based cache with count-based eviction policy.
  *                        - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy.
+ *                        - lv_cache_class_lru_rb_cost for size-based cache weighting entries by their `slot.cost`.
  * @param node_size     The node size is the size of the data stored in the cache..
  * @param max_size      The max size is the maximum amount of memory or count that the cache can hold.
  *                        - lv_cache_class_lru_rb_count: max_size is the maximum count of nodes in the cache.
  *                        - lv_cache_class_lru_rb_size: max_size is the maximum size of the cache in bytes.
+ *                        - lv_cache_class_lru_rb_cost: max_size is the maximum size of the cache in bytes.
  * @param ops           A set of operations that can be performed on the cache. See lv_cache_ops_t for details.
  * @return              Returns a pointer to the created cache object on success, `NULL` on error.
  */
@@ -222,6 +235,19 @@ const char * lv_cache_get_name(lv_cache_t * cache);
  */
 lv_iter_t * lv_cache_iter_create(lv_cache_t * cache);
 
+/**
+ * Get the hit, miss and eviction counters of the cache.
+ * @param cache         The cache object pointer to get the counters from.
+ * @param stats         Where to store the counters.
+ */
+void lv_cache_get_stats(lv_cache_t * cache, lv_cache_stats_t * stats);
+
+/**
+ * Reset the hit, miss and eviction counters of the cache.
+ * @param cache         The cache object pointer to reset the counters of.
+ */
+void lv_cache_reset_stats(lv_cache_t * cache);
+
 /*************************
  *    GLOBAL VARIABLES
  *************************/
@@ -50,6 +50,7 @@
 #include "../lv_rb_private.h"
 #include "../lv_rb.h"
 #include "../lv_iter.h"
+#include "../lv_math.h"
 
 /*********************
  *      DEFINES
@@ -67,7 +68,19 @@ struct _lv_lru_rb_t {
     lv_ll_t ll;
 
     get_data_size_cb_t * get_data_size_cb;
+
+    bool cost_aware;
+    uint64_t inflation;     /*Priority of the last victim, ages the entries that stay (cost class only)*/
 };
+
+/**
+ * List node of the cost class. Starts with the tree node pointer like the plain list nodes,
+ * so the shared code can treat both the same way.
+ */
+typedef struct {
+    lv_rb_node_t * node;
+    uint64_t base;          /*`inflation` when the entry was last used*/
+} lru_cost_node_t;
 typedef struct _lv_lru_rb_t lv_lru_rb_t_;
 /**********************
  *  STATIC PROTOTYPES
@@ -76,6 +89,7 @@ typedef struct _lv_lru_rb_t lv_lru_rb_t_;
 static void * alloc_cb(void);
 static bool init_cnt_cb(lv_cache_t * cache);
 static bool init_size_cb(lv_cache_t * cache);
+static bool init_cost_cb(lv_cache_t * cache);
 static void  destroy_cb(lv_cache_t * cache, void * user_data);
 
 static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data);
@@ -89,6 +103,8 @@ static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const voi
 
 static void * alloc_new_node(lv_lru_rb_t_ * lru, void * key, void * user_data);
 inline static void ** get_lru_node(lv_lru_rb_t_ * lru, lv_rb_node_t * node);
+static void touch_lru_node(lv_lru_rb_t_ * lru, void * lru_node);
+static uint64_t get_priority(lru_cost_node_t * lru_node);
 
 static uint32_t cnt_get_data_size_cb(const void * data);
 static uint32_t size_get_data_size_cb(const void * data);
@@ -128,6 +144,21 @@ const lv_cache_class_t lv_cache_class_lru_rb_size = {
     .reserve_cond_cb = reserve_cond_cb,
     .iter_create_cb = cache_iter_create_cb,
 };
+
+const lv_cache_class_t lv_cache_class_lru_rb_cost = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_cost_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cb,
+    .reserve_cond_cb = reserve_cond_cb,
+    .iter_create_cb = cache_iter_create_cb,
+};
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -168,6 +199,7 @@ static void * alloc_new_node(lv_lru_rb_t_ * lru, void * key, void * user_data)
 
     lv_memcpy(lru_node, &node, sizeof(void *));
     lv_memcpy(get_lru_node(lru, node), &lru_node, sizeof(void *));
+    touch_lru_node(lru, lru_node);
 
     lv_cache_entry_init(entry, &lru->cache, lru->cache.node_size);
     goto FAILED_HANDLER2;
@@ -184,6 +216,27 @@ inline static void ** get_lru_node(lv_lru_rb_t_ * lru, lv_rb_node_t * node)
     return (void **)((char *)node->data + lru->rb.size - sizeof(void *));
 }
 
+/**
+ * Mark a list node as just used. The cost class remembers the current inflation,
+ * the other classes only use the list order.
+ */
+static void touch_lru_node(lv_lru_rb_t_ * lru, void * lru_node)
+{
+    if(lru->cost_aware) ((lru_cost_node_t *)lru_node)->base = lru->inflation;
+}
+
+/**
+ * GreedyDual-Size priority: inflation at the last use plus the square root of the cost per KiB of cached data.
+ * Expensive, small and recently used entries get the highest priority. The square root keeps an expensive
+ * image that is no longer shown from outliving many cheap ones that still are.
+ */
+static uint64_t get_priority(lru_cost_node_t * lru_node)
+{
+    const lv_cache_slot_size_t * slot = (const lv_cache_slot_size_t *)lru_node->node->data;
+    uint64_t density = ((uint64_t)LV_MAX(slot->cost, 1) << 10) / (slot->size + 1);
+    return lru_node->base + (uint64_t)lv_sqrt32((uint32_t)LV_MIN(density, UINT32_MAX));
+}
+
 static void * alloc_cb(void)
 {
     void * res = lv_malloc(sizeof(lv_lru_rb_t_));
@@ -243,6 +296,23 @@ static bool init_size_cb(lv_cache_t * cache)
     return true;
 }
 
+static bool init_cost_cb(lv_cache_t * cache)
+{
+    lv_lru_rb_t_ * lru = (lv_lru_rb_t_ *)cache;
+
+    if(!init_size_cb(cache)) {
+        return false;
+    }
+
+    /*The list nodes also store when the entry was last used*/
+    lv_ll_init(&lru->ll, sizeof(lru_cost_node_t));
+
+    lru->cost_aware = true;
+    lru->inflation = 0;
+
+    return true;
+}
+
 static void destroy_cb(lv_cache_t * cache, void * user_data)
 {
     LV_UNUSED(user_data);
@@ -278,6 +348,7 @@ static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * us
         void * data = node->data;
         lv_cache_entry_t * entry = lv_cache_entry_get_entry(data, cache->node_size);
         if(lru->cache.ops.compare_cb(data, key) == 0) {
+            touch_lru_node(lru, head);
             return entry;
         }
     }
@@ -288,6 +359,7 @@ static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * us
         void * lru_node = *get_lru_node(lru, node);
         head = lv_ll_get_head(&lru->ll);
         lv_ll_move_before(&lru->ll, lru_node, head);
+        touch_lru_node(lru, lru_node);
 
         lv_cache_entry_t * entry = lv_cache_entry_get_entry(node->data, cache->node_size);
         return entry;
@@ -420,6 +492,28 @@ static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data)
 
     LV_ASSERT_NULL(lru);
 
+    if(lru->cost_aware) {
+        /*Lowest priority wins, on a tie the least recently used one*/
+        lru_cost_node_t * victim = NULL;
+        uint64_t victim_priority = UINT64_MAX;
+        lru_cost_node_t * lru_node;
+        LV_LL_READ_BACK(&lru->ll, lru_node) {
+            lv_cache_entry_t * entry = lv_cache_entry_get_entry(lru_node->node->data, cache->node_size);
+            if(lv_cache_entry_get_ref(entry) != 0) continue;
+
+            uint64_t priority = get_priority(lru_node);
+            if(priority < victim_priority) {
+                victim = lru_node;
+                victim_priority = priority;
+            }
+        }
+
+        if(victim == NULL) return NULL;
+
+        lru->inflation = victim_priority;
+        return lv_cache_entry_get_entry(victim->node->data, cache->node_size);
+    }
+
     lv_rb_node_t ** tail;
     LV_LL_READ_BACK(&lru->ll, tail) {
         lv_rb_node_t * tail_node = *tail;
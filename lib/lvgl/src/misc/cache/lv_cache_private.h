@@ -124,9 +124,10 @@ struct _lv_cache_ops_t {
  * The cache entry struct
  */
 struct _lv_cache_t {
-    const lv_cache_class_t * clz;     /**< Cache class. There are two built-in classes:
+    const lv_cache_class_t * clz;     /**< Cache class. There are three built-in classes:
                                        * - lv_cache_class_lru_rb_count for LRU-based cache with count-based eviction policy.
-                                       * - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy. */
+                                       * - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy.
+                                       * - lv_cache_class_lru_rb_cost for size-based cache evicting cheap to recreate entries first. */
 
     uint32_t node_size;               /**< Size of a node */
 
@@ -138,6 +139,10 @@ struct _lv_cache_t {
     lv_mutex_t lock;                  /**< Cache lock used to protect the cache in multithreading environments */
 
     const char * name;                /**< Name of the cache */
+
+    uint32_t hit_cnt;                 /**< Lookups that found their entry */
+    uint32_t miss_cnt;                /**< Lookups that did not */
+    uint32_t evict_cnt;               /**< Entries dropped to make room */
 };
 
 /**
@@ -146,6 +151,7 @@ struct _lv_cache_t {
  * Examples:
  * - lv_cache_class_lru_rb_count for LRU-based cache with count-based eviction policy.
  * - lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy.
+ * - lv_cache_class_lru_rb_cost for size-based cache evicting cheap to recreate entries first.
  */
 struct _lv_cache_class_t {
     lv_cache_alloc_cb_t alloc_cb;                 /**< The allocation function for cache entries */
@@ -179,6 +185,7 @@ typedef struct _lv_cache_slot_size_t lv_cache_slot_size_t;
  */
 struct _lv_cache_slot_size_t {
     size_t size;
+    uint32_t cost;      /**< Cost of recreating the data (e.g. decode time in us), used by lv_cache_class_lru_rb_cost */
 };
 /**********************
  * GLOBAL PROTOTYPES
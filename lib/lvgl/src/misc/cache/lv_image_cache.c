@@ -59,7 +59,7 @@ lv_result_t lv_image_cache_init(uint32_t size)
         return LV_RESULT_OK;
     }
 
-    img_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+    img_cache_p = lv_cache_create(&lv_cache_class_lru_rb_cost,
     sizeof(lv_image_cache_data_t), size, (lv_cache_ops_t) {
         .compare_cb = (lv_cache_compare_cb_t) image_cache_compare_cb,
         .create_cb = NULL,
@@ -112,10 +112,26 @@ void lv_image_cache_dump(void)
     if(iter == NULL) return;
 
     LV_LOG_USER("Image cache dump:");
-    LV_LOG_USER("\tsize\tdata_size\tcf\trc\ttype\tdecoded\t\t\tsrc");
+    LV_LOG_USER("\tsize\tdata_size\tcf\trc\ttype\tdecoded\t\t\tcost\tsrc");
     lv_iter_inspect(iter, iter_inspect_cb);
 }
 
+void lv_image_cache_set_clock_cb(uint32_t (*clock_us_cb)(void))
+{
+    LV_GLOBAL_DEFAULT()->img_cache_clock_cb = clock_us_cb;
+}
+
+uint32_t lv_image_cache_clock(void)
+{
+    uint32_t (*clock_us_cb)(void) = LV_GLOBAL_DEFAULT()->img_cache_clock_cb;
+    return clock_us_cb ? clock_us_cb() : lv_tick_get() * 1000;
+}
+
+void lv_image_cache_get_stats(lv_cache_stats_t * stats)
+{
+    lv_cache_get_stats(img_cache_p, stats);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -174,18 +190,19 @@ static void iter_inspect_cb(void * elem)
 
     /*  size    data_size   cf  rc  type    decoded         src*/
 #define IMAGE_CACHE_DUMP_FORMAT "	%4dx%-4d	%9"LV_PRIu32"	%d	%"LV_PRId32"	"
+#define IMAGE_CACHE_DUMP_COST   "\t%"LV_PRIu32"us\t"
     switch(data->src_type) {
         case LV_IMAGE_SRC_FILE:
-            LV_LOG_USER(IMAGE_CACHE_DUMP_FORMAT "file\t%-12p\t%s", header->w, header->h, decoded->data_size, header->cf,
-                        lv_cache_entry_get_ref(entry), (void *)data->decoded, (char *)data->src);
+            LV_LOG_USER(IMAGE_CACHE_DUMP_FORMAT "file\t%-12p" IMAGE_CACHE_DUMP_COST "%s", header->w, header->h, decoded->data_size,
+                        header->cf, lv_cache_entry_get_ref(entry), (void *)data->decoded, data->slot.cost, (char *)data->src);
             break;
         case LV_IMAGE_SRC_VARIABLE:
-            LV_LOG_USER(IMAGE_CACHE_DUMP_FORMAT "var \t%-12p\t%p", header->w, header->h, decoded->data_size, header->cf,
-                        lv_cache_entry_get_ref(entry), (void *)data->decoded, data->src);
+            LV_LOG_USER(IMAGE_CACHE_DUMP_FORMAT "var \t%-12p" IMAGE_CACHE_DUMP_COST "%p", header->w, header->h, decoded->data_size,
+                        header->cf, lv_cache_entry_get_ref(entry), (void *)data->decoded, data->slot.cost, data->src);
             break;
         default:
-            LV_LOG_USER(IMAGE_CACHE_DUMP_FORMAT "unkn\t%-12p\t%p", header->w, header->h, decoded->data_size, header->cf,
-                        lv_cache_entry_get_ref(entry), (void *)data->decoded, data->src);
+            LV_LOG_USER(IMAGE_CACHE_DUMP_FORMAT "unkn\t%-12p" IMAGE_CACHE_DUMP_COST "%p", header->w, header->h, decoded->data_size,
+                        header->cf, lv_cache_entry_get_ref(entry), (void *)data->decoded, data->slot.cost, data->src);
             break;
     }
 }
@@ -67,6 +67,26 @@ lv_iter_t * lv_image_cache_iter_create(void);
  */
 void lv_image_cache_dump(void);
 
+/**
+ * Set the clock used to measure how long an image takes to decode.
+ * Images that were slow to decode are kept longer than cheap ones of the same size.
+ * By default `lv_tick_get()` is used, which is too coarse for fast decoders.
+ * @param clock_us_cb   a function returning a free running time in microseconds, NULL to use the tick
+ */
+void lv_image_cache_set_clock_cb(uint32_t (*clock_us_cb)(void));
+
+/**
+ * Get the current time of the image cache clock.
+ * @return time in microseconds
+ */
+uint32_t lv_image_cache_clock(void);
+
+/**
+ * Get the hit, miss and eviction counters of the image cache.
+ * @param stats     where to store the counters. `size` and `max_size` are in bytes.
+ */
+void lv_image_cache_get_stats(lv_cache_stats_t * stats);
+
 /*************************
  *    GLOBAL VARIABLES
  *************************/
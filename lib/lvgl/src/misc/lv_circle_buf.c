@@ -0,0 +1,203 @@
+/**
+ * @file lv_circle_buf.c
+ * Circular buffer of fixed size elements.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_circle_buf.h"
+#include "lv_assert.h"
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_circle_buf_t {
+    uint8_t * data;         /**< Storage of `capacity` elements */
+    uint32_t capacity;      /**< Maximum number of elements */
+    uint32_t element_size;  /**< Size of one element in bytes */
+    uint32_t head;          /**< Index of the oldest element */
+    uint32_t size;          /**< Number of elements */
+    bool inner_alloc;       /**< true: `data` is allocated by the buffer */
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static inline uint8_t * slot(const lv_circle_buf_t * circle_buf, uint32_t index);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_circle_buf_t * lv_circle_buf_create(uint32_t capacity, uint32_t element_size)
+{
+    LV_ASSERT(capacity > 0 && element_size > 0);
+
+    void * buf = lv_malloc((size_t)capacity * element_size);
+    LV_ASSERT_MALLOC(buf);
+    if(buf == NULL) return NULL;
+
+    lv_circle_buf_t * circle_buf = lv_circle_buf_create_from_buf(buf, capacity, element_size);
+    if(circle_buf == NULL) {
+        lv_free(buf);
+        return NULL;
+    }
+
+    circle_buf->inner_alloc = true;
+    return circle_buf;
+}
+
+lv_circle_buf_t * lv_circle_buf_create_from_buf(void * buf, uint32_t capacity, uint32_t element_size)
+{
+    LV_ASSERT_NULL(buf);
+    LV_ASSERT(capacity > 0 && element_size > 0);
+
+    lv_circle_buf_t * circle_buf = lv_malloc_zeroed(sizeof(lv_circle_buf_t));
+    LV_ASSERT_MALLOC(circle_buf);
+    if(circle_buf == NULL) return NULL;
+
+    circle_buf->data = buf;
+    circle_buf->capacity = capacity;
+    circle_buf->element_size = element_size;
+    return circle_buf;
+}
+
+void lv_circle_buf_destroy(lv_circle_buf_t * circle_buf)
+{
+    LV_ASSERT_NULL(circle_buf);
+    if(circle_buf == NULL) return;
+
+    if(circle_buf->inner_alloc) lv_free(circle_buf->data);
+    lv_free(circle_buf);
+}
+
+uint32_t lv_circle_buf_size(const lv_circle_buf_t * circle_buf)
+{
+    LV_ASSERT_NULL(circle_buf);
+    return circle_buf->size;
+}
+
+uint32_t lv_circle_buf_capacity(const lv_circle_buf_t * circle_buf)
+{
+    LV_ASSERT_NULL(circle_buf);
+    return circle_buf->capacity;
+}
+
+uint32_t lv_circle_buf_remain(const lv_circle_buf_t * circle_buf)
+{
+    LV_ASSERT_NULL(circle_buf);
+    return circle_buf->capacity - circle_buf->size;
+}
+
+bool lv_circle_buf_is_empty(const lv_circle_buf_t * circle_buf)
+{
+    LV_ASSERT_NULL(circle_buf);
+    return circle_buf->size == 0;
+}
+
+bool lv_circle_buf_is_full(const lv_circle_buf_t * circle_buf)
+{
+    LV_ASSERT_NULL(circle_buf);
+    return circle_buf->size == circle_buf->capacity;
+}
+
+void lv_circle_buf_reset(lv_circle_buf_t * circle_buf)
+{
+    LV_ASSERT_NULL(circle_buf);
+    circle_buf->head = 0;
+    circle_buf->size = 0;
+}
+
+lv_result_t lv_circle_buf_read(lv_circle_buf_t * circle_buf, void * data)
+{
+    LV_ASSERT_NULL(circle_buf);
+    if(circle_buf->size == 0) return LV_RESULT_INVALID;
+
+    if(data) lv_memcpy(data, slot(circle_buf, 0), circle_buf->element_size);
+    return lv_circle_buf_skip(circle_buf);
+}
+
+lv_result_t lv_circle_buf_write(lv_circle_buf_t * circle_buf, const void * data)
+{
+    LV_ASSERT_NULL(circle_buf);
+    LV_ASSERT_NULL(data);
+    if(circle_buf->size == circle_buf->capacity) return LV_RESULT_INVALID;
+
+    lv_memcpy(slot(circle_buf, circle_buf->size), data, circle_buf->element_size);
+    circle_buf->size++;
+    return LV_RESULT_OK;
+}
+
+uint32_t lv_circle_buf_fill(lv_circle_buf_t * circle_buf, uint32_t count, lv_circle_buf_fill_cb_t fill_cb,
+                            void * user_data)
+{
+    LV_ASSERT_NULL(circle_buf);
+    LV_ASSERT_NULL(fill_cb);
+
+    uint32_t filled = 0;
+    while(filled < count && circle_buf->size < circle_buf->capacity) {
+        if(!fill_cb(slot(circle_buf, circle_buf->size), circle_buf->element_size, (int32_t)filled, user_data)) break;
+        circle_buf->size++;
+        filled++;
+    }
+
+    return filled;
+}
+
+lv_result_t lv_circle_buf_skip(lv_circle_buf_t * circle_buf)
+{
+    LV_ASSERT_NULL(circle_buf);
+    if(circle_buf->size == 0) return LV_RESULT_INVALID;
+
+    circle_buf->head++;
+    if(circle_buf->head == circle_buf->capacity) circle_buf->head = 0;
+    circle_buf->size--;
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_circle_buf_peek(const lv_circle_buf_t * circle_buf, void * data)
+{
+    return lv_circle_buf_peek_at(circle_buf, 0, data);
+}
+
+lv_result_t lv_circle_buf_peek_at(const lv_circle_buf_t * circle_buf, uint32_t index, void * data)
+{
+    LV_ASSERT_NULL(circle_buf);
+    LV_ASSERT_NULL(data);
+    if(index >= circle_buf->size) return LV_RESULT_INVALID;
+
+    lv_memcpy(data, slot(circle_buf, index), circle_buf->element_size);
+    return LV_RESULT_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Address of the `index`th element counted from the oldest one, `index` may point past the last element
+ */
+static inline uint8_t * slot(const lv_circle_buf_t * circle_buf, uint32_t index)
+{
+    uint32_t i = circle_buf->head + index;
+    if(i >= circle_buf->capacity) i -= circle_buf->capacity;
+    return circle_buf->data + (size_t)i * circle_buf->element_size;
+}
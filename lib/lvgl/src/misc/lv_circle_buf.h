@@ -0,0 +1,164 @@
+/**
+ * @file lv_circle_buf.h
+ * Circular buffer of fixed size elements. The storage is allocated by the 'lv_mem' module.
+ */
+
+#ifndef LV_CIRCLE_BUF_H
+#define LV_CIRCLE_BUF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_types.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Called by `lv_circle_buf_fill` to produce the next element
+ * @param buf       where the element should be written
+ * @param buf_len   size of the element in bytes
+ * @param index     index of the element among the ones requested by this fill
+ * @param user_data custom data passed to `lv_circle_buf_fill`
+ * @return          true if an element was written, false to stop filling
+ */
+typedef bool (*lv_circle_buf_fill_cb_t)(void * buf, uint32_t buf_len, int32_t index, void * user_data);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a circular buffer
+ * @param capacity      the maximum number of elements in the buffer
+ * @param element_size  the size of an element in bytes
+ * @return              pointer to the created buffer or NULL if the allocation failed
+ */
+lv_circle_buf_t * lv_circle_buf_create(uint32_t capacity, uint32_t element_size);
+
+/**
+ * Create a circular buffer on a user provided storage. The storage is not freed by `lv_circle_buf_destroy`.
+ * @param buf           storage for at least `capacity` elements
+ * @param capacity      the maximum number of elements in the buffer
+ * @param element_size  the size of an element in bytes
+ * @return              pointer to the created buffer or NULL if the allocation failed
+ */
+lv_circle_buf_t * lv_circle_buf_create_from_buf(void * buf, uint32_t capacity, uint32_t element_size);
+
+/**
+ * Delete a circular buffer
+ * @param circle_buf    pointer to a buffer
+ */
+void lv_circle_buf_destroy(lv_circle_buf_t * circle_buf);
+
+/**
+ * Get the number of elements in the buffer
+ * @param circle_buf    pointer to a buffer
+ * @return              the number of elements
+ */
+uint32_t lv_circle_buf_size(const lv_circle_buf_t * circle_buf);
+
+/**
+ * Get the maximum number of elements in the buffer
+ * @param circle_buf    pointer to a buffer
+ * @return              the capacity
+ */
+uint32_t lv_circle_buf_capacity(const lv_circle_buf_t * circle_buf);
+
+/**
+ * Get how many elements can still be written
+ * @param circle_buf    pointer to a buffer
+ * @return              the number of free slots
+ */
+uint32_t lv_circle_buf_remain(const lv_circle_buf_t * circle_buf);
+
+/**
+ * Check whether the buffer has no elements
+ * @param circle_buf    pointer to a buffer
+ * @return              true: empty
+ */
+bool lv_circle_buf_is_empty(const lv_circle_buf_t * circle_buf);
+
+/**
+ * Check whether the buffer can't take more elements
+ * @param circle_buf    pointer to a buffer
+ * @return              true: full
+ */
+bool lv_circle_buf_is_full(const lv_circle_buf_t * circle_buf);
+
+/**
+ * Remove every element
+ * @param circle_buf    pointer to a buffer
+ */
+void lv_circle_buf_reset(lv_circle_buf_t * circle_buf);
+
+/**
+ * Copy the oldest element out and remove it
+ * @param circle_buf    pointer to a buffer
+ * @param data          where the element should be copied, can be NULL
+ * @return              LV_RESULT_OK: an element was read; LV_RESULT_INVALID: the buffer is empty
+ */
+lv_result_t lv_circle_buf_read(lv_circle_buf_t * circle_buf, void * data);
+
+/**
+ * Append an element
+ * @param circle_buf    pointer to a buffer
+ * @param data          the element to copy in
+ * @return              LV_RESULT_OK: the element was written; LV_RESULT_INVALID: the buffer is full
+ */
+lv_result_t lv_circle_buf_write(lv_circle_buf_t * circle_buf, const void * data);
+
+/**
+ * Append up to `count` elements produced by a callback, stops when the buffer is full or the callback fails
+ * @param circle_buf    pointer to a buffer
+ * @param count         number of elements to append
+ * @param fill_cb       writes an element into the buffer
+ * @param user_data     custom data passed to `fill_cb`
+ * @return              the number of elements appended
+ */
+uint32_t lv_circle_buf_fill(lv_circle_buf_t * circle_buf, uint32_t count, lv_circle_buf_fill_cb_t fill_cb,
+                            void * user_data);
+
+/**
+ * Remove the oldest element without copying it
+ * @param circle_buf    pointer to a buffer
+ * @return              LV_RESULT_OK: an element was removed; LV_RESULT_INVALID: the buffer is empty
+ */
+lv_result_t lv_circle_buf_skip(lv_circle_buf_t * circle_buf);
+
+/**
+ * Copy the oldest element out without removing it
+ * @param circle_buf    pointer to a buffer
+ * @param data          where the element should be copied
+ * @return              LV_RESULT_OK: an element was copied; LV_RESULT_INVALID: the buffer is empty
+ */
+lv_result_t lv_circle_buf_peek(const lv_circle_buf_t * circle_buf, void * data);
+
+/**
+ * Copy the element at `index` (0 is the oldest) out without removing it
+ * @param circle_buf    pointer to a buffer
+ * @param index         index of the element
+ * @param data          where the element should be copied
+ * @return              LV_RESULT_OK: an element was copied; LV_RESULT_INVALID: `index` is out of range
+ */
+lv_result_t lv_circle_buf_peek_at(const lv_circle_buf_t * circle_buf, uint32_t index, void * data);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_CIRCLE_BUF_H*/
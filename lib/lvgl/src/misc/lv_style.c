@@ -191,7 +191,7 @@ void lv_style_reset(lv_style_t * style)
 {
     LV_ASSERT_STYLE(style);
 
-    if(style->prop_cnt != 255) lv_free(style->values_and_props);
+    if(!lv_style_is_const(style)) lv_free(style->values_and_props);
     lv_memzero(style, sizeof(lv_style_t));
 #if LV_USE_ASSERT_STYLE
     style->sentinel = LV_STYLE_SENTINEL_VALUE;
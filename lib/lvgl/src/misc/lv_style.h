@@ -64,6 +64,30 @@ LV_EXPORT_CONST_INT(LV_SCALE_NONE);
         .prop_cnt = 255,                                                \
     }
 #endif
+
+/**
+ * Like `LV_STYLE_CONST_INIT` but `prop_array` is sorted by property ID and `groups` tells
+ * which property groups are used (see `lv_style_get_prop_group`), so the properties are
+ * searched with binary search and the style is skipped for properties of other groups.
+ * `prop_array` needs to be padded with `LV_STYLE_CONST_PROPS_END` to a power of 2 length.
+ * Usually generated from a style sheet by `scripts/style_sheet_gen.py`.
+ */
+#if LV_USE_ASSERT_STYLE
+#define LV_STYLE_CONST_INIT_SORTED(var_name, prop_array, groups)        \
+    const lv_style_t var_name = {                                       \
+        .sentinel = LV_STYLE_SENTINEL_VALUE,                            \
+        .values_and_props = (void*)prop_array,                          \
+        .has_group = groups,                                            \
+        .prop_cnt = 254                                                 \
+    }
+#else
+#define LV_STYLE_CONST_INIT_SORTED(var_name, prop_array, groups)        \
+    const lv_style_t var_name = {                                       \
+        .values_and_props = (void*)prop_array,                          \
+        .has_group = groups,                                            \
+        .prop_cnt = 254,                                                \
+    }
+#endif
 // *INDENT-ON*
 
 #define LV_STYLE_CONST_PROPS_END { .prop = LV_STYLE_PROP_INV, .value = { .num = 0 } }
@@ -376,7 +400,7 @@ typedef struct {
     void * values_and_props;
 
     uint32_t has_group;
-    uint8_t prop_cnt;   /**< 255 means it's a constant style*/
+    uint8_t prop_cnt;   /**< 255 means it's a constant style, 254 a constant style with sorted properties*/
 } lv_style_t;
 
 /**********************
@@ -405,7 +429,7 @@ void lv_style_reset(lv_style_t * style);
  */
 static inline bool lv_style_is_const(const lv_style_t * style)
 {
-    if(style->prop_cnt == 255) return true;
+    if(style->prop_cnt >= 254) return true;
     return false;
 }
 
@@ -500,7 +524,30 @@ lv_style_value_t lv_style_prop_get_default(lv_style_prop_t prop);
 static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style, lv_style_prop_t prop,
                                                        lv_style_value_t * value)
 {
-    if(lv_style_is_const(style)) {
+    if(style->prop_cnt == 254) {
+        /*Sorted constant style. The length is unknown, so first find an upper bound by doubling the index.
+         *The array is padded to a power of 2 length, so the probes can't go past its end.*/
+        lv_style_const_prop_t * props = (lv_style_const_prop_t *)style->values_and_props;
+        uint32_t min = 0;
+        uint32_t max = 1;
+        while(props[max - 1].prop != LV_STYLE_PROP_INV && props[max - 1].prop < prop) {
+            min = max;
+            max <<= 1;
+        }
+
+        /*Binary search in [min, max). LV_STYLE_PROP_INV (the end) is handled as larger than every property*/
+        while(min < max) {
+            uint32_t mid = (min + max) >> 1;
+            lv_style_prop_t p = props[mid].prop;
+            if(p == prop) {
+                *value = props[mid].value;
+                return LV_STYLE_RES_FOUND;
+            }
+            if(p != LV_STYLE_PROP_INV && p < prop) min = mid + 1;
+            else max = mid;
+        }
+    }
+    else if(lv_style_is_const(style)) {
         lv_style_const_prop_t * props = (lv_style_const_prop_t *)style->values_and_props;
         uint32_t i;
         for(i = 0; props[i].prop != LV_STYLE_PROP_INV; i++) {
@@ -14,19 +14,50 @@
 #include "../stdlib/lv_mem.h"
 #include "../stdlib/lv_string.h"
 #include "../misc/lv_types.h"
+#include "../core/lv_global.h"
+#include "cache/lv_cache.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define NO_BREAK_FOUND UINT32_MAX
 
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    #define layout_cache_p LV_GLOBAL_DEFAULT()->text_layout_cache
+    #define layout_clock_cb LV_GLOBAL_DEFAULT()->text_layout_clock_cb
+    #define layout_saved LV_GLOBAL_DEFAULT()->text_layout_saved
+    #define LAYOUT_LINES_MAX 32     /**< Longer texts are cached only with their size*/
+    #define CACHE_NAME "TEXT_LAYOUT"
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+typedef struct {
+    lv_cache_slot_size_t slot;
+    uint64_t hash;                  /**< Hash of the text's content*/
+    uint32_t len;
+    const lv_font_t * font;
+    int32_t letter_space;
+    int32_t line_space;
+    int32_t max_width;
+    lv_text_flag_t flag;
+    uint32_t cost;                  /**< Time taken to lay out the text*/
+    lv_text_layout_t layout;
+} text_layout_data_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void measure_text(lv_point_t * size_res, const char * text, const lv_font_t * font, int32_t letter_space,
+                         int32_t line_space, int32_t max_width, lv_text_flag_t flag,
+                         uint32_t * line_starts, uint32_t * line_cnt);
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    static void layout_free_cb(text_layout_data_t * node, void * user_data);
+    static lv_cache_compare_res_t layout_compare_cb(const text_layout_data_t * lhs, const text_layout_data_t * rhs);
+#endif
 
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
     static uint8_t lv_text_utf8_size(const char * str);
@@ -100,40 +131,158 @@ void lv_text_get_size(lv_point_t * size_res, const char * text, const lv_font_t
 
     if(flag & LV_TEXT_FLAG_EXPAND) max_width = LV_COORD_MAX;
 
-    uint32_t line_start     = 0;
-    uint32_t new_line_start = 0;
-    uint16_t letter_height = lv_font_get_line_height(font);
+    const lv_text_layout_t * layout = lv_text_layout_acquire(text, font, letter_space, line_space, max_width, flag);
+    if(layout) {
+        *size_res = layout->size;
+        lv_text_layout_release(layout);
+        return;
+    }
 
-    /*Calc. the height and longest line*/
-    while(text[line_start] != '\0') {
-        new_line_start += lv_text_get_next_line(&text[line_start], LV_TEXT_LEN_MAX, font, letter_space, max_width, NULL, flag);
+    measure_text(size_res, text, font, letter_space, line_space, max_width, flag, NULL, NULL);
+}
 
-        if((unsigned long)size_res->y + (unsigned long)letter_height + (unsigned long)line_space > LV_MAX_OF(int32_t)) {
-            LV_LOG_WARN("integer overflow while calculating text height");
-            return;
-        }
-        else {
-            size_res->y += letter_height;
-            size_res->y += line_space;
-        }
+const lv_text_layout_t * lv_text_layout_acquire(const char * text, const lv_font_t * font, int32_t letter_space,
+                                                int32_t line_space, int32_t max_width, lv_text_flag_t flag)
+{
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    if(layout_cache_p == NULL || text == NULL || font == NULL) return NULL;
+
+    /*The width doesn't matter for these, so all widths can share one layout*/
+    if(flag & (LV_TEXT_FLAG_EXPAND | LV_TEXT_FLAG_FIT)) max_width = LV_COORD_MAX;
+
+    /*FNV-1a. Hashing is much cheaper than looking up and measuring every glyph again*/
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    uint32_t len;
+    for(len = 0; text[len] != '\0'; len++) {
+        hash ^= (uint8_t)text[len];
+        hash *= 0x100000001b3ULL;
+    }
 
-        /*Calculate the longest line*/
-        int32_t act_line_length = lv_text_get_width(&text[line_start], new_line_start - line_start, font, letter_space);
+    text_layout_data_t search_key = {
+        .hash = hash,
+        .len = len,
+        .font = font,
+        .letter_space = letter_space,
+        .line_space = line_space,
+        .max_width = max_width,
+        .flag = flag,
+    };
+
+    lv_cache_entry_t * entry = lv_cache_acquire(layout_cache_p, &search_key, NULL);
+    if(entry) {
+        text_layout_data_t * data = lv_cache_entry_get_data(entry);
+        layout_saved += data->cost;
+        return &data->layout;
+    }
 
-        size_res->x = LV_MAX(act_line_length, size_res->x);
-        line_start  = new_line_start;
+    uint32_t line_starts[LAYOUT_LINES_MAX + 1];
+    uint32_t line_cnt;
+    uint32_t t_start = layout_clock_cb ? layout_clock_cb() : 0;
+    measure_text(&search_key.layout.size, text, font, letter_space, line_space, max_width, flag, line_starts, &line_cnt);
+    search_key.cost = layout_clock_cb ? layout_clock_cb() - t_start : 0;
+
+    /*Broken measurement (overflow), don't keep it*/
+    if(line_cnt == UINT32_MAX) return NULL;
+
+    uint32_t * lines = NULL;
+    if(line_cnt <= LAYOUT_LINES_MAX) {
+        lines = lv_malloc((line_cnt + 1) * sizeof(uint32_t));
+        if(lines) lv_memcpy(lines, line_starts, (line_cnt + 1) * sizeof(uint32_t));
     }
+    search_key.layout.line_cnt = line_cnt;
+    search_key.layout.line_starts = lines;
+    search_key.slot.size = sizeof(text_layout_data_t) + (lines ? (line_cnt + 1) * sizeof(uint32_t) : 0);
+
+    /*The cache owns the line starts from now on*/
+    entry = lv_cache_add(layout_cache_p, &search_key, NULL);
+    if(entry == NULL) {
+        lv_free(lines);
+        return NULL;
+    }
+    return &((text_layout_data_t *)lv_cache_entry_get_data(entry))->layout;
+#else
+    LV_UNUSED(text);
+    LV_UNUSED(font);
+    LV_UNUSED(letter_space);
+    LV_UNUSED(line_space);
+    LV_UNUSED(max_width);
+    LV_UNUSED(flag);
+    return NULL;
+#endif
+}
 
-    /*Make the text one line taller if the last character is '\n' or '\r'*/
-    if((line_start != 0) && (text[line_start - 1] == '\n' || text[line_start - 1] == '\r')) {
-        size_res->y += letter_height + line_space;
+void lv_text_layout_release(const lv_text_layout_t * layout)
+{
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    text_layout_data_t * data = (text_layout_data_t *)((uint8_t *)layout - offsetof(text_layout_data_t, layout));
+    lv_cache_release(layout_cache_p, lv_cache_entry_get_entry(data, sizeof(text_layout_data_t)), NULL);
+#else
+    LV_UNUSED(layout);
+#endif
+}
+
+void lv_text_layout_cache_init(uint32_t size)
+{
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    if(layout_cache_p != NULL || size == 0) return;
+
+    layout_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(text_layout_data_t), size, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t)layout_compare_cb,
+        .create_cb = NULL,
+        .free_cb = (lv_cache_free_cb_t)layout_free_cb,
+    });
+    lv_cache_set_name(layout_cache_p, CACHE_NAME);
+    layout_saved = 0;
+#else
+    LV_UNUSED(size);
+#endif
+}
+
+void lv_text_layout_cache_deinit(void)
+{
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    if(layout_cache_p) {
+        lv_cache_destroy(layout_cache_p, NULL);
+        layout_cache_p = NULL;
     }
+#endif
+}
 
-    /*Correction with the last line space or set the height manually if the text is empty*/
-    if(size_res->y == 0)
-        size_res->y = letter_height;
-    else
-        size_res->y -= line_space;
+void lv_text_layout_cache_drop(const lv_font_t * font)
+{
+    LV_UNUSED(font);
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    if(layout_cache_p) lv_cache_drop_all(layout_cache_p, NULL);
+#endif
+}
+
+void lv_text_layout_cache_get_stats(lv_cache_stats_t * stats)
+{
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    if(layout_cache_p) {
+        lv_cache_get_stats(layout_cache_p, stats);
+        return;
+    }
+#endif
+    lv_memzero(stats, sizeof(lv_cache_stats_t));
+}
+
+uint64_t lv_text_layout_cache_get_saved_cycles(void)
+{
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    return layout_saved;
+#else
+    return 0;
+#endif
+}
+
+void lv_text_layout_cache_set_clock_cb(uint32_t (*clock_cb)(void))
+{
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    layout_clock_cb = clock_cb;
+#else
+    LV_UNUSED(clock_cb);
+#endif
 }
 
 bool lv_text_is_cmd(lv_text_cmd_state_t * state, uint32_t c)
@@ -541,6 +690,92 @@ void lv_text_encoded_letter_next_2(const char * txt, uint32_t * letter, uint32_t
     *letter_next = *letter != '\0' ? lv_text_encoded_next(&txt[*ofs], NULL) : 0;
 }
 
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Measure a text as `lv_text_get_size` does
+ * @param line_starts   if not NULL the byte offset of the first lines and the end are saved here
+ *                      (LAYOUT_LINES_MAX + 1 items)
+ * @param line_cnt      if not NULL the number of lines is saved here, UINT32_MAX if the height overflowed
+ */
+static void measure_text(lv_point_t * size_res, const char * text, const lv_font_t * font, int32_t letter_space,
+                         int32_t line_space, int32_t max_width, lv_text_flag_t flag,
+                         uint32_t * line_starts, uint32_t * line_cnt)
+{
+    size_res->x = 0;
+    size_res->y = 0;
+
+    uint32_t line_start     = 0;
+    uint32_t new_line_start = 0;
+    uint32_t line_id = 0;
+    uint16_t letter_height = lv_font_get_line_height(font);
+
+    /*Calc. the height and longest line*/
+    while(text[line_start] != '\0') {
+        new_line_start += lv_text_get_next_line(&text[line_start], LV_TEXT_LEN_MAX, font, letter_space, max_width, NULL, flag);
+
+        if((unsigned long)size_res->y + (unsigned long)letter_height + (unsigned long)line_space > LV_MAX_OF(int32_t)) {
+            LV_LOG_WARN("integer overflow while calculating text height");
+            if(line_cnt) *line_cnt = UINT32_MAX;
+            return;
+        }
+        else {
+            size_res->y += letter_height;
+            size_res->y += line_space;
+        }
+
+        /*Calculate the longest line*/
+        int32_t act_line_length = lv_text_get_width(&text[line_start], new_line_start - line_start, font, letter_space);
+
+        size_res->x = LV_MAX(act_line_length, size_res->x);
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+        if(line_starts && line_id < LAYOUT_LINES_MAX) line_starts[line_id] = line_start;
+#endif
+        line_id++;
+        line_start  = new_line_start;
+    }
+
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+    if(line_starts && line_id <= LAYOUT_LINES_MAX) line_starts[line_id] = line_start;
+#else
+    LV_UNUSED(line_starts);
+#endif
+    if(line_cnt) *line_cnt = line_id;
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    if((line_start != 0) && (text[line_start - 1] == '\n' || text[line_start - 1] == '\r')) {
+        size_res->y += letter_height + line_space;
+    }
+
+    /*Correction with the last line space or set the height manually if the text is empty*/
+    if(size_res->y == 0)
+        size_res->y = letter_height;
+    else
+        size_res->y -= line_space;
+}
+
+#if LV_TEXT_LAYOUT_CACHE_SIZE
+static void layout_free_cb(text_layout_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+    lv_free((void *)node->layout.line_starts);
+}
+
+static lv_cache_compare_res_t layout_compare_cb(const text_layout_data_t * lhs, const text_layout_data_t * rhs)
+{
+    if(lhs->hash != rhs->hash) return lhs->hash > rhs->hash ? 1 : -1;
+    if(lhs->len != rhs->len) return lhs->len > rhs->len ? 1 : -1;
+    if(lhs->font != rhs->font) return lhs->font > rhs->font ? 1 : -1;
+    if(lhs->max_width != rhs->max_width) return lhs->max_width > rhs->max_width ? 1 : -1;
+    if(lhs->letter_space != rhs->letter_space) return lhs->letter_space > rhs->letter_space ? 1 : -1;
+    if(lhs->line_space != rhs->line_space) return lhs->line_space > rhs->line_space ? 1 : -1;
+    if(lhs->flag != rhs->flag) return lhs->flag > rhs->flag ? 1 : -1;
+    return 0;
+}
+#endif /*LV_TEXT_LAYOUT_CACHE_SIZE*/
+
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
 /*******************************
  *   UTF-8 ENCODER/DECODER
@@ -96,6 +96,32 @@ void lv_text_get_size(lv_point_t * size_res, const char * text, const lv_font_t
  */
 int32_t lv_text_get_width(const char * txt, uint32_t length, const lv_font_t * font, int32_t letter_space);
 
+/**
+ * Drop the cached text layouts. Call it before freeing a font whose layouts might be cached.
+ * @param font      the font whose layouts to drop or NULL for all. The layouts can't be searched by font
+ *                  so all of them are dropped either way
+ */
+void lv_text_layout_cache_drop(const lv_font_t * font);
+
+/**
+ * Get the hit, miss and eviction counters of the text layout cache
+ * @param stats     the counters are written here, all zero if the cache is disabled
+ */
+void lv_text_layout_cache_get_stats(lv_cache_stats_t * stats);
+
+/**
+ * Get the time the text layout cache saved: the sum of the measured layout time of every hit
+ * @return          the saved time in the units of the clock set by `lv_text_layout_cache_set_clock_cb`
+ */
+uint64_t lv_text_layout_cache_get_saved_cycles(void);
+
+/**
+ * Set the clock used to measure how long laying out a text takes, e.g. a CPU cycle counter.
+ * Without a clock the saved time isn't counted.
+ * @param clock_cb  a function returning a free running counter or NULL
+ */
+void lv_text_layout_cache_set_clock_cb(uint32_t (*clock_cb)(void));
+
 /**
  * Give the length of a text with a given font with text flags
  * @param txt a '\0' terminate string
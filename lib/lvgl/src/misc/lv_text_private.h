@@ -24,6 +24,14 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/** The measured layout of a text, kept in the text layout cache*/
+typedef struct {
+    lv_point_t size;                /**< The same as `lv_text_get_size` returns*/
+    uint32_t line_cnt;
+    const uint32_t * line_starts;   /**< Byte offset of every line and the end of the text (`line_cnt + 1` items).
+                                     *   NULL if the text has too many lines to keep them*/
+} lv_text_layout_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -45,6 +53,31 @@ extern "C" {
 uint32_t lv_text_get_next_line(const char * txt, uint32_t len, const lv_font_t * font, int32_t letter_space,
                                int32_t max_width, int32_t * used_width, lv_text_flag_t flag);
 
+/**
+ * Get the layout of a text from the text layout cache, laying it out if it's not there yet.
+ * The parameters are the same as of `lv_text_get_size`.
+ * @return the layout, release it with `lv_text_layout_release`. NULL if the cache is disabled or full
+ */
+const lv_text_layout_t * lv_text_layout_acquire(const char * text, const lv_font_t * font, int32_t letter_space,
+                                                int32_t line_space, int32_t max_width, lv_text_flag_t flag);
+
+/**
+ * Release a layout got from `lv_text_layout_acquire`
+ * @param layout pointer to the layout
+ */
+void lv_text_layout_release(const lv_text_layout_t * layout);
+
+/**
+ * Create the text layout cache
+ * @param size size of the cache in bytes, 0 to not cache
+ */
+void lv_text_layout_cache_init(uint32_t size);
+
+/**
+ * Destroy the text layout cache
+ */
+void lv_text_layout_cache_deinit(void);
+
 /**
  * Insert a string into another
  * @param txt_buf the original text (must be big enough for the result text and NULL terminated)
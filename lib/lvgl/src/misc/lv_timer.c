@@ -20,6 +20,10 @@
 
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
+#define HEAP_MIN_CAP 8
+/*Deadlines are compared with a wrapping difference, so keep them within half of the tick range.
+ *Timers with a longer period are checked again when the first part of it has passed.*/
+#define MAX_DELAY 0x3FFFFFFF /*[ms]*/
 
 #define state LV_GLOBAL_DEFAULT()->timer_state
 #define timer_ll_p &(state.timer_ll)
@@ -31,9 +35,18 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool lv_timer_exec(lv_timer_t * timer);
+static void lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
 static void lv_timer_handler_resume(void);
+static void timer_update_deadline(lv_timer_t * timer);
+static inline bool timer_before(const lv_timer_t * a, const lv_timer_t * b);
+static void timer_schedule(lv_timer_t * timer);
+static void timer_unschedule(lv_timer_t * timer);
+static lv_timer_t * heap_pop(void);
+static void heap_restore(void);
+static void heap_sift_up(uint32_t i);
+static void heap_sift_down(uint32_t i);
+static uint32_t heap_time_until_next(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -90,43 +103,25 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    lv_timer_t * timer_active;
-    lv_ll_t * timer_head = timer_ll_p;
-    do {
-        state_p->timer_deleted             = false;
-        state_p->timer_created             = false;
-
-        timer_active = lv_ll_get_head(timer_head);
-        while(timer_active) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = lv_ll_get_next(timer_head, timer_active);
-
-            if(lv_timer_exec(timer_active)) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(state_p->timer_created || state_p->timer_deleted) {
-                    LV_TRACE_TIMER("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
-
-            timer_active = next; /*Load the next timer*/
-        }
-    } while(timer_active);
-
-    uint32_t time_until_next = LV_NO_TIMER_READY;
-    next = lv_ll_get_head(timer_head);
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_until_next)
-                time_until_next = delay;
+    /*Run the due timers, the earliest deadline first. The ones which ran are kept out of the heap
+     *until the end, so every timer runs at most once per call even if its period is shorter than the call.
+     *Timers created, deleted, paused or resumed by the callbacks are (un)scheduled right away.*/
+    while(state_p->timer_heap_cnt) {
+        lv_timer_t * timer = state_p->timer_heap[0];
+        if((int32_t)(timer->deadline - lv_tick_get()) > 0) break;
+
+        if(lv_timer_time_remaining(timer) != 0) {
+            /*Only the first part of a very long period has passed*/
+            timer_update_deadline(timer);
+            continue;
         }
 
-        next = lv_ll_get_next(timer_head, next); /*Find the next timer*/
+        heap_pop();
+        lv_timer_exec(timer);
     }
+    heap_restore();
+
+    uint32_t time_until_next = heap_time_until_next();
 
     state_p->busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(state_p->idle_period_start);
@@ -166,6 +161,16 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
+    /*Make sure the timer can be scheduled whenever it is resumed*/
+    if(state.timer_cnt >= state.timer_heap_cap) {
+        uint32_t new_cap = state.timer_heap_cap ? state.timer_heap_cap * 2 : HEAP_MIN_CAP;
+        lv_timer_t ** new_heap = lv_realloc(state.timer_heap, new_cap * sizeof(lv_timer_t *));
+        LV_ASSERT_MALLOC(new_heap);
+        if(new_heap == NULL) return NULL;
+        state.timer_heap = new_heap;
+        state.timer_heap_cap = new_cap;
+    }
+
     new_timer = lv_ll_ins_head(timer_ll_p);
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
@@ -177,8 +182,12 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
     new_timer->auto_delete = true;
+    new_timer->heap_index = LV_TIMER_NOT_SCHEDULED;
+    new_timer->order = state.timer_order_next++;
 
-    state.timer_created = true;
+    state.timer_cnt++;
+    timer_update_deadline(new_timer);
+    timer_schedule(new_timer);
 
     lv_timer_handler_resume();
 
@@ -194,6 +203,8 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
 void lv_timer_delete(lv_timer_t * timer)
 {
     lv_ll_remove(timer_ll_p, timer);
+    timer_unschedule(timer);
+    state.timer_cnt--;
     state.timer_deleted = true;
 
     lv_free(timer);
@@ -203,12 +214,17 @@ void lv_timer_pause(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = true;
+    timer_unschedule(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
-    timer->paused = false;
+    if(timer->paused) {
+        timer->paused = false;
+        timer_update_deadline(timer);
+        timer_schedule(timer);
+    }
     lv_timer_handler_resume();
 }
 
@@ -216,12 +232,14 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     LV_ASSERT_NULL(timer);
     timer->period = period;
+    timer_update_deadline(timer);
 }
 
 void lv_timer_ready(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get() - timer->period - 1;
+    timer_update_deadline(timer);
 }
 
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
@@ -246,6 +264,7 @@ void lv_timer_reset(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get();
+    timer_update_deadline(timer);
     lv_timer_handler_resume();
 }
 
@@ -260,6 +279,13 @@ void lv_timer_core_deinit(void)
     lv_timer_enable(false);
 
     lv_ll_clear(timer_ll_p);
+
+    lv_free(state.timer_heap);
+    state.timer_heap = NULL;
+    state.timer_heap_cnt = 0;
+    state.timer_sched_cnt = 0;
+    state.timer_heap_cap = 0;
+    state.timer_cnt = 0;
 }
 
 uint32_t lv_timer_get_idle(void)
@@ -269,7 +295,7 @@ uint32_t lv_timer_get_idle(void)
 
 uint32_t lv_timer_get_time_until_next(void)
 {
-    return state.timer_time_until_next;
+    return heap_time_until_next();
 }
 
 lv_timer_t * lv_timer_get_next(lv_timer_t * timer)
@@ -304,41 +330,37 @@ bool lv_timer_get_paused(lv_timer_t * timer)
  **********************/
 
 /**
- * Execute timer if its remaining time is zero
+ * Execute a due timer
  * @param timer pointer to lv_timer
- * @return true: execute, false: not executed
  */
-static bool lv_timer_exec(lv_timer_t * timer)
-{
-    if(timer->paused) return false;
-
-    bool exec = false;
-    if(lv_timer_time_remaining(timer) == 0) {
-        /* Decrement the repeat count before executing the timer_cb.
-         * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
-         * but at least the repeat count is zero and the timer can be deleted in the next round*/
-        int32_t original_repeat_count = timer->repeat_count;
-        if(timer->repeat_count > 0) timer->repeat_count--;
-        timer->last_run = lv_tick_get();
-        LV_TRACE_TIMER("calling timer callback: %p", *((void **)&timer->timer_cb));
-
-        if(timer->timer_cb && original_repeat_count != 0) {
-            LV_PROFILER_TIMER_BEGIN_TAG("timer_cb");
-            timer->timer_cb(timer);
-            LV_PROFILER_TIMER_END_TAG("timer_cb");
-        }
+static void lv_timer_exec(lv_timer_t * timer)
+{
+    state.timer_deleted = false;
 
-        if(!state.timer_deleted) {
-            LV_TRACE_TIMER("timer callback %p finished", *((void **)&timer->timer_cb));
-        }
-        else {
-            LV_TRACE_TIMER("timer callback finished");
-        }
+    /* Decrement the repeat count before executing the timer_cb.
+     * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
+     * but at least the repeat count is zero and the timer can be deleted in the next round*/
+    int32_t original_repeat_count = timer->repeat_count;
+    if(timer->repeat_count > 0) timer->repeat_count--;
+    timer->last_run = lv_tick_get();
+    timer_update_deadline(timer);
+    LV_TRACE_TIMER("calling timer callback: %p", *((void **)&timer->timer_cb));
 
-        LV_ASSERT_MEM_INTEGRITY();
-        exec = true;
+    if(timer->timer_cb && original_repeat_count != 0) {
+        LV_PROFILER_TIMER_BEGIN_TAG("timer_cb");
+        timer->timer_cb(timer);
+        LV_PROFILER_TIMER_END_TAG("timer_cb");
+    }
+
+    if(!state.timer_deleted) {
+        LV_TRACE_TIMER("timer callback %p finished", *((void **)&timer->timer_cb));
+    }
+    else {
+        LV_TRACE_TIMER("timer callback finished");
     }
 
+    LV_ASSERT_MEM_INTEGRITY();
+
     if(state.timer_deleted == false) { /*The timer might be deleted by itself as well*/
         if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
             if(timer->auto_delete) {
@@ -351,8 +373,6 @@ static bool lv_timer_exec(lv_timer_t * timer)
             }
         }
     }
-
-    return exec;
 }
 
 /**
@@ -381,6 +401,175 @@ static void lv_timer_handler_resume(void)
     }
 }
 
+/**
+ * Set the deadline of a timer from its last run and period and restore the heap order
+ * @param timer pointer to lv_timer
+ */
+static void timer_update_deadline(lv_timer_t * timer)
+{
+    timer->deadline = lv_tick_get() + LV_MIN(lv_timer_time_remaining(timer), MAX_DELAY);
+
+    uint32_t i = timer->heap_index;
+    if(i >= state.timer_heap_cnt) return; /*Paused or already ran in this handler call*/
+
+    if(i > 0 && timer_before(timer, state.timer_heap[(i - 1) / 2])) heap_sift_up(i);
+    else heap_sift_down(i);
+}
+
+/**
+ * Order of the heap: the earlier deadline first. Timers due at the same tick run newest first, as they did
+ * from the list of timers, so the result of a call doesn't depend on where the heap happens to keep them.
+ * @param a     pointer to lv_timer
+ * @param b     pointer to lv_timer
+ * @return      true if `a` runs before `b`
+ */
+static inline bool timer_before(const lv_timer_t * a, const lv_timer_t * b)
+{
+    int32_t diff = (int32_t)(a->deadline - b->deadline);
+    if(diff != 0) return diff < 0;
+    return (int32_t)(a->order - b->order) > 0;
+}
+
+/**
+ * Add a timer to the heap. `timer_heap` has room for all the timers.
+ * @param timer pointer to a not scheduled lv_timer
+ */
+static void timer_schedule(lv_timer_t * timer)
+{
+    lv_timer_t ** heap = state.timer_heap;
+    uint32_t i = state.timer_heap_cnt;
+
+    /*Make room by moving the first timer which already ran to the end*/
+    if(state.timer_sched_cnt > i) {
+        heap[state.timer_sched_cnt] = heap[i];
+        heap[i]->heap_index = state.timer_sched_cnt;
+    }
+    state.timer_sched_cnt++;
+    state.timer_heap_cnt++;
+
+    heap[i] = timer;
+    heap_sift_up(i);
+}
+
+/**
+ * Remove a timer from the heap or from the timers which already ran
+ * @param timer pointer to lv_timer
+ */
+static void timer_unschedule(lv_timer_t * timer)
+{
+    uint32_t i = timer->heap_index;
+    if(i == LV_TIMER_NOT_SCHEDULED) return;
+    timer->heap_index = LV_TIMER_NOT_SCHEDULED;
+
+    lv_timer_t ** heap = state.timer_heap;
+    state.timer_sched_cnt--;
+    uint32_t last_sched = state.timer_sched_cnt;
+
+    if(i >= state.timer_heap_cnt) {
+        /*The order of the timers which already ran doesn't matter*/
+        if(i < last_sched) {
+            heap[i] = heap[last_sched];
+            heap[i]->heap_index = i;
+        }
+        return;
+    }
+
+    state.timer_heap_cnt--;
+    uint32_t last = state.timer_heap_cnt;
+    lv_timer_t * moved = heap[last];
+
+    /*Close the gap before the timers which already ran*/
+    if(last < last_sched) {
+        heap[last] = heap[last_sched];
+        heap[last]->heap_index = last;
+    }
+
+    if(i < last) {
+        heap[i] = moved;
+        if(i > 0 && timer_before(moved, heap[(i - 1) / 2])) heap_sift_up(i);
+        else heap_sift_down(i);
+    }
+}
+
+/**
+ * Move the earliest timer from the heap to the timers which already ran
+ * @return the earliest timer
+ */
+static lv_timer_t * heap_pop(void)
+{
+    lv_timer_t ** heap = state.timer_heap;
+    lv_timer_t * timer = heap[0];
+
+    state.timer_heap_cnt--;
+    uint32_t last = state.timer_heap_cnt;
+    if(last > 0) {
+        heap[0] = heap[last];
+        heap_sift_down(0);
+    }
+
+    heap[last] = timer;
+    timer->heap_index = last;
+    return timer;
+}
+
+/**
+ * Add the timers which already ran back to the heap
+ */
+static void heap_restore(void)
+{
+    while(state.timer_heap_cnt < state.timer_sched_cnt) {
+        state.timer_heap_cnt++;
+        heap_sift_up(state.timer_heap_cnt - 1);
+    }
+}
+
+static void heap_sift_up(uint32_t i)
+{
+    lv_timer_t ** heap = state.timer_heap;
+    lv_timer_t * timer = heap[i];
+    while(i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if(!timer_before(timer, heap[parent])) break;
+        heap[i] = heap[parent];
+        heap[i]->heap_index = i;
+        i = parent;
+    }
+
+    heap[i] = timer;
+    timer->heap_index = i;
+}
+
+static void heap_sift_down(uint32_t i)
+{
+    lv_timer_t ** heap = state.timer_heap;
+    uint32_t cnt = state.timer_heap_cnt;
+    lv_timer_t * timer = heap[i];
+    while(1) {
+        uint32_t child = i * 2 + 1;
+        if(child >= cnt) break;
+        if(child + 1 < cnt && timer_before(heap[child + 1], heap[child])) child++;
+        if(!timer_before(heap[child], timer)) break;
+        heap[i] = heap[child];
+        heap[i]->heap_index = i;
+        i = child;
+    }
+
+    heap[i] = timer;
+    timer->heap_index = i;
+}
+
+/**
+ * Get the time until the earliest deadline
+ * @return the time in ms, 0 if a timer is due, or `LV_NO_TIMER_READY` if there are no running timers
+ */
+static uint32_t heap_time_until_next(void)
+{
+    if(state.timer_heap_cnt == 0) return LV_NO_TIMER_READY;
+
+    int32_t diff = (int32_t)(state.timer_heap[0]->deadline - lv_tick_get());
+    return diff > 0 ? (uint32_t)diff : 0;
+}
+
 void lv_timer_handler_set_resume_cb(lv_timer_handler_resume_cb_t cb, void * data)
 {
     state.resume_cb = cb;
@@ -173,8 +173,9 @@ void lv_timer_enable(bool en);
 uint32_t lv_timer_get_idle(void);
 
 /**
- * Get the time remaining until the next timer will run
- * @return the time remaining in ms
+ * Get the time remaining until the next timer will run.
+ * It's taken from the earliest deadline at the time of the call, so it can be used to sleep until then.
+ * @return the time remaining in ms, or `LV_NO_TIMER_READY` if no timer is running
  */
 uint32_t lv_timer_get_time_until_next(void);
 
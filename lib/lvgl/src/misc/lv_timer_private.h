@@ -20,6 +20,8 @@ extern "C" {
  *      DEFINES
  *********************/
 
+#define LV_TIMER_NOT_SCHEDULED 0xFFFFFFFF
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -33,6 +35,9 @@ struct _lv_timer_t {
     lv_timer_cb_t timer_cb;    /**< Timer function */
     void * user_data;          /**< Custom user data */
     int32_t repeat_count;      /**< 1: One time;  -1 : infinity;  n>0: residual times */
+    uint32_t deadline;         /**< Tick when the timer is due, its key in the scheduler heap */
+    uint32_t heap_index;       /**< Position in `timer_heap`, or `LV_TIMER_NOT_SCHEDULED` while paused */
+    uint32_t order;            /**< Creation number, of timers due at the same tick the newer one runs first*/
     uint32_t paused : 1;
     uint32_t auto_delete : 1;
 };
@@ -40,10 +45,18 @@ struct _lv_timer_t {
 typedef struct {
     lv_ll_t timer_ll;          /**< Linked list to store the lv_timers */
 
+    /** The not paused timers: a min-heap by deadline in the first `timer_heap_cnt` slots,
+     *  followed by the ones which already ran in the current `lv_timer_handler` call */
+    lv_timer_t ** timer_heap;
+    uint32_t timer_heap_cnt;   /**< Number of timers in the heap part */
+    uint32_t timer_sched_cnt;  /**< Number of timers in `timer_heap` */
+    uint32_t timer_heap_cap;   /**< Allocated slots, at least the number of timers */
+    uint32_t timer_cnt;        /**< Number of timers, including the paused ones */
+    uint32_t timer_order_next; /**< `order` of the next created timer */
+
     bool lv_timer_run;
     uint8_t idle_last;
     bool timer_deleted;
-    bool timer_created;
     uint32_t timer_time_until_next;
 
     bool already_running;
@@ -125,6 +125,8 @@ typedef struct _lv_fragment_t lv_fragment_t;
 typedef struct _lv_fragment_class_t lv_fragment_class_t;
 typedef struct _lv_fragment_managed_states_t lv_fragment_managed_states_t;
 
+typedef struct _lv_page_cache_t lv_page_cache_t;
+
 typedef struct _lv_profiler_builtin_config_t lv_profiler_builtin_config_t;
 
 typedef struct _lv_rb_node_t lv_rb_node_t;
@@ -139,6 +141,8 @@ typedef struct _lv_cache_t lv_cache_t;
 
 typedef struct _lv_cache_entry_t lv_cache_entry_t;
 
+typedef struct _lv_cache_stats_t lv_cache_stats_t;
+
 typedef struct _lv_fs_file_cache_t lv_fs_file_cache_t;
 
 typedef struct _lv_fs_path_ex_t lv_fs_path_ex_t;
@@ -165,6 +169,8 @@ typedef struct _lv_obj_style_t lv_obj_style_t;
 
 typedef struct _lv_obj_style_transition_dsc_t lv_obj_style_transition_dsc_t;
 
+typedef struct _lv_obj_style_resolved_t lv_obj_style_resolved_t;
+
 typedef struct _lv_hit_test_info_t lv_hit_test_info_t;
 
 typedef struct _lv_cover_check_info_t lv_cover_check_info_t;
@@ -223,6 +229,8 @@ typedef struct _lv_menu_page_t lv_menu_page_t;
 
 typedef struct _lv_msgbox_t lv_msgbox_t;
 
+typedef struct _lv_numlabel_t lv_numlabel_t;
+
 typedef struct _lv_roller_t lv_roller_t;
 
 typedef struct _lv_scale_section_t lv_scale_section_t;
@@ -265,6 +273,8 @@ typedef struct _lv_barcode_t lv_barcode_t;
 
 typedef struct _lv_gif_t lv_gif_t;
 
+typedef struct _lv_sprite_anim_t lv_sprite_anim_t;
+
 typedef struct _lv_qrcode_t lv_qrcode_t;
 
 typedef struct _lv_freetype_outline_vector_t lv_freetype_outline_vector_t;
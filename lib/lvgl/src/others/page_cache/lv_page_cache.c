@@ -0,0 +1,829 @@
+/**
+ * @file lv_page_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_page_cache_private.h"
+#if LV_USE_PAGE_CACHE
+
+#include "../snapshot/lv_snapshot.h"
+#include "../../core/lv_obj_private.h"
+#include "../../core/lv_obj_draw_private.h"
+#include "../../misc/lv_area_private.h"
+#include "../../display/lv_display_private.h"
+#include "../../core/lv_refr_private.h"
+#include "../../draw/lv_draw_buf_private.h"
+#include "../../stdlib/lv_string.h"
+#include "../../tick/lv_tick.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define NONE                UINT32_MAX
+#define BLOB_FREE           0xFFFF
+
+/*A token of a row: a run of one color if the bit is set, else that many literal pixels follow*/
+#define TOKEN_RUN           0x8000
+#define TOKEN_MAX_CNT       0x7FFF
+#define MIN_RUN             3
+
+/*Missing bands of the pages which are not shown are rendered this often, this many at once*/
+#define PRERENDER_PERIOD    50
+#define PRERENDER_BANDS     4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Header of an encoded band in the buffer, followed by the tokens of its rows*/
+typedef struct {
+    uint32_t size;              /*Bytes with the header, a multiple of 4*/
+    uint16_t page;              /*Slot of the page or BLOB_FREE*/
+    uint16_t band;
+} blob_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_page_cache_page_t * get_page(lv_page_cache_t * cache, uint32_t idx);
+static uint32_t find_page(lv_page_cache_t * cache, const lv_obj_t * screen);
+static void free_page_bands(lv_page_cache_t * cache, uint32_t idx, uint32_t band_first, uint32_t band_last);
+static void free_blob(lv_page_cache_t * cache, uint32_t offset);
+static void compact(lv_page_cache_t * cache);
+static bool make_room(lv_page_cache_t * cache, uint32_t size, bool evict, uint32_t keep_idx);
+static uint32_t band_size_max(lv_page_cache_t * cache);
+static bool begin_band(lv_page_cache_t * cache, uint32_t idx, uint32_t band, bool evict);
+static void add_row(lv_page_cache_t * cache, const uint16_t * px);
+static void abort_band(lv_page_cache_t * cache);
+static uint32_t encode_row(const uint16_t * px, int32_t w, uint16_t * out);
+static const uint16_t * decode_row(const uint16_t * src, int32_t w, int32_t x1, int32_t x2, uint16_t * dest);
+static bool fills_display(lv_display_t * disp, lv_obj_t * screen);
+static bool overlay_on_rows(lv_display_t * disp, int32_t y1, int32_t y2);
+static bool band_needed(lv_page_cache_t * cache, uint32_t band);
+static lv_result_t render_band(lv_page_cache_t * cache, uint32_t idx, uint32_t band, lv_draw_buf_t * draw_buf,
+                               bool evict);
+static void capture_rows(lv_page_cache_t * cache, const lv_area_t * area);
+static void reset_pages(lv_page_cache_t * cache);
+static void prerender_timer_cb(lv_timer_t * t);
+static void display_event_cb(lv_event_t * e);
+static void screen_delete_event_cb(lv_event_t * e);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_page_cache_t * lv_page_cache_create(lv_display_t * disp, void * buf, uint32_t buf_size)
+{
+    LV_ASSERT_NULL(disp);
+    LV_ASSERT_NULL(buf);
+
+    if(disp->page_cache) {
+        LV_LOG_WARN("The display has a page cache already");
+        return NULL;
+    }
+
+    if(lv_display_get_color_format(disp) != LV_COLOR_FORMAT_RGB565) {
+        LV_LOG_WARN("Only RGB565 displays are supported");
+        return NULL;
+    }
+
+    lv_page_cache_t * cache = lv_malloc_zeroed(sizeof(lv_page_cache_t));
+    LV_ASSERT_MALLOC(cache);
+    if(cache == NULL) return NULL;
+
+    /*The blob headers are read as uint32_t*/
+    uintptr_t align = (4 - ((uintptr_t)buf & 3)) & 3;
+    cache->buf = (uint8_t *)buf + align;
+    cache->buf_size = buf_size > align ? (buf_size - align) & ~3U : 0;
+    cache->disp = disp;
+    cache->build_blob = NONE;
+    cache->stats.max_size = cache->buf_size;
+    lv_array_init(&cache->pages, 4, sizeof(lv_page_cache_page_t));
+    cache->band_cnt = (lv_display_get_vertical_resolution(disp) + LV_PAGE_CACHE_BAND_HEIGHT - 1) /
+                      LV_PAGE_CACHE_BAND_HEIGHT;
+
+    cache->timer = lv_timer_create(prerender_timer_cb, PRERENDER_PERIOD, cache);
+    lv_display_add_event_cb(disp, display_event_cb, LV_EVENT_ALL, cache);
+    disp->page_cache = cache;
+
+    return cache;
+}
+
+void lv_page_cache_delete(lv_page_cache_t * cache)
+{
+    LV_ASSERT_NULL(cache);
+
+    uint32_t i;
+    for(i = 0; i < lv_array_size(&cache->pages); i++) {
+        lv_page_cache_page_t * page = get_page(cache, i);
+        if(page->screen == NULL) continue;
+        lv_obj_remove_event_cb_with_user_data(page->screen, screen_delete_event_cb, cache);
+        lv_free(page->bands);
+    }
+    lv_array_deinit(&cache->pages);
+
+    lv_timer_delete(cache->timer);
+    lv_display_remove_event_cb_with_user_data(cache->disp, display_event_cb, cache);
+    cache->disp->page_cache = NULL;
+    lv_free(cache);
+}
+
+lv_result_t lv_page_cache_add_page(lv_page_cache_t * cache, lv_obj_t * screen)
+{
+    LV_ASSERT_NULL(cache);
+    LV_ASSERT_OBJ(screen, &lv_obj_class);
+
+    if(lv_obj_get_parent(screen) != NULL || lv_obj_get_display(screen) != cache->disp) {
+        LV_LOG_WARN("Not a screen of the cache's display");
+        return LV_RESULT_INVALID;
+    }
+
+    if(find_page(cache, screen) != NONE) return LV_RESULT_OK;
+
+    uint32_t * bands = lv_malloc(cache->band_cnt * sizeof(uint32_t));
+    LV_ASSERT_MALLOC(bands);
+    if(bands == NULL) return LV_RESULT_INVALID;
+    lv_memset(bands, 0xFF, cache->band_cnt * sizeof(uint32_t));
+
+    /*Reuse a free slot, the blobs refer to the pages by their slot*/
+    uint32_t idx;
+    for(idx = 0; idx < lv_array_size(&cache->pages); idx++) {
+        if(get_page(cache, idx)->screen == NULL) break;
+    }
+    if(idx == lv_array_size(&cache->pages)) {
+        if(lv_array_size(&cache->pages) >= BLOB_FREE) {
+            lv_free(bands);
+            return LV_RESULT_INVALID;
+        }
+        lv_page_cache_page_t empty = {0};
+        if(lv_array_push_back(&cache->pages, &empty) != LV_RESULT_OK) {
+            lv_free(bands);
+            return LV_RESULT_INVALID;
+        }
+    }
+
+    lv_page_cache_page_t * page = get_page(cache, idx);
+    page->screen = screen;
+    page->bands = bands;
+    page->last_shown = lv_tick_get();
+    page->shown = false;
+
+    lv_obj_add_event_cb(screen, screen_delete_event_cb, LV_EVENT_DELETE, cache);
+
+    return LV_RESULT_OK;
+}
+
+void lv_page_cache_remove_page(lv_page_cache_t * cache, lv_obj_t * screen)
+{
+    LV_ASSERT_NULL(cache);
+
+    uint32_t idx = find_page(cache, screen);
+    if(idx == NONE) return;
+
+    free_page_bands(cache, idx, 0, cache->band_cnt - 1);
+
+    lv_page_cache_page_t * page = get_page(cache, idx);
+    lv_obj_remove_event_cb_with_user_data(screen, screen_delete_event_cb, cache);
+    lv_free(page->bands);
+    page->bands = NULL;
+    page->screen = NULL;
+}
+
+lv_result_t lv_page_cache_prerender(lv_page_cache_t * cache, lv_obj_t * screen)
+{
+    LV_ASSERT_NULL(cache);
+
+    uint32_t idx = find_page(cache, screen);
+    if(idx == NONE) return LV_RESULT_INVALID;
+
+    lv_page_cache_page_t * page = get_page(cache, idx);
+    page->shown = true;
+    page->last_shown = lv_tick_get();
+
+    /*Changes of the layout drop bands, so do it before rendering any*/
+    lv_obj_update_layout(screen);
+    if(!fills_display(cache->disp, screen)) return LV_RESULT_INVALID;
+
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(lv_display_get_horizontal_resolution(cache->disp),
+                                                  LV_PAGE_CACHE_BAND_HEIGHT, LV_COLOR_FORMAT_RGB565, LV_STRIDE_AUTO);
+    if(draw_buf == NULL) return LV_RESULT_INVALID;
+
+    lv_result_t res = LV_RESULT_OK;
+    uint32_t band;
+    for(band = 0; band < cache->band_cnt; band++) {
+        /*The page might be evicted while making room for its bands*/
+        page = get_page(cache, idx);
+        if(page->bands[band] != NONE || !band_needed(cache, band)) continue;
+        res = render_band(cache, idx, band, draw_buf, true);
+        if(res != LV_RESULT_OK) break;
+    }
+
+    lv_draw_buf_destroy(draw_buf);
+    return res;
+}
+
+void lv_page_cache_get_stats(lv_page_cache_t * cache, lv_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(cache);
+    LV_ASSERT_NULL(stats);
+
+    *stats = cache->stats;
+    stats->size = cache->used - cache->freed;
+}
+
+void lv_page_cache_report_change(lv_display_t * disp, const lv_obj_t * obj, const lv_area_t * area)
+{
+    if(disp == NULL || disp->page_cache == NULL) return;
+    lv_page_cache_t * cache = disp->page_cache;
+
+    uint32_t idx = find_page(cache, lv_obj_get_screen(obj));
+    if(idx == NONE) return;
+
+    /*Hidden objects are not drawn. They are invalidated before getting hidden*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+
+    lv_area_t a;
+    lv_area_t obj_coords = obj->coords;
+    int32_t ext_size = lv_obj_get_ext_draw_size(obj);
+    lv_area_increase(&obj_coords, ext_size, ext_size);
+    if(!lv_area_intersect(&a, area, &obj_coords)) return;
+
+    const lv_obj_t * parent;
+    for(parent = obj; parent; parent = parent->parent) {
+        if(parent->spec_attr && parent->spec_attr->layer_type == LV_LAYER_TYPE_TRANSFORM) {
+            lv_obj_get_transformed_area(obj, &a, LV_OBJ_POINT_TRANSFORM_FLAG_RECURSIVE);
+            break;
+        }
+    }
+
+    int32_t ver_res = lv_display_get_vertical_resolution(disp);
+    if(a.y2 < 0 || a.y1 >= ver_res) return;
+    if(a.y1 < 0) a.y1 = 0;
+    if(a.y2 >= ver_res) a.y2 = ver_res - 1;
+
+    free_page_bands(cache, idx, a.y1 / LV_PAGE_CACHE_BAND_HEIGHT, a.y2 / LV_PAGE_CACHE_BAND_HEIGHT);
+}
+
+bool lv_page_cache_draw(lv_display_t * disp, lv_layer_t * layer, lv_area_t * render_area)
+{
+    lv_page_cache_t * cache = disp->page_cache;
+    if(cache == NULL || disp->prev_scr || disp->act_scr == NULL) return false;
+    if(layer->color_format != LV_COLOR_FORMAT_RGB565) return false;
+
+    uint32_t idx = find_page(cache, disp->act_scr);
+    if(idx == NONE) return false;
+    if(!fills_display(disp, disp->act_scr)) return false;
+
+    lv_page_cache_page_t * page = get_page(cache, idx);
+    page->last_shown = lv_tick_get();
+    page->shown = true;
+
+    /*Find the span of missing bands, only the rows around it are copied*/
+    const lv_area_t * clip = &layer->_clip_area;
+    uint32_t band_first = clip->y1 / LV_PAGE_CACHE_BAND_HEIGHT;
+    uint32_t band_last = clip->y2 / LV_PAGE_CACHE_BAND_HEIGHT;
+    uint32_t miss_first = NONE;
+    uint32_t miss_last = NONE;
+    uint32_t band;
+    for(band = band_first; band <= band_last; band++) {
+        if(page->bands[band] == NONE) {
+            if(miss_first == NONE) miss_first = band;
+            miss_last = band;
+        }
+    }
+
+    *render_area = *clip;
+    if(miss_first == NONE) {
+        render_area->y2 = render_area->y1 - 1;
+        cache->stats.hits++;
+    }
+    else {
+        render_area->y1 = LV_MAX(clip->y1, (int32_t)(miss_first * LV_PAGE_CACHE_BAND_HEIGHT));
+        render_area->y2 = LV_MIN(clip->y2, (int32_t)((miss_last + 1) * LV_PAGE_CACHE_BAND_HEIGHT - 1));
+        cache->stats.misses++;
+        /*Nothing to copy*/
+        if(render_area->y1 == clip->y1 && render_area->y2 == clip->y2) return false;
+    }
+
+    int32_t w = lv_display_get_horizontal_resolution(disp);
+    int32_t ver_res = lv_display_get_vertical_resolution(disp);
+    lv_draw_buf_t * draw_buf = layer->draw_buf;
+    uint32_t stride = draw_buf->header.stride;
+    uint8_t * dest = draw_buf->data + (clip->y1 - layer->buf_area.y1) * stride +
+                     (clip->x1 - layer->buf_area.x1) * sizeof(uint16_t);
+
+    for(band = band_first; band <= band_last; band++) {
+        int32_t y = band * LV_PAGE_CACHE_BAND_HEIGHT;
+        int32_t y_end = LV_MIN(y + LV_PAGE_CACHE_BAND_HEIGHT, ver_res);
+        if(miss_first != NONE && band >= miss_first && band <= miss_last) {
+            /*Rendered, skip its rows*/
+            int32_t skip = LV_MIN(y_end - 1, clip->y2) - LV_MAX(y, clip->y1) + 1;
+            dest += skip * stride;
+            continue;
+        }
+
+        const uint16_t * src = (const uint16_t *)(cache->buf + page->bands[band] + sizeof(blob_t));
+        for(; y < y_end && y <= clip->y2; y++) {
+            if(y < clip->y1) {
+                src = decode_row(src, w, 0, -1, NULL);
+            }
+            else {
+                src = decode_row(src, w, clip->x1, clip->x2, (uint16_t *)dest);
+                dest += stride;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_page_cache_page_t * get_page(lv_page_cache_t * cache, uint32_t idx)
+{
+    return lv_array_at(&cache->pages, idx);
+}
+
+/**
+ * Find the slot of a screen
+ */
+static uint32_t find_page(lv_page_cache_t * cache, const lv_obj_t * screen)
+{
+    if(screen == NULL) return NONE;
+
+    uint32_t i;
+    uint32_t cnt = lv_array_size(&cache->pages);
+    for(i = 0; i < cnt; i++) {
+        if(get_page(cache, i)->screen == screen) return i;
+    }
+    return NONE;
+}
+
+static void free_page_bands(lv_page_cache_t * cache, uint32_t idx, uint32_t band_first, uint32_t band_last)
+{
+    if(cache->build_blob != NONE && cache->build_page == idx &&
+       cache->build_band >= band_first && cache->build_band <= band_last) {
+        abort_band(cache);
+    }
+
+    lv_page_cache_page_t * page = get_page(cache, idx);
+    uint32_t band;
+    for(band = band_first; band <= band_last; band++) {
+        if(page->bands[band] == NONE) continue;
+        free_blob(cache, page->bands[band]);
+        page->bands[band] = NONE;
+    }
+}
+
+static void free_blob(lv_page_cache_t * cache, uint32_t offset)
+{
+    blob_t * blob = (blob_t *)(cache->buf + offset);
+    blob->page = BLOB_FREE;
+
+    /*The last blob is dropped right away, the others are reclaimed by compacting*/
+    if(offset + blob->size == cache->used) cache->used = offset;
+    else cache->freed += blob->size;
+}
+
+/**
+ * Move the blobs to the beginning of the buffer so the free space is in one piece at the end
+ */
+static void compact(lv_page_cache_t * cache)
+{
+    uint32_t rd = 0;
+    uint32_t wr = 0;
+    while(rd < cache->used) {
+        blob_t * blob = (blob_t *)(cache->buf + rd);
+        uint32_t size = blob->size;
+        if(blob->page != BLOB_FREE) {
+            if(wr != rd) {
+                if(rd == cache->build_blob) cache->build_blob = wr;
+                else get_page(cache, blob->page)->bands[blob->band] = wr;
+                lv_memmove(cache->buf + wr, blob, size);
+            }
+            wr += size;
+        }
+        rd += size;
+    }
+
+    cache->used = wr;
+    cache->freed = 0;
+}
+
+/**
+ * Make `size` bytes free at the end of the buffer. With `evict` the least recently shown pages
+ * are dropped if needed, except `keep_idx`.
+ */
+static bool make_room(lv_page_cache_t * cache, uint32_t size, bool evict, uint32_t keep_idx)
+{
+    if(cache->buf_size - cache->used >= size) return true;
+    if(cache->buf_size - cache->used + cache->freed >= size) {
+        compact(cache);
+        return true;
+    }
+    if(!evict) return false;
+
+    while(cache->buf_size - cache->used + cache->freed < size) {
+        uint32_t lru = NONE;
+        uint32_t i;
+        for(i = 0; i < lv_array_size(&cache->pages); i++) {
+            lv_page_cache_page_t * page = get_page(cache, i);
+            if(i == keep_idx || page->screen == NULL) continue;
+
+            uint32_t band;
+            for(band = 0; band < cache->band_cnt; band++) {
+                if(page->bands[band] != NONE) break;
+            }
+            if(band == cache->band_cnt) continue;
+
+            if(lru != NONE && (int32_t)(page->last_shown - get_page(cache, lru)->last_shown) >= 0) continue;
+            lru = i;
+        }
+        if(lru == NONE) return false;
+
+        free_page_bands(cache, lru, 0, cache->band_cnt - 1);
+        cache->stats.evictions++;
+    }
+
+    compact(cache);
+    return true;
+}
+
+/**
+ * The largest encoded band: a literal token for every row
+ */
+static uint32_t band_size_max(lv_page_cache_t * cache)
+{
+    uint32_t w = lv_display_get_horizontal_resolution(cache->disp);
+    uint32_t row_max = (w + w / TOKEN_MAX_CNT + 1) * sizeof(uint16_t);
+    return sizeof(blob_t) + LV_PAGE_CACHE_BAND_HEIGHT * row_max + 3;
+}
+
+/**
+ * Start writing a band at the end of the buffer. Room for the largest band is made
+ * so the rows can be added without checking.
+ */
+static bool begin_band(lv_page_cache_t * cache, uint32_t idx, uint32_t band, bool evict)
+{
+    if(cache->build_blob != NONE) abort_band(cache);
+    if(!make_room(cache, band_size_max(cache), evict, idx)) return false;
+
+    blob_t * blob = (blob_t *)(cache->buf + cache->used);
+    blob->size = sizeof(blob_t);
+    blob->page = (uint16_t)idx;
+    blob->band = (uint16_t)band;
+
+    cache->build_blob = cache->used;
+    cache->build_page = idx;
+    cache->build_band = band;
+    cache->build_row = band * LV_PAGE_CACHE_BAND_HEIGHT;
+    cache->used += sizeof(blob_t);
+    return true;
+}
+
+static void add_row(lv_page_cache_t * cache, const uint16_t * px)
+{
+    blob_t * blob = (blob_t *)(cache->buf + cache->build_blob);
+    int32_t w = lv_display_get_horizontal_resolution(cache->disp);
+    uint32_t bytes = encode_row(px, w, (uint16_t *)(cache->buf + cache->used)) * sizeof(uint16_t);
+    cache->used += bytes;
+    blob->size += bytes;
+    cache->build_row++;
+
+    int32_t band_end = LV_MIN((int32_t)(cache->build_band + 1) * LV_PAGE_CACHE_BAND_HEIGHT,
+                              lv_display_get_vertical_resolution(cache->disp));
+    if(cache->build_row < band_end) return;
+
+    /*Band complete*/
+    uint32_t pad = (4 - (blob->size & 3)) & 3;
+    lv_memzero(cache->buf + cache->used, pad);
+    cache->used += pad;
+    blob->size += pad;
+
+    get_page(cache, cache->build_page)->bands[cache->build_band] = cache->build_blob;
+    cache->build_blob = NONE;
+}
+
+static void abort_band(lv_page_cache_t * cache)
+{
+    if(cache->build_blob == NONE) return;
+    uint32_t offset = cache->build_blob;
+    cache->build_blob = NONE;
+    free_blob(cache, offset);
+}
+
+/**
+ * Run-length encode a row of pixels
+ * @return the number of uint16_t written
+ */
+static uint32_t encode_row(const uint16_t * px, int32_t w, uint16_t * out)
+{
+    uint16_t * out_start = out;
+    int32_t lit_start = 0;
+    int32_t i = 0;
+    while(i < w) {
+        int32_t run = 1;
+        while(i + run < w && px[i + run] == px[i] && run < TOKEN_MAX_CNT) run++;
+
+        if(run < MIN_RUN) {
+            i += run;
+            continue;
+        }
+
+        while(lit_start < i) {
+            int32_t cnt = LV_MIN(i - lit_start, TOKEN_MAX_CNT);
+            *out++ = (uint16_t)cnt;
+            lv_memcpy(out, px + lit_start, cnt * sizeof(uint16_t));
+            out += cnt;
+            lit_start += cnt;
+        }
+
+        *out++ = (uint16_t)(TOKEN_RUN | run);
+        *out++ = px[i];
+        i += run;
+        lit_start = i;
+    }
+
+    while(lit_start < w) {
+        int32_t cnt = LV_MIN(w - lit_start, TOKEN_MAX_CNT);
+        *out++ = (uint16_t)cnt;
+        lv_memcpy(out, px + lit_start, cnt * sizeof(uint16_t));
+        out += cnt;
+        lit_start += cnt;
+    }
+
+    return out - out_start;
+}
+
+/**
+ * Decode the pixels x1..x2 of a row to `dest`, or just skip the row if `dest` is NULL
+ * @return the start of the next row
+ */
+static const uint16_t * decode_row(const uint16_t * src, int32_t w, int32_t x1, int32_t x2, uint16_t * dest)
+{
+    int32_t x = 0;
+    while(x < w) {
+        uint16_t token = *src++;
+        int32_t cnt = token & TOKEN_MAX_CNT;
+        int32_t start = LV_MAX(x, x1);
+        int32_t end = LV_MIN(x + cnt - 1, x2);
+
+        if(token & TOKEN_RUN) {
+            if(dest) {
+                uint16_t c = *src;
+                uint16_t * d = dest + (start - x1);
+                int32_t n;
+                for(n = start; n <= end; n++) *d++ = c;
+            }
+            src++;
+        }
+        else {
+            if(dest && start <= end) {
+                lv_memcpy(dest + (start - x1), src + (start - x), (end - start + 1) * sizeof(uint16_t));
+            }
+            src += cnt;
+        }
+        x += cnt;
+    }
+
+    return src;
+}
+
+/**
+ * The image is stored in display coordinates, so the screen must not be moved
+ */
+static bool fills_display(lv_display_t * disp, lv_obj_t * screen)
+{
+    return screen->coords.x1 == 0 && screen->coords.y1 == 0 &&
+           lv_obj_get_width(screen) == lv_display_get_horizontal_resolution(disp) &&
+           lv_obj_get_height(screen) == lv_display_get_vertical_resolution(disp) &&
+           !lv_obj_has_flag(screen, LV_OBJ_FLAG_HIDDEN);
+}
+
+/**
+ * Check if the top or system layer draws something on the rows.
+ * Such rows are not taken from the flushed pixels as they are not the page's own.
+ */
+static bool overlay_on_rows(lv_display_t * disp, int32_t y1, int32_t y2)
+{
+    lv_obj_t * layers[2] = {disp->top_layer, disp->sys_layer};
+    uint32_t l;
+    for(l = 0; l < 2; l++) {
+        if(layers[l] == NULL) continue;
+        uint32_t i;
+        uint32_t cnt = lv_obj_get_child_count(layers[l]);
+        for(i = 0; i < cnt; i++) {
+            lv_obj_t * child = lv_obj_get_child(layers[l], i);
+            if(lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) continue;
+            int32_t ext_size = lv_obj_get_ext_draw_size(child);
+            if(child->coords.y1 - ext_size <= y2 && child->coords.y2 + ext_size >= y1) return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Check if a band of the pages can be seen or it's covered by the top and sys layers, e.g. by a
+ * header shared by the pages. Covered bands are never drawn, so they are not rendered in advance.
+ */
+static bool band_needed(lv_page_cache_t * cache, uint32_t band)
+{
+    lv_area_t area;
+    area.x1 = 0;
+    area.x2 = lv_display_get_horizontal_resolution(cache->disp) - 1;
+    area.y1 = band * LV_PAGE_CACHE_BAND_HEIGHT;
+    area.y2 = LV_MIN(area.y1 + LV_PAGE_CACHE_BAND_HEIGHT, lv_display_get_vertical_resolution(cache->disp)) - 1;
+    return lv_refr_trim_covered_area(cache->disp, &area);
+}
+
+/**
+ * Render a band of a page with a snapshot and store it
+ */
+static lv_result_t render_band(lv_page_cache_t * cache, uint32_t idx, uint32_t band, lv_draw_buf_t * draw_buf,
+                               bool evict)
+{
+    lv_page_cache_page_t * page = get_page(cache, idx);
+    lv_area_t area;
+    area.x1 = 0;
+    area.x2 = lv_display_get_horizontal_resolution(cache->disp) - 1;
+    area.y1 = band * LV_PAGE_CACHE_BAND_HEIGHT;
+    area.y2 = LV_MIN(area.y1 + LV_PAGE_CACHE_BAND_HEIGHT, lv_display_get_vertical_resolution(cache->disp)) - 1;
+
+    if(!make_room(cache, band_size_max(cache), evict, idx)) return LV_RESULT_INVALID;
+
+    lv_result_t res = lv_snapshot_take_area_to_draw_buf(page->screen, &area, LV_COLOR_FORMAT_RGB565, draw_buf);
+    if(res != LV_RESULT_OK) return res;
+
+    /*Rendering might have changed something*/
+    if(page->bands[band] != NONE) return LV_RESULT_OK;
+
+    if(!begin_band(cache, idx, band, evict)) return LV_RESULT_INVALID;
+    int32_t y;
+    for(y = area.y1; y <= area.y2; y++) {
+        add_row(cache, (const uint16_t *)(draw_buf->data + (y - area.y1) * draw_buf->header.stride));
+    }
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Store the rendered rows of the missing bands of the active page while they are flushed
+ */
+static void capture_rows(lv_page_cache_t * cache, const lv_area_t * flush_area)
+{
+    lv_display_t * disp = cache->disp;
+    uint32_t idx = disp->prev_scr ? NONE : find_page(cache, disp->act_scr);
+    if(idx == NONE || !fills_display(disp, disp->act_scr)) {
+        abort_band(cache);
+        return;
+    }
+
+    lv_area_t area = *flush_area;
+    lv_area_move(&area, -disp->offset_x, -disp->offset_y);
+
+    /*Bands are stored in full width*/
+    if(area.x1 != 0 || area.x2 != lv_display_get_horizontal_resolution(disp) - 1) {
+        abort_band(cache);
+        return;
+    }
+
+    lv_layer_t * layer = disp->layer_head;
+    lv_draw_buf_t * draw_buf = layer->draw_buf;
+    int32_t ver_res = lv_display_get_vertical_resolution(disp);
+    int32_t y;
+    for(y = area.y1; y <= area.y2; y++) {
+        const uint16_t * px = (const uint16_t *)(draw_buf->data + (y - layer->buf_area.y1) * draw_buf->header.stride -
+                                                 layer->buf_area.x1 * sizeof(uint16_t));
+        uint32_t band = y / LV_PAGE_CACHE_BAND_HEIGHT;
+
+        if(cache->build_blob != NONE) {
+            if(cache->build_page == idx && cache->build_band == band && cache->build_row == y) {
+                add_row(cache, px);
+                continue;
+            }
+            abort_band(cache);
+        }
+
+        if(y != (int32_t)band * LV_PAGE_CACHE_BAND_HEIGHT) continue;
+        if(get_page(cache, idx)->bands[band] != NONE) continue;
+        if(overlay_on_rows(disp, y, LV_MIN(y + LV_PAGE_CACHE_BAND_HEIGHT, ver_res) - 1)) continue;
+
+        if(begin_band(cache, idx, band, true)) add_row(cache, px);
+    }
+}
+
+/**
+ * Drop every image, e.g. when the resolution changed
+ */
+static void reset_pages(lv_page_cache_t * cache)
+{
+    cache->build_blob = NONE;
+    cache->used = 0;
+    cache->freed = 0;
+    cache->band_cnt = (lv_display_get_vertical_resolution(cache->disp) + LV_PAGE_CACHE_BAND_HEIGHT - 1) /
+                      LV_PAGE_CACHE_BAND_HEIGHT;
+
+    uint32_t i;
+    for(i = 0; i < lv_array_size(&cache->pages); i++) {
+        lv_page_cache_page_t * page = get_page(cache, i);
+        if(page->screen == NULL) continue;
+        uint32_t * bands = lv_realloc(page->bands, cache->band_cnt * sizeof(uint32_t));
+        LV_ASSERT_MALLOC(bands);
+        if(bands == NULL) {
+            lv_page_cache_remove_page(cache, page->screen);
+            continue;
+        }
+        page->bands = bands;
+        lv_memset(bands, 0xFF, cache->band_cnt * sizeof(uint32_t));
+    }
+}
+
+static void prerender_timer_cb(lv_timer_t * t)
+{
+    lv_page_cache_t * cache = lv_timer_get_user_data(t);
+    lv_display_t * disp = cache->disp;
+
+    /*Fill the most recently shown page first, it's the most likely to be shown again*/
+    uint32_t idx = NONE;
+    uint32_t i;
+    for(i = 0; i < lv_array_size(&cache->pages); i++) {
+        lv_page_cache_page_t * page = get_page(cache, i);
+        if(page->screen == NULL || !page->shown) continue;
+        if(page->screen == disp->act_scr || page->screen == disp->prev_scr || page->screen == disp->scr_to_load) continue;
+
+        uint32_t band;
+        for(band = 0; band < cache->band_cnt; band++) {
+            if(page->bands[band] == NONE && band_needed(cache, band)) break;
+        }
+        if(band == cache->band_cnt) continue;
+
+        if(idx != NONE && (int32_t)(page->last_shown - get_page(cache, idx)->last_shown) < 0) continue;
+        idx = i;
+    }
+    if(idx == NONE) return;
+
+    lv_obj_t * screen = get_page(cache, idx)->screen;
+    lv_obj_update_layout(screen);
+    if(!fills_display(disp, screen)) return;
+
+    lv_draw_buf_t * draw_buf = NULL;
+    uint32_t rendered = 0;
+    uint32_t band;
+    for(band = 0; band < cache->band_cnt && rendered < PRERENDER_BANDS; band++) {
+        if(get_page(cache, idx)->bands[band] != NONE || !band_needed(cache, band)) continue;
+
+        if(draw_buf == NULL) {
+            draw_buf = lv_draw_buf_create(lv_display_get_horizontal_resolution(disp), LV_PAGE_CACHE_BAND_HEIGHT,
+                                          LV_COLOR_FORMAT_RGB565, LV_STRIDE_AUTO);
+            if(draw_buf == NULL) return;
+        }
+
+        /*Other pages are not evicted for a page which is not shown*/
+        if(render_band(cache, idx, band, draw_buf, false) != LV_RESULT_OK) break;
+        rendered++;
+    }
+
+    if(draw_buf) lv_draw_buf_destroy(draw_buf);
+}
+
+static void display_event_cb(lv_event_t * e)
+{
+    lv_page_cache_t * cache = lv_event_get_user_data(e);
+    lv_event_code_t code = lv_event_get_code(e);
+
+    if(code == LV_EVENT_FLUSH_START) {
+        capture_rows(cache, lv_event_get_param(e));
+    }
+    else if(code == LV_EVENT_REFR_READY) {
+        /*A band is stored only if all its rows were rendered in the same refresh*/
+        abort_band(cache);
+    }
+    else if(code == LV_EVENT_RESOLUTION_CHANGED) {
+        reset_pages(cache);
+    }
+    else if(code == LV_EVENT_DELETE) {
+        lv_page_cache_delete(cache);
+    }
+}
+
+static void screen_delete_event_cb(lv_event_t * e)
+{
+    lv_page_cache_t * cache = lv_event_get_user_data(e);
+    lv_page_cache_remove_page(cache, lv_event_get_current_target(e));
+}
+
+#endif /*LV_USE_PAGE_CACHE*/
@@ -0,0 +1,104 @@
+/**
+ * @file lv_page_cache.h
+ *
+ */
+
+#ifndef LV_PAGE_CACHE_H
+#define LV_PAGE_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../core/lv_obj.h"
+
+#if LV_USE_PAGE_CACHE
+
+#if LV_USE_SNAPSHOT == 0
+#error "lv_page_cache: lv_snapshot is required. Enable it in lv_conf.h (LV_USE_SNAPSHOT  1) "
+#endif
+
+#include "../../misc/cache/lv_cache.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a page cache for a display.
+ * The rendered image of the added screens (pages) is kept run-length compressed in `buf`,
+ * in bands of a few rows. When a page is loaded again the unchanged bands are copied to the
+ * draw buffer instead of being rendered, only the rows of the changed ones and the top and
+ * system layers are drawn. A band is dropped as soon as an object on it is invalidated, even if the page is
+ * not shown, and pages which are not shown get their missing bands rendered with
+ * `lv_snapshot` in the background. If `buf` gets full the least recently shown page is evicted.
+ * Only RGB565 displays are supported and the pages should have an opaque background.
+ * @param disp      the display whose screens are cached
+ * @param buf       memory for the images. It's not used by anything else while the cache exists
+ * @param buf_size  size of `buf` in bytes
+ * @return          the new page cache or NULL on error
+ */
+lv_page_cache_t * lv_page_cache_create(lv_display_t * disp, void * buf, uint32_t buf_size);
+
+/**
+ * Delete a page cache. Its buffer can be freed after this.
+ * It's also deleted with its display.
+ * @param cache     the page cache to delete
+ */
+void lv_page_cache_delete(lv_page_cache_t * cache);
+
+/**
+ * Keep the image of a screen. The page is removed from the cache when the screen is deleted.
+ * @param cache     a page cache
+ * @param screen    a screen of the cache's display
+ * @return          LV_RESULT_OK if the page was added or was already there, LV_RESULT_INVALID on error
+ */
+lv_result_t lv_page_cache_add_page(lv_page_cache_t * cache, lv_obj_t * screen);
+
+/**
+ * Stop caching a screen and free its image.
+ * @param cache     a page cache
+ * @param screen    a screen added with `lv_page_cache_add_page`
+ */
+void lv_page_cache_remove_page(lv_page_cache_t * cache, lv_obj_t * screen);
+
+/**
+ * Render the missing bands of a page now, e.g. before it's loaded for the first time.
+ * Pages which were shown already are kept complete in the background without this.
+ * @param cache     a page cache
+ * @param screen    a screen added with `lv_page_cache_add_page`
+ * @return          LV_RESULT_OK if the visible part of the page is in the cache
+ */
+lv_result_t lv_page_cache_prerender(lv_page_cache_t * cache, lv_obj_t * screen);
+
+/**
+ * Get the counters of a page cache. `hits` counts the draw areas of cached pages which were
+ * copied completely, `misses` the ones where some rows had to be rendered, `evictions` the pages
+ * dropped because the buffer was full, `size` and `max_size` are the used and total bytes of the buffer.
+ * @param cache     a page cache
+ * @param stats     where to store the counters
+ */
+void lv_page_cache_get_stats(lv_page_cache_t * cache, lv_cache_stats_t * stats);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_PAGE_CACHE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_PAGE_CACHE_H*/
@@ -0,0 +1,94 @@
+/**
+ * @file lv_page_cache_private.h
+ *
+ */
+
+#ifndef LV_PAGE_CACHE_PRIVATE_H
+#define LV_PAGE_CACHE_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "lv_page_cache.h"
+
+#if LV_USE_PAGE_CACHE
+
+#include "../../misc/lv_array.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** Rows of a band, the unit in which images are stored and dropped*/
+#define LV_PAGE_CACHE_BAND_HEIGHT   8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** A cached screen*/
+typedef struct {
+    lv_obj_t * screen;          /**< NULL if the slot is unused*/
+    uint32_t * bands;           /**< Offset of the blob of each band in the buffer or `UINT32_MAX` if it's missing*/
+    uint32_t last_shown;        /**< Tick when the page was shown last, the least recent is evicted first*/
+    bool shown;                 /**< Shown at least once or prerendered, so it's kept complete in the background*/
+} lv_page_cache_page_t;
+
+struct _lv_page_cache_t {
+    lv_display_t * disp;
+    uint8_t * buf;              /**< Blobs of the bands, each starting with a header*/
+    uint32_t buf_size;
+    uint32_t used;              /**< End of the last blob*/
+    uint32_t freed;             /**< Bytes of freed blobs below `used`, reclaimed by compacting*/
+    lv_array_t pages;           /**< lv_page_cache_page_t, slots are reused so blobs can refer to them by index*/
+    uint32_t band_cnt;
+    lv_timer_t * timer;         /**< Renders the missing bands of the pages which are not shown*/
+
+    /*The band being written, row by row*/
+    uint32_t build_blob;        /**< Offset of its blob or `UINT32_MAX` if no band is written*/
+    uint32_t build_page;
+    uint32_t build_band;
+    int32_t build_row;          /**< Next row expected*/
+
+    lv_cache_stats_t stats;
+};
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Drop the bands of a cached page where an object was invalidated.
+ * Called for every invalidation, before checking if the object is visible.
+ * @param disp      display of the object
+ * @param obj       the invalidated object
+ * @param area      the invalidated area
+ */
+void lv_page_cache_report_change(lv_display_t * disp, const lv_obj_t * obj, const lv_area_t * area);
+
+/**
+ * Copy the rows of a layer's clip area which are in the cached image of the active screen.
+ * The rows between the first and the last missing band still need to be rendered.
+ * @param disp          the display being refreshed
+ * @param layer         the display's layer to draw
+ * @param render_area   store the part of the clip area to render here. Its height is 0 if all rows were copied
+ * @return              true if any rows were copied, false if the screen needs to be rendered normally
+ */
+bool lv_page_cache_draw(lv_display_t * disp, lv_layer_t * layer, lv_area_t * render_area);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_PAGE_CACHE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_PAGE_CACHE_PRIVATE_H*/
@@ -28,6 +28,8 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static bool is_supported_cf(lv_color_format_t cf);
+static void take_area(lv_obj_t * obj, const lv_area_t * area, lv_color_format_t cf, lv_draw_buf_t * draw_buf);
 
 /**********************
  *  STATIC VARIABLES
@@ -77,22 +79,9 @@ lv_result_t lv_snapshot_take_to_draw_buf(lv_obj_t * obj, lv_color_format_t cf, l
     LV_ASSERT_NULL(draw_buf);
     lv_result_t res;
 
-    switch(cf) {
-        case LV_COLOR_FORMAT_RGB565:
-        case LV_COLOR_FORMAT_ARGB8565:
-        case LV_COLOR_FORMAT_RGB888:
-        case LV_COLOR_FORMAT_XRGB8888:
-        case LV_COLOR_FORMAT_ARGB8888:
-        case LV_COLOR_FORMAT_A8:
-        case LV_COLOR_FORMAT_L8:
-        case LV_COLOR_FORMAT_I1:
-        case LV_COLOR_FORMAT_ARGB2222:
-        case LV_COLOR_FORMAT_ARGB4444:
-        case LV_COLOR_FORMAT_ARGB1555:
-            break;
-        default:
-            LV_LOG_WARN("Not supported color format");
-            return LV_RESULT_INVALID;
+    if(!is_supported_cf(cf)) {
+        LV_LOG_WARN("Not supported color format");
+        return LV_RESULT_INVALID;
     }
 
     res = lv_snapshot_reshape_draw_buf(obj, draw_buf);
@@ -102,42 +91,39 @@ lv_result_t lv_snapshot_take_to_draw_buf(lv_obj_t * obj, lv_color_format_t cf, l
     lv_draw_buf_clear(draw_buf, NULL);
 
     lv_area_t snapshot_area;
-    int32_t w = draw_buf->header.w;
-    int32_t h = draw_buf->header.h;
     int32_t ext_size = lv_obj_get_ext_draw_size(obj);
     lv_obj_get_coords(obj, &snapshot_area);
     lv_area_increase(&snapshot_area, ext_size, ext_size);
 
-    lv_layer_t layer;
-    lv_memzero(&layer, sizeof(layer));
+    take_area(obj, &snapshot_area, cf, draw_buf);
 
-    layer.draw_buf = draw_buf;
-    layer.buf_area.x1 = snapshot_area.x1;
-    layer.buf_area.y1 = snapshot_area.y1;
-    layer.buf_area.x2 = snapshot_area.x1 + w - 1;
-    layer.buf_area.y2 = snapshot_area.y1 + h - 1;
-    layer.color_format = cf;
-    layer._clip_area = snapshot_area;
-    layer.phy_clip_area = snapshot_area;
-#if LV_DRAW_TRANSFORM_USE_MATRIX
-    lv_matrix_identity(&layer.matrix);
-#endif
-
-    lv_display_t * disp_old = lv_refr_get_disp_refreshing();
-    lv_display_t * disp_new = lv_obj_get_display(obj);
-    lv_layer_t * layer_old = disp_new->layer_head;
-    disp_new->layer_head = &layer;
+    return LV_RESULT_OK;
+}
 
-    lv_refr_set_disp_refreshing(disp_new);
-    lv_obj_redraw(&layer, obj);
+lv_result_t lv_snapshot_take_area_to_draw_buf(lv_obj_t * obj, const lv_area_t * area, lv_color_format_t cf,
+                                              lv_draw_buf_t * draw_buf)
+{
+    LV_ASSERT_NULL(obj);
+    LV_ASSERT_NULL(area);
+    LV_ASSERT_NULL(draw_buf);
 
-    while(layer.draw_task_head) {
-        lv_draw_dispatch_wait_for_request();
-        lv_draw_dispatch();
+    if(!is_supported_cf(cf)) {
+        LV_LOG_WARN("Not supported color format");
+        return LV_RESULT_INVALID;
     }
 
-    disp_new->layer_head = layer_old;
-    lv_refr_set_disp_refreshing(disp_old);
+    lv_obj_update_layout(obj);
+
+    int32_t w = lv_area_get_width(area);
+    int32_t h = lv_area_get_height(area);
+    if(w <= 0 || h <= 0) return LV_RESULT_INVALID;
+
+    draw_buf = lv_draw_buf_reshape(draw_buf, LV_COLOR_FORMAT_UNKNOWN, w, h, LV_STRIDE_AUTO);
+    if(draw_buf == NULL) return LV_RESULT_INVALID;
+
+    lv_draw_buf_clear(draw_buf, NULL);
+
+    take_area(obj, area, cf, draw_buf);
 
     return LV_RESULT_OK;
 }
@@ -180,4 +166,61 @@ lv_result_t lv_snapshot_take_to_buf(lv_obj_t * obj, lv_color_format_t cf, lv_ima
  *   STATIC FUNCTIONS
  **********************/
 
+static bool is_supported_cf(lv_color_format_t cf)
+{
+    switch(cf) {
+        case LV_COLOR_FORMAT_RGB565:
+        case LV_COLOR_FORMAT_ARGB8565:
+        case LV_COLOR_FORMAT_RGB888:
+        case LV_COLOR_FORMAT_XRGB8888:
+        case LV_COLOR_FORMAT_ARGB8888:
+        case LV_COLOR_FORMAT_A8:
+        case LV_COLOR_FORMAT_L8:
+        case LV_COLOR_FORMAT_I1:
+        case LV_COLOR_FORMAT_ARGB2222:
+        case LV_COLOR_FORMAT_ARGB4444:
+        case LV_COLOR_FORMAT_ARGB1555:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Render the part of an object in `area` to a draw buffer which is at least as large as the area
+ */
+static void take_area(lv_obj_t * obj, const lv_area_t * area, lv_color_format_t cf, lv_draw_buf_t * draw_buf)
+{
+    lv_layer_t layer;
+    lv_memzero(&layer, sizeof(layer));
+
+    layer.draw_buf = draw_buf;
+    layer.buf_area.x1 = area->x1;
+    layer.buf_area.y1 = area->y1;
+    layer.buf_area.x2 = area->x1 + draw_buf->header.w - 1;
+    layer.buf_area.y2 = area->y1 + draw_buf->header.h - 1;
+    layer.color_format = cf;
+    layer._clip_area = *area;
+    layer.phy_clip_area = *area;
+#if LV_DRAW_TRANSFORM_USE_MATRIX
+    lv_matrix_identity(&layer.matrix);
+#endif
+
+    lv_display_t * disp_old = lv_refr_get_disp_refreshing();
+    lv_display_t * disp_new = lv_obj_get_display(obj);
+    lv_layer_t * layer_old = disp_new->layer_head;
+    disp_new->layer_head = &layer;
+
+    lv_refr_set_disp_refreshing(disp_new);
+    lv_obj_redraw(&layer, obj);
+
+    while(layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        lv_draw_dispatch();
+    }
+
+    disp_new->layer_head = layer_old;
+    lv_refr_set_disp_refreshing(disp_old);
+}
+
 #endif /*LV_USE_SNAPSHOT*/
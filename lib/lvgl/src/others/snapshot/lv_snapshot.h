@@ -67,6 +67,19 @@ lv_result_t lv_snapshot_reshape_draw_buf(lv_obj_t * obj, lv_draw_buf_t * draw_bu
  */
 lv_result_t lv_snapshot_take_to_draw_buf(lv_obj_t * obj, lv_color_format_t cf, lv_draw_buf_t * draw_buf);
 
+/**
+ * Take snapshot of a part of an object with its children. Only what is in the area is drawn,
+ * so a tall object can be rendered in bands with a small draw buffer.
+ * @param obj       the object to generate snapshot.
+ * @param area      the area to render in absolute coordinates.
+ * @param cf        color format for new snapshot image.
+ *                  It could differ with cf of `draw_buf` as long as the new cf will fit in.
+ * @param draw_buf  the draw buffer to store the image result. It's reshaped to the size of `area`.
+ * @return          LV_RESULT_OK on success, LV_RESULT_INVALID on error.
+ */
+lv_result_t lv_snapshot_take_area_to_draw_buf(lv_obj_t * obj, const lv_area_t * area, lv_color_format_t cf,
+                                              lv_draw_buf_t * draw_buf);
+
 /**
  * @deprecated Use `lv_draw_buf_destroy` instead.
  *
@@ -53,6 +53,14 @@ struct _lv_image_t {
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Invalidate only the part of an image showing an area of its source, e.g. the rectangle an animation frame changed.
+ * Transformed or tiled images fall back to invalidating the whole object.
+ * @param obj       pointer to an image object
+ * @param area      the area in source image pixels
+ */
+void lv_image_invalidate_src_area(lv_obj_t * obj, const lv_area_t * area);
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,570 @@
+/**
+ * @file lv_numlabel.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_numlabel_private.h"
+#include "../../misc/lv_area_private.h"
+#include "../../core/lv_obj_class_private.h"
+#if LV_USE_NUMLABEL
+
+#include "../../core/lv_global.h"
+#include "../../misc/lv_assert.h"
+#include "../../misc/lv_anim.h"
+#include "../../misc/cache/lv_image_cache.h"
+#include "../../draw/lv_draw_image.h"
+#include "../../draw/lv_draw_label.h"
+#include "../../font/lv_font.h"
+#include "../../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define MY_CLASS (&lv_numlabel_class)
+#define strip_ll_p &(LV_GLOBAL_DEFAULT()->numlabel_strip_ll)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void lv_numlabel_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_numlabel_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void lv_numlabel_event(const lv_obj_class_t * class_p, lv_event_t * e);
+static void draw_main(lv_event_t * e);
+static void update_cells(lv_obj_t * obj, bool roll);
+static int32_t format_value(const lv_numlabel_t * numlabel, char * buf);
+static int32_t glyph_index(char c);
+static int32_t cell_width(const lv_numlabel_strip_t * strip, char c);
+static int32_t get_text_width(const lv_numlabel_t * numlabel);
+static void get_cell_area(lv_obj_t * obj, uint32_t cell_id, lv_area_t * area);
+static void invalidate_changed_cells(lv_obj_t * obj);
+static void roll_anim_exec(void * var, int32_t v);
+static void roll_anim_completed(lv_anim_t * a);
+static void copy_affix(char * dst, const char * src);
+static lv_numlabel_strip_t * strip_get(const lv_font_t * font);
+static void strip_release(lv_numlabel_strip_t * strip);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+const lv_obj_class_t lv_numlabel_class = {
+    .constructor_cb = lv_numlabel_constructor,
+    .destructor_cb = lv_numlabel_destructor,
+    .event_cb = lv_numlabel_event,
+    .width_def = LV_SIZE_CONTENT,
+    .height_def = LV_SIZE_CONTENT,
+    .instance_size = sizeof(lv_numlabel_t),
+    .base_class = &lv_obj_class,
+    .name = "numlabel",
+};
+
+static const char glyph_chars[] = "0123456789" LV_NUMLABEL_SYMBOLS;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_obj_t * lv_numlabel_create(lv_obj_t * parent)
+{
+    LV_LOG_INFO("begin");
+    lv_obj_t * obj = lv_obj_class_create_obj(MY_CLASS, parent);
+    lv_obj_class_init_obj(obj);
+    return obj;
+}
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+void lv_numlabel_set_value(lv_obj_t * obj, int64_t value)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    if(numlabel->value == value) return;
+
+    numlabel->roll_down = value < numlabel->value;
+    numlabel->value = value;
+    update_cells(obj, true);
+}
+
+void lv_numlabel_set_format(lv_obj_t * obj, const char * prefix, uint32_t decimals, char group_sep)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    if(decimals > 9) decimals = 9;
+    if(group_sep != '\0' && glyph_index(group_sep) < 0) group_sep = '\0';
+
+    copy_affix(numlabel->prefix, prefix);
+    numlabel->decimals = (uint8_t)decimals;
+    numlabel->group_sep = group_sep;
+    update_cells(obj, false);
+}
+
+void lv_numlabel_set_suffix(lv_obj_t * obj, const char * suffix)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    copy_affix(numlabel->suffix, suffix);
+    update_cells(obj, false);
+}
+
+void lv_numlabel_set_roll_time(lv_obj_t * obj, uint32_t time)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    numlabel->roll_time = time;
+}
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+int64_t lv_numlabel_get_value(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    return ((const lv_numlabel_t *)obj)->value;
+}
+
+const char * lv_numlabel_get_text(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    return ((const lv_numlabel_t *)obj)->cells;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void lv_numlabel_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    LV_TRACE_OBJ_CREATE("begin");
+
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    numlabel->value = 0;
+    numlabel->decimals = 0;
+    numlabel->group_sep = '\0';
+    numlabel->roll_time = 0;
+    numlabel->roll_progress = LV_NUMLABEL_ROLL_RES;
+    numlabel->strip = strip_get(lv_obj_get_style_text_font(obj, LV_PART_MAIN));
+
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+
+    update_cells(obj, false);
+
+    LV_TRACE_OBJ_CREATE("finished");
+}
+
+static void lv_numlabel_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+    LV_UNUSED(class_p);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    lv_anim_delete(obj, roll_anim_exec);
+    if(numlabel->strip) strip_release(numlabel->strip);
+    numlabel->strip = NULL;
+}
+
+static void lv_numlabel_event(const lv_obj_class_t * class_p, lv_event_t * e)
+{
+    LV_UNUSED(class_p);
+
+    /*Call the ancestor's event handler*/
+    lv_result_t res = lv_obj_event_base(MY_CLASS, e);
+    if(res != LV_RESULT_OK) return;
+
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t * obj = lv_event_get_current_target(e);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    if(code == LV_EVENT_STYLE_CHANGED) {
+        /*Render the glyphs again only if the font changed*/
+        const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+        if(numlabel->strip == NULL || numlabel->strip->font != font) {
+            lv_numlabel_strip_t * strip = strip_get(font);
+            if(numlabel->strip) strip_release(numlabel->strip);
+            numlabel->strip = strip;
+        }
+        lv_obj_refresh_self_size(obj);
+        lv_obj_invalidate(obj);
+    }
+    else if(code == LV_EVENT_GET_SELF_SIZE) {
+        lv_point_t * p = lv_event_get_param(e);
+        if(numlabel->strip == NULL) return;
+        p->x = LV_MAX(p->x, get_text_width(numlabel));
+        p->y = LV_MAX(p->y, numlabel->strip->font->line_height);
+    }
+    else if(code == LV_EVENT_DRAW_MAIN) {
+        draw_main(e);
+    }
+}
+
+static void draw_main(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_current_target(e);
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    lv_layer_t * layer = lv_event_get_layer(e);
+    lv_numlabel_strip_t * strip = numlabel->strip;
+    if(strip == NULL || numlabel->cell_cnt == 0) return;
+
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_dsc);
+
+    /*The glyphs are A8 so they are drawn with the recolor as their color*/
+    lv_draw_image_dsc_t img_dsc;
+    lv_draw_image_dsc_init(&img_dsc);
+    img_dsc.recolor = label_dsc.color;
+    img_dsc.opa = label_dsc.opa;
+    img_dsc.blend_mode = label_dsc.blend_mode;
+
+    bool rolling = numlabel->roll_progress < LV_NUMLABEL_ROLL_RES;
+    int32_t line_h = strip->font->line_height;
+    int32_t shift = (line_h * numlabel->roll_progress) / LV_NUMLABEL_ROLL_RES;
+    if(numlabel->roll_down) shift = -shift;
+
+    const lv_area_t clip_area_ori = layer->_clip_area;
+    uint32_t i;
+    for(i = 0; i < numlabel->cell_cnt; i++) {
+        lv_area_t cell_area;
+        get_cell_area(obj, i, &cell_area);
+        if(!lv_area_intersect(&layer->_clip_area, &clip_area_ori, &cell_area)) continue;
+
+        int32_t new_id = glyph_index(numlabel->cells[i]);
+        int32_t old_id = rolling ? glyph_index(numlabel->old_cells[i]) : new_id;
+
+        if(old_id == new_id) {
+            if(new_id < 0) continue;
+            img_dsc.src = &strip->glyphs[new_id];
+            lv_draw_image(layer, &img_dsc, &cell_area);
+            continue;
+        }
+
+        /*Rolling up: the old glyph leaves at the top and the new one comes from below.
+         *Rolling down is the opposite*/
+        lv_area_t a = cell_area;
+        if(old_id >= 0) {
+            lv_area_move(&a, 0, -shift);
+            img_dsc.src = &strip->glyphs[old_id];
+            lv_draw_image(layer, &img_dsc, &a);
+        }
+        if(new_id >= 0) {
+            a = cell_area;
+            lv_area_move(&a, 0, (numlabel->roll_down ? -line_h : line_h) - shift);
+            img_dsc.src = &strip->glyphs[new_id];
+            lv_draw_image(layer, &img_dsc, &a);
+        }
+    }
+    layer->_clip_area = clip_area_ori;
+}
+
+/**
+ * Write the value into the cells and invalidate what changed.
+ * If only glyphs of the same width changed only their cells are redrawn,
+ * else the whole label is as the characters moved.
+ */
+static void update_cells(lv_obj_t * obj, bool roll)
+{
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+
+    char new_cells[LV_NUMLABEL_CELL_MAX + 1];
+    int32_t new_cnt = format_value(numlabel, new_cells);
+
+    bool same_layout = numlabel->strip && new_cnt == numlabel->cell_cnt;
+    int32_t i;
+    for(i = 0; same_layout && i < new_cnt; i++) {
+        same_layout = cell_width(numlabel->strip, new_cells[i]) == cell_width(numlabel->strip, numlabel->cells[i]);
+    }
+
+    /*Stop a running roll. A new one starts from the digits that were the target of the old one*/
+    bool was_rolling = lv_anim_delete(obj, roll_anim_exec);
+    numlabel->roll_progress = LV_NUMLABEL_ROLL_RES;
+
+    if(!same_layout) {
+        lv_memcpy(numlabel->cells, new_cells, new_cnt + 1);
+        numlabel->cell_cnt = (uint8_t)new_cnt;
+        lv_obj_refresh_self_size(obj);
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    /*Redraw the cells still showing the old glyphs of the interrupted roll*/
+    if(was_rolling) invalidate_changed_cells(obj);
+
+    lv_memcpy(numlabel->old_cells, numlabel->cells, new_cnt + 1);
+    lv_memcpy(numlabel->cells, new_cells, new_cnt + 1);
+
+    if(roll && numlabel->roll_time > 0 && lv_obj_is_visible(obj)) {
+        numlabel->roll_progress = 0;
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, obj);
+        lv_anim_set_exec_cb(&a, roll_anim_exec);
+        lv_anim_set_completed_cb(&a, roll_anim_completed);
+        lv_anim_set_values(&a, 0, LV_NUMLABEL_ROLL_RES);
+        lv_anim_set_duration(&a, numlabel->roll_time);
+        lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+        lv_anim_start(&a);
+    }
+
+    invalidate_changed_cells(obj);
+}
+
+/**
+ * Write the value as text, e.g. "-$1,234.56%"
+ * @return the number of characters
+ */
+static int32_t format_value(const lv_numlabel_t * numlabel, char * buf)
+{
+    /*Digits from the lowest, the sign is handled separately to support INT64_MIN*/
+    char digits[20];
+    int32_t digit_cnt = 0;
+    uint64_t v = numlabel->value < 0 ? (uint64_t)0 - (uint64_t)numlabel->value : (uint64_t)numlabel->value;
+    do {
+        digits[digit_cnt++] = (char)('0' + v % 10);
+        v /= 10;
+    } while(v);
+
+    /*Leading zeros so there is always a digit before the decimal point*/
+    while(digit_cnt <= numlabel->decimals) digits[digit_cnt++] = '0';
+
+    int32_t len = 0;
+    if(numlabel->value < 0) buf[len++] = '-';
+
+    const char * c;
+    for(c = numlabel->prefix; *c; c++) buf[len++] = *c;
+
+    int32_t i;
+    for(i = digit_cnt - 1; i >= 0 && len < LV_NUMLABEL_CELL_MAX; i--) {
+        buf[len++] = digits[i];
+        int32_t int_left = i - numlabel->decimals;
+        if(int_left > 0 && int_left % 3 == 0 && numlabel->group_sep) {
+            if(len < LV_NUMLABEL_CELL_MAX) buf[len++] = numlabel->group_sep;
+        }
+        else if(i == numlabel->decimals && numlabel->decimals > 0) {
+            if(len < LV_NUMLABEL_CELL_MAX) buf[len++] = '.';
+        }
+    }
+
+    for(c = numlabel->suffix; *c && len < LV_NUMLABEL_CELL_MAX; c++) buf[len++] = *c;
+
+    buf[len] = '\0';
+    return len;
+}
+
+static int32_t glyph_index(char c)
+{
+    if(c >= '0' && c <= '9') return c - '0';
+    if(c == '\0') return -1;
+    const char * p = lv_strchr(LV_NUMLABEL_SYMBOLS, c);
+    return p ? 10 + (int32_t)(p - LV_NUMLABEL_SYMBOLS) : -1;
+}
+
+static int32_t cell_width(const lv_numlabel_strip_t * strip, char c)
+{
+    int32_t id = glyph_index(c);
+    return id < 0 ? 0 : (int32_t)strip->glyphs[id].header.w;
+}
+
+static int32_t get_text_width(const lv_numlabel_t * numlabel)
+{
+    int32_t w = 0;
+    uint32_t i;
+    for(i = 0; i < numlabel->cell_cnt; i++) w += cell_width(numlabel->strip, numlabel->cells[i]);
+    return w;
+}
+
+static void get_cell_area(lv_obj_t * obj, uint32_t cell_id, lv_area_t * area)
+{
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    const lv_numlabel_strip_t * strip = numlabel->strip;
+
+    lv_area_t content;
+    lv_obj_get_content_coords(obj, &content);
+
+    int32_t x = content.x1;
+    lv_text_align_t align = lv_obj_get_style_text_align(obj, LV_PART_MAIN);
+    if(align == LV_TEXT_ALIGN_RIGHT) x = content.x2 + 1 - get_text_width(numlabel);
+    else if(align == LV_TEXT_ALIGN_CENTER) x += (lv_area_get_width(&content) - get_text_width(numlabel)) / 2;
+
+    uint32_t i;
+    for(i = 0; i < cell_id; i++) x += cell_width(strip, numlabel->cells[i]);
+
+    area->x1 = x;
+    area->x2 = x + cell_width(strip, numlabel->cells[cell_id]) - 1;
+    area->y1 = content.y1;
+    area->y2 = content.y1 + strip->font->line_height - 1;
+}
+
+static void invalidate_changed_cells(lv_obj_t * obj)
+{
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    uint32_t i;
+    for(i = 0; i < numlabel->cell_cnt; i++) {
+        if(numlabel->cells[i] == numlabel->old_cells[i]) continue;
+        lv_area_t a;
+        get_cell_area(obj, i, &a);
+        lv_obj_invalidate_area(obj, &a);
+    }
+}
+
+static void roll_anim_exec(void * var, int32_t v)
+{
+    lv_obj_t * obj = var;
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    if(numlabel->roll_progress == v) return;
+    numlabel->roll_progress = v;
+    invalidate_changed_cells(obj);
+}
+
+static void roll_anim_completed(lv_anim_t * a)
+{
+    lv_obj_t * obj = a->var;
+    lv_numlabel_t * numlabel = (lv_numlabel_t *)obj;
+    numlabel->roll_progress = LV_NUMLABEL_ROLL_RES;
+    invalidate_changed_cells(obj);
+}
+
+/**
+ * Copy a prefix or suffix keeping only the characters that have glyphs
+ */
+static void copy_affix(char * dst, const char * src)
+{
+    uint32_t len = 0;
+    while(src && *src && len < LV_NUMLABEL_AFFIX_MAX) {
+        if(glyph_index(*src) >= 10) dst[len++] = *src;
+        src++;
+    }
+    dst[len] = '\0';
+}
+
+/**
+ * Get the glyph strip of a font, rendering it if no other numeric label uses the font
+ */
+static lv_numlabel_strip_t * strip_get(const lv_font_t * font)
+{
+    if(font == NULL) return NULL;
+
+    lv_numlabel_strip_t * strip;
+    LV_LL_READ(strip_ll_p, strip) {
+        if(strip->font == font) {
+            strip->ref_cnt++;
+            return strip;
+        }
+    }
+
+    /*Measure the glyphs. The digits share the width of the widest one so they don't move while changing*/
+    int32_t widths[LV_NUMLABEL_GLYPH_CNT];
+    int32_t digit_w = 0;
+    int32_t strip_w = 0;
+    uint32_t i;
+    for(i = 0; i < LV_NUMLABEL_GLYPH_CNT; i++) {
+        lv_font_glyph_dsc_t g;
+        widths[i] = lv_font_get_glyph_dsc(font, &g, (uint32_t)glyph_chars[i], 0) ? g.adv_w : 0;
+        if(i < 10) digit_w = LV_MAX(digit_w, widths[i]);
+    }
+    for(i = 0; i < LV_NUMLABEL_GLYPH_CNT; i++) {
+        if(i < 10) widths[i] = digit_w;
+        strip_w += widths[i];
+    }
+
+    int32_t line_h = font->line_height;
+    lv_draw_buf_t * buf = lv_draw_buf_create(LV_MAX(strip_w, 1), LV_MAX(line_h, 1), LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    if(buf == NULL) {
+        LV_LOG_WARN("Couldn't allocate the glyph strip");
+        return NULL;
+    }
+    lv_draw_buf_clear(buf, NULL);
+
+    strip = lv_ll_ins_head(strip_ll_p);
+    LV_ASSERT_MALLOC(strip);
+    if(strip == NULL) {
+        lv_draw_buf_destroy(buf);
+        return NULL;
+    }
+    lv_memzero(strip, sizeof(lv_numlabel_strip_t));
+    strip->font = font;
+    strip->ref_cnt = 1;
+    strip->buf = buf;
+
+    /*Render every glyph into its cell at the same place lv_draw_label would draw it*/
+    uint32_t stride = buf->header.stride;
+    lv_draw_buf_t * tmp = NULL;
+    int32_t x = 0;
+    for(i = 0; i < LV_NUMLABEL_GLYPH_CNT; i++) {
+        lv_image_dsc_t * img = &strip->glyphs[i];
+        img->header.magic = LV_IMAGE_HEADER_MAGIC;
+        img->header.cf = LV_COLOR_FORMAT_A8;
+        img->header.w = (uint32_t)widths[i];
+        img->header.h = (uint32_t)line_h;
+        img->header.stride = stride;
+        img->data = buf->data + x;
+        img->data_size = stride * line_h - x;
+
+        lv_font_glyph_dsc_t g;
+        bool ok = lv_font_get_glyph_dsc(font, &g, (uint32_t)glyph_chars[i], 0);
+        if(ok && g.box_w > 0 && g.box_h > 0 && g.resolved_font &&
+           LV_FONT_GLYPH_FORMAT_NONE < g.format && g.format < LV_FONT_GLYPH_FORMAT_IMAGE) {
+            if(lv_draw_buf_reshape(tmp, LV_COLOR_FORMAT_A8, g.box_w, g.box_h, LV_STRIDE_AUTO) == NULL) {
+                if(tmp) lv_draw_buf_destroy(tmp);
+                tmp = lv_draw_buf_create(g.box_w, g.box_h, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+            }
+            const lv_draw_buf_t * bitmap = tmp ? lv_font_get_glyph_bitmap(&g, tmp) : NULL;
+            if(bitmap) {
+                /*Center the digits in the common width*/
+                int32_t ofs_x = g.ofs_x + (i < 10 ? (widths[i] - g.adv_w) / 2 : 0);
+                int32_t ofs_y = (line_h - font->base_line) - g.box_h - g.ofs_y;
+                int32_t gy;
+                for(gy = 0; gy < (int32_t)g.box_h; gy++) {
+                    int32_t y = ofs_y + gy;
+                    if(y < 0 || y >= line_h) continue;
+                    const uint8_t * src = bitmap->data + gy * bitmap->header.stride;
+                    uint8_t * dst = buf->data + y * stride + x;
+                    int32_t gx;
+                    for(gx = 0; gx < (int32_t)g.box_w; gx++) {
+                        int32_t px = ofs_x + gx;
+                        if(px >= 0 && px < widths[i]) dst[px] = src[gx];
+                    }
+                }
+            }
+            lv_font_glyph_release_draw_data(&g);
+        }
+        x += widths[i];
+    }
+    if(tmp) lv_draw_buf_destroy(tmp);
+
+    return strip;
+}
+
+static void strip_release(lv_numlabel_strip_t * strip)
+{
+    if(strip->ref_cnt > 1) {
+        strip->ref_cnt--;
+        return;
+    }
+
+    /*The image cache might refer to the glyphs as image sources*/
+    uint32_t i;
+    for(i = 0; i < LV_NUMLABEL_GLYPH_CNT; i++) lv_image_cache_drop(&strip->glyphs[i]);
+
+    lv_draw_buf_destroy(strip->buf);
+    lv_ll_remove(strip_ll_p, strip);
+    lv_free(strip);
+}
+
+#endif /*LV_USE_NUMLABEL*/
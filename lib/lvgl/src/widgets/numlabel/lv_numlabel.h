@@ -0,0 +1,113 @@
+/**
+ * @file lv_numlabel.h
+ *
+ */
+
+#ifndef LV_NUMLABEL_H
+#define LV_NUMLABEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../core/lv_obj.h"
+
+#if LV_USE_NUMLABEL
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** Maximal number of characters shown, including the sign, prefix, separators and suffix*/
+#define LV_NUMLABEL_CELL_MAX    24
+
+/** Maximal length of the prefix and of the suffix*/
+#define LV_NUMLABEL_AFFIX_MAX   4
+
+/** Characters a numeric label can show besides the digits. Others in the prefix or suffix are skipped*/
+#define LV_NUMLABEL_SYMBOLS     "-+.,$% "
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+LV_ATTRIBUTE_EXTERN_DATA extern const lv_obj_class_t lv_numlabel_class;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a numeric label. It shows a fixed point number with tabular digits rendered once per font,
+ * and a new value only redraws the characters that changed.
+ * @param parent    pointer to an object, it will be the parent of the new numeric label
+ * @return          pointer to the created numeric label
+ */
+lv_obj_t * lv_numlabel_create(lv_obj_t * parent);
+
+/*=====================
+ * Setter functions
+ *====================*/
+
+/**
+ * Set the value to show
+ * @param obj       pointer to a numeric label
+ * @param value     the value in units of the last decimal, e.g. cents if 2 decimals are shown
+ */
+void lv_numlabel_set_value(lv_obj_t * obj, int64_t value);
+
+/**
+ * Set how the value is written
+ * @param obj       pointer to a numeric label
+ * @param prefix    written after the sign and before the digits, e.g. "$". NULL or "" for none
+ * @param decimals  number of digits after the decimal point (0..9)
+ * @param group_sep separator of the thousands, e.g. ',', or 0 to not group the digits
+ */
+void lv_numlabel_set_format(lv_obj_t * obj, const char * prefix, uint32_t decimals, char group_sep);
+
+/**
+ * Set a text written after the digits, e.g. "%"
+ * @param obj       pointer to a numeric label
+ * @param suffix    the suffix, NULL or "" for none
+ */
+void lv_numlabel_set_suffix(lv_obj_t * obj, const char * suffix);
+
+/**
+ * Set the duration of the roll-over animation of the changed digits
+ * @param obj       pointer to a numeric label
+ * @param time      duration in milliseconds, 0 to change the digits without animation
+ */
+void lv_numlabel_set_roll_time(lv_obj_t * obj, uint32_t time);
+
+/*=====================
+ * Getter functions
+ *====================*/
+
+/**
+ * Get the shown value
+ * @param obj       pointer to a numeric label
+ * @return          the value in units of the last decimal
+ */
+int64_t lv_numlabel_get_value(const lv_obj_t * obj);
+
+/**
+ * Get the text the value is written as
+ * @param obj       pointer to a numeric label
+ * @return          the text, valid until the value or the format changes
+ */
+const char * lv_numlabel_get_text(const lv_obj_t * obj);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_NUMLABEL*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_NUMLABEL_H*/
@@ -0,0 +1,77 @@
+/**
+ * @file lv_numlabel_private.h
+ *
+ */
+
+#ifndef LV_NUMLABEL_PRIVATE_H
+#define LV_NUMLABEL_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../core/lv_obj_private.h"
+#include "../../draw/lv_image_dsc.h"
+#include "lv_numlabel.h"
+
+#if LV_USE_NUMLABEL
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/** Digits followed by LV_NUMLABEL_SYMBOLS*/
+#define LV_NUMLABEL_GLYPH_CNT   (10 + sizeof(LV_NUMLABEL_SYMBOLS) - 1)
+
+/** Steps of the roll-over animation*/
+#define LV_NUMLABEL_ROLL_RES    256
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** The glyphs of a font rendered side by side into one A8 buffer. Shared by the numeric labels using that font.
+ * Every glyph is rendered into a cell as wide as its advance (the widest digit for the digits) and as high as the line*/
+typedef struct {
+    const lv_font_t * font;
+    uint32_t ref_cnt;
+    lv_draw_buf_t * buf;
+    lv_image_dsc_t glyphs[LV_NUMLABEL_GLYPH_CNT];   /**< A window of `buf` per glyph, drawn as A8 images*/
+} lv_numlabel_strip_t;
+
+/** Data of numeric label */
+struct _lv_numlabel_t {
+    lv_obj_t obj;
+    int64_t value;
+    lv_numlabel_strip_t * strip;
+    uint32_t roll_time;
+    char prefix[LV_NUMLABEL_AFFIX_MAX + 1];
+    char suffix[LV_NUMLABEL_AFFIX_MAX + 1];
+    char cells[LV_NUMLABEL_CELL_MAX + 1];       /**< The shown characters, '\0' terminated*/
+    char old_cells[LV_NUMLABEL_CELL_MAX + 1];   /**< The characters rolling out while animating*/
+    uint8_t cell_cnt;
+    uint8_t decimals;
+    char group_sep;
+    uint8_t roll_down : 1;                      /**< 1: the value decreased, digits roll downwards*/
+    int32_t roll_progress;                      /**< 0..LV_NUMLABEL_ROLL_RES while animating*/
+};
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_NUMLABEL*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_NUMLABEL_PRIVATE_H*/
@@ -26,6 +26,12 @@
  *********************/
 #define MY_CLASS (&lv_table_class)
 
+/*Size of the scratch buffer the text of a virtual cell can be formatted into.
+ *Longer texts can be returned from the callback directly.*/
+#ifndef LV_TABLE_VIRTUAL_CELL_TXT_MAX
+    #define LV_TABLE_VIRTUAL_CELL_TXT_MAX 128
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -47,12 +53,35 @@ static size_t get_cell_txt_len(const char * txt);
 static void copy_cell_txt(lv_table_cell_t * dst, const char * txt);
 static void get_cell_area(lv_obj_t * obj, uint32_t row, uint32_t col, lv_area_t * area);
 static void scroll_to_selected_cell(lv_obj_t * obj);
+static int32_t get_row_y(lv_obj_t * obj, uint32_t row);
+static void free_cells(lv_obj_t * obj);
 
 static inline bool is_cell_empty(void * cell)
 {
     return cell == NULL;
 }
 
+static inline bool is_virtual(lv_table_t * table)
+{
+    return table->cell_data_cb != NULL;
+}
+
+static inline int32_t get_row_h(lv_table_t * table, uint32_t row)
+{
+    return is_virtual(table) ? table->virtual_row_h : table->row_h[row];
+}
+
+static inline bool in_batch(lv_table_t * table)
+{
+    return table->batch_depth > 0;
+}
+
+/* Remember that rows from `row` need to be measured when the batch is committed */
+static inline void batch_mark_dirty(lv_table_t * table, uint32_t row)
+{
+    if(table->batch_dirty_row == LV_TABLE_CELL_NONE || row < table->batch_dirty_row) table->batch_dirty_row = row;
+}
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -95,6 +124,11 @@ void lv_table_set_cell_value(lv_obj_t * obj, uint32_t row, uint32_t col, const c
 
     lv_table_t * table = (lv_table_t *)obj;
 
+    if(is_virtual(table)) {
+        LV_LOG_WARN("not supported in virtual mode");
+        return;
+    }
+
     /*Auto expand*/
     if(col >= table->col_cnt) lv_table_set_column_count(obj, col + 1);
     if(row >= table->row_cnt) lv_table_set_row_count(obj, row + 1);
@@ -129,6 +163,12 @@ void lv_table_set_cell_value_fmt(lv_obj_t * obj, uint32_t row, uint32_t col, con
     LV_ASSERT_NULL(fmt);
 
     lv_table_t * table = (lv_table_t *)obj;
+
+    if(is_virtual(table)) {
+        LV_LOG_WARN("not supported in virtual mode");
+        return;
+    }
+
     if(col >= table->col_cnt) {
         lv_table_set_column_count(obj, col + 1);
     }
@@ -208,13 +248,33 @@ void lv_table_set_row_count(lv_obj_t * obj, uint32_t row_cnt)
 
     if(table->row_cnt == row_cnt) return;
 
+    /*All rows have the same height so there is nothing to allocate or measure*/
+    if(is_virtual(table)) {
+        uint32_t old_row_cnt = table->row_cnt;
+        table->row_cnt = row_cnt;
+        if(table->row_act != LV_TABLE_CELL_NONE && table->row_act >= row_cnt) table->row_act = LV_TABLE_CELL_NONE;
+
+        /*The size is updated once when the batch is committed*/
+        if(in_batch(table)) {
+            batch_mark_dirty(table, LV_MIN(old_row_cnt, row_cnt));
+            return;
+        }
+
+        lv_obj_refresh_self_size(obj);
+
+        /*Only the changed rows need to be redrawn*/
+        lv_area_t a;
+        a.x1 = obj->coords.x1;
+        a.x2 = obj->coords.x2;
+        a.y1 = obj->coords.y1 + get_row_y(obj, LV_MIN(old_row_cnt, row_cnt));
+        a.y2 = obj->coords.y2;
+        lv_obj_invalidate_area(obj, &a);
+        return;
+    }
+
     uint32_t old_row_cnt = table->row_cnt;
     table->row_cnt         = row_cnt;
 
-    table->row_h = lv_realloc(table->row_h, table->row_cnt * sizeof(table->row_h[0]));
-    LV_ASSERT_MALLOC(table->row_h);
-    if(table->row_h == NULL) return;
-
     /*Free the unused cells*/
     if(old_row_cnt > row_cnt) {
         uint32_t old_cell_cnt = old_row_cnt * table->col_cnt;
@@ -226,21 +286,37 @@ void lv_table_set_row_count(lv_obj_t * obj, uint32_t row_cnt)
                 table->cell_data[i]->user_data = NULL;
             }
             lv_free(table->cell_data[i]);
+            table->cell_data[i] = NULL;
         }
     }
 
-    table->cell_data = lv_realloc(table->cell_data, table->row_cnt * table->col_cnt * sizeof(lv_table_cell_t *));
-    LV_ASSERT_MALLOC(table->cell_data);
-    if(table->cell_data == NULL) return;
+    /*In a batch grow the capacity geometrically to avoid a realloc for every added row.
+     *Otherwise keep the arrays exactly as large as needed.*/
+    uint32_t new_cap = row_cnt;
+    if(in_batch(table)) new_cap = row_cnt > table->row_cap ? LV_MAX(row_cnt, table->row_cap * 2) : table->row_cap;
+
+    if(new_cap != table->row_cap) {
+        int32_t * new_row_h = lv_realloc(table->row_h, new_cap * sizeof(table->row_h[0]));
+        LV_ASSERT_MALLOC(new_row_h);
+        if(new_row_h == NULL) return;
+        table->row_h = new_row_h;
+
+        lv_table_cell_t ** new_cell_data = lv_realloc(table->cell_data, new_cap * table->col_cnt * sizeof(lv_table_cell_t *));
+        LV_ASSERT_MALLOC(new_cell_data);
+        if(new_cell_data == NULL) return;
+        table->cell_data = new_cell_data;
+        table->row_cap = new_cap;
+    }
 
     /*Initialize the new fields*/
     if(old_row_cnt < row_cnt) {
         uint32_t old_cell_cnt = old_row_cnt * table->col_cnt;
         uint32_t new_cell_cnt = table->col_cnt * table->row_cnt;
         lv_memzero(&table->cell_data[old_cell_cnt], (new_cell_cnt - old_cell_cnt) * sizeof(table->cell_data[0]));
+        lv_memzero(&table->row_h[old_row_cnt], (row_cnt - old_row_cnt) * sizeof(table->row_h[0]));
     }
 
-    refr_size_form_row(obj, 0);
+    refr_size_form_row(obj, in_batch(table) ? LV_MIN(old_row_cnt, row_cnt) : 0);
 }
 
 void lv_table_set_column_count(lv_obj_t * obj, uint32_t col_cnt)
@@ -254,40 +330,43 @@ void lv_table_set_column_count(lv_obj_t * obj, uint32_t col_cnt)
     uint32_t old_col_cnt = table->col_cnt;
     table->col_cnt         = col_cnt;
 
-    lv_table_cell_t ** new_cell_data = lv_malloc(table->row_cnt * table->col_cnt * sizeof(lv_table_cell_t *));
-    LV_ASSERT_MALLOC(new_cell_data);
-    if(new_cell_data == NULL) return;
-    uint32_t new_cell_cnt = table->col_cnt * table->row_cnt;
+    if(!is_virtual(table)) {
+        /*Keep the spare rows of a batch so appending rows doesn't realloc again*/
+        lv_table_cell_t ** new_cell_data = lv_malloc(table->row_cap * table->col_cnt * sizeof(lv_table_cell_t *));
+        LV_ASSERT_MALLOC(new_cell_data);
+        if(new_cell_data == NULL) return;
+        uint32_t new_cell_cnt = table->col_cnt * table->row_cnt;
 
-    lv_memzero(new_cell_data, new_cell_cnt * sizeof(table->cell_data[0]));
+        lv_memzero(new_cell_data, new_cell_cnt * sizeof(table->cell_data[0]));
 
-    /*The new column(s) messes up the mapping of `cell_data`*/
-    uint32_t old_col_start;
-    uint32_t new_col_start;
-    uint32_t min_col_cnt = LV_MIN(old_col_cnt, col_cnt);
-    uint32_t row;
-    for(row = 0; row < table->row_cnt; row++) {
-        old_col_start = row * old_col_cnt;
-        new_col_start = row * col_cnt;
-
-        lv_memcpy(&new_cell_data[new_col_start], &table->cell_data[old_col_start],
-                  sizeof(new_cell_data[0]) * min_col_cnt);
-
-        /*Free the old cells (only if the table becomes smaller)*/
-        int32_t i;
-        for(i = 0; i < (int32_t)old_col_cnt - (int32_t)col_cnt; i++) {
-            uint32_t idx = old_col_start + min_col_cnt + i;
-            if(table->cell_data[idx] && table->cell_data[idx]->user_data) {
-                lv_free(table->cell_data[idx]->user_data);
-                table->cell_data[idx]->user_data = NULL;
+        /*The new column(s) messes up the mapping of `cell_data`*/
+        uint32_t old_col_start;
+        uint32_t new_col_start;
+        uint32_t min_col_cnt = LV_MIN(old_col_cnt, col_cnt);
+        uint32_t row;
+        for(row = 0; row < table->row_cnt; row++) {
+            old_col_start = row * old_col_cnt;
+            new_col_start = row * col_cnt;
+
+            lv_memcpy(&new_cell_data[new_col_start], &table->cell_data[old_col_start],
+                      sizeof(new_cell_data[0]) * min_col_cnt);
+
+            /*Free the old cells (only if the table becomes smaller)*/
+            int32_t i;
+            for(i = 0; i < (int32_t)old_col_cnt - (int32_t)col_cnt; i++) {
+                uint32_t idx = old_col_start + min_col_cnt + i;
+                if(table->cell_data[idx] && table->cell_data[idx]->user_data) {
+                    lv_free(table->cell_data[idx]->user_data);
+                    table->cell_data[idx]->user_data = NULL;
+                }
+                lv_free(table->cell_data[idx]);
+                table->cell_data[idx] = NULL;
             }
-            lv_free(table->cell_data[idx]);
-            table->cell_data[idx] = NULL;
         }
-    }
 
-    lv_free(table->cell_data);
-    table->cell_data = new_cell_data;
+        lv_free(table->cell_data);
+        table->cell_data = new_cell_data;
+    }
 
     /*Initialize the new column widths if any*/
     table->col_w = lv_realloc(table->col_w, col_cnt * sizeof(table->col_w[0]));
@@ -321,6 +400,11 @@ void lv_table_add_cell_ctrl(lv_obj_t * obj, uint32_t row, uint32_t col, lv_table
 
     lv_table_t * table = (lv_table_t *)obj;
 
+    if(is_virtual(table)) {
+        LV_LOG_WARN("not supported in virtual mode");
+        return;
+    }
+
     /*Auto expand*/
     if(col >= table->col_cnt) lv_table_set_column_count(obj, col + 1);
     if(row >= table->row_cnt) lv_table_set_row_count(obj, row + 1);
@@ -346,6 +430,11 @@ void lv_table_clear_cell_ctrl(lv_obj_t * obj, uint32_t row, uint32_t col, lv_tab
 
     lv_table_t * table = (lv_table_t *)obj;
 
+    if(is_virtual(table)) {
+        LV_LOG_WARN("not supported in virtual mode");
+        return;
+    }
+
     /*Auto expand*/
     if(col >= table->col_cnt) lv_table_set_column_count(obj, col + 1);
     if(row >= table->row_cnt) lv_table_set_row_count(obj, row + 1);
@@ -371,6 +460,11 @@ void lv_table_set_cell_user_data(lv_obj_t * obj, uint16_t row, uint16_t col, voi
 
     lv_table_t * table = (lv_table_t *)obj;
 
+    if(is_virtual(table)) {
+        LV_LOG_WARN("not supported in virtual mode");
+        return;
+    }
+
     /*Auto expand*/
     if(col >= table->col_cnt) lv_table_set_column_count(obj, col + 1);
     if(row >= table->row_cnt) lv_table_set_row_count(obj, row + 1);
@@ -394,6 +488,79 @@ void lv_table_set_cell_user_data(lv_obj_t * obj, uint16_t row, uint16_t col, voi
     table->cell_data[cell]->user_data = user_data;
 }
 
+void lv_table_set_cell_data_cb(lv_obj_t * obj, lv_table_cell_data_cb_t cb)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_table_t * table = (lv_table_t *)obj;
+
+    if(table->cell_data_cb == cb) return;
+
+    if(cb) {
+        /*Nothing is stored per row or cell in virtual mode*/
+        free_cells(obj);
+        lv_free(table->cell_data);
+        lv_free(table->row_h);
+        table->cell_data = NULL;
+        table->row_h = NULL;
+        table->row_cap = 0;
+    }
+    else {
+        table->cell_data = lv_malloc_zeroed(table->row_cnt * table->col_cnt * sizeof(lv_table_cell_t *));
+        LV_ASSERT_MALLOC(table->cell_data);
+        table->row_h = lv_malloc_zeroed(table->row_cnt * sizeof(table->row_h[0]));
+        LV_ASSERT_MALLOC(table->row_h);
+        table->row_cap = table->row_cnt;
+    }
+
+    table->cell_data_cb = cb;
+    refr_size_form_row(obj, 0);
+}
+
+void lv_table_begin_batch(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_table_t * table = (lv_table_t *)obj;
+    if(table->batch_depth == 0) table->batch_dirty_row = LV_TABLE_CELL_NONE;
+    table->batch_depth++;
+}
+
+void lv_table_commit_batch(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_table_t * table = (lv_table_t *)obj;
+    if(table->batch_depth == 0) {
+        LV_LOG_WARN("no batch to commit");
+        return;
+    }
+
+    table->batch_depth--;
+    if(table->batch_depth > 0) return;
+
+    if(table->batch_dirty_row != LV_TABLE_CELL_NONE) {
+        uint32_t start_row = table->batch_dirty_row;
+        table->batch_dirty_row = LV_TABLE_CELL_NONE;
+        refr_size_form_row(obj, start_row);
+    }
+}
+
+void lv_table_invalidate_row(lv_obj_t * obj, uint32_t row)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_table_t * table = (lv_table_t *)obj;
+    if(row >= table->row_cnt) return;
+
+    lv_area_t a;
+    a.x1 = obj->coords.x1;
+    a.x2 = obj->coords.x2;
+    a.y1 = obj->coords.y1 + get_row_y(obj, row);
+    a.y2 = a.y1 + get_row_h(table, row) - 1 + lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    lv_obj_invalidate_area(obj, &a);
+}
+
 void lv_table_set_selected_cell(lv_obj_t * obj, uint16_t row, uint16_t col)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
@@ -427,6 +594,8 @@ const char * lv_table_get_cell_value(lv_obj_t * obj, uint32_t row, uint32_t col)
         LV_LOG_WARN("invalid row or column");
         return "";
     }
+    if(is_virtual(table)) return "";
+
     uint32_t cell = row * table->col_cnt + col;
 
     if(is_cell_empty(table->cell_data[cell])) return "";
@@ -473,6 +642,8 @@ bool lv_table_has_cell_ctrl(lv_obj_t * obj, uint32_t row, uint32_t col, lv_table
         LV_LOG_WARN("invalid row or column");
         return false;
     }
+    if(is_virtual(table)) return false;
+
     uint32_t cell = row * table->col_cnt + col;
 
     if(is_cell_empty(table->cell_data[cell])) return false;
@@ -486,6 +657,14 @@ void lv_table_get_selected_cell(lv_obj_t * obj, uint32_t * row, uint32_t * col)
     *col = table->col_act;
 }
 
+lv_table_cell_data_cb_t lv_table_get_cell_data_cb(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_table_t * table = (lv_table_t *)obj;
+    return table->cell_data_cb;
+}
+
 void * lv_table_get_cell_user_data(lv_obj_t * obj, uint16_t row, uint16_t col)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
@@ -495,6 +674,8 @@ void * lv_table_get_cell_user_data(lv_obj_t * obj, uint16_t row, uint16_t col)
         LV_LOG_WARN("invalid row or column");
         return NULL;
     }
+    if(is_virtual(table)) return NULL;
+
     uint32_t cell = row * table->col_cnt + col;
 
     if(is_cell_empty(table->cell_data[cell])) return NULL;
@@ -523,6 +704,8 @@ static void lv_table_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     table->cell_data[0] = NULL;
     table->row_act = LV_TABLE_CELL_NONE;
     table->col_act = LV_TABLE_CELL_NONE;
+    table->row_cap = table->row_cnt;
+    table->batch_dirty_row = LV_TABLE_CELL_NONE;
 
     LV_TRACE_OBJ_CREATE("finished");
 }
@@ -532,17 +715,7 @@ static void lv_table_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     LV_UNUSED(class_p);
     lv_table_t * table = (lv_table_t *)obj;
     /*Free the cell texts*/
-    uint32_t i;
-    for(i = 0; i < table->col_cnt * table->row_cnt; i++) {
-        if(table->cell_data[i]) {
-            if(table->cell_data[i]->user_data) {
-                lv_free(table->cell_data[i]->user_data);
-                table->cell_data[i]->user_data = NULL;
-            }
-            lv_free(table->cell_data[i]);
-            table->cell_data[i] = NULL;
-        }
-    }
+    free_cells(obj);
 
     if(table->cell_data) lv_free(table->cell_data);
     if(table->row_h) lv_free(table->row_h);
@@ -573,7 +746,8 @@ static void lv_table_event(const lv_obj_class_t * class_p, lv_event_t * e)
         for(i = 0; i < table->col_cnt; i++) w += table->col_w[i];
 
         int32_t h = 0;
-        for(i = 0; i < table->row_cnt; i++) h += table->row_h[i];
+        if(is_virtual(table)) h = (int32_t)table->row_cnt * table->virtual_row_h;
+        else for(i = 0; i < table->row_cnt; i++) h += table->row_h[i];
 
         p->x = w - 1;
         p->y = h - 1;
@@ -705,9 +879,18 @@ static void draw_main(lv_event_t * e)
     obj->state = state_ori;
     obj->skip_trans = 0;
 
+    /*The borders of the cells are drawn half into the neighbor cells (see below),
+     *so a row is skipped only if its border is out of the clip area too*/
+    int32_t border_out_top = (rect_dsc_def.border_side & LV_BORDER_SIDE_TOP) ? rect_dsc_def.border_width / 2 : 0;
+    int32_t border_out_bottom = (rect_dsc_def.border_side & LV_BORDER_SIDE_BOTTOM) ?
+                                rect_dsc_def.border_width / 2 + (rect_dsc_def.border_width & 0x1) : 0;
+
     uint32_t col;
     uint32_t row;
+    uint32_t row_start = 0;
     uint32_t cell = 0;
+    bool virtual_mode = is_virtual(table);
+    char virtual_txt[LV_TABLE_VIRTUAL_CELL_TXT_MAX];
 
     cell_area.y2 = obj->coords.y1 + bg_top - 1 - lv_obj_get_scroll_y(obj) + border_width;
     cell_area.x1 = 0;
@@ -715,21 +898,28 @@ static void draw_main(lv_event_t * e)
     int32_t scroll_x = lv_obj_get_scroll_x(obj) ;
     bool rtl = lv_obj_get_style_base_dir(obj, LV_PART_MAIN) == LV_BASE_DIR_RTL;
 
+    /*In virtual mode jump directly to the first visible row*/
+    if(virtual_mode && table->virtual_row_h > 0 && clip_area.y1 - border_out_bottom > cell_area.y2) {
+        row_start = (clip_area.y1 - border_out_bottom - cell_area.y2 - 1) / table->virtual_row_h;
+        cell_area.y2 += row_start * table->virtual_row_h;
+    }
+
     /*Handle custom drawer*/
-    for(row = 0; row < table->row_cnt; row++) {
-        int32_t h_row = table->row_h[row];
+    for(row = row_start; row < table->row_cnt; row++) {
+        int32_t h_row = get_row_h(table, row);
 
         cell_area.y1 = cell_area.y2 + 1;
         cell_area.y2 = cell_area.y1 + h_row - 1;
 
-        if(cell_area.y1 > clip_area.y2) break;
+        if(cell_area.y1 - border_out_top > clip_area.y2) break;
 
         if(rtl) cell_area.x1 = obj->coords.x2 - bg_right - 1 - scroll_x - border_width;
         else cell_area.x2 = obj->coords.x1 + bg_left - 1 - scroll_x + border_width;
 
         for(col = 0; col < table->col_cnt; col++) {
+            lv_table_cell_t * cell_data = virtual_mode ? NULL : table->cell_data[cell];
             lv_table_cell_ctrl_t ctrl = 0;
-            if(table->cell_data[cell]) ctrl = table->cell_data[cell]->ctrl;
+            if(cell_data) ctrl = cell_data->ctrl;
 
             if(rtl) {
                 cell_area.x2 = cell_area.x1 - 1;
@@ -741,7 +931,7 @@ static void draw_main(lv_event_t * e)
             }
 
             uint32_t col_merge = 0;
-            for(col_merge = 0; col_merge + col < table->col_cnt - 1; col_merge++) {
+            for(col_merge = 0; !virtual_mode && col_merge + col < table->col_cnt - 1; col_merge++) {
                 lv_table_cell_t * next_cell_data = table->cell_data[cell + col_merge];
 
                 if(is_cell_empty(next_cell_data)) break;
@@ -758,7 +948,7 @@ static void draw_main(lv_event_t * e)
                 }
             }
 
-            if(cell_area.y2 < clip_area.y1) {
+            if(cell_area.y2 + border_out_bottom < clip_area.y1) {
                 cell += col_merge + 1;
                 col += col_merge;
                 continue;
@@ -813,7 +1003,26 @@ static void draw_main(lv_event_t * e)
 
             lv_draw_rect(layer, &rect_dsc_act, &cell_area_border);
 
-            if(table->cell_data[cell]) {
+            const char * txt = NULL;
+            if(virtual_mode) {
+                virtual_txt[0] = '\0';
+                txt = table->cell_data_cb(obj, row, col, virtual_txt, sizeof(virtual_txt));
+                if(txt == virtual_txt) {
+                    virtual_txt[sizeof(virtual_txt) - 1] = '\0';
+                    /*A full buffer means the text was most likely cut. Longer texts should be returned directly.*/
+                    if(lv_strlen(virtual_txt) == sizeof(virtual_txt) - 1) {
+                        LV_LOG_WARN("the text of cell %" LV_PRIu32 ", %" LV_PRIu32 " may be truncated to %d bytes",
+                                    row, col, LV_TABLE_VIRTUAL_CELL_TXT_MAX - 1);
+                    }
+                }
+                /*The buffer is reused for the next cell so the draw task needs its own copy*/
+                label_dsc_act.text_local = 1;
+            }
+            else if(cell_data) {
+                txt = cell_data->txt;
+            }
+
+            if(txt) {
                 const int32_t cell_left = lv_obj_get_style_pad_left(obj, LV_PART_ITEMS);
                 const int32_t cell_right = lv_obj_get_style_pad_right(obj, LV_PART_ITEMS);
                 const int32_t cell_top = lv_obj_get_style_pad_top(obj, LV_PART_ITEMS);
@@ -830,7 +1039,7 @@ static void draw_main(lv_event_t * e)
                 bool crop = ctrl & LV_TABLE_CELL_CTRL_TEXT_CROP;
                 if(crop) txt_flags = LV_TEXT_FLAG_EXPAND;
 
-                lv_text_get_size(&txt_size, table->cell_data[cell]->txt, label_dsc_def.font,
+                lv_text_get_size(&txt_size, txt, label_dsc_def.font,
                                  label_dsc_act.letter_space, label_dsc_act.line_space,
                                  lv_area_get_width(&txt_area), txt_flags);
 
@@ -845,7 +1054,7 @@ static void draw_main(lv_event_t * e)
                 label_mask_ok = lv_area_intersect(&label_clip_area, &clip_area, &cell_area);
                 if(label_mask_ok) {
                     layer->_clip_area = label_clip_area;
-                    label_dsc_act.text = table->cell_data[cell]->txt;
+                    label_dsc_act.text = txt;
                     lv_draw_label(layer, &label_dsc_act, &txt_area);
                     layer->_clip_area = clip_area;
                 }
@@ -862,6 +1071,12 @@ static void draw_main(lv_event_t * e)
 /* Refreshes size of the table starting from @start_row row */
 static void refr_size_form_row(lv_obj_t * obj, uint32_t start_row)
 {
+    lv_table_t * table = (lv_table_t *)obj;
+    if(in_batch(table)) {
+        batch_mark_dirty(table, start_row);
+        return;
+    }
+
     const int32_t cell_pad_left = lv_obj_get_style_pad_left(obj, LV_PART_ITEMS);
     const int32_t cell_pad_right = lv_obj_get_style_pad_right(obj, LV_PART_ITEMS);
     const int32_t cell_pad_top = lv_obj_get_style_pad_top(obj, LV_PART_ITEMS);
@@ -874,7 +1089,19 @@ static void refr_size_form_row(lv_obj_t * obj, uint32_t start_row)
     const int32_t minh = lv_obj_get_style_min_height(obj, LV_PART_ITEMS);
     const int32_t maxh = lv_obj_get_style_max_height(obj, LV_PART_ITEMS);
 
-    lv_table_t * table = (lv_table_t *)obj;
+    if(is_virtual(table)) {
+        /*Cells are not known in advance so use one line of text for every row*/
+        int32_t h = lv_font_get_line_height(font) + cell_pad_top + cell_pad_bottom;
+        table->virtual_row_h = LV_CLAMP(minh, h, maxh);
+        LV_UNUSED(cell_pad_left);
+        LV_UNUSED(cell_pad_right);
+        LV_UNUSED(letter_space);
+        LV_UNUSED(line_space);
+        lv_obj_refresh_self_size(obj);
+        lv_obj_invalidate(obj);
+        return;
+    }
+
     uint32_t i;
     for(i = start_row; i < table->row_cnt; i++) {
         int32_t calculated_height = get_row_height(obj, i, font, letter_space, line_space,
@@ -888,6 +1115,12 @@ static void refr_size_form_row(lv_obj_t * obj, uint32_t start_row)
 
 static void refr_cell_size(lv_obj_t * obj, uint32_t row, uint32_t col)
 {
+    lv_table_t * table = (lv_table_t *)obj;
+    if(in_batch(table)) {
+        batch_mark_dirty(table, row);
+        return;
+    }
+
     const int32_t cell_pad_left = lv_obj_get_style_pad_left(obj, LV_PART_ITEMS);
     const int32_t cell_pad_right = lv_obj_get_style_pad_right(obj, LV_PART_ITEMS);
     const int32_t cell_pad_top = lv_obj_get_style_pad_top(obj, LV_PART_ITEMS);
@@ -900,7 +1133,6 @@ static void refr_cell_size(lv_obj_t * obj, uint32_t row, uint32_t col)
     const int32_t minh = lv_obj_get_style_min_height(obj, LV_PART_ITEMS);
     const int32_t maxh = lv_obj_get_style_max_height(obj, LV_PART_ITEMS);
 
-    lv_table_t * table = (lv_table_t *)obj;
     int32_t calculated_height = get_row_height(obj, row, font, letter_space, line_space,
                                                cell_pad_left, cell_pad_right, cell_pad_top, cell_pad_bottom);
 
@@ -1033,11 +1265,19 @@ static lv_result_t get_pressed_cell(lv_obj_t * obj, uint32_t * row, uint32_t * c
         *row = 0;
         tmp = 0;
 
-        for(*row = 0; *row < table->row_cnt; (*row)++) {
-            tmp += table->row_h[*row];
-            if(y < tmp) {
-                is_click_on_valid_row = true;
-                break;
+        if(is_virtual(table)) {
+            if(y >= 0 && table->virtual_row_h > 0) {
+                *row = y / table->virtual_row_h;
+                is_click_on_valid_row = *row < table->row_cnt;
+            }
+        }
+        else {
+            for(*row = 0; *row < table->row_cnt; (*row)++) {
+                tmp += table->row_h[*row];
+                if(y < tmp) {
+                    is_click_on_valid_row = true;
+                    break;
+                }
             }
         }
     }
@@ -1098,15 +1338,8 @@ static void get_cell_area(lv_obj_t * obj, uint32_t row, uint32_t col, lv_area_t
         area->x2 = area->x1 + table->col_w[col] - 1;
     }
 
-    uint32_t r;
-    area->y1 = 0;
-    for(r = 0; r < row; r++) {
-        area->y1 += table->row_h[r];
-    }
-
-    area->y1 += lv_obj_get_style_pad_top(obj, 0);
-    area->y1 -= lv_obj_get_scroll_y(obj);
-    area->y2 = area->y1 + table->row_h[row] - 1;
+    area->y1 = get_row_y(obj, row);
+    area->y2 = area->y1 + get_row_h(table, row) - 1;
 
 }
 
@@ -1131,4 +1364,44 @@ static void scroll_to_selected_cell(lv_obj_t * obj)
     }
 
 }
+
+/* Returns the top of a row relative to the table's coordinates, including the top padding and the scroll */
+static int32_t get_row_y(lv_obj_t * obj, uint32_t row)
+{
+    lv_table_t * table = (lv_table_t *)obj;
+
+    int32_t y = 0;
+    if(is_virtual(table)) {
+        y = (int32_t)row * table->virtual_row_h;
+    }
+    else {
+        uint32_t r;
+        for(r = 0; r < row; r++) {
+            y += table->row_h[r];
+        }
+    }
+
+    y += lv_obj_get_style_pad_top(obj, 0);
+    y -= lv_obj_get_scroll_y(obj);
+    return y;
+}
+
+/* Frees the stored cells and their user data, but not the `cell_data` array itself */
+static void free_cells(lv_obj_t * obj)
+{
+    lv_table_t * table = (lv_table_t *)obj;
+    if(table->cell_data == NULL) return;
+
+    uint32_t i;
+    for(i = 0; i < table->col_cnt * table->row_cnt; i++) {
+        if(table->cell_data[i]) {
+            if(table->cell_data[i]->user_data) {
+                lv_free(table->cell_data[i]->user_data);
+                table->cell_data[i]->user_data = NULL;
+            }
+            lv_free(table->cell_data[i]);
+            table->cell_data[i] = NULL;
+        }
+    }
+}
 #endif
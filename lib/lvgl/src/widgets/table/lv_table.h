@@ -42,6 +42,20 @@ typedef enum {
     LV_TABLE_CELL_CTRL_CUSTOM_4    = 1 << 7,
 } lv_table_cell_ctrl_t;
 
+/**
+ * Get the text of a cell in a virtual table. Called only for the visible cells while drawing.
+ * @param obj           pointer to the Table object
+ * @param row           id of the row [0 .. row_cnt -1]
+ * @param col           id of the column [0 .. col_cnt -1]
+ * @param buf           scratch buffer the text can be formatted into
+ * @param buf_size      size of `buf` in bytes (`LV_TABLE_VIRTUAL_CELL_TXT_MAX`)
+ * @return              the '\0' terminated text of the cell: `buf` or any string of any length which
+ *                      stays valid until the callback returns. NULL means an empty cell.
+ *                      The text is copied by the table.
+ */
+typedef const char * (*lv_table_cell_data_cb_t)(lv_obj_t * obj, uint32_t row, uint32_t col, char * buf,
+                                                 uint32_t buf_size);
+
 LV_ATTRIBUTE_EXTERN_DATA extern const lv_obj_class_t lv_table_class;
 
 /**********************
@@ -84,6 +98,7 @@ void lv_table_set_cell_value_fmt(lv_obj_t * obj, uint32_t row, uint32_t col, con
  * Set the number of rows
  * @param obj           table pointer to a Table object
  * @param row_cnt       number of rows
+ * @note                In virtual mode it's O(1) so rows can be appended one by one cheaply
  */
 void lv_table_set_row_count(lv_obj_t * obj, uint32_t row_cnt);
 
@@ -132,6 +147,40 @@ void lv_table_clear_cell_ctrl(lv_obj_t * obj, uint32_t row, uint32_t col, lv_tab
  */
 void lv_table_set_cell_user_data(lv_obj_t * obj, uint16_t row, uint16_t col, void * user_data);
 
+/**
+ * Make the table virtual: cells are not stored but `cb` is called to get the text of the visible cells
+ * when the table is drawn. Memory usage doesn't depend on the row count and all rows have the same height
+ * (the line height of the font plus the padding of `LV_PART_ITEMS`).
+ * Cell control bits, merging and user data are not supported in this mode.
+ * @param obj       pointer to a Table object
+ * @param cb        callback to get the text of a cell, or NULL to go back to storing the cells.
+ *                  Switching mode drops the cells stored so far.
+ */
+void lv_table_set_cell_data_cb(lv_obj_t * obj, lv_table_cell_data_cb_t cb);
+
+/**
+ * Redraw a row of a virtual table, e.g. when the data behind it has changed.
+ * @param obj       pointer to a Table object
+ * @param row       id of the row [0 .. row_cnt -1]
+ */
+void lv_table_invalidate_row(lv_obj_t * obj, uint32_t row);
+
+/**
+ * Start a batch of changes. Until `lv_table_commit_batch` is called, setting cell values, the row/column count,
+ * column widths or styles doesn't measure the text, resize or invalidate the table; it's done once on commit.
+ * Rows are also allocated in bigger steps so adding them one by one doesn't reallocate every time.
+ * Batches can be nested, only the outermost commit applies the changes.
+ * @param obj       pointer to a Table object
+ */
+void lv_table_begin_batch(lv_obj_t * obj);
+
+/**
+ * Finish a batch started with `lv_table_begin_batch`: measure the changed rows, update the size
+ * and invalidate the table once.
+ * @param obj       pointer to a Table object
+ */
+void lv_table_commit_batch(lv_obj_t * obj);
+
 /**
  * Set the selected cell
  * @param obj       pointer to a table object
@@ -193,6 +242,13 @@ bool lv_table_has_cell_ctrl(lv_obj_t * obj, uint32_t row, uint32_t col, lv_table
  */
 void lv_table_get_selected_cell(lv_obj_t * obj, uint32_t * row, uint32_t * col);
 
+/**
+ * Get the callback of a virtual table
+ * @param obj       pointer to a Table object
+ * @return          the callback set by `lv_table_set_cell_data_cb` or NULL if the table is not virtual
+ */
+lv_table_cell_data_cb_t lv_table_get_cell_data_cb(lv_obj_t * obj);
+
 /**
  * Get custom user data to the cell.
  * @param obj       pointer to a Table object
@@ -44,6 +44,11 @@ struct _lv_table_t {
     int32_t * col_w;
     uint32_t col_act;
     uint32_t row_act;
+    lv_table_cell_data_cb_t cell_data_cb;   /**< Set in virtual mode, `cell_data` and `row_h` are NULL then */
+    int32_t virtual_row_h;                  /**< Height of every row in virtual mode */
+    uint32_t row_cap;                       /**< Number of rows `cell_data` and `row_h` have room for */
+    uint32_t batch_depth;                   /**< Nesting level of `lv_table_begin_batch` */
+    uint32_t batch_dirty_row;               /**< First row to measure on commit or LV_TABLE_CELL_NONE */
 };
 
 
@@ -0,0 +1,189 @@
+#include "asset_fs.h"
+#include <string.h>
+#include "esp_log.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_partition.h"
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define HEADER_SIZE 8
+#define ENTRY_SIZE (ASSET_FS_NAME_LEN + 8)
+
+static const char *ASSET_TAG = "Asset FS";
+
+// An open file is only a window into the mapping
+typedef struct {
+    const uint8_t* data;
+    uint32_t size;
+    uint32_t pos;
+} asset_file_t;
+
+static const uint8_t* pack = NULL;
+static size_t pack_size = 0;
+static uint16_t entry_count = 0;
+static lv_fs_drv_t fs_drv;
+
+static uint32_t get_u32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// -----------------------  Mapping  -----------------------
+#ifdef ESP_PLATFORM
+static esp_err_t map_pack(void) {
+    const esp_partition_t* part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "assets");
+    if(!part) return ESP_ERR_NOT_FOUND;
+
+    // Reads through the cache from here on, nothing is copied to RAM
+    esp_partition_mmap_handle_t handle;
+    const void* ptr;
+    esp_err_t err = esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &ptr, &handle);
+    if(err != ESP_OK) return err;
+    pack = ptr;
+    pack_size = part->size;
+    return ESP_OK;
+}
+#else
+static esp_err_t map_pack(void) {
+    int fd = open(ASSET_FS_HOST_PATH, O_RDONLY);
+    if(fd < 0) return ESP_ERR_NOT_FOUND;
+    struct stat st;
+    void* ptr = MAP_FAILED;
+    if(fstat(fd, &st) == 0 && st.st_size > 0) ptr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping stays valid
+    if(ptr == MAP_FAILED) return ESP_FAIL;
+    pack = ptr;
+    pack_size = st.st_size;
+    return ESP_OK;
+}
+#endif
+
+// Returns the directory entry of `name` or NULL
+static const uint8_t* find_entry(const char* name) {
+    if(!pack) return NULL;
+    while(*name == '/') name++;
+    size_t len = strlen(name);
+    if(len >= ASSET_FS_NAME_LEN) return NULL;
+
+    const uint8_t* entry = pack + HEADER_SIZE;
+    for(uint16_t i = 0; i < entry_count; i++, entry += ENTRY_SIZE) {
+        if(memcmp(entry, name, len) == 0 && entry[len] == '\0') return entry;
+    }
+    return NULL;
+}
+
+// -----------------------  lv_fs driver  -----------------------
+static void* fs_open(lv_fs_drv_t* drv, const char* path, lv_fs_mode_t mode) {
+    if(mode & LV_FS_MODE_WR) return NULL; // Flash is read-only
+    const uint8_t* entry = find_entry(path);
+    if(!entry) return NULL;
+
+    asset_file_t* file = lv_malloc(sizeof(asset_file_t));
+    if(!file) return NULL;
+    file->data = pack + get_u32(entry + ASSET_FS_NAME_LEN);
+    file->size = get_u32(entry + ASSET_FS_NAME_LEN + 4);
+    file->pos = 0;
+    return file;
+}
+
+static lv_fs_res_t fs_close(lv_fs_drv_t* drv, void* file_p) {
+    lv_free(file_p);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_read(lv_fs_drv_t* drv, void* file_p, void* buf, uint32_t btr, uint32_t* br) {
+    asset_file_t* file = file_p;
+    uint32_t left = file->size - file->pos;
+    if(btr > left) btr = left;
+    memcpy(buf, file->data + file->pos, btr);
+    file->pos += btr;
+    *br = btr;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_seek(lv_fs_drv_t* drv, void* file_p, uint32_t pos, lv_fs_whence_t whence) {
+    asset_file_t* file = file_p;
+    uint32_t base = whence == LV_FS_SEEK_CUR ? file->pos : whence == LV_FS_SEEK_END ? file->size : 0;
+    if(base + pos > file->size) return LV_FS_RES_INV_PARAM;
+    file->pos = base + pos;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_tell(lv_fs_drv_t* drv, void* file_p, uint32_t* pos_p) {
+    *pos_p = ((asset_file_t*)file_p)->pos;
+    return LV_FS_RES_OK;
+}
+
+// -----------------------  Public API  -----------------------
+esp_err_t asset_fs_init(void) {
+    esp_err_t err = map_pack();
+    if(err != ESP_OK) {
+        ESP_LOGE(ASSET_TAG, "Failed to map the asset pack: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    if(pack_size < HEADER_SIZE || get_u32(pack) != ASSET_FS_MAGIC || (pack[4] | (pack[5] << 8)) != ASSET_FS_VERSION) {
+        ESP_LOGE(ASSET_TAG, "No asset pack flashed");
+        pack = NULL;
+        return ESP_ERR_INVALID_STATE;
+    }
+    entry_count = pack[6] | (pack[7] << 8);
+
+    // Check the directory once so lookups can trust it
+    if(HEADER_SIZE + (size_t)entry_count * ENTRY_SIZE > pack_size) entry_count = 0;
+    const uint8_t* entry = pack + HEADER_SIZE;
+    for(uint16_t i = 0; i < entry_count; i++, entry += ENTRY_SIZE) {
+        uint32_t offset = get_u32(entry + ASSET_FS_NAME_LEN);
+        uint32_t size = get_u32(entry + ASSET_FS_NAME_LEN + 4);
+        if(entry[ASSET_FS_NAME_LEN - 1] != '\0' || offset > pack_size || size > pack_size - offset) {
+            ESP_LOGE(ASSET_TAG, "Asset pack directory is broken at entry %u", i);
+            entry_count = i;
+            break;
+        }
+    }
+
+    lv_fs_drv_init(&fs_drv);
+    fs_drv.letter = ASSET_FS_LETTER;
+    fs_drv.open_cb = fs_open;
+    fs_drv.close_cb = fs_close;
+    fs_drv.read_cb = fs_read;
+    fs_drv.seek_cb = fs_seek;
+    fs_drv.tell_cb = fs_tell;
+    lv_fs_drv_register(&fs_drv);
+
+    ESP_LOGI(ASSET_TAG, "%u assets mapped", entry_count);
+    return ESP_OK;
+}
+
+esp_err_t asset_fs_get(const char* name, const void** data, size_t* size) {
+    const uint8_t* entry = find_entry(name);
+    if(!entry) return ESP_ERR_NOT_FOUND;
+    *data = pack + get_u32(entry + ASSET_FS_NAME_LEN);
+    *size = get_u32(entry + ASSET_FS_NAME_LEN + 4);
+    return ESP_OK;
+}
+
+esp_err_t asset_fs_image(const char* name, lv_image_dsc_t* dsc) {
+    const void* data;
+    size_t size;
+    esp_err_t err = asset_fs_get(name, &data, &size);
+    if(err != ESP_OK) return err;
+    if(size < sizeof(lv_image_header_t)) return ESP_ERR_NOT_SUPPORTED;
+
+    memset(dsc, 0, sizeof(*dsc));
+    memcpy(&dsc->header, data, sizeof(lv_image_header_t));
+    uint32_t pixels = size - sizeof(lv_image_header_t);
+    if(dsc->header.magic != LV_IMAGE_HEADER_MAGIC || (dsc->header.flags & LV_IMAGE_FLAGS_COMPRESSED) ||
+       (uint32_t)dsc->header.stride * dsc->header.h > pixels) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    // The pixels are read-only flash, never let LVGL write or free them
+    dsc->header.flags &= ~(LV_IMAGE_FLAGS_ALLOCATED | LV_IMAGE_FLAGS_MODIFIABLE);
+    dsc->data = (const uint8_t*)data + sizeof(lv_image_header_t);
+    dsc->data_size = pixels;
+    return ESP_OK;
+}
@@ -0,0 +1,48 @@
+#ifndef ESP32C6_FINANCE_HUB_ASSET_FS_H
+#define ESP32C6_FINANCE_HUB_ASSET_FS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+// lv_fs drive letter of the asset pack, e.g. "A:/icons/bank.bin"
+#define ASSET_FS_LETTER 'A'
+#define ASSET_FS_NAME_LEN 40
+// Pack file mapped instead of the partition when not running on the device
+#define ASSET_FS_HOST_PATH "assets.bin"
+
+/**
+ * Asset pack layout (little endian), written by tools/asset_pack.py:
+ *   header: u32 magic "LVAP", u16 version, u16 entry count
+ *   entries: char name[ASSET_FS_NAME_LEN], u32 offset (from the start of the pack), u32 size
+ *   data: every file starts on a 64 byte boundary so pixel data stays aligned
+*/
+#define ASSET_FS_MAGIC 0x5041564C
+#define ASSET_FS_VERSION 1
+
+/**
+ * @brief Map the "assets" partition (or ASSET_FS_HOST_PATH off-target) and register the lv_fs driver.
+ * Only the directory is read, file data stays on flash until it is used. Call after lv_init
+ * @return ESP_OK, ESP_ERR_NOT_FOUND if there is no partition, ESP_ERR_INVALID_STATE if it holds no pack
+*/
+esp_err_t asset_fs_init(void);
+
+/**
+ * @brief Get a file of the pack without copying it
+ * @param name Name inside the pack, with or without the leading '/'
+ * @param data Set to the mapped file data, valid until the program ends
+ * @param size Set to the size of the file
+ * @return ESP_OK or ESP_ERR_NOT_FOUND
+*/
+esp_err_t asset_fs_get(const char* name, const void** data, size_t* size);
+
+/**
+ * @brief Describe an uncompressed LVGL .bin image of the pack so it is drawn straight from flash.
+ * Pass `dsc` to lv_image_set_src, it must stay valid while it is used
+ * @return ESP_OK, ESP_ERR_NOT_FOUND, or ESP_ERR_NOT_SUPPORTED for compressed or broken images
+*/
+esp_err_t asset_fs_image(const char* name, lv_image_dsc_t* dsc);
+
+#endif //ESP32C6_FINANCE_HUB_ASSET_FS_H
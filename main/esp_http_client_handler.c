@@ -6,9 +6,18 @@
 #include "esp_http_client.h"
 #include "cJSON.h"
 #include "esp_log.h"
+#include "request_arena.h"
+#include "json_stream.h"
+#include "transaction_log.h"
+#include "transaction_store.h"
 #include <string.h>
 #include "env.h"
 
+// Lets a local mock server stand in for Plaid (define it in env.h, e.g. "http://192.168.1.20:8080")
+#ifndef PLAID_BASE_URL
+#define PLAID_BASE_URL "https://production.plaid.com"
+#endif
+
 // Define a TAG specific to the HTTP module
 static const char *TIME_TAG = "HTTP_CLIENT";
 static const char *PLAID_TAG = "Plaid Tag";
@@ -147,7 +156,17 @@ char (*fetch_time())[32] {
 
 // --------------------------------------------------  Plaid Sandbox  --------------------------------------------------
 static char* plaid_response;
-static char* institution_temp = NULL;
+static const char* institution_temp = NULL;
+
+// Everything a Plaid request allocates (body, cJSON tree, printed output) comes from this arena.
+// PLAID_ARENA_SIZE is therefore the worst-case memory used by one refresh
+#define PLAID_ARENA_SIZE (32 * 1024)
+static unsigned char plaid_arena_region[PLAID_ARENA_SIZE];
+static request_arena_t plaid_arena;
+static bool plaid_arena_ready = false;
+static char* plaid_handler_buffer = NULL; // Response body, lives in the arena
+static int response_buffer_len = 0;
+static bool plaid_response_overflow = false; // The body didn't fit, the rest of it is ignored
 
 static const char *PLAID_ROOT_CERT =
         "-----BEGIN CERTIFICATE-----\n"
@@ -174,19 +193,19 @@ static const char *PLAID_ROOT_CERT =
         "-----END CERTIFICATE-----\n";
 
 esp_err_t plaid_balance_handler(esp_http_client_event_t* evt) {
-    static char* plaid_handler_buffer = NULL; // Buffer to accumulate the response
-    static int response_buffer_len = 0;
-
     switch (evt->event_id) {
         case HTTP_EVENT_ON_DATA:
-            if (evt->data_len > 0) {
-                // Reallocate buffer to accommodate new data
-                char* temp = realloc(plaid_handler_buffer, response_buffer_len + evt->data_len + 1);
+            if (evt->data_len > 0 && !plaid_response_overflow) {
+                // The body is the newest arena allocation while it downloads, so it grows in place
+                char* temp = request_arena_realloc(&plaid_arena, plaid_handler_buffer,
+                                                   response_buffer_len + 1, response_buffer_len + evt->data_len + 1);
                 if (!temp) {
-                    ESP_LOGE("Plaid Handler", "Failed to allocate memory for response buffer");
-                    free(plaid_handler_buffer);
+                    ESP_LOGE("Plaid Handler", "Response does not fit in the %d byte request arena", PLAID_ARENA_SIZE);
+                    // Never parse a cut off body, drop what arrived so far
+                    plaid_response_overflow = true;
                     plaid_handler_buffer = NULL;
                     response_buffer_len = 0;
+                    request_arena_reset(&plaid_arena);
                     return ESP_FAIL;
                 }
                 plaid_handler_buffer = temp;
@@ -201,8 +220,13 @@ esp_err_t plaid_balance_handler(esp_http_client_event_t* evt) {
         case HTTP_EVENT_ON_FINISH:
 //            ESP_LOGI(PLAID_TAG, "HTTP response finished. Total response size: %d bytes", response_buffer_len);
 //            ESP_LOGI(PLAID_TAG, "Response: %s", response_buffer);
+            if (plaid_response_overflow) break;
+            if (!plaid_handler_buffer) {
+                ESP_LOGE("Plaid Handler", "Empty response");
+                break;
+            }
 
-            // Parse and process the JSON response
+            // Parse and process the JSON response. Every cJSON node lands in the arena
             cJSON* root = cJSON_Parse(plaid_handler_buffer);
             if (root) {
 //                ESP_LOGI(PLAID_TAG, "%s", cJSON_Print(root));
@@ -225,20 +249,21 @@ esp_err_t plaid_balance_handler(esp_http_client_event_t* evt) {
                             cJSON_AddItemToArray(account_array, account_object);
                         }
                     }
-                    plaid_response = cJSON_PrintUnformatted(account_array);
-                    cJSON_Delete(account_array);
+                    // The printed string is handed to the caller, so it is the only thing copied out of the arena.
+                    // If any allocation failed some accounts are missing, return nothing rather than a partial list
+                    char* printed = cJSON_PrintUnformatted(account_array);
+                    if (printed && !plaid_arena.exhausted) {
+                        plaid_response = strdup(printed);
+                    } else {
+                        ESP_LOGE("Plaid Handler", "Failed to build the accounts, request arena is full");
+                    }
                 } else {
                     ESP_LOGE("Plaid Handler", "No 'accounts' array found in response");
                 }
-                cJSON_Delete(root);
             } else {
                 ESP_LOGE("Plaid Handler", "Failed to parse JSON response");
             }
-
-            // Free the response buffer
-            free(plaid_handler_buffer);
-            plaid_handler_buffer = NULL;
-            response_buffer_len = 0;
+            // No cJSON_Delete / free needed, plaid_fetch_balance resets the arena
             break;
 
         case HTTP_EVENT_ERROR:
@@ -254,11 +279,16 @@ esp_err_t plaid_balance_handler(esp_http_client_event_t* evt) {
 
 
 char* plaid_fetch_balance(const char* access_token, const char* institution) {
-    institution_temp = strdup(institution);
-    if(!institution_temp) {
-        ESP_LOGE(PLAID_TAG, "Failed to copy institution to the temp var");
-        return NULL;
+    if(!plaid_arena_ready) {
+        request_arena_init(&plaid_arena, plaid_arena_region, sizeof(plaid_arena_region));
+        plaid_arena_ready = true;
     }
+    // The caller's string outlives the request, no need to copy it
+    institution_temp = institution;
+    plaid_response = NULL;
+    plaid_handler_buffer = NULL;
+    response_buffer_len = 0;
+    plaid_response_overflow = false;
 
     esp_http_client_config_t config = {
             .host = "production.plaid.com",
@@ -286,16 +316,257 @@ char* plaid_fetch_balance(const char* access_token, const char* institution) {
     esp_http_client_set_method(client, HTTP_METHOD_POST);
     esp_http_client_set_post_field(client, post_data, strlen(post_data));
 
-    // Perform the HTTP request
+    // Perform the HTTP request with cJSON allocating from the arena
+    request_arena_attach_cjson(&plaid_arena);
     esp_err_t err = esp_http_client_perform(client);
+    request_arena_detach_cjson();
     if (err != ESP_OK) {
         ESP_LOGE(PLAID_TAG, "Error performing HTTP request: %s", esp_err_to_name(err));
     }
 
     esp_http_client_cleanup(client);
-    if(institution_temp) {
-        free(institution_temp);
-        institution_temp = NULL;
-    }
+    ESP_LOGI(PLAID_TAG, "Request arena: %d of %d bytes used (peak %d)",
+             (int)plaid_arena.used, PLAID_ARENA_SIZE, (int)plaid_arena.high_water);
+    // Drop the body and cJSON tree in one go
+    request_arena_reset(&plaid_arena);
+    plaid_handler_buffer = NULL;
+    response_buffer_len = 0;
+    institution_temp = NULL;
     return(plaid_response);
 }
+
+
+// ----------------------------------------------  Plaid Transactions Sync  ----------------------------------------------
+#define PLAID_SYNC_PAGE_SIZE 100
+// Times a sync starts over after Plaid reports changes during pagination before giving up
+#define PLAID_SYNC_MAX_RESTARTS 3
+// Only one transaction object is parsed at a time, this bounds its cJSON tree
+#define PLAID_SYNC_ARENA_SIZE (12 * 1024)
+
+typedef struct {
+    uint8_t institution;
+    json_stream_t stream;
+    char next_cursor[TRANSACTION_CURSOR_LEN];
+    bool cursor_seen;
+    bool has_more;
+    uint32_t applied;
+    uint32_t too_large; // Transactions whose cJSON tree didn't fit in the arena
+    uint32_t write_failed; // Changes the log or the store could not write
+    bool mutated; // Plaid reported TRANSACTIONS_SYNC_MUTATION_DURING_PAGINATION
+} plaid_sync_state_t;
+
+static plaid_sync_state_t sync_state;
+static unsigned char sync_arena_region[PLAID_SYNC_ARENA_SIZE];
+static request_arena_t sync_arena;
+static bool sync_arena_ready = false;
+static char sync_post_data[TRANSACTION_CURSOR_LEN + 256];
+static char sync_first_cursor[TRANSACTION_CURSOR_LEN]; // Cursor the current pagination loop started from
+
+// Copy a string into a record field without cutting a UTF-8 character in half
+static void copy_name(char* dst, size_t size, const char* src) {
+    size_t len = strlen(src);
+    if(len >= size) {
+        len = size - 1;
+        while(len > 0 && ((unsigned char)src[len] & 0xC0) == 0x80) len--; // Step back over continuation bytes
+    }
+    memcpy(dst, src, len);
+    dst[len] = '\0';
+}
+
+// Called by the stream parser for every item of "added", "modified" and "removed"
+static void plaid_sync_element_cb(const char* key, const char* element, size_t len, void* user_data) {
+    plaid_sync_state_t* state = user_data;
+
+    request_arena_attach_cjson(&sync_arena);
+    cJSON* transaction = cJSON_Parse(element); // element is null-terminated
+    (void)len;
+    cJSON* id = transaction ? cJSON_GetObjectItem(transaction, "transaction_id") : NULL;
+
+    if(sync_arena.exhausted) {
+        // Dropping it would lose the transaction for good once the cursor moves past it
+        state->too_large++;
+    } else if(cJSON_IsString(id) && strlen(id->valuestring) >= TRANSACTION_ID_LEN) {
+        ESP_LOGE(PLAID_TAG, "transaction_id '%s' is longer than %d characters", id->valuestring, TRANSACTION_ID_LEN - 1);
+        state->too_large++;
+    } else if(cJSON_IsString(id)) {
+        uint32_t id_hash = transaction_log_hash_id(id->valuestring);
+        if(strcmp(key, "removed") == 0) {
+            // Not found is fine, it may never have been stored
+            esp_err_t err = transaction_log_remove(id->valuestring);
+            if(err != ESP_OK && err != ESP_ERR_NOT_FOUND) state->write_failed++;
+            err = transaction_store_remove(id_hash);
+            if(err != ESP_OK && err != ESP_ERR_NOT_FOUND && err != ESP_ERR_INVALID_STATE) state->write_failed++;
+            state->applied++;
+        } else if(strcmp(key, "added") == 0 || strcmp(key, "modified") == 0) {
+            cJSON* amount = cJSON_GetObjectItem(transaction, "amount");
+            cJSON* date = cJSON_GetObjectItem(transaction, "date");
+            cJSON* merchant = cJSON_GetObjectItem(transaction, "merchant_name");
+            cJSON* name = cJSON_GetObjectItem(transaction, "name");
+            cJSON* category = cJSON_GetObjectItem(transaction, "personal_finance_category");
+            cJSON* primary = category ? cJSON_GetObjectItem(category, "primary") : NULL;
+
+            transaction_record_t record = {0};
+            strcpy(record.id, id->valuestring);
+            record.institution = state->institution;
+            if(cJSON_IsString(date)) record.day = transaction_log_date_to_day(date->valuestring);
+            if(cJSON_IsNumber(amount)) {
+                double cents = amount->valuedouble * 100.0;
+                record.amount_cents = (int32_t)(cents + (cents >= 0 ? 0.5 : -0.5));
+            }
+            const char* label = cJSON_IsString(merchant) ? merchant->valuestring :
+                                cJSON_IsString(name) ? name->valuestring : "";
+            copy_name(record.name, sizeof(record.name), label);
+
+            transaction_store_entry_t entry = {
+                    .id_hash = id_hash,
+                    .day = record.day,
+                    .amount_cents = record.amount_cents,
+                    .institution = state->institution,
+                    .category = transaction_store_category_from_name(cJSON_IsString(primary) ? primary->valuestring : NULL),
+                    .merchant = label
+            };
+
+            if(transaction_log_put(&record) != ESP_OK) state->write_failed++;
+            // Without the store (no partition, failed to load) the log syncs on its own
+            esp_err_t err = key[0] == 'a' ? transaction_store_add(&entry) : transaction_store_modify(&entry);
+            if(err != ESP_OK && err != ESP_ERR_INVALID_STATE) state->write_failed++;
+            state->applied++;
+        }
+    } else {
+        ESP_LOGW(PLAID_TAG, "Skipping unreadable transaction in '%s'", key);
+    }
+
+    // Nothing of the tree is kept, drop it in one go
+    request_arena_detach_cjson();
+    request_arena_reset(&sync_arena);
+}
+
+static void plaid_sync_scalar_cb(const char* key, const char* value, void* user_data) {
+    plaid_sync_state_t* state = user_data;
+    if(strcmp(key, "next_cursor") == 0) {
+        strncpy(state->next_cursor, value, sizeof(state->next_cursor) - 1);
+        state->next_cursor[sizeof(state->next_cursor) - 1] = '\0';
+        state->cursor_seen = true;
+    } else if(strcmp(key, "has_more") == 0) {
+        state->has_more = strcmp(value, "true") == 0;
+    } else if(strcmp(key, "error_code") == 0) {
+        state->mutated = strcmp(value, "TRANSACTIONS_SYNC_MUTATION_DURING_PAGINATION") == 0;
+    }
+}
+
+esp_err_t plaid_sync_handler(esp_http_client_event_t* evt) {
+    switch (evt->event_id) {
+        case HTTP_EVENT_ON_DATA:
+            // Parse as it arrives, the page itself is never held in memory
+            json_stream_feed(&sync_state.stream, evt->data, evt->data_len);
+            break;
+
+        case HTTP_EVENT_ERROR:
+            ESP_LOGE("Plaid Sync Handler", "HTTP Event Error occurred");
+            break;
+
+        default:
+            break;
+    }
+    return ESP_OK;
+}
+
+esp_err_t plaid_sync_transactions(const char* access_token, uint8_t institution, plaid_sync_page_cb_t on_page) {
+    if(!sync_arena_ready) {
+        request_arena_init(&sync_arena, sync_arena_region, sizeof(sync_arena_region));
+        sync_arena_ready = true;
+    }
+
+    sync_state.institution = institution;
+    transaction_log_get_cursor(institution, sync_state.next_cursor, sizeof(sync_state.next_cursor));
+    strcpy(sync_first_cursor, sync_state.next_cursor);
+
+    esp_http_client_config_t config = {
+            .url = PLAID_BASE_URL "/transactions/sync",
+            .cert_pem = PLAID_ROOT_CERT,
+            .skip_cert_common_name_check = false,
+            .event_handler = plaid_sync_handler,
+            .timeout_ms = 15000,
+            .keep_alive_enable = true // Every page goes over the same connection
+    };
+
+    esp_http_client_handle_t client = esp_http_client_init(&config);
+    esp_http_client_set_header(client, "Content-Type", "application/json");
+    esp_http_client_set_method(client, HTTP_METHOD_POST);
+
+    esp_err_t err = ESP_OK;
+    uint32_t pages = 0;
+    uint32_t restarts = 0;
+    do {
+        // An empty cursor means "from the beginning", Plaid wants it omitted then
+        if(sync_state.next_cursor[0]) {
+            snprintf(sync_post_data, sizeof(sync_post_data),
+                     "{\"client_id\":\"%s\",\"secret\":\"%s\",\"access_token\":\"%s\",\"cursor\":\"%s\",\"count\":%d}",
+                     PLAID_CLIENT_ID, PLAID_SECRET, access_token, sync_state.next_cursor, PLAID_SYNC_PAGE_SIZE);
+        } else {
+            snprintf(sync_post_data, sizeof(sync_post_data),
+                     "{\"client_id\":\"%s\",\"secret\":\"%s\",\"access_token\":\"%s\",\"count\":%d}",
+                     PLAID_CLIENT_ID, PLAID_SECRET, access_token, PLAID_SYNC_PAGE_SIZE);
+        }
+        esp_http_client_set_post_field(client, sync_post_data, strlen(sync_post_data));
+
+        json_stream_init(&sync_state.stream, plaid_sync_element_cb, plaid_sync_scalar_cb, &sync_state);
+        sync_state.cursor_seen = false;
+        sync_state.has_more = false;
+        sync_state.applied = 0;
+        sync_state.too_large = 0;
+        sync_state.write_failed = 0;
+        sync_state.mutated = false;
+
+        err = esp_http_client_perform(client);
+        int status_code = esp_http_client_get_status_code(client);
+        if(err == ESP_OK && (status_code != 200 || !sync_state.cursor_seen)) err = ESP_FAIL;
+        if(err == ESP_OK && sync_state.too_large) {
+            ESP_LOGE(PLAID_TAG, "%lu transactions did not fit in the %d byte sync arena or a record",
+                     (unsigned long)sync_state.too_large, PLAID_SYNC_ARENA_SIZE);
+            err = ESP_ERR_NO_MEM;
+        }
+        // Like the ones above, the cursor must not move past transactions that were never applied
+        if(err == ESP_OK && sync_state.stream.skipped) {
+            ESP_LOGE(PLAID_TAG, "%u transactions were longer than the %d byte stream buffer",
+                     sync_state.stream.skipped, JSON_STREAM_ELEMENT_MAX);
+            err = ESP_ERR_NO_MEM;
+        }
+        if(err == ESP_OK && sync_state.write_failed) err = ESP_FAIL;
+        if(err != ESP_OK && sync_state.mutated && restarts < PLAID_SYNC_MAX_RESTARTS) {
+            // Plaid wants the whole pagination loop run again from the cursor it started with, not the last page's.
+            // Pages applied since then are applied again, which replaces their transactions in place
+            ESP_LOGW(PLAID_TAG, "Transactions changed during the sync, restarting from the first page");
+            transaction_log_rollback();
+            restarts++;
+            strcpy(sync_state.next_cursor, sync_first_cursor);
+            err = transaction_log_commit(institution, sync_first_cursor);
+            if(err != ESP_OK) break;
+            sync_state.has_more = true;
+            continue;
+        }
+        if(err != ESP_OK) {
+            ESP_LOGE(PLAID_TAG, "Transactions sync failed (status %d): %s", status_code, esp_err_to_name(err));
+            // Forget the half applied page, it is fetched again from the saved cursor next time
+            transaction_log_rollback();
+            break;
+        }
+        // Store first: it skips transactions it already has, so the page replayed after a failed commit is harmless
+        err = transaction_store_commit();
+        if(err == ESP_ERR_INVALID_STATE) err = ESP_OK;
+        if(err != ESP_OK) {
+            ESP_LOGE(PLAID_TAG, "Transaction store commit failed: %s", esp_err_to_name(err));
+            transaction_log_rollback();
+            break;
+        }
+        err = transaction_log_commit(institution, sync_state.next_cursor);
+        if(err != ESP_OK) break;
+        pages++;
+        ESP_LOGI(PLAID_TAG, "Sync page %lu: %lu changes, %lu transactions stored", (unsigned long)pages,
+                 (unsigned long)sync_state.applied, (unsigned long)transaction_log_count());
+        if(on_page) on_page(transaction_log_count());
+    } while(sync_state.has_more);
+
+    esp_http_client_cleanup(client);
+    return err;
+}
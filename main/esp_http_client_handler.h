@@ -22,4 +22,21 @@ char (*fetch_time())[32];
 */
 char* plaid_fetch_balance(const char* access_token, const char* institution);
 
+/**
+ * @brief Called after each /transactions/sync page has been applied to the transaction log
+ * @param total Number of transactions in the log
+*/
+typedef void (*plaid_sync_page_cb_t)(uint32_t total);
+
+/**
+ * @brief Bring the transaction log up to date through /transactions/sync.
+ * Pages are parsed while they download, one transaction at a time, and the cursor is saved after each page,
+ * so RAM use is bounded and an interrupted sync continues where it stopped
+ * @param access_token Access Tokens are unique to institutions
+ * @param institution Index of the institution, stored with its transactions and used to key its cursor
+ * @param on_page Optional progress callback
+ * @return ESP_OK once Plaid reports no more pages
+*/
+esp_err_t plaid_sync_transactions(const char* access_token, uint8_t institution, plaid_sync_page_cb_t on_page);
+
 #endif //ESP32C6_FINANCE_HUB_ESP_HTTP_CLIENT_HANDLER_H
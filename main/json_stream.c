@@ -0,0 +1,129 @@
+#include "json_stream.h"
+#include <string.h>
+#include <ctype.h>
+
+void json_stream_init(json_stream_t* stream, json_stream_element_cb_t element_cb, json_stream_scalar_cb_t scalar_cb,
+                      void* user_data) {
+    memset(stream, 0, sizeof(*stream));
+    stream->element_cb = element_cb;
+    stream->scalar_cb = scalar_cb;
+    stream->user_data = user_data;
+}
+
+// Add a character of the document to whatever is being captured right now
+static void capture_char(json_stream_t* s, char c) {
+    if(s->element_capturing) {
+        if(s->element_len < sizeof(s->element) - 1) s->element[s->element_len++] = c;
+        else s->element_overflow = true;
+    } else if(s->scalar_capturing && s->depth == 1) {
+        if(s->scalar_len < sizeof(s->scalar) - 1) s->scalar[s->scalar_len++] = c;
+        else s->scalar_capturing = false; // Too long, drop it
+    }
+}
+
+static void finish_scalar(json_stream_t* s) {
+    if(!s->scalar_capturing) return;
+    s->scalar_capturing = false;
+
+    // Trim whitespace and the quotes of strings
+    char* value = s->scalar;
+    size_t len = s->scalar_len;
+    while(len && isspace((unsigned char)value[len - 1])) len--;
+    while(len && isspace((unsigned char)*value)) { value++; len--; }
+    if(len >= 2 && value[0] == '"' && value[len - 1] == '"') { value++; len -= 2; }
+    value[len] = '\0';
+
+    if(s->scalar_cb) s->scalar_cb(s->key, value, s->user_data);
+}
+
+static void finish_element(json_stream_t* s) {
+    s->element_capturing = false;
+    if(s->element_overflow) {
+        s->skipped++;
+        return;
+    }
+    s->element[s->element_len] = '\0';
+    if(s->element_cb) s->element_cb(s->key, s->element, s->element_len, s->user_data);
+}
+
+void json_stream_feed(json_stream_t* stream, const char* data, size_t len) {
+    json_stream_t* s = stream;
+    for(size_t i = 0; i < len; i++) {
+        char c = data[i];
+
+        if(s->in_string) {
+            capture_char(s, c);
+            if(s->escape) {
+                s->escape = false;
+            } else if(c == '\\') {
+                s->escape = true;
+            } else if(c == '"') {
+                s->in_string = false;
+                if(s->key_capturing) {
+                    s->key_capturing = false;
+                    s->key[s->key_len] = '\0';
+                }
+                continue;
+            }
+            if(s->key_capturing && s->key_len < sizeof(s->key) - 1) s->key[s->key_len++] = c;
+            continue;
+        }
+
+        switch(c) {
+            case '"':
+                capture_char(s, c);
+                s->in_string = true;
+                if(s->depth == 1 && s->expect_key) {
+                    s->key_capturing = true;
+                    s->key_len = 0;
+                }
+                break;
+
+            case ':':
+                capture_char(s, c);
+                if(s->depth == 1) { // A top-level value starts
+                    s->expect_key = false;
+                    s->scalar_capturing = true;
+                    s->scalar_len = 0;
+                }
+                break;
+
+            case '{':
+            case '[':
+                if(s->depth == 1) { // The top-level value is an object/array, not a scalar
+                    s->scalar_capturing = false;
+                    s->in_array = (c == '[');
+                } else if(s->depth == 2 && s->in_array && c == '{') { // An element of a top-level array
+                    s->element_capturing = true;
+                    s->element_len = 0;
+                    s->element_overflow = false;
+                }
+                capture_char(s, c);
+                s->depth++;
+                if(s->depth == 1) s->expect_key = true; // The root object opened
+                break;
+
+            case '}':
+            case ']':
+                if(s->depth == 1) finish_scalar(s); // Last value of the root object
+                capture_char(s, c);
+                if(s->depth > 0) s->depth--;
+                if(s->depth == 2 && s->element_capturing) finish_element(s);
+                if(s->depth == 1) s->in_array = false;
+                break;
+
+            case ',':
+                if(s->depth == 1) {
+                    finish_scalar(s);
+                    s->expect_key = true;
+                } else {
+                    capture_char(s, c);
+                }
+                break;
+
+            default:
+                capture_char(s, c);
+                break;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef ESP32C6_FINANCE_HUB_JSON_STREAM_H
+#define ESP32C6_FINANCE_HUB_JSON_STREAM_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// Largest single array element that can be captured. Bigger elements are skipped and counted in `skipped`
+#define JSON_STREAM_ELEMENT_MAX 3072
+// Largest top-level scalar value (e.g. a cursor) that can be captured
+#define JSON_STREAM_SCALAR_MAX 320
+#define JSON_STREAM_KEY_MAX 32
+
+/**
+ * @brief Called with the raw text of each object inside a top-level array, e.g. every item of "added"
+ * @param key Key of the array the element belongs to
+ * @param element Null-terminated JSON text of the element
+ * @param len Length of element
+ * @param user_data Pointer given to json_stream_init
+*/
+typedef void (*json_stream_element_cb_t)(const char* key, const char* element, size_t len, void* user_data);
+
+/**
+ * @brief Called with each top-level scalar value (string quotes removed)
+*/
+typedef void (*json_stream_scalar_cb_t)(const char* key, const char* value, void* user_data);
+
+/**
+ * Incremental scanner for a JSON object that arrives in chunks.
+ * Only one array element is buffered at a time, so RAM use does not depend on the size of the response.
+*/
+typedef struct {
+    json_stream_element_cb_t element_cb;
+    json_stream_scalar_cb_t scalar_cb;
+    void* user_data;
+
+    int depth;               // Current {/[ nesting
+    bool in_string;
+    bool escape;
+    bool expect_key;         // At depth 1, the next string is a key
+    bool in_array;           // Inside an array that is a top-level value
+    char key[JSON_STREAM_KEY_MAX];
+    size_t key_len;
+    bool key_capturing;
+
+    char scalar[JSON_STREAM_SCALAR_MAX];
+    size_t scalar_len;
+    bool scalar_capturing;
+
+    char element[JSON_STREAM_ELEMENT_MAX];
+    size_t element_len;
+    bool element_capturing;
+    bool element_overflow;
+    unsigned int skipped;    // Elements dropped because they did not fit
+} json_stream_t;
+
+/**
+ * @brief Prepare a scanner for a new document
+*/
+void json_stream_init(json_stream_t* stream, json_stream_element_cb_t element_cb, json_stream_scalar_cb_t scalar_cb,
+                      void* user_data);
+
+/**
+ * @brief Feed the next chunk of the document
+*/
+void json_stream_feed(json_stream_t* stream, const char* data, size_t len);
+
+#endif //ESP32C6_FINANCE_HUB_JSON_STREAM_H
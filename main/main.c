@@ -4,27 +4,46 @@
 #include <stdio.h>
 #include <esp_timer.h>
 #include <string.h>
+#include <stdlib.h>
+#include <math.h>
 #include <esp_log.h>
 #include <nvs_flash.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "esp_err.h"
+#include "esp_cpu.h"
 #include "cJSON.h"
 #include "lvgl.h"
 #include "driver/gpio.h"
 #include "esp_lcd_panel_io.h"
-#include "esp_lcd_panel_vendor.h"
-#include "esp_lcd_panel_ops.h"
 #include "driver/spi_master.h"
-#include "esp_lcd_ili9341.h"
 #include "esp_wifi_connect.h"
 #include "esp_http_client_handler.h"
+#include "transaction_log.h"
+#include "transaction_store.h"
+#include "asset_fs.h"
+#include "ui_screens_gen.h"
 #include "env.h"
 
 #define BOOT_BUTTON_PIN GPIO_NUM_9
 #define SCROLL_UP_BUTTON GPIO_NUM_10
 #define SCROLL_DOWN_BUTTON GPIO_NUM_11
 
+// Image cache budget, adjusted to the free LVGL heap. The reserve covers the largest page built on its
+// first visit (accounts, 7 KB) and a refresh's peak above the steady use (6 KB), see lib/lv_conf.h
+#define IMAGE_CACHE_MAX_SIZE (32 * 1024)
+#define IMAGE_CACHE_HEAP_RESERVE (16 * 1024)
+// Compressed images of the pages, the three pages take about 38 KB
+#define PAGE_CACHE_SIZE (48 * 1024)
+
+// 1: LVGL keeps the whole frame (150 KB) and redraws only the changed areas in it, which are sent
+// from there. 0: the changed areas are rendered in stripes of the two 20 line buffers.
+// Off by default: the static frame on top of the page cache (48 KB), the LVGL heap (64 KB) and
+// Wi-Fi with TLS doesn't leave a safe margin in the C6's 512 KB of SRAM. Before turning it on, drop
+// the page cache (which mostly saves the same rendering) and check the free heap on the device
+#define DISPLAY_DIRECT_MODE 0
+
 #define BL 15
 #define SCK 6
 #define MISO 4
@@ -38,53 +57,54 @@ static const char *TAG = "Plaid API";
 
 // ------------------------------------------ LVGL Objects ------------------------------------------
 // Screen Buffers & Panel Handle
+#if DISPLAY_DIRECT_MODE
+static uint16_t frame[320 * 240];
+// The rows of a changed area are packed into buffer and buffer2 in turn for the SPI DMA
+static SemaphoreHandle_t bounce_free;
+#endif
 static uint16_t buffer[240 * 20];
 static uint16_t buffer2[240 * 20];
-static esp_lcd_panel_handle_t panel_handle;
+static esp_lcd_panel_io_handle_t lcd_io;
+
+// LVGL runs without OS support (LV_OS_NONE), so its calls are serialized here. lvgl_task holds the mutex
+// while it runs the timers, the other tasks take it with lvgl_lock() around their LVGL calls
+static SemaphoreHandle_t lvgl_mutex;
+
+// Page switches copy the unchanged parts of a page from here instead of rendering them
+static uint8_t page_cache_buf[PAGE_CACHE_SIZE];
+static lv_page_cache_t* page_cache;
 
 // Booleans
 static bool data_loaded = true;
 
+// The screens and their objects are generated from ui_screens.lvui into ui_screens_gen.c,
+// the styles from ui_styles.lvss into ui_styles_gen.c
+
 // Pages
-static lv_obj_t* loading_screen;
-static lv_obj_t *home_page;
-static lv_obj_t *accounts_page;
-static lv_obj_t *transactions_page;
 static uint8_t page_number = 0;
 
-// Pages Content
-lv_obj_t *account_content;
-
-// Nav Buttons
-static lv_obj_t* home_button_label;
-static lv_obj_t* accounts_button_label;
-static lv_obj_t* transactions_button_label;
-
 // Counter
-static lv_obj_t *counter_label;
 static int counter = 0;
 
-// Time API
-static lv_obj_t *time_label;
-
-// Styles
-static lv_style_t bar_style_bg;
-static lv_style_t bar_style_indic;
-static lv_style_t nav_style;
-static lv_style_t menu_style;
-static lv_style_t menu_button_style;
-static lv_style_t table_style;
-
 // Nav Bar
-static lv_obj_t *nav_bar;
-static lv_obj_t *api_progress_label;
 static lv_color_t deselected;
 
-// Account Tables
-static lv_obj_t* checking_table;
-static lv_obj_t* credit_table;
-static uint8_t num_of_checking_accounts = 0;
-static uint8_t num_of_credit_accounts = 0;
+// Accounts fetched at boot, shown on the accounts page
+static cJSON* all_accounts;
+
+// Totals of the accounts, shown on the home page by show_balances_cb
+typedef struct {
+    double credit;
+    double checking;
+} balances_t;
+static balances_t balances;
+
+// Transactions Table
+#define TRANSACTION_WINDOW_ROWS 16 // Records read from flash at once
+static transaction_record_t transaction_window[TRANSACTION_WINDOW_ROWS];
+static uint32_t transaction_window_first = 0;
+static size_t transaction_window_len = 0;
+static uint32_t transaction_window_revision = UINT32_MAX;
 
 // -----------------------------------------  API Functions  ------------------------------------------
 
@@ -100,12 +120,107 @@ void update_time() {
 // ------------------------------------------ LVGL Functions ------------------------------------------
 // Gets the amount of time since system startup in ms
 uint32_t lv_tick_get_cb(void) { return esp_timer_get_time() / 1000; }
+// Used by the LCD driver while the panel is initialized
+void lv_delay_cb(uint32_t ms) { vTaskDelay(pdMS_TO_TICKS(ms)); }
+
+static void lvgl_lock() { xSemaphoreTakeRecursive(lvgl_mutex, portMAX_DELAY); }
+static void lvgl_unlock() { xSemaphoreGiveRecursive(lvgl_mutex); }
+
+// Microseconds, lets the image cache tell slow decodes from fast ones
+static uint32_t image_cache_clock_cb(void) { return (uint32_t)esp_timer_get_time(); }
+
+// CPU cycles, the text layout cache counts what its hits saved with it
+static uint32_t text_layout_clock_cb(void) { return (uint32_t)esp_cpu_get_cycle_count(); }
+
+// Decoded images share LVGL's heap with everything else. Give the cache what is free above a reserve,
+// nothing if the UI needs it all
+static void image_cache_budget_cb(lv_timer_t* timer) {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    lv_cache_stats_t stats;
+    lv_image_cache_get_stats(&stats);
+
+    size_t budget = stats.size + mon.free_size;
+    budget = budget > IMAGE_CACHE_HEAP_RESERVE ? budget - IMAGE_CACHE_HEAP_RESERVE : 0;
+    if(budget > IMAGE_CACHE_MAX_SIZE) budget = IMAGE_CACHE_MAX_SIZE;
+    if(budget != stats.max_size) lv_image_cache_resize(budget, budget < stats.size);
+
+    ESP_LOGD(TAG, "Image cache %u/%u bytes, %lu hits, %lu misses, %lu evictions", (unsigned)stats.size,
+             (unsigned)budget, (unsigned long)stats.hits, (unsigned long)stats.misses, (unsigned long)stats.evictions);
+
+    lv_text_layout_cache_get_stats(&stats);
+    ESP_LOGD(TAG, "Text layout cache %u bytes, %lu hits, %lu misses, %llu cycles saved", (unsigned)stats.size,
+             (unsigned long)stats.hits, (unsigned long)stats.misses, lv_text_layout_cache_get_saved_cycles());
+    lv_obj_style_resolved_cache_get_stats(&stats);
+    ESP_LOGD(TAG, "Resolved style cache %lu hits, %lu misses, %lu evictions", (unsigned long)stats.hits,
+             (unsigned long)stats.misses, (unsigned long)stats.evictions);
+    // Runs on lvgl_task, which also builds the pages
+    ESP_LOGD(TAG, "lvgl_task stack: %u bytes never used", (unsigned)uxTaskGetStackHighWaterMark(NULL));
+    if(page_cache) {
+        lv_page_cache_get_stats(page_cache, &stats);
+        ESP_LOGD(TAG, "Page cache %u/%u bytes, %lu hits, %lu misses, %lu evictions", (unsigned)stats.size,
+                 (unsigned)stats.max_size, (unsigned long)stats.hits, (unsigned long)stats.misses,
+                 (unsigned long)stats.evictions);
+    }
+}
+
+// Sends a command with its parameters to the panel, used by LVGL's ILI9341 driver
+static void lcd_send_cmd(lv_display_t *display, const uint8_t *cmd, size_t cmd_size, const uint8_t *param, size_t param_size) {
+    ESP_ERROR_CHECK(esp_lcd_panel_io_tx_param(lcd_io, *cmd, param, param_size));
+}
 
-// Draws the screen
+// Queues pixels for the panel, the transfer is done in the background
+static void lcd_send_color(lv_display_t *display, const uint8_t *cmd, size_t cmd_size, uint8_t *param, size_t param_size) {
+    ESP_ERROR_CHECK(esp_lcd_panel_io_tx_color(lcd_io, *cmd, param, param_size));
+}
+
+#if DISPLAY_DIRECT_MODE
+// A color transfer is done, its bounce buffer can be filled again
+static bool IRAM_ATTR lcd_color_trans_done_cb(esp_lcd_panel_io_handle_t io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx) {
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(bounce_free, &woken);
+    return woken == pdTRUE;
+}
+
+// Sets the panel's write window. The coordinates are the rotated ones, MADCTL maps them to the panel
+static void lcd_set_window(int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+    ESP_ERROR_CHECK(esp_lcd_panel_io_tx_param(lcd_io, LV_LCD_CMD_SET_COLUMN_ADDRESS,
+                                              (uint8_t[]) {x1 >> 8, x1 & 0xFF, x2 >> 8, x2 & 0xFF}, 4));
+    ESP_ERROR_CHECK(esp_lcd_panel_io_tx_param(lcd_io, LV_LCD_CMD_SET_PAGE_ADDRESS,
+                                              (uint8_t[]) {y1 >> 8, y1 & 0xFF, y2 >> 8, y2 & 0xFF}, 4));
+}
+
+// Sends a changed area of the frame. One bounce buffer is filled while the other one is sent
 void lvgl_flush_cb(lv_display_t *display, const lv_area_t *area, uint8_t *px_map) {
-    ESP_ERROR_CHECK(esp_lcd_panel_draw_bitmap(panel_handle, area->x1, area->y1, area->x2 + 1, area->y2 + 1, (uint16_t *)px_map));
-    lv_display_flush_ready(display); // Notify LVGL the flushing is done
+    static uint8_t bounce_act = 0;
+    uint16_t *bounce[2] = {buffer, buffer2};
+    // The frame keeps its stride when it's rotated, so it's not always the horizontal resolution
+    int32_t stride = lv_display_get_buf_active(display)->header.stride / sizeof(uint16_t);
+    int32_t w = lv_area_get_width(area);
+    int32_t rows_max = (int32_t)(sizeof(buffer) / sizeof(buffer[0])) / w;
+    const uint16_t *src = (const uint16_t *)px_map;
+
+    for(int32_t y = area->y1; y <= area->y2; y += rows_max) {
+        int32_t rows = LV_MIN(rows_max, area->y2 - y + 1);
+        uint16_t *dest = bounce[bounce_act];
+        bounce_act ^= 1;
+        xSemaphoreTake(bounce_free, portMAX_DELAY);
+        for(int32_t i = 0; i < rows; i++) {
+            memcpy(dest + i * w, src + (y + i) * stride + area->x1, w * sizeof(uint16_t));
+        }
+        lcd_set_window(area->x1, y, area->x2, y + rows - 1);
+        ESP_ERROR_CHECK(esp_lcd_panel_io_tx_color(lcd_io, LV_LCD_CMD_WRITE_MEMORY_START, dest, rows * w * sizeof(uint16_t)));
+    }
+    // The pixels are copied out already, LVGL can draw into the frame while the last rows are sent
+    lv_display_flush_ready(display);
 }
+#else
+// The stripe is sent, LVGL can render into its buffer again
+static bool IRAM_ATTR lcd_color_trans_done_cb(esp_lcd_panel_io_handle_t io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx) {
+    lv_display_flush_ready((lv_display_t *)user_ctx);
+    return false;
+}
+#endif
 
 // Controls custom count label with each second
 static void counter_update_cb() {
@@ -114,8 +229,135 @@ static void counter_update_cb() {
     lv_label_set_text(counter_label, timer_buffer);
 }
 
-static void clear_loading_screen() {
+static void show_balance(lv_obj_t* title, lv_obj_t* value, const char* text, double balance) {
+    lv_label_set_text(title, text);
+    lv_numlabel_set_value(value, llround(balance * 100)); // In cents
+    lv_obj_remove_flag(value, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_align_to(value, title, LV_ALIGN_OUT_BOTTOM_MID, 0, 0);
+}
+
+// Runs on lvgl_task, which also runs the roll animations the numeric labels start
+static void show_balances_cb(void* user_data) {
+    const balances_t* totals = user_data;
+    show_balance(total_credit_balance_label, total_credit_balance_value, "Credit Balance", totals->credit);
+    show_balance(total_checking_balance_label, total_checking_balance_value, "Checking Balance", totals->checking);
+    show_balance(total_balance, total_balance_value, "Total Balance", totals->checking - totals->credit);
+}
+
+// Supplies the visible cells of the transactions table. Rows are newest first and are read from flash a window at a time
+static const char* transactions_cell_cb(lv_obj_t* table, uint32_t row, uint32_t col, char* buf, uint32_t buf_size) {
+    uint32_t count = transaction_log_count();
+    if(row >= count) return NULL;
+    uint32_t index = count - 1 - row;
+
+    if(transaction_window_revision != transaction_log_revision() || index < transaction_window_first ||
+       index >= transaction_window_first + transaction_window_len) {
+        // Rows are drawn top to bottom (decreasing index), so load the window that ends at this record
+        transaction_window_revision = transaction_log_revision();
+        transaction_window_first = (index + 1 > TRANSACTION_WINDOW_ROWS) ? index + 1 - TRANSACTION_WINDOW_ROWS : 0;
+        transaction_window_len = transaction_log_read(transaction_window_first, transaction_window, TRANSACTION_WINDOW_ROWS);
+        if(index >= transaction_window_first + transaction_window_len) return NULL;
+    }
+
+    const transaction_record_t* transaction = &transaction_window[index - transaction_window_first];
+    if(transaction->id[0] == '\0') return ""; // Removed, the slot is filled when the sync page commits
+    switch(col) {
+        case 0: {
+            int year, month, day;
+            transaction_log_day_to_date(transaction->day, &year, &month, &day);
+            snprintf(buf, buf_size, "%02d/%02d", month, day);
+            return buf;
+        }
+        case 1:
+            return transaction->name; // Copied by the table, so it is never cut to the buffer size
+        default: {
+            // Plaid amounts are positive when money leaves the account
+            long cents = transaction->amount_cents;
+            snprintf(buf, buf_size, "%s$%ld.%02ld", cents > 0 ? "-" : "+", labs(cents) / 100, labs(cents) % 100);
+            return buf;
+        }
+    }
+}
+
+// Called after every synced page, only the row count changes so this is cheap on a virtual table
+static void transactions_synced_cb(uint32_t total) {
+    lvgl_lock();
+    if(transactions_table) lv_table_set_row_count(transactions_table, total);
+    lvgl_unlock();
+}
+
+static bool is_checking_account(const char* account_name) {
+    return strcmp(account_name, "Advantage Savings") == 0 ||
+           strcmp(account_name, "Rewards Checking") == 0 ||
+           strcmp(account_name, "Adv Plus Banking") == 0;
+}
+
+// Fills the account tables once both the accounts and the accounts page exist
+static void show_accounts() {
+    if(all_accounts == NULL || accounts_page == NULL) return;
+
+    // Collect every row first, the tables are measured, resized and redrawn once at the end
+    lv_table_begin_batch(checking_table);
+    lv_table_begin_batch(credit_table);
+
+    uint8_t num_of_checking_accounts = 0;
+    uint8_t num_of_credit_accounts = 0;
+    cJSON* account;
+    cJSON_ArrayForEach(account, all_accounts) {
+        cJSON* current_balance = cJSON_GetObjectItem(account, "Balance");
+        cJSON* current_account = cJSON_GetObjectItem(account, "Account");
+        if(!cJSON_IsString(current_account) || !cJSON_IsNumber(current_balance)) continue;
+
+        const char* account_name = cJSON_GetStringValue(current_account);
+        char balance_str[32];
+        sprintf(balance_str, "$%.2f", current_balance->valuedouble);
+
+        // Row 0 is the title row
+        if(is_checking_account(account_name)) {
+            num_of_checking_accounts++;
+            lv_table_set_row_count(checking_table, num_of_checking_accounts + 1);
+            lv_table_set_cell_value(checking_table, num_of_checking_accounts, 0, account_name);
+            lv_table_set_cell_value(checking_table, num_of_checking_accounts, 1, balance_str);
+        } else {
+            num_of_credit_accounts++;
+            lv_table_set_row_count(credit_table, num_of_credit_accounts + 1);
+            lv_table_set_cell_value(credit_table, num_of_credit_accounts, 0, account_name);
+            lv_table_set_cell_value(credit_table, num_of_credit_accounts, 1, balance_str);
+        }
+    }
+
+    lv_table_commit_batch(checking_table);
+    lv_table_commit_batch(credit_table);
+    // Update table sizes
+    lv_obj_set_size(checking_table, 310, LV_SIZE_CONTENT);
+    lv_obj_set_size(credit_table, 310, LV_SIZE_CONTENT);
+    lv_obj_align_to(credit_table, checking_table, LV_ALIGN_OUT_BOTTOM_MID, 0, 15);
+}
+
+// The accounts and transactions pages are created on their first visit
+static lv_obj_t* get_accounts_page() {
+    if(accounts_page == NULL) {
+        accounts_page_create();
+        show_accounts();
+        lv_page_cache_add_page(page_cache, accounts_page);
+    }
+    return accounts_page;
+}
+
+static lv_obj_t* get_transactions_page() {
+    if(transactions_page == NULL) {
+        transactions_page_create();
+        lv_table_set_cell_data_cb(transactions_table, transactions_cell_cb);
+        lv_table_set_row_count(transactions_table, transaction_log_count());
+        lv_page_cache_add_page(page_cache, transactions_page);
+    }
+    return transactions_page;
+}
+
+// One-shot LVGL timer, so it runs on lvgl_task
+static void clear_loading_screen(lv_timer_t* timer) {
     lv_screen_load(home_page);
+    lv_obj_remove_flag(nav_bar, LV_OBJ_FLAG_HIDDEN);
     data_loaded = true;
     lv_obj_delete(loading_screen);
 }
@@ -123,11 +365,37 @@ static void clear_loading_screen() {
 // Main LVGL task that will run indefinitely (Like void loop() in arduino)
 _Noreturn void lvgl_task() {
     while(true) {
+        lvgl_lock();
         lv_timer_handler();
+        lvgl_unlock();
         vTaskDelay(pdMS_TO_TICKS(20));
     }
 }
 
+// Shows a page and highlights its nav button. Runs on lvgl_task, whose stack also builds the pages
+// on their first visit
+static void show_page_cb(void* user_data) {
+    uint32_t page = (uint32_t)(uintptr_t)user_data;
+    lv_obj_set_style_text_color(home_button_label, deselected, LV_PART_MAIN);
+    lv_obj_set_style_text_color(accounts_button_label, deselected, LV_PART_MAIN);
+    lv_obj_set_style_text_color(transactions_button_label, deselected, LV_PART_MAIN);
+
+    switch(page) {
+        case 0:
+            lv_obj_set_style_text_color(home_button_label, lv_color_hex(0x000000), LV_PART_MAIN);
+            lv_screen_load(home_page);
+            break;
+        case 1:
+            lv_obj_set_style_text_color(accounts_button_label, lv_color_hex(0x000000), LV_PART_MAIN);
+            lv_screen_load(get_accounts_page());
+            break;
+        default:
+            lv_obj_set_style_text_color(transactions_button_label, lv_color_hex(0x000000), LV_PART_MAIN);
+            lv_screen_load(get_transactions_page());
+            break;
+    }
+}
+
 // Page changing gpio
 _Noreturn void next_page() {
     while (true) {
@@ -135,31 +403,9 @@ _Noreturn void next_page() {
 
         if(gpio_state == 0 && data_loaded) {
             (page_number > 1) ? page_number = 0 : page_number++;
-
-            lv_obj_set_style_text_color(home_button_label, deselected, LV_PART_MAIN);
-            lv_obj_set_style_text_color(accounts_button_label, deselected, LV_PART_MAIN);
-            lv_obj_set_style_text_color(transactions_button_label, deselected, LV_PART_MAIN);
-
-            switch(page_number) {
-                case 0:
-                    lv_obj_set_style_text_color(home_button_label, lv_color_hex(0x000000), LV_PART_MAIN);
-                    lv_screen_load_anim(home_page, LV_SCR_LOAD_ANIM_NONE, 100, 0, 0);
-                    vTaskDelay(pdMS_TO_TICKS(150));
-                    lv_obj_set_parent(nav_bar, home_page);
-                    break;
-                case 1:
-                    lv_obj_set_style_text_color(accounts_button_label, lv_color_hex(0x000000), LV_PART_MAIN);
-                    lv_screen_load_anim(accounts_page, LV_SCR_LOAD_ANIM_NONE, 100, 0, 0);
-                    vTaskDelay(pdMS_TO_TICKS(150));
-                    lv_obj_set_parent(nav_bar, accounts_page);
-                    break;
-                default:
-                    lv_obj_set_style_text_color(transactions_button_label, lv_color_hex(0x000000), LV_PART_MAIN);
-                    lv_screen_load_anim(transactions_page, LV_SCR_LOAD_ANIM_NONE, 100, 0, 0);
-                    vTaskDelay(pdMS_TO_TICKS(150));
-                    lv_obj_set_parent(nav_bar, transactions_page);
-                    break;
-            }
+            lvgl_lock();
+            lv_async_call(show_page_cb, (void*)(uintptr_t)page_number);
+            lvgl_unlock();
         }
 
         vTaskDelay(pdMS_TO_TICKS(100));
@@ -177,18 +423,24 @@ _Noreturn void scroll_ux() {
             // If either scroll up/down states are different from last recorded
             if(scroll_up_state != lastScrollUpState || scroll_down_state != lastScrollDownState) {
                 vTaskDelay(pdMS_TO_TICKS(50)); // Delay
+                lvgl_lock();
                 // Both start at logical state 1 (pull-up), so check if they are at 0
                 if(scroll_up_state == gpio_get_level(SCROLL_UP_BUTTON) && scroll_up_state == 0) {
                     if(lv_screen_active() == accounts_page) {
                         if(lv_obj_get_scroll_top(account_content) > 0) {
                             lv_obj_scroll_by(account_content, 0, 80, LV_ANIM_ON);
                         }
+                    } else if(lv_screen_active() == transactions_page) {
+                        lv_obj_scroll_by_bounded(transactions_table, 0, 80, LV_ANIM_ON);
                     }
                 } else if(scroll_down_state == gpio_get_level(SCROLL_DOWN_BUTTON) && scroll_down_state == 0) {
                     if(lv_screen_active() == accounts_page) {
                         lv_obj_scroll_by(account_content, 0, -80, LV_ANIM_ON);
+                    } else if(lv_screen_active() == transactions_page) {
+                        lv_obj_scroll_by_bounded(transactions_table, 0, -80, LV_ANIM_ON);
                     }
                 }
+                lvgl_unlock();
             }
             lastScrollUpState = scroll_up_state;
             lastScrollDownState = scroll_down_state;
@@ -235,6 +487,15 @@ void app_main(void) {
         ESP_ERROR_CHECK(nvs_flash_erase());
         ESP_ERROR_CHECK(nvs_flash_init());
     }
+    // Transactions live on the storage partition, the sync cursor in NVS
+    bool transaction_log_ready = transaction_log_init() == ESP_OK;
+    if(!transaction_log_ready) {
+        ESP_LOGE(TAG, "Transaction log unavailable, transactions are not synced");
+    }
+    // Monthly totals by category live on the raw txn_store partition, the sync keeps them next to the log
+    if(transaction_store_init(NULL) != ESP_OK) {
+        ESP_LOGE(TAG, "Transaction store unavailable");
+    }
 // -------------------------------------------  Wi-Fi  -------------------------------------------
     // Call function to init Wi-Fi
     wifi_init();
@@ -263,28 +524,20 @@ void app_main(void) {
             .lcd_cmd_bits = 8,
             .lcd_param_bits = 8,
             .trans_queue_depth = 10,
-            .on_color_trans_done = NULL,
+            .on_color_trans_done = NULL, // Registered once the display exists
             .user_ctx = NULL,
             .flags = {
                     .dc_low_on_data = 0,
                     .dc_low_on_param = 0
             }
     };
-    // Create the handle and set to empty
-    esp_lcd_panel_io_handle_t io_handle = NULL;
+#if DISPLAY_DIRECT_MODE
+    // Both bounce buffers are free
+    bounce_free = xSemaphoreCreateCounting(2, 2);
+#endif
 
     // Init the lcd with the empty handle & config
-    ESP_ERROR_CHECK(esp_lcd_new_panel_io_spi((esp_lcd_spi_bus_handle_t)SPI2_HOST, &io_config, &io_handle));
-// ------------------------------------------  Panel Config  ------------------------------------------
-    // Config panel data
-    esp_lcd_panel_dev_config_t panel_config = {
-            .reset_gpio_num = RST,
-            .rgb_ele_order = ESP_LCD_COLOR_SPACE_RGB,
-            .bits_per_pixel = 16
-    };
-
-    // Init the panel with the empty handle & config
-    ESP_ERROR_CHECK(esp_lcd_new_panel_ili9341(io_handle, &panel_config, &panel_handle));
+    ESP_ERROR_CHECK(esp_lcd_new_panel_io_spi((esp_lcd_spi_bus_handle_t)SPI2_HOST, &io_config, &lcd_io));
 // ------------------------------------------  Backlight config  ------------------------------------------
     // Define gpio for BL
     gpio_config_t bl_gpio_config = {
@@ -300,290 +553,72 @@ void app_main(void) {
     gpio_set_level(BL, 1);
 
 // ------------------------------------------  Resetting TFT  ------------------------------------------
-    ESP_ERROR_CHECK(esp_lcd_panel_reset(panel_handle));
-    ESP_ERROR_CHECK(esp_lcd_panel_init(panel_handle));
-
-// -----------------------------------  Set the display orientation ------------------------------------
-    ESP_ERROR_CHECK(esp_lcd_panel_swap_xy(panel_handle, true)); // True = Landscape
-    ESP_ERROR_CHECK(esp_lcd_panel_mirror(panel_handle, true, true));
-
-// ----------------------------------  Ensuring display is turned on  ----------------------------------
-    ESP_ERROR_CHECK(esp_lcd_panel_disp_on_off(panel_handle, true));
-    vTaskDelay(pdMS_TO_TICKS(100));
+    // Hardware reset, LVGL's ILI9341 driver sends the init sequence when the display is created
+    gpio_config_t rst_gpio_config = {
+            .pin_bit_mask = (1ULL << RST),
+            .mode = GPIO_MODE_OUTPUT,
+            .pull_up_en = GPIO_PULLUP_DISABLE,
+            .pull_down_en = GPIO_PULLDOWN_DISABLE,
+            .intr_type = GPIO_INTR_DISABLE
+    };
+    gpio_config(&rst_gpio_config);
+    gpio_set_level(RST, 0);
+    vTaskDelay(pdMS_TO_TICKS(10));
+    gpio_set_level(RST, 1);
+    vTaskDelay(pdMS_TO_TICKS(120));
 
 // --------------------------------------------  LVGL  --------------------------------------------
+    lvgl_mutex = xSemaphoreCreateRecursiveMutex();
     // Mandatory function. LVGL functions will not work without this
     lv_init();
+    // Images and animations are read in place from the mapped asset partition ("A:/...")
+    if(asset_fs_init() != ESP_OK) {
+        ESP_LOGW(TAG, "Asset pack unavailable");
+    }
     // set colors
     deselected = lv_color_make(14,14,28);
     // Set tick callback
     lv_tick_set_cb(lv_tick_get_cb);
-    // Creating LVGL display
-    lv_display_t *display = lv_display_create(320, 240);
+    lv_delay_set_cb(lv_delay_cb);
+    lv_image_cache_set_clock_cb(image_cache_clock_cb);
+    lv_text_layout_cache_set_clock_cb(text_layout_clock_cb);
+    lv_timer_create(image_cache_budget_cb, 500, NULL);
+    // Creating LVGL display, the driver initializes the panel
+    lv_display_t *display = lv_ili9341_create(320, 240, LV_LCD_FLAG_NONE, lcd_send_cmd, lcd_send_color);
+    // Landscape is the native orientation, rows and columns are swapped by the panel
+    lv_lcd_generic_mipi_set_address_mode(display, false, false, true, false);
     // Define screen color format
     lv_display_set_color_format(display, LV_COLOR_FORMAT_RGB565);
+#if DISPLAY_DIRECT_MODE
+    // Render in place into the persistent frame, only the changed areas are redrawn and sent
+    lv_display_set_buffers(display, frame, NULL, sizeof(frame), LV_DISPLAY_RENDER_MODE_DIRECT);
+#else
     // Set LVGL Buffers (2 buffers for smooth and consistent display)
     lv_display_set_buffers(display, buffer, buffer2, sizeof(buffer), LV_DISPLAY_RENDER_MODE_PARTIAL);
-    // Set LVGL draw (flush) callback
+#endif
+#if DISPLAY_DIRECT_MODE
+    // The changed areas are sent through the bounce buffers instead of the driver's flush
     lv_display_set_flush_cb(display, lvgl_flush_cb);
-    // Define rotation
+#endif
+    const esp_lcd_panel_io_callbacks_t lcd_io_cbs = {
+            .on_color_trans_done = lcd_color_trans_done_cb
+    };
+    ESP_ERROR_CHECK(esp_lcd_panel_io_register_event_callbacks(lcd_io, &lcd_io_cbs, display));
+    // Define rotation. The driver turns it into the panel's address mode (MADCTL), the pixels
+    // are sent as they are rendered and no rotated copy is made
     lv_display_set_rotation(display, LV_DISPLAY_ROTATION_180);
-
-    // Create loading screen
-    loading_screen = lv_obj_create(NULL);
-    lv_screen_load(loading_screen);
-    lv_obj_set_style_bg_color(loading_screen, lv_color_hex(0x000000), LV_PART_MAIN);
-    lv_obj_set_size(loading_screen, 320, 200);
-
-    // Create home screen
-    home_page = lv_obj_create(NULL);
-    // Set background to black
-    lv_obj_set_style_bg_color(home_page, lv_color_hex(0x000000), LV_PART_MAIN);
-    lv_obj_set_size(home_page, 320, 200);
-//-------------------------------------------------  LOADING SCREEN  --------------------------------------------------
-    // Center div
-    lv_style_t loading_div_style;
-    lv_style_init(&loading_div_style);
-    lv_style_set_border_width(&loading_div_style, 0);
-    lv_style_set_pad_all(&loading_div_style, 0);
-    lv_style_set_radius(&loading_div_style, 0);
-    lv_style_set_size(&loading_div_style, 220, 60);
-    lv_style_set_bg_color(&loading_div_style, lv_color_hex(0x000000));
-    lv_obj_t* loading_div = lv_obj_create(loading_screen);
-    lv_obj_add_style(loading_div, &loading_div_style, 0);
-    lv_obj_align(loading_div, LV_ALIGN_CENTER, 0, 0);
-
-
-    // Div header
-    lv_obj_t* loading_header = lv_label_create(loading_div);
-    lv_label_set_text(loading_header, LV_SYMBOL_WIFI " Loading...");
-    lv_obj_set_style_text_color(loading_header, lv_color_hex(0xffffff), LV_PART_MAIN);
-    lv_obj_align(loading_header, LV_ALIGN_BOTTOM_MID, 0, 0);
-
-// Fetching Progress Label Styles
-    // Bar Background Style
-    lv_style_init(&bar_style_bg);
-    lv_style_set_border_color(&bar_style_bg, lv_color_hex(0xffffff));
-    lv_style_set_border_width(&bar_style_bg, 2);
-    lv_style_set_pad_all(&bar_style_bg, 3);
-    lv_style_set_radius(&bar_style_bg, 10);
-    lv_style_set_anim_duration(&bar_style_bg, 1500);
-    // Bar Indicator Style
-    lv_style_init(&bar_style_indic);
-    lv_style_set_bg_opa(&bar_style_indic, LV_OPA_COVER);
-    lv_style_set_bg_color(&bar_style_indic, lv_color_hex(0x0000ff));
-    lv_style_set_radius(&bar_style_indic, 10);
-    // Bar Label
-    api_progress_label = lv_bar_create(loading_div);
-    lv_obj_remove_style_all(api_progress_label);
-    lv_obj_add_style(api_progress_label, &bar_style_bg, 0);
-    lv_obj_add_style(api_progress_label, &bar_style_indic, LV_PART_INDICATOR);
-    lv_obj_set_size(api_progress_label, 220, 30);
-    lv_bar_set_value(api_progress_label, 0, LV_ANIM_ON);
-    lv_obj_align(api_progress_label, LV_ALIGN_TOP_MID, 0, 0);
-
-//-----------------------------------------------------  NAV BAR  -----------------------------------------------------
-    // Nav bar style
-    lv_style_init(&nav_style);
-    lv_style_set_pad_hor(&nav_style, 0);
-    lv_style_set_pad_ver(&nav_style, 8);
-    lv_style_set_radius(&nav_style, 0);
-    lv_style_set_size(&nav_style, 320, 40);
-    lv_style_set_bg_opa(&nav_style, LV_OPA_COVER);
-    lv_style_set_bg_color(&nav_style, lv_color_make(28,1,38));
-    lv_style_set_text_color(&nav_style, lv_color_hex(0x000000));
-    lv_style_set_border_width(&nav_style, 0);
-    // Nav bar
-    nav_bar = lv_obj_create(home_page);
-    lv_obj_align(nav_bar, LV_ALIGN_TOP_MID, 0, 0);
-    lv_obj_add_style(nav_bar, &nav_style, 0);
-    lv_obj_set_scrollbar_mode(nav_bar, LV_SCROLLBAR_MODE_OFF);
-
-
-    //---------------------------  Menu  ---------------------------
-    // Menu style
-    lv_style_init(&menu_style);
-    lv_style_set_pad_hor(&menu_style, 4);
-    lv_style_set_pad_ver(&menu_style, 8);
-    lv_style_set_radius(&menu_style, 0);
-    lv_style_set_bg_opa(&menu_style, LV_OPA_COVER);
-    lv_style_set_bg_color(&menu_style, lv_color_make(28,1,38));
-    lv_style_set_border_width(&menu_style, 0);
-// Menu
-    lv_obj_t* menu = lv_obj_create(nav_bar);
-    lv_obj_align(menu, LV_ALIGN_LEFT_MID, 0, 0);
-    lv_obj_add_style(menu, &menu_style, 0);
-    lv_obj_set_scrollbar_mode(menu, LV_SCROLLBAR_MODE_OFF);
-
-    lv_style_init(&menu_button_style);
-    lv_style_set_pad_hor(&menu_button_style, 4);
-    lv_style_set_pad_ver(&menu_button_style, 8);
-    lv_style_set_radius(&menu_button_style, 0);
-    lv_style_set_size(&menu_button_style, 150, 35);
-    lv_style_set_bg_opa(&menu_button_style, LV_OPA_0);
-    lv_style_set_border_width(&menu_button_style, 0);
-    lv_style_set_outline_width(&menu_button_style, 0);
-    lv_style_set_shadow_width(&menu_button_style, 0);
-
-// Home Button
-    lv_obj_t* home_button = lv_button_create(menu);
-    lv_obj_align(home_button, LV_ALIGN_LEFT_MID, 0, 0);
-    lv_obj_add_style(home_button, &menu_button_style, 0);
-
-    home_button_label = lv_label_create(home_button);
-    lv_label_set_text(home_button_label, LV_SYMBOL_HOME);
-    lv_obj_set_style_text_color(home_button, lv_color_hex(0x000000), LV_PART_MAIN);
-
-// Accounts Button
-    lv_obj_t* accounts_button = lv_button_create(menu);
-    lv_obj_align(accounts_button, LV_ALIGN_LEFT_MID, 25, 0);
-    lv_obj_add_style(accounts_button, &menu_button_style, 0);
-
-    accounts_button_label = lv_label_create(accounts_button);
-    lv_label_set_text(accounts_button_label, LV_SYMBOL_LIST);
-    lv_obj_set_style_text_color(accounts_button, deselected, LV_PART_MAIN);
-
-// Transactions Button
-    lv_obj_t* transactions_button = lv_button_create(menu);
-    lv_obj_align(transactions_button, LV_ALIGN_LEFT_MID, 50, 0);
-    lv_obj_add_style(transactions_button, &menu_button_style, 0);
-
-    transactions_button_label = lv_label_create(transactions_button);
-    lv_label_set_text(transactions_button_label, LV_SYMBOL_BELL);
-    lv_obj_set_style_text_color(transactions_button, deselected, LV_PART_MAIN);
-
-    lv_obj_t *title = lv_label_create(nav_bar);
-    lv_label_set_text(title, "Finance Hub");
-    lv_obj_align(title, LV_ALIGN_CENTER, 0, 0);
-
-    // Time label
-    time_label = lv_label_create(nav_bar);
-    lv_label_set_text(time_label, "Fetching...");
-    lv_obj_align(time_label, LV_ALIGN_RIGHT_MID, -5, 0);
-    lv_obj_set_style_text_align(time_label, LV_TEXT_ALIGN_RIGHT, LV_PART_MAIN);
-
-//--------------------------------------------------------------------  HOME SCREEN  --------------------------------------------------------------------
-    // Counter label
-    counter_label = lv_label_create(home_page);
-    lv_label_set_text(counter_label, "Count: 0");
-    lv_obj_set_style_text_color(counter_label, lv_color_hex(0xffffff), LV_PART_MAIN);
-    lv_obj_align(counter_label, LV_ALIGN_TOP_MID, 0, 45);
-
-    // Credit Cards Balance
-    lv_obj_t *total_credit_balance_label = lv_label_create(home_page);
-    lv_label_set_text(total_credit_balance_label, LV_SYMBOL_WIFI " Credit...");
-    lv_obj_set_style_text_color(total_credit_balance_label, lv_color_hex(0xffffff), LV_PART_MAIN);
-    lv_obj_align(total_credit_balance_label, LV_ALIGN_LEFT_MID, 20, 0);
-    lv_obj_set_style_text_align(total_credit_balance_label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
-
-
-    // Checking Accounts Balance
-    lv_obj_t *total_checking_balance_label = lv_label_create(home_page);
-    lv_label_set_text(total_checking_balance_label, LV_SYMBOL_WIFI " Checking...");
-    lv_obj_set_style_text_color(total_checking_balance_label, lv_color_hex(0xffffff), LV_PART_MAIN);
-    lv_obj_align(total_checking_balance_label, LV_ALIGN_RIGHT_MID, -20, 0);
-    lv_obj_set_style_text_align(total_checking_balance_label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
-
-
-    // Total Balance
-    lv_obj_t *total_balance = lv_label_create(home_page);
-    lv_label_set_text(total_balance, LV_SYMBOL_WIFI " Total Balance...");
-    lv_obj_align(total_balance, LV_ALIGN_BOTTOM_MID, 0, -40);
-    lv_obj_set_style_text_align(total_balance, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
-    lv_obj_set_style_text_color(total_balance, lv_color_hex(0xffffff), LV_PART_MAIN);
-//--------------------------------------------------------------------  ACCOUNTS SCREEN  --------------------------------------------------------------------
-    // Create accounts screen
-    accounts_page = lv_obj_create(NULL);
-    lv_obj_set_style_bg_color(accounts_page, lv_color_hex(0x000000), LV_PART_MAIN);
-
-    // Account page div
-    account_content = lv_obj_create(accounts_page);
-    lv_obj_set_size(account_content, 320, 190);
-    lv_obj_set_style_bg_opa(account_content, LV_OPA_0, LV_PART_MAIN);
-    lv_obj_set_style_text_color(account_content, lv_color_hex(0x000000), 0);
-    lv_obj_set_style_border_width(account_content, 0, 0);
-    lv_obj_set_style_outline_width(account_content, 0, 0);
-    lv_obj_set_style_shadow_width(account_content, 0, 0);
-    lv_obj_set_style_pad_all(account_content, 0, 0);
-    lv_obj_align(account_content, LV_ALIGN_TOP_MID, 0, 50);
-//    lv_obj_set_layout(account_content, LV_LAYOUT_FLEX);
-//    lv_obj_set_flex_flow(account_content, LV_FLEX_FLOW_COLUMN);
-//    lv_obj_set_flex_align(account_content, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_END, LV_FLEX_ALIGN_CENTER);
-
-    // Table Style
-    lv_style_init(&table_style);
-    lv_style_set_pad_all(&table_style, 0);
-    lv_style_set_radius(&table_style, 0);
-    lv_style_set_size(&table_style, 310, 60);
-    lv_style_set_bg_opa(&table_style, LV_OPA_0);
-//    lv_style_set_bg_color(&table_style, lv_color_make(0,255,0));
-    lv_style_set_border_width(&table_style, 0);
-    lv_style_set_outline_width(&table_style, 0);
-    lv_style_set_shadow_width(&table_style, 0);
-    lv_style_set_text_color(&table_style, lv_color_hex(0x000000));
-
-    // Checking Table
-    checking_table = lv_table_create(account_content);
-    lv_table_set_column_count(checking_table, 2);
-    lv_table_set_row_count(checking_table, 1);
-    lv_table_set_column_width(checking_table, 0, 180);
-    lv_table_set_column_width(checking_table, 1, 120);
-    // Cell Styling
-    lv_obj_set_style_bg_color(checking_table, lv_color_make(0,255,50), LV_PART_ITEMS);
-    lv_obj_set_style_border_color(checking_table, lv_color_hex(0x000000), LV_PART_ITEMS);
-    lv_obj_set_style_border_width(checking_table, 1, LV_PART_ITEMS);
-    // Style for table
-    lv_obj_add_style(checking_table, &table_style, 0);
-    lv_table_set_cell_value(checking_table, 0, 0, "Checking Account");
-    lv_table_set_cell_value(checking_table, 0, 1, "Balance");
-    // Item text color
-    lv_obj_set_style_text_color(checking_table, lv_color_hex(0x000000), LV_PART_ITEMS);
-//    lv_obj_set_layout(checking_table, LV_LAYOUT_FLEX);          // Flex
-//    lv_obj_set_flex_flow(checking_table, LV_FLEX_FLOW_ROW);     // Flex-direction
-//    lv_obj_set_flex_align(checking_table, LV_FLEX_ALIGN_SPACE_BETWEEN, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER); // flex-align
-    lv_obj_set_style_pad_row(checking_table, 5, 0);
-    lv_obj_align(checking_table, LV_ALIGN_TOP_MID, 0, 0);
-/*
-
-    // Spacer
-    lv_obj_t *account_content_spacer = lv_obj_create(account_content);
-    lv_obj_set_size(account_content_spacer, 320, 40);
-    lv_obj_set_style_border_width(account_content_spacer, 0, 0);
-//    lv_obj_set_style_bg_color(account_content_spacer, lv_color_hex(0x000000), LV_PART_MAIN);
-//    lv_obj_align(account_content_spacer, LV_ALIGN_TOP_MID, 0, lv_obj_get_height(checking_table));
-    lv_obj_align_to(account_content_spacer, checking_table, LV_ALIGN_OUT_BOTTOM_MID, 0, 0);
-*/
-
-    // Credit Table
-    credit_table = lv_table_create(account_content);
-    lv_table_set_column_count(credit_table, 2);
-    lv_table_set_row_count(credit_table, 1);
-    lv_table_set_column_width(credit_table, 0, 180);
-    lv_table_set_column_width(credit_table, 1, 120);
-    lv_obj_set_style_bg_color(credit_table, lv_color_make(14,14,28), LV_PART_ITEMS);
-    lv_obj_set_style_border_color(credit_table, lv_color_hex(0x000000), LV_PART_ITEMS);
-    lv_obj_set_style_border_width(credit_table, 1, LV_PART_ITEMS);
-    lv_obj_add_style(credit_table, &table_style, 0);
-    lv_table_set_cell_value(credit_table, 0, 0, "Credit Account");
-    lv_table_set_cell_value(credit_table, 0, 1, "Balance");
-    lv_obj_set_style_text_color(credit_table, lv_color_hex(0x000000), LV_PART_ITEMS);
-//    lv_obj_set_layout(credit_table, LV_LAYOUT_FLEX);            // Flex
-//    lv_obj_set_flex_flow(credit_table, LV_FLEX_FLOW_ROW);       // Flex-direction
-//    lv_obj_set_flex_align(credit_table, LV_FLEX_ALIGN_SPACE_BETWEEN, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER); // flex-align
-    lv_obj_set_style_pad_row(credit_table, 5, 0);
-//    lv_obj_align(credit_table, LV_ALIGN_TOP_MID, 0, (lv_obj_get_height(checking_table) + lv_obj_get_height(account_content_spacer)));
-
-//------------------------------------------------------------------  TRANSACTIONS SCREEN  ------------------------------------------------------------------
-    transactions_page = lv_obj_create(NULL);
-    lv_obj_set_style_bg_color(transactions_page, lv_color_hex(0x000000), LV_PART_MAIN);
-
-    // Counter label
-    lv_obj_t *transactions_label = lv_label_create(transactions_page);
-    lv_label_set_text(transactions_label, "Transactions Page");
-    lv_obj_set_style_text_color(transactions_label, lv_color_hex(0xffffff), LV_PART_MAIN);
-    lv_obj_align(transactions_label, LV_ALIGN_TOP_MID, 0, 45);
-
-
+    page_cache = lv_page_cache_create(display, page_cache_buf, sizeof(page_cache_buf));
+
+    // Only the loading screen, the home page and the nav bar shared by the pages are built at boot
+    int64_t ui_start = esp_timer_get_time();
+    lv_screen_load(loading_screen_create());
+    home_page_create();
+    lv_page_cache_add_page(page_cache, home_page);
+    chrome_create();
+    lv_mem_monitor_t mem_mon;
+    lv_mem_monitor(&mem_mon);
+    ESP_LOGI(TAG, "UI built in %lld us, %u bytes of LVGL heap used", esp_timer_get_time() - ui_start,
+             (unsigned)(mem_mon.total_size - mem_mon.free_size));
 
     // Create timer updater
     lv_timer_create(counter_update_cb, 1000, NULL);
@@ -607,14 +642,15 @@ void app_main(void) {
             "Capital One"
     };
     int token_count = sizeof(access_tokens) / sizeof(access_tokens[0]);
-    cJSON* all_accounts = cJSON_CreateArray();
+    cJSON* fetched_accounts = cJSON_CreateArray();
     double total_credit_balance = 0.0;
     double total_checking_balance = 0.0;
 
-    // Go over each account and place it in all_accounts
+    // Go over each account and place it in fetched_accounts
     for(int i = 0; i < token_count-3; i++) {
         char* balance_response = plaid_fetch_balance(access_tokens[i], access_tokens[i + 3]);
         // Visual update on API progress
+        lvgl_lock();
         switch(i) {
             case 0:
                 lv_bar_set_value(api_progress_label, 50, LV_ANIM_ON);
@@ -629,6 +665,7 @@ void app_main(void) {
                 lv_bar_set_value(api_progress_label, 0, LV_ANIM_ON);
                 break;
         }
+        lvgl_unlock();
         ESP_LOGI(TAG, "Finished %s", access_tokens[i+3]);
         if(balance_response) {
 //            ESP_LOGI(TAG, "MAIN CODE: %s", balance_response);
@@ -636,52 +673,20 @@ void app_main(void) {
             if(institution_accounts) {
                 cJSON* account;
                 cJSON_ArrayForEach(account, institution_accounts) {
-                    cJSON_AddItemToArray(all_accounts, cJSON_Duplicate(account, 1)); // Copy to the new local array
+                    cJSON_AddItemToArray(fetched_accounts, cJSON_Duplicate(account, 1)); // Copy to the new local array
 
                     // Get the balance & account name.
                     cJSON* current_balance = cJSON_GetObjectItem(account, "Balance");
                     cJSON* current_account = cJSON_GetObjectItem(account, "Account");
 
                     if(cJSON_IsString(current_account) && cJSON_IsNumber(current_balance)) {
-                        // Define account name and balance as appropriate variable types
-                        const char* account_name = cJSON_GetStringValue(current_account);
-                        double balance_double = current_balance->valuedouble;
-                        // Save balance as string temporarily
-                        char balance_str_temp[32];
-                        sprintf(balance_str_temp, "$%.2f", balance_double);
-
-                        /*
-                            If it is a checking account, add to checking total, else add to credit total.
-                            Also add to accounts table based on checking or credit
-                        */
-                        if(strcmp(account_name, "Advantage Savings") == 0 ||
-                                strcmp(account_name, "Rewards Checking") == 0 ||
-                                strcmp(account_name, "Adv Plus Banking") == 0) {
-                            total_checking_balance += balance_double; // Add balance to checking balance
-
-                            // Account page data
-                            num_of_checking_accounts++;
-                            // Num of checking accounts plus 1 (the title row)
-                            lv_table_set_row_count(checking_table, (num_of_checking_accounts+1));
-
-                            // Set data for new row
-                            lv_table_set_cell_value(checking_table, num_of_checking_accounts, 0, account_name);
-                            lv_table_set_cell_value(checking_table, num_of_checking_accounts, 1, balance_str_temp);
+                        // If it is a checking account, add to checking total, else add to credit total.
+                        // The accounts table is filled by show_accounts()
+                        if(is_checking_account(cJSON_GetStringValue(current_account))) {
+                            total_checking_balance += current_balance->valuedouble;
                         } else {
-                            total_credit_balance += balance_double; // Add balance to credit balance
-                            //Account page data
-                            num_of_credit_accounts++;
-                            // Num of credit accounts plus 1 (title row)
-                            lv_table_set_row_count(credit_table, (num_of_credit_accounts+1));
-
-                            // Set data for new row
-                            lv_table_set_cell_value(credit_table, num_of_credit_accounts, 0, account_name);
-                            lv_table_set_cell_value(credit_table, num_of_credit_accounts, 1, balance_str_temp);
+                            total_credit_balance += current_balance->valuedouble;
                         }
-                        // Update table sizes
-                        lv_obj_set_size(checking_table, 310, LV_SIZE_CONTENT);
-                        lv_obj_set_size(credit_table, 310, LV_SIZE_CONTENT);
-                        lv_obj_align_to(credit_table, checking_table, LV_ALIGN_OUT_BOTTOM_MID, 0, 15);
                     } else {
                         ESP_LOGW(TAG, "Invalid Response");
                     }
@@ -694,28 +699,25 @@ void app_main(void) {
         }
     }
 
-    char total_credit_balance_string[32];
-    sprintf(total_credit_balance_string, "Credit Balance\n$%.2f", total_credit_balance);
-    lv_label_set_text(total_credit_balance_label, total_credit_balance_string);
-
-    char total_checking_balance_string[32];
-    sprintf(total_checking_balance_string, "Checking Balance\n$%.2f", total_checking_balance);
-    lv_label_set_text(total_checking_balance_label, total_checking_balance_string);
-
-    char total_balance_calc_string[32];
-    sprintf(total_balance_calc_string, "Total Balance\n$%.2f", total_checking_balance - total_credit_balance);
-    lv_label_set_text(total_balance, total_balance_calc_string);
+    balances.credit = total_credit_balance;
+    balances.checking = total_checking_balance;
+    lvgl_lock();
+    // Fills the tables now if the accounts page was already visited, else on the first visit
+    all_accounts = fetched_accounts;
+    show_accounts();
+    lv_async_call(show_balances_cb, &balances);
 
     // Create a one-shot timer with a 5-second delay
-    TimerHandle_t bar_deletion_timer = xTimerCreate(
-            "Delete_Bar_Timer",
-            pdMS_TO_TICKS(5000),
-            pdFALSE,                     // One-shot timer
-            NULL,
-            clear_loading_screen        // Callback function
-    );
-
-    if(bar_deletion_timer != NULL) { xTimerStart(bar_deletion_timer, 0); }
+    lv_timer_t* bar_deletion_timer = lv_timer_create(clear_loading_screen, 5000, NULL);
+    lv_timer_set_repeat_count(bar_deletion_timer, 1);
+    lvgl_unlock();
+
+    // Pull new transactions page by page while the UI is already usable
+    for(int i = 0; transaction_log_ready && i < token_count-3; i++) {
+        if(plaid_sync_transactions(access_tokens[i], i, transactions_synced_cb) != ESP_OK) {
+            ESP_LOGE(TAG, "Transactions sync failed for %s", access_tokens[i + 3]);
+        }
+    }
 
     // From here, the _Noreturn void lvgl_task() will run until the system is powered off.
 //    clear_loading_screen();
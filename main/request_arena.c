@@ -0,0 +1,139 @@
+#include "request_arena.h"
+#include "cJSON.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Every allocation is aligned to this so cJSON's doubles and pointers are safe
+#define ARENA_ALIGN 8
+#define ARENA_ALIGN_UP(x) (((x) + (ARENA_ALIGN - 1)) & ~((size_t)ARENA_ALIGN - 1))
+
+// cJSON hooks are process-global and take no user data. They are installed once and send only the
+// attached task's allocations to its arena, every other task keeps using malloc/free
+static request_arena_t* cjson_arena = NULL;
+static TaskHandle_t cjson_task = NULL;
+static SemaphoreHandle_t cjson_mutex = NULL;
+static portMUX_TYPE cjson_init_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Every initialized arena, so a cJSON free of arena memory is recognized whichever task does it
+static request_arena_t* arenas = NULL;
+
+esp_err_t request_arena_init(request_arena_t* arena, void* region, size_t capacity) {
+    memset(arena, 0, sizeof(*arena));
+    if(region == NULL) {
+        region = malloc(capacity);
+        if(!region) return ESP_ERR_NO_MEM;
+        arena->owned_region = region;
+    }
+    // Start on an aligned address so offsets can be aligned on their own
+    uintptr_t misalign = (uintptr_t)region & (ARENA_ALIGN - 1);
+    size_t skip = misalign ? ARENA_ALIGN - misalign : 0;
+    arena->base = (unsigned char*)region + skip;
+    arena->capacity = capacity > skip ? capacity - skip : 0;
+
+    taskENTER_CRITICAL(&cjson_init_lock);
+    arena->next = arenas;
+    arenas = arena;
+    taskEXIT_CRITICAL(&cjson_init_lock);
+    return ESP_OK;
+}
+
+void request_arena_deinit(request_arena_t* arena) {
+    if(cjson_arena == arena) request_arena_detach_cjson();
+
+    taskENTER_CRITICAL(&cjson_init_lock);
+    request_arena_t** link = &arenas;
+    while(*link && *link != arena) link = &(*link)->next;
+    if(*link) *link = arena->next;
+    taskEXIT_CRITICAL(&cjson_init_lock);
+
+    free(arena->owned_region);
+    memset(arena, 0, sizeof(*arena));
+}
+
+void* request_arena_alloc(request_arena_t* arena, size_t size) {
+    size_t offset = ARENA_ALIGN_UP(arena->used);
+    if(size > arena->capacity || offset > arena->capacity - size) {
+        arena->exhausted = true;
+        return NULL;
+    }
+
+    arena->last_offset = offset;
+    arena->used = offset + size;
+    if(arena->used > arena->high_water) arena->high_water = arena->used;
+    return arena->base + offset;
+}
+
+void* request_arena_realloc(request_arena_t* arena, void* ptr, size_t old_size, size_t new_size) {
+    if(ptr == NULL) return request_arena_alloc(arena, new_size);
+
+    // The last allocation can simply be extended
+    if((unsigned char*)ptr == arena->base + arena->last_offset) {
+        if(new_size > arena->capacity - arena->last_offset) {
+            arena->exhausted = true;
+            return NULL;
+        }
+        arena->used = arena->last_offset + new_size;
+        if(arena->used > arena->high_water) arena->high_water = arena->used;
+        return ptr;
+    }
+
+    if(new_size <= old_size) return ptr;
+    void* moved = request_arena_alloc(arena, new_size);
+    if(moved) memcpy(moved, ptr, old_size);
+    return moved;
+}
+
+void request_arena_reset(request_arena_t* arena) {
+    arena->used = 0;
+    arena->last_offset = 0;
+    arena->exhausted = false;
+}
+
+// -----------------------  cJSON hooks  -----------------------
+static void* cjson_arena_malloc(size_t size) {
+    if(cjson_task == xTaskGetCurrentTaskHandle()) return request_arena_alloc(cjson_arena, size);
+    return malloc(size);
+}
+
+// Frees of arena memory are no-ops, it comes back with request_arena_reset
+static void cjson_arena_free(void* ptr) {
+    for(request_arena_t* arena = arenas; arena; arena = arena->next) {
+        if((unsigned char*)ptr >= arena->base && (unsigned char*)ptr < arena->base + arena->capacity) return;
+    }
+    free(ptr);
+}
+
+void request_arena_attach_cjson(request_arena_t* arena) {
+    if(cjson_mutex == NULL) {
+        // Tasks racing here each create a mutex, the first one to publish it installs the hooks
+        SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+        configASSERT(mutex);
+        taskENTER_CRITICAL(&cjson_init_lock);
+        bool install = cjson_mutex == NULL;
+        if(install) cjson_mutex = mutex;
+        taskEXIT_CRITICAL(&cjson_init_lock);
+        if(install) {
+            cJSON_Hooks hooks = {
+                    .malloc_fn = cjson_arena_malloc,
+                    .free_fn = cjson_arena_free
+            };
+            cJSON_InitHooks(&hooks);
+        } else {
+            vSemaphoreDelete(mutex);
+        }
+    }
+
+    xSemaphoreTake(cjson_mutex, portMAX_DELAY);
+    cjson_arena = arena;
+    cjson_task = xTaskGetCurrentTaskHandle();
+}
+
+void request_arena_detach_cjson(void) {
+    cjson_task = NULL;
+    cjson_arena = NULL;
+    xSemaphoreGive(cjson_mutex);
+}
@@ -0,0 +1,75 @@
+#ifndef ESP32C6_FINANCE_HUB_REQUEST_ARENA_H
+#define ESP32C6_FINANCE_HUB_REQUEST_ARENA_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+/**
+ * Bump allocator used for everything a single HTTP request needs (response body, cJSON tree, printed output).
+ * Allocations are never freed one by one; the whole arena is reset in O(1) once the request is done.
+*/
+typedef struct request_arena_t {
+    unsigned char* base;     // Start of the backing region
+    size_t capacity;         // Size of the backing region in bytes
+    size_t used;             // Bytes handed out since the last reset
+    size_t last_offset;      // Offset of the most recent allocation (lets it grow in place)
+    size_t high_water;       // Largest `used` seen since init
+    bool exhausted;          // An allocation failed since the last reset, what was built may be incomplete
+    void* owned_region;      // Heap block allocated by request_arena_init (NULL for static regions)
+    struct request_arena_t* next; // Next initialized arena, lets the cJSON free hook recognize arena memory
+} request_arena_t;
+
+/**
+ * @brief Initialize an arena
+ * @param arena Arena to initialize
+ * @param region Reusable static region to allocate from. Pass NULL to allocate `capacity` bytes from the heap once
+ * @param capacity Size of the region in bytes. This is the worst-case memory a request can use
+ * @return ESP_OK or ESP_ERR_NO_MEM if the heap region could not be allocated
+*/
+esp_err_t request_arena_init(request_arena_t* arena, void* region, size_t capacity);
+
+/**
+ * @brief Release the heap region of an arena (no-op for static regions)
+ * @param arena Arena to deinitialize
+*/
+void request_arena_deinit(request_arena_t* arena);
+
+/**
+ * @brief Allocate memory from the arena
+ * @param arena Arena to allocate from
+ * @param size Number of bytes
+ * @return Pointer aligned for any type, or NULL if the arena is exhausted
+*/
+void* request_arena_alloc(request_arena_t* arena, size_t size);
+
+/**
+ * @brief Grow an allocation. If `ptr` is the most recent allocation it is extended in place
+ * @param arena Arena the memory came from
+ * @param ptr Previous allocation (or NULL)
+ * @param old_size Current size of `ptr`
+ * @param new_size Requested size
+ * @return Pointer to the (possibly moved) memory, or NULL if the arena is exhausted. `ptr` stays valid on failure
+*/
+void* request_arena_realloc(request_arena_t* arena, void* ptr, size_t old_size, size_t new_size);
+
+/**
+ * @brief Drop every allocation at once and clear `exhausted`. Pointers handed out before are invalid afterward
+ * @param arena Arena to reset
+*/
+void request_arena_reset(request_arena_t* arena);
+
+/**
+ * @brief Route the calling task's cJSON allocations into an arena until request_arena_detach_cjson is called.
+ * Other tasks keep allocating with malloc. Only one arena is attached at a time, a second caller blocks until
+ * the first one detaches
+ * @param arena Arena cJSON should allocate from
+*/
+void request_arena_attach_cjson(request_arena_t* arena);
+
+/**
+ * @brief Stop routing the calling task's cJSON allocations into the attached arena
+*/
+void request_arena_detach_cjson(void);
+
+#endif //ESP32C6_FINANCE_HUB_REQUEST_ARENA_H
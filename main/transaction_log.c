@@ -0,0 +1,408 @@
+#include "transaction_log.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <unistd.h>
+#include "esp_log.h"
+#include "esp_spiffs.h"
+#include "nvs.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+// Mount point of the storage partition. The host checks point it at a directory
+#ifndef TRANSACTION_LOG_MOUNT
+#define TRANSACTION_LOG_MOUNT "/storage"
+#endif
+#define LOG_PATH TRANSACTION_LOG_MOUNT "/txn.log"
+#define NVS_NAMESPACE "txn_log"
+#define LOG_FORMAT 2 // Version of transaction_record_t, 1 kept a 32-bit hash instead of the id
+#define SCAN_CHUNK 16 // Records read at once while loading the index
+#define INDEX_CHUNK 1024 // Index entries per block, 4 KB, so a growing log never needs one large block
+#define TOMBSTONE 0 // Index entry of a removed record, index_hash never returns it
+
+_Static_assert(sizeof(transaction_record_t) == 92, "transaction_record_t must stay 92 bytes, it is the on-flash format");
+
+static const char *LOG_TAG = "Transaction Log";
+
+static bool log_ready = false; // Set once init succeeded, every call fails before that
+static FILE* log_file = NULL;
+static SemaphoreHandle_t log_lock = NULL; // The LVGL task reads while the sync task writes
+static uint32_t record_count = 0;
+static uint32_t committed_count = 0; // record_count as of the last commit
+static uint32_t revision = 0;
+static transaction_record_t scan_buffer[SCAN_CHUNK];
+static const transaction_record_t removed_record; // All zero, written over removed records
+
+// Id hash of every record (4 bytes per transaction), so a lookup only reads records whose hash matches.
+// Kept in INDEX_CHUNK blocks, ID_INDEX(i) is the entry of record i
+static uint32_t** index_chunks = NULL;
+static uint32_t index_chunk_count = 0;
+#define ID_INDEX(i) index_chunks[(i) / INDEX_CHUNK][(i) % INDEX_CHUNK]
+static uint32_t tombstones = 0; // Removed records still taking a slot
+
+// -----------------------  Helpers (call with log_lock held)  -----------------------
+static uint32_t index_hash(const char* id) {
+    uint32_t hash = transaction_log_hash_id(id);
+    return hash == TOMBSTONE ? 1 : hash;
+}
+
+static bool is_valid_id(const char* id) {
+    return id[0] != '\0' && memchr(id, '\0', TRANSACTION_ID_LEN) != NULL;
+}
+
+// Add index blocks until `count` records fit. Blocks are only freed with the whole index
+static esp_err_t reserve_index(uint32_t count) {
+    while((uint64_t)index_chunk_count * INDEX_CHUNK < count) {
+        uint32_t** chunks = realloc(index_chunks, (index_chunk_count + 1) * sizeof(uint32_t*));
+        uint32_t* chunk = chunks ? malloc(INDEX_CHUNK * sizeof(uint32_t)) : NULL;
+        if(chunks) index_chunks = chunks;
+        if(!chunk) {
+            ESP_LOGE(LOG_TAG, "No memory to index %lu records", (unsigned long)count);
+            return ESP_ERR_NO_MEM;
+        }
+        index_chunks[index_chunk_count++] = chunk;
+    }
+    return ESP_OK;
+}
+
+static void free_index(void) {
+    for(uint32_t i = 0; i < index_chunk_count; i++) free(index_chunks[i]);
+    free(index_chunks);
+    index_chunks = NULL;
+    index_chunk_count = 0;
+}
+
+static esp_err_t write_record(uint32_t index, const transaction_record_t* record) {
+    if(fseek(log_file, (long)index * sizeof(transaction_record_t), SEEK_SET) != 0 ||
+       fwrite(record, sizeof(*record), 1, log_file) != 1) {
+        ESP_LOGE(LOG_TAG, "Failed to write record %lu", (unsigned long)index);
+        return ESP_FAIL;
+    }
+    revision++;
+    return ESP_OK;
+}
+
+static size_t read_records(uint32_t first, transaction_record_t* out, size_t max) {
+    if(first >= record_count) return 0;
+    if(max > record_count - first) max = record_count - first;
+    if(fseek(log_file, (long)first * sizeof(transaction_record_t), SEEK_SET) != 0) return 0;
+    return fread(out, sizeof(transaction_record_t), max, log_file);
+}
+
+// Returns the index of the record with the id among the first `limit` records, or UINT32_MAX.
+// The hash only picks candidates, their full id is read back and compared
+static uint32_t find_record(const char* id, uint32_t hash, uint32_t limit) {
+    char stored[TRANSACTION_ID_LEN];
+    for(uint32_t i = 0; i < limit; i++) {
+        if(ID_INDEX(i) != hash) continue;
+        if(fseek(log_file, (long)i * sizeof(transaction_record_t) + offsetof(transaction_record_t, id), SEEK_SET) == 0 &&
+           fread(stored, sizeof(stored), 1, log_file) == 1 && strncmp(stored, id, sizeof(stored)) == 0) {
+            return i;
+        }
+    }
+    return UINT32_MAX;
+}
+
+static esp_err_t set_compacting(uint8_t compacting) {
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if(err == ESP_OK) {
+        err = nvs_set_u8(nvs, "compacting", compacting);
+        if(err == ESP_OK) err = nvs_commit(nvs);
+        nvs_close(nvs);
+    }
+    return err;
+}
+
+// Records first, then the count (and the cursor) that point at them. Ends a compaction
+static esp_err_t save_state(uint8_t institution, const char* cursor) {
+    fflush(log_file);
+    fsync(fileno(log_file));
+
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if(err == ESP_OK) {
+        err = nvs_set_u32(nvs, "count", record_count);
+        if(err == ESP_OK) err = nvs_set_u8(nvs, "compacting", 0);
+        if(err == ESP_OK && cursor) {
+            char key[16];
+            snprintf(key, sizeof(key), "cursor%u", institution);
+            err = nvs_set_str(nvs, key, cursor);
+        }
+        if(err == ESP_OK) err = nvs_commit(nvs);
+        nvs_close(nvs);
+    }
+    return err;
+}
+
+// Move the last records into the slots of removed ones, so the log is dense again. A reset halfway leaves some
+// records on flash twice, the "compacting" flag makes the next init drop the second copies
+static esp_err_t compact(void) {
+    if(tombstones == 0) return ESP_OK;
+    esp_err_t err = set_compacting(1);
+
+    uint32_t hole = 0;
+    while(tombstones && err == ESP_OK) {
+        uint32_t last = record_count - 1;
+        if(ID_INDEX(last) != TOMBSTONE) {
+            while(ID_INDEX(hole) != TOMBSTONE) hole++; // Always below `last`
+            transaction_record_t moved;
+            err = read_records(last, &moved, 1) == 1 ? write_record(hole, &moved) : ESP_FAIL;
+            if(err != ESP_OK) break;
+            ID_INDEX(hole) = ID_INDEX(last);
+        }
+        record_count--;
+        tombstones--;
+        revision++;
+    }
+    if(committed_count > record_count) committed_count = record_count;
+    return err;
+}
+
+// Hash every record into the index. Removed records become tombstones, and so do second copies after a
+// compaction cut short by a reset
+static esp_err_t load_index(bool compacting) {
+    esp_err_t err = reserve_index(record_count);
+    if(err != ESP_OK) return err;
+
+    tombstones = 0;
+    for(uint32_t first = 0; first < record_count; first += SCAN_CHUNK) {
+        size_t n = read_records(first, scan_buffer, SCAN_CHUNK);
+        if(n == 0) return ESP_FAIL;
+        for(size_t i = 0; i < n; i++) {
+            const char* id = scan_buffer[i].id;
+            uint32_t hash = is_valid_id(id) ? index_hash(id) : TOMBSTONE;
+            if(hash != TOMBSTONE && compacting && find_record(id, hash, first + i) != UINT32_MAX) hash = TOMBSTONE;
+            ID_INDEX(first + i) = hash;
+            if(hash == TOMBSTONE) tombstones++;
+        }
+    }
+    return ESP_OK;
+}
+
+// Mount the storage, open the file and load its index. May leave things half set up on failure
+static esp_err_t open_log(void) {
+    esp_vfs_spiffs_conf_t conf = {
+            .base_path = TRANSACTION_LOG_MOUNT,
+            .partition_label = "storage",
+            .max_files = 4,
+            .format_if_mount_failed = true
+    };
+    esp_err_t err = esp_vfs_spiffs_register(&conf);
+    if(err != ESP_OK) {
+        ESP_LOGE(LOG_TAG, "Failed to mount storage: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    if(!log_lock) log_lock = xSemaphoreCreateMutex();
+    if(!log_lock) return ESP_ERR_NO_MEM;
+
+    // Only records covered by the last commit count, anything after that is an interrupted sync
+    nvs_handle_t nvs;
+    uint32_t format = 0;
+    uint8_t compacting = 0;
+    err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if(err != ESP_OK) {
+        ESP_LOGE(LOG_TAG, "Failed to open NVS: %s", esp_err_to_name(err));
+        return err;
+    }
+    nvs_get_u32(nvs, "format", &format);
+    nvs_get_u32(nvs, "count", &record_count);
+    nvs_get_u8(nvs, "compacting", &compacting);
+    bool fresh = format != LOG_FORMAT;
+    if(fresh) {
+        // Records of another format can't be read. Start over, the cursors go too so everything is synced again
+        if(record_count) ESP_LOGW(LOG_TAG, "Dropping %lu records of log format %lu", (unsigned long)record_count,
+                                  (unsigned long)format);
+        record_count = 0;
+        compacting = 0;
+        err = nvs_erase_all(nvs);
+        if(err == ESP_OK) err = nvs_set_u32(nvs, "format", LOG_FORMAT);
+        if(err == ESP_OK) err = nvs_commit(nvs);
+    }
+    nvs_close(nvs);
+    if(err != ESP_OK) return err;
+
+    log_file = fresh ? NULL : fopen(LOG_PATH, "r+b");
+    if(!log_file) log_file = fopen(LOG_PATH, "w+b"); // First boot
+    if(!log_file) {
+        ESP_LOGE(LOG_TAG, "Failed to open %s", LOG_PATH);
+        return ESP_FAIL;
+    }
+
+    fseek(log_file, 0, SEEK_END);
+    long file_records = ftell(log_file) / (long)sizeof(transaction_record_t);
+    if(file_records >= 0 && record_count > (uint32_t)file_records) {
+        ESP_LOGW(LOG_TAG, "Log is shorter than the committed count, truncating to %ld records", file_records);
+        record_count = file_records;
+    }
+
+    err = load_index(compacting);
+    // Close the slots of removed records a reset left behind
+    if(err == ESP_OK && (tombstones || compacting)) {
+        err = compact();
+        if(err == ESP_OK) err = save_state(0, NULL);
+    }
+    if(err != ESP_OK) {
+        ESP_LOGE(LOG_TAG, "Failed to load the log: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    committed_count = record_count;
+    ESP_LOGI(LOG_TAG, "%lu transactions on flash", (unsigned long)record_count);
+    return ESP_OK;
+}
+
+// -----------------------  Public API  -----------------------
+esp_err_t transaction_log_init(void) {
+    esp_err_t err = open_log();
+    if(err != ESP_OK) {
+        // Leave nothing half set up, the other calls see an empty log that refuses changes
+        if(log_file) fclose(log_file);
+        log_file = NULL;
+        free_index();
+        record_count = 0;
+        committed_count = 0;
+        tombstones = 0;
+    }
+    log_ready = err == ESP_OK;
+    return err;
+}
+
+uint32_t transaction_log_count(void) {
+    return log_ready ? record_count : 0;
+}
+
+uint32_t transaction_log_revision(void) {
+    return revision;
+}
+
+esp_err_t transaction_log_put(const transaction_record_t* record) {
+    if(!log_ready) return ESP_ERR_INVALID_STATE;
+    if(!is_valid_id(record->id)) return ESP_ERR_INVALID_ARG;
+    xSemaphoreTake(log_lock, portMAX_DELAY);
+    uint32_t hash = index_hash(record->id);
+    uint32_t index = find_record(record->id, hash, record_count);
+    esp_err_t err = ESP_OK;
+    if(index == UINT32_MAX) {
+        index = record_count;
+        err = reserve_index(record_count + 1);
+    }
+    if(err == ESP_OK) err = write_record(index, record);
+    if(err == ESP_OK) {
+        ID_INDEX(index) = hash;
+        if(index == record_count) record_count++;
+    }
+    xSemaphoreGive(log_lock);
+    return err;
+}
+
+esp_err_t transaction_log_remove(const char* id) {
+    if(!log_ready) return ESP_ERR_INVALID_STATE;
+    xSemaphoreTake(log_lock, portMAX_DELAY);
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+    uint32_t index = find_record(id, index_hash(id), record_count);
+    if(index != UINT32_MAX) {
+        // Leave a tombstone, the slot is filled by the next commit or rollback
+        err = write_record(index, &removed_record);
+        if(err == ESP_OK) {
+            ID_INDEX(index) = TOMBSTONE;
+            tombstones++;
+        }
+    }
+    xSemaphoreGive(log_lock);
+    return err;
+}
+
+size_t transaction_log_read(uint32_t first, transaction_record_t* out, size_t max) {
+    if(!log_ready) return 0;
+    xSemaphoreTake(log_lock, portMAX_DELAY);
+    size_t n = read_records(first, out, max);
+    xSemaphoreGive(log_lock);
+    return n;
+}
+
+esp_err_t transaction_log_commit(uint8_t institution, const char* cursor) {
+    if(!log_ready) return ESP_ERR_INVALID_STATE;
+    xSemaphoreTake(log_lock, portMAX_DELAY);
+    esp_err_t err = compact();
+    if(err == ESP_OK) err = save_state(institution, cursor);
+    if(err == ESP_OK) committed_count = record_count;
+    xSemaphoreGive(log_lock);
+
+    if(err != ESP_OK) ESP_LOGE(LOG_TAG, "Failed to commit: %s", esp_err_to_name(err));
+    return err;
+}
+
+void transaction_log_rollback(void) {
+    if(!log_ready) return;
+    xSemaphoreTake(log_lock, portMAX_DELAY);
+    if(record_count > committed_count) {
+        for(uint32_t i = committed_count; i < record_count; i++) tombstones -= ID_INDEX(i) == TOMBSTONE;
+        record_count = committed_count;
+        revision++;
+    }
+    // Replacements stay, replaying the page applies them again. So do removals, their slots are closed now
+    if(tombstones && compact() == ESP_OK) save_state(0, NULL);
+    committed_count = record_count;
+    xSemaphoreGive(log_lock);
+}
+
+esp_err_t transaction_log_get_cursor(uint8_t institution, char* cursor, size_t len) {
+    cursor[0] = '\0';
+    if(!log_ready) return ESP_ERR_INVALID_STATE;
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READONLY, &nvs);
+    if(err == ESP_ERR_NVS_NOT_FOUND) return ESP_OK; // Nothing synced yet
+    if(err != ESP_OK) return err;
+
+    char key[16];
+    snprintf(key, sizeof(key), "cursor%u", institution);
+    err = nvs_get_str(nvs, key, cursor, &len);
+    nvs_close(nvs);
+    if(err == ESP_ERR_NVS_NOT_FOUND) {
+        cursor[0] = '\0';
+        return ESP_OK;
+    }
+    return err;
+}
+
+// 32-bit FNV-1a
+uint32_t transaction_log_hash_id(const char* transaction_id) {
+    uint32_t hash = 2166136261u;
+    while(*transaction_id) {
+        hash ^= (uint8_t)*transaction_id++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Days from civil date, see http://howardhinnant.github.io/date_algorithms.html
+uint32_t transaction_log_date_to_day(const char* iso_date) {
+    int y = 1970, m = 1, d = 1;
+    if(sscanf(iso_date, "%d-%d-%d", &y, &m, &d) != 3) return 0;
+
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    unsigned yoe = (unsigned)(y - era * 400);
+    unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    long days = (long)era * 146097 + (long)doe - 719468;
+    return days > 0 ? (uint32_t)days : 0;
+}
+
+void transaction_log_day_to_date(uint32_t day, int* year, int* month, int* mday) {
+    long z = (long)day + 719468;
+    long era = z / 146097;
+    unsigned doe = (unsigned)(z - era * 146097);
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    unsigned mp = (5 * doy + 2) / 153;
+    unsigned d = doy - (153 * mp + 2) / 5 + 1;
+    unsigned m = mp < 10 ? mp + 3 : mp - 9;
+    *year = (int)(yoe + era * 400 + (m <= 2));
+    *month = (int)m;
+    *mday = (int)d;
+}
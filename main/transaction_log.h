@@ -0,0 +1,101 @@
+#ifndef ESP32C6_FINANCE_HUB_TRANSACTION_LOG_H
+#define ESP32C6_FINANCE_HUB_TRANSACTION_LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+#define TRANSACTION_NAME_LEN 35
+// Longest Plaid transaction_id we keep, including the terminator. Plaid's ids are 37 characters
+#define TRANSACTION_ID_LEN 48
+// Longest Plaid cursor we keep. Plaid documents them as < 256 characters
+#define TRANSACTION_CURSOR_LEN 320
+
+/**
+ * One transaction as stored on flash. Fixed size so record N lives at N * sizeof(transaction_record_t)
+*/
+typedef struct {
+    char id[TRANSACTION_ID_LEN];        // Plaid's transaction_id. "" for a record removed since the last commit
+    uint32_t day;                       // Days since 1970-01-01
+    int32_t amount_cents;               // Positive = money leaving the account (Plaid convention)
+    uint8_t institution;                // Index of the institution the transaction came from
+    char name[TRANSACTION_NAME_LEN];    // Merchant or description, truncated
+} transaction_record_t;
+
+/**
+ * @brief Mount the storage partition and open the log. Call after nvs_flash_init
+ * @return ESP_OK or the error of the failing step. Until it succeeded the log reads as empty,
+ * and the calls that change it or read a cursor return ESP_ERR_INVALID_STATE
+*/
+esp_err_t transaction_log_init(void);
+
+/**
+ * @brief Number of records in the log
+*/
+uint32_t transaction_log_count(void);
+
+/**
+ * @brief Incremented on every change, lets readers know when cached records are stale
+*/
+uint32_t transaction_log_revision(void);
+
+/**
+ * @brief Replace the record with the same id, or append it if it is not in the log yet.
+ * Used for both "added" and "modified", so a replayed sync page never duplicates a transaction
+*/
+esp_err_t transaction_log_put(const transaction_record_t* record);
+
+/**
+ * @brief Remove a transaction. Its slot reads as an empty record until the next commit or rollback fills it
+ * with the last record, so committed records are never moved by a page that may still be rolled back
+ * @param id Plaid's transaction_id
+ * @return ESP_OK, or ESP_ERR_NOT_FOUND if the transaction is not in the log
+*/
+esp_err_t transaction_log_remove(const char* id);
+
+/**
+ * @brief Read consecutive records. A record removed since the last commit has an empty id
+ * @param first Index of the first record
+ * @param out Where to store the records
+ * @param max Size of `out` in records
+ * @return Number of records read
+*/
+size_t transaction_log_read(uint32_t first, transaction_record_t* out, size_t max);
+
+/**
+ * @brief Make everything written so far durable and save the sync cursor of an institution with it
+ * @param institution Index of the institution
+ * @param cursor Cursor returned by /transactions/sync for the last applied page
+*/
+esp_err_t transaction_log_commit(uint8_t institution, const char* cursor);
+
+/**
+ * @brief Drop records appended since the last commit, e.g. after a sync page failed halfway.
+ * Replacements and removals of committed records stay, replaying the page applies them again
+*/
+void transaction_log_rollback(void);
+
+/**
+ * @brief Get the saved sync cursor of an institution
+ * @param institution Index of the institution
+ * @param cursor Buffer for the cursor. Set to "" if there is none yet
+ * @param len Size of `cursor`
+*/
+esp_err_t transaction_log_get_cursor(uint8_t institution, char* cursor, size_t len);
+
+/**
+ * @brief Hash a Plaid transaction_id. Only used to find candidates quickly, records keep the full id
+*/
+uint32_t transaction_log_hash_id(const char* transaction_id);
+
+/**
+ * @brief Convert a "YYYY-MM-DD" date to days since 1970-01-01
+*/
+uint32_t transaction_log_date_to_day(const char* iso_date);
+
+/**
+ * @brief Convert days since 1970-01-01 back to a calendar date
+*/
+void transaction_log_day_to_date(uint32_t day, int* year, int* month, int* mday);
+
+#endif //ESP32C6_FINANCE_HUB_TRANSACTION_LOG_H
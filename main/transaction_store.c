@@ -0,0 +1,881 @@
+#include "transaction_store.h"
+#include "transaction_log.h"
+#include <stdio.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+/*
+ * Flash layout (4 KB sectors)
+ *
+ *  sector 0-1   Summary area. Append-only blocks, one per month and commit, plus commit markers and the erase
+ *               counts of the segments (written before a segment is erased, as the erase takes its header with it).
+ *               When the active sector is full the other one is erased and the current summaries are compacted into it.
+ *  sector 2..   Segments. Each holds up to SEGMENT_RECORDS transactions stored column by column:
+ *
+ *      header | id hashes | day deltas | amounts | merchant idx | category | institution | flags | merchant dictionary
+ *
+ *               Days are stored as a 16-bit delta to the segment's base day, amounts as int32 cents, merchants as an
+ *               index into the segment's own dictionary. Slots are filled in order and never rewritten, a record
+ *               counts once its written flag is cleared and deletes only clear further flag bits. A full store recycles the segment with the oldest data, picking erased segments with
+ *               the fewest erases first, so wear is spread over the whole partition. The records of a recycled
+ *               segment are removed from the summaries first, so a summary always counts what the segments hold.
+ */
+#define STORE_PARTITION_LABEL "txn_store"
+#define SECTOR_SIZE 4096
+#define SUMMARY_SECTORS 2
+#define MAX_SEGMENTS 64            // RAM index limit, 256 KB of segments
+#define SEGMENT_RECORDS 128
+#define SEGMENT_MAGIC 0x32535854   // "TXS2"
+
+#define OFF_IDS          32
+#define OFF_DAYS         (OFF_IDS + SEGMENT_RECORDS * 4)
+#define OFF_AMOUNTS      (OFF_DAYS + SEGMENT_RECORDS * 2)
+#define OFF_MERCHANTS    (OFF_AMOUNTS + SEGMENT_RECORDS * 4)
+#define OFF_CATEGORIES   (OFF_MERCHANTS + SEGMENT_RECORDS)
+#define OFF_INSTITUTIONS (OFF_CATEGORIES + SEGMENT_RECORDS)
+#define OFF_FLAGS        (OFF_INSTITUTIONS + SEGMENT_RECORDS)
+#define OFF_DICT         (OFF_FLAGS + SEGMENT_RECORDS)
+#define DICT_SIZE        (SECTOR_SIZE - OFF_DICT)
+
+#define DAY_EMPTY 0xFFFF           // Erased day slot = unused record slot
+#define DAY_BIAS 0x8000
+#define MERCHANT_NONE 0xFF
+#define DICT_END 0xFF              // Erased length byte ends the dictionary
+
+// Flag bits start at 1 (erased) and are cleared one by one, which flash allows without an erase
+#define FLAG_SUMMARIZED        0x01 // Cleared: the record is counted in a committed summary
+#define FLAG_WRITTEN           0x02 // Cleared: every column of the record is on flash. One byte, a reset can't tear it
+#define FLAG_DELETE_SUMMARIZED 0x40 // Cleared: the delete is reflected in a committed summary
+#define FLAG_DELETED           0x80 // Cleared: the record was removed
+#define IS_CLEARED(flags, bit) (((flags) & (bit)) == 0)
+
+#define SUMMARY_MAGIC 0x5356
+#define MONTH_MARKER 0xFFFE        // Block is a commit marker, not a month
+#define WEAR_MARKER 0xFFFD         // Block holds erase counts, `count` is the group and `totals` the counts
+#define WEAR_GROUP TRANSACTION_CATEGORY_COUNT
+#define WEAR_GROUPS ((MAX_SEGMENTS + WEAR_GROUP - 1) / WEAR_GROUP)
+#define PHASE_SUMMARIES 1          // Every month block of the commit is on flash
+#define PHASE_FLAGS 2              // Every record flag of the commit is on flash
+
+typedef struct {
+    uint32_t seq;                  // Increases with every segment opened, the highest is the active one
+    uint32_t erase_count;
+    uint32_t base_day;
+    uint32_t magic;                // Written last
+} segment_header_t;
+
+typedef struct {
+    uint16_t magic;
+    uint16_t month;                // Months since 1970-01, or MONTH_MARKER
+    uint32_t commit;
+    uint32_t count;                // Transactions in the month, or the phase of a marker
+    int32_t totals[TRANSACTION_CATEGORY_COUNT];
+    uint32_t check;
+} summary_block_t;
+
+#define BLOCKS_PER_SECTOR (SECTOR_SIZE / sizeof(summary_block_t))
+
+_Static_assert(sizeof(segment_header_t) <= OFF_IDS, "Segment header overlaps the id column");
+_Static_assert(DICT_SIZE >= 1024, "Segment dictionary too small");
+_Static_assert(TRANSACTION_STORE_SUMMARY_MONTHS + WEAR_GROUPS + 2 <= BLOCKS_PER_SECTOR,
+               "A compacted summary sector must fit every month and erase count");
+
+typedef struct {
+    uint32_t seq;                  // 0 = segment not in use
+    uint32_t erase_count;
+    uint32_t base_day;
+    uint32_t min_day;
+    uint32_t max_day;
+    uint16_t used;                 // Slots written
+    uint16_t live;                 // Slots written and not deleted
+    bool sealed;                   // Nothing more can be appended
+    bool flags_dirty;              // Has flags that the next commit must settle
+} segment_info_t;
+
+typedef struct {
+    bool used;
+    bool dirty;                    // Changed since the last commit
+    uint16_t month;
+    uint32_t commit;               // Commit of the block it was loaded from
+    transaction_month_summary_t summary;
+} month_entry_t;
+
+static const char *STORE_TAG = "Transaction Store";
+
+static const char* category_names[TRANSACTION_CATEGORY_COUNT] = {
+        "OTHER", "INCOME", "TRANSFER_IN", "TRANSFER_OUT", "LOAN_PAYMENTS", "BANK_FEES", "ENTERTAINMENT",
+        "FOOD_AND_DRINK", "GENERAL_MERCHANDISE", "HOME_IMPROVEMENT", "MEDICAL", "PERSONAL_CARE", "GENERAL_SERVICES",
+        "GOVERNMENT_AND_NON_PROFIT", "TRANSPORTATION", "TRAVEL", "RENT_AND_UTILITIES"
+};
+
+static transaction_store_flash_t store_flash;
+static SemaphoreHandle_t store_lock = NULL;
+static bool store_ready = false;
+
+static segment_info_t segments[MAX_SEGMENTS];
+static uint16_t segment_count = 0;
+static int active_segment = -1;
+static uint32_t next_seq = 1;
+static uint8_t active_dict[DICT_SIZE];         // Copy of the active segment's dictionary
+static uint16_t active_dict_len = 0;
+static uint16_t active_dict_entries = 0;
+
+static month_entry_t months[TRANSACTION_STORE_SUMMARY_MONTHS];
+static uint8_t summary_sector = 0;
+static size_t summary_offset = 0;              // Next free byte in the active summary sector
+static uint32_t last_commit = 0;               // Highest commit id seen anywhere, used or not
+static uint32_t wear_counts[MAX_SEGMENTS];     // Erase counts found in the summary area
+static bool wear_dirty[WEAR_GROUPS];           // Erase counts the next commit must write
+
+// Column scratch, only touched with store_lock held
+static uint32_t col_ids[SEGMENT_RECORDS];
+static uint16_t col_days[SEGMENT_RECORDS];
+static int32_t col_amounts[SEGMENT_RECORDS];
+static uint8_t col_merchants[SEGMENT_RECORDS];
+static uint8_t col_categories[SEGMENT_RECORDS];
+static uint8_t col_institutions[SEGMENT_RECORDS];
+static uint8_t col_flags[SEGMENT_RECORDS];
+static uint8_t dict_scratch[DICT_SIZE];
+static uint16_t dict_offsets[MERCHANT_NONE];
+
+// -----------------------  Flash  -----------------------
+static esp_err_t partition_read(void* ctx, size_t offset, void* dst, size_t len) {
+    return esp_partition_read(ctx, offset, dst, len);
+}
+
+static esp_err_t partition_write(void* ctx, size_t offset, const void* src, size_t len) {
+    return esp_partition_write(ctx, offset, src, len);
+}
+
+static esp_err_t partition_erase(void* ctx, size_t offset) {
+    return esp_partition_erase_range(ctx, offset, SECTOR_SIZE);
+}
+
+static size_t segment_offset(int segment) {
+    return (size_t)(SUMMARY_SECTORS + segment) * SECTOR_SIZE;
+}
+
+static esp_err_t segment_read(int segment, size_t offset, void* dst, size_t len) {
+    return store_flash.read(store_flash.ctx, segment_offset(segment) + offset, dst, len);
+}
+
+static esp_err_t segment_write(int segment, size_t offset, const void* src, size_t len) {
+    return store_flash.write(store_flash.ctx, segment_offset(segment) + offset, src, len);
+}
+
+static bool is_erased(const void* data, size_t len) {
+    const uint8_t* bytes = data;
+    for(size_t i = 0; i < len; i++) {
+        if(bytes[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+// -----------------------  Month summaries  -----------------------
+static uint16_t month_of_day(uint32_t day) {
+    int year, month, mday;
+    transaction_log_day_to_date(day, &year, &month, &mday);
+    return (uint16_t)((year - 1970) * 12 + (month - 1));
+}
+
+static month_entry_t* find_month(uint16_t month, bool create) {
+    month_entry_t* free_entry = NULL;
+    month_entry_t* oldest = NULL;
+    for(int i = 0; i < TRANSACTION_STORE_SUMMARY_MONTHS; i++) {
+        if(!months[i].used) {
+            if(!free_entry) free_entry = &months[i];
+        } else if(months[i].month == month) {
+            return &months[i];
+        } else if(!oldest || months[i].month < oldest->month) {
+            oldest = &months[i];
+        }
+    }
+    if(!create) return NULL;
+
+    month_entry_t* entry = free_entry;
+    if(!entry) {
+        // Full, make room by dropping the oldest month unless this one is even older
+        if(!oldest || month < oldest->month) return NULL;
+        if(oldest->dirty) ESP_LOGW(STORE_TAG, "Dropping uncommitted summary of month %u", oldest->month);
+        entry = oldest;
+    }
+    memset(entry, 0, sizeof(*entry));
+    entry->used = true;
+    entry->month = month;
+    return entry;
+}
+
+static void summary_apply(uint32_t day, uint8_t category, int32_t amount_cents, int sign) {
+    month_entry_t* entry = find_month(month_of_day(day), true);
+    if(!entry) return; // Older than every month we keep
+    if(category >= TRANSACTION_CATEGORY_COUNT) category = TRANSACTION_CATEGORY_OTHER;
+    entry->summary.totals_cents[category] += sign * amount_cents;
+    entry->summary.count += sign;
+    entry->dirty = true;
+}
+
+// 32-bit FNV-1a over everything before `check`
+static uint32_t block_check(const summary_block_t* block) {
+    const uint8_t* bytes = (const uint8_t*)block;
+    uint32_t hash = 2166136261u;
+    for(size_t i = 0; i < offsetof(summary_block_t, check); i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static esp_err_t append_block(uint16_t month, uint32_t commit, uint32_t count, const int32_t* totals) {
+    summary_block_t block;
+    memset(&block, 0, sizeof(block));
+    block.magic = SUMMARY_MAGIC;
+    block.month = month;
+    block.commit = commit;
+    block.count = count;
+    if(totals) memcpy(block.totals, totals, sizeof(block.totals));
+    block.check = block_check(&block);
+
+    esp_err_t err = store_flash.write(store_flash.ctx, summary_sector * SECTOR_SIZE + summary_offset, &block,
+                                      sizeof(block));
+    summary_offset += sizeof(block); // Skipped even on failure, the slot is no longer blank
+    return err;
+}
+
+static esp_err_t append_wear(int group, uint32_t commit) {
+    int32_t counts[WEAR_GROUP] = {0};
+    for(int i = 0; i < WEAR_GROUP && group * WEAR_GROUP + i < segment_count; i++) {
+        counts[i] = (int32_t)segments[group * WEAR_GROUP + i].erase_count;
+    }
+    esp_err_t err = append_block(WEAR_MARKER, commit, group, counts);
+    if(err == ESP_OK) wear_dirty[group] = false;
+    return err;
+}
+
+// Erase the other summary sector and write every month into it. The active sector stays intact until the
+// new one holds a commit marker, so a reset in between falls back to it
+static esp_err_t compact_summaries(uint32_t commit) {
+    uint8_t target = summary_sector ^ 1;
+    esp_err_t err = store_flash.erase_sector(store_flash.ctx, target * SECTOR_SIZE);
+    if(err != ESP_OK) return err;
+
+    summary_sector = target;
+    summary_offset = 0;
+    for(int i = 0; i < TRANSACTION_STORE_SUMMARY_MONTHS && err == ESP_OK; i++) {
+        if(!months[i].used) continue;
+        err = append_block(months[i].month, commit, months[i].summary.count, months[i].summary.totals_cents);
+        if(err != ESP_OK) break;
+        months[i].commit = commit;
+        months[i].dirty = false;
+    }
+    for(int group = 0; group * WEAR_GROUP < segment_count && err == ESP_OK; group++) err = append_wear(group, commit);
+    return err;
+}
+
+static esp_err_t load_summaries(bool* pending_counted) {
+    summary_block_t block;
+    size_t sector_end[SUMMARY_SECTORS] = {0};
+    uint32_t marked_commit = 0;     // Newest commit whose summaries are complete
+    uint32_t flags_commit = 0;      // Newest commit whose flags are complete
+    uint8_t marked_sector = 0;
+
+    for(uint8_t s = 0; s < SUMMARY_SECTORS; s++) {
+        for(size_t b = 0; b < BLOCKS_PER_SECTOR; b++) {
+            size_t offset = b * sizeof(block);
+            esp_err_t err = store_flash.read(store_flash.ctx, s * SECTOR_SIZE + offset, &block, sizeof(block));
+            if(err != ESP_OK) return err;
+            if(is_erased(&block, sizeof(block))) continue;
+            sector_end[s] = offset + sizeof(block);
+            if(block.magic != SUMMARY_MAGIC || block.check != block_check(&block)) continue;
+
+            if(block.commit > last_commit) last_commit = block.commit;
+            if(block.month == WEAR_MARKER) {
+                // Written before the erase, whether or not the commit finished
+                for(size_t i = 0; i < WEAR_GROUP && block.count * WEAR_GROUP + i < MAX_SEGMENTS; i++) {
+                    uint32_t count = (uint32_t)block.totals[i];
+                    if(count > wear_counts[block.count * WEAR_GROUP + i]) wear_counts[block.count * WEAR_GROUP + i] = count;
+                }
+                continue;
+            }
+            if(block.month != MONTH_MARKER) continue;
+            if(block.count == PHASE_SUMMARIES && block.commit > marked_commit) {
+                marked_commit = block.commit;
+                marked_sector = s;
+            } else if(block.count == PHASE_FLAGS && block.commit > flags_commit) {
+                flags_commit = block.commit;
+            }
+        }
+    }
+
+    // Month blocks of a commit without a marker are ignored, the previous version of the month still counts
+    for(uint8_t s = 0; s < SUMMARY_SECTORS; s++) {
+        for(size_t b = 0; b < sector_end[s] / sizeof(block); b++) {
+            esp_err_t err = store_flash.read(store_flash.ctx, s * SECTOR_SIZE + b * sizeof(block), &block,
+                                             sizeof(block));
+            if(err != ESP_OK) return err;
+            if(block.magic != SUMMARY_MAGIC || block.check != block_check(&block)) continue;
+            if(block.month == MONTH_MARKER || block.month == WEAR_MARKER || block.commit > marked_commit) continue;
+
+            month_entry_t* entry = find_month(block.month, false);
+            if(entry && entry->commit >= block.commit) continue;
+            if(!entry) entry = find_month(block.month, true);
+            if(!entry) continue;
+            entry->commit = block.commit;
+            entry->summary.count = block.count;
+            memcpy(entry->summary.totals_cents, block.totals, sizeof(block.totals));
+        }
+    }
+
+    summary_sector = marked_sector;
+    summary_offset = sector_end[marked_sector];
+    // A reset between the two markers means the summaries already count the records whose flags are unsettled
+    *pending_counted = marked_commit != 0 && flags_commit < marked_commit;
+    return ESP_OK;
+}
+
+// -----------------------  Segments  -----------------------
+// Find records whose flags do not match the committed summaries yet. With `count`, they are also
+// added to/removed from the summaries in RAM. Nothing is written, the next commit settles the flags
+static esp_err_t check_segment(int segment, bool count) {
+    segment_info_t* info = &segments[segment];
+    if(info->used == 0) return ESP_OK;
+
+    esp_err_t err = segment_read(segment, OFF_FLAGS, col_flags, info->used);
+    if(err == ESP_OK && count) {
+        err = segment_read(segment, OFF_DAYS, col_days, info->used * sizeof(uint16_t));
+        if(err == ESP_OK) err = segment_read(segment, OFF_AMOUNTS, col_amounts, info->used * sizeof(int32_t));
+        if(err == ESP_OK) err = segment_read(segment, OFF_CATEGORIES, col_categories, info->used);
+    }
+    if(err != ESP_OK) return err;
+
+    for(uint16_t i = 0; i < info->used; i++) {
+        uint8_t flags = col_flags[i];
+        bool deleted = IS_CLEARED(flags, FLAG_DELETED);
+        bool counted = IS_CLEARED(flags, FLAG_SUMMARIZED) && !IS_CLEARED(flags, FLAG_DELETE_SUMMARIZED);
+        bool settled = IS_CLEARED(flags, FLAG_SUMMARIZED) && (!deleted || IS_CLEARED(flags, FLAG_DELETE_SUMMARIZED));
+        if(settled) continue;
+
+        info->flags_dirty = true;
+        if(count && deleted == counted) {
+            uint32_t day = info->base_day + col_days[i] - DAY_BIAS;
+            summary_apply(day, col_categories[i], col_amounts[i], deleted ? -1 : 1);
+        }
+    }
+    return ESP_OK;
+}
+
+// Mark every record of a segment as reflected in the committed summaries
+static esp_err_t settle_segment(int segment) {
+    segment_info_t* info = &segments[segment];
+    if(info->used == 0) return ESP_OK;
+
+    esp_err_t err = segment_read(segment, OFF_FLAGS, col_flags, info->used);
+    if(err != ESP_OK) return err;
+
+    bool changed = false;
+    for(uint16_t i = 0; i < info->used; i++) {
+        uint8_t flags = col_flags[i] & ~FLAG_SUMMARIZED;
+        if(IS_CLEARED(flags, FLAG_DELETED)) flags &= ~FLAG_DELETE_SUMMARIZED;
+        if(flags != col_flags[i]) {
+            col_flags[i] = flags;
+            changed = true;
+        }
+    }
+    if(changed) err = segment_write(segment, OFF_FLAGS, col_flags, info->used);
+    return err;
+}
+
+static esp_err_t commit_locked(void) {
+    int dirty_months = 0;
+    int dirty_wear = 0;
+    bool dirty_flags = false;
+    for(int i = 0; i < TRANSACTION_STORE_SUMMARY_MONTHS; i++) dirty_months += months[i].used && months[i].dirty;
+    for(int i = 0; i < WEAR_GROUPS; i++) dirty_wear += wear_dirty[i];
+    for(int i = 0; i < segment_count; i++) dirty_flags |= segments[i].flags_dirty;
+    if(dirty_months == 0 && dirty_wear == 0 && !dirty_flags) return ESP_OK;
+
+    uint32_t commit = ++last_commit;
+    esp_err_t err = ESP_OK;
+    if(summary_offset + (dirty_months + dirty_wear + 2) * sizeof(summary_block_t) > SECTOR_SIZE) {
+        err = compact_summaries(commit);
+    } else {
+        for(int group = 0; group < WEAR_GROUPS && err == ESP_OK; group++) {
+            if(wear_dirty[group]) err = append_wear(group, commit);
+        }
+        for(int i = 0; i < TRANSACTION_STORE_SUMMARY_MONTHS && err == ESP_OK; i++) {
+            if(!months[i].used || !months[i].dirty) continue;
+            err = append_block(months[i].month, commit, months[i].summary.count, months[i].summary.totals_cents);
+            if(err != ESP_OK) break;
+            months[i].commit = commit;
+            months[i].dirty = false;
+        }
+    }
+    if(err == ESP_OK) err = append_block(MONTH_MARKER, commit, PHASE_SUMMARIES, NULL);
+
+    for(int i = 0; i < segment_count && err == ESP_OK; i++) {
+        if(!segments[i].flags_dirty) continue;
+        err = settle_segment(i);
+        if(err == ESP_OK) segments[i].flags_dirty = false;
+    }
+    if(err == ESP_OK) err = append_block(MONTH_MARKER, commit, PHASE_FLAGS, NULL);
+
+    if(err != ESP_OK) ESP_LOGE(STORE_TAG, "Commit %lu failed: %s", (unsigned long)commit, esp_err_to_name(err));
+    return err;
+}
+
+static void load_dictionary(int segment) {
+    active_dict_len = 0;
+    active_dict_entries = 0;
+    if(segment_read(segment, OFF_DICT, active_dict, DICT_SIZE) != ESP_OK) {
+        memset(active_dict, 0xFF, sizeof(active_dict));
+        segments[segment].sealed = true;
+        return;
+    }
+    while(active_dict_len < DICT_SIZE && active_dict[active_dict_len] != DICT_END) {
+        active_dict_len += 1 + active_dict[active_dict_len];
+        active_dict_entries++;
+    }
+    if(active_dict_len > DICT_SIZE) { // Last entry was cut short
+        active_dict_len = DICT_SIZE;
+        segments[segment].sealed = true;
+    }
+}
+
+static esp_err_t scan_segment(int segment) {
+    segment_info_t* info = &segments[segment];
+    segment_header_t header;
+    memset(info, 0, sizeof(*info));
+    info->erase_count = wear_counts[segment];
+
+    esp_err_t err = segment_read(segment, 0, &header, sizeof(header));
+    if(err != ESP_OK) return err;
+    if(header.magic != SEGMENT_MAGIC) return ESP_OK; // Not in use
+
+    info->seq = header.seq;
+    if(header.erase_count > info->erase_count) info->erase_count = header.erase_count;
+    info->base_day = header.base_day;
+    info->min_day = UINT32_MAX;
+    err = segment_read(segment, OFF_DAYS, col_days, sizeof(col_days));
+    if(err == ESP_OK) err = segment_read(segment, OFF_FLAGS, col_flags, sizeof(col_flags));
+    if(err != ESP_OK) return err;
+
+    while(info->used < SEGMENT_RECORDS && col_days[info->used] != DAY_EMPTY &&
+          IS_CLEARED(col_flags[info->used], FLAG_WRITTEN)) {
+        uint32_t day = info->base_day + col_days[info->used] - DAY_BIAS;
+        if(day < info->min_day) info->min_day = day;
+        if(day > info->max_day) info->max_day = day;
+        if(!IS_CLEARED(col_flags[info->used], FLAG_DELETED)) info->live++;
+        info->used++;
+    }
+
+    // The written flag comes last, anything else in the slot is a record cut short by a reset. Its slot cannot be reused
+    if(info->used < SEGMENT_RECORDS) {
+        uint32_t id;
+        err = segment_read(segment, OFF_IDS + info->used * sizeof(uint32_t), &id, sizeof(id));
+        if(err != ESP_OK || id != UINT32_MAX || col_days[info->used] != DAY_EMPTY || col_flags[info->used] != 0xFF) {
+            info->sealed = true;
+        }
+    } else {
+        info->sealed = true;
+    }
+    return err;
+}
+
+// Remove every live record of a segment that is about to be recycled, like transaction_store_remove would
+static esp_err_t drop_segment(int segment) {
+    segment_info_t* info = &segments[segment];
+    if(info->live == 0) return ESP_OK;
+
+    esp_err_t err = segment_read(segment, OFF_FLAGS, col_flags, info->used);
+    if(err == ESP_OK) err = segment_read(segment, OFF_DAYS, col_days, info->used * sizeof(uint16_t));
+    if(err == ESP_OK) err = segment_read(segment, OFF_AMOUNTS, col_amounts, info->used * sizeof(int32_t));
+    if(err == ESP_OK) err = segment_read(segment, OFF_CATEGORIES, col_categories, info->used);
+    if(err != ESP_OK) return err;
+
+    for(uint16_t i = 0; i < info->used; i++) {
+        if(IS_CLEARED(col_flags[i], FLAG_DELETED)) continue;
+        col_flags[i] &= ~FLAG_DELETED;
+        summary_apply(info->base_day + col_days[i] - DAY_BIAS, col_categories[i], col_amounts[i], -1);
+    }
+    err = segment_write(segment, OFF_FLAGS, col_flags, info->used);
+    if(err != ESP_OK) return err;
+    info->live = 0;
+    info->flags_dirty = true;
+    return ESP_OK;
+}
+
+// Start a new segment for records around `day`. Prefers erased segments with the fewest erases,
+// otherwise recycles the one with the oldest data
+static esp_err_t open_segment(uint32_t day) {
+    int target = -1;
+    for(int i = 0; i < segment_count; i++) {
+        if(i == active_segment && segment_count > 1) continue;
+        if(target < 0) { target = i; continue; }
+        const segment_info_t* a = &segments[i];
+        const segment_info_t* b = &segments[target];
+        if(a->seq == 0 && (b->seq != 0 || a->erase_count < b->erase_count)) target = i;
+        else if(a->seq != 0 && b->seq != 0 && a->seq < b->seq) target = i;
+    }
+    if(target < 0) return ESP_ERR_NO_MEM;
+
+    if(segments[target].seq != 0) {
+        // Its records are about to disappear, the commit below takes them out of the summaries
+        ESP_LOGI(STORE_TAG, "Recycling segment %d (%u transactions)", target, segments[target].live);
+        esp_err_t err = drop_segment(target);
+        if(err != ESP_OK) return err;
+    }
+
+    // The erase takes the header and its erase count with it, so the count goes to the summary area first
+    segments[target].erase_count++;
+    wear_dirty[target / WEAR_GROUP] = true;
+    esp_err_t err = commit_locked();
+    if(err != ESP_OK) {
+        segments[target].erase_count--;
+        return err;
+    }
+
+    segment_header_t header = {
+            .seq = next_seq++,
+            .erase_count = segments[target].erase_count,
+            .base_day = day,
+            .magic = SEGMENT_MAGIC
+    };
+    err = store_flash.erase_sector(store_flash.ctx, segment_offset(target));
+    if(err == ESP_OK) err = segment_write(target, 0, &header, sizeof(header));
+
+    segment_info_t* info = &segments[target];
+    memset(info, 0, sizeof(*info));
+    info->erase_count = header.erase_count;
+    if(err != ESP_OK) return err;
+
+    info->seq = header.seq;
+    info->base_day = day;
+    info->min_day = UINT32_MAX;
+    active_segment = target;
+    memset(active_dict, 0xFF, sizeof(active_dict));
+    active_dict_len = 0;
+    active_dict_entries = 0;
+    return ESP_OK;
+}
+
+// Index of a merchant in the active dictionary, appending it if needed. -1 when the dictionary is full
+static int dictionary_index(const char* merchant) {
+    if(!merchant || !merchant[0]) return MERCHANT_NONE;
+    size_t len = strlen(merchant);
+    if(len > TRANSACTION_STORE_MERCHANT_MAX) {
+        len = TRANSACTION_STORE_MERCHANT_MAX;
+        while(len > 0 && ((unsigned char)merchant[len] & 0xC0) == 0x80) len--; // Keep UTF-8 characters whole
+    }
+
+    uint16_t pos = 0;
+    for(int index = 0; index < active_dict_entries; index++) {
+        uint8_t entry_len = active_dict[pos];
+        if(entry_len == len && memcmp(&active_dict[pos + 1], merchant, len) == 0) return index;
+        pos += 1 + entry_len;
+    }
+
+    if(active_dict_entries >= MERCHANT_NONE || active_dict_len + 1 + len > DICT_SIZE) return -1;
+    uint8_t* entry = &active_dict[active_dict_len];
+    entry[0] = (uint8_t)len;
+    memcpy(entry + 1, merchant, len);
+    if(segment_write(active_segment, OFF_DICT + active_dict_len, entry, 1 + len) != ESP_OK) return -1;
+    active_dict_len += 1 + len;
+    return active_dict_entries++;
+}
+
+static bool fits_active(uint32_t day) {
+    if(active_segment < 0) return false;
+    const segment_info_t* info = &segments[active_segment];
+    int64_t delta = (int64_t)day - info->base_day + DAY_BIAS;
+    return !info->sealed && info->used < SEGMENT_RECORDS && delta >= 0 && delta < DAY_EMPTY;
+}
+
+static esp_err_t append_record(const transaction_store_entry_t* entry) {
+    int merchant = -1;
+    for(int attempt = 0; attempt < 2 && merchant < 0; attempt++) {
+        if(!fits_active(entry->day)) {
+            esp_err_t err = open_segment(entry->day);
+            if(err != ESP_OK) return err;
+        }
+        merchant = dictionary_index(entry->merchant);
+        if(merchant < 0) segments[active_segment].sealed = true; // Dictionary full, the rest goes to a new segment
+    }
+    if(merchant < 0) merchant = MERCHANT_NONE;
+
+    segment_info_t* info = &segments[active_segment];
+    uint16_t slot = info->used;
+    uint8_t merchant_byte = merchant;
+    uint8_t category = entry->category < TRANSACTION_CATEGORY_COUNT ? entry->category : TRANSACTION_CATEGORY_OTHER;
+    uint16_t day = (uint16_t)(entry->day - info->base_day + DAY_BIAS);
+    uint8_t flags = (uint8_t)~FLAG_WRITTEN;
+
+    // The written flag last, it is what makes the slot count as a record
+    esp_err_t err = segment_write(active_segment, OFF_IDS + slot * sizeof(uint32_t), &entry->id_hash, sizeof(uint32_t));
+    if(err == ESP_OK) err = segment_write(active_segment, OFF_AMOUNTS + slot * sizeof(int32_t), &entry->amount_cents, sizeof(int32_t));
+    if(err == ESP_OK) err = segment_write(active_segment, OFF_MERCHANTS + slot, &merchant_byte, 1);
+    if(err == ESP_OK) err = segment_write(active_segment, OFF_CATEGORIES + slot, &category, 1);
+    if(err == ESP_OK) err = segment_write(active_segment, OFF_INSTITUTIONS + slot, &entry->institution, 1);
+    if(err == ESP_OK) err = segment_write(active_segment, OFF_DAYS + slot * sizeof(uint16_t), &day, sizeof(day));
+    if(err == ESP_OK) err = segment_write(active_segment, OFF_FLAGS + slot, &flags, 1);
+    if(err != ESP_OK) {
+        info->sealed = true; // The slot may be half written
+        return err;
+    }
+
+    info->used++;
+    info->live++;
+    info->flags_dirty = true;
+    if(entry->day < info->min_day) info->min_day = entry->day;
+    if(entry->day > info->max_day) info->max_day = entry->day;
+    summary_apply(entry->day, category, entry->amount_cents, 1);
+    return ESP_OK;
+}
+
+// Find the live record with an id. `day` limits the search to segments covering it, pass UINT32_MAX to search all
+static bool find_record(uint32_t id_hash, uint32_t day, int* segment, uint16_t* slot) {
+    for(int s = 0; s < segment_count; s++) {
+        const segment_info_t* info = &segments[s];
+        if(info->seq == 0 || info->live == 0) continue;
+        if(day != UINT32_MAX && (day < info->min_day || day > info->max_day)) continue;
+        if(segment_read(s, OFF_IDS, col_ids, info->used * sizeof(uint32_t)) != ESP_OK) continue;
+
+        for(uint16_t i = 0; i < info->used; i++) {
+            if(col_ids[i] != id_hash) continue;
+            uint8_t flags;
+            if(segment_read(s, OFF_FLAGS + i, &flags, 1) != ESP_OK || IS_CLEARED(flags, FLAG_DELETED)) continue;
+            *segment = s;
+            *slot = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static esp_err_t delete_record(int segment, uint16_t slot) {
+    uint8_t flags, category;
+    uint16_t day;
+    int32_t amount;
+    esp_err_t err = segment_read(segment, OFF_FLAGS + slot, &flags, 1);
+    if(err == ESP_OK) err = segment_read(segment, OFF_DAYS + slot * sizeof(uint16_t), &day, sizeof(day));
+    if(err == ESP_OK) err = segment_read(segment, OFF_AMOUNTS + slot * sizeof(int32_t), &amount, sizeof(amount));
+    if(err == ESP_OK) err = segment_read(segment, OFF_CATEGORIES + slot, &category, 1);
+    if(err != ESP_OK) return err;
+
+    flags &= ~FLAG_DELETED;
+    err = segment_write(segment, OFF_FLAGS + slot, &flags, 1);
+    if(err != ESP_OK) return err;
+
+    segment_info_t* info = &segments[segment];
+    info->live--;
+    info->flags_dirty = true;
+    summary_apply(info->base_day + day - DAY_BIAS, category, amount, -1);
+    return ESP_OK;
+}
+
+// -----------------------  Public API  -----------------------
+esp_err_t transaction_store_init(const transaction_store_flash_t* flash) {
+    if(flash) {
+        store_flash = *flash;
+    } else {
+        const esp_partition_t* partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                                    ESP_PARTITION_SUBTYPE_ANY, STORE_PARTITION_LABEL);
+        if(!partition) {
+            ESP_LOGE(STORE_TAG, "No '%s' partition", STORE_PARTITION_LABEL);
+            return ESP_ERR_NOT_FOUND;
+        }
+        store_flash = (transaction_store_flash_t) {
+                .read = partition_read,
+                .write = partition_write,
+                .erase_sector = partition_erase,
+                .size = partition->size,
+                .ctx = (void*)partition
+        };
+    }
+    if(store_flash.size < (SUMMARY_SECTORS + 2) * SECTOR_SIZE) return ESP_ERR_INVALID_SIZE;
+
+    if(!store_lock) store_lock = xSemaphoreCreateMutex();
+    if(!store_lock) return ESP_ERR_NO_MEM;
+    xSemaphoreTake(store_lock, portMAX_DELAY);
+
+    memset(months, 0, sizeof(months));
+    memset(wear_counts, 0, sizeof(wear_counts));
+    memset(wear_dirty, 0, sizeof(wear_dirty));
+    segment_count = store_flash.size / SECTOR_SIZE - SUMMARY_SECTORS;
+    if(segment_count > MAX_SEGMENTS) segment_count = MAX_SEGMENTS;
+    active_segment = -1;
+    next_seq = 1;
+    last_commit = 0;
+
+    bool pending_counted = false;
+    esp_err_t err = load_summaries(&pending_counted);
+
+    uint32_t records = 0;
+    for(int i = 0; i < segment_count && err == ESP_OK; i++) {
+        err = scan_segment(i);
+        if(err != ESP_OK || segments[i].seq == 0) continue;
+        // Records changed after the last complete commit: fold them into the summaries, unless that commit
+        // already counted them and only their flags are missing
+        err = check_segment(i, !pending_counted);
+        records += segments[i].live;
+        if(segments[i].seq >= next_seq) {
+            next_seq = segments[i].seq + 1;
+            active_segment = i;
+        }
+    }
+    if(err == ESP_OK && active_segment >= 0) load_dictionary(active_segment);
+    if(err == ESP_OK) err = commit_locked();
+
+    store_ready = err == ESP_OK;
+    xSemaphoreGive(store_lock);
+
+    if(err != ESP_OK) ESP_LOGE(STORE_TAG, "Failed to load: %s", esp_err_to_name(err));
+    else ESP_LOGI(STORE_TAG, "%lu transactions in %u segments", (unsigned long)records, segment_count);
+    return err;
+}
+
+esp_err_t transaction_store_add(const transaction_store_entry_t* entry) {
+    if(!store_ready) return ESP_ERR_INVALID_STATE;
+    xSemaphoreTake(store_lock, portMAX_DELAY);
+    int segment;
+    uint16_t slot;
+    esp_err_t err = ESP_OK;
+    if(!find_record(entry->id_hash, entry->day, &segment, &slot)) err = append_record(entry);
+    xSemaphoreGive(store_lock);
+    return err;
+}
+
+esp_err_t transaction_store_modify(const transaction_store_entry_t* entry) {
+    if(!store_ready) return ESP_ERR_INVALID_STATE;
+    xSemaphoreTake(store_lock, portMAX_DELAY);
+    int segment;
+    uint16_t slot;
+    esp_err_t err = ESP_OK;
+    // The date may be what changed, so every segment is searched
+    if(find_record(entry->id_hash, UINT32_MAX, &segment, &slot)) err = delete_record(segment, slot);
+    if(err == ESP_OK) err = append_record(entry);
+    xSemaphoreGive(store_lock);
+    return err;
+}
+
+esp_err_t transaction_store_remove(uint32_t id_hash) {
+    if(!store_ready) return ESP_ERR_INVALID_STATE;
+    xSemaphoreTake(store_lock, portMAX_DELAY);
+    int segment;
+    uint16_t slot;
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+    if(find_record(id_hash, UINT32_MAX, &segment, &slot)) err = delete_record(segment, slot);
+    xSemaphoreGive(store_lock);
+    return err;
+}
+
+esp_err_t transaction_store_commit(void) {
+    if(!store_ready) return ESP_ERR_INVALID_STATE;
+    xSemaphoreTake(store_lock, portMAX_DELAY);
+    esp_err_t err = commit_locked();
+    xSemaphoreGive(store_lock);
+    return err;
+}
+
+esp_err_t transaction_store_month_summary(int year, int month, transaction_month_summary_t* out) {
+    if(!store_ready) return ESP_ERR_INVALID_STATE;
+    if(year < 1970 || month < 1 || month > 12) return ESP_ERR_INVALID_ARG;
+    xSemaphoreTake(store_lock, portMAX_DELAY);
+    month_entry_t* entry = find_month((uint16_t)((year - 1970) * 12 + (month - 1)), false);
+    if(entry) *out = entry->summary;
+    xSemaphoreGive(store_lock);
+    return entry ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+void transaction_store_for_each(uint32_t first_day, uint32_t last_day, transaction_store_cb_t cb, void* user_data) {
+    if(!store_ready) return;
+    xSemaphoreTake(store_lock, portMAX_DELAY);
+
+    // Oldest segment first
+    uint32_t previous_seq = 0;
+    for(;;) {
+        int s = -1;
+        for(int i = 0; i < segment_count; i++) {
+            if(segments[i].seq > previous_seq && (s < 0 || segments[i].seq < segments[s].seq)) s = i;
+        }
+        if(s < 0) break;
+        previous_seq = segments[s].seq;
+
+        const segment_info_t* info = &segments[s];
+        if(info->live == 0 || info->max_day < first_day || info->min_day > last_day) continue;
+
+        size_t n = info->used;
+        if(segment_read(s, OFF_IDS, col_ids, n * sizeof(uint32_t)) != ESP_OK ||
+           segment_read(s, OFF_DAYS, col_days, n * sizeof(uint16_t)) != ESP_OK ||
+           segment_read(s, OFF_AMOUNTS, col_amounts, n * sizeof(int32_t)) != ESP_OK ||
+           segment_read(s, OFF_MERCHANTS, col_merchants, n) != ESP_OK ||
+           segment_read(s, OFF_CATEGORIES, col_categories, n) != ESP_OK ||
+           segment_read(s, OFF_INSTITUTIONS, col_institutions, n) != ESP_OK ||
+           segment_read(s, OFF_FLAGS, col_flags, n) != ESP_OK ||
+           segment_read(s, OFF_DICT, dict_scratch, DICT_SIZE) != ESP_OK) {
+            ESP_LOGE(STORE_TAG, "Failed to read segment %d", s);
+            continue;
+        }
+
+        int dict_entries = 0;
+        for(uint16_t pos = 0; pos < DICT_SIZE && dict_scratch[pos] != DICT_END && dict_entries < MERCHANT_NONE;
+            pos += 1 + dict_scratch[pos]) {
+            dict_offsets[dict_entries++] = pos;
+        }
+
+        for(size_t i = 0; i < n; i++) {
+            uint32_t day = info->base_day + col_days[i] - DAY_BIAS;
+            if(IS_CLEARED(col_flags[i], FLAG_DELETED) || day < first_day || day > last_day) continue;
+
+            char merchant[TRANSACTION_STORE_MERCHANT_MAX + 1] = "";
+            if(col_merchants[i] < dict_entries) {
+                uint16_t pos = dict_offsets[col_merchants[i]];
+                size_t len = dict_scratch[pos];
+                if(len > TRANSACTION_STORE_MERCHANT_MAX || pos + 1 + len > DICT_SIZE) len = 0;
+                memcpy(merchant, &dict_scratch[pos + 1], len);
+                merchant[len] = '\0';
+            }
+
+            transaction_store_entry_t entry = {
+                    .id_hash = col_ids[i],
+                    .day = day,
+                    .amount_cents = col_amounts[i],
+                    .institution = col_institutions[i],
+                    .category = col_categories[i],
+                    .merchant = merchant
+            };
+            cb(&entry, user_data);
+        }
+    }
+    xSemaphoreGive(store_lock);
+}
+
+void transaction_store_get_stats(transaction_store_stats_t* stats) {
+    memset(stats, 0, sizeof(*stats));
+    if(!store_ready) return;
+    xSemaphoreTake(store_lock, portMAX_DELAY);
+    stats->segments_total = segment_count;
+    stats->erase_min = UINT32_MAX;
+    for(int i = 0; i < segment_count; i++) {
+        if(segments[i].seq != 0) {
+            stats->segments_used++;
+            stats->records += segments[i].live;
+        }
+        if(segments[i].erase_count < stats->erase_min) stats->erase_min = segments[i].erase_count;
+        if(segments[i].erase_count > stats->erase_max) stats->erase_max = segments[i].erase_count;
+    }
+    xSemaphoreGive(store_lock);
+}
+
+transaction_category_t transaction_store_category_from_name(const char* name) {
+    if(!name) return TRANSACTION_CATEGORY_OTHER;
+    for(int i = 1; i < TRANSACTION_CATEGORY_COUNT; i++) {
+        if(strcmp(name, category_names[i]) == 0) return (transaction_category_t)i;
+    }
+    return TRANSACTION_CATEGORY_OTHER;
+}
+
+const char* transaction_store_category_name(transaction_category_t category) {
+    return category < TRANSACTION_CATEGORY_COUNT ? category_names[category] : category_names[0];
+}
@@ -0,0 +1,144 @@
+#ifndef ESP32C6_FINANCE_HUB_TRANSACTION_STORE_H
+#define ESP32C6_FINANCE_HUB_TRANSACTION_STORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+// Longest merchant name kept in a segment dictionary
+#define TRANSACTION_STORE_MERCHANT_MAX 24
+// Months whose summaries are kept (older months are dropped first)
+#define TRANSACTION_STORE_SUMMARY_MONTHS 36
+
+/**
+ * Plaid personal_finance_category.primary values. The table is fixed, so a category is stored as one byte
+*/
+typedef enum {
+    TRANSACTION_CATEGORY_OTHER = 0,
+    TRANSACTION_CATEGORY_INCOME,
+    TRANSACTION_CATEGORY_TRANSFER_IN,
+    TRANSACTION_CATEGORY_TRANSFER_OUT,
+    TRANSACTION_CATEGORY_LOAN_PAYMENTS,
+    TRANSACTION_CATEGORY_BANK_FEES,
+    TRANSACTION_CATEGORY_ENTERTAINMENT,
+    TRANSACTION_CATEGORY_FOOD_AND_DRINK,
+    TRANSACTION_CATEGORY_GENERAL_MERCHANDISE,
+    TRANSACTION_CATEGORY_HOME_IMPROVEMENT,
+    TRANSACTION_CATEGORY_MEDICAL,
+    TRANSACTION_CATEGORY_PERSONAL_CARE,
+    TRANSACTION_CATEGORY_GENERAL_SERVICES,
+    TRANSACTION_CATEGORY_GOVERNMENT_AND_NON_PROFIT,
+    TRANSACTION_CATEGORY_TRANSPORTATION,
+    TRANSACTION_CATEGORY_TRAVEL,
+    TRANSACTION_CATEGORY_RENT_AND_UTILITIES,
+    TRANSACTION_CATEGORY_COUNT
+} transaction_category_t;
+
+/**
+ * A transaction going into or coming out of the store
+*/
+typedef struct {
+    uint32_t id_hash;           // transaction_log_hash_id of Plaid's transaction_id
+    uint32_t day;               // Days since 1970-01-01
+    int32_t amount_cents;       // Positive = money leaving the account (Plaid convention)
+    uint8_t institution;
+    uint8_t category;           // transaction_category_t
+    const char* merchant;       // Truncated to TRANSACTION_STORE_MERCHANT_MAX when stored
+} transaction_store_entry_t;
+
+/**
+ * Totals of one calendar month over the transactions the store holds. Recycling a segment takes its
+ * transactions out, so the oldest months can be partial once the store is full
+*/
+typedef struct {
+    int32_t totals_cents[TRANSACTION_CATEGORY_COUNT];   // Sum of amount_cents per category
+    uint32_t count;                                     // Number of transactions
+} transaction_month_summary_t;
+
+/**
+ * Raw flash the store lives on. Writes may only clear bits, like NOR flash.
+ * Passing a file-backed implementation to transaction_store_init runs the store off-target
+*/
+typedef struct {
+    esp_err_t (*read)(void* ctx, size_t offset, void* dst, size_t len);
+    esp_err_t (*write)(void* ctx, size_t offset, const void* src, size_t len);
+    esp_err_t (*erase_sector)(void* ctx, size_t offset);   // Sets a 4 KB sector back to 0xFF
+    size_t size;                                           // Bytes, a multiple of 4 KB
+    void* ctx;
+} transaction_store_flash_t;
+
+typedef struct {
+    uint32_t records;           // Live transactions
+    uint16_t segments_used;
+    uint16_t segments_total;
+    uint32_t erase_min;         // Lowest and highest erase count over all segments
+    uint32_t erase_max;
+} transaction_store_stats_t;
+
+/**
+ * @brief Called for each transaction by transaction_store_for_each. `entry->merchant` is only valid during the call
+*/
+typedef void (*transaction_store_cb_t)(const transaction_store_entry_t* entry, void* user_data);
+
+/**
+ * @brief Load the store and finish a commit that was cut short by a reset
+ * @param flash Flash to use, or NULL for the "txn_store" partition
+ * @return ESP_OK or the error of the failing step
+*/
+esp_err_t transaction_store_init(const transaction_store_flash_t* flash);
+
+/**
+ * @brief Store a new transaction. Adding an id that is already stored does nothing, so a page can be replayed
+*/
+esp_err_t transaction_store_add(const transaction_store_entry_t* entry);
+
+/**
+ * @brief Replace the transaction with the same id_hash (added if it is not stored yet)
+*/
+esp_err_t transaction_store_modify(const transaction_store_entry_t* entry);
+
+/**
+ * @brief Remove a transaction
+ * @return ESP_OK, or ESP_ERR_NOT_FOUND if it is not stored
+*/
+esp_err_t transaction_store_remove(uint32_t id_hash);
+
+/**
+ * @brief Write the month summaries changed since the last commit. Call once per sync page, before
+ * transaction_log_commit: a page that failed here must not move the sync cursor
+ * @return ESP_OK, ESP_ERR_INVALID_STATE if the store did not load, or the flash error
+*/
+esp_err_t transaction_store_commit(void);
+
+/**
+ * @brief Totals of a month. Served from the summary index, no transaction is read
+ * @param year Calendar year, e.g. 2026
+ * @param month 1-12
+ * @param out Where to store the summary
+ * @return ESP_OK, ESP_ERR_NOT_FOUND if nothing is known about that month,
+ * or ESP_ERR_INVALID_STATE if the store did not load
+*/
+esp_err_t transaction_store_month_summary(int year, int month, transaction_month_summary_t* out);
+
+/**
+ * @brief Visit every stored transaction between two days (inclusive). Segments outside the range are not read
+*/
+void transaction_store_for_each(uint32_t first_day, uint32_t last_day, transaction_store_cb_t cb, void* user_data);
+
+/**
+ * @brief Record and wear statistics
+*/
+void transaction_store_get_stats(transaction_store_stats_t* stats);
+
+/**
+ * @brief Map a Plaid personal_finance_category.primary string to a category
+*/
+transaction_category_t transaction_store_category_from_name(const char* name);
+
+/**
+ * @brief Plaid name of a category
+*/
+const char* transaction_store_category_name(transaction_category_t category);
+
+#endif //ESP32C6_FINANCE_HUB_TRANSACTION_STORE_H
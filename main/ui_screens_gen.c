@@ -0,0 +1,496 @@
+/*
+ **********************************************************************
+ *                            DO NOT EDIT
+ * This file is automatically generated by "ui_tree_gen.py"
+ * from "ui_screens.lvui"
+ **********************************************************************
+ */
+
+#include "ui_screens_gen.h"
+#include "ui_styles_gen.h"
+
+lv_obj_t * loading_screen;
+lv_obj_t * loading_gif;
+lv_obj_t * api_progress_label;
+lv_obj_t * chrome;
+lv_obj_t * nav_bar;
+lv_obj_t * home_button_label;
+lv_obj_t * accounts_button_label;
+lv_obj_t * transactions_button_label;
+lv_obj_t * time_label;
+lv_obj_t * home_page;
+lv_obj_t * counter_label;
+lv_obj_t * total_credit_balance_label;
+lv_obj_t * total_credit_balance_value;
+lv_obj_t * total_checking_balance_label;
+lv_obj_t * total_checking_balance_value;
+lv_obj_t * total_balance;
+lv_obj_t * total_balance_value;
+lv_obj_t * accounts_page;
+lv_obj_t * account_content;
+lv_obj_t * checking_table;
+lv_obj_t * credit_table;
+lv_obj_t * transactions_page;
+lv_obj_t * transactions_table;
+
+static const lv_style_const_prop_t loading_screen_main_props[4] = {
+    LV_STYLE_CONST_WIDTH(320),
+    LV_STYLE_CONST_HEIGHT(200),
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(loading_screen_main_style, loading_screen_main_props, 0x00000081);
+
+static const lv_style_const_prop_t loading_gif_main_props[4] = {
+    LV_STYLE_CONST_X(0),
+    LV_STYLE_CONST_Y(0),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_TOP_MID),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(loading_gif_main_style, loading_gif_main_props, 0x00000004);
+
+static const lv_style_const_prop_t loading_screen_obj_1_main_props[4] = {
+    LV_STYLE_CONST_X(0),
+    LV_STYLE_CONST_Y(0),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_CENTER),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(loading_screen_obj_1_main_style, loading_screen_obj_1_main_props, 0x00000004);
+
+static const lv_style_const_prop_t loading_screen_label_2_main_props[8] = {
+    LV_STYLE_CONST_X(0),
+    LV_STYLE_CONST_Y(0),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_BOTTOM_MID),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xff, 0xff, 0xff)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(loading_screen_label_2_main_style, loading_screen_label_2_main_props, 0x00400004);
+
+static const lv_style_const_prop_t api_progress_label_main_props[8] = {
+    LV_STYLE_CONST_WIDTH(220),
+    LV_STYLE_CONST_HEIGHT(30),
+    LV_STYLE_CONST_X(0),
+    LV_STYLE_CONST_Y(0),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_TOP_MID),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(api_progress_label_main_style, api_progress_label_main_props, 0x00000005);
+
+static const lv_style_const_prop_t nav_bar_main_props[4] = {
+    LV_STYLE_CONST_X(0),
+    LV_STYLE_CONST_Y(0),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_TOP_MID),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(nav_bar_main_style, nav_bar_main_props, 0x00000004);
+
+static const lv_style_const_prop_t chrome_obj_1_main_props[4] = {
+    LV_STYLE_CONST_X(0),
+    LV_STYLE_CONST_Y(0),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_LEFT_MID),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(chrome_obj_1_main_style, chrome_obj_1_main_props, 0x00000004);
+
+static const lv_style_const_prop_t chrome_button_2_main_props[8] = {
+    LV_STYLE_CONST_X(0),
+    LV_STYLE_CONST_Y(0),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_LEFT_MID),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(chrome_button_2_main_style, chrome_button_2_main_props, 0x00400004);
+
+static const lv_style_const_prop_t chrome_button_3_main_props[8] = {
+    LV_STYLE_CONST_X(25),
+    LV_STYLE_CONST_Y(0),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_LEFT_MID),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(14, 14, 28)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(chrome_button_3_main_style, chrome_button_3_main_props, 0x00400004);
+
+static const lv_style_const_prop_t chrome_button_4_main_props[8] = {
+    LV_STYLE_CONST_X(50),
+    LV_STYLE_CONST_Y(0),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_LEFT_MID),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(14, 14, 28)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(chrome_button_4_main_style, chrome_button_4_main_props, 0x00400004);
+
+static const lv_style_const_prop_t chrome_label_5_main_props[4] = {
+    LV_STYLE_CONST_X(0),
+    LV_STYLE_CONST_Y(0),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_CENTER),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(chrome_label_5_main_style, chrome_label_5_main_props, 0x00000004);
+
+static const lv_style_const_prop_t time_label_main_props[8] = {
+    LV_STYLE_CONST_X(-5),
+    LV_STYLE_CONST_Y(0),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_RIGHT_MID),
+    LV_STYLE_CONST_TEXT_ALIGN(LV_TEXT_ALIGN_RIGHT),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(time_label_main_style, time_label_main_props, 0x00800004);
+
+static const lv_style_const_prop_t home_page_main_props[4] = {
+    LV_STYLE_CONST_WIDTH(320),
+    LV_STYLE_CONST_HEIGHT(200),
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(home_page_main_style, home_page_main_props, 0x00000081);
+
+static const lv_style_const_prop_t counter_label_main_props[8] = {
+    LV_STYLE_CONST_X(0),
+    LV_STYLE_CONST_Y(45),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_TOP_MID),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xff, 0xff, 0xff)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(counter_label_main_style, counter_label_main_props, 0x00400004);
+
+static const lv_style_const_prop_t total_credit_balance_label_main_props[8] = {
+    LV_STYLE_CONST_X(20),
+    LV_STYLE_CONST_Y(-11),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_LEFT_MID),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xff, 0xff, 0xff)),
+    LV_STYLE_CONST_TEXT_ALIGN(LV_TEXT_ALIGN_CENTER),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(total_credit_balance_label_main_style, total_credit_balance_label_main_props, 0x00C00004);
+
+static const lv_style_const_prop_t total_credit_balance_value_main_props[2] = {
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xff, 0xff, 0xff)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(total_credit_balance_value_main_style, total_credit_balance_value_main_props, 0x00400000);
+
+static const lv_style_const_prop_t total_checking_balance_label_main_props[8] = {
+    LV_STYLE_CONST_X(-20),
+    LV_STYLE_CONST_Y(-11),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_RIGHT_MID),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xff, 0xff, 0xff)),
+    LV_STYLE_CONST_TEXT_ALIGN(LV_TEXT_ALIGN_CENTER),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(total_checking_balance_label_main_style, total_checking_balance_label_main_props, 0x00C00004);
+
+static const lv_style_const_prop_t total_checking_balance_value_main_props[2] = {
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xff, 0xff, 0xff)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(total_checking_balance_value_main_style, total_checking_balance_value_main_props, 0x00400000);
+
+static const lv_style_const_prop_t total_balance_main_props[8] = {
+    LV_STYLE_CONST_X(0),
+    LV_STYLE_CONST_Y(-62),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_BOTTOM_MID),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xff, 0xff, 0xff)),
+    LV_STYLE_CONST_TEXT_ALIGN(LV_TEXT_ALIGN_CENTER),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(total_balance_main_style, total_balance_main_props, 0x00C00004);
+
+static const lv_style_const_prop_t total_balance_value_main_props[2] = {
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xff, 0xff, 0xff)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(total_balance_value_main_style, total_balance_value_main_props, 0x00400000);
+
+static const lv_style_const_prop_t accounts_page_main_props[2] = {
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(accounts_page_main_style, accounts_page_main_props, 0x00000080);
+
+static const lv_style_const_prop_t account_content_main_props[16] = {
+    LV_STYLE_CONST_WIDTH(320),
+    LV_STYLE_CONST_HEIGHT(190),
+    LV_STYLE_CONST_X(0),
+    LV_STYLE_CONST_Y(50),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_TOP_MID),
+    LV_STYLE_CONST_PAD_TOP(0),
+    LV_STYLE_CONST_PAD_BOTTOM(0),
+    LV_STYLE_CONST_PAD_LEFT(0),
+    LV_STYLE_CONST_PAD_RIGHT(0),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_TRANSP),
+    LV_STYLE_CONST_BORDER_WIDTH(0),
+    LV_STYLE_CONST_OUTLINE_WIDTH(0),
+    LV_STYLE_CONST_SHADOW_WIDTH(0),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(account_content_main_style, account_content_main_props, 0x0040D095);
+
+static const lv_style_const_prop_t checking_table_main_props[8] = {
+    LV_STYLE_CONST_X(0),
+    LV_STYLE_CONST_Y(0),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_TOP_MID),
+    LV_STYLE_CONST_PAD_ROW(5),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(checking_table_main_style, checking_table_main_props, 0x00000024);
+
+static const lv_style_const_prop_t checking_table_items_props[8] = {
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0, 255, 50)),
+    LV_STYLE_CONST_BORDER_WIDTH(1),
+    LV_STYLE_CONST_BORDER_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(checking_table_items_style, checking_table_items_props, 0x00401080);
+
+static const lv_style_const_prop_t credit_table_main_props[2] = {
+    LV_STYLE_CONST_PAD_ROW(5),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(credit_table_main_style, credit_table_main_props, 0x00000020);
+
+static const lv_style_const_prop_t credit_table_items_props[8] = {
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(14, 14, 28)),
+    LV_STYLE_CONST_BORDER_WIDTH(1),
+    LV_STYLE_CONST_BORDER_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(credit_table_items_style, credit_table_items_props, 0x00401080);
+
+static const lv_style_const_prop_t transactions_page_main_props[2] = {
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(transactions_page_main_style, transactions_page_main_props, 0x00000080);
+
+static const lv_style_const_prop_t transactions_table_main_props[8] = {
+    LV_STYLE_CONST_WIDTH(310),
+    LV_STYLE_CONST_HEIGHT(150),
+    LV_STYLE_CONST_X(0),
+    LV_STYLE_CONST_Y(50),
+    LV_STYLE_CONST_ALIGN(LV_ALIGN_TOP_MID),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(transactions_table_main_style, transactions_table_main_props, 0x00000005);
+
+static const lv_style_const_prop_t transactions_table_items_props[8] = {
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(14, 14, 28)),
+    LV_STYLE_CONST_BORDER_WIDTH(1),
+    LV_STYLE_CONST_BORDER_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0xff, 0xff, 0xff)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+static LV_STYLE_CONST_INIT_SORTED(transactions_table_items_style, transactions_table_items_props, 0x00401080);
+
+lv_obj_t * loading_screen_create(void)
+{
+    lv_obj_begin_style_batch();
+
+    loading_screen = lv_obj_create(NULL);
+    lv_obj_add_style(loading_screen, &loading_screen_main_style, 0);
+
+    loading_gif = lv_gif_create(loading_screen);
+    lv_gif_set_color_format(loading_gif, LV_COLOR_FORMAT_RGB565);
+    lv_gif_set_src(loading_gif, "A:/loading.gif");
+    lv_obj_add_style(loading_gif, &loading_gif_main_style, 0);
+
+    lv_obj_t * obj_1 = lv_obj_create(loading_screen);
+    lv_obj_add_style(obj_1, &loading_div_style, 0);
+    lv_obj_add_style(obj_1, &loading_screen_obj_1_main_style, 0);
+
+    lv_obj_t * label_2 = lv_label_create(obj_1);
+    lv_label_set_text(label_2, LV_SYMBOL_WIFI " Loading...");
+    lv_obj_add_style(label_2, &loading_screen_label_2_main_style, 0);
+
+    api_progress_label = lv_bar_create(obj_1);
+    lv_obj_remove_style_all(api_progress_label);
+    lv_obj_add_style(api_progress_label, &bar_style_bg, 0);
+    lv_obj_add_style(api_progress_label, &bar_style_indic, LV_PART_INDICATOR);
+    lv_bar_set_value(api_progress_label, 0, LV_ANIM_ON);
+    lv_obj_add_style(api_progress_label, &api_progress_label_main_style, 0);
+
+    lv_obj_commit_style_batch(loading_screen);
+    return loading_screen;
+}
+
+lv_obj_t * chrome_create(void)
+{
+    lv_obj_begin_style_batch();
+
+    chrome = lv_layer_top();
+
+    nav_bar = lv_obj_create(chrome);
+    lv_obj_add_style(nav_bar, &nav_style, 0);
+    lv_obj_set_scrollbar_mode(nav_bar, LV_SCROLLBAR_MODE_OFF);
+    lv_obj_add_flag(nav_bar, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_style(nav_bar, &nav_bar_main_style, 0);
+
+    lv_obj_t * obj_1 = lv_obj_create(nav_bar);
+    lv_obj_add_style(obj_1, &menu_style, 0);
+    lv_obj_set_scrollbar_mode(obj_1, LV_SCROLLBAR_MODE_OFF);
+    lv_obj_add_style(obj_1, &chrome_obj_1_main_style, 0);
+
+    lv_obj_t * button_2 = lv_button_create(obj_1);
+    lv_obj_add_style(button_2, &menu_button_style, 0);
+    lv_obj_add_style(button_2, &chrome_button_2_main_style, 0);
+
+    home_button_label = lv_label_create(button_2);
+    lv_label_set_text(home_button_label, LV_SYMBOL_HOME);
+
+    lv_obj_t * button_3 = lv_button_create(obj_1);
+    lv_obj_add_style(button_3, &menu_button_style, 0);
+    lv_obj_add_style(button_3, &chrome_button_3_main_style, 0);
+
+    accounts_button_label = lv_label_create(button_3);
+    lv_label_set_text(accounts_button_label, LV_SYMBOL_LIST);
+
+    lv_obj_t * button_4 = lv_button_create(obj_1);
+    lv_obj_add_style(button_4, &menu_button_style, 0);
+    lv_obj_add_style(button_4, &chrome_button_4_main_style, 0);
+
+    transactions_button_label = lv_label_create(button_4);
+    lv_label_set_text(transactions_button_label, LV_SYMBOL_BELL);
+
+    lv_obj_t * label_5 = lv_label_create(nav_bar);
+    lv_label_set_text(label_5, "Finance Hub");
+    lv_obj_add_style(label_5, &chrome_label_5_main_style, 0);
+
+    time_label = lv_label_create(nav_bar);
+    lv_label_set_text(time_label, "Fetching...");
+    lv_obj_add_style(time_label, &time_label_main_style, 0);
+
+    lv_obj_commit_style_batch(chrome);
+    return chrome;
+}
+
+lv_obj_t * home_page_create(void)
+{
+    lv_obj_begin_style_batch();
+
+    home_page = lv_obj_create(NULL);
+    lv_obj_add_style(home_page, &home_page_main_style, 0);
+
+    counter_label = lv_label_create(home_page);
+    lv_label_set_text(counter_label, "Count: 0");
+    lv_obj_add_style(counter_label, &counter_label_main_style, 0);
+
+    total_credit_balance_label = lv_label_create(home_page);
+    lv_label_set_text(total_credit_balance_label, LV_SYMBOL_WIFI " Credit...");
+    lv_obj_add_style(total_credit_balance_label, &total_credit_balance_label_main_style, 0);
+
+    total_credit_balance_value = lv_numlabel_create(home_page);
+    lv_numlabel_set_format(total_credit_balance_value, "$", 2, ',');
+    lv_numlabel_set_roll_time(total_credit_balance_value, 300);
+    lv_obj_add_flag(total_credit_balance_value, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_style(total_credit_balance_value, &total_credit_balance_value_main_style, 0);
+
+    total_checking_balance_label = lv_label_create(home_page);
+    lv_label_set_text(total_checking_balance_label, LV_SYMBOL_WIFI " Checking...");
+    lv_obj_add_style(total_checking_balance_label, &total_checking_balance_label_main_style, 0);
+
+    total_checking_balance_value = lv_numlabel_create(home_page);
+    lv_numlabel_set_format(total_checking_balance_value, "$", 2, ',');
+    lv_numlabel_set_roll_time(total_checking_balance_value, 300);
+    lv_obj_add_flag(total_checking_balance_value, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_style(total_checking_balance_value, &total_checking_balance_value_main_style, 0);
+
+    total_balance = lv_label_create(home_page);
+    lv_label_set_text(total_balance, LV_SYMBOL_WIFI " Total Balance...");
+    lv_obj_add_style(total_balance, &total_balance_main_style, 0);
+
+    total_balance_value = lv_numlabel_create(home_page);
+    lv_numlabel_set_format(total_balance_value, "$", 2, ',');
+    lv_numlabel_set_roll_time(total_balance_value, 300);
+    lv_obj_add_flag(total_balance_value, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_style(total_balance_value, &total_balance_value_main_style, 0);
+
+    lv_obj_commit_style_batch(home_page);
+    return home_page;
+}
+
+lv_obj_t * accounts_page_create(void)
+{
+    lv_obj_begin_style_batch();
+
+    accounts_page = lv_obj_create(NULL);
+    lv_obj_add_style(accounts_page, &accounts_page_main_style, 0);
+
+    account_content = lv_obj_create(accounts_page);
+    lv_obj_add_style(account_content, &account_content_main_style, 0);
+
+    checking_table = lv_table_create(account_content);
+    lv_table_set_column_count(checking_table, 2);
+    lv_table_set_row_count(checking_table, 1);
+    lv_table_set_column_width(checking_table, 0, 180);
+    lv_table_set_column_width(checking_table, 1, 120);
+    lv_obj_add_style(checking_table, &table_style, 0);
+    lv_table_set_cell_value(checking_table, 0, 0, "Checking Account");
+    lv_table_set_cell_value(checking_table, 0, 1, "Balance");
+    lv_obj_add_style(checking_table, &checking_table_main_style, 0);
+    lv_obj_add_style(checking_table, &checking_table_items_style, LV_PART_ITEMS);
+
+    credit_table = lv_table_create(account_content);
+    lv_table_set_column_count(credit_table, 2);
+    lv_table_set_row_count(credit_table, 1);
+    lv_table_set_column_width(credit_table, 0, 180);
+    lv_table_set_column_width(credit_table, 1, 120);
+    lv_obj_add_style(credit_table, &table_style, 0);
+    lv_table_set_cell_value(credit_table, 0, 0, "Credit Account");
+    lv_table_set_cell_value(credit_table, 0, 1, "Balance");
+    lv_obj_add_style(credit_table, &credit_table_main_style, 0);
+    lv_obj_add_style(credit_table, &credit_table_items_style, LV_PART_ITEMS);
+
+    lv_obj_commit_style_batch(accounts_page);
+    return accounts_page;
+}
+
+lv_obj_t * transactions_page_create(void)
+{
+    lv_obj_begin_style_batch();
+
+    transactions_page = lv_obj_create(NULL);
+    lv_obj_add_style(transactions_page, &transactions_page_main_style, 0);
+
+    transactions_table = lv_table_create(transactions_page);
+    lv_obj_add_style(transactions_table, &table_style, 0);
+    lv_table_set_column_count(transactions_table, 3);
+    lv_table_set_column_width(transactions_table, 0, 60);
+    lv_table_set_column_width(transactions_table, 1, 160);
+    lv_table_set_column_width(transactions_table, 2, 90);
+    lv_obj_add_style(transactions_table, &transactions_table_main_style, 0);
+    lv_obj_add_style(transactions_table, &transactions_table_items_style, LV_PART_ITEMS);
+
+    lv_obj_commit_style_batch(transactions_page);
+    return transactions_page;
+}
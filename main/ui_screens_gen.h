@@ -0,0 +1,74 @@
+/*
+ **********************************************************************
+ *                            DO NOT EDIT
+ * This file is automatically generated by "ui_tree_gen.py"
+ * from "ui_screens.lvui"
+ **********************************************************************
+ */
+
+#ifndef UI_SCREENS_GEN_H
+#define UI_SCREENS_GEN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+
+/** Shown while the accounts are fetched */
+lv_obj_t * loading_screen_create(void);
+
+/** Shared by all pages, stays on the top layer while the pages change under it */
+lv_obj_t * chrome_create(void);
+
+/** Counter and balances */
+lv_obj_t * home_page_create(void);
+
+/** Checking and credit accounts */
+lv_obj_t * accounts_page_create(void);
+
+/** Transaction history */
+lv_obj_t * transactions_page_create(void);
+
+/* The named objects. Set by the `..._create()` function of their screen */
+
+/** Shown while the accounts are fetched */
+extern lv_obj_t * loading_screen;
+/** Loading animation from the asset pack. Decoded into RGB565, so its canvas takes 3 bytes per pixel */
+extern lv_obj_t * loading_gif;
+/** Progress of fetching the accounts */
+extern lv_obj_t * api_progress_label;
+/** Shared by all pages, stays on the top layer while the pages change under it */
+extern lv_obj_t * chrome;
+/** Shown with the home page when the accounts are loaded */
+extern lv_obj_t * nav_bar;
+extern lv_obj_t * home_button_label;
+extern lv_obj_t * accounts_button_label;
+extern lv_obj_t * transactions_button_label;
+extern lv_obj_t * time_label;
+/** Counter and balances */
+extern lv_obj_t * home_page;
+extern lv_obj_t * counter_label;
+extern lv_obj_t * total_credit_balance_label;
+/** Shown once the balances are loaded. Numeric labels only redraw the digits that changed */
+extern lv_obj_t * total_credit_balance_value;
+extern lv_obj_t * total_checking_balance_label;
+extern lv_obj_t * total_checking_balance_value;
+extern lv_obj_t * total_balance;
+extern lv_obj_t * total_balance_value;
+/** Checking and credit accounts */
+extern lv_obj_t * accounts_page;
+/** Scrolled by the scroll buttons */
+extern lv_obj_t * account_content;
+extern lv_obj_t * checking_table;
+extern lv_obj_t * credit_table;
+/** Transaction history */
+extern lv_obj_t * transactions_page;
+/** Virtual, so only the visible rows are ever built no matter how many transactions there are */
+extern lv_obj_t * transactions_table;
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*UI_SCREENS_GEN_H*/
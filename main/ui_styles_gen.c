@@ -0,0 +1,113 @@
+/*
+ **********************************************************************
+ *                            DO NOT EDIT
+ * This file is automatically generated by "style_sheet_gen.py"
+ * from "ui_styles.lvss"
+ **********************************************************************
+ */
+
+#include "ui_styles_gen.h"
+
+static const lv_style_const_prop_t loading_div_style_props[16] = {
+    LV_STYLE_CONST_WIDTH(220),
+    LV_STYLE_CONST_HEIGHT(60),
+    LV_STYLE_CONST_RADIUS(0),
+    LV_STYLE_CONST_PAD_TOP(0),
+    LV_STYLE_CONST_PAD_BOTTOM(0),
+    LV_STYLE_CONST_PAD_LEFT(0),
+    LV_STYLE_CONST_PAD_RIGHT(0),
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_BORDER_WIDTH(0),
+    LV_STYLE_CONST_PROPS_END
+};
+
+LV_STYLE_CONST_INIT_SORTED(loading_div_style, loading_div_style_props, 0x00001099);
+
+static const lv_style_const_prop_t bar_style_bg_props[16] = {
+    LV_STYLE_CONST_RADIUS(10),
+    LV_STYLE_CONST_PAD_TOP(3),
+    LV_STYLE_CONST_PAD_BOTTOM(3),
+    LV_STYLE_CONST_PAD_LEFT(3),
+    LV_STYLE_CONST_PAD_RIGHT(3),
+    LV_STYLE_CONST_BORDER_WIDTH(2),
+    LV_STYLE_CONST_BORDER_COLOR(LV_COLOR_MAKE(0xff, 0xff, 0xff)),
+    LV_STYLE_CONST_ANIM_DURATION(1500),
+    LV_STYLE_CONST_PROPS_END
+};
+
+LV_STYLE_CONST_INIT_SORTED(bar_style_bg, bar_style_bg_props, 0x02001018);
+
+static const lv_style_const_prop_t bar_style_indic_props[4] = {
+    LV_STYLE_CONST_RADIUS(10),
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0xff)),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_COVER),
+    LV_STYLE_CONST_PROPS_END
+};
+
+LV_STYLE_CONST_INIT_SORTED(bar_style_indic, bar_style_indic_props, 0x00000088);
+
+static const lv_style_const_prop_t nav_style_props[16] = {
+    LV_STYLE_CONST_WIDTH(320),
+    LV_STYLE_CONST_HEIGHT(40),
+    LV_STYLE_CONST_RADIUS(0),
+    LV_STYLE_CONST_PAD_TOP(8),
+    LV_STYLE_CONST_PAD_BOTTOM(8),
+    LV_STYLE_CONST_PAD_LEFT(0),
+    LV_STYLE_CONST_PAD_RIGHT(0),
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(28, 1, 38)),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_COVER),
+    LV_STYLE_CONST_BORDER_WIDTH(0),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+LV_STYLE_CONST_INIT_SORTED(nav_style, nav_style_props, 0x00401099);
+
+static const lv_style_const_prop_t menu_style_props[16] = {
+    LV_STYLE_CONST_RADIUS(0),
+    LV_STYLE_CONST_PAD_TOP(8),
+    LV_STYLE_CONST_PAD_BOTTOM(8),
+    LV_STYLE_CONST_PAD_LEFT(4),
+    LV_STYLE_CONST_PAD_RIGHT(4),
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(28, 1, 38)),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_COVER),
+    LV_STYLE_CONST_BORDER_WIDTH(0),
+    LV_STYLE_CONST_PROPS_END
+};
+
+LV_STYLE_CONST_INIT_SORTED(menu_style, menu_style_props, 0x00001098);
+
+static const lv_style_const_prop_t menu_button_style_props[16] = {
+    LV_STYLE_CONST_WIDTH(150),
+    LV_STYLE_CONST_HEIGHT(35),
+    LV_STYLE_CONST_RADIUS(0),
+    LV_STYLE_CONST_PAD_TOP(8),
+    LV_STYLE_CONST_PAD_BOTTOM(8),
+    LV_STYLE_CONST_PAD_LEFT(4),
+    LV_STYLE_CONST_PAD_RIGHT(4),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_0),
+    LV_STYLE_CONST_BORDER_WIDTH(0),
+    LV_STYLE_CONST_OUTLINE_WIDTH(0),
+    LV_STYLE_CONST_SHADOW_WIDTH(0),
+    LV_STYLE_CONST_PROPS_END
+};
+
+LV_STYLE_CONST_INIT_SORTED(menu_button_style, menu_button_style_props, 0x0000D099);
+
+static const lv_style_const_prop_t table_style_props[16] = {
+    LV_STYLE_CONST_WIDTH(310),
+    LV_STYLE_CONST_HEIGHT(60),
+    LV_STYLE_CONST_RADIUS(0),
+    LV_STYLE_CONST_PAD_TOP(0),
+    LV_STYLE_CONST_PAD_BOTTOM(0),
+    LV_STYLE_CONST_PAD_LEFT(0),
+    LV_STYLE_CONST_PAD_RIGHT(0),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_0),
+    LV_STYLE_CONST_BORDER_WIDTH(0),
+    LV_STYLE_CONST_OUTLINE_WIDTH(0),
+    LV_STYLE_CONST_SHADOW_WIDTH(0),
+    LV_STYLE_CONST_TEXT_COLOR(LV_COLOR_MAKE(0x00, 0x00, 0x00)),
+    LV_STYLE_CONST_PROPS_END
+};
+
+LV_STYLE_CONST_INIT_SORTED(table_style, table_style_props, 0x0040D099);
@@ -0,0 +1,43 @@
+/*
+ **********************************************************************
+ *                            DO NOT EDIT
+ * This file is automatically generated by "style_sheet_gen.py"
+ * from "ui_styles.lvss"
+ **********************************************************************
+ */
+
+#ifndef UI_STYLES_GEN_H
+#define UI_STYLES_GEN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+
+/** Center div of the loading screen */
+extern const lv_style_t loading_div_style;
+
+/** Background of the fetching progress bar */
+extern const lv_style_t bar_style_bg;
+
+/** Indicator of the fetching progress bar */
+extern const lv_style_t bar_style_indic;
+
+/** Nav bar at the top of the home page */
+extern const lv_style_t nav_style;
+
+/** Menu in the nav bar */
+extern const lv_style_t menu_style;
+
+/** Home, accounts and transactions buttons of the menu */
+extern const lv_style_t menu_button_style;
+
+/** Account and transaction tables */
+extern const lv_style_t table_style;
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*UI_STYLES_GEN_H*/
@@ -0,0 +1,166 @@
+/**
+ * @file covered_area_test.c
+ * Checks of leaving out the rows of the screens covered by the top layer (`lv_refr_trim_covered_area`),
+ * both when refreshing and when a loaded screen is redrawn, with the app's pages and nav bar.
+ * After random changes every frame must equal a full redraw in which nothing is trimmed
+ * (the chrome reports itself masked to the cover check, so it's drawn the same but covers nothing):
+ * - the nav bar with a semi-transparent or transparent background, semi-transparent, hidden and shown again
+ * - the nav bar moved, partly off the display and to the bottom
+ * - the whole top layer semi-transparent or hidden
+ * - changes of the page and the nav bar's label under all of these
+ * - pages loaded with every kind of screen load animation, each frame of it
+ */
+
+#include "host.h"
+#include "src/core/lv_refr_private.h"
+
+/*The generated UI is compiled into this translation unit too*/
+#include "../../main/ui_styles_gen.c"
+#include "../../main/ui_screens_gen.c"
+
+#define STEPS           800
+#define FRAME_TIME      LV_DEF_REFR_PERIOD
+
+static lv_display_t * disp;
+static uint32_t frame_cnt;
+
+static uint32_t rnd_state = 1;
+
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return rnd_state >> 8;
+}
+
+static const char * transaction_cell_cb(lv_obj_t * obj, uint32_t row, uint32_t col, char * buf, uint32_t buf_size)
+{
+    if(col == 0) lv_snprintf(buf, buf_size, "%02u/%02u", (unsigned)(row % 12 + 1), (unsigned)(row % 28 + 1));
+    else if(col == 1) lv_snprintf(buf, buf_size, "Merchant %u", (unsigned)row);
+    else lv_snprintf(buf, buf_size, "-$%u.%02u", (unsigned)(row * 37 % 500), (unsigned)(row * 13 % 100));
+    return buf;
+}
+
+static void pages_create(void)
+{
+    chrome_create();
+    lv_obj_remove_flag(nav_bar, LV_OBJ_FLAG_HIDDEN);
+    home_page_create();
+    accounts_page_create();
+    for(uint32_t i = 1; i <= 4; i++) {
+        lv_table_set_row_count(checking_table, i + 1);
+        lv_table_set_cell_value_fmt(checking_table, i, 0, "Bank %u", (unsigned)i);
+        lv_table_set_cell_value(checking_table, i, 1, "$1,234.00");
+    }
+    transactions_page_create();
+    lv_table_set_cell_data_cb(transactions_table, transaction_cell_cb);
+    lv_table_set_row_count(transactions_table, 200);
+}
+
+static void masked_cb(lv_event_t * e)
+{
+    lv_event_set_cover_res(e, LV_COVER_RES_MASKED);
+}
+
+/** Compare the frame with a full redraw of the same moment which trims nothing */
+static void check_frame(const char * what)
+{
+    /*The animations ran after the refresh, render what they invalidated the usual way first*/
+    lv_refr_now(disp);
+    uint32_t hash = host_frame_hash();
+
+    lv_obj_t * top = lv_layer_top();
+    uint32_t cnt = lv_obj_get_child_count(top);
+    for(uint32_t i = 0; i < cnt; i++) {
+        lv_obj_add_event_cb(lv_obj_get_child(top, i), masked_cb, LV_EVENT_COVER_CHECK, NULL);
+    }
+    lv_area_t area = {0, 0, HOST_HOR_RES - 1, HOST_VER_RES - 1};
+    lv_inv_area(disp, &area);
+    lv_refr_now(disp);
+    for(uint32_t i = 0; i < cnt; i++) lv_obj_remove_event_cb(lv_obj_get_child(top, i), masked_cb);
+
+    HOST_CHECK(hash == host_frame_hash(), "frame %u (%s) differs from the full redraw", (unsigned)frame_cnt, what);
+    frame_cnt++;
+}
+
+static void load_anim(lv_obj_t * page)
+{
+    static const lv_screen_load_anim_t anims[] = {
+        LV_SCR_LOAD_ANIM_OVER_LEFT, LV_SCR_LOAD_ANIM_OVER_TOP, LV_SCR_LOAD_ANIM_OVER_BOTTOM,
+        LV_SCR_LOAD_ANIM_MOVE_RIGHT, LV_SCR_LOAD_ANIM_MOVE_TOP, LV_SCR_LOAD_ANIM_FADE_IN,
+        LV_SCR_LOAD_ANIM_FADE_OUT, LV_SCR_LOAD_ANIM_OUT_LEFT, LV_SCR_LOAD_ANIM_OUT_BOTTOM,
+    };
+
+    if(page == lv_screen_active()) return;
+    lv_screen_load_anim(page, anims[rnd() % (sizeof(anims) / sizeof(anims[0]))], 100 + rnd() % 200, 0, false);
+    do {
+        host_advance(FRAME_TIME);
+        check_frame("screen load animation");
+    } while(lv_anim_count_running());
+}
+
+static void random_step(void)
+{
+    lv_obj_t * pages[] = {home_page, accounts_page, transactions_page};
+    static const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_COVER, LV_OPA_50, LV_OPA_TRANSP};
+    static const int32_t ys[] = {0, 0, 12, -12, HOST_VER_RES / 2, HOST_VER_RES};
+
+    switch(rnd() % 10) {
+        case 0:
+            lv_screen_load(pages[rnd() % 3]);
+            break;
+        case 1:
+            load_anim(pages[rnd() % 3]);
+            return;
+        case 2:
+            lv_obj_set_style_bg_opa(nav_bar, opas[rnd() % 4], 0);
+            break;
+        case 3:
+            lv_obj_set_style_opa(nav_bar, opas[rnd() % 3], 0);
+            break;
+        case 4:
+            if(lv_obj_has_flag(nav_bar, LV_OBJ_FLAG_HIDDEN)) lv_obj_remove_flag(nav_bar, LV_OBJ_FLAG_HIDDEN);
+            else lv_obj_add_flag(nav_bar, LV_OBJ_FLAG_HIDDEN);
+            break;
+        case 5: {
+                /*At the bottom the nav bar's lower edge is on the last row*/
+                int32_t y = ys[rnd() % 6];
+                if(y == HOST_VER_RES) y -= lv_obj_get_height(nav_bar);
+                lv_obj_set_y(nav_bar, y);
+                break;
+            }
+        case 6: {
+                lv_obj_t * top = lv_layer_top();
+                if(rnd() % 4) lv_obj_set_style_opa(top, opas[rnd() % 3], 0);
+                else if(lv_obj_has_flag(top, LV_OBJ_FLAG_HIDDEN)) lv_obj_remove_flag(top, LV_OBJ_FLAG_HIDDEN);
+                else lv_obj_add_flag(top, LV_OBJ_FLAG_HIDDEN);
+                break;
+            }
+        case 7:
+            lv_label_set_text_fmt(time_label, "12:%02u", (unsigned)(rnd() % 60));
+            break;
+        case 8:
+            lv_obj_scroll_by_bounded(transactions_table, 0, rnd() % 2 ? -40 : 40, LV_ANIM_OFF);
+            break;
+        case 9:
+            lv_label_set_text_fmt(counter_label, "Count: %u", (unsigned)(rnd() % 1000));
+            lv_table_set_cell_value_fmt(checking_table, 1 + rnd() % 4, 1, "$%u.00", (unsigned)(rnd() % 5000));
+            break;
+    }
+
+    host_advance(FRAME_TIME);
+    check_frame("random step");
+}
+
+int main(void)
+{
+    disp = host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+    pages_create();
+
+    lv_screen_load(home_page);
+    host_advance(FRAME_TIME);
+    check_frame("first load");
+
+    for(uint32_t i = 0; i < STEPS; i++) random_step();
+
+    return host_finish("covered_area_test");
+}
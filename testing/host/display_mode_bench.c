@@ -0,0 +1,188 @@
+/**
+ * @file display_mode_bench.c
+ * Page switches and scrolls of the app's UI in the firmware's partial mode (two 240x20 pixel buffers) and in
+ * direct mode (DISPLAY_DIRECT_MODE in main/main.c: LVGL keeps the whole frame), each with and without the page cache.
+ * The flush does what main.c's does: a stripe of partial mode is sent as it is, in direct mode the rows of a
+ * changed area are copied into the two bounce buffers and sent one filled buffer at a time.
+ * - page switch: home, accounts and transactions loaded in turn, the refresh after each load is timed, then the
+ *   display idles for 500 ms (the button's period), in which the page cache renders missing bands in the background
+ * - scroll: the transactions table scrolled by 80 px with animation like the scroll buttons do, every frame timed
+ * For each it prints the time in `lv_timer_handler` (rendering and flush copies), the pixels and transfers sent and
+ * their time on the 64 MHz SPI bus. The frames of every mode are compared with the first one's.
+ */
+
+#include "host.h"
+
+/*The generated UI is compiled into this translation unit too*/
+#include "../../main/ui_styles_gen.c"
+#include "../../main/ui_screens_gen.c"
+
+#define SWITCHES        30
+#define SCROLLS         24
+#define FRAME_TIME      LV_DEF_REFR_PERIOD
+#define IDLE_TIME       500
+#define SPI_HZ          (64 * 1000 * 1000)
+#define BOUNCE_PX       (240 * 20)
+
+static lv_display_t * disp;
+static uint16_t buffer[BOUNCE_PX];
+static uint16_t buffer2[BOUNCE_PX];
+static uint8_t page_cache_buf[48 * 1024];
+static bool direct;
+static uint32_t flush_px;
+static uint32_t flush_transfers;
+
+/** Like lvgl_flush_cb of main.c in direct mode and the driver's flush in partial mode */
+static void flush_cb(lv_display_t * d, const lv_area_t * area, uint8_t * px_map)
+{
+    int32_t w = lv_area_get_width(area);
+    flush_px += w * lv_area_get_height(area);
+
+    if(direct) {
+        uint16_t * bounce[2] = {buffer, buffer2};
+        static uint32_t bounce_act;
+        int32_t rows_max = BOUNCE_PX / w;
+        const uint16_t * src = (const uint16_t *)px_map;
+        for(int32_t y = area->y1; y <= area->y2; y += rows_max) {
+            int32_t rows = LV_MIN(rows_max, area->y2 - y + 1);
+            uint16_t * dest = bounce[bounce_act];
+            bounce_act ^= 1;
+            for(int32_t i = 0; i < rows; i++) {
+                memcpy(dest + i * w, src + (y + i) * HOST_HOR_RES + area->x1, w * sizeof(uint16_t));
+            }
+            flush_transfers++;
+        }
+        lv_display_flush_ready(d);
+    }
+    else {
+        flush_transfers++;
+        host_flush_cb(d, area, px_map);
+    }
+}
+
+static const char * transaction_cell_cb(lv_obj_t * obj, uint32_t row, uint32_t col, char * buf, uint32_t buf_size)
+{
+    if(col == 0) lv_snprintf(buf, buf_size, "%02u/%02u", (unsigned)(row % 12 + 1), (unsigned)(row % 28 + 1));
+    else if(col == 1) lv_snprintf(buf, buf_size, "Merchant %u", (unsigned)row);
+    else lv_snprintf(buf, buf_size, "-$%u.%02u", (unsigned)(row * 37 % 500), (unsigned)(row * 13 % 100));
+    return buf;
+}
+
+static void pages_create(void)
+{
+    chrome_create();
+    lv_obj_remove_flag(nav_bar, LV_OBJ_FLAG_HIDDEN);
+    home_page_create();
+    accounts_page_create();
+    for(uint32_t i = 1; i <= 4; i++) {
+        lv_table_set_row_count(checking_table, i + 1);
+        lv_table_set_cell_value_fmt(checking_table, i, 0, "Bank %u", (unsigned)i);
+        lv_table_set_cell_value(checking_table, i, 1, "$1,234.00");
+    }
+    lv_table_set_row_count(credit_table, 2);
+    lv_table_set_cell_value(credit_table, 1, 0, "Card");
+    lv_table_set_cell_value(credit_table, 1, 1, "$42.00");
+    transactions_page_create();
+    lv_table_set_cell_data_cb(transactions_table, transaction_cell_cb);
+    lv_table_set_row_count(transactions_table, 200);
+}
+
+typedef struct {
+    uint64_t ns;
+    uint32_t frames;
+    uint32_t px;
+    uint32_t transfers;
+} scene_t;
+
+/** Run the timers once after `ms` and add what it cost to `scene` */
+static void frame(scene_t * scene, uint32_t ms)
+{
+    uint32_t px = flush_px;
+    uint32_t transfers = flush_transfers;
+    uint64_t t0 = host_ns();
+    host_advance(ms);
+    scene->ns += host_ns() - t0;
+    scene->frames++;
+    scene->px += flush_px - px;
+    scene->transfers += flush_transfers - transfers;
+}
+
+static void print_scene(const char * mode, const char * name, const scene_t * scene, uint32_t cnt, const char * per)
+{
+    printf("%-15s %-12s %7.1f us, %6u px, %4.1f transfers, SPI %5.2f ms per %s\n", mode, name,
+           scene->ns / 1e3 / cnt, (unsigned)(scene->px / cnt), (double)scene->transfers / cnt,
+           scene->px * 16.0 * 1e3 / SPI_HZ / cnt, per);
+}
+
+static void run(const char * mode, bool direct_mode, bool page_cache_on)
+{
+    static uint32_t ref_hash[SWITCHES + SCROLLS];
+    static bool ref_set;
+    uint32_t mismatches = 0;
+
+    direct = direct_mode;
+    if(direct) lv_display_set_buffers(disp, host_frame, NULL, sizeof(host_frame), LV_DISPLAY_RENDER_MODE_DIRECT);
+    else lv_display_set_buffers(disp, buffer, buffer2, sizeof(buffer), LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    lv_page_cache_t * page_cache = NULL;
+    if(page_cache_on) {
+        page_cache = lv_page_cache_create(disp, page_cache_buf, sizeof(page_cache_buf));
+        lv_page_cache_add_page(page_cache, home_page);
+        lv_page_cache_add_page(page_cache, accounts_page);
+        lv_page_cache_add_page(page_cache, transactions_page);
+    }
+
+    lv_obj_scroll_to_y(transactions_table, 0, LV_ANIM_OFF);
+    lv_screen_load(home_page);
+    lv_obj_invalidate(home_page);
+    for(uint32_t i = 0; i < IDLE_TIME / FRAME_TIME; i++) host_advance(FRAME_TIME);
+
+    /*Page switches, the idle time after them is counted apart*/
+    lv_obj_t * pages[] = {home_page, accounts_page, transactions_page};
+    scene_t load = {0};
+    scene_t idle = {0};
+    for(uint32_t i = 0; i < SWITCHES; i++) {
+        lv_screen_load(pages[(i + 1) % 3]);
+        frame(&load, FRAME_TIME);
+        if(!ref_set) ref_hash[i] = host_frame_hash();
+        else if(host_frame_hash() != ref_hash[i]) mismatches++;
+        for(uint32_t t = FRAME_TIME; t < IDLE_TIME; t += FRAME_TIME) frame(&idle, FRAME_TIME);
+    }
+
+    /*Scroll down and back up in steps of the scroll buttons, the frames of an animation are counted together*/
+    lv_screen_load(transactions_page);
+    for(uint32_t i = 0; i < IDLE_TIME / FRAME_TIME; i++) host_advance(FRAME_TIME);
+    scene_t scroll = {0};
+    for(uint32_t i = 0; i < SCROLLS; i++) {
+        lv_obj_scroll_by_bounded(transactions_table, 0, i < SCROLLS / 2 ? -80 : 80, LV_ANIM_ON);
+        do {
+            frame(&scroll, FRAME_TIME);
+        } while(lv_anim_count_running());
+        if(!ref_set) ref_hash[SWITCHES + i] = host_frame_hash();
+        else if(host_frame_hash() != ref_hash[SWITCHES + i]) mismatches++;
+    }
+    ref_set = true;
+
+    print_scene(mode, "page switch", &load, SWITCHES, "switch");
+    print_scene(mode, "idle", &idle, SWITCHES, "switch");
+    print_scene(mode, "scroll", &scroll, scroll.frames, "frame");
+    printf("%-15s %u frames of %u differ from the first mode's\n", mode, (unsigned)mismatches,
+           (unsigned)(SWITCHES + SCROLLS));
+
+    if(page_cache) lv_page_cache_delete(page_cache);
+}
+
+int main(void)
+{
+    disp = host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush_cb);
+    pages_create();
+
+    printf("partial: 2 x %u B buffers, direct: %u B frame and the same 2 bounce buffers\n",
+           (unsigned)sizeof(buffer), (unsigned)sizeof(host_frame));
+    run("partial+cache", false, true);
+    run("partial", false, false);
+    run("direct", true, false);
+    run("direct+cache", true, true);
+    return 0;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file draw_task_bench.c
+ * Adding and dispatching the draw tasks of a table with 4 draw units, at several table sizes.
+ * Every cell has a background, a border and a label, on top of the table's background.
+ * The draw units are fake: they take a task in one dispatch round and finish it in the next one,
+ * so the time is only the bookkeeping of the tasks. Prints the time per frame of adding the
+ * tasks and of dispatching them, and the dispatch rounds.
+ * The tasks and their descriptors are in the firmware's 64 KB LVGL heap, so the tables stop at
+ * about 200 tasks.
+ *
+ * It's built twice: `draw_task_bench` with the draw task index (`LV_DRAW_TASK_INDEX 1`) and
+ * `draw_task_bench_scan` with the firmware's configuration, where it's off (one draw unit) and
+ * the units compare each task with the older ones.
+ * Both check that overlapping tasks never run at the same time and the older one finishes first.
+ */
+
+#include "host.h"
+#include "src/draw/lv_draw_private.h"
+#include "src/core/lv_global.h"
+#include "src/misc/lv_area_private.h"
+
+#define UNIT_CNT        4
+#define TASK_MAX        256
+#define FRAMES          500
+
+typedef struct {
+    lv_draw_unit_t base;
+    lv_draw_task_t * task_act;
+    uint32_t task_id;
+} fake_unit_t;
+
+static uint32_t round_cnt;
+static uint32_t step_cnt;       /*Counts the starts and ends of the tasks, to order them*/
+static uint32_t task_cnt;
+static lv_area_t task_areas[TASK_MAX];
+static uint32_t task_start[TASK_MAX];
+static uint32_t task_end[TASK_MAX];
+
+static uint32_t get_task_id(lv_draw_task_t * t)
+{
+    return (uint32_t)(uintptr_t)((lv_draw_dsc_base_t *)t->draw_dsc)->user_data;
+}
+
+/** Finish the task taken in the previous round, or take a new one */
+static int32_t fake_dispatch_cb(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
+{
+    fake_unit_t * u = (fake_unit_t *)draw_unit;
+    if(u->task_act) {
+        u->task_act->state = LV_DRAW_TASK_STATE_READY;
+        task_end[u->task_id] = step_cnt++;
+        u->task_act = NULL;
+        return 0;
+    }
+
+    lv_draw_task_t * t = lv_draw_get_next_available_task(layer, NULL, LV_DRAW_UNIT_NONE);
+    if(t == NULL) return LV_DRAW_UNIT_IDLE;
+
+    t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+    u->task_act = t;
+    u->task_id = get_task_id(t);
+    task_start[u->task_id] = step_cnt++;
+    return 1;
+}
+
+static void add_task(lv_layer_t * layer, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    lv_area_t a = {x1, y1, x2, y2};
+    lv_draw_task_t * t = lv_draw_add_task(layer, &a);
+    lv_draw_fill_dsc_t * dsc = lv_malloc_zeroed(sizeof(lv_draw_fill_dsc_t));
+    dsc->base.user_data = (void *)(uintptr_t)task_cnt;
+    task_areas[task_cnt++] = a;
+    t->draw_dsc = dsc;
+    t->type = LV_DRAW_TASK_TYPE_FILL;
+    lv_draw_finalize_task_creation(layer, t);
+}
+
+static void add_table(lv_layer_t * layer, int32_t rows, int32_t cols)
+{
+    int32_t cell_w = HOST_HOR_RES / cols;
+    int32_t cell_h = HOST_VER_RES / rows;
+    add_task(layer, 0, 0, HOST_HOR_RES - 1, HOST_VER_RES - 1);
+    for(int32_t row = 0; row < rows; row++) {
+        for(int32_t col = 0; col < cols; col++) {
+            int32_t x = col * cell_w;
+            int32_t y = row * cell_h;
+            add_task(layer, x + 1, y + 1, x + cell_w - 2, y + cell_h - 2);
+            add_task(layer, x, y, x + cell_w - 1, y + cell_h - 1);
+            add_task(layer, x + 3, y + 3, x + cell_w - 4, y + cell_h / 2);
+        }
+    }
+}
+
+/** Overlapping tasks must not run at the same time and the older one must finish first */
+static bool check_order(void)
+{
+    for(uint32_t i = 0; i < task_cnt; i++) {
+        for(uint32_t j = i + 1; j < task_cnt; j++) {
+            lv_area_t common;
+            if(lv_area_intersect(&common, &task_areas[i], &task_areas[j]) && task_start[j] < task_end[i]) {
+                printf("task %u started before the older task %u overlapping it finished\n", (unsigned)j, (unsigned)i);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool run(int32_t rows, int32_t cols)
+{
+    lv_draw_global_info_t * info = &LV_GLOBAL_DEFAULT()->draw_info;
+    uint64_t add_ns = 0;
+    uint64_t dispatch_ns = 0;
+    uint32_t rounds = 0;
+    bool ok = true;
+
+    for(uint32_t f = 0; f < FRAMES; f++) {
+        lv_layer_t * layer = lv_malloc_zeroed(sizeof(lv_layer_t));
+        lv_area_t full = {0, 0, HOST_HOR_RES - 1, HOST_VER_RES - 1};
+        layer->buf_area = full;
+        layer->phy_clip_area = full;
+        layer->_clip_area = full;
+        task_cnt = 0;
+        round_cnt = 0;
+        step_cnt = 0;
+
+        /*Only queue the tasks while they are added*/
+        info->task_running = true;
+        uint64_t t0 = host_ns();
+        add_table(layer, rows, cols);
+        uint64_t t1 = host_ns();
+        info->task_running = false;
+        while(layer->draw_task_head) {
+            round_cnt++;
+            lv_draw_dispatch_layer(NULL, layer);
+        }
+        uint64_t t2 = host_ns();
+
+        add_ns += t1 - t0;
+        dispatch_ns += t2 - t1;
+        rounds += round_cnt;
+        if(f == 0) ok = check_order();
+        lv_free(layer);
+    }
+
+    printf("%5u tasks: add %8.1f us, dispatch %8.1f us, %4u rounds per frame\n", (unsigned)task_cnt,
+           add_ns / 1e3 / FRAMES, dispatch_ns / 1e3 / FRAMES, (unsigned)(rounds / FRAMES));
+    return ok;
+}
+
+int main(void)
+{
+    host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    /*Replace the software draw unit with the fake ones*/
+    lv_draw_global_info_t * info = &LV_GLOBAL_DEFAULT()->draw_info;
+    info->unit_head = NULL;
+    info->unit_cnt = 0;
+    for(uint32_t i = 0; i < UNIT_CNT; i++) {
+        fake_unit_t * u = lv_draw_create_unit(sizeof(fake_unit_t));
+        u->base.dispatch_cb = fake_dispatch_cb;
+        u->base.name = "FAKE";
+    }
+
+    printf("%u draw units, draw task index %s\n", (unsigned)UNIT_CNT, LV_DRAW_TASK_INDEX ? "on" : "off");
+    static const int32_t sizes[][2] = {{2, 2}, {4, 4}, {6, 6}, {7, 7}, {8, 8}};
+    bool ok = true;
+    for(uint32_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        if(!run(sizes[i][0], sizes[i][1])) ok = false;
+    }
+    return ok ? 0 : 1;
+}
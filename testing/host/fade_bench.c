@@ -0,0 +1,127 @@
+/**
+ * @file fade_bench.c
+ * 300 ms layered fades between the app's pages, with the firmware's 64 KB LVGL heap: the incoming page
+ * animates `opa_layered`, so it's drawn into simple layers in chunks and blended over the old page.
+ * Runs in partial mode (the firmware's default) and in direct mode. Prints the time per fade frame,
+ * the draw buffers allocated per frame, the pool of layer buffers' hits and misses per frame
+ * (zero while LV_DRAW_LAYER_BUF_POOL_SIZE is 0), the heap's peak and the heap used after the fades.
+ */
+
+#include "host.h"
+#include "src/core/lv_global.h"
+#include "src/draw/lv_draw_buf_private.h"
+
+/*The generated UI is compiled into this translation unit too*/
+#include "../../main/ui_styles_gen.c"
+#include "../../main/ui_screens_gen.c"
+
+#define FADES           12
+#define FADE_TIME       300
+#define FRAME_TIME      33
+#define FADE_FRAMES     (FADE_TIME / FRAME_TIME + 1)
+
+static lv_display_t * disp;
+static lv_draw_buf_malloc_cb buf_malloc_orig;
+static uint32_t buf_alloc_cnt;
+
+/** Count the draw buffers allocated with the default handlers, the layers' ones among them */
+static void * count_buf_malloc_cb(size_t size, lv_color_format_t color_format)
+{
+    buf_alloc_cnt++;
+    return buf_malloc_orig(size, color_format);
+}
+
+static const char * transaction_cell_cb(lv_obj_t * obj, uint32_t row, uint32_t col, char * buf, uint32_t buf_size)
+{
+    if(col == 0) lv_snprintf(buf, buf_size, "%02u/%02u", (unsigned)(row % 12 + 1), (unsigned)(row % 28 + 1));
+    else if(col == 1) lv_snprintf(buf, buf_size, "Merchant %u", (unsigned)row);
+    else lv_snprintf(buf, buf_size, "-$%u.%02u", (unsigned)(row * 37 % 500), (unsigned)(row * 13 % 100));
+    return buf;
+}
+
+static void opa_layered_anim_cb(void * obj, int32_t v)
+{
+    lv_obj_set_style_opa_layered(obj, v, 0);
+}
+
+static void pages_create(void)
+{
+    chrome_create();
+    lv_obj_remove_flag(nav_bar, LV_OBJ_FLAG_HIDDEN);
+    home_page_create();
+    accounts_page_create();
+    for(uint32_t i = 1; i <= 4; i++) {
+        lv_table_set_row_count(checking_table, i + 1);
+        lv_table_set_cell_value_fmt(checking_table, i, 0, "Bank %u", (unsigned)i);
+        lv_table_set_cell_value(checking_table, i, 1, "$1,234.00");
+    }
+    lv_table_set_row_count(credit_table, 2);
+    lv_table_set_cell_value(credit_table, 1, 0, "Card");
+    lv_table_set_cell_value(credit_table, 1, 1, "$42.00");
+    transactions_page_create();
+    lv_table_set_cell_data_cb(transactions_table, transaction_cell_cb);
+    lv_table_set_row_count(transactions_table, 200);
+}
+
+static void run(const char * mode)
+{
+    lv_obj_t * pages[] = {home_page, accounts_page, transactions_page};
+    uint64_t t = 0;
+    uint32_t frames = 0;
+    uint32_t allocs = 0;
+    uint32_t incomplete = 0;
+    lv_cache_stats_t pool_before, pool_after;
+    lv_draw_buf_pool_get_stats(&pool_before);
+    lv_mem_monitor_t mon;
+
+    for(uint32_t i = 0; i < FADES; i++) {
+        lv_obj_t * page = pages[(i + 1) % 3];
+        lv_obj_set_style_opa_layered(page, LV_OPA_TRANSP, 0);
+        lv_screen_load(page);
+
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, page);
+        lv_anim_set_exec_cb(&a, opa_layered_anim_cb);
+        lv_anim_set_values(&a, LV_OPA_TRANSP, LV_OPA_COVER);
+        lv_anim_set_duration(&a, FADE_TIME);
+        lv_anim_start(&a);
+
+        for(uint32_t f = 0; f < FADE_FRAMES; f++) {
+            uint32_t alloc_start = buf_alloc_cnt;
+            uint64_t t0 = host_ns();
+            host_advance(FRAME_TIME);
+            t += host_ns() - t0;
+            allocs += buf_alloc_cnt - alloc_start;
+            frames++;
+        }
+        if(lv_obj_get_style_opa_layered(page, 0) != LV_OPA_COVER) incomplete++;
+        host_advance(FRAME_TIME);
+    }
+
+    lv_draw_buf_pool_get_stats(&pool_after);
+    lv_mem_monitor(&mon);
+    printf("%-8s %7.1f us/frame, %4.1f draw bufs/frame, pool %4.1f hits %4.1f misses/frame, "
+           "heap peak %5u, after %5u, %u of %u fades incomplete\n", mode, t / 1e3 / frames,
+           (double)allocs / frames, (double)(pool_after.hits - pool_before.hits) / frames,
+           (double)(pool_after.misses - pool_before.misses) / frames, (unsigned)mon.max_used,
+           (unsigned)(mon.total_size - mon.free_size), (unsigned)incomplete, (unsigned)FADES);
+}
+
+int main(void)
+{
+    disp = host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+    buf_malloc_orig = LV_GLOBAL_DEFAULT()->draw_buf_handlers.buf_malloc_cb;
+    LV_GLOBAL_DEFAULT()->draw_buf_handlers.buf_malloc_cb = count_buf_malloc_cb;
+
+    pages_create();
+    lv_screen_load(home_page);
+    for(uint32_t i = 0; i < 20; i++) host_advance(10);
+    run("partial");
+
+    lv_display_set_buffers(disp, host_frame, NULL, sizeof(host_frame), LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_obj_invalidate(lv_screen_active());
+    host_advance(FRAME_TIME);
+    run("direct");
+    return 0;
+}
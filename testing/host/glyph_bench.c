@@ -0,0 +1,74 @@
+/**
+ * @file glyph_bench.c
+ * Drawing lines of text with the app's fonts into an RGB565 canvas, the letters blended from the packed
+ * bitmap of the font and through the A8 path (the glyph unpacked to an A8 buffer first, which the font
+ * forces with a `get_glyph_bitmap` only wrapping `lv_font_get_bitmap_fmt_txt`).
+ * Prints the best time of several runs per character.
+ */
+
+#include "host.h"
+
+#define CANVAS_W    HOST_HOR_RES
+#define CANVAS_H    HOST_VER_RES
+#define LINES       10
+#define RUNS        30
+
+LV_DRAW_BUF_DEFINE_STATIC(canvas_buf, CANVAS_W, CANVAS_H, LV_COLOR_FORMAT_RGB565);
+
+static lv_obj_t * canvas;
+
+static const char * text = "Credit Balance $1,234.56 Coffee -4.50 Rent -1200.00 Salary +3400.00 @#%&*()[]{} gjpqy";
+
+static const void * a8_get_bitmap_cb(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf)
+{
+    return lv_font_get_bitmap_fmt_txt(g_dsc, draw_buf);
+}
+
+static void run(const char * name, const lv_font_t * font)
+{
+    uint64_t best = UINT64_MAX;
+    uint32_t chars = LINES * lv_strlen(text);
+    int32_t line_h = lv_font_get_line_height(font);
+    for(uint32_t r = 0; r < RUNS; r++) {
+        lv_memzero(canvas_buf.data, canvas_buf.data_size);
+        lv_layer_t layer;
+        lv_canvas_init_layer(canvas, &layer);
+        uint64_t t0 = host_ns();
+        for(int32_t i = 0; i < LINES; i++) {
+            lv_draw_label_dsc_t dsc;
+            lv_draw_label_dsc_init(&dsc);
+            dsc.font = font;
+            dsc.color = lv_color_white();
+            dsc.text = text;
+            /*Wider than the canvas so no line wraps, the letters outside of it are clipped*/
+            lv_area_t coords = {0, i * line_h, CANVAS_W * 4, i * line_h + line_h - 1};
+            lv_draw_label(&layer, &dsc, &coords);
+        }
+        lv_canvas_finish_layer(canvas, &layer);
+        uint64_t t = host_ns() - t0;
+        if(t < best) best = t;
+    }
+    printf("%-22s %5u chars in %7.1f us, %5.0f ns/char\n", name, (unsigned)chars, best / 1e3,
+           (double)best / chars);
+}
+
+int main(void)
+{
+    host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+    LV_DRAW_BUF_INIT_STATIC(canvas_buf);
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, &canvas_buf);
+
+    static lv_font_t a8_14;
+    static lv_font_t a8_20;
+    a8_14 = lv_font_montserrat_14;
+    a8_14.get_glyph_bitmap = a8_get_bitmap_cb;
+    a8_20 = lv_font_montserrat_20;
+    a8_20.get_glyph_bitmap = a8_get_bitmap_cb;
+
+    run("montserrat_14 packed", &lv_font_montserrat_14);
+    run("montserrat_14 A8", &a8_14);
+    run("montserrat_20 packed", &lv_font_montserrat_20);
+    run("montserrat_20 A8", &a8_20);
+    return 0;
+}
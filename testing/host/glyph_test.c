@@ -0,0 +1,128 @@
+/**
+ * @file glyph_test.c
+ * Checks that letters drawn from the packed bitmap of the fonts into an RGB565 layer are bit-exact
+ * with the A8 path (the glyph unpacked to an A8 buffer and blended with `lv_draw_sw_blend`).
+ * Every font is used twice with the same descriptor: as it is, and with a `get_glyph_bitmap` that only
+ * wraps `lv_font_get_bitmap_fmt_txt`, so it has no packed bitmap and the A8 path draws it.
+ * The same random labels are drawn with both into a canvas and the pixels must be equal:
+ * - the app's Montserrat fonts (4 bpp, plain)
+ * - their bitmaps read as 1 and 2 bpp and with aligned rows, to cover the other depths and layouts
+ * - opacities 255, 254, 200, 128 and 40, colors and positions partly outside of the canvas
+ * - random clip areas, over a noisy background
+ */
+
+#include "host.h"
+
+#define CANVAS_W    HOST_HOR_RES
+#define CANVAS_H    HOST_VER_RES
+#define ROUNDS      300
+#define LABELS      8
+#define FONT_MAX    16
+
+LV_DRAW_BUF_DEFINE_STATIC(canvas_buf, CANVAS_W, CANVAS_H, LV_COLOR_FORMAT_RGB565);
+
+static lv_obj_t * canvas;
+static uint16_t packed_px[CANVAS_W * CANVAS_H];
+static lv_font_t packed_fonts[FONT_MAX];
+static lv_font_t a8_fonts[FONT_MAX];
+static lv_font_fmt_txt_dsc_t dscs[FONT_MAX];
+static uint32_t font_cnt;
+static uint32_t rnd_state;
+
+static const char * text = "Credit Balance $1,234.56 Coffee -4.50 Rent -1200.00 Salary +3400.00 @#%&*()[]{} gjpqy";
+
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return rnd_state >> 8;
+}
+
+/** The same bitmap as the font's, but the packed path doesn't recognize the font */
+static const void * a8_get_bitmap_cb(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf)
+{
+    return lv_font_get_bitmap_fmt_txt(g_dsc, draw_buf);
+}
+
+static void font_add(const lv_font_t * font, uint8_t bpp, lv_font_fmt_txt_bitmap_format_t format)
+{
+    dscs[font_cnt] = *(const lv_font_fmt_txt_dsc_t *)font->dsc;
+    dscs[font_cnt].bpp = bpp;
+    dscs[font_cnt].bitmap_format = format;
+    packed_fonts[font_cnt] = *font;
+    packed_fonts[font_cnt].dsc = &dscs[font_cnt];
+    a8_fonts[font_cnt] = packed_fonts[font_cnt];
+    a8_fonts[font_cnt].get_glyph_bitmap = a8_get_bitmap_cb;
+    font_cnt++;
+}
+
+/** Draw random labels with the packed or the A8 fonts, the same ones for the same seed */
+static void draw_round(uint32_t seed, const lv_font_t * fonts)
+{
+    static const lv_opa_t opas[] = {LV_OPA_COVER, 254, 200, 128, 40};
+
+    rnd_state = seed;
+    uint16_t * px = (uint16_t *)canvas_buf.data;
+    for(uint32_t i = 0; i < CANVAS_W * CANVAS_H; i++) px[i] = rnd();
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    for(uint32_t i = 0; i < LABELS; i++) {
+        lv_draw_label_dsc_t dsc;
+        lv_draw_label_dsc_init(&dsc);
+        dsc.font = &fonts[rnd() % font_cnt];
+        dsc.color = lv_color_hex(rnd());
+        dsc.opa = opas[rnd() % 5];
+        dsc.text = text;
+
+        lv_area_t coords;
+        coords.x1 = (int32_t)(rnd() % 300) - 40;
+        coords.y1 = (int32_t)(rnd() % 260) - 20;
+        coords.x2 = coords.x1 + 80 + rnd() % 300;
+        coords.y2 = coords.y1 + 20 + rnd() % 100;
+
+        lv_area_t clip;
+        clip.x1 = rnd() % CANVAS_W;
+        clip.y1 = rnd() % CANVAS_H;
+        clip.x2 = clip.x1 + rnd() % CANVAS_W;
+        clip.y2 = clip.y1 + rnd() % CANVAS_H;
+        if(clip.x2 >= CANVAS_W) clip.x2 = CANVAS_W - 1;
+        if(clip.y2 >= CANVAS_H) clip.y2 = CANVAS_H - 1;
+        if(rnd() % 3 == 0) lv_area_set(&clip, 0, 0, CANVAS_W - 1, CANVAS_H - 1);
+        layer._clip_area = clip;
+
+        lv_draw_label(&layer, &dsc, &coords);
+    }
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+int main(void)
+{
+    host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+    LV_DRAW_BUF_INIT_STATIC(canvas_buf);
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, &canvas_buf);
+
+    const lv_font_t * app_fonts[] = {&lv_font_montserrat_14, &lv_font_montserrat_16, &lv_font_montserrat_18,
+                                     &lv_font_montserrat_20, &lv_font_montserrat_22, &lv_font_montserrat_24
+                                    };
+    for(uint32_t i = 0; i < 6; i++) font_add(app_fonts[i], 4, LV_FONT_FMT_TXT_PLAIN);
+    font_add(app_fonts[0], 1, LV_FONT_FMT_TXT_PLAIN);
+    font_add(app_fonts[3], 1, LV_FONT_FMT_PLAIN_ALIGNED);
+    font_add(app_fonts[1], 2, LV_FONT_FMT_TXT_PLAIN);
+    font_add(app_fonts[5], 2, LV_FONT_FMT_PLAIN_ALIGNED);
+    font_add(app_fonts[2], 4, LV_FONT_FMT_PLAIN_ALIGNED);
+
+    for(uint32_t r = 0; r < ROUNDS; r++) {
+        uint32_t seed = r * 7919 + 1;
+        draw_round(seed, packed_fonts);
+        lv_memcpy(packed_px, canvas_buf.data, sizeof(packed_px));
+        draw_round(seed, a8_fonts);
+
+        const uint16_t * a8_px = (const uint16_t *)canvas_buf.data;
+        uint32_t diff = 0;
+        for(uint32_t i = 0; i < CANVAS_W * CANVAS_H; i++) diff += packed_px[i] != a8_px[i];
+        HOST_CHECK(diff == 0, "round %u: %u px of the packed path differ from the A8 path", (unsigned)r, (unsigned)diff);
+    }
+
+    return host_finish("glyph_test");
+}
@@ -0,0 +1,177 @@
+/**
+ * @file gradient_cache_bench.c
+ * Four rounded cards with vertical and horizontal gradients refreshed in stripes of 20 rows, and random
+ * gradient rectangles and triangles on a canvas, with the cache of gradient color maps
+ * (LV_DRAW_SW_GRADIENT_CACHE_SIZE) and with it detached, when every map is calculated again like without
+ * the cache. Prints the best time of several runs per frame and per canvas, and the hits, misses,
+ * evictions and size of the cache.
+ */
+
+#include "host.h"
+#include "src/core/lv_global.h"
+#include "src/draw/sw/lv_draw_sw_gradient.h"
+#include "src/draw/lv_draw_triangle_private.h"
+
+#define CANVAS_W    HOST_HOR_RES
+#define CANVAS_H    HOST_VER_RES
+#define RUNS        50
+#define ROUNDS      100
+#define SHAPES      6
+
+LV_DRAW_BUF_DEFINE_STATIC(canvas_buf, CANVAS_W, CANVAS_H, LV_COLOR_FORMAT_RGB565);
+
+static lv_display_t * disp;
+static lv_obj_t * canvas;
+static lv_cache_t * grad_cache;
+static uint32_t rnd_state;
+
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return rnd_state >> 8;
+}
+
+static void grad_cache_attach(bool attach)
+{
+    LV_GLOBAL_DEFAULT()->sw_grad_cache = attach ? grad_cache : NULL;
+}
+
+static void print_stats(const lv_cache_stats_t * before)
+{
+    lv_cache_stats_t s;
+    lv_gradient_cache_get_stats(&s);
+    uint32_t hits = s.hits - before->hits;
+    uint32_t misses = s.misses - before->misses;
+    printf("  cache: %u hits, %u misses, %u evictions, %.1f %% hits, %u of %u bytes\n", (unsigned)hits,
+           (unsigned)misses, (unsigned)(s.evictions - before->evictions), hits + misses ? hits * 100.0 / (hits + misses) : 0.0,
+           (unsigned)s.size, (unsigned)s.max_size);
+}
+
+/** The same cards as in gradient_cache_test */
+static void cards_create(void)
+{
+    static const uint32_t colors[4][2] = {{0x1e3a8a, 0x3b82f6}, {0x065f46, 0x10b981}, {0x7c2d12, 0xf97316}, {0x312e81, 0xa855f7}};
+
+    lv_obj_t * screen = lv_screen_active();
+    lv_obj_set_style_bg_color(screen, lv_color_hex(0x101018), 0);
+    for(uint32_t i = 0; i < 4; i++) {
+        lv_obj_t * card = lv_obj_create(screen);
+        lv_obj_remove_style_all(card);
+        lv_obj_set_pos(card, 10, 8 + i * 58);
+        lv_obj_set_size(card, i < 3 ? 140 + i * 40 : 110, 50);
+        lv_obj_set_style_radius(card, 10, 0);
+        lv_obj_set_style_bg_opa(card, LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(card, lv_color_hex(colors[i][0]), 0);
+        lv_obj_set_style_bg_grad_color(card, lv_color_hex(colors[i][1]), 0);
+        lv_obj_set_style_bg_grad_dir(card, i < 3 ? LV_GRAD_DIR_VER : LV_GRAD_DIR_HOR, 0);
+        lv_obj_t * label = lv_label_create(card);
+        lv_label_set_text_fmt(label, "Balance $%u,%03u.00", (unsigned)(1 + i), (unsigned)(i * 137));
+        lv_obj_set_style_text_color(label, lv_color_white(), 0);
+        lv_obj_set_pos(label, 10, 16);
+    }
+}
+
+static void run_cards(bool cached)
+{
+    lv_cache_stats_t before;
+    lv_gradient_cache_get_stats(&before);
+    grad_cache_attach(cached);
+    uint64_t best = UINT64_MAX;
+    for(uint32_t r = 0; r < RUNS; r++) {
+        lv_obj_invalidate(lv_screen_active());
+        uint64_t t0 = host_ns();
+        lv_refr_now(disp);
+        uint64_t t = host_ns() - t0;
+        if(t < best) best = t;
+    }
+    grad_cache_attach(true);
+    printf("cards, %-20s %7.1f us/frame\n", cached ? "cached" : "not cached", best / 1e3);
+    if(cached) print_stats(&before);
+}
+
+/** Random gradient shapes like in gradient_cache_test */
+static void draw_round(void)
+{
+    static const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_COVER, 254, 200, 128, 40};
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    for(uint32_t i = 0; i < SHAPES; i++) {
+        lv_grad_dsc_t grad;
+        lv_memzero(&grad, sizeof(grad));
+        grad.dir = rnd() % 2 ? LV_GRAD_DIR_VER : LV_GRAD_DIR_HOR;
+        grad.stops_count = 2;
+        for(uint32_t s = 0; s < 2; s++) {
+            grad.stops[s].color = lv_color_hex(rnd());
+            grad.stops[s].opa = opas[rnd() % 6];
+            grad.stops[s].frac = s == 0 ? rnd() % 100 : 155 + rnd() % 101;
+        }
+
+        lv_area_t coords;
+        coords.x1 = (int32_t)(rnd() % 300) - 20;
+        coords.y1 = (int32_t)(rnd() % 220) - 20;
+        coords.x2 = coords.x1 + 1 + rnd() % 150;
+        coords.y2 = coords.y1 + 1 + rnd() % 100;
+
+        if(rnd() % 4) {
+            lv_draw_rect_dsc_t dsc;
+            lv_draw_rect_dsc_init(&dsc);
+            dsc.radius = rnd() % 3 ? rnd() % 20 : 0;
+            dsc.bg_opa = opas[rnd() % 6];
+            dsc.bg_grad = grad;
+            lv_draw_rect(&layer, &dsc, &coords);
+        }
+        else {
+            lv_draw_triangle_dsc_t dsc;
+            lv_draw_triangle_dsc_init(&dsc);
+            dsc.bg_grad = grad;
+            dsc.bg_opa = opas[rnd() % 6];
+            dsc.p[0].x = coords.x1;
+            dsc.p[0].y = coords.y1;
+            dsc.p[1].x = coords.x2;
+            dsc.p[1].y = coords.y1 + lv_area_get_height(&coords) / 3;
+            dsc.p[2].x = coords.x1 + lv_area_get_width(&coords) / 2;
+            dsc.p[2].y = coords.y2;
+            lv_draw_triangle(&layer, &dsc);
+        }
+    }
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+static void run_canvas(bool cached)
+{
+    lv_cache_stats_t before;
+    lv_gradient_cache_get_stats(&before);
+    grad_cache_attach(cached);
+    uint64_t best = UINT64_MAX;
+    for(uint32_t r = 0; r < RUNS / 5; r++) {
+        rnd_state = 1;
+        uint64_t t0 = host_ns();
+        for(uint32_t i = 0; i < ROUNDS; i++) draw_round();
+        uint64_t t = host_ns() - t0;
+        if(t < best) best = t;
+    }
+    grad_cache_attach(true);
+    printf("random shapes, %-12s %7.1f us/canvas\n", cached ? "cached" : "not cached", best / 1e3 / ROUNDS);
+    if(cached) print_stats(&before);
+}
+
+int main(void)
+{
+    disp = host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+    grad_cache = LV_GLOBAL_DEFAULT()->sw_grad_cache;
+
+    cards_create();
+    lv_refr_now(disp);
+    run_cards(false);
+    run_cards(true);
+
+    LV_DRAW_BUF_INIT_STATIC(canvas_buf);
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+    lv_canvas_set_draw_buf(canvas, &canvas_buf);
+    lv_memzero(canvas_buf.data, canvas_buf.data_size);
+    run_canvas(false);
+    run_canvas(true);
+    return 0;
+}
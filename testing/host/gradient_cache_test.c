@@ -0,0 +1,175 @@
+/**
+ * @file gradient_cache_test.c
+ * Checks of the cache of gradient color maps (LV_DRAW_SW_GRADIENT_CACHE_SIZE).
+ * Everything is drawn twice, with the cache and with it detached, when every map is calculated
+ * again like without the cache. The pixels must be equal:
+ * - four rounded cards with vertical and horizontal gradients, refreshed in stripes of 20 rows
+ * - random gradient rectangles and triangles on a canvas over a noisy background: random stops,
+ *   directions, radii and opacities 255, 254, 200, 128 and 40, partly outside of the canvas and
+ *   with random clip areas
+ * The cache must also be hit by the cards of the next frames.
+ */
+
+#include "host.h"
+#include "src/core/lv_global.h"
+#include "src/draw/sw/lv_draw_sw_gradient.h"
+#include "src/draw/lv_draw_triangle_private.h"
+
+#define CANVAS_W    HOST_HOR_RES
+#define CANVAS_H    HOST_VER_RES
+#define ROUNDS      300
+#define SHAPES      6
+
+LV_DRAW_BUF_DEFINE_STATIC(canvas_buf, CANVAS_W, CANVAS_H, LV_COLOR_FORMAT_RGB565);
+
+static lv_display_t * disp;
+static lv_obj_t * canvas;
+static lv_cache_t * grad_cache;
+static uint16_t cached_px[CANVAS_W * CANVAS_H];
+static uint32_t rnd_state;
+
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return rnd_state >> 8;
+}
+
+/** Without the cache every map is calculated for each draw task, like with LV_DRAW_SW_GRADIENT_CACHE_SIZE 0 */
+static void grad_cache_attach(bool attach)
+{
+    LV_GLOBAL_DEFAULT()->sw_grad_cache = attach ? grad_cache : NULL;
+}
+
+static void cards_create(void)
+{
+    static const uint32_t colors[4][2] = {{0x1e3a8a, 0x3b82f6}, {0x065f46, 0x10b981}, {0x7c2d12, 0xf97316}, {0x312e81, 0xa855f7}};
+
+    lv_obj_t * screen = lv_screen_active();
+    lv_obj_set_style_bg_color(screen, lv_color_hex(0x101018), 0);
+    for(uint32_t i = 0; i < 4; i++) {
+        lv_obj_t * card = lv_obj_create(screen);
+        lv_obj_remove_style_all(card);
+        lv_obj_set_pos(card, 10, 8 + i * 58);
+        lv_obj_set_size(card, i < 3 ? 140 + i * 40 : 110, 50);
+        lv_obj_set_style_radius(card, 10, 0);
+        lv_obj_set_style_bg_opa(card, LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(card, lv_color_hex(colors[i][0]), 0);
+        lv_obj_set_style_bg_grad_color(card, lv_color_hex(colors[i][1]), 0);
+        lv_obj_set_style_bg_grad_dir(card, i < 3 ? LV_GRAD_DIR_VER : LV_GRAD_DIR_HOR, 0);
+        lv_obj_t * label = lv_label_create(card);
+        lv_label_set_text_fmt(label, "Balance $%u,%03u.00", (unsigned)(1 + i), (unsigned)(i * 137));
+        lv_obj_set_style_text_color(label, lv_color_white(), 0);
+        lv_obj_set_pos(label, 10, 16);
+    }
+}
+
+static uint32_t cards_frame_hash(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+    return host_frame_hash();
+}
+
+/** Draw random gradient rectangles and triangles, the same ones for the same seed */
+static void draw_round(uint32_t seed)
+{
+    static const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_COVER, 254, 200, 128, 40};
+
+    rnd_state = seed;
+    uint16_t * px = (uint16_t *)canvas_buf.data;
+    for(uint32_t i = 0; i < CANVAS_W * CANVAS_H; i++) px[i] = rnd();
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    for(uint32_t i = 0; i < SHAPES; i++) {
+        lv_grad_dsc_t grad;
+        lv_memzero(&grad, sizeof(grad));
+        grad.dir = rnd() % 2 ? LV_GRAD_DIR_VER : LV_GRAD_DIR_HOR;
+        grad.stops_count = 2;
+        for(uint32_t s = 0; s < 2; s++) {
+            grad.stops[s].color = lv_color_hex(rnd());
+            grad.stops[s].opa = opas[rnd() % 6];
+            grad.stops[s].frac = s == 0 ? rnd() % 100 : 155 + rnd() % 101;
+        }
+
+        lv_area_t coords;
+        coords.x1 = (int32_t)(rnd() % 300) - 20;
+        coords.y1 = (int32_t)(rnd() % 220) - 20;
+        coords.x2 = coords.x1 + 1 + rnd() % 150;
+        coords.y2 = coords.y1 + 1 + rnd() % 100;
+
+        lv_area_t clip;
+        clip.x1 = rnd() % CANVAS_W;
+        clip.y1 = rnd() % CANVAS_H;
+        clip.x2 = clip.x1 + rnd() % CANVAS_W;
+        clip.y2 = clip.y1 + rnd() % CANVAS_H;
+        if(clip.x2 >= CANVAS_W) clip.x2 = CANVAS_W - 1;
+        if(clip.y2 >= CANVAS_H) clip.y2 = CANVAS_H - 1;
+        if(rnd() % 2) lv_area_set(&clip, 0, 0, CANVAS_W - 1, CANVAS_H - 1);
+        layer._clip_area = clip;
+
+        if(rnd() % 4) {
+            lv_draw_rect_dsc_t dsc;
+            lv_draw_rect_dsc_init(&dsc);
+            dsc.radius = rnd() % 3 ? rnd() % 20 : 0;
+            dsc.bg_opa = opas[rnd() % 6];
+            dsc.bg_grad = grad;
+            lv_draw_rect(&layer, &dsc, &coords);
+        }
+        else {
+            lv_draw_triangle_dsc_t dsc;
+            lv_draw_triangle_dsc_init(&dsc);
+            dsc.bg_grad = grad;
+            dsc.bg_opa = opas[rnd() % 6];
+            dsc.p[0].x = coords.x1;
+            dsc.p[0].y = coords.y1;
+            dsc.p[1].x = coords.x2;
+            dsc.p[1].y = coords.y1 + lv_area_get_height(&coords) / 3;
+            dsc.p[2].x = coords.x1 + lv_area_get_width(&coords) / 2;
+            dsc.p[2].y = coords.y2;
+            lv_draw_triangle(&layer, &dsc);
+        }
+    }
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+int main(void)
+{
+    disp = host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+    grad_cache = LV_GLOBAL_DEFAULT()->sw_grad_cache;
+    HOST_CHECK(grad_cache != NULL, "the gradient cache wasn't created");
+
+    cards_create();
+    grad_cache_attach(false);
+    uint32_t uncached = cards_frame_hash();
+    grad_cache_attach(true);
+    lv_cache_stats_t before, after;
+    lv_gradient_cache_get_stats(&before);
+    for(uint32_t i = 0; i < 3; i++) {
+        uint32_t cached = cards_frame_hash();
+        HOST_CHECK(cached == uncached, "frame %u of the cards differs with the gradient cache", (unsigned)i);
+    }
+    lv_gradient_cache_get_stats(&after);
+    HOST_CHECK(after.hits > before.hits, "the cards never hit the gradient cache");
+
+    LV_DRAW_BUF_INIT_STATIC(canvas_buf);
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+    lv_canvas_set_draw_buf(canvas, &canvas_buf);
+
+    for(uint32_t r = 0; r < ROUNDS; r++) {
+        uint32_t seed = r * 7919 + 1;
+        draw_round(seed);
+        lv_memcpy(cached_px, canvas_buf.data, sizeof(cached_px));
+        grad_cache_attach(false);
+        draw_round(seed);
+        grad_cache_attach(true);
+
+        const uint16_t * uncached_px = (const uint16_t *)canvas_buf.data;
+        uint32_t diff = 0;
+        for(uint32_t i = 0; i < CANVAS_W * CANVAS_H; i++) diff += cached_px[i] != uncached_px[i];
+        HOST_CHECK(diff == 0, "round %u: %u px differ with the gradient cache", (unsigned)r, (unsigned)diff);
+    }
+
+    return host_finish("gradient_cache_test");
+}
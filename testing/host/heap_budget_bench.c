@@ -0,0 +1,158 @@
+/**
+ * @file heap_budget_bench.c
+ * Builds the app's UI from main/ui_screens_gen.c and walks through it like the device does:
+ * the loading screen with its GIF, the home page with the rolling balances, the accounts page
+ * and the virtual transactions table, then a few rounds over the pages.
+ * After every step it prints the LVGL heap (`lv_mem_monitor`) and what each cache holds of it,
+ * so the cache sizes in lib/lv_conf.h can be chosen together against the 64 KB heap.
+ */
+
+#include "host.h"
+#include "src/core/lv_obj_style_private.h"
+#include "src/draw/sw/lv_draw_sw_mask.h"
+
+/*The generated UI is compiled into this translation unit too*/
+#include "../../main/ui_styles_gen.c"
+#include "../../main/ui_screens_gen.c"
+
+#define TRANSACTIONS 500
+
+static lv_display_t * disp;
+
+static const char * accounts[][2] = {
+    {"Adv Plus Banking", "$1523.10"}, {"Advantage Savings", "$8210.00"}, {"Rewards Checking", "$342.77"},
+    {"Platinum Card", "$1204.55"}, {"Blue Cash", "$96.30"}, {"Quicksilver", "$410.12"},
+};
+
+static const char * transaction_cell_cb(lv_obj_t * obj, uint32_t row, uint32_t col, char * buf, uint32_t buf_size)
+{
+    if(col == 0) lv_snprintf(buf, buf_size, "%02u/%02u", (unsigned)(row % 12 + 1), (unsigned)(row % 28 + 1));
+    else if(col == 1) lv_snprintf(buf, buf_size, "Merchant %u", (unsigned)row);
+    else lv_snprintf(buf, buf_size, "-$%u.%02u", (unsigned)(row * 37 % 500), (unsigned)(row * 13 % 100));
+    return buf;
+}
+
+/** Run the timers (and so the refreshes) for `ms` milliseconds in 20 ms steps like lvgl_task */
+static void run(uint32_t ms)
+{
+    for(uint32_t t = 0; t < ms; t += 20) host_advance(20);
+}
+
+/** Bytes of the resolved style values of every object, found by freeing them */
+static uint32_t resolved_style_size(void)
+{
+    uint32_t used = host_heap_used();
+    lv_obj_style_resolved_cache_invalidate(lv_layer_top());
+    for(uint32_t i = 0; i < disp->screen_cnt; i++) {
+        lv_obj_style_resolved_cache_invalidate(disp->screens[i]);
+    }
+    uint32_t size = used - host_heap_used();
+    /*Resolve the visible ones again, as the next refresh would*/
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+    return size;
+}
+
+static void report(const char * step)
+{
+    lv_cache_stats_t image, layout, mask, grad, pool;
+    lv_image_cache_get_stats(&image);
+    lv_text_layout_cache_get_stats(&layout);
+    lv_draw_sw_mask_cache_get_stats(&mask);
+    lv_gradient_cache_get_stats(&grad);
+    lv_draw_buf_pool_get_stats(&pool);
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    uint32_t used = mon.total_size - mon.free_size;
+    uint32_t styles = resolved_style_size();
+
+    uint32_t caches = image.size + layout.size + styles + mask.size + grad.size + pool.size;
+    printf("%-14s %6u %6u %6u | %6u %6u %6u %6u %6u %6u\n", step, (unsigned)used, (unsigned)mon.max_used,
+           (unsigned)(used - caches), (unsigned)image.size, (unsigned)layout.size, (unsigned)styles,
+           (unsigned)mask.size, (unsigned)grad.size, (unsigned)pool.size);
+}
+
+static void show_balance(lv_obj_t * title, lv_obj_t * value, const char * text, int64_t cents)
+{
+    lv_label_set_text(title, text);
+    lv_numlabel_set_value(value, cents);
+    lv_obj_remove_flag(value, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_align_to(value, title, LV_ALIGN_OUT_BOTTOM_MID, 0, 0);
+}
+
+static void fill_accounts(void)
+{
+    lv_table_begin_batch(checking_table);
+    lv_table_begin_batch(credit_table);
+    for(uint32_t i = 0; i < sizeof(accounts) / sizeof(accounts[0]); i++) {
+        lv_obj_t * table = i < 3 ? checking_table : credit_table;
+        uint32_t row = i % 3 + 1;
+        lv_table_set_row_count(table, row + 1);
+        lv_table_set_cell_value(table, row, 0, accounts[i][0]);
+        lv_table_set_cell_value(table, row, 1, accounts[i][1]);
+    }
+    lv_table_commit_batch(checking_table);
+    lv_table_commit_batch(credit_table);
+    lv_obj_set_size(checking_table, 310, LV_SIZE_CONTENT);
+    lv_obj_set_size(credit_table, 310, LV_SIZE_CONTENT);
+    lv_obj_align_to(credit_table, checking_table, LV_ALIGN_OUT_BOTTOM_MID, 0, 15);
+}
+
+int main(void)
+{
+    disp = host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+    host_fs_init('A', "../../assets");
+    static uint8_t page_cache_buf[48 * 1024];
+    lv_page_cache_t * page_cache = lv_page_cache_create(disp, page_cache_buf, sizeof(page_cache_buf));
+
+    printf("LVGL heap %u bytes. used/peak/without caches | image layout styles mask gradient layer pool\n",
+           (unsigned)LV_MEM_SIZE);
+
+    lv_screen_load(loading_screen_create());
+    home_page_create();
+    lv_page_cache_add_page(page_cache, home_page);
+    chrome_create();
+    lv_refr_now(disp);
+    report("boot");
+
+    run(2000);
+    report("loading");
+
+    show_balance(total_credit_balance_label, total_credit_balance_value, "Credit Balance", 171097);
+    show_balance(total_checking_balance_label, total_checking_balance_value, "Checking Balance", 1007587);
+    show_balance(total_balance, total_balance_value, "Total Balance", 836490);
+    lv_screen_load(home_page);
+    lv_obj_remove_flag(nav_bar, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_delete(loading_screen);
+    run(1000);
+    report("home");
+
+    accounts_page_create();
+    fill_accounts();
+    lv_page_cache_add_page(page_cache, accounts_page);
+    lv_screen_load(accounts_page);
+    run(500);
+    lv_obj_scroll_by(account_content, 0, -80, LV_ANIM_ON);
+    run(500);
+    report("accounts");
+
+    transactions_page_create();
+    lv_table_set_cell_data_cb(transactions_table, transaction_cell_cb);
+    lv_table_set_row_count(transactions_table, TRANSACTIONS);
+    lv_page_cache_add_page(page_cache, transactions_page);
+    lv_screen_load(transactions_page);
+    run(500);
+    for(uint32_t i = 0; i < 5; i++) {
+        lv_obj_scroll_by_bounded(transactions_table, 0, -80, LV_ANIM_ON);
+        run(300);
+    }
+    report("transactions");
+
+    lv_obj_t * pages[] = {home_page, accounts_page, transactions_page};
+    for(uint32_t i = 0; i < 9; i++) {
+        lv_screen_load(pages[i % 3]);
+        run(300);
+    }
+    report("page rounds");
+    return 0;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file host.h
+ * Helpers shared by the host checks and benchmarks: a manually advanced tick,
+ * a 320x240 RGB565 display rendering into `host_frame`, a stdio file system driver, a clock and check macros.
+ * Every harness is a single translation unit, so everything here is static.
+ */
+
+#ifndef HOST_H
+#define HOST_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lvgl.h"
+#include "src/display/lv_display_private.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define HOST_HOR_RES 320
+#define HOST_VER_RES 240
+
+/** Report a failed check and keep going, `host_finish` turns failures into the exit code */
+#define HOST_CHECK(cond, ...) do { \
+        if(!(cond)) { \
+            host_failures++; \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+        } \
+    } while(0)
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint16_t host_frame[HOST_HOR_RES * HOST_VER_RES];
+static uint16_t host_partial_buf[HOST_HOR_RES * 20];
+static uint32_t host_ticks;
+static uint32_t host_failures;
+static const char * host_fs_dir;
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint32_t host_tick_cb(void)
+{
+    return host_ticks;
+}
+
+static void host_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    /*In direct mode LVGL rendered into `host_frame` already*/
+    if(lv_display_get_buf_active(disp)->data != (uint8_t *)host_frame) {
+        int32_t w = lv_area_get_width(area);
+        const uint16_t * src = (const uint16_t *)px_map;
+        for(int32_t y = area->y1; y <= area->y2; y++) {
+            memcpy(&host_frame[y * HOST_HOR_RES + area->x1], src, w * sizeof(uint16_t));
+            src += w;
+        }
+    }
+    lv_display_flush_ready(disp);
+}
+
+static void * host_fs_open_cb(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode)
+{
+    char full[256];
+    snprintf(full, sizeof(full), "%s%s", host_fs_dir, path);
+    return fopen(full, "rb");
+}
+
+static lv_fs_res_t host_fs_close_cb(lv_fs_drv_t * drv, void * file_p)
+{
+    fclose(file_p);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t host_fs_read_cb(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    *br = (uint32_t)fread(buf, 1, btr, file_p);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t host_fs_seek_cb(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    int w = whence == LV_FS_SEEK_SET ? SEEK_SET : whence == LV_FS_SEEK_CUR ? SEEK_CUR : SEEK_END;
+    return fseek(file_p, pos, w) == 0 ? LV_FS_RES_OK : LV_FS_RES_UNKNOWN;
+}
+
+static lv_fs_res_t host_fs_tell_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    *pos_p = (uint32_t)ftell(file_p);
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Register a read-only stdio driver
+ * @param letter    drive letter, e.g. 'A' to read the firmware's "A:/..." paths
+ * @param dir       prepended to the paths, e.g. "../../assets", "" to open them as they are
+ */
+static inline void host_fs_init(char letter, const char * dir)
+{
+    static lv_fs_drv_t drv;
+    host_fs_dir = dir;
+    lv_fs_drv_init(&drv);
+    drv.letter = letter;
+    drv.open_cb = host_fs_open_cb;
+    drv.close_cb = host_fs_close_cb;
+    drv.read_cb = host_fs_read_cb;
+    drv.seek_cb = host_fs_seek_cb;
+    drv.tell_cb = host_fs_tell_cb;
+    lv_fs_drv_register(&drv);
+}
+
+/**
+ * Initialize LVGL with the firmware's lv_conf.h and create the display
+ * @param render_mode   LV_DISPLAY_RENDER_MODE_DIRECT renders into `host_frame` like the device,
+ *                      LV_DISPLAY_RENDER_MODE_PARTIAL uses a 20 line buffer and copies it there
+ * @return              the display
+ */
+static inline lv_display_t * host_init(lv_display_render_mode_t render_mode)
+{
+    lv_init();
+    lv_tick_set_cb(host_tick_cb);
+    lv_display_t * disp = lv_display_create(HOST_HOR_RES, HOST_VER_RES);
+    lv_display_set_flush_cb(disp, host_flush_cb);
+    if(render_mode == LV_DISPLAY_RENDER_MODE_DIRECT) {
+        lv_display_set_buffers(disp, host_frame, NULL, sizeof(host_frame), LV_DISPLAY_RENDER_MODE_DIRECT);
+    }
+    else {
+        lv_display_set_buffers(disp, host_partial_buf, NULL, sizeof(host_partial_buf), render_mode);
+    }
+    return disp;
+}
+
+/** Let `ms` milliseconds pass and run the timers once */
+static inline void host_advance(uint32_t ms)
+{
+    host_ticks += ms;
+    lv_timer_handler();
+}
+
+static inline uint64_t host_ns(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000ull + (uint64_t)t.tv_nsec;
+}
+
+/** Hash of every pixel of the last rendered frame */
+static inline uint32_t host_frame_hash(void)
+{
+    uint32_t h = 2166136261u;
+    for(uint32_t i = 0; i < HOST_HOR_RES * HOST_VER_RES; i++) h = (h ^ host_frame[i]) * 16777619u;
+    return h;
+}
+
+/** Used bytes of LVGL's heap (LV_MEM_SIZE of the firmware) */
+static inline uint32_t host_heap_used(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+/** Print the result and get the exit code */
+static inline int host_finish(const char * name)
+{
+    if(host_failures) printf("%s: %u check(s) failed\n", name, (unsigned)host_failures);
+    else printf("%s: ok\n", name);
+    return host_failures ? 1 : 0;
+}
+
+#endif /*HOST_H*/
@@ -0,0 +1,22 @@
+/**
+ * @file esp_log.h
+ * Host stand-in for ESP-IDF's logging. The checks provoke errors on purpose, so nothing is printed
+ * unless they are built with -DHOST_IDF_LOG, then errors and warnings are
+ */
+
+#ifndef HOST_ESP_LOG_H
+#define HOST_ESP_LOG_H
+
+#include <stdio.h>
+
+#ifdef HOST_IDF_LOG
+#define ESP_LOGE(tag, fmt, ...) printf("E %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) printf("W %s: " fmt "\n", tag, ##__VA_ARGS__)
+#else
+#define ESP_LOGE(tag, fmt, ...) do { (void)(tag); } while(0)
+#define ESP_LOGW(tag, fmt, ...) do { (void)(tag); } while(0)
+#endif
+#define ESP_LOGI(tag, fmt, ...) do { (void)(tag); } while(0)
+#define ESP_LOGD(tag, fmt, ...) do { (void)(tag); } while(0)
+
+#endif /*HOST_ESP_LOG_H*/
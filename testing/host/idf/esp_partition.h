@@ -0,0 +1,51 @@
+/**
+ * @file esp_partition.h
+ * Host stand-in for the partition API. There is no partition table on the host, checks of code that
+ * can run on raw flash hand it their own flash instead (e.g. a file, see transaction_store_test.c)
+ */
+
+#ifndef HOST_ESP_PARTITION_H
+#define HOST_ESP_PARTITION_H
+
+#include <stddef.h>
+#include "esp_err.h"
+
+typedef enum {
+    ESP_PARTITION_TYPE_APP = 0x00,
+    ESP_PARTITION_TYPE_DATA = 0x01,
+} esp_partition_type_t;
+
+typedef enum {
+    ESP_PARTITION_SUBTYPE_ANY = 0xff,
+} esp_partition_subtype_t;
+
+typedef struct {
+    size_t size;
+} esp_partition_t;
+
+static inline const esp_partition_t * esp_partition_find_first(esp_partition_type_t type,
+                                                               esp_partition_subtype_t subtype, const char * label)
+{
+    (void)type;
+    (void)subtype;
+    (void)label;
+    return NULL;
+}
+
+static inline esp_err_t esp_partition_read(const esp_partition_t * partition, size_t offset, void * dst, size_t len)
+{
+    return ESP_ERR_NOT_FOUND;
+}
+
+static inline esp_err_t esp_partition_write(const esp_partition_t * partition, size_t offset, const void * src,
+                                            size_t len)
+{
+    return ESP_ERR_NOT_FOUND;
+}
+
+static inline esp_err_t esp_partition_erase_range(const esp_partition_t * partition, size_t offset, size_t len)
+{
+    return ESP_ERR_NOT_FOUND;
+}
+
+#endif /*HOST_ESP_PARTITION_H*/
@@ -0,0 +1,29 @@
+/**
+ * @file esp_spiffs.h
+ * Host stand-in for mounting SPIFFS. The "partition" is a host directory the firmware source is built
+ * to use, mounting only fails when a check sets `host_spiffs_result`
+ */
+
+#ifndef HOST_ESP_SPIFFS_H
+#define HOST_ESP_SPIFFS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+typedef struct {
+    const char * base_path;
+    const char * partition_label;
+    size_t max_files;
+    bool format_if_mount_failed;
+} esp_vfs_spiffs_conf_t;
+
+static esp_err_t host_spiffs_result = ESP_OK;
+
+static inline esp_err_t esp_vfs_spiffs_register(const esp_vfs_spiffs_conf_t * conf)
+{
+    (void)conf;
+    return host_spiffs_result;
+}
+
+#endif /*HOST_ESP_SPIFFS_H*/
@@ -0,0 +1,19 @@
+/**
+ * @file FreeRTOS.h
+ * Host stand-in for the FreeRTOS types the firmware sources use. The host checks run in one thread
+ */
+
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <stdint.h>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdTRUE          1
+#define pdFALSE         0
+#define portMAX_DELAY   0xFFFFFFFFu
+
+#endif /*HOST_FREERTOS_H*/
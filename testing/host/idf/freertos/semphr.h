@@ -0,0 +1,48 @@
+/**
+ * @file semphr.h
+ * Host stand-in for FreeRTOS mutexes. There is one thread, so a mutex only checks that it exists and
+ * that it's not taken twice: both abort, like a FreeRTOS assert on the device
+ */
+
+#ifndef HOST_SEMPHR_H
+#define HOST_SEMPHR_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "FreeRTOS.h"
+
+typedef struct {
+    int taken;
+} host_semaphore_t;
+
+typedef host_semaphore_t * SemaphoreHandle_t;
+
+static inline SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return calloc(1, sizeof(host_semaphore_t));
+}
+
+static inline BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    (void)ticks;
+    if(sem == NULL || sem->taken) {
+        printf("FAIL %s mutex taken\n", sem ? "a taken" : "a NULL");
+        fflush(stdout);
+        abort();
+    }
+    sem->taken = 1;
+    return pdTRUE;
+}
+
+static inline BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    if(sem == NULL || !sem->taken) {
+        printf("FAIL %s mutex given\n", sem ? "a free" : "a NULL");
+        fflush(stdout);
+        abort();
+    }
+    sem->taken = 0;
+    return pdTRUE;
+}
+
+#endif /*HOST_SEMPHR_H*/
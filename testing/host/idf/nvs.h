@@ -0,0 +1,166 @@
+/**
+ * @file nvs.h
+ * Host stand-in for ESP-IDF's NVS: u8, u32 and string keys in RAM. Writes are kept at once, so they survive
+ * the simulated resets of the host checks. Setting `host_nvs_result` makes every call fail with it
+ */
+
+#ifndef HOST_NVS_H
+#define HOST_NVS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "esp_err.h"
+
+#define ESP_ERR_NVS_NOT_FOUND       0x1102
+#define ESP_ERR_NVS_NOT_ENOUGH_SPACE 0x1105
+#define ESP_ERR_NVS_INVALID_LENGTH  0x110c
+
+#define HOST_NVS_KEYS       64
+#define HOST_NVS_NAME_MAX   16
+#define HOST_NVS_STR_MAX    512
+
+typedef uint32_t nvs_handle_t;
+
+typedef enum {
+    NVS_READONLY,
+    NVS_READWRITE,
+} nvs_open_mode_t;
+
+typedef struct {
+    char ns[HOST_NVS_NAME_MAX];
+    char key[HOST_NVS_NAME_MAX];
+    uint32_t value;
+    char str[HOST_NVS_STR_MAX];
+    int used;
+} host_nvs_entry_t;
+
+static host_nvs_entry_t host_nvs[HOST_NVS_KEYS];
+static char host_nvs_namespaces[8][HOST_NVS_NAME_MAX];
+static esp_err_t host_nvs_result = ESP_OK;
+
+static inline host_nvs_entry_t * host_nvs_find(nvs_handle_t handle, const char * key, int create)
+{
+    const char * ns = host_nvs_namespaces[handle];
+    host_nvs_entry_t * free_entry = NULL;
+    for(int i = 0; i < HOST_NVS_KEYS; i++) {
+        host_nvs_entry_t * e = &host_nvs[i];
+        if(!e->used) {
+            if(!free_entry) free_entry = e;
+        }
+        else if(strcmp(e->ns, ns) == 0 && strcmp(e->key, key) == 0) return e;
+    }
+    if(!create || !free_entry) return NULL;
+    memset(free_entry, 0, sizeof(*free_entry));
+    strcpy(free_entry->ns, ns);
+    snprintf(free_entry->key, sizeof(free_entry->key), "%s", key);
+    free_entry->used = 1;
+    return free_entry;
+}
+
+/** Forget everything, like erasing the NVS partition */
+static inline void host_nvs_erase(void)
+{
+    memset(host_nvs, 0, sizeof(host_nvs));
+    memset(host_nvs_namespaces, 0, sizeof(host_nvs_namespaces));
+}
+
+static inline esp_err_t nvs_open(const char * name, nvs_open_mode_t mode, nvs_handle_t * handle)
+{
+    if(host_nvs_result != ESP_OK) return host_nvs_result;
+    for(nvs_handle_t i = 0; i < 8; i++) {
+        if(strcmp(host_nvs_namespaces[i], name) == 0) {
+            *handle = i;
+            return ESP_OK;
+        }
+    }
+    if(mode == NVS_READONLY) return ESP_ERR_NVS_NOT_FOUND;
+    for(nvs_handle_t i = 0; i < 8; i++) {
+        if(host_nvs_namespaces[i][0] == '\0') {
+            snprintf(host_nvs_namespaces[i], sizeof(host_nvs_namespaces[i]), "%s", name);
+            *handle = i;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+}
+
+static inline void nvs_close(nvs_handle_t handle)
+{
+    (void)handle;
+}
+
+static inline esp_err_t nvs_commit(nvs_handle_t handle)
+{
+    (void)handle;
+    return host_nvs_result;
+}
+
+static inline esp_err_t nvs_erase_all(nvs_handle_t handle)
+{
+    if(host_nvs_result != ESP_OK) return host_nvs_result;
+    for(int i = 0; i < HOST_NVS_KEYS; i++) {
+        if(host_nvs[i].used && strcmp(host_nvs[i].ns, host_nvs_namespaces[handle]) == 0) host_nvs[i].used = 0;
+    }
+    return ESP_OK;
+}
+
+static inline esp_err_t nvs_set_u32(nvs_handle_t handle, const char * key, uint32_t value)
+{
+    if(host_nvs_result != ESP_OK) return host_nvs_result;
+    host_nvs_entry_t * e = host_nvs_find(handle, key, 1);
+    if(!e) return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    e->value = value;
+    return ESP_OK;
+}
+
+static inline esp_err_t nvs_get_u32(nvs_handle_t handle, const char * key, uint32_t * value)
+{
+    if(host_nvs_result != ESP_OK) return host_nvs_result;
+    host_nvs_entry_t * e = host_nvs_find(handle, key, 0);
+    if(!e) return ESP_ERR_NVS_NOT_FOUND;
+    *value = e->value;
+    return ESP_OK;
+}
+
+static inline esp_err_t nvs_set_u8(nvs_handle_t handle, const char * key, uint8_t value)
+{
+    return nvs_set_u32(handle, key, value);
+}
+
+static inline esp_err_t nvs_get_u8(nvs_handle_t handle, const char * key, uint8_t * value)
+{
+    uint32_t v;
+    esp_err_t err = nvs_get_u32(handle, key, &v);
+    if(err == ESP_OK) *value = (uint8_t)v;
+    return err;
+}
+
+static inline esp_err_t nvs_set_str(nvs_handle_t handle, const char * key, const char * value)
+{
+    if(host_nvs_result != ESP_OK) return host_nvs_result;
+    if(strlen(value) >= HOST_NVS_STR_MAX) return ESP_ERR_NVS_INVALID_LENGTH;
+    host_nvs_entry_t * e = host_nvs_find(handle, key, 1);
+    if(!e) return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    strcpy(e->str, value);
+    return ESP_OK;
+}
+
+static inline esp_err_t nvs_get_str(nvs_handle_t handle, const char * key, char * value, size_t * len)
+{
+    if(host_nvs_result != ESP_OK) return host_nvs_result;
+    host_nvs_entry_t * e = host_nvs_find(handle, key, 0);
+    if(!e) return ESP_ERR_NVS_NOT_FOUND;
+    size_t need = strlen(e->str) + 1;
+    if(value == NULL) {
+        *len = need;
+        return ESP_OK;
+    }
+    if(*len < need) return ESP_ERR_NVS_INVALID_LENGTH;
+    memcpy(value, e->str, need);
+    *len = need;
+    return ESP_OK;
+}
+
+#endif /*HOST_NVS_H*/
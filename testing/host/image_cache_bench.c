@@ -0,0 +1,113 @@
+/**
+ * @file image_cache_bench.c
+ * Replays a trace of image lookups on the plain size based LRU cache (`lv_cache_class_lru_rb_size`)
+ * and on the cost aware one the image cache uses (`lv_cache_class_lru_rb_cost`) at several sizes.
+ * Prints the decode time each one spends on misses, the hits and the evictions.
+ *
+ * The app draws no decoded images yet, so the trace is synthetic: page visits in a random walk over
+ * three pages, each drawing its images for a few frames. The sizes and decode times are the ones of
+ * RGB565 images of that size: PNG icons are slow and small, raw images are large and only copied.
+ */
+
+#include "host.h"
+
+#define VISITS          300
+#define FRAMES          10
+
+typedef struct {
+    lv_cache_slot_size_t slot;      /*Size and decode cost, read by the cache classes*/
+    uint32_t id;
+} image_entry_t;
+
+typedef struct {
+    const char * name;
+    uint32_t size;                  /*[bytes]*/
+    uint32_t cost;                  /*Decode time [us]*/
+} image_t;
+
+static const image_t images[] = {
+    {"home icon png",     24 * 24 * 3,  2000},
+    {"wifi icon png",     24 * 24 * 3,  2000},
+    {"sync icon png",     24 * 24 * 3,  2000},
+    {"logo bin",          64 * 48 * 2,   150},
+    {"amex logo png",     32 * 32 * 3,  3500},
+    {"bofa logo png",     32 * 32 * 3,  3500},
+    {"capone logo png",   32 * 32 * 3,  3500},
+    {"card bin",          96 * 60 * 2,   250},
+    {"chart rle",        120 * 60 * 2,  1200},
+    {"arrow up bin",      16 * 16 * 2,    20},
+    {"arrow down bin",    16 * 16 * 2,    20},
+};
+
+/*Indexes of `images` drawn by each page, -1 terminated*/
+static const int32_t pages[][6] = {
+    {0, 1, 2, 3, -1},
+    {0, 4, 5, 6, 7, -1},
+    {0, 8, 9, 10, -1},
+};
+
+static lv_cache_compare_res_t compare_cb(const image_entry_t * lhs, const image_entry_t * rhs)
+{
+    if(lhs->id == rhs->id) return 0;
+    return lhs->id > rhs->id ? 1 : -1;
+}
+
+static void free_cb(image_entry_t * entry, void * user_data)
+{
+}
+
+typedef struct {
+    uint64_t decode_us;
+    lv_cache_stats_t stats;
+} replay_result_t;
+
+static void replay(const lv_cache_class_t * cache_class, uint32_t size, replay_result_t * res)
+{
+    lv_cache_t * cache = lv_cache_create(cache_class, sizeof(image_entry_t), size, (lv_cache_ops_t) {
+        .compare_cb = (lv_cache_compare_cb_t)compare_cb,
+        .create_cb = NULL,
+        .free_cb = (lv_cache_free_cb_t)free_cb,
+    });
+
+    uint32_t seed = 1;
+    uint32_t page = 0;
+    res->decode_us = 0;
+    for(uint32_t v = 0; v < VISITS; v++) {
+        for(uint32_t f = 0; f < FRAMES; f++) {
+            for(uint32_t i = 0; pages[page][i] >= 0; i++) {
+                const image_t * img = &images[pages[page][i]];
+                image_entry_t key = {.slot = {.size = img->size, .cost = img->cost}, .id = pages[page][i]};
+                lv_cache_entry_t * entry = lv_cache_acquire(cache, &key, NULL);
+                if(entry == NULL) {
+                    /*Decode it again. It's only kept if it fits*/
+                    res->decode_us += img->cost;
+                    entry = lv_cache_add(cache, &key, NULL);
+                }
+                if(entry) lv_cache_release(cache, entry, NULL);
+            }
+        }
+        /*Mostly to a neighbour page, like the page button does, sometimes back home*/
+        seed = seed * 1103515245u + 12345u;
+        page = ((seed >> 16) % 4 == 0) ? 0 : (page + 1) % 3;
+    }
+
+    lv_cache_get_stats(cache, &res->stats);
+    lv_cache_destroy(cache, NULL);
+}
+
+int main(void)
+{
+    host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    static const uint32_t sizes[] = {0, 4 * 1024, 8 * 1024, 12 * 1024, 16 * 1024, 24 * 1024, 32 * 1024};
+    printf("%u page visits of %u frames. Decode time of the misses:\n", (unsigned)VISITS, (unsigned)FRAMES);
+    for(uint32_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        replay_result_t lru, cost;
+        replay(&lv_cache_class_lru_rb_size, sizes[i], &lru);
+        replay(&lv_cache_class_lru_rb_cost, sizes[i], &cost);
+        printf("%5u bytes: LRU %9.1f ms (%5u misses, %5u evictions), cost aware %9.1f ms (%5u misses, %5u evictions)\n",
+               (unsigned)sizes[i], lru.decode_us / 1e3, (unsigned)lru.stats.misses, (unsigned)lru.stats.evictions,
+               cost.decode_us / 1e3, (unsigned)cost.stats.misses, (unsigned)cost.stats.evictions);
+    }
+    return 0;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file json_stream_test.c
+ * Checks of the incremental JSON scanner the transactions sync parses its pages with (main/json_stream.c).
+ * The callbacks of every document are recorded and must be the same however it's cut into chunks:
+ * in one piece, split at every byte, byte by byte and in random chunks.
+ * - a /transactions/sync page: the elements of "added", "modified" and "removed" and the top-level scalars
+ * - strings with escaped quotes and backslashes, braces, brackets, commas and colons in them,
+ *   nested objects and arrays inside the elements
+ * - elements of JSON_STREAM_ELEMENT_MAX - 1 bytes are delivered, longer ones are skipped and counted
+ *   in `skipped` without losing their neighbors, too long scalars are dropped
+ */
+
+#include "host.h"
+
+#include "../../main/json_stream.c"
+
+#define EVENTS_MAX  (64 * 1024)
+#define DOC_MAX     (16 * 1024)
+
+typedef struct {
+    char text[EVENTS_MAX];
+    size_t len;
+} events_t;
+
+static uint32_t rnd_state = 1;
+
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return rnd_state >> 8;
+}
+
+static void events_add(events_t * ev, char type, const char * key, const char * value)
+{
+    int n = snprintf(ev->text + ev->len, sizeof(ev->text) - ev->len, "%c %s|%s\n", type, key, value);
+    if(n > 0) ev->len += (size_t)n;
+    if(ev->len >= sizeof(ev->text)) ev->len = sizeof(ev->text) - 1;
+}
+
+static void element_cb(const char * key, const char * element, size_t len, void * user_data)
+{
+    HOST_CHECK(strlen(element) == len, "the element length is %u instead of %u", (unsigned)len, (unsigned)strlen(element));
+    events_add(user_data, 'E', key, element);
+}
+
+static void scalar_cb(const char * key, const char * value, void * user_data)
+{
+    events_add(user_data, 'S', key, value);
+}
+
+/** Feed a document in chunks of the given sizes (repeated), 0 for one piece, and record the callbacks */
+static unsigned parse(const char * doc, events_t * ev, const size_t * chunks, size_t chunk_cnt)
+{
+    static json_stream_t stream;
+    ev->len = 0;
+    ev->text[0] = '\0';
+    json_stream_init(&stream, element_cb, scalar_cb, ev);
+
+    size_t len = strlen(doc);
+    size_t pos = 0;
+    for(size_t i = 0; pos < len; i++) {
+        size_t n = chunk_cnt ? chunks[i % chunk_cnt] : len;
+        if(n > len - pos) n = len - pos;
+        json_stream_feed(&stream, doc + pos, n);
+        pos += n;
+    }
+    ev->text[ev->len] = '\0';
+    return stream.skipped;
+}
+
+/** Every way of cutting the document must give the callbacks and skipped count of the whole */
+static void check_splits(const char * name, const char * doc, const events_t * whole, unsigned whole_skipped)
+{
+    static events_t ev;
+    size_t len = strlen(doc);
+
+    for(size_t cut = 1; cut < len; cut++) {
+        size_t chunks[2] = {cut, len};
+        unsigned skipped = parse(doc, &ev, chunks, 2);
+        HOST_CHECK(skipped == whole_skipped && strcmp(ev.text, whole->text) == 0,
+                   "%s: differs when split at byte %u", name, (unsigned)cut);
+    }
+
+    size_t one = 1;
+    unsigned skipped = parse(doc, &ev, &one, 1);
+    HOST_CHECK(skipped == whole_skipped && strcmp(ev.text, whole->text) == 0, "%s: differs byte by byte", name);
+
+    for(uint32_t r = 0; r < 200; r++) {
+        size_t chunks[16];
+        for(uint32_t i = 0; i < 16; i++) chunks[i] = 1 + rnd() % 700;
+        skipped = parse(doc, &ev, chunks, 16);
+        HOST_CHECK(skipped == whole_skipped && strcmp(ev.text, whole->text) == 0,
+                   "%s: differs in random chunks, round %u", name, (unsigned)r);
+    }
+}
+
+static void check_sync_page(void)
+{
+    static const char doc[] =
+        "{\"added\": [{\"transaction_id\": \"a1\", \"amount\": 12.5, \"date\": \"2026-10-01\", \"name\": \"Coffee\"},\n"
+        "  {\"transaction_id\":\"a2\",\"amount\":-1500,\"date\":\"2026-10-02\",\"name\":\"Payroll, \\\"ACME\\\" {inc}\","
+        "\"location\":{\"city\":\"[Reno]\",\"lat\":null},\"counterparties\":[{\"name\":\"A:B\"},{\"name\":\"\\\\\"}]}],"
+        " \"modified\": [], \"removed\": [{\"transaction_id\": \"r1\"}],"
+        " \"next_cursor\": \"c\\\"ur,sor:1\", \"has_more\": true, \"request_id\": \"req}]\"}";
+    static const char expected[] =
+        "E added|{\"transaction_id\": \"a1\", \"amount\": 12.5, \"date\": \"2026-10-01\", \"name\": \"Coffee\"}\n"
+        "E added|{\"transaction_id\":\"a2\",\"amount\":-1500,\"date\":\"2026-10-02\",\"name\":\"Payroll, \\\"ACME\\\" {inc}\","
+        "\"location\":{\"city\":\"[Reno]\",\"lat\":null},\"counterparties\":[{\"name\":\"A:B\"},{\"name\":\"\\\\\"}]}\n"
+        "E removed|{\"transaction_id\": \"r1\"}\n"
+        "S next_cursor|c\\\"ur,sor:1\n"
+        "S has_more|true\n"
+        "S request_id|req}]\n";
+
+    static events_t whole;
+    unsigned skipped = parse(doc, &whole, NULL, 0);
+    HOST_CHECK(skipped == 0, "sync page: %u elements skipped", skipped);
+    HOST_CHECK(strcmp(whole.text, expected) == 0, "sync page: the callbacks were\n%s", whole.text);
+    check_splits("sync page", doc, &whole, skipped);
+}
+
+/** An element whose text is exactly `len` bytes */
+static size_t element_of_len(char * dst, const char * id, size_t len)
+{
+    int head = sprintf(dst, "{\"transaction_id\":\"%s\",\"name\":\"", id);
+    size_t fill = len - head - 2;
+    for(size_t i = 0; i < fill; i++) dst[head + i] = i % 50 == 49 ? ' ' : 'x';
+    strcpy(dst + head + fill, "\"}");
+    return len;
+}
+
+static void check_sizes(void)
+{
+    static char doc[DOC_MAX];
+    static events_t whole;
+    size_t fits = JSON_STREAM_ELEMENT_MAX - 1;
+
+    /*The largest element that fits, one that is a byte too long, and small neighbors*/
+    size_t pos = (size_t)sprintf(doc, "{\"added\":[{\"transaction_id\":\"before\"},");
+    pos += element_of_len(doc + pos, "fits", fits);
+    doc[pos++] = ',';
+    pos += element_of_len(doc + pos, "too_long", fits + 1);
+    pos += (size_t)sprintf(doc + pos, ",{\"transaction_id\":\"after\"}],\"removed\":[");
+    pos += element_of_len(doc + pos, "much_too_long", 2 * JSON_STREAM_ELEMENT_MAX);
+    pos += (size_t)sprintf(doc + pos, "],\"next_cursor\":\"");
+    for(uint32_t i = 0; i < JSON_STREAM_SCALAR_MAX; i++) doc[pos++] = 'c';
+    pos += (size_t)sprintf(doc + pos, "\",\"has_more\":false}");
+    doc[pos] = '\0';
+
+    unsigned skipped = parse(doc, &whole, NULL, 0);
+    HOST_CHECK(skipped == 2, "%u elements skipped instead of 2", skipped);
+    HOST_CHECK(strstr(whole.text, "E added|{\"transaction_id\":\"before\"}\n") != NULL, "the element before is lost");
+    HOST_CHECK(strstr(whole.text, "E added|{\"transaction_id\":\"after\"}\n") != NULL, "the element after is lost");
+    HOST_CHECK(strstr(whole.text, "\"fits\"") != NULL, "the element of %u bytes is not delivered", (unsigned)fits);
+    HOST_CHECK(strstr(whole.text, "too_long") == NULL, "a too long element is delivered");
+    HOST_CHECK(strstr(whole.text, "next_cursor") == NULL, "a too long scalar is delivered");
+    HOST_CHECK(strstr(whole.text, "S has_more|false\n") != NULL, "the scalar after a too long one is lost");
+    check_splits("sizes", doc, &whole, skipped);
+}
+
+int main(void)
+{
+    check_sync_page();
+    check_sizes();
+    return host_finish("json_stream_test");
+}
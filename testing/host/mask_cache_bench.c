@@ -0,0 +1,150 @@
+/**
+ * @file mask_cache_bench.c
+ * The loading screen's progress bar sweeping from 0 to 100 and random rounded fills, borders and shadows
+ * on a canvas, with the cache of rounded corner masks and blurred shadow corners (LV_DRAW_SW_MASK_CACHE_SIZE)
+ * and with it detached, when every mask is rendered for each row again like without the cache.
+ * Prints the best time of several runs per bar frame and per canvas, and the hits,
+ * misses, evictions and size of the cache.
+ */
+
+#include "host.h"
+#include "src/core/lv_global.h"
+#include "src/draw/sw/lv_draw_sw_mask.h"
+
+/*The generated UI is compiled into this translation unit too*/
+#include "../../main/ui_styles_gen.c"
+#include "../../main/ui_screens_gen.c"
+
+#define CANVAS_W    HOST_HOR_RES
+#define CANVAS_H    HOST_VER_RES
+#define SWEEPS      20
+#define ROUNDS      100
+#define RECTS       6
+
+LV_DRAW_BUF_DEFINE_STATIC(canvas_buf, CANVAS_W, CANVAS_H, LV_COLOR_FORMAT_RGB565);
+
+static lv_display_t * disp;
+static lv_obj_t * canvas;
+static lv_cache_t * mask_cache;
+static uint32_t rnd_state;
+
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return rnd_state >> 8;
+}
+
+static void mask_cache_attach(bool attach)
+{
+    LV_GLOBAL_DEFAULT()->sw_mask_cache = attach ? mask_cache : NULL;
+}
+
+static void print_stats(const lv_cache_stats_t * before)
+{
+    lv_cache_stats_t s;
+    lv_draw_sw_mask_cache_get_stats(&s);
+    uint32_t hits = s.hits - before->hits;
+    uint32_t misses = s.misses - before->misses;
+    printf("  cache: %u hits, %u misses, %u evictions, %.1f %% hits, %u of %u bytes\n", (unsigned)hits,
+           (unsigned)misses, (unsigned)(s.evictions - before->evictions), hits + misses ? hits * 100.0 / (hits + misses) : 0.0,
+           (unsigned)s.size, (unsigned)s.max_size);
+}
+
+static void run_bar(bool cached)
+{
+    lv_cache_stats_t before;
+    lv_draw_sw_mask_cache_get_stats(&before);
+    mask_cache_attach(cached);
+    uint64_t best = UINT64_MAX;
+    for(uint32_t s = 0; s < SWEEPS; s++) {
+        uint64_t t = 0;
+        for(int32_t v = 0; v <= 100; v++) {
+            lv_bar_set_value(api_progress_label, v, LV_ANIM_OFF);
+            uint64_t t0 = host_ns();
+            lv_refr_now(disp);
+            t += host_ns() - t0;
+        }
+        if(t < best) best = t;
+    }
+    mask_cache_attach(true);
+    printf("bar, %-22s %7.1f us/frame\n", cached ? "cached" : "not cached", best / 1e3 / 101);
+    if(cached) print_stats(&before);
+}
+
+/** Random rectangles like in mask_cache_test */
+static void draw_round(void)
+{
+    static const int32_t radii[] = {0, 1, 2, 3, 5, 8, 10, 12, 15, 20, LV_RADIUS_CIRCLE};
+    static const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_COVER, 254, 200, 128, 40};
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    for(uint32_t i = 0; i < RECTS; i++) {
+        lv_draw_rect_dsc_t dsc;
+        lv_draw_rect_dsc_init(&dsc);
+        dsc.radius = radii[rnd() % 11];
+        dsc.bg_color = lv_color_hex(rnd());
+        dsc.bg_opa = rnd() % 4 ? opas[rnd() % 6] : LV_OPA_TRANSP;
+        if(rnd() % 2) {
+            dsc.border_width = 1 + rnd() % 6;
+            dsc.border_color = lv_color_hex(rnd());
+            dsc.border_opa = opas[rnd() % 6];
+            if(rnd() % 4 == 0) dsc.border_side = LV_BORDER_SIDE_TOP | LV_BORDER_SIDE_LEFT;
+        }
+        if(rnd() % 3 == 0) {
+            dsc.shadow_width = 1 + rnd() % 12;
+            dsc.shadow_spread = rnd() % 4;
+            dsc.shadow_offset_x = rnd() % 5;
+            dsc.shadow_offset_y = rnd() % 5;
+            dsc.shadow_color = lv_color_hex(rnd());
+            dsc.shadow_opa = opas[rnd() % 6];
+        }
+
+        lv_area_t coords;
+        coords.x1 = (int32_t)(rnd() % 300) - 20;
+        coords.y1 = (int32_t)(rnd() % 220) - 20;
+        coords.x2 = coords.x1 + 1 + rnd() % 120;
+        coords.y2 = coords.y1 + 1 + rnd() % 80;
+        lv_draw_rect(&layer, &dsc, &coords);
+    }
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+static void run_canvas(bool cached)
+{
+    lv_cache_stats_t before;
+    lv_draw_sw_mask_cache_get_stats(&before);
+    mask_cache_attach(cached);
+    uint64_t best = UINT64_MAX;
+    for(uint32_t s = 0; s < SWEEPS; s++) {
+        rnd_state = 1;
+        uint64_t t0 = host_ns();
+        for(uint32_t r = 0; r < ROUNDS; r++) draw_round();
+        uint64_t t = host_ns() - t0;
+        if(t < best) best = t;
+    }
+    mask_cache_attach(true);
+    printf("random rects, %-13s %7.1f us/canvas\n", cached ? "cached" : "not cached", best / 1e3 / ROUNDS);
+    if(cached) print_stats(&before);
+}
+
+int main(void)
+{
+    disp = host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+    host_fs_init('A', "../../assets");
+    mask_cache = LV_GLOBAL_DEFAULT()->sw_mask_cache;
+
+    lv_screen_load(loading_screen_create());
+    lv_refr_now(disp);
+    run_bar(false);
+    run_bar(true);
+
+    LV_DRAW_BUF_INIT_STATIC(canvas_buf);
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+    lv_canvas_set_draw_buf(canvas, &canvas_buf);
+    lv_memzero(canvas_buf.data, canvas_buf.data_size);
+    run_canvas(false);
+    run_canvas(true);
+    return 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file mask_cache_test.c
+ * Checks of the cache of rounded corner masks and blurred shadow corners (LV_DRAW_SW_MASK_CACHE_SIZE).
+ * Everything is drawn twice, with the cache and with it detached, when every mask is rendered
+ * for each row again like without the cache. The pixels must be equal:
+ * - the loading screen's progress bar at every value from 0 to 100
+ * - random rectangles on a canvas over a noisy background: radii from 0 to a circle, fills, borders
+ *   (also on two sides only) and shadows with opacities 255, 254, 200, 128 and 40, partly outside
+ *   of the canvas and with random clip areas
+ * The cache must also be hit while the bar moves.
+ */
+
+#include "host.h"
+#include "src/core/lv_global.h"
+#include "src/draw/sw/lv_draw_sw_mask.h"
+
+/*The generated UI is compiled into this translation unit too*/
+#include "../../main/ui_styles_gen.c"
+#include "../../main/ui_screens_gen.c"
+
+#define CANVAS_W    HOST_HOR_RES
+#define CANVAS_H    HOST_VER_RES
+#define ROUNDS      300
+#define RECTS       6
+
+LV_DRAW_BUF_DEFINE_STATIC(canvas_buf, CANVAS_W, CANVAS_H, LV_COLOR_FORMAT_RGB565);
+
+static lv_display_t * disp;
+static lv_obj_t * canvas;
+static lv_cache_t * mask_cache;
+static uint16_t cached_px[CANVAS_W * CANVAS_H];
+static uint32_t rnd_state;
+
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return rnd_state >> 8;
+}
+
+/** Without the cache every mask is rendered row by row, like with LV_DRAW_SW_MASK_CACHE_SIZE 0 */
+static void mask_cache_attach(bool attach)
+{
+    LV_GLOBAL_DEFAULT()->sw_mask_cache = attach ? mask_cache : NULL;
+}
+
+/** Draw random rectangles, the same ones for the same seed */
+static void draw_round(uint32_t seed)
+{
+    static const int32_t radii[] = {0, 1, 2, 3, 5, 8, 10, 12, 15, 20, LV_RADIUS_CIRCLE};
+    static const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_COVER, 254, 200, 128, 40};
+
+    rnd_state = seed;
+    uint16_t * px = (uint16_t *)canvas_buf.data;
+    for(uint32_t i = 0; i < CANVAS_W * CANVAS_H; i++) px[i] = rnd();
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    for(uint32_t i = 0; i < RECTS; i++) {
+        lv_draw_rect_dsc_t dsc;
+        lv_draw_rect_dsc_init(&dsc);
+        dsc.radius = radii[rnd() % 11];
+        dsc.bg_color = lv_color_hex(rnd());
+        dsc.bg_opa = rnd() % 4 ? opas[rnd() % 6] : LV_OPA_TRANSP;
+        if(rnd() % 2) {
+            dsc.border_width = 1 + rnd() % 6;
+            dsc.border_color = lv_color_hex(rnd());
+            dsc.border_opa = opas[rnd() % 6];
+            if(rnd() % 4 == 0) dsc.border_side = LV_BORDER_SIDE_TOP | LV_BORDER_SIDE_LEFT;
+        }
+        if(rnd() % 3 == 0) {
+            dsc.shadow_width = 1 + rnd() % 12;
+            dsc.shadow_spread = rnd() % 4;
+            dsc.shadow_offset_x = rnd() % 5;
+            dsc.shadow_offset_y = rnd() % 5;
+            dsc.shadow_color = lv_color_hex(rnd());
+            dsc.shadow_opa = opas[rnd() % 6];
+        }
+
+        lv_area_t coords;
+        coords.x1 = (int32_t)(rnd() % 300) - 20;
+        coords.y1 = (int32_t)(rnd() % 220) - 20;
+        coords.x2 = coords.x1 + 1 + rnd() % 120;
+        coords.y2 = coords.y1 + 1 + rnd() % 80;
+
+        lv_area_t clip;
+        clip.x1 = rnd() % CANVAS_W;
+        clip.y1 = rnd() % CANVAS_H;
+        clip.x2 = clip.x1 + rnd() % CANVAS_W;
+        clip.y2 = clip.y1 + rnd() % CANVAS_H;
+        if(clip.x2 >= CANVAS_W) clip.x2 = CANVAS_W - 1;
+        if(clip.y2 >= CANVAS_H) clip.y2 = CANVAS_H - 1;
+        if(rnd() % 2) lv_area_set(&clip, 0, 0, CANVAS_W - 1, CANVAS_H - 1);
+        layer._clip_area = clip;
+
+        lv_draw_rect(&layer, &dsc, &coords);
+    }
+    lv_canvas_finish_layer(canvas, &layer);
+}
+
+static uint32_t bar_frame_hash(int32_t value)
+{
+    lv_bar_set_value(api_progress_label, value, LV_ANIM_OFF);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+    return host_frame_hash();
+}
+
+int main(void)
+{
+    disp = host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+    host_fs_init('A', "../../assets");
+    mask_cache = LV_GLOBAL_DEFAULT()->sw_mask_cache;
+    HOST_CHECK(mask_cache != NULL, "the mask cache wasn't created");
+
+    lv_screen_load(loading_screen_create());
+    lv_refr_now(disp);
+
+    lv_cache_stats_t before, after;
+    lv_draw_sw_mask_cache_get_stats(&before);
+    for(int32_t v = 0; v <= 100; v++) {
+        mask_cache_attach(true);
+        uint32_t cached = bar_frame_hash(v);
+        mask_cache_attach(false);
+        uint32_t uncached = bar_frame_hash(v);
+        HOST_CHECK(cached == uncached, "the bar at %d differs with the mask cache", (int)v);
+    }
+    mask_cache_attach(true);
+    lv_draw_sw_mask_cache_get_stats(&after);
+    HOST_CHECK(after.hits > before.hits, "the bar never hit the mask cache");
+
+    LV_DRAW_BUF_INIT_STATIC(canvas_buf);
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+    lv_canvas_set_draw_buf(canvas, &canvas_buf);
+
+    for(uint32_t r = 0; r < ROUNDS; r++) {
+        uint32_t seed = r * 7919 + 1;
+        mask_cache_attach(true);
+        draw_round(seed);
+        lv_memcpy(cached_px, canvas_buf.data, sizeof(cached_px));
+        mask_cache_attach(false);
+        draw_round(seed);
+        mask_cache_attach(true);
+
+        const uint16_t * uncached_px = (const uint16_t *)canvas_buf.data;
+        uint32_t diff = 0;
+        for(uint32_t i = 0; i < CANVAS_W * CANVAS_H; i++) diff += cached_px[i] != uncached_px[i];
+        HOST_CHECK(diff == 0, "round %u: %u px differ with the mask cache", (unsigned)r, (unsigned)diff);
+    }
+
+    return host_finish("mask_cache_test");
+}
@@ -0,0 +1,75 @@
+/**
+ * @file numlabel_bench.c
+ * Updating a balance the way the home page does, with an lv_label and with an lv_numlabel:
+ * the time of setting the value, of setting and rendering it, and the pixels rendered per update.
+ * The numeric label is measured without and with its roll-over animation.
+ */
+
+#include "host.h"
+
+#define UPDATES 5000
+
+static lv_display_t * disp;
+static uint64_t rendered_px;
+
+static void count_flush_cb(lv_display_t * d, const lv_area_t * area, uint8_t * px_map)
+{
+    rendered_px += lv_area_get_size(area);
+    host_flush_cb(d, area, px_map);
+}
+
+static void set_label(lv_obj_t * obj, int64_t cents)
+{
+    char buf[32];
+    lv_snprintf(buf, sizeof(buf), "$%d.%02d", (int)(cents / 100), (int)(cents % 100));
+    lv_label_set_text(obj, buf);
+}
+
+static void run(const char * name, lv_obj_t * obj, bool numlabel, uint32_t frames_per_update)
+{
+    int64_t value = 123456;
+    uint64_t t_set = 0;
+    rendered_px = 0;
+    uint64_t t0 = host_ns();
+    for(uint32_t i = 0; i < UPDATES; i++) {
+        value += 7;
+        uint64_t t1 = host_ns();
+        if(numlabel) lv_numlabel_set_value(obj, value);
+        else set_label(obj, value);
+        t_set += host_ns() - t1;
+        /*The roll animation redraws the changed digits in every frame*/
+        if(frames_per_update == 1) {
+            lv_refr_now(disp);
+        }
+        else {
+            for(uint32_t f = 0; f < frames_per_update; f++) host_advance(20);
+        }
+    }
+    uint64_t t = host_ns() - t0;
+    printf("%-22s set %6.2f us, set and render %7.2f us, %6.0f px rendered per update\n", name,
+           t_set / 1e3 / UPDATES, t / 1e3 / UPDATES, (double)rendered_px / UPDATES);
+}
+
+int main(void)
+{
+    disp = host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, count_flush_cb);
+
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_obj_set_pos(label, 10, 100);
+    lv_refr_now(disp);
+    run("lv_label", label, false, 1);
+    lv_obj_delete(label);
+
+    lv_obj_t * num = lv_numlabel_create(lv_screen_active());
+    lv_numlabel_set_format(num, "$", 2, ',');
+    lv_obj_set_pos(num, 10, 100);
+    lv_refr_now(disp);
+    run("lv_numlabel", num, true, 1);
+
+    /*300 ms at 20 ms per frame*/
+    lv_numlabel_set_roll_time(num, 300);
+    run("lv_numlabel, rolling", num, true, 16);
+    lv_obj_delete(num);
+    return 0;
+}
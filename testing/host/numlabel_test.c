@@ -0,0 +1,103 @@
+/**
+ * @file numlabel_test.c
+ * Checks of lv_numlabel:
+ * - values are written with their sign, prefix, separators, decimals and suffix
+ * - a new value of the same width invalidates only the cells that changed, the same value nothing
+ * - after a roll, interrupted or not, the label renders exactly like one created with the final value
+ */
+
+#include "host.h"
+#include "src/widgets/numlabel/lv_numlabel_private.h"
+
+static lv_display_t * disp;
+
+static lv_obj_t * numlabel_create(int64_t value, uint32_t roll_time)
+{
+    lv_obj_t * obj = lv_numlabel_create(lv_screen_active());
+    lv_numlabel_set_format(obj, "$", 2, ',');
+    lv_numlabel_set_roll_time(obj, roll_time);
+    lv_numlabel_set_value(obj, value);
+    lv_obj_set_pos(obj, 10, 100);
+    return obj;
+}
+
+static uint32_t render(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+    return host_frame_hash();
+}
+
+static void check_text(int64_t value, const char * prefix, uint32_t decimals, char sep, const char * suffix,
+                       const char * expected)
+{
+    lv_obj_t * obj = lv_numlabel_create(lv_screen_active());
+    lv_numlabel_set_format(obj, prefix, decimals, sep);
+    lv_numlabel_set_suffix(obj, suffix);
+    lv_numlabel_set_value(obj, value);
+    HOST_CHECK(lv_streq(lv_numlabel_get_text(obj), expected), "%lld is written as \"%s\" instead of \"%s\"",
+               (long long)value, lv_numlabel_get_text(obj), expected);
+    lv_obj_delete(obj);
+}
+
+static void test_format(void)
+{
+    check_text(0, "$", 2, ',', NULL, "$0.00");
+    check_text(5, "$", 2, ',', NULL, "$0.05");
+    check_text(-123456, "$", 2, ',', NULL, "-$1,234.56");
+    check_text(100000000, "$", 2, ',', NULL, "$1,000,000.00");
+    check_text(1234567, NULL, 0, 0, "%", "1234567%");
+    check_text(INT64_MIN, NULL, 0, 0, NULL, "-9223372036854775808");
+}
+
+static void test_invalidates_changed_cells(void)
+{
+    lv_obj_t * obj = numlabel_create(123456, 0);
+    lv_refr_now(disp);
+    int32_t w = lv_obj_get_width(obj);
+
+    lv_numlabel_set_value(obj, 123456);
+    HOST_CHECK(disp->inv_p == 0, "the same value invalidated %u areas", (unsigned)disp->inv_p);
+
+    lv_numlabel_set_value(obj, 123457);
+    HOST_CHECK(disp->inv_p == 1, "one changed digit invalidated %u areas", (unsigned)disp->inv_p);
+    if(disp->inv_p == 1) {
+        int32_t inv_w = lv_area_get_width(&disp->inv_areas[0]);
+        HOST_CHECK(inv_w * 4 < w, "one changed digit invalidated %d of %d px", (int)inv_w, (int)w);
+    }
+    lv_refr_now(disp);
+    lv_obj_delete(obj);
+}
+
+static void test_roll_ends_clean(int64_t from, int64_t to, bool interrupt)
+{
+    lv_obj_t * direct = numlabel_create(to, 0);
+    uint32_t expected = render();
+    lv_obj_delete(direct);
+
+    lv_obj_t * obj = numlabel_create(from, 300);
+    lv_refr_now(disp);
+    lv_numlabel_set_value(obj, interrupt ? to + 1111 : to);
+    for(uint32_t t = 0; t < 600; t += 20) {
+        host_advance(20);
+        if(interrupt && t == 100) lv_numlabel_set_value(obj, to);
+    }
+    lv_refr_now(disp);
+    HOST_CHECK(host_frame_hash() == expected, "%lld -> %lld%s left stale pixels", (long long)from, (long long)to,
+               interrupt ? " (interrupted)" : "");
+    lv_obj_delete(obj);
+}
+
+int main(void)
+{
+    disp = host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    test_format();
+    test_invalidates_changed_cells();
+    test_roll_ends_clean(123456, 123499, false);
+    test_roll_ends_clean(123499, 123456, false);
+    test_roll_ends_clean(123456, 123499, true);
+    test_roll_ends_clean(99999, 100000, false);
+
+    return host_finish("numlabel_test");
+}
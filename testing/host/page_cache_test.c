@@ -0,0 +1,202 @@
+/**
+ * @file page_cache_test.c
+ * Checks of the page cache (LV_USE_PAGE_CACHE) with the app's UI, rendered in partial mode like the firmware.
+ * The same random page switches, changes and idle times are played without a page cache, which is what the
+ * firmware renders with LV_USE_PAGE_CACHE 0 (the hooks of lv_refr.c and lv_obj_pos.c return at once), then
+ * with the firmware's 48 KB cache and with one too small for every page. Every frame must be identical:
+ * - changes of pages which are not shown (table cells, a numlabel's roll, a scroll), loaded right after or later
+ * - changes of the shown page and of the nav bar in the top layer
+ * - the prerender timer filling in the bands of a changed page in the background, so the next switch
+ *   to it is only copied, and a change right after that
+ * - the least recently shown pages evicted from the small cache, and rendered again when loaded
+ */
+
+#include "host.h"
+
+/*The generated UI is compiled into this translation unit too*/
+#include "../../main/ui_styles_gen.c"
+#include "../../main/ui_screens_gen.c"
+
+#define STEPS           600
+#define FRAME_TIME      LV_DEF_REFR_PERIOD
+#define IDLE_TIME       300
+#define SMALL_CACHE     (12 * 1024)
+
+static lv_display_t * disp;
+static lv_obj_t * blank_screen;
+static uint8_t page_cache_buf[48 * 1024];
+static uint32_t ref_hash[STEPS + 8];
+static uint32_t frame_cnt;
+static bool ref_set;
+
+static uint32_t rnd_state;
+
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return rnd_state >> 8;
+}
+
+static const char * transaction_cell_cb(lv_obj_t * obj, uint32_t row, uint32_t col, char * buf, uint32_t buf_size)
+{
+    if(col == 0) lv_snprintf(buf, buf_size, "%02u/%02u", (unsigned)(row % 12 + 1), (unsigned)(row % 28 + 1));
+    else if(col == 1) lv_snprintf(buf, buf_size, "Merchant %u", (unsigned)row);
+    else lv_snprintf(buf, buf_size, "-$%u.%02u", (unsigned)(row * 37 % 500), (unsigned)(row * 13 % 100));
+    return buf;
+}
+
+static void pages_create(void)
+{
+    chrome_create();
+    lv_obj_remove_flag(nav_bar, LV_OBJ_FLAG_HIDDEN);
+    home_page_create();
+    lv_obj_remove_flag(total_balance_value, LV_OBJ_FLAG_HIDDEN);
+    accounts_page_create();
+    for(uint32_t i = 1; i <= 4; i++) {
+        lv_table_set_row_count(checking_table, i + 1);
+        lv_table_set_cell_value_fmt(checking_table, i, 0, "Bank %u", (unsigned)i);
+        lv_table_set_cell_value(checking_table, i, 1, "$1,234.00");
+    }
+    transactions_page_create();
+    lv_table_set_cell_data_cb(transactions_table, transaction_cell_cb);
+    lv_table_set_row_count(transactions_table, 200);
+}
+
+static void pages_delete(void)
+{
+    lv_screen_load(blank_screen);
+    lv_obj_delete(home_page);
+    lv_obj_delete(accounts_page);
+    lv_obj_delete(transactions_page);
+    lv_obj_clean(lv_layer_top());
+    host_advance(FRAME_TIME);
+}
+
+/** Compare the frame with the one of the run without a cache */
+static void check_frame(const char * what)
+{
+    uint32_t hash = host_frame_hash();
+    if(!ref_set) ref_hash[frame_cnt] = hash;
+    else HOST_CHECK(hash == ref_hash[frame_cnt], "frame %u (%s) differs from the one without a page cache",
+                        (unsigned)frame_cnt, what);
+    frame_cnt++;
+}
+
+static void idle(uint32_t ms)
+{
+    for(uint32_t t = 0; t < ms; t += FRAME_TIME) host_advance(FRAME_TIME);
+}
+
+/** Change something at random, then render one frame or idle for a while */
+static void random_step(void)
+{
+    lv_obj_t * pages[] = {home_page, accounts_page, transactions_page};
+
+    switch(rnd() % 8) {
+        case 0:
+        case 1:
+            lv_screen_load(pages[rnd() % 3]);
+            break;
+        case 2:
+            lv_table_set_cell_value_fmt(checking_table, 1 + rnd() % 4, 1, "$%u.%02u", (unsigned)(rnd() % 5000),
+                                        (unsigned)(rnd() % 100));
+            break;
+        case 3:
+            lv_table_set_row_count(credit_table, 1 + rnd() % 4);
+            break;
+        case 4:
+            lv_label_set_text_fmt(counter_label, "Count: %u", (unsigned)(rnd() % 1000));
+            break;
+        case 5:
+            lv_numlabel_set_value(total_balance_value, rnd() % 10000000);
+            break;
+        case 6:
+            lv_obj_scroll_by_bounded(transactions_table, 0, rnd() % 2 ? -80 : 80, rnd() % 2 ? LV_ANIM_ON : LV_ANIM_OFF);
+            break;
+        case 7:
+            lv_label_set_text_fmt(time_label, "12:%02u", (unsigned)(rnd() % 60));
+            break;
+    }
+
+    if(rnd() % 4 == 0) idle(IDLE_TIME);
+    else host_advance(FRAME_TIME);
+    check_frame("random step");
+}
+
+static void run(uint32_t cache_size)
+{
+    frame_cnt = 0;
+    rnd_state = 1;
+    pages_create();
+
+    lv_page_cache_t * cache = NULL;
+    if(cache_size) {
+        cache = lv_page_cache_create(disp, page_cache_buf, cache_size);
+        lv_page_cache_add_page(cache, home_page);
+        lv_page_cache_add_page(cache, accounts_page);
+        lv_page_cache_add_page(cache, transactions_page);
+    }
+
+    lv_screen_load(home_page);
+    idle(IDLE_TIME);
+    check_frame("first load");
+
+    for(uint32_t i = 0; i < STEPS; i++) random_step();
+
+    /*Show every page, change the accounts page from another one and give the timer time to render it again*/
+    lv_screen_load(accounts_page);
+    idle(IDLE_TIME);
+    lv_screen_load(transactions_page);
+    idle(IDLE_TIME);
+    lv_screen_load(home_page);
+    host_advance(FRAME_TIME);
+    lv_table_set_cell_value(checking_table, 2, 1, "$99,999.99");
+    lv_table_set_row_count(credit_table, 3);
+    idle(IDLE_TIME);
+
+    lv_cache_stats_t before;
+    lv_cache_stats_t after;
+    if(cache) lv_page_cache_get_stats(cache, &before);
+    lv_screen_load(accounts_page);
+    host_advance(FRAME_TIME);
+    check_frame("changed page rendered in the background");
+    /*The small cache doesn't evict other pages for a page which is not shown*/
+    if(cache && cache_size == sizeof(page_cache_buf)) {
+        lv_page_cache_get_stats(cache, &after);
+        HOST_CHECK(after.hits > before.hits && after.misses == before.misses,
+                   "prerendered page not copied: %u hits, %u misses", (unsigned)(after.hits - before.hits),
+                   (unsigned)(after.misses - before.misses));
+    }
+
+    /*A change right after the background rendering and loaded at once*/
+    lv_screen_load(home_page);
+    host_advance(FRAME_TIME);
+    lv_table_set_cell_value(checking_table, 3, 0, "Savings");
+    lv_screen_load(accounts_page);
+    host_advance(FRAME_TIME);
+    check_frame("page changed just before the load");
+
+    if(cache) {
+        lv_page_cache_get_stats(cache, &after);
+        if(cache_size == SMALL_CACHE) HOST_CHECK(after.evictions > 0, "the small cache never evicted a page");
+        else HOST_CHECK(after.evictions == 0, "the 48 KB cache evicted %u pages", (unsigned)after.evictions);
+        printf("page_cache_test: %2u KB cache: %u hits, %u misses, %u evictions\n", (unsigned)(cache_size / 1024),
+               (unsigned)after.hits, (unsigned)after.misses, (unsigned)after.evictions);
+        lv_page_cache_delete(cache);
+    }
+
+    pages_delete();
+    ref_set = true;
+}
+
+int main(void)
+{
+    disp = host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+    blank_screen = lv_screen_active();
+
+    run(0);
+    run(sizeof(page_cache_buf));
+    run(SMALL_CACHE);
+
+    return host_finish("page_cache_test");
+}
@@ -0,0 +1,234 @@
+/**
+ * @file rotation_test.c
+ * Checks of the display rotation done by the panel, the way main.c drives the ILI9341.
+ * A model of the panel's memory (240 columns x 320 rows) maps the written pixels with MADCTL.
+ * Displays created with `lv_ili9341_create` in partial mode and in direct mode (sending the changed
+ * areas of the frame with its stride like main.c) must fill the panel exactly like a reference
+ * display that keeps the landscape address mode and moves every pixel with `lv_display_rotate_area`:
+ * - for 0, 90, 180 and 270 degrees, and when going back to 90 and 0
+ * - for a full redraw and for an update of one object after it
+ * - MADCTL is the one of the rotation and nothing is written outside of the panel's memory
+ */
+
+#include "host.h"
+#include "src/drivers/display/lcd/lv_lcd_generic_mipi.h"
+
+#define PANEL_COLS 240
+#define PANEL_ROWS 320
+
+#define MADCTL_MY 0x80
+#define MADCTL_MX 0x40
+#define MADCTL_MV 0x20
+
+typedef struct {
+    uint16_t gram[PANEL_ROWS][PANEL_COLS];
+    uint8_t madctl;
+    int32_t col_start;
+    int32_t col_end;
+    int32_t page_start;
+    int32_t page_end;
+    uint32_t outside;           /*Pixels written outside of the memory*/
+} panel_t;
+
+static panel_t ref_panel;
+static panel_t partial_panel;
+static panel_t direct_panel;
+static uint16_t partial_buf[HOST_HOR_RES * 20];
+static uint16_t direct_frame[HOST_HOR_RES * HOST_VER_RES];
+static uint16_t bounce[HOST_HOR_RES * HOST_VER_RES];
+
+static void panel_cmd(panel_t * panel, uint8_t cmd, const uint8_t * param, size_t param_size)
+{
+    if(cmd == LV_LCD_CMD_SET_ADDRESS_MODE && param_size >= 1) {
+        panel->madctl = param[0];
+    }
+    else if(cmd == LV_LCD_CMD_SET_COLUMN_ADDRESS && param_size >= 4) {
+        panel->col_start = param[0] << 8 | param[1];
+        panel->col_end = param[2] << 8 | param[3];
+    }
+    else if(cmd == LV_LCD_CMD_SET_PAGE_ADDRESS && param_size >= 4) {
+        panel->page_start = param[0] << 8 | param[1];
+        panel->page_end = param[2] << 8 | param[3];
+    }
+}
+
+/** Write pixels to the window from its start, mapped to the memory by MADCTL */
+static void panel_write(panel_t * panel, const uint16_t * px, size_t px_cnt)
+{
+    int32_t x = panel->col_start;
+    int32_t y = panel->page_start;
+    for(size_t i = 0; i < px_cnt; i++) {
+        int32_t col = (panel->madctl & MADCTL_MV) ? y : x;
+        int32_t row = (panel->madctl & MADCTL_MV) ? x : y;
+        if(panel->madctl & MADCTL_MX) col = PANEL_COLS - 1 - col;
+        if(panel->madctl & MADCTL_MY) row = PANEL_ROWS - 1 - row;
+        if(col < 0 || col >= PANEL_COLS || row < 0 || row >= PANEL_ROWS) panel->outside++;
+        else panel->gram[row][col] = px[i];
+
+        if(++x > panel->col_end) {
+            x = panel->col_start;
+            y++;
+        }
+    }
+}
+
+static void lcd_send_cmd(lv_display_t * disp, const uint8_t * cmd, size_t cmd_size, const uint8_t * param,
+                         size_t param_size)
+{
+    /*The init sequence is sent by `lv_ili9341_create`, before the panel is attached*/
+    panel_t * panel = lv_display_get_user_data(disp);
+    if(panel) panel_cmd(panel, cmd[0], param, param_size);
+}
+
+static void lcd_send_color(lv_display_t * disp, const uint8_t * cmd, size_t cmd_size, uint8_t * param,
+                           size_t param_size)
+{
+    panel_write(lv_display_get_user_data(disp), (const uint16_t *)param, param_size / sizeof(uint16_t));
+    lv_display_flush_ready(disp);
+}
+
+/** main.c's direct mode flush: the rows of the area are packed from the frame with its stride */
+static void direct_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    int32_t stride = lv_display_get_buf_active(disp)->header.stride / sizeof(uint16_t);
+    int32_t w = lv_area_get_width(area);
+    const uint16_t * src = (const uint16_t *)px_map;
+    for(int32_t y = area->y1; y <= area->y2; y++) {
+        memcpy(&bounce[(y - area->y1) * w], &src[y * stride + area->x1], w * sizeof(uint16_t));
+    }
+    panel_cmd(&direct_panel, LV_LCD_CMD_SET_COLUMN_ADDRESS,
+              (uint8_t[]) {area->x1 >> 8, area->x1 & 0xFF, area->x2 >> 8, area->x2 & 0xFF}, 4);
+    panel_cmd(&direct_panel, LV_LCD_CMD_SET_PAGE_ADDRESS,
+              (uint8_t[]) {area->y1 >> 8, area->y1 & 0xFF, area->y2 >> 8, area->y2 & 0xFF}, 4);
+    panel_write(&direct_panel, bounce, w * lv_area_get_height(area));
+    lv_display_flush_ready(disp);
+}
+
+/** The reference: landscape address mode and every pixel moved to its rotated place one by one */
+static void ref_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    const uint16_t * px = (const uint16_t *)px_map;
+    int32_t w = lv_area_get_width(area);
+    for(int32_t y = area->y1; y <= area->y2; y++) {
+        for(int32_t x = area->x1; x <= area->x2; x++) {
+            lv_area_t a = {x, y, x, y};
+            lv_display_rotate_area(disp, &a);
+            panel_cmd(&ref_panel, LV_LCD_CMD_SET_COLUMN_ADDRESS, (uint8_t[]) {a.x1 >> 8, a.x1 & 0xFF, a.x1 >> 8, a.x1 & 0xFF}, 4);
+            panel_cmd(&ref_panel, LV_LCD_CMD_SET_PAGE_ADDRESS, (uint8_t[]) {a.y1 >> 8, a.y1 & 0xFF, a.y1 >> 8, a.y1 & 0xFF}, 4);
+            panel_write(&ref_panel, &px[(y - area->y1) * w + (x - area->x1)], 1);
+        }
+    }
+    lv_display_flush_ready(disp);
+}
+
+/** The driver waits after some commands of its init sequence, the tick only moves when it's advanced */
+static void delay_cb(uint32_t ms)
+{
+    host_ticks += ms;
+}
+
+static lv_display_t * ili9341_create(panel_t * panel)
+{
+    lv_display_t * disp = lv_ili9341_create(HOST_HOR_RES, HOST_VER_RES, LV_LCD_FLAG_NONE, lcd_send_cmd, lcd_send_color);
+    lv_display_set_user_data(disp, panel);
+    /*Like main.c: landscape is the native orientation, rows and columns are swapped by the panel*/
+    lv_lcd_generic_mipi_set_address_mode(disp, false, false, true, false);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    return disp;
+}
+
+/** Corner boxes of different sizes and a label, so any mirrored or swapped axis shows */
+static void scene_create(lv_display_t * disp)
+{
+    static const uint32_t colors[4] = {0xff0000, 0x00ff00, 0x0000ff, 0xffff00};
+    static const lv_align_t aligns[4] = {LV_ALIGN_TOP_LEFT, LV_ALIGN_TOP_RIGHT, LV_ALIGN_BOTTOM_LEFT, LV_ALIGN_BOTTOM_RIGHT};
+
+    lv_obj_t * screen = lv_display_get_screen_active(disp);
+    lv_obj_clean(screen);
+    lv_obj_set_style_bg_color(screen, lv_color_hex(0x101040), 0);
+    for(uint32_t i = 0; i < 4; i++) {
+        lv_obj_t * box = lv_obj_create(screen);
+        lv_obj_set_size(box, 30 + i * 10, 20 + i * 5);
+        lv_obj_set_style_bg_color(box, lv_color_hex(colors[i]), 0);
+        lv_obj_align(box, aligns[i], 0, 0);
+    }
+    lv_obj_t * label = lv_label_create(screen);
+    lv_label_set_text(label, "Rotation 0123 Finance Hub");
+    lv_obj_align(label, LV_ALIGN_TOP_LEFT, 35, 30);
+}
+
+static void scene_update(lv_display_t * disp)
+{
+    lv_obj_set_style_bg_color(lv_obj_get_child(lv_display_get_screen_active(disp), 1), lv_color_hex(0xff00ff), 0);
+}
+
+static uint32_t panel_diff(const panel_t * a, const panel_t * b)
+{
+    uint32_t diff = 0;
+    for(int32_t row = 0; row < PANEL_ROWS; row++) {
+        for(int32_t col = 0; col < PANEL_COLS; col++) diff += a->gram[row][col] != b->gram[row][col];
+    }
+    return diff;
+}
+
+static void check_panel(const char * mode, const panel_t * panel, uint32_t degrees, uint8_t madctl, const char * when)
+{
+    uint32_t diff = panel_diff(panel, &ref_panel);
+    HOST_CHECK(diff == 0, "%s mode at %u degrees: %u px differ from the reference after %s", mode, (unsigned)degrees,
+               (unsigned)diff, when);
+    HOST_CHECK(panel->outside == 0, "%s mode at %u degrees: %u px written outside of the panel after %s", mode,
+               (unsigned)degrees, (unsigned)panel->outside, when);
+    HOST_CHECK(panel->madctl == madctl, "%s mode at %u degrees: MADCTL 0x%02x instead of 0x%02x", mode,
+               (unsigned)degrees, (unsigned)panel->madctl, (unsigned)madctl);
+}
+
+int main(void)
+{
+    static const struct {
+        lv_display_rotation_t rotation;
+        uint32_t degrees;
+        uint8_t madctl;
+    } steps[] = {
+        {LV_DISPLAY_ROTATION_0,   0,   MADCTL_MV},
+        {LV_DISPLAY_ROTATION_90,  90,  MADCTL_MX},
+        {LV_DISPLAY_ROTATION_180, 180, MADCTL_MV | MADCTL_MX | MADCTL_MY},
+        {LV_DISPLAY_ROTATION_270, 270, MADCTL_MY},
+        {LV_DISPLAY_ROTATION_90,  90,  MADCTL_MX},
+        {LV_DISPLAY_ROTATION_0,   0,   MADCTL_MV},
+    };
+
+    lv_display_t * ref = host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(ref, ref_flush_cb);
+    ref_panel.madctl = MADCTL_MV;
+    lv_delay_set_cb(delay_cb);
+
+    lv_display_t * partial = ili9341_create(&partial_panel);
+    lv_display_set_buffers(partial, partial_buf, NULL, sizeof(partial_buf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    lv_display_t * direct = ili9341_create(&direct_panel);
+    lv_display_set_buffers(direct, direct_frame, NULL, sizeof(direct_frame), LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_flush_cb(direct, direct_flush_cb);
+
+    lv_display_t * disps[] = {ref, partial, direct};
+    panel_t * panels[] = {&ref_panel, &partial_panel, &direct_panel};
+
+    for(uint32_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+        for(uint32_t d = 0; d < 3; d++) {
+            lv_memzero(panels[d]->gram, sizeof(panels[d]->gram));
+            lv_display_set_rotation(disps[d], steps[i].rotation);
+            scene_create(disps[d]);
+            lv_refr_now(disps[d]);
+        }
+        check_panel("partial", &partial_panel, steps[i].degrees, steps[i].madctl, "a full redraw");
+        check_panel("direct", &direct_panel, steps[i].degrees, steps[i].madctl, "a full redraw");
+
+        for(uint32_t d = 0; d < 3; d++) {
+            scene_update(disps[d]);
+            lv_refr_now(disps[d]);
+        }
+        check_panel("partial", &partial_panel, steps[i].degrees, steps[i].madctl, "an update");
+        check_panel("direct", &direct_panel, steps[i].degrees, steps[i].madctl, "an update");
+    }
+
+    return host_finish("rotation_test");
+}
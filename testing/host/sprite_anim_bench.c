@@ -0,0 +1,132 @@
+/**
+ * @file sprite_anim_bench.c
+ * Frame decoding of lv_gif (into RGB565) against lv_sprite_anim playing the same animation
+ * converted by `LVGLImage.py --ofmt ANIM` without compression, with RLE and with LZ4.
+ * Prints the decode time per frame, the LVGL heap each player takes and the file size.
+ * The frames of every .anim file are compared with the ones lv_gif decodes.
+ *
+ * The small loading animation of the app is played by both. The full-screen GIF's canvas does not fit in
+ * the 64 KB heap, so only lv_sprite_anim plays it, into a buffer set by `lv_sprite_anim_set_buffer()`.
+ * The make target converts the GIFs into obj/anim/{none,rle,lz4}/ first.
+ */
+
+#include "host.h"
+#include "src/libs/gif/lv_gif_private.h"
+#include "src/libs/sprite_anim/lv_sprite_anim_private.h"
+#include "src/misc/lv_timer_private.h"
+
+#define MAX_FRAMES 256
+
+static uint32_t gif_hashes[MAX_FRAMES];
+static uint8_t full_canvas[HOST_HOR_RES * HOST_VER_RES * 2];
+
+static uint32_t canvas_hash(const uint8_t * data, uint32_t size)
+{
+    uint32_t h = 2166136261u;
+    for(uint32_t i = 0; i < size; i++) h = (h ^ data[i]) * 16777619u;
+    return h;
+}
+
+static long file_size(const char * path)
+{
+    FILE * f = fopen(path, "rb");
+    if(f == NULL) return -1;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    return size;
+}
+
+/**
+ * Run the frame timer of a player `frames` times, with enough ticks in between that every call decodes
+ * @return  nanoseconds spent in the timer callbacks
+ */
+static uint64_t decode_frames(lv_timer_t * timer, uint32_t frames, const uint8_t * canvas, uint32_t canvas_size,
+                              uint32_t * hashes)
+{
+    uint64_t total = 0;
+    for(uint32_t i = 0; i < frames; i++) {
+        host_ticks += 10000;
+        uint64_t t0 = host_ns();
+        timer->timer_cb(timer);
+        total += host_ns() - t0;
+        if(hashes) hashes[i] = canvas_hash(canvas, canvas_size);
+    }
+    return total;
+}
+
+static uint32_t run_gif(const char * name, uint32_t frames)
+{
+    char path[128];
+    lv_snprintf(path, sizeof(path), "H:../../assets/%s.gif", name);
+    uint32_t heap_before = host_heap_used();
+    lv_obj_t * obj = lv_gif_create(lv_screen_active());
+    lv_gif_set_color_format(obj, LV_COLOR_FORMAT_RGB565);
+    lv_gif_set_src(obj, path);
+    lv_gif_t * gif = (lv_gif_t *)obj;
+    if(!lv_gif_is_loaded(obj)) {
+        printf("%-8s lv_gif: could not load %s\n", name, path);
+        lv_obj_delete(obj);
+        return 0;
+    }
+    uint32_t heap = host_heap_used() - heap_before;
+    /*The first frame was decoded by lv_gif_set_src*/
+    gif_hashes[0] = canvas_hash(gif->imgdsc.data, gif->imgdsc.data_size);
+    uint64_t t = decode_frames(gif->timer, frames - 1, gif->imgdsc.data, gif->imgdsc.data_size, gif_hashes + 1);
+    printf("%-8s lv_gif        %8.3f ms/frame, heap %6u bytes, file %7ld bytes\n", name, t / 1e6 / (frames - 1),
+           (unsigned)heap, file_size(path + 2));
+    lv_obj_delete(obj);
+    return frames;
+}
+
+static void run_anim(const char * name, const char * compress, uint32_t gif_frames, bool user_buf)
+{
+    char path[128];
+    lv_snprintf(path, sizeof(path), "H:obj/anim/%s/%s.anim", compress, name);
+    uint32_t heap_before = host_heap_used();
+    lv_obj_t * obj = lv_sprite_anim_create(lv_screen_active());
+    if(user_buf) lv_sprite_anim_set_buffer(obj, full_canvas, sizeof(full_canvas));
+    lv_sprite_anim_set_src(obj, path);
+    lv_sprite_anim_t * anim = (lv_sprite_anim_t *)obj;
+    if(!lv_sprite_anim_is_loaded(obj)) {
+        printf("%-8s %-4s anim: could not load %s\n", name, compress, path);
+        lv_obj_delete(obj);
+        return;
+    }
+    uint32_t heap = host_heap_used() - heap_before;
+    uint32_t frames = anim->frame_count;
+    uint32_t size = anim->imgdsc.data_size;
+
+    uint32_t matching = 0;
+    if(gif_frames) matching += canvas_hash(anim->canvas, size) == gif_hashes[0];
+    static uint32_t hashes[MAX_FRAMES];
+    uint64_t t = decode_frames(anim->timer, frames - 1, anim->canvas, size, hashes);
+    for(uint32_t i = 1; i < gif_frames && i < frames; i++) matching += hashes[i - 1] == gif_hashes[i];
+
+    printf("%-8s %-4s anim     %8.3f ms/frame, heap %6u bytes, file %7ld bytes", name, compress,
+           t / 1e6 / (frames - 1), (unsigned)heap, file_size(path + 2));
+    if(gif_frames) printf(", %u/%u frames match lv_gif", (unsigned)matching, (unsigned)frames);
+    printf("\n");
+    lv_obj_delete(obj);
+}
+
+int main(void)
+{
+    host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+    host_fs_init('H', "");
+
+    static const char * compress[] = {"none", "rle", "lz4"};
+
+    /*A GIF loops forever, so decode as many frames as the .anim holds*/
+    lv_obj_t * probe = lv_sprite_anim_create(lv_screen_active());
+    lv_sprite_anim_set_src(probe, "H:obj/anim/none/loading.anim");
+    uint32_t frames = LV_MIN(((lv_sprite_anim_t *)probe)->frame_count, MAX_FRAMES);
+    lv_obj_delete(probe);
+
+    uint32_t gif_frames = run_gif("loading", frames);
+    for(uint32_t i = 0; i < 3; i++) run_anim("loading", compress[i], gif_frames, false);
+
+    printf("ouiaiu   lv_gif        skipped, its 320x240 canvas does not fit in the LVGL heap\n");
+    for(uint32_t i = 0; i < 3; i++) run_anim("ouiaiu", compress[i], 0, true);
+    return 0;
+}
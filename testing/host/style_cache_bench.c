@@ -0,0 +1,121 @@
+/**
+ * @file style_cache_bench.c
+ * Frames of a menu, a table and a nav bar while buttons are pressed and released and a shared style changes,
+ * with the resolved style cache kept between frames and with it freed before every frame (every lookup
+ * resolves the value again, like without the cache). Prints the time per frame, the style lookups and
+ * hits per frame, and the heap the cached values take.
+ */
+
+#include "host.h"
+#include "src/core/lv_obj_style_private.h"
+
+#define FRAMES 600
+
+static lv_display_t * disp;
+static lv_style_t style_btn;
+static lv_style_t style_btn_pressed;
+static lv_style_t style_nav;
+static lv_obj_t * menu_buttons[6];
+static lv_obj_t * nav_buttons[4];
+
+static void scene_create(void)
+{
+    lv_style_init(&style_btn);
+    lv_style_set_bg_color(&style_btn, lv_color_hex(0x3060a0));
+    lv_style_set_radius(&style_btn, 6);
+    lv_style_set_border_width(&style_btn, 1);
+    lv_style_set_border_color(&style_btn, lv_color_hex(0x80a0c0));
+    lv_style_init(&style_btn_pressed);
+    lv_style_set_bg_color(&style_btn_pressed, lv_color_hex(0x60a0e0));
+    lv_style_set_text_color(&style_btn_pressed, lv_color_hex(0xffff00));
+    lv_style_init(&style_nav);
+    lv_style_set_bg_color(&style_nav, lv_color_hex(0x202830));
+    lv_style_set_pad_all(&style_nav, 2);
+    lv_style_set_text_color(&style_nav, lv_color_white());
+
+    lv_obj_t * menu = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(menu, 150, 180);
+    lv_obj_set_flex_flow(menu, LV_FLEX_FLOW_COLUMN);
+    for(uint32_t i = 0; i < 6; i++) {
+        menu_buttons[i] = lv_button_create(menu);
+        lv_obj_set_width(menu_buttons[i], LV_PCT(100));
+        lv_obj_add_style(menu_buttons[i], &style_btn, 0);
+        lv_obj_add_style(menu_buttons[i], &style_btn_pressed, LV_STATE_PRESSED);
+        lv_label_set_text_fmt(lv_label_create(menu_buttons[i]), "Menu item %u", (unsigned)i);
+    }
+
+    lv_obj_t * table = lv_table_create(lv_screen_active());
+    lv_obj_set_size(table, 165, 180);
+    lv_obj_align(table, LV_ALIGN_TOP_RIGHT, 0, 0);
+    lv_table_set_column_count(table, 2);
+    lv_table_set_column_width(table, 0, 90);
+    lv_table_set_column_width(table, 1, 70);
+    for(uint32_t row = 0; row < 8; row++) {
+        lv_table_set_cell_value_fmt(table, row, 0, "Acct %u", (unsigned)row);
+        lv_table_set_cell_value_fmt(table, row, 1, "$%u", (unsigned)(100 + row * 37));
+    }
+
+    lv_obj_t * nav = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(nav, 320, 56);
+    lv_obj_align(nav, LV_ALIGN_BOTTOM_MID, 0, 0);
+    lv_obj_add_style(nav, &style_nav, 0);
+    lv_obj_set_flex_flow(nav, LV_FLEX_FLOW_ROW);
+    static const char * nav_texts[] = {LV_SYMBOL_HOME " Home", LV_SYMBOL_LIST " Acct", LV_SYMBOL_SETTINGS " Set", LV_SYMBOL_BELL " Msg"};
+    for(uint32_t i = 0; i < 4; i++) {
+        nav_buttons[i] = lv_button_create(nav);
+        lv_obj_set_size(nav_buttons[i], 74, 48);
+        lv_obj_add_style(nav_buttons[i], &style_btn, 0);
+        lv_obj_add_style(nav_buttons[i], &style_btn_pressed, LV_STATE_PRESSED);
+        lv_obj_t * label = lv_label_create(nav_buttons[i]);
+        lv_label_set_text(label, nav_texts[i]);
+        lv_obj_center(label);
+    }
+}
+
+/** Press and release buttons, change the nav bar's shared style every 10th frame */
+static void churn(uint32_t i)
+{
+    if(i % 6 == 0) lv_obj_add_state(nav_buttons[(i / 6) % 4], LV_STATE_PRESSED);
+    if(i % 6 == 3) lv_obj_remove_state(nav_buttons[(i / 6) % 4], LV_STATE_PRESSED);
+    if(i % 8 == 0) lv_obj_add_state(menu_buttons[(i / 8) % 6], LV_STATE_PRESSED);
+    if(i % 8 == 4) lv_obj_remove_state(menu_buttons[(i / 8) % 6], LV_STATE_PRESSED);
+    if(i % 10 == 0) {
+        lv_style_set_text_color(&style_nav, lv_color_hex(0xffffff - i * 1000));
+        lv_obj_report_style_change(&style_nav);
+    }
+}
+
+static void run(bool keep_cache)
+{
+    lv_cache_stats_t before, after;
+    lv_obj_style_resolved_cache_get_stats(&before);
+    uint64_t t0 = host_ns();
+    for(uint32_t i = 0; i < FRAMES; i++) {
+        churn(i);
+        if(!keep_cache) lv_obj_style_resolved_cache_invalidate(lv_screen_active());
+        lv_obj_invalidate(lv_screen_active());
+        host_advance(34);
+    }
+    uint64_t t = host_ns() - t0;
+    lv_obj_style_resolved_cache_get_stats(&after);
+
+    uint32_t hits = after.hits - before.hits;
+    uint32_t lookups = hits + after.misses - before.misses;
+    uint32_t used = host_heap_used();
+    lv_obj_style_resolved_cache_invalidate(lv_screen_active());
+    uint32_t cached = used - host_heap_used();
+    printf("%-14s %7.1f us/frame, %5u lookups/frame, %5.1f %% hits, cached values %5u bytes\n",
+           keep_cache ? "cache kept" : "cache freed", t / 1e3 / FRAMES, (unsigned)(lookups / FRAMES),
+           lookups ? hits * 100.0 / lookups : 0.0, (unsigned)cached);
+}
+
+int main(void)
+{
+    disp = host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+    scene_create();
+    lv_refr_now(disp);
+
+    run(false);
+    run(true);
+    return 0;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file style_cache_test.c
+ * Checks of the resolved style cache (LV_OBJ_STYLE_RESOLVED_CACHE).
+ * After every kind of change that affects style values, every object is queried for the drawn
+ * properties in several parts. The values, partly coming from the cache, must equal the ones
+ * resolved again after the cache of every object was freed:
+ * - state changes, with and without a style for the new state
+ * - a changed shared style reported with `lv_obj_report_style_change`
+ * - local properties of a parent inherited by its children
+ * - removed styles
+ * - moving an object to a parent with other inherited values
+ * - a running and a finished transition
+ */
+
+#include "host.h"
+#include "src/core/lv_obj_private.h"
+#include "src/core/lv_obj_style_private.h"
+
+static lv_display_t * disp;
+static lv_style_t style_btn;
+static lv_style_t style_btn_pressed;
+static lv_style_t style_nav;
+static lv_obj_t * buttons[4];
+static lv_obj_t * nav;
+static lv_obj_t * menu;
+static lv_obj_t * table;
+
+static const lv_style_prop_t props[] = {
+    LV_STYLE_BG_COLOR, LV_STYLE_BG_OPA, LV_STYLE_TEXT_COLOR, LV_STYLE_TEXT_FONT, LV_STYLE_TEXT_OPA,
+    LV_STYLE_RADIUS, LV_STYLE_BORDER_WIDTH, LV_STYLE_BORDER_COLOR, LV_STYLE_PAD_LEFT, LV_STYLE_PAD_TOP,
+    LV_STYLE_OPA, LV_STYLE_WIDTH,
+};
+
+static const lv_part_t parts[] = {LV_PART_MAIN, LV_PART_ITEMS, LV_PART_SCROLLBAR};
+
+#define PROP_CNT (sizeof(props) / sizeof(props[0]))
+#define PART_CNT (sizeof(parts) / sizeof(parts[0]))
+#define MAX_OBJS 64
+
+static lv_style_value_t values[MAX_OBJS][PART_CNT][PROP_CNT];
+static lv_obj_t * objs[MAX_OBJS];
+static uint32_t obj_cnt;
+
+static void collect(lv_obj_t * obj)
+{
+    if(obj_cnt < MAX_OBJS) objs[obj_cnt++] = obj;
+    for(uint32_t i = 0; i < lv_obj_get_child_count(obj); i++) collect(lv_obj_get_child(obj, i));
+}
+
+static void query_all(void)
+{
+    for(uint32_t o = 0; o < obj_cnt; o++) {
+        for(uint32_t p = 0; p < PART_CNT; p++) {
+            for(uint32_t i = 0; i < PROP_CNT; i++) values[o][p][i] = lv_obj_get_style_prop(objs[o], parts[p], props[i]);
+        }
+    }
+}
+
+/** Compare the values now (from the cache where it has them) with the ones resolved without the cache */
+static void check_cache(const char * change)
+{
+    obj_cnt = 0;
+    collect(lv_screen_active());
+    query_all();
+
+    lv_obj_style_resolved_cache_invalidate(lv_screen_active());
+    for(uint32_t o = 0; o < obj_cnt; o++) {
+        for(uint32_t p = 0; p < PART_CNT; p++) {
+            for(uint32_t i = 0; i < PROP_CNT; i++) {
+                lv_style_value_t v = lv_obj_get_style_prop(objs[o], parts[p], props[i]);
+                HOST_CHECK(lv_memcmp(&v, &values[o][p][i], sizeof(v)) == 0,
+                           "after %s: object %u part 0x%x property %u is stale", change, (unsigned)o,
+                           (unsigned)parts[p], (unsigned)props[i]);
+            }
+        }
+    }
+}
+
+/** Render and query everything, so the next change finds every value in the cache */
+static void warm_up(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+    obj_cnt = 0;
+    collect(lv_screen_active());
+    query_all();
+}
+
+static void scene_create(void)
+{
+    static const lv_style_prop_t trans_props[] = {LV_STYLE_BG_COLOR, LV_STYLE_PROP_INV};
+    static lv_style_transition_dsc_t trans;
+    lv_style_transition_dsc_init(&trans, trans_props, lv_anim_path_linear, 200, 0, NULL);
+
+    lv_style_init(&style_btn);
+    lv_style_set_bg_color(&style_btn, lv_color_hex(0x3060a0));
+    lv_style_set_radius(&style_btn, 6);
+    lv_style_set_border_width(&style_btn, 1);
+    lv_style_set_transition(&style_btn, &trans);
+    lv_style_init(&style_btn_pressed);
+    lv_style_set_bg_color(&style_btn_pressed, lv_color_hex(0x60a0e0));
+    lv_style_set_text_color(&style_btn_pressed, lv_color_hex(0xffff00));
+    lv_style_set_transition(&style_btn_pressed, &trans);
+    lv_style_init(&style_nav);
+    lv_style_set_bg_color(&style_nav, lv_color_hex(0x202830));
+    lv_style_set_text_color(&style_nav, lv_color_white());
+
+    menu = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(menu, 150, 180);
+    lv_obj_set_flex_flow(menu, LV_FLEX_FLOW_COLUMN);
+    for(uint32_t i = 0; i < 4; i++) {
+        buttons[i] = lv_button_create(menu);
+        lv_obj_add_style(buttons[i], &style_btn, 0);
+        lv_obj_add_style(buttons[i], &style_btn_pressed, LV_STATE_PRESSED);
+        lv_label_set_text_fmt(lv_label_create(buttons[i]), "Item %u", (unsigned)i);
+    }
+
+    table = lv_table_create(lv_screen_active());
+    lv_obj_align(table, LV_ALIGN_TOP_RIGHT, 0, 0);
+    lv_table_set_cell_value(table, 0, 0, "Checking");
+    lv_table_set_cell_value(table, 0, 1, "$10.00");
+
+    nav = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(nav, 320, 50);
+    lv_obj_align(nav, LV_ALIGN_BOTTOM_MID, 0, 0);
+    lv_obj_add_style(nav, &style_nav, 0);
+    lv_label_set_text(lv_label_create(nav), "Finance Hub");
+}
+
+int main(void)
+{
+    disp = host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+    scene_create();
+
+    warm_up();
+    check_cache("the first render");
+
+    warm_up();
+    lv_obj_add_state(buttons[0], LV_STATE_PRESSED);
+    host_advance(100);
+    check_cache("a state change in the middle of a transition");
+    host_advance(300);
+    check_cache("a finished transition");
+
+    warm_up();
+    lv_obj_add_state(buttons[1], LV_STATE_CHECKED);
+    check_cache("a state change without a style");
+
+    warm_up();
+    lv_style_set_text_color(&style_nav, lv_color_hex(0xff8000));
+    lv_obj_report_style_change(&style_nav);
+    check_cache("a reported change of a shared style");
+
+    warm_up();
+    lv_obj_set_style_text_color(menu, lv_color_hex(0x00ff00), 0);
+    lv_obj_set_style_pad_left(menu, 12, 0);
+    check_cache("inherited local properties");
+
+    warm_up();
+    lv_obj_remove_style(buttons[2], &style_btn, 0);
+    check_cache("a removed style");
+
+    warm_up();
+    lv_obj_set_parent(lv_obj_get_child(buttons[3], 0), nav);
+    check_cache("moving a label to another parent");
+
+    warm_up();
+    lv_obj_remove_state(buttons[0], LV_STATE_PRESSED);
+    host_advance(400);
+    check_cache("a state removed with a transition");
+
+    return host_finish("style_cache_test");
+}
@@ -0,0 +1,81 @@
+/**
+ * @file table_bench.c
+ * Bulk loading a table the way the app fills its transaction list:
+ * cell by cell, the same inside a batch, and a virtual table which only sets the row count.
+ * Prints the load time, the time of the next refresh and the LVGL heap the table uses.
+ *
+ *   ./table_bench [rows]
+ */
+
+#include "host.h"
+
+static lv_display_t * disp;
+
+static void cell_text(uint32_t row, uint32_t col, char * buf, uint32_t buf_size)
+{
+    if(col == 0) lv_snprintf(buf, buf_size, "%02u/%02u", (unsigned)(row % 12 + 1), (unsigned)(row % 28 + 1));
+    else if(col == 1) lv_snprintf(buf, buf_size, "Merchant %u", (unsigned)row);
+    else lv_snprintf(buf, buf_size, "$%u.%02u", (unsigned)(row * 37 % 500), (unsigned)(row * 13 % 100));
+}
+
+static const char * virtual_cell_cb(lv_obj_t * obj, uint32_t row, uint32_t col, char * buf, uint32_t buf_size)
+{
+    cell_text(row, col, buf, buf_size);
+    return buf;
+}
+
+typedef enum {
+    LOAD_CELLS,
+    LOAD_BATCH,
+    LOAD_VIRTUAL,
+} load_mode_t;
+
+static void run(load_mode_t mode, uint32_t rows)
+{
+    static const char * names[] = {"cell by cell", "batch", "virtual"};
+    uint32_t heap_before = host_heap_used();
+
+    lv_obj_t * table = lv_table_create(lv_screen_active());
+    lv_obj_set_size(table, HOST_HOR_RES, HOST_VER_RES);
+    lv_table_set_column_count(table, 3);
+
+    char buf[32];
+    uint64_t t0 = host_ns();
+    if(mode == LOAD_VIRTUAL) {
+        lv_table_set_cell_data_cb(table, virtual_cell_cb);
+        lv_table_set_row_count(table, rows);
+    }
+    else {
+        if(mode == LOAD_BATCH) lv_table_begin_batch(table);
+        for(uint32_t row = 0; row < rows; row++) {
+            for(uint32_t col = 0; col < 3; col++) {
+                cell_text(row, col, buf, sizeof(buf));
+                lv_table_set_cell_value(table, row, col, buf);
+            }
+        }
+        if(mode == LOAD_BATCH) lv_table_commit_batch(table);
+    }
+    uint64_t t_load = host_ns() - t0;
+
+    t0 = host_ns();
+    lv_refr_now(disp);
+    uint64_t t_refr = host_ns() - t0;
+
+    printf("%-13s %5u rows: load %8.3f ms, refresh %6.3f ms, heap %6u bytes\n", names[mode], (unsigned)rows,
+           t_load / 1e6, t_refr / 1e6, (unsigned)(host_heap_used() - heap_before));
+    lv_obj_delete(table);
+    lv_refr_now(disp);
+}
+
+int main(int argc, char ** argv)
+{
+    /*About 150 stored rows fit in the 64 KB heap next to the screen*/
+    uint32_t rows = argc > 1 ? (uint32_t)atoi(argv[1]) : 150;
+    disp = host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    run(LOAD_CELLS, rows);
+    run(LOAD_BATCH, rows);
+    run(LOAD_VIRTUAL, rows);
+    run(LOAD_VIRTUAL, 100000);
+    return 0;
+}
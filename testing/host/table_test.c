@@ -0,0 +1,241 @@
+/**
+ * @file table_test.c
+ * Checks of the lv_table batch API and virtual mode:
+ * - a table filled in a batch measures and renders exactly like one filled cell by cell
+ * - nothing is invalidated inside a batch, for stored and virtual tables
+ * - changing the column count inside a batch keeps the spare rows
+ * - a virtual table renders like a stored one with the same texts
+ * - a virtual cell text is never cut to the scratch buffer when the callback returns it directly
+ * - the cell borders are drawn the same whichever row the 20 line stripes of partial rendering start on
+ */
+
+#include "host.h"
+#include "src/core/lv_refr_private.h"
+#include "src/widgets/table/lv_table_private.h"
+
+#define ROWS 40
+#define COLS 3
+
+static lv_display_t * disp;
+static char long_txt[300];
+static uint32_t longest_drawn;
+
+static void cell_text(uint32_t row, uint32_t col, char * buf, uint32_t buf_size)
+{
+    if(col == 0) lv_snprintf(buf, buf_size, "%02u/%02u", (unsigned)(row % 12 + 1), (unsigned)(row % 28 + 1));
+    else if(col == 1) lv_snprintf(buf, buf_size, "Merchant %u", (unsigned)row);
+    else lv_snprintf(buf, buf_size, "$%u.%02u", (unsigned)(row * 37 % 500), (unsigned)(row * 13 % 100));
+}
+
+static const char * virtual_cell_cb(lv_obj_t * obj, uint32_t row, uint32_t col, char * buf, uint32_t buf_size)
+{
+    cell_text(row, col, buf, buf_size);
+    return buf;
+}
+
+static const char * long_cell_cb(lv_obj_t * obj, uint32_t row, uint32_t col, char * buf, uint32_t buf_size)
+{
+    if(col == 1) return long_txt;
+    cell_text(row, col, buf, buf_size);
+    return buf;
+}
+
+static void label_task_cb(lv_event_t * e)
+{
+    lv_draw_label_dsc_t * dsc = lv_draw_task_get_label_dsc(lv_event_get_draw_task(e));
+    if(dsc && dsc->text && lv_strlen(dsc->text) > longest_drawn) longest_drawn = lv_strlen(dsc->text);
+}
+
+static lv_obj_t * table_create(void)
+{
+    lv_obj_t * table = lv_table_create(lv_screen_active());
+    lv_table_set_column_count(table, COLS);
+    lv_table_set_column_width(table, 0, 80);
+    lv_table_set_column_width(table, 1, 140);
+    lv_table_set_column_width(table, 2, 100);
+    lv_obj_set_size(table, HOST_HOR_RES, HOST_VER_RES);
+    /*Small padding like the app's tables, so every single line text fits in one line*/
+    lv_obj_set_style_pad_all(table, 4, LV_PART_ITEMS);
+    return table;
+}
+
+static void fill(lv_obj_t * table)
+{
+    char buf[32];
+    for(uint32_t row = 0; row < ROWS; row++) {
+        for(uint32_t col = 0; col < COLS; col++) {
+            cell_text(row, col, buf, sizeof(buf));
+            /*Some taller rows so the measured heights differ*/
+            if(col == 1 && row % 7 == 0) lv_strcat(buf, "\nwith a note");
+            lv_table_set_cell_value(table, row, col, buf);
+        }
+    }
+}
+
+static uint32_t render(lv_obj_t * table)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+    LV_UNUSED(table);
+    return host_frame_hash();
+}
+
+static void test_batch_matches_direct(void)
+{
+    lv_obj_t * direct = table_create();
+    fill(direct);
+    uint32_t direct_hash = render(direct);
+    int32_t direct_h = lv_obj_get_self_height(direct);
+    lv_table_t * d = (lv_table_t *)direct;
+    int32_t direct_row_h[ROWS];
+    lv_memcpy(direct_row_h, d->row_h, sizeof(direct_row_h));
+    lv_obj_delete(direct);
+
+    lv_obj_t * batched = table_create();
+    lv_table_begin_batch(batched);
+    lv_table_begin_batch(batched); /*Nested batches are committed by the outermost commit*/
+    fill(batched);
+    lv_table_commit_batch(batched);
+    lv_table_t * b = (lv_table_t *)batched;
+    HOST_CHECK(b->batch_depth == 1, "the inner commit ended the batch");
+    lv_table_commit_batch(batched);
+
+    HOST_CHECK(b->row_cnt == ROWS && b->row_cap >= ROWS, "%u rows, capacity %u", (unsigned)b->row_cnt,
+               (unsigned)b->row_cap);
+    HOST_CHECK(lv_memcmp(direct_row_h, b->row_h, sizeof(direct_row_h)) == 0, "row heights differ");
+    HOST_CHECK(lv_obj_get_self_height(batched) == direct_h, "height %d != %d", (int)lv_obj_get_self_height(batched),
+               (int)direct_h);
+    HOST_CHECK(render(batched) == direct_hash, "a batch filled table renders differently");
+    lv_obj_delete(batched);
+}
+
+static void test_batch_defers_invalidation(bool virtual_mode)
+{
+    lv_obj_t * table = table_create();
+    if(virtual_mode) lv_table_set_cell_data_cb(table, virtual_cell_cb);
+    lv_table_set_row_count(table, 5);
+    render(table);
+
+    lv_table_begin_batch(table);
+    lv_table_set_row_count(table, ROWS);
+    if(!virtual_mode) lv_table_set_cell_value(table, 3, 1, "changed");
+    HOST_CHECK(disp->inv_p == 0, "%s table invalidated %u areas inside a batch", virtual_mode ? "virtual" : "stored",
+               (unsigned)disp->inv_p);
+    lv_table_commit_batch(table);
+    HOST_CHECK(disp->inv_p > 0, "%s table not invalidated by the commit", virtual_mode ? "virtual" : "stored");
+    lv_obj_delete(table);
+}
+
+static void test_column_count_keeps_capacity(void)
+{
+    lv_obj_t * table = table_create();
+    lv_table_begin_batch(table);
+    for(uint32_t row = 0; row < 10; row++) lv_table_set_cell_value_fmt(table, row, 0, "%u", (unsigned)row);
+    lv_table_t * t = (lv_table_t *)table;
+    uint32_t cap = t->row_cap;
+    HOST_CHECK(cap > 10, "no spare rows in a batch (capacity %u)", (unsigned)cap);
+
+    lv_table_set_column_count(table, COLS + 1);
+    HOST_CHECK(t->row_cap == cap, "the column count changed the capacity from %u to %u", (unsigned)cap,
+               (unsigned)t->row_cap);
+    for(uint32_t row = 10; row < cap; row++) lv_table_set_cell_value_fmt(table, row, COLS, "%u", (unsigned)row);
+    lv_table_commit_batch(table);
+
+    char last[16];
+    lv_snprintf(last, sizeof(last), "%u", (unsigned)(cap - 1));
+    HOST_CHECK(lv_streq(lv_table_get_cell_value(table, 9, 0), "9"), "a cell was lost");
+    HOST_CHECK(lv_streq(lv_table_get_cell_value(table, cap - 1, COLS), last), "a new cell was lost");
+    lv_obj_delete(table);
+}
+
+static void test_virtual_matches_stored(void)
+{
+    char buf[32];
+    lv_obj_t * stored = table_create();
+    for(uint32_t row = 0; row < ROWS; row++) {
+        for(uint32_t col = 0; col < COLS; col++) {
+            cell_text(row, col, buf, sizeof(buf));
+            lv_table_set_cell_value(stored, row, col, buf);
+        }
+    }
+    lv_obj_update_layout(stored);
+    lv_obj_scroll_to_y(stored, 300, LV_ANIM_OFF);
+    uint32_t stored_hash = render(stored);
+    lv_obj_delete(stored);
+
+    lv_obj_t * virt = table_create();
+    lv_table_set_cell_data_cb(virt, virtual_cell_cb);
+    lv_table_set_row_count(virt, ROWS);
+    lv_obj_update_layout(virt);
+    lv_obj_scroll_to_y(virt, 300, LV_ANIM_OFF);
+    HOST_CHECK(render(virt) == stored_hash, "the virtual table renders differently");
+    lv_obj_delete(virt);
+}
+
+static void test_virtual_long_text(void)
+{
+    lv_memset(long_txt, 'a', sizeof(long_txt) - 1);
+    lv_obj_t * table = table_create();
+    lv_table_set_cell_data_cb(table, long_cell_cb);
+    lv_table_set_row_count(table, 3);
+    lv_obj_add_flag(table, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    lv_obj_add_event_cb(table, label_task_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
+    longest_drawn = 0;
+    render(table);
+    HOST_CHECK(longest_drawn == sizeof(long_txt) - 1, "a %u character text was drawn as %u characters",
+               (unsigned)(sizeof(long_txt) - 1), (unsigned)longest_drawn);
+    lv_obj_delete(table);
+}
+
+static void test_stripes_match_full(bool virtual_mode, lv_border_side_t side)
+{
+    char buf[32];
+    lv_obj_t * table = table_create();
+    /*Transparent cells, so only the cell of a border draws it*/
+    lv_obj_set_style_bg_opa(table, LV_OPA_TRANSP, LV_PART_ITEMS);
+    lv_obj_set_style_border_width(table, 3, LV_PART_ITEMS);
+    lv_obj_set_style_border_side(table, side, LV_PART_ITEMS);
+    if(virtual_mode) {
+        lv_table_set_cell_data_cb(table, virtual_cell_cb);
+        lv_table_set_row_count(table, ROWS);
+    }
+    else {
+        for(uint32_t row = 0; row < ROWS; row++) {
+            for(uint32_t col = 0; col < COLS; col++) {
+                cell_text(row, col, buf, sizeof(buf));
+                lv_table_set_cell_value(table, row, col, buf);
+            }
+        }
+    }
+    lv_obj_update_layout(table);
+    lv_obj_scroll_to_y(table, 300, LV_ANIM_OFF);
+    uint32_t full_hash = render(table);
+
+    /*The rows above the invalidated area keep the pixels of the full render*/
+    for(int32_t y = 1; y < 20; y++) {
+        lv_area_t area = {0, y, HOST_HOR_RES - 1, HOST_VER_RES - 1};
+        lv_inv_area(disp, &area);
+        lv_refr_now(disp);
+        HOST_CHECK(host_frame_hash() == full_hash, "%s table with %s borders rendered from row %d differs",
+                   virtual_mode ? "virtual" : "stored", side == LV_BORDER_SIDE_TOP ? "top" : "bottom", (int)y);
+    }
+    lv_obj_delete(table);
+}
+
+int main(void)
+{
+    disp = host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    test_batch_matches_direct();
+    test_batch_defers_invalidation(false);
+    test_batch_defers_invalidation(true);
+    test_column_count_keeps_capacity();
+    test_virtual_matches_stored();
+    test_virtual_long_text();
+    test_stripes_match_full(false, LV_BORDER_SIDE_TOP);
+    test_stripes_match_full(false, LV_BORDER_SIDE_BOTTOM);
+    test_stripes_match_full(true, LV_BORDER_SIDE_TOP);
+    test_stripes_match_full(true, LV_BORDER_SIDE_BOTTOM);
+
+    return host_finish("table_test");
+}
@@ -0,0 +1,87 @@
+/**
+ * @file timer_bench.c
+ * The timer scheduler with the firmware's 64 KB LVGL heap: N timers with random periods from 50 to 5000 ms
+ * (LVGL's own timers paused), `lv_timer_handler` called once per ms for 10 s after a warm up of 5 s.
+ * Prints the time per handler call, the callbacks run per call, the time of `lv_timer_get_time_until_next`
+ * and the heap used per timer. N is limited by the heap: a timer takes about 64 bytes with its slot in the scheduler.
+ */
+
+#include "host.h"
+#include "src/misc/lv_timer_private.h"
+
+#define WARM_UP_MS      5000
+#define RUN_MS          10000
+#define NEXT_CALLS      1000000
+#define RUNS            5
+
+static uint32_t rnd_state = 1;
+static uint32_t cb_cnt;
+
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return rnd_state >> 8;
+}
+
+static void timer_cb(lv_timer_t * timer)
+{
+    cb_cnt++;
+}
+
+static uint32_t heap_used(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+static void run(uint32_t n)
+{
+    static lv_timer_t * timers[600];
+
+    uint32_t used_before = heap_used();
+    rnd_state = 1;
+    for(uint32_t i = 0; i < n; i++) timers[i] = lv_timer_create(timer_cb, 50 + rnd() % 4951, NULL);
+    uint32_t used = heap_used() - used_before;
+
+    for(uint32_t ms = 0; ms < WARM_UP_MS; ms++) {
+        host_ticks++;
+        lv_timer_handler();
+    }
+
+    uint64_t best = UINT64_MAX;
+    uint32_t cbs = 0;
+    for(uint32_t r = 0; r < RUNS; r++) {
+        cb_cnt = 0;
+        uint64_t t0 = host_ns();
+        for(uint32_t ms = 0; ms < RUN_MS; ms++) {
+            host_ticks++;
+            lv_timer_handler();
+        }
+        uint64_t t = host_ns() - t0;
+        if(t < best) best = t;
+        cbs = cb_cnt;
+    }
+
+    volatile uint32_t sink = 0;
+    uint64_t t0 = host_ns();
+    for(uint32_t i = 0; i < NEXT_CALLS; i++) sink += lv_timer_get_time_until_next();
+    uint64_t next_t = host_ns() - t0;
+
+    printf("%4u timers: %6.3f us/call, %5.2f callbacks/call, %5.1f ns/get_time_until_next, %5.1f bytes/timer\n",
+           (unsigned)n, best / 1e3 / RUN_MS, (double)cbs / RUN_MS, (double)next_t / NEXT_CALLS, (double)used / n);
+
+    for(uint32_t i = 0; i < n; i++) lv_timer_delete(timers[i]);
+}
+
+int main(void)
+{
+    static const uint32_t counts[] = {10, 50, 100, 300, 600};
+
+    host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_timer_t * t = NULL;
+    while((t = lv_timer_get_next(t))) lv_timer_pause(t);
+
+    for(uint32_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) run(counts[i]);
+    return 0;
+}
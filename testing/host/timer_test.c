@@ -0,0 +1,441 @@
+/**
+ * @file timer_test.c
+ * Checks of the timer scheduler (the min-heap by deadline in lv_timer.c), with the firmware's 64 KB LVGL heap.
+ * LVGL's own timers are paused first, the tick starts 64 s before it wraps around.
+ * - equivalence: random creates, deletes, pauses, resumes, readies, resets and changes of the period,
+ *   repeat count and auto delete between the `lv_timer_handler` calls, also with periods longer than
+ *   the scheduler's 0x3FFFFFFF ms limit and jumps of the tick. The timers run by each call must be exactly
+ *   the due ones of a plain model of every timer's last run and period, and the returned time until
+ *   the next timer must be the model's
+ * - stress: the callbacks create, delete, pause, resume, ready and change other timers and themselves.
+ *   After every call and in every callback the heap must be ordered and consistent with the timer list,
+ *   no timer may run twice in a call (unless resumed in it), no due timer may be left behind and
+ *   the time until the next timer must be exact
+ * - ties: timers due at the same tick among others with random periods, created, paused and resumed in
+ *   random order. They must run newest first, as they did from the timer list
+ */
+
+#include "host.h"
+#include "src/core/lv_global.h"
+#include "src/misc/lv_timer_private.h"
+
+#define EQUIV_TIMERS    400
+#define EQUIV_STEPS     20000
+#define STRESS_TIMERS   300
+#define STRESS_CALLS    20000
+#define LONG_PERIOD     0xA0000000
+#define TICK_JUMP       0x20000000
+#define MAX_DELAY       0x3FFFFFFF
+#define TIE_TIMERS      40
+#define TIE_ROUNDS      500
+
+typedef struct {
+    lv_timer_t * timer;
+    uint32_t period;
+    uint32_t last_run;
+    int32_t repeat_count;
+    bool paused;
+    bool auto_delete;
+    uint32_t ran;
+    bool resumed;
+} slot_t;
+
+static slot_t slots[EQUIV_TIMERS];
+static uint32_t rnd_state = 1;
+
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return rnd_state >> 8;
+}
+
+static uint32_t remaining(uint32_t last_run, uint32_t period)
+{
+    uint32_t elapsed = host_ticks - last_run;
+    return elapsed >= period ? 0 : period - elapsed;
+}
+
+static uint32_t slot_id(lv_timer_t * timer)
+{
+    return (uint32_t)(uintptr_t)lv_timer_get_user_data(timer);
+}
+
+static void timers_pause_all(void)
+{
+    lv_timer_t * t = NULL;
+    while((t = lv_timer_get_next(t))) lv_timer_pause(t);
+}
+
+/**
+ * Check the heap against the timer list
+ * @param in_handler    true in a callback, when the timers which already ran are kept after the heap
+ * @param exact_next    the time until the next timer must be the minimum over the list,
+ *                      false if there are timers with longer periods than the scheduler's limit
+ */
+static void check_heap(bool in_handler, bool exact_next)
+{
+    lv_timer_state_t * st = &LV_GLOBAL_DEFAULT()->timer_state;
+    HOST_CHECK(in_handler ? st->timer_heap_cnt <= st->timer_sched_cnt : st->timer_heap_cnt == st->timer_sched_cnt,
+               "%u timers in the heap, %u scheduled", (unsigned)st->timer_heap_cnt, (unsigned)st->timer_sched_cnt);
+
+    uint32_t cnt = 0;
+    uint32_t sched = 0;
+    uint32_t next = LV_NO_TIMER_READY;
+    lv_timer_t * t = NULL;
+    while((t = lv_timer_get_next(t))) {
+        cnt++;
+        if(t->paused) {
+            HOST_CHECK(t->heap_index == LV_TIMER_NOT_SCHEDULED, "a paused timer is at %u in the heap", (unsigned)t->heap_index);
+            continue;
+        }
+        sched++;
+        HOST_CHECK(t->heap_index < st->timer_sched_cnt && st->timer_heap[t->heap_index] == t,
+                   "a timer is not at its index %u in the heap", (unsigned)t->heap_index);
+        uint32_t r = remaining(t->last_run, t->period);
+        if(r < next) next = r;
+    }
+    HOST_CHECK(cnt == st->timer_cnt, "%u timers in the list, %u counted", (unsigned)cnt, (unsigned)st->timer_cnt);
+    HOST_CHECK(sched == st->timer_sched_cnt, "%u timers not paused, %u scheduled", (unsigned)sched,
+               (unsigned)st->timer_sched_cnt);
+
+    for(uint32_t i = 1; i < st->timer_heap_cnt; i++) {
+        lv_timer_t * child = st->timer_heap[i];
+        lv_timer_t * parent = st->timer_heap[(i - 1) / 2];
+        int32_t diff = (int32_t)(child->deadline - parent->deadline);
+        HOST_CHECK(diff > 0 || (diff == 0 && (int32_t)(child->order - parent->order) < 0),
+                   "the heap is out of order at %u", (unsigned)i);
+    }
+
+    if(!in_handler && exact_next) {
+        HOST_CHECK(lv_timer_get_time_until_next() == next, "%u ms until the next timer instead of %u",
+                   (unsigned)lv_timer_get_time_until_next(), (unsigned)next);
+    }
+}
+
+/*---------------
+ * Equivalence
+ *--------------*/
+
+static void equiv_timer_cb(lv_timer_t * timer)
+{
+    slots[slot_id(timer)].ran++;
+}
+
+/** The time until the next timer by the model, `*has_long` tells if it can be shorter in lv_timer */
+static uint32_t model_time_until_next(bool * has_long)
+{
+    uint32_t next = LV_NO_TIMER_READY;
+    *has_long = false;
+    for(uint32_t i = 0; i < EQUIV_TIMERS; i++) {
+        slot_t * s = &slots[i];
+        if(s->timer == NULL || s->paused) continue;
+        uint32_t r = remaining(s->last_run, s->period);
+        if(s->period > MAX_DELAY) *has_long = true;
+        if(r < next) next = r;
+    }
+    return next;
+}
+
+static void model_check_next(uint32_t next, const char * when, uint32_t step)
+{
+    bool has_long;
+    uint32_t expected = model_time_until_next(&has_long);
+    /*lv_timer waits at most MAX_DELAY at once, so the deadline of a long period can be earlier in the heap*/
+    if(has_long) HOST_CHECK(next <= expected, "step %u %s: %u ms until the next timer, more than %u",
+                                (unsigned)step, when, (unsigned)next, (unsigned)expected);
+    else HOST_CHECK(next == expected, "step %u %s: %u ms until the next timer instead of %u",
+                        (unsigned)step, when, (unsigned)next, (unsigned)expected);
+}
+
+static void equiv_op(void)
+{
+    uint32_t id = rnd() % EQUIV_TIMERS;
+    slot_t * s = &slots[id];
+
+    if(s->timer == NULL) {
+        if(rnd() % 2) return;
+        s->period = rnd() % 200 == 0 ? LONG_PERIOD + rnd() % 1000 : rnd() % 3000;
+        s->timer = lv_timer_create(equiv_timer_cb, s->period, (void *)(uintptr_t)id);
+        s->last_run = host_ticks;
+        s->repeat_count = -1;
+        s->paused = false;
+        s->auto_delete = true;
+        if(rnd() % 4 == 0) {
+            s->repeat_count = 1 + rnd() % 4;
+            lv_timer_set_repeat_count(s->timer, s->repeat_count);
+            s->auto_delete = rnd() % 2;
+            lv_timer_set_auto_delete(s->timer, s->auto_delete);
+        }
+        return;
+    }
+
+    switch(rnd() % 9) {
+        case 0:
+            lv_timer_delete(s->timer);
+            s->timer = NULL;
+            break;
+        case 1:
+            lv_timer_pause(s->timer);
+            s->paused = true;
+            break;
+        case 2:
+            lv_timer_resume(s->timer);
+            s->paused = false;
+            break;
+        case 3:
+            lv_timer_ready(s->timer);
+            s->last_run = host_ticks - s->period - 1;
+            break;
+        case 4:
+            lv_timer_reset(s->timer);
+            s->last_run = host_ticks;
+            break;
+        case 5:
+        case 6:
+            s->period = rnd() % 3000;
+            lv_timer_set_period(s->timer, s->period);
+            break;
+        case 7:
+            s->repeat_count = rnd() % 3 ? -1 : (int32_t)(rnd() % 4);
+            lv_timer_set_repeat_count(s->timer, s->repeat_count);
+            break;
+        case 8:
+            s->auto_delete = rnd() % 2;
+            lv_timer_set_auto_delete(s->timer, s->auto_delete);
+            break;
+    }
+}
+
+/** Run the due timers of the model like `lv_timer_exec` and compare them with the ones which ran */
+static void model_handler(uint32_t step)
+{
+    for(uint32_t i = 0; i < EQUIV_TIMERS; i++) {
+        slot_t * s = &slots[i];
+        uint32_t ran = s->ran;
+        s->ran = 0;
+
+        bool due = s->timer && !s->paused && remaining(s->last_run, s->period) == 0;
+        bool runs = due && s->repeat_count != 0;
+        HOST_CHECK(ran == runs, "step %u: timer %u ran %u times instead of %u", (unsigned)step, (unsigned)i,
+                   (unsigned)ran, (unsigned)runs);
+        if(!due) continue;
+
+        if(s->repeat_count > 0) s->repeat_count--;
+        s->last_run = host_ticks;
+        if(s->repeat_count == 0) {
+            if(s->auto_delete) s->timer = NULL;
+            else s->paused = true;
+        }
+    }
+}
+
+static void equiv_run(void)
+{
+    for(uint32_t step = 0; step < EQUIV_STEPS; step++) {
+        uint32_t ops = rnd() % 6;
+        for(uint32_t i = 0; i < ops; i++) equiv_op();
+        model_check_next(lv_timer_get_time_until_next(), "before", step);
+
+        host_ticks += step % 2000 == 1999 ? TICK_JUMP : rnd() % 4 ? rnd() % 200 : 0;
+        uint32_t next = lv_timer_handler();
+        model_handler(step);
+        model_check_next(next, "after", step);
+        check_heap(false, false);
+        for(uint32_t i = 0; i < EQUIV_TIMERS; i++) {
+            slot_t * s = &slots[i];
+            if(s->timer) HOST_CHECK(s->timer->paused == s->paused, "step %u: timer %u is %s", (unsigned)step,
+                                        (unsigned)i, s->paused ? "not paused" : "paused");
+        }
+    }
+
+    for(uint32_t i = 0; i < EQUIV_TIMERS; i++) {
+        if(slots[i].timer) lv_timer_delete(slots[i].timer);
+        slots[i].timer = NULL;
+    }
+}
+
+/*---------------
+ * Stress
+ *--------------*/
+
+static void stress_timer_cb(lv_timer_t * timer);
+
+static void stress_create(slot_t * s, uint32_t id)
+{
+    s->timer = lv_timer_create(stress_timer_cb, rnd() % 8 == 0 ? 0 : rnd() % 500, (void *)(uintptr_t)id);
+    s->ran = 0;
+    s->resumed = false;
+    if(rnd() % 8 == 0) lv_timer_set_repeat_count(s->timer, 1 + rnd() % 3);
+}
+
+static void stress_op(void)
+{
+    uint32_t id = rnd() % STRESS_TIMERS;
+    slot_t * s = &slots[id];
+    if(s->timer == NULL) {
+        stress_create(s, id);
+        return;
+    }
+
+    switch(rnd() % 7) {
+        case 0:
+            lv_timer_delete(s->timer);
+            s->timer = NULL;
+            break;
+        case 1:
+            lv_timer_pause(s->timer);
+            break;
+        case 2:
+            if(s->timer->paused) s->resumed = true;
+            lv_timer_resume(s->timer);
+            break;
+        case 3:
+            lv_timer_ready(s->timer);
+            break;
+        case 4:
+            lv_timer_reset(s->timer);
+            break;
+        case 5:
+            lv_timer_set_period(s->timer, rnd() % 500);
+            break;
+        case 6:
+            lv_timer_set_repeat_count(s->timer, rnd() % 2 ? -1 : 1 + rnd() % 3);
+            break;
+    }
+}
+
+static void stress_timer_cb(lv_timer_t * timer)
+{
+    uint32_t id = slot_id(timer);
+    slot_t * s = &slots[id];
+    HOST_CHECK(s->timer == timer, "the callback of deleted timer %u ran", (unsigned)id);
+    HOST_CHECK(s->ran == 0 || s->resumed, "timer %u ran twice in a call", (unsigned)id);
+    s->ran++;
+
+    uint32_t ops = rnd() % 3;
+    for(uint32_t i = 0; i < ops; i++) stress_op();
+
+    /*The repeat count might end here, then lv_timer_exec deletes the timer*/
+    if(s->timer == timer && timer->repeat_count == 0 && timer->auto_delete) s->timer = NULL;
+    check_heap(true, true);
+}
+
+static void stress_run(void)
+{
+    for(uint32_t i = 0; i < STRESS_TIMERS; i++) stress_create(&slots[i], i);
+
+    for(uint32_t call = 0; call < STRESS_CALLS; call++) {
+        host_ticks += rnd() % 4 ? rnd() % 50 : 0;
+        lv_timer_handler();
+        check_heap(false, true);
+
+        for(uint32_t i = 0; i < STRESS_TIMERS; i++) {
+            slot_t * s = &slots[i];
+            if(s->timer && !s->timer->paused && s->ran == 0) {
+                HOST_CHECK(remaining(s->timer->last_run, s->timer->period) != 0,
+                           "call %u: due timer %u didn't run", (unsigned)call, (unsigned)i);
+            }
+            s->ran = 0;
+            s->resumed = false;
+        }
+
+        /*Revive the deleted and paused ones now and then, so the callbacks keep the heap busy*/
+        if(call % 16 == 0) {
+            for(uint32_t i = 0; i < STRESS_TIMERS; i++) {
+                slot_t * s = &slots[i];
+                if(s->timer == NULL) stress_create(s, i);
+                else if(s->timer->paused && rnd() % 2) lv_timer_resume(s->timer);
+            }
+        }
+    }
+
+    for(uint32_t i = 0; i < STRESS_TIMERS; i++) {
+        if(slots[i].timer) lv_timer_delete(slots[i].timer);
+        slots[i].timer = NULL;
+    }
+}
+
+/*---------------
+ * Ties
+ *--------------*/
+
+static uint32_t tie_log[TIE_TIMERS];
+static uint32_t tie_cnt;
+
+static void tie_timer_cb(lv_timer_t * timer)
+{
+    if(tie_cnt < TIE_TIMERS) tie_log[tie_cnt] = slot_id(timer);
+    tie_cnt++;
+}
+
+static void noise_timer_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+}
+
+static void tie_run(void)
+{
+    for(uint32_t round = 0; round < TIE_ROUNDS; round++) {
+        uint32_t period = 1 + rnd() % 100;
+        uint32_t created = 0;
+        tie_cnt = 0;
+
+        /*The tied timers are created in id order between others, some of which are due at the same tick*/
+        while(created < TIE_TIMERS) {
+            uint32_t id = rnd() % EQUIV_TIMERS;
+            slot_t * s = &slots[id];
+            if(s->timer) {
+                if(s->timer->timer_cb == noise_timer_cb && rnd() % 4 == 0) {
+                    lv_timer_delete(s->timer);
+                    s->timer = NULL;
+                }
+                else if(rnd() % 2) {
+                    lv_timer_pause(s->timer);
+                    lv_timer_resume(s->timer);
+                }
+                continue;
+            }
+            if(rnd() % 3 == 0) {
+                s->timer = lv_timer_create(tie_timer_cb, period, (void *)(uintptr_t)created);
+                created++;
+            }
+            else {
+                s->timer = lv_timer_create(noise_timer_cb, rnd() % 3 ? period : rnd() % (2 * period), NULL);
+            }
+        }
+
+        host_ticks += period;
+        lv_timer_handler();
+        check_heap(false, true);
+
+        HOST_CHECK(tie_cnt == TIE_TIMERS, "round %u: %u of %u tied timers ran", (unsigned)round,
+                   (unsigned)tie_cnt, (unsigned)TIE_TIMERS);
+        for(uint32_t i = 0; i < TIE_TIMERS && i < tie_cnt; i++) {
+            HOST_CHECK(tie_log[i] == TIE_TIMERS - 1 - i, "round %u: tied timer %u ran as the %u. one",
+                       (unsigned)round, (unsigned)tie_log[i], (unsigned)i);
+        }
+
+        for(uint32_t i = 0; i < EQUIV_TIMERS; i++) {
+            if(slots[i].timer) lv_timer_delete(slots[i].timer);
+            slots[i].timer = NULL;
+        }
+    }
+}
+
+int main(void)
+{
+    host_init(LV_DISPLAY_RENDER_MODE_PARTIAL);
+    timers_pause_all();
+    host_ticks = 0xFFFF0000;
+
+    equiv_run();
+    check_heap(false, true);
+    HOST_CHECK(lv_timer_get_time_until_next() == LV_NO_TIMER_READY, "a timer is scheduled after the equivalence check");
+
+    stress_run();
+    check_heap(false, true);
+
+    tie_run();
+
+    return host_finish("timer_test");
+}
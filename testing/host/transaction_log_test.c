@@ -0,0 +1,462 @@
+/**
+ * @file transaction_log_test.c
+ * Checks of the flash-backed transaction log (main/transaction_log.c) fed like the sync feeds it: a mock
+ * /transactions/sync server writes pages of 100 changes, they are parsed in random chunks by json_stream
+ * and applied with put and remove, then committed with the page's cursor. The log lives in obj/storage,
+ * NVS in RAM (idf/nvs.h). The transactions' fields are picked out with a small scanner instead of cJSON,
+ * which isn't built on the host.
+ * - before init succeeds (SPIFFS, NVS or the file failing) the log reads as empty and refuses changes
+ * - over 12000 added transactions with escaped names, also modified and removed ones. After every
+ *   committed page the log must hold exactly the server's transactions and the cursor of the page
+ * - pages cut off halfway and rolled back, resets halfway through a page, resets after a commit, commits
+ *   whose compaction is cut short by failing writes and a page with an element too large for json_stream:
+ *   the cursor stays, and replaying the page must give the same log
+ * - the id index grows in blocks of INDEX_CHUNK entries
+ */
+
+#include "host.h"
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*Lets the checks fail the log's writes from a point on, like a full or failing flash*/
+static int32_t host_writes_left = -1;
+
+static size_t host_fwrite(const void * ptr, size_t size, size_t n, FILE * f)
+{
+    if(host_writes_left == 0) return 0;
+    if(host_writes_left > 0) host_writes_left--;
+    return fwrite(ptr, size, n, f);
+}
+
+#define TRANSACTION_LOG_MOUNT "obj/storage"
+#define fwrite host_fwrite
+#include "../../main/transaction_log.c"
+#undef fwrite
+#include "../../main/json_stream.c"
+
+#define SERVER_MAX      14000
+#define PAGES           170
+#define PAGE_CHANGES    100
+#define PAGE_MAX        (64 * 1024)
+
+typedef struct {
+    uint32_t day;
+    int32_t amount_cents;
+    char name[64];
+    bool live;
+} server_txn_t;
+
+typedef struct {
+    char cursor[TRANSACTION_CURSOR_LEN];
+    uint32_t failed;
+} client_t;
+
+static server_txn_t server[SERVER_MAX];
+static uint32_t server_cnt;
+static uint32_t server_live;
+static char page[PAGE_MAX];
+static json_stream_t stream;
+static client_t client;
+static uint32_t rnd_state = 1;
+
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return rnd_state >> 8;
+}
+
+static void txn_id(char * dst, uint32_t i)
+{
+    /*As long as Plaid's 37 characters*/
+    snprintf(dst, TRANSACTION_ID_LEN, "%06u-PLAIDxKq3vZ8mB7nW2pL9rT4yH6jD", (unsigned)i);
+}
+
+/*---------------
+ * Mock server
+ *--------------*/
+
+static size_t json_escape(char * dst, const char * src)
+{
+    size_t n = 0;
+    for(; *src; src++) {
+        if(*src == '"' || *src == '\\') dst[n++] = '\\';
+        dst[n++] = *src;
+    }
+    return n;
+}
+
+static size_t print_txn(char * dst, uint32_t i)
+{
+    const server_txn_t * t = &server[i];
+    char id[TRANSACTION_ID_LEN];
+    int year, month, mday;
+    txn_id(id, i);
+    transaction_log_day_to_date(t->day, &year, &month, &mday);
+    int32_t cents = t->amount_cents < 0 ? -t->amount_cents : t->amount_cents;
+    size_t n = (size_t)sprintf(dst, "{\"transaction_id\": \"%s\", \"amount\": %s%d.%02d, \"date\": \"%04d-%02d-%02d\", "
+                               "\"location\": {\"city\": \"Reno\"}, \"name\": \"", id, t->amount_cents < 0 ? "-" : "",
+                               (int)(cents / 100), (int)(cents % 100), year, month, mday);
+    n += json_escape(dst + n, t->name);
+    n += (size_t)sprintf(dst + n, "\"}");
+    return n;
+}
+
+static void random_txn(server_txn_t * t)
+{
+    static const char * const names[] = {"Coffee \"Bean\" Co", "Rent \\ Utilities", "Payroll, {ACME}", "Groceries [Store #12]",
+                                         "Fuel: Station", "A very long merchant name that does not fit in a record"
+                                        };
+    t->day = 20000 + rnd() % 1000;
+    t->amount_cents = (int32_t)(rnd() % 200000) - 50000;
+    snprintf(t->name, sizeof(t->name), "%s %u", names[rnd() % 6], (unsigned)(rnd() % 1000));
+}
+
+static uint32_t random_live(void)
+{
+    uint32_t i = rnd() % server_cnt;
+    while(!server[i].live) i = (i + 1) % server_cnt;
+    return i;
+}
+
+/**
+ * Write the next page and apply its changes to the server's transactions
+ * @param removing  mostly removals, so a compaction moves committed records
+ */
+static void server_next_page(uint32_t number, bool has_more, bool too_large, bool removing)
+{
+    uint32_t added[PAGE_CHANGES], modified[PAGE_CHANGES], removed[PAGE_CHANGES];
+    uint32_t added_cnt = 0, modified_cnt = 0, removed_cnt = 0;
+
+    for(uint32_t c = 0; c < PAGE_CHANGES; c++) {
+        uint32_t r = rnd() % 100;
+        if(removing) r = r < 10 ? r : 90 + r % 10;
+        if(r < 85 || server_live < 50) {
+            server_txn_t * t = &server[server_cnt];
+            random_txn(t);
+            t->live = true;
+            added[added_cnt++] = server_cnt++;
+            server_live++;
+        }
+        else if(r < 94) {
+            uint32_t i = random_live();
+            random_txn(&server[i]);
+            modified[modified_cnt++] = i;
+        }
+        else {
+            uint32_t i = random_live();
+            server[i].live = false;
+            server_live--;
+            removed[removed_cnt++] = i;
+        }
+    }
+
+    /*A transaction modified after it was removed in the same page would be a server bug*/
+    size_t n = (size_t)sprintf(page, "{\"added\": [");
+    for(uint32_t i = 0; i < added_cnt; i++) {
+        if(i) page[n++] = ',';
+        n += print_txn(page + n, added[i]);
+    }
+    if(too_large) {
+        n += (size_t)sprintf(page + n, ",{\"transaction_id\": \"huge\", \"name\": \"");
+        for(uint32_t i = 0; i < JSON_STREAM_ELEMENT_MAX; i++) page[n++] = 'x';
+        n += (size_t)sprintf(page + n, "\"}");
+    }
+    n += (size_t)sprintf(page + n, "],\n\"modified\": [");
+    uint32_t printed = 0;
+    for(uint32_t i = 0; i < modified_cnt; i++) {
+        if(!server[modified[i]].live) continue;
+        if(printed++) page[n++] = ',';
+        n += print_txn(page + n, modified[i]);
+    }
+    n += (size_t)sprintf(page + n, "],\n\"removed\": [");
+    for(uint32_t i = 0; i < removed_cnt; i++) {
+        char id[TRANSACTION_ID_LEN];
+        txn_id(id, removed[i]);
+        n += (size_t)sprintf(page + n, "%s{\"account_id\": \"acc\", \"transaction_id\": \"%s\"}", i ? "," : "", id);
+    }
+    n += (size_t)sprintf(page + n, "],\n\"next_cursor\": \"cursor-%u\", \"has_more\": %s, \"request_id\": \"r%u\"}",
+                         (unsigned)number, has_more ? "true" : "false", (unsigned)number);
+    HOST_CHECK(n < PAGE_MAX, "page %u is %u bytes", (unsigned)number, (unsigned)n);
+}
+
+/** Drop the too large element again, like the server would send the page after it changed */
+static void server_drop_too_large(void)
+{
+    char * start = strstr(page, ",{\"transaction_id\": \"huge\"");
+    char * end = start ? strstr(start + 1, "\"}") : NULL;
+    if(end) memmove(start, end + 2, strlen(end + 2) + 1);
+}
+
+/*---------------
+ * Client
+ *--------------*/
+
+/** Copy the value of a key of a flat element, strings unescaped. Returns false if the key isn't there */
+static bool json_field(const char * element, const char * key, char * dst, size_t size)
+{
+    char pattern[40];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char * p = strstr(element, pattern);
+    if(!p) return false;
+    p += strlen(pattern);
+    while(*p == ' ') p++;
+
+    size_t n = 0;
+    if(*p == '"') {
+        for(p++; *p && *p != '"'; p++) {
+            if(*p == '\\') p++;
+            if(n < size - 1) dst[n++] = *p;
+        }
+    }
+    else {
+        while(*p && *p != ',' && *p != '}' && n < size - 1) dst[n++] = *p++;
+    }
+    dst[n] = '\0';
+    return true;
+}
+
+/** Like plaid_sync_element_cb, with json_field instead of cJSON */
+static void sync_element_cb(const char * key, const char * element, size_t len, void * user_data)
+{
+    client_t * c = user_data;
+    char id[64], value[80];
+    if(!json_field(element, "transaction_id", id, sizeof(id)) || strlen(id) >= TRANSACTION_ID_LEN) {
+        c->failed++;
+        return;
+    }
+
+    if(strcmp(key, "removed") == 0) {
+        esp_err_t err = transaction_log_remove(id);
+        if(err != ESP_OK && err != ESP_ERR_NOT_FOUND) c->failed++;
+        return;
+    }
+
+    transaction_record_t record = {0};
+    strcpy(record.id, id);
+    if(json_field(element, "date", value, sizeof(value))) record.day = transaction_log_date_to_day(value);
+    if(json_field(element, "amount", value, sizeof(value))) {
+        double cents = strtod(value, NULL) * 100.0;
+        record.amount_cents = (int32_t)(cents + (cents >= 0 ? 0.5 : -0.5));
+    }
+    if(json_field(element, "name", value, sizeof(value))) {
+        memcpy(record.name, value, LV_MIN(strlen(value), sizeof(record.name) - 1));
+    }
+    if(transaction_log_put(&record) != ESP_OK) c->failed++;
+}
+
+static void sync_scalar_cb(const char * key, const char * value, void * user_data)
+{
+    client_t * c = user_data;
+    if(strcmp(key, "next_cursor") == 0) snprintf(c->cursor, sizeof(c->cursor), "%s", value);
+}
+
+/**
+ * Parse and apply a page like plaid_sync_transactions
+ * @param cut               stop after this many bytes like a dropped connection, 0 for the whole page
+ * @param commit_writes     writes the commit may do before they fail, -1 for no limit
+ * @return                  true if the page was committed
+ */
+static bool client_sync(size_t cut, int32_t commit_writes)
+{
+    size_t len = cut ? cut : strlen(page);
+    client.failed = 0;
+    client.cursor[0] = '\0';
+    json_stream_init(&stream, sync_element_cb, sync_scalar_cb, &client);
+    for(size_t pos = 0; pos < len;) {
+        size_t n = 1 + rnd() % 1500;
+        if(n > len - pos) n = len - pos;
+        json_stream_feed(&stream, page + pos, n);
+        pos += n;
+    }
+
+    if(cut || client.failed || stream.skipped || client.cursor[0] == '\0') {
+        transaction_log_rollback();
+        return false;
+    }
+    host_writes_left = commit_writes;
+    esp_err_t err = transaction_log_commit(0, client.cursor);
+    host_writes_left = -1;
+    return err == ESP_OK;
+}
+
+/** A reset: everything in RAM is lost, the file and NVS stay */
+static esp_err_t log_reboot(void)
+{
+    if(log_file) fclose(log_file);
+    log_file = NULL;
+    free_index();
+    log_ready = false;
+    record_count = 0;
+    committed_count = 0;
+    tombstones = 0;
+    return transaction_log_init();
+}
+
+/*---------------
+ * Checks
+ *--------------*/
+
+static void check_unavailable(const char * why)
+{
+    transaction_record_t record = {0};
+    char cursor[16];
+    strcpy(record.id, "id");
+    HOST_CHECK(transaction_log_count() == 0, "%s: the log has records", why);
+    HOST_CHECK(transaction_log_read(0, &record, 1) == 0, "%s: a record was read", why);
+    HOST_CHECK(transaction_log_put(&record) == ESP_ERR_INVALID_STATE, "%s: put didn't fail", why);
+    HOST_CHECK(transaction_log_remove("id") == ESP_ERR_INVALID_STATE, "%s: remove didn't fail", why);
+    HOST_CHECK(transaction_log_commit(0, "c") == ESP_ERR_INVALID_STATE, "%s: commit didn't fail", why);
+    HOST_CHECK(transaction_log_get_cursor(0, cursor, sizeof(cursor)) == ESP_ERR_INVALID_STATE && cursor[0] == '\0',
+               "%s: a cursor was read", why);
+    transaction_log_rollback();
+}
+
+static void check_init_failures(void)
+{
+    host_spiffs_result = ESP_FAIL;
+    HOST_CHECK(log_reboot() == ESP_FAIL, "init succeeded without storage");
+    check_unavailable("no storage");
+    host_spiffs_result = ESP_OK;
+
+    host_nvs_result = ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    HOST_CHECK(log_reboot() != ESP_OK, "init succeeded without NVS");
+    check_unavailable("no NVS");
+    host_nvs_result = ESP_OK;
+
+    rmdir(TRANSACTION_LOG_MOUNT);
+    HOST_CHECK(log_reboot() == ESP_FAIL, "init succeeded without the log file");
+    check_unavailable("no log file");
+
+    mkdir(TRANSACTION_LOG_MOUNT, 0755);
+    HOST_CHECK(log_reboot() == ESP_OK, "init failed");
+    HOST_CHECK(transaction_log_count() == 0, "a new log has %u records", (unsigned)transaction_log_count());
+}
+
+/** After a rollback only transactions of earlier pages may be left, the removals of the page may stay */
+static void check_rolled_back(uint32_t number, uint32_t first_new)
+{
+    static transaction_record_t records[64];
+    uint32_t count = transaction_log_count();
+    uint32_t wrong = 0;
+    for(uint32_t first = 0; first < count; first += 64) {
+        size_t n = transaction_log_read(first, records, 64);
+        for(size_t r = 0; r < n; r++) wrong += records[r].id[0] && (uint32_t)atoi(records[r].id) >= first_new;
+    }
+    HOST_CHECK(wrong == 0, "page %u: %u added transactions are left after the rollback", (unsigned)number, (unsigned)wrong);
+}
+
+/** The log must hold exactly the server's live transactions */
+static void check_log(uint32_t number, const char * cursor)
+{
+    static transaction_record_t records[64];
+    static bool seen[SERVER_MAX];
+    memset(seen, 0, sizeof(seen));
+
+    uint32_t count = transaction_log_count();
+    HOST_CHECK(count == server_live, "page %u: %u records instead of %u", (unsigned)number, (unsigned)count,
+               (unsigned)server_live);
+
+    uint32_t wrong = 0;
+    for(uint32_t first = 0; first < count; first += 64) {
+        size_t n = transaction_log_read(first, records, 64);
+        HOST_CHECK(n == LV_MIN(64, count - first), "page %u: read %u records at %u", (unsigned)number, (unsigned)n,
+                   (unsigned)first);
+        for(size_t r = 0; r < n; r++) {
+            const transaction_record_t * rec = &records[r];
+            char id[TRANSACTION_ID_LEN];
+            uint32_t i = (uint32_t)atoi(rec->id);
+            txn_id(id, i);
+            if(i >= server_cnt || strcmp(rec->id, id) != 0 || !server[i].live || seen[i]) {
+                wrong++;
+                continue;
+            }
+            seen[i] = true;
+            const server_txn_t * t = &server[i];
+            if(rec->day != t->day || rec->amount_cents != t->amount_cents ||
+               strncmp(rec->name, t->name, TRANSACTION_NAME_LEN - 1) != 0 || rec->name[TRANSACTION_NAME_LEN - 1]) wrong++;
+        }
+    }
+    HOST_CHECK(wrong == 0, "page %u: %u records are wrong, removed or stored twice", (unsigned)number, (unsigned)wrong);
+
+    char saved[TRANSACTION_CURSOR_LEN];
+    transaction_log_get_cursor(0, saved, sizeof(saved));
+    HOST_CHECK(strcmp(saved, cursor) == 0, "page %u: the cursor is '%s' instead of '%s'", (unsigned)number, saved, cursor);
+    /*Blocks are only freed by a reset, a page rolled back may leave one*/
+    HOST_CHECK((uint64_t)index_chunk_count * INDEX_CHUNK >= count && index_chunk_count <= count / INDEX_CHUNK + 2,
+               "page %u: %u index blocks for %u records", (unsigned)number, (unsigned)index_chunk_count, (unsigned)count);
+}
+
+static void check_sync(void)
+{
+    char cursor[TRANSACTION_CURSOR_LEN] = "";
+    uint32_t failures[6] = {0};
+
+    for(uint32_t p = 0; p < PAGES; p++) {
+        bool too_large = p == PAGES / 2;
+        uint32_t what = rnd() % 10;
+        uint32_t first_new = server_cnt;
+        server_next_page(p, p + 1 < PAGES, too_large, what == 2);
+
+        bool committed = false;
+        if(too_large) {
+            HOST_CHECK(!client_sync(0, -1), "page %u: committed with an element too large to parse", (unsigned)p);
+            check_rolled_back(p, first_new);
+            failures[0]++;
+            server_drop_too_large();
+        }
+        else if(what == 0) {
+            HOST_CHECK(!client_sync(1 + rnd() % (strlen(page) - 1), -1), "page %u: committed while cut off", (unsigned)p);
+            check_rolled_back(p, first_new);
+            failures[1]++;
+        }
+        else if(what == 1) {
+            /*Reset halfway through the page, nothing is rolled back*/
+            json_stream_init(&stream, sync_element_cb, sync_scalar_cb, &client);
+            json_stream_feed(&stream, page, rnd() % strlen(page));
+            HOST_CHECK(log_reboot() == ESP_OK, "page %u: init failed after a reset", (unsigned)p);
+            failures[2]++;
+        }
+        else if(what == 2) {
+            /*The compaction of the commit is cut short, then the device resets. It needs no writes
+             *if only the last records were removed*/
+            committed = client_sync(0, (int32_t)(rnd() % 20));
+            if(!committed) {
+                HOST_CHECK(log_reboot() == ESP_OK, "page %u: init failed after a cut short compaction", (unsigned)p);
+                failures[3]++;
+            }
+        }
+
+        if(!committed) {
+            char saved[TRANSACTION_CURSOR_LEN];
+            transaction_log_get_cursor(0, saved, sizeof(saved));
+            HOST_CHECK(strcmp(saved, cursor) == 0, "page %u: the cursor moved to '%s' without a commit", (unsigned)p, saved);
+            HOST_CHECK(client_sync(0, -1), "page %u: the sync failed", (unsigned)p);
+        }
+        snprintf(cursor, sizeof(cursor), "cursor-%u", (unsigned)p);
+        check_log(p, cursor);
+
+        if(what == 3) {
+            HOST_CHECK(log_reboot() == ESP_OK, "page %u: init failed after a commit", (unsigned)p);
+            check_log(p, cursor);
+            failures[4]++;
+        }
+    }
+
+    HOST_CHECK(server_cnt > 12000, "only %u transactions were added", (unsigned)server_cnt);
+    printf("%u transactions added, %u stored, %u index blocks; %u too large, %u cut off, %u reset, "
+           "%u compactions cut short, %u resets after a commit\n", (unsigned)server_cnt, (unsigned)server_live,
+           (unsigned)index_chunk_count, (unsigned)failures[0], (unsigned)failures[1], (unsigned)failures[2],
+           (unsigned)failures[3], (unsigned)failures[4]);
+}
+
+int main(void)
+{
+    mkdir("obj", 0755);
+    mkdir(TRANSACTION_LOG_MOUNT, 0755);
+    remove(LOG_PATH);
+    host_nvs_erase();
+
+    check_init_failures();
+    check_sync();
+    return host_finish("transaction_log_test");
+}
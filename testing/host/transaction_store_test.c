@@ -0,0 +1,514 @@
+/**
+ * @file transaction_store_test.c
+ * Checks of the columnar transaction store (main/transaction_store.c) on a file-backed flash emulator:
+ * obj/txn_store.bin behaves like NOR flash (writes only clear bits, erases set a 4 KB sector back to 0xFF)
+ * and can lose power at any write or erase. The write is then torn halfway and nothing reaches the file
+ * until the store is loaded again. Pages of 100 changes are applied and committed like the sync does,
+ * a page whose changes or commit failed is replayed after the reboot.
+ * - on the partition's 256 KB, after every page the store holds exactly the reference transactions, with
+ *   their days, amounts, categories and dictionary merchants
+ * - on 48 KB segments get recycled: what is left must still match the reference, and the month summaries
+ *   must count exactly the transactions the segments hold
+ * - a commit that could not write fails, what it could not write goes with the next one, and a commit that
+ *   succeeded survives the power cut
+ * - erase counts survive resets, also one right after an erase, and recycling spreads them evenly
+ * - no write ever tries to set a bit back to 1
+ */
+
+#include "host.h"
+
+/*The log is only here for the id hash and the dates. Both have a static find_record*/
+#define find_record log_find_record
+#include "../../main/transaction_log.c"
+#undef find_record
+#include "../../main/transaction_store.c"
+
+#define FLASH_PATH          "obj/txn_store.bin"
+#define FLASH_SECTORS_MAX   64
+#define IDS_MAX             20000
+#define ID_TABLE            (1 << 16)
+#define PAGE_CHANGES        100
+#define MERCHANTS           300
+#define MONTHS_CHECKED      36
+
+typedef struct {
+    FILE * file;
+    size_t size;
+    int32_t ops_left;                       /*Writes and erases until the power is cut, -1 for never*/
+    bool cut_on_erase;                      /*Cut the power right after the next segment erase*/
+    bool dead;                              /*The power is cut, nothing reaches the file until the reboot*/
+    uint32_t fails_left;                    /*Writes that fail without a reset, like a flaky flash*/
+    uint32_t cuts;
+    uint32_t erases[FLASH_SECTORS_MAX];
+    uint32_t bit_sets;                      /*Writes that wanted a 0 bit back to 1*/
+} flash_emu_t;
+
+typedef struct {
+    uint32_t day;
+    int32_t amount_cents;
+    uint8_t category;
+    uint8_t institution;
+    uint16_t merchant;
+    bool live;
+} txn_t;
+
+typedef enum {
+    CHANGE_ADD,
+    CHANGE_MODIFY,
+    CHANGE_REMOVE,
+} change_type_t;
+
+typedef struct {
+    change_type_t type;
+    uint32_t id;
+    txn_t txn;
+} change_t;
+
+static flash_emu_t flash;
+static txn_t model[IDS_MAX];
+static uint32_t id_hashes[IDS_MAX];
+static uint32_t id_table[ID_TABLE];         /*id_hash -> id + 1*/
+static uint32_t id_cnt;
+static uint32_t model_live;
+static char merchants[MERCHANTS][40];
+static change_t page[PAGE_CHANGES];
+static uint32_t page_stamp[IDS_MAX];
+static uint32_t seen_stamp[IDS_MAX];
+static uint32_t stamp;
+static uint32_t rnd_state = 1;
+
+static uint32_t rnd(void)
+{
+    rnd_state = rnd_state * 1103515245 + 12345;
+    return rnd_state >> 8;
+}
+
+/*---------------
+ * Flash emulator
+ *--------------*/
+
+static esp_err_t flash_read(void * ctx, size_t offset, void * dst, size_t len)
+{
+    flash_emu_t * f = ctx;
+    HOST_CHECK(offset + len <= f->size, "read of %u bytes at %u is outside the flash", (unsigned)len, (unsigned)offset);
+    fseek(f->file, (long)offset, SEEK_SET);
+    return fread(dst, 1, len, f->file) == len ? ESP_OK : ESP_FAIL;
+}
+
+static esp_err_t flash_write(void * ctx, size_t offset, const void * src, size_t len)
+{
+    static uint8_t old[SECTOR_SIZE];
+    flash_emu_t * f = ctx;
+    HOST_CHECK(offset + len <= f->size && len <= SECTOR_SIZE, "write of %u bytes at %u is outside the flash",
+               (unsigned)len, (unsigned)offset);
+    if(f->dead) return ESP_FAIL;
+    if(f->fails_left) {
+        f->fails_left--;
+        return ESP_FAIL;
+    }
+
+    /*Losing the power halfway leaves the write torn*/
+    size_t n = len;
+    if(f->ops_left == 0) {
+        n = len / 2;
+        f->dead = true;
+        f->cuts++;
+    }
+    else if(f->ops_left > 0) {
+        f->ops_left--;
+    }
+
+    fseek(f->file, (long)offset, SEEK_SET);
+    if(fread(old, 1, n, f->file) != n) return ESP_FAIL;
+    const uint8_t * bytes = src;
+    for(size_t i = 0; i < n; i++) {
+        if(bytes[i] & ~old[i]) f->bit_sets++;
+        old[i] &= bytes[i];
+    }
+    fseek(f->file, (long)offset, SEEK_SET);
+    if(fwrite(old, 1, n, f->file) != n) return ESP_FAIL;
+    return f->dead ? ESP_FAIL : ESP_OK;
+}
+
+static esp_err_t flash_erase(void * ctx, size_t offset)
+{
+    static uint8_t erased[SECTOR_SIZE];
+    flash_emu_t * f = ctx;
+    HOST_CHECK(offset % SECTOR_SIZE == 0 && offset < f->size, "erase at %u", (unsigned)offset);
+    if(f->dead) return ESP_FAIL;
+
+    size_t n = SECTOR_SIZE;
+    if(f->ops_left == 0) {
+        n = SECTOR_SIZE / 2;
+        f->dead = true;
+        f->cuts++;
+    }
+    else if(f->ops_left > 0) {
+        f->ops_left--;
+    }
+
+    memset(erased, 0xFF, sizeof(erased));
+    fseek(f->file, (long)offset, SEEK_SET);
+    if(fwrite(erased, 1, n, f->file) != n) return ESP_FAIL;
+    f->erases[offset / SECTOR_SIZE]++;
+    if(f->cut_on_erase && offset >= SUMMARY_SECTORS * SECTOR_SIZE) {
+        f->cut_on_erase = false;
+        f->ops_left = 0;
+    }
+    return f->dead ? ESP_FAIL : ESP_OK;
+}
+
+static const transaction_store_flash_t store_flash_emu = {
+    .read = flash_read,
+    .write = flash_write,
+    .erase_sector = flash_erase,
+    .ctx = &flash,
+};
+
+/** A new, erased flash of `sectors` sectors */
+static void flash_create(uint32_t sectors)
+{
+    static uint8_t erased[SECTOR_SIZE];
+    if(flash.file) fclose(flash.file);
+    memset(&flash, 0, sizeof(flash));
+    flash.file = fopen(FLASH_PATH, "w+b");
+    flash.size = sectors * SECTOR_SIZE;
+    flash.ops_left = -1;
+    memset(erased, 0xFF, sizeof(erased));
+    for(uint32_t i = 0; i < sectors; i++) fwrite(erased, 1, sizeof(erased), flash.file);
+}
+
+/** Power comes back, the store is loaded from the file again */
+static esp_err_t flash_reboot(void)
+{
+    flash.dead = false;
+    flash.ops_left = -1;
+    flash.cut_on_erase = false;
+    store_ready = false;
+    transaction_store_flash_t f = store_flash_emu;
+    f.size = flash.size;
+    return transaction_store_init(&f);
+}
+
+/*---------------
+ * Reference
+ *--------------*/
+
+static uint32_t month_index(uint32_t day)
+{
+    int year, month, mday;
+    transaction_log_day_to_date(day, &year, &month, &mday);
+    return (uint32_t)((year - 1970) * 12 + month - 1);
+}
+
+/** A new id whose hash no other id has, the store tells transactions apart by the hash */
+static uint32_t new_id(void)
+{
+    char text[TRANSACTION_ID_LEN];
+    for(;;) {
+        snprintf(text, sizeof(text), "%06u-PLAIDxKq3vZ8mB7nW2pL9rT4yH6jD", (unsigned)(id_cnt + rnd() % 1000000));
+        uint32_t hash = transaction_log_hash_id(text);
+        uint32_t slot = hash % ID_TABLE;
+        bool taken = false;
+        while(id_table[slot]) {
+            taken |= id_hashes[id_table[slot] - 1] == hash;
+            slot = (slot + 1) % ID_TABLE;
+        }
+        if(taken) continue;
+        id_hashes[id_cnt] = hash;
+        id_table[slot] = id_cnt + 1;
+        return id_cnt++;
+    }
+}
+
+static uint32_t find_id(uint32_t hash)
+{
+    for(uint32_t slot = hash % ID_TABLE; id_table[slot]; slot = (slot + 1) % ID_TABLE) {
+        if(id_hashes[id_table[slot] - 1] == hash) return id_table[slot] - 1;
+    }
+    return UINT32_MAX;
+}
+
+static void random_txn(txn_t * t, uint32_t first_day)
+{
+    t->day = first_day + rnd() % 60;
+    t->amount_cents = (int32_t)(rnd() % 200000) - 50000;
+    t->category = rnd() % TRANSACTION_CATEGORY_COUNT;
+    t->institution = rnd() % 3;
+    t->merchant = rnd() % MERCHANTS;
+    t->live = true;
+}
+
+/** The merchant as the dictionary keeps it: cut to TRANSACTION_STORE_MERCHANT_MAX bytes on a character boundary */
+static void stored_merchant(char * dst, uint16_t merchant)
+{
+    const char * src = merchants[merchant];
+    size_t len = strlen(src);
+    if(len > TRANSACTION_STORE_MERCHANT_MAX) {
+        len = TRANSACTION_STORE_MERCHANT_MAX;
+        while(len > 0 && ((unsigned char)src[len] & 0xC0) == 0x80) len--;
+    }
+    memcpy(dst, src, len);
+    dst[len] = '\0';
+}
+
+/** The next page: mostly new transactions, also modified ones (some moving to another month) and removed ones */
+static void next_page(uint32_t number, uint32_t first_day)
+{
+    stamp++;
+    for(uint32_t c = 0; c < PAGE_CHANGES; c++) {
+        change_t * change = &page[c];
+        uint32_t r = rnd() % 100;
+        if(r < 80 || model_live < 200) {
+            change->type = CHANGE_ADD;
+            change->id = new_id();
+            random_txn(&change->txn, first_day);
+        }
+        else {
+            /*A transaction isn't changed twice in one page*/
+            uint32_t id = rnd() % id_cnt;
+            while(!model[id].live || page_stamp[id] == stamp) id = (id + 1) % id_cnt;
+            change->id = id;
+            change->type = r < 92 ? CHANGE_MODIFY : CHANGE_REMOVE;
+            change->txn = model[id];
+            if(change->type == CHANGE_MODIFY) {
+                change->txn.amount_cents += (int32_t)(rnd() % 1000) - 500;
+                if(rnd() % 4 == 0) change->txn.day = first_day - rnd() % 90;
+                change->txn.category = rnd() % TRANSACTION_CATEGORY_COUNT;
+            }
+        }
+        page_stamp[change->id] = stamp;
+    }
+}
+
+static void model_apply(void)
+{
+    for(uint32_t c = 0; c < PAGE_CHANGES; c++) {
+        const change_t * change = &page[c];
+        model_live += (change->type != CHANGE_REMOVE) - model[change->id].live;
+        model[change->id] = change->txn;
+        model[change->id].live = change->type != CHANGE_REMOVE;
+    }
+}
+
+/**
+ * Apply the page like the sync does
+ * @param commit_cut    writes of the commit before the power is cut, -1 for none
+ * @param commit_fails  writes of the commit that fail without a reset
+ * @return false if a change or the commit failed
+ */
+static bool apply_page(int32_t commit_cut, uint32_t commit_fails)
+{
+    uint32_t failed = 0;
+    for(uint32_t c = 0; c < PAGE_CHANGES; c++) {
+        const change_t * change = &page[c];
+        esp_err_t err;
+        if(change->type == CHANGE_REMOVE) {
+            err = transaction_store_remove(id_hashes[change->id]);
+            if(err == ESP_ERR_NOT_FOUND) err = ESP_OK;
+        }
+        else {
+            transaction_store_entry_t entry = {
+                .id_hash = id_hashes[change->id],
+                .day = change->txn.day,
+                .amount_cents = change->txn.amount_cents,
+                .institution = change->txn.institution,
+                .category = change->txn.category,
+                .merchant = merchants[change->txn.merchant],
+            };
+            err = change->type == CHANGE_ADD ? transaction_store_add(&entry) : transaction_store_modify(&entry);
+        }
+        failed += err != ESP_OK;
+    }
+    if(commit_cut >= 0 && !flash.dead) flash.ops_left = commit_cut;
+    flash.fails_left = commit_fails;
+    esp_err_t err = transaction_store_commit();
+    HOST_CHECK(flash.fails_left == commit_fails || err != ESP_OK, "a commit whose writes failed succeeded");
+    flash.fails_left = 0;
+    HOST_CHECK(commit_cut < 0 || !flash.dead || err != ESP_OK, "a commit cut short succeeded");
+    return failed == 0 && err == ESP_OK;
+}
+
+/*---------------
+ * Checks
+ *--------------*/
+
+typedef struct {
+    int32_t totals[MONTHS_CHECKED][TRANSACTION_CATEGORY_COUNT];
+    uint32_t counts[MONTHS_CHECKED];
+    uint32_t first_month;
+    uint32_t stored;
+    uint32_t wrong;
+    uint32_t twice;
+    uint32_t unknown;
+} scan_t;
+
+static void scan_cb(const transaction_store_entry_t * entry, void * user_data)
+{
+    scan_t * scan = user_data;
+    scan->stored++;
+    uint32_t id = find_id(entry->id_hash);
+    if(id == UINT32_MAX) {
+        scan->unknown++;
+        return;
+    }
+    if(seen_stamp[id] == stamp) scan->twice++;
+    seen_stamp[id] = stamp;
+
+    const txn_t * t = &model[id];
+    char merchant[TRANSACTION_STORE_MERCHANT_MAX + 1];
+    stored_merchant(merchant, t->merchant);
+    if(!t->live || entry->day != t->day || entry->amount_cents != t->amount_cents || entry->category != t->category ||
+       entry->institution != t->institution || strcmp(entry->merchant, merchant) != 0) {
+        scan->wrong++;
+    }
+
+    uint32_t month = month_index(entry->day) - scan->first_month;
+    if(month < MONTHS_CHECKED) {
+        scan->totals[month][entry->category] += entry->amount_cents;
+        scan->counts[month]++;
+    }
+}
+
+/**
+ * Every stored transaction must match the reference, with `exact` every live reference transaction must be stored.
+ * The month summaries must add up the stored transactions
+ */
+static void check_store(const char * what, uint32_t number, uint32_t first_month, bool exact)
+{
+    static scan_t scan;
+    memset(&scan, 0, sizeof(scan));
+    scan.first_month = first_month;
+    stamp++;
+    transaction_store_for_each(0, UINT32_MAX, scan_cb, &scan);
+
+    HOST_CHECK(scan.unknown == 0 && scan.twice == 0 && scan.wrong == 0,
+               "%s page %u: %u unknown, %u stored twice and %u wrong transactions", what, (unsigned)number,
+               (unsigned)scan.unknown, (unsigned)scan.twice, (unsigned)scan.wrong);
+    if(exact) {
+        HOST_CHECK(scan.stored == model_live, "%s page %u: %u transactions stored instead of %u", what, (unsigned)number,
+                   (unsigned)scan.stored, (unsigned)model_live);
+    }
+
+    transaction_store_stats_t stats;
+    transaction_store_get_stats(&stats);
+    HOST_CHECK(stats.records == scan.stored, "%s page %u: the stats count %u transactions, %u are stored", what,
+               (unsigned)number, (unsigned)stats.records, (unsigned)scan.stored);
+
+    uint32_t months_wrong = 0;
+    for(uint32_t m = 0; m < MONTHS_CHECKED; m++) {
+        transaction_month_summary_t summary;
+        uint32_t month = scan.first_month + m;
+        if(transaction_store_month_summary(1970 + month / 12, month % 12 + 1, &summary) != ESP_OK) {
+            memset(&summary, 0, sizeof(summary));
+        }
+        bool same = summary.count == scan.counts[m];
+        for(int c = 0; c < TRANSACTION_CATEGORY_COUNT; c++) same &= summary.totals_cents[c] == scan.totals[m][c];
+        months_wrong += !same;
+    }
+    HOST_CHECK(months_wrong == 0, "%s page %u: %u month summaries differ from the stored transactions", what,
+               (unsigned)number, (unsigned)months_wrong);
+}
+
+/** The store's erase counts must not be below the real ones, and only above by the erases a power cut stopped */
+static void check_erase_counts(const char * what, uint32_t number)
+{
+    uint32_t wrong = 0;
+    for(uint32_t s = 0; s < segment_count; s++) {
+        uint32_t real = flash.erases[SUMMARY_SECTORS + s];
+        wrong += segments[s].erase_count < real || segments[s].erase_count > real + flash.cuts;
+    }
+    HOST_CHECK(wrong == 0, "%s page %u: %u segments have a wrong erase count", what, (unsigned)number, (unsigned)wrong);
+}
+
+/**
+ * Sync `pages` pages on a new flash of `sectors` sectors. Some lose the power at a random write or erase,
+ * right after a segment erase or in the commit, some have writes of the commit fail without a reset,
+ * some reboot after the commit
+ */
+static void run(const char * what, uint32_t sectors, uint32_t pages, uint32_t first_day)
+{
+    flash_create(sectors);
+    memset(model, 0, sizeof(model));
+    model_live = 0;
+    HOST_CHECK(flash_reboot() == ESP_OK, "%s: the store did not load", what);
+
+    uint32_t replays = 0, reboots = 0;
+    for(uint32_t p = 0; p < pages; p++) {
+        uint32_t day = first_day + p * 3;
+        next_page(p, day);
+
+        uint32_t what_now = rnd() % 10;
+        if(what_now == 0) flash.ops_left = (int32_t)(rnd() % 900);
+        else if(what_now == 1) flash.cut_on_erase = true;
+
+        bool ok = apply_page(what_now == 3 ? (int32_t)(rnd() % 4) : -1, what_now == 4 ? 1 + rnd() % 3 : 0);
+        if(flash.dead || what_now == 2) {
+            HOST_CHECK(flash_reboot() == ESP_OK, "%s page %u: the store did not load after a reset", what, (unsigned)p);
+            check_erase_counts(what, p);
+            reboots++;
+        }
+        flash.cut_on_erase = false;
+        if(!ok) {
+            /*The sync cursor didn't move, the page comes again*/
+            HOST_CHECK(apply_page(-1, 0), "%s page %u: replaying the page failed", what, (unsigned)p);
+            replays++;
+        }
+        if(what_now == 4) {
+            /*What the replay committed after the failed commit must be all there*/
+            HOST_CHECK(flash_reboot() == ESP_OK, "%s page %u: the store did not load", what, (unsigned)p);
+            reboots++;
+        }
+        model_apply();
+
+        bool recycled = false;
+        for(uint32_t s = 0; s < segment_count; s++) recycled |= flash.erases[SUMMARY_SECTORS + s] > 1;
+        /*Modified transactions go back up to 3 months*/
+        check_store(what, p, month_index(first_day) - 4, !recycled);
+    }
+
+    transaction_store_stats_t stats;
+    transaction_store_get_stats(&stats);
+    check_erase_counts(what, pages);
+    uint32_t erase_min = UINT32_MAX, erase_max = 0;
+    for(uint32_t s = SUMMARY_SECTORS; s < sectors; s++) {
+        if(flash.erases[s] < erase_min) erase_min = flash.erases[s];
+        if(flash.erases[s] > erase_max) erase_max = flash.erases[s];
+    }
+    /*A reset can cost a segment an extra erase, but none may wear twice as fast as another*/
+    HOST_CHECK(erase_max <= 2 * erase_min + 1, "%s: segments erased from %u to %u times", what, (unsigned)erase_min,
+               (unsigned)erase_max);
+    HOST_CHECK(flash.bit_sets == 0, "%s: %u writes set bits back to 1", what, (unsigned)flash.bit_sets);
+    printf("%s: %u of %u transactions stored in %u of %u segments, erased %u to %u times; %u power cuts, %u reboots, %u replayed pages\n",
+           what, (unsigned)stats.records, (unsigned)model_live, stats.segments_used, stats.segments_total,
+           (unsigned)stats.erase_min, (unsigned)stats.erase_max, (unsigned)flash.cuts, (unsigned)reboots, (unsigned)replays);
+}
+
+static void check_unavailable(void)
+{
+    transaction_store_entry_t entry = {.id_hash = 1, .day = 20000, .merchant = "x"};
+    transaction_month_summary_t summary;
+    transaction_store_stats_t stats;
+    store_ready = false;
+    HOST_CHECK(transaction_store_init(NULL) == ESP_ERR_NOT_FOUND, "loaded without a partition");
+    HOST_CHECK(transaction_store_add(&entry) == ESP_ERR_INVALID_STATE, "add without a store");
+    HOST_CHECK(transaction_store_commit() == ESP_ERR_INVALID_STATE, "commit without a store");
+    HOST_CHECK(transaction_store_month_summary(2026, 1, &summary) == ESP_ERR_INVALID_STATE, "summary without a store");
+    transaction_store_get_stats(&stats);
+    HOST_CHECK(stats.records == 0 && stats.segments_total == 0, "stats without a store");
+}
+
+int main(void)
+{
+    for(uint32_t i = 0; i < MERCHANTS; i++) {
+        /*Some longer than the dictionary keeps, some cut inside a UTF-8 character*/
+        static const char * const names[] = {"Coffee", "Groceries \xc3\xa9picerie fine du coin", "Fuel", "Caf\xc3\xa9 du Jardin Botanique"};
+        snprintf(merchants[i], sizeof(merchants[i]), "%s %u", names[i % 4], (unsigned)i);
+    }
+    uint32_t first_day = transaction_log_date_to_day("2025-01-01");
+
+    check_unavailable();
+    run("256 KB", 64, 60, first_day);
+    run("48 KB", 12, 80, first_day);
+    return host_finish("transaction_store_test");
+}
@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""
+Pack a folder into the asset partition image read by main/asset_fs.c.
+
+    python3 tools/asset_pack.py assets/ -o build/assets.bin
+
+`idf.py build` runs this on the repo's assets/ folder and `idf.py flash` writes
+the image to the "assets" partition (see the root CMakeLists.txt).
+
+Files keep their path relative to the folder ("icons/bank.bin" is opened as
+"A:/icons/bank.bin"). Convert images with lib/lvgl/scripts/LVGLImage.py
+(--ofmt BIN --cf RGB565, no compression) so they can be drawn straight from flash.
+"""
+import argparse
+import struct
+from pathlib import Path
+
+MAGIC = 0x5041564C  # "LVAP"
+VERSION = 1
+NAME_LEN = 40
+ALIGN = 64
+PARTITION_SIZE = 0x100000  # "assets" in partitions.csv
+
+
+def pack(folder: Path) -> bytes:
+    files = sorted(p for p in folder.rglob("*") if p.is_file())
+    names = [p.relative_to(folder).as_posix() for p in files]
+    for name in names:
+        if len(name.encode()) >= NAME_LEN:
+            raise SystemExit(f"name too long (max {NAME_LEN - 1} bytes): {name}")
+
+    image = bytearray(struct.pack("<IHH", MAGIC, VERSION, len(files)))
+    offset = len(image) + len(files) * (NAME_LEN + 8)
+    contents = []
+    for name, path in zip(names, files):
+        content = path.read_bytes()
+        offset = (offset + ALIGN - 1) // ALIGN * ALIGN
+        image += name.encode().ljust(NAME_LEN, b"\0")
+        image += struct.pack("<II", offset, len(content))
+        contents.append((offset, content))
+        offset += len(content)
+
+    for offset, content in contents:
+        image += b"\xff" * (offset - len(image))  # Erased flash
+        image += content
+    return bytes(image)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build the asset partition image")
+    parser.add_argument("folder", type=Path)
+    parser.add_argument("-o", "--output", type=Path, default=Path("assets.bin"))
+    parser.add_argument("--size", type=lambda s: int(s, 0), default=PARTITION_SIZE,
+                        help="size of the partition")
+    args = parser.parse_args()
+
+    image = pack(args.folder)
+    if len(image) > args.size:
+        raise SystemExit(f"{len(image)} bytes does not fit the {args.size} byte partition")
+    args.output.parent.mkdir(parents=True, exist_ok=True)
+    args.output.write_bytes(image)
+    print(f"{args.output}: {len(image)} of {args.size} bytes")
+
+
+if __name__ == "__main__":
+    main()